@@ -185,6 +185,7 @@ add_library(core
   fboss/agent/FabricConnectivityManager.cpp
   fboss/agent/EncapIndexAllocator.cpp
   fboss/agent/FibHelpers.cpp
+  fboss/agent/FibLpmSnapshot.cpp
   fboss/agent/FsdbAdaptedSubManager.cpp
   fboss/agent/HwAsicTable.cpp
   fboss/agent/HwSwitch.cpp
@@ -217,6 +218,7 @@ add_library(core
   fboss/agent/NeighborUpdater.cpp
   fboss/agent/NeighborUpdaterImpl.cpp
   fboss/agent/NeighborUpdaterNoopImpl.cpp
+  fboss/agent/PortStatsHistory.cpp
   fboss/agent/PortUpdateHandler.cpp
   fboss/agent/RemoteNeighborUpdater.cpp
   fboss/agent/ResolvedNexthopMonitor.cpp
@@ -273,6 +275,7 @@ set(core_libs
   hardware_stats_cpp2
   hw_switch_fb303_stats
   hw_cpu_fb303_stats
+  hw_switch_stats_delta
   switch_asics
   switchid_scope_resolver
   ctrl_cpp2
@@ -283,6 +286,7 @@ set(core_libs
   product_info
   platform_base
   restart_time_tracker
+  route_update_trace
   route_update_wrapper
   fib_updater
   network_to_route_map
@@ -290,12 +294,15 @@ set(core_libs
   state
   state_utils
   exponential_back_off
+  function_call_time_reporter
   fboss_config_utils
   phy_cpp2
   phy_utils
   snapshot_manager
   transceiver_cpp2
   alert_logger
+  rcu_lpm_table
+  shm_packet_ring
   Folly::folly
   bidirectional_packet_stream
   fsdb_common_cpp2
@@ -303,10 +310,12 @@ set(core_libs
   fsdb_stream_client
   fsdb_pub_sub
   fsdb_flags
+  thrift_cow_visitors
   ${IPROUTE2}
   ${NETLINK3}
   ${NETLINKROUTE3}
   thread_heartbeat
+  thread_stall_profiler
   platform_mapping_utils
   sw_switch_warmboot_helper
   hw_write_behavior
@@ -347,6 +356,7 @@ add_library(handler
 target_link_libraries(handler
   core
   pkt
+  route_update_trace
   fb303::fb303
   ctrl_cpp2
   log_thrift_call
@@ -378,6 +388,16 @@ target_link_libraries(fboss_error
   Folly::folly
 )
 
+add_library(hw_switch_stats_delta
+  fboss/agent/HwSwitchStatsDelta.cpp
+)
+
+target_link_libraries(hw_switch_stats_delta
+  fboss_error
+  multiswitch_ctrl_cpp2
+  Folly::folly
+)
+
 add_library(build_info_wrapper
   fboss/agent/BuildInfoWrapper.h
   fboss/agent/oss/BuildInfoWrapper.cpp
@@ -418,6 +438,7 @@ target_link_libraries(hw_switch
   hw_write_behavior
   hw_switch_warmboot_helper
   multiswitch_ctrl_cpp2
+  function_call_time_reporter
 )
 
 add_library(async_logger
@@ -511,6 +532,24 @@ target_link_libraries(restart_time_tracker
   Folly::folly
 )
 
+add_library(route_update_trace
+  fboss/agent/RouteUpdateTrace.cpp
+)
+
+target_link_libraries(route_update_trace
+  fb303::fb303
+  Folly::folly
+)
+
+add_library(tx_packet_buffer_pool
+  fboss/agent/TxPacketBufferPool.cpp
+)
+
+target_link_libraries(tx_packet_buffer_pool
+  fb303::fb303
+  Folly::folly
+)
+
 add_library(multiswitch_service
   fboss/agent/MultiSwitchThriftHandler.cpp
 )
@@ -544,6 +583,7 @@ add_library(split_agent_thrift_syncer
   fboss/agent/mnpu/LinkChangeEventSyncer.cpp
   fboss/agent/mnpu/SwitchReachabilityChangeEventSyncer.cpp
   fboss/agent/mnpu/OperDeltaSyncer.cpp
+  fboss/agent/mnpu/PacketRingSyncer.cpp
   fboss/agent/mnpu/RxPktEventSyncer.cpp
   fboss/agent/mnpu/SplitAgentThriftSyncer.cpp
   fboss/agent/mnpu/SplitAgentThriftSyncerClient.cpp
@@ -552,6 +592,8 @@ add_library(split_agent_thrift_syncer
 
 target_link_libraries(split_agent_thrift_syncer
   multiswitch_service
+  hw_switch_stats_delta
+  shm_packet_ring
   Folly::folly
   hw_switch
 )
@@ -266,6 +266,21 @@ add_library(hw_rx_slow_path_rate
   fboss/agent/hw/benchmarks/HwRxSlowPathBenchmark.cpp
 )
 
+add_library(hw_pktio_speed
+  fboss/agent/hw/benchmarks/HwPktioBenchmark.cpp
+)
+
+target_link_libraries(hw_pktio_speed
+  config_utils
+  packet_factory
+  fake_sai
+  sai_switch
+  mono_agent_ensemble
+  mono_agent_benchmarks
+  Folly::folly
+  Folly::follybenchmark
+)
+
 add_library(hw_rx_slow_path_arp_rate
   fboss/agent/hw/benchmarks/HwRxSlowPathArpBenchmark.cpp
 )
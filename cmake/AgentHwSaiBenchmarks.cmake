@@ -508,6 +508,28 @@ endfunction()
 
 if(BUILD_SAI_FAKE AND BUILD_SAI_FAKE_BENCHMARKS)
   BUILD_SAI_BENCHMARKS("fake" fake_sai)
+
+  # Injects packets through the fake SAI hostif, so only built for fake SAI.
+  # The allocation counter replaces operator new, so it is compiled into the
+  # executable only.
+  add_executable(sai_pktio_speed-fake
+    fboss/agent/hw/benchmarks/HwPktioAllocationCounter.cpp
+  )
+
+  target_link_libraries(sai_pktio_speed-fake
+    -Wl,--whole-archive
+    mono_sai_agent_benchmarks_main
+    hw_pktio_speed
+    fake_sai
+    -Wl,--no-whole-archive
+  )
+
+  set_target_properties(sai_pktio_speed-fake
+    PROPERTIES COMPILE_FLAGS
+    "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+    -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+    -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+  )
 endif()
 
 # If libsai_impl is provided, build sai tests linking with it
@@ -3,6 +3,24 @@
 # In general, libraries and binaries in fboss/foo/bar are built by
 # cmake/FooBar.cmake
 
+add_library(sai_recording
+  fboss/agent/hw/sai/tracer/SaiRecording.cpp
+)
+
+target_link_libraries(sai_recording
+  fboss_error
+  Folly::folly
+)
+
+add_library(sai_recorder
+  fboss/agent/hw/sai/tracer/SaiRecorder.cpp
+)
+
+target_link_libraries(sai_recorder
+  sai_recording
+  Folly::folly
+)
+
 add_library(sai_tracer
   fboss/agent/hw/sai/tracer/AclApiTracer.cpp
   fboss/agent/hw/sai/tracer/ArsApiTracer.cpp
@@ -44,6 +62,8 @@ add_library(sai_tracer
 target_link_libraries(sai_tracer
   fboss_error
   fboss_types
+  sai_recording
+  sai_recorder
   async_logger
   sai_version
   function_call_time_reporter
@@ -0,0 +1,86 @@
+# CMake to build libraries and binaries in fboss/agent/hw/sai/tracer/replay
+
+# In general, libraries and binaries in fboss/foo/bar are built by
+# cmake/FooBar.cmake
+
+add_library(sai_recording_replayer
+  fboss/agent/hw/sai/tracer/replay/SaiRecordingReplayer.cpp
+)
+
+target_link_libraries(sai_recording_replayer
+  sai_recording
+  logging_util
+  fmt::fmt
+  Folly::folly
+)
+
+set_target_properties(sai_recording_replayer PROPERTIES COMPILE_FLAGS
+  "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+  -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+  -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+)
+
+if(BUILD_SAI_FAKE)
+add_executable(sai_recording_replayer-fake
+  fboss/agent/hw/sai/tracer/replay/Main.cpp
+)
+
+target_link_libraries(sai_recording_replayer-fake
+  sai_recording_replayer
+  fake_sai
+  Folly::folly
+)
+
+set_target_properties(sai_recording_replayer-fake PROPERTIES COMPILE_FLAGS
+  "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+  -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+  -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+)
+
+install(
+  TARGETS
+  sai_recording_replayer-fake)
+
+add_executable(sai_recording_replayer_test
+  fboss/agent/hw/sai/tracer/replay/tests/SaiRecordingReplayerTest.cpp
+  fboss/agent/test/oss/Main.cpp
+)
+
+target_link_libraries(sai_recording_replayer_test
+  sai_recording_replayer
+  fake_sai
+  fboss_error
+  Folly::folly
+  ${GTEST}
+  ${LIBGMOCK_LIBRARIES}
+)
+
+set_target_properties(sai_recording_replayer_test PROPERTIES COMPILE_FLAGS
+  "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+  -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+  -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+)
+
+gtest_discover_tests(sai_recording_replayer_test)
+
+add_executable(sai_recorder_test
+  fboss/agent/hw/sai/tracer/replay/tests/SaiRecorderTest.cpp
+  fboss/agent/test/oss/Main.cpp
+)
+
+target_link_libraries(sai_recorder_test
+  sai_recorder
+  sai_recording
+  Folly::folly
+  ${GTEST}
+  ${LIBGMOCK_LIBRARIES}
+)
+
+set_target_properties(sai_recorder_test PROPERTIES COMPILE_FLAGS
+  "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+  -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+  -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+)
+
+gtest_discover_tests(sai_recorder_test)
+endif()
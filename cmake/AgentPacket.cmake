@@ -25,6 +25,7 @@ add_library(packet
 target_link_libraries(packet
   pktutil
   stats
+  tx_packet_buffer_pool
   utils
   Folly::folly
 )
@@ -17,6 +17,15 @@ target_link_libraries(platform_mapping
   ${RE2}
 )
 
+add_executable(platform_mapping_compiler
+  fboss/agent/platforms/common/PlatformMappingCompiler.cpp
+)
+
+target_link_libraries(platform_mapping_compiler
+  platform_mapping
+  Folly::folly
+)
+
 add_library(platform_mapping_utils
   fboss/agent/platforms/common/PlatformMappingUtils.cpp
 )
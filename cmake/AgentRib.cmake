@@ -18,6 +18,8 @@ target_link_libraries(standalone_rib
   ctrl_cpp2
   label_forwarding_action
   state_utils
+  function_call_time_reporter
+  route_update_trace
   Folly::folly
   switch_state_cpp2
   thrift_cow_nodes
@@ -41,5 +43,6 @@ target_link_libraries(fib_updater
   standalone_rib
   fboss_types
   state
+  function_call_time_reporter
   Folly::folly
 )
@@ -85,6 +85,33 @@ target_link_libraries(async_logger_test
 
 gtest_discover_tests(async_logger_test)
 
+add_executable(route_update_trace_test
+  fboss/agent/test/oss/Main.cpp
+  fboss/agent/test/RouteUpdateTraceTest.cpp
+)
+
+target_link_libraries(route_update_trace_test
+  route_update_trace
+  ${GTEST}
+  ${LIBGMOCK_LIBRARIES}
+)
+
+gtest_discover_tests(route_update_trace_test)
+
+add_executable(tx_packet_buffer_pool_test
+  fboss/agent/test/oss/Main.cpp
+  fboss/agent/test/TxPacketBufferPoolTest.cpp
+)
+
+target_link_libraries(tx_packet_buffer_pool_test
+  packet
+  tx_packet_buffer_pool
+  ${GTEST}
+  ${LIBGMOCK_LIBRARIES}
+)
+
+gtest_discover_tests(tx_packet_buffer_pool_test)
+
 add_library(agent_test_lib
   fboss/agent/test/AgentTest.cpp
 )
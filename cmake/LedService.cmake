@@ -94,6 +94,8 @@ target_link_libraries(led_manager_lib
   fsdb_stream_client
   fsdb_pub_sub
   fsdb_flags
+  switch_state_cpp2
+  thrift_cow_nodes
 )
 
 add_library(led_core_lib
@@ -12,6 +12,22 @@ target_link_libraries(radix_tree
   Folly::folly
 )
 
+add_library(rcu_lpm_table
+  fboss/lib/RcuLpmTable.h
+)
+
+target_link_libraries(rcu_lpm_table
+  Folly::folly
+)
+
+add_library(shm_packet_ring
+  fboss/lib/ShmPacketRing.cpp
+)
+
+target_link_libraries(shm_packet_ring
+  Folly::folly
+)
+
 add_library(log_thrift_call
   fboss/lib/LogThriftCall.cpp
   fboss/lib/oss/LogThriftCall.cpp
@@ -132,6 +148,15 @@ target_link_libraries(thread_heartbeat
   Folly::folly
 )
 
+add_library(thread_stall_profiler
+  fboss/lib/ThreadStallProfiler.cpp
+)
+
+target_link_libraries(thread_stall_profiler
+  thread_heartbeat
+  Folly::folly
+)
+
 add_library(pci_device
   fboss/lib/PciDevice.cpp
   fboss/lib/PciSystem.cpp
@@ -32,6 +32,7 @@ target_link_libraries(platform_manager_platform_explorer_test
   fb303::fb303
   platform_manager_platform_explorer
   platform_manager_utils
+  platform_fs_utils
   Folly::folly
   ${GTEST}
   ${LIBGMOCK_LIBRARIES}
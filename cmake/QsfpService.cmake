@@ -198,6 +198,7 @@ target_link_libraries(transceiver_manager
   common_file_utils
   qsfp_platforms_wedge
   thread_heartbeat
+  thread_stall_profiler
   utils
   product_info
   fsdb_flags
@@ -33,6 +33,9 @@ add_library(
   fboss/thrift_cow/visitors/PatchApplier.cpp
   fboss/thrift_cow/visitors/PatchHelpers.h
   fboss/thrift_cow/visitors/PatchHelpers.cpp
+  fboss/thrift_cow/visitors/PathToken.h
+  fboss/thrift_cow/visitors/PathToken.cpp
+  fboss/thrift_cow/visitors/ThriftObjectPatchBuilder.h
   fboss/thrift_cow/visitors/TraverseHelper.h
 )
 
@@ -45,4 +48,5 @@ target_link_libraries(thrift_cow_visitors
   Folly::folly
   FBThrift::thriftcpp2
   ${RE2}
+  ${ZSTD}
 )
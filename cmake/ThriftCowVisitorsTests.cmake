@@ -6,6 +6,7 @@
 add_executable(thrift_cow_visitor_tests
   fboss/thrift_cow/visitors/tests/VisitorTestUtils.cpp
   fboss/thrift_cow/visitors/tests/DeltaVisitorTests.cpp
+  fboss/thrift_cow/visitors/tests/PathTokenTests.cpp
   fboss/thrift_cow/visitors/tests/PathVisitorTests.cpp
   fboss/thrift_cow/visitors/tests/RecurseVisitorTests.cpp
 )
@@ -49,6 +49,7 @@ set(fsdb_pub_sub_libs
   fb303::fb303
   fsdb_cpp2
   fsdb_utils
+  thrift_cow_visitors
 )
 
 target_link_libraries(fsdb_pub_sub ${fsdb_pub_sub_libs})
@@ -34,6 +34,7 @@ target_link_libraries(subscription_manager
   fsdb_oper_metadata_tracker
   patch_cpp2
   thrift_cow_visitors
+  fb303::fb303
 )
 
 add_library(oper_path_helpers
@@ -204,3 +204,9 @@ DEFINE_bool(
     fw_drained_unrecoverable_error,
     false,
     "Enable or disable whether firmware drained(isolation) can be unrecoverable error");
+
+DEFINE_bool(
+    skip_unchanged_config_sections,
+    true,
+    "Skip re-applying config sections whose config and state are unchanged "
+    "since the last successful config application");
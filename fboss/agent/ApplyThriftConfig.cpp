@@ -12,6 +12,7 @@
 #include <fboss/thrift_cow/nodes/ThriftMapNode-inl.h>
 #include <folly/FileUtil.h>
 #include <folly/gen/Base.h>
+#include <folly/hash/SpookyHashV2.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 #include <memory>
 #include <optional>
@@ -222,7 +223,8 @@ class ThriftConfigApplier {
       RoutingInformationBase* rib,
       AclNexthopHandler* aclNexthopHandler,
       const PlatformMapping* platformMapping,
-      const HwAsicTable* hwAsicTable)
+      const HwAsicTable* hwAsicTable,
+      AppliedConfigSections* appliedSections)
       : orig_(orig),
         cfg_(config),
         supportsAddRemovePort_(supportsAddRemovePort),
@@ -230,7 +232,8 @@ class ThriftConfigApplier {
         aclNexthopHandler_(aclNexthopHandler),
         scopeResolver_(getSwitchInfoFromConfig(config)),
         platformMapping_(platformMapping),
-        hwAsicTable_(hwAsicTable) {}
+        hwAsicTable_(hwAsicTable),
+        appliedSections_(appliedSections) {}
 
   ThriftConfigApplier(
       const std::shared_ptr<SwitchState>& orig,
@@ -239,7 +242,8 @@ class ThriftConfigApplier {
       RouteUpdateWrapper* routeUpdater,
       AclNexthopHandler* aclNexthopHandler,
       const PlatformMapping* platformMapping,
-      const HwAsicTable* hwAsicTable)
+      const HwAsicTable* hwAsicTable,
+      AppliedConfigSections* appliedSections)
       : orig_(orig),
         cfg_(config),
         supportsAddRemovePort_(supportsAddRemovePort),
@@ -247,7 +251,8 @@ class ThriftConfigApplier {
         aclNexthopHandler_(aclNexthopHandler),
         scopeResolver_(getSwitchInfoFromConfig(config)),
         platformMapping_(platformMapping),
-        hwAsicTable_(hwAsicTable) {}
+        hwAsicTable_(hwAsicTable),
+        appliedSections_(appliedSections) {}
 
   std::shared_ptr<SwitchState> run();
 
@@ -570,6 +575,14 @@ class ThriftConfigApplier {
       std::shared_ptr<SwitchSettings> switchSettings);
   QueueConfig getVoqConfig(PortID portId);
 
+  // Incremental config application helpers
+  static std::vector<std::shared_ptr<const void>> sectionStateNodes(
+      ConfigSection section,
+      const SwitchState& state);
+  void computeSectionFingerprints();
+  bool isSectionUnchanged(ConfigSection section) const;
+  void recordAppliedSections(const SwitchState& appliedState);
+
   std::shared_ptr<SwitchState> orig_;
   std::shared_ptr<SwitchState> new_;
   const cfg::SwitchConfig* cfg_{nullptr};
@@ -580,6 +593,9 @@ class ThriftConfigApplier {
   SwitchIdScopeResolver scopeResolver_;
   const PlatformMapping* platformMapping_{nullptr};
   const HwAsicTable* hwAsicTable_{nullptr};
+  AppliedConfigSections* appliedSections_{nullptr};
+  std::array<uint64_t, AppliedConfigSections::kNumSections>
+      sectionFingerprints_{};
 
   struct InterfaceIpInfo {
     InterfaceIpInfo(uint8_t mask, MacAddress mac, InterfaceID intf)
@@ -604,8 +620,9 @@ class ThriftConfigApplier {
 shared_ptr<SwitchState> ThriftConfigApplier::run() {
   new_ = orig_->clone();
   bool changed = false;
+  computeSectionFingerprints();
 
-  {
+  if (!isSectionUnchanged(ConfigSection::CONTROL_PLANE)) {
     auto newControlPlane = updateControlPlane();
     if (newControlPlane) {
       new_->resetControlPlane(std::move(newControlPlane));
@@ -642,7 +659,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
 
   processInterfaceForPort();
 
-  {
+  if (!isSectionUnchanged(ConfigSection::PORTS)) {
     auto newPorts = updatePorts(new_->getTransceivers());
     if (newPorts) {
       new_->resetPorts(
@@ -656,7 +673,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
     }
   }
 
-  {
+  if (!isSectionUnchanged(ConfigSection::AGGREGATE_PORTS)) {
     auto newAggPorts = updateAggregatePorts();
     if (newAggPorts) {
       new_->resetAggregatePorts(toMultiSwitchMap<MultiSwitchAggregatePortMap>(
@@ -666,7 +683,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
   }
 
   // updateMirrors must be called after updatePorts, mirror needs ports!
-  {
+  if (!isSectionUnchanged(ConfigSection::MIRRORS)) {
     auto newMirrors = updateMirrors();
     if (newMirrors) {
       new_->resetMirrors(
@@ -676,7 +693,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
   }
 
   // updateAcls must be called after updateMirrors, acls may need mirror!
-  {
+  if (!isSectionUnchanged(ConfigSection::ACLS)) {
     if (FLAGS_enable_acl_table_group) {
       auto newAclTableGroups = updateAclTableGroups();
       if (newAclTableGroups) {
@@ -694,7 +711,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
     }
   }
 
-  {
+  if (!isSectionUnchanged(ConfigSection::QOS_POLICIES)) {
     auto newQosPolicies = updateQosPolicies();
     if (newQosPolicies) {
       new_->resetQosPolicies(toMultiSwitchMap<MultiSwitchQosPolicyMap>(
@@ -809,7 +826,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
   }
 
   // Add sFlow collectors
-  {
+  if (!isSectionUnchanged(ConfigSection::SFLOW_COLLECTORS)) {
     auto newCollectors = updateSflowCollectors();
     if (newCollectors) {
       new_->resetSflowCollectors(toMultiSwitchMap<MultiSwitchSflowCollectorMap>(
@@ -829,7 +846,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
     }
   }
 
-  {
+  if (!isSectionUnchanged(ConfigSection::LOAD_BALANCERS)) {
     LoadBalancerConfigApplier loadBalancerConfigApplier(
         orig_->getLoadBalancers(), cfg_->get_loadBalancers());
     auto newLoadBalancers = loadBalancerConfigApplier.updateLoadBalancers(
@@ -842,7 +859,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
     }
   }
 
-  {
+  if (!isSectionUnchanged(ConfigSection::IP_IN_IP_TUNNELS)) {
     auto newTunnels = updateIpInIpTunnels();
     if (newTunnels) {
       new_->resetTunnels(
@@ -888,11 +905,107 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
   }
 
   if (!changed) {
+    recordAppliedSections(*orig_);
     return nullptr;
   }
+  recordAppliedSections(*new_);
   return new_;
 }
 
+void ThriftConfigApplier::computeSectionFingerprints() {
+  if (!appliedSections_) {
+    return;
+  }
+  for (size_t i = 0; i < AppliedConfigSections::kNumSections; ++i) {
+    sectionFingerprints_[i] =
+        configSectionFingerprint(*cfg_, static_cast<ConfigSection>(i));
+  }
+}
+
+std::vector<std::shared_ptr<const void>> ThriftConfigApplier::sectionStateNodes(
+    ConfigSection section,
+    const SwitchState& state) {
+  switch (section) {
+    case ConfigSection::CONTROL_PLANE:
+      return {state.getControlPlane(), state.getSwitchSettings()};
+    case ConfigSection::PORTS:
+      return {
+          state.getPorts(),
+          state.getSystemPorts(),
+          state.getRemoteSystemPorts(),
+          state.getTransceivers(),
+          state.getSwitchSettings(),
+          state.getBufferPoolCfgs(),
+          state.getPortFlowletCfgs()};
+    case ConfigSection::AGGREGATE_PORTS:
+      return {
+          state.getAggregatePorts(),
+          state.getPorts(),
+          state.getSwitchSettings()};
+    case ConfigSection::MIRRORS:
+      return {state.getMirrors(), state.getPorts(), state.getSwitchSettings()};
+    case ConfigSection::ACLS:
+      return {
+          state.getAcls(),
+          state.getAclTableGroups(),
+          state.getMirrors(),
+          state.getSwitchSettings()};
+    case ConfigSection::QOS_POLICIES:
+      return {state.getQosPolicies(), state.getSwitchSettings()};
+    case ConfigSection::SFLOW_COLLECTORS:
+      return {state.getSflowCollectors()};
+    case ConfigSection::LOAD_BALANCERS:
+      return {state.getLoadBalancers(), state.getSwitchSettings()};
+    case ConfigSection::IP_IN_IP_TUNNELS:
+      return {state.getTunnels()};
+    case ConfigSection::NUM_SECTIONS:
+      break;
+  }
+  throw FbossError("Unknown config section: ", static_cast<int>(section));
+}
+
+bool ThriftConfigApplier::isSectionUnchanged(ConfigSection section) const {
+  if (!appliedSections_) {
+    return false;
+  }
+  const auto idx = static_cast<size_t>(section);
+  const auto& applied = appliedSections_->sections_[idx];
+  if (!applied.fingerprint.has_value() ||
+      *applied.fingerprint != sectionFingerprints_[idx]) {
+    return false;
+  }
+  // Sections also read switch state which may have been changed outside of
+  // config application (e.g. by thrift calls or by earlier sections of this
+  // very config application), so only skip if those nodes are untouched.
+  auto stateNodes = sectionStateNodes(section, *new_);
+  if (stateNodes.size() != applied.stateNodes.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < stateNodes.size(); ++i) {
+    if (applied.stateNodes[i].lock() != stateNodes[i]) {
+      return false;
+    }
+  }
+  XLOG(DBG2) << "Skipping unchanged config section " << idx;
+  return true;
+}
+
+void ThriftConfigApplier::recordAppliedSections(
+    const SwitchState& appliedState) {
+  if (!appliedSections_) {
+    return;
+  }
+  for (size_t i = 0; i < AppliedConfigSections::kNumSections; ++i) {
+    auto& applied = appliedSections_->sections_[i];
+    applied.fingerprint = sectionFingerprints_[i];
+    applied.stateNodes.clear();
+    for (const auto& node :
+         sectionStateNodes(static_cast<ConfigSection>(i), appliedState)) {
+      applied.stateNodes.emplace_back(node);
+    }
+  }
+}
+
 std::optional<SwitchID> ThriftConfigApplier::getAnyVoqSwitchId() {
   std::optional<SwitchID> switchId;
   for (const auto& switchIdAndSwitchInfo :
@@ -5732,6 +5845,90 @@ void ThriftConfigApplier::addRemoteIntfRoute() {
   }
 }
 
+uint64_t configSectionFingerprint(
+    const cfg::SwitchConfig& config,
+    ConfigSection section) {
+  // Copy just the fields the section reads into an otherwise default config
+  // and hash its serialized form.
+  cfg::SwitchConfig inputs;
+  switch (section) {
+    case ConfigSection::CONTROL_PLANE:
+      inputs.cpuQueues().copy_from(config.cpuQueues());
+      inputs.cpuVoqs().copy_from(config.cpuVoqs());
+      inputs.cpuTrafficPolicy().copy_from(config.cpuTrafficPolicy());
+      inputs.dataPlaneTrafficPolicy().copy_from(
+          config.dataPlaneTrafficPolicy());
+      inputs.qosPolicies().copy_from(config.qosPolicies());
+      inputs.defaultPortQueues().copy_from(config.defaultPortQueues());
+      inputs.switchSettings().copy_from(config.switchSettings());
+      break;
+    case ConfigSection::PORTS:
+      inputs.ports().copy_from(config.ports());
+      inputs.vlanPorts().copy_from(config.vlanPorts());
+      inputs.interfaces().copy_from(config.interfaces());
+      inputs.dsfNodes().copy_from(config.dsfNodes());
+      inputs.switchSettings().copy_from(config.switchSettings());
+      inputs.portQueueConfigs().copy_from(config.portQueueConfigs());
+      inputs.portPgConfigs().copy_from(config.portPgConfigs());
+      inputs.portFlowletConfigs().copy_from(config.portFlowletConfigs());
+      inputs.bufferPoolConfigs().copy_from(config.bufferPoolConfigs());
+      inputs.defaultPortQueues().copy_from(config.defaultPortQueues());
+      inputs.defaultVoqConfig().copy_from(config.defaultVoqConfig());
+      inputs.qosPolicies().copy_from(config.qosPolicies());
+      inputs.dataPlaneTrafficPolicy().copy_from(
+          config.dataPlaneTrafficPolicy());
+      break;
+    case ConfigSection::AGGREGATE_PORTS:
+      inputs.aggregatePorts().copy_from(config.aggregatePorts());
+      inputs.lacp().copy_from(config.lacp());
+      inputs.ports().copy_from(config.ports());
+      inputs.switchSettings().copy_from(config.switchSettings());
+      break;
+    case ConfigSection::MIRRORS:
+      inputs.mirrors().copy_from(config.mirrors());
+      inputs.ports().copy_from(config.ports());
+      inputs.interfaces().copy_from(config.interfaces());
+      inputs.mirrorOnDropReports().copy_from(config.mirrorOnDropReports());
+      inputs.switchSettings().copy_from(config.switchSettings());
+      break;
+    case ConfigSection::ACLS:
+      inputs.acls().copy_from(config.acls());
+      inputs.aclTableGroup().copy_from(config.aclTableGroup());
+      inputs.aclTableGroups().copy_from(config.aclTableGroups());
+      inputs.cpuTrafficPolicy().copy_from(config.cpuTrafficPolicy());
+      inputs.dataPlaneTrafficPolicy().copy_from(
+          config.dataPlaneTrafficPolicy());
+      inputs.trafficCounters().copy_from(config.trafficCounters());
+      inputs.udfConfig().copy_from(config.udfConfig());
+      inputs.mirrors().copy_from(config.mirrors());
+      inputs.switchSettings().copy_from(config.switchSettings());
+      break;
+    case ConfigSection::QOS_POLICIES:
+      inputs.qosPolicies().copy_from(config.qosPolicies());
+      inputs.dataPlaneTrafficPolicy().copy_from(
+          config.dataPlaneTrafficPolicy());
+      break;
+    case ConfigSection::SFLOW_COLLECTORS:
+      inputs.sFlowCollectors().copy_from(config.sFlowCollectors());
+      break;
+    case ConfigSection::LOAD_BALANCERS:
+      inputs.loadBalancers().copy_from(config.loadBalancers());
+      inputs.sdkVersion().copy_from(config.sdkVersion());
+      inputs.udfConfig().copy_from(config.udfConfig());
+      inputs.switchSettings().copy_from(config.switchSettings());
+      break;
+    case ConfigSection::IP_IN_IP_TUNNELS:
+      inputs.ipInIpTunnels().copy_from(config.ipInIpTunnels());
+      break;
+    case ConfigSection::NUM_SECTIONS:
+      throw FbossError("Unknown config section: ", static_cast<int>(section));
+  }
+  auto serialized =
+      apache::thrift::CompactSerializer::serialize<std::string>(inputs);
+  return folly::hash::SpookyHashV2::Hash64(
+      serialized.data(), serialized.size(), 0 /* seed */);
+}
+
 std::shared_ptr<SwitchState> applyThriftConfig(
     const std::shared_ptr<SwitchState>& state,
     const cfg::SwitchConfig* config,
@@ -5739,7 +5936,8 @@ std::shared_ptr<SwitchState> applyThriftConfig(
     const PlatformMapping* platformMapping,
     const HwAsicTable* hwAsicTable,
     RoutingInformationBase* rib,
-    AclNexthopHandler* aclNexthopHandler) {
+    AclNexthopHandler* aclNexthopHandler,
+    AppliedConfigSections* appliedSections) {
   return ThriftConfigApplier(
              state,
              config,
@@ -5747,7 +5945,8 @@ std::shared_ptr<SwitchState> applyThriftConfig(
              rib,
              aclNexthopHandler,
              platformMapping,
-             hwAsicTable)
+             hwAsicTable,
+             appliedSections)
       .run();
 }
 
@@ -5758,7 +5957,8 @@ std::shared_ptr<SwitchState> applyThriftConfig(
     const PlatformMapping* platformMapping,
     const HwAsicTable* hwAsicTable,
     RouteUpdateWrapper* routeUpdater,
-    AclNexthopHandler* aclNexthopHandler) {
+    AclNexthopHandler* aclNexthopHandler,
+    AppliedConfigSections* appliedSections) {
   return ThriftConfigApplier(
              state,
              config,
@@ -5766,7 +5966,8 @@ std::shared_ptr<SwitchState> applyThriftConfig(
              routeUpdater,
              aclNexthopHandler,
              platformMapping,
-             hwAsicTable)
+             hwAsicTable,
+             appliedSections)
       .run();
 }
 
@@ -10,7 +10,11 @@
 #pragma once
 
 #include <folly/Range.h>
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <vector>
 
 namespace facebook::fboss {
 
@@ -26,12 +30,77 @@ class RouteUpdateWrapper;
 class AclNexthopHandler;
 class PlatformMapping;
 class HwAsicTable;
+class ThriftConfigApplier;
+
+/*
+ * Sections of the config that applyThriftConfig() can skip when neither the
+ * config fields they are derived from nor the switch state nodes they read
+ * and write changed since the last successful config application.
+ */
+enum class ConfigSection : uint8_t {
+  CONTROL_PLANE,
+  PORTS,
+  AGGREGATE_PORTS,
+  MIRRORS,
+  ACLS,
+  QOS_POLICIES,
+  SFLOW_COLLECTORS,
+  LOAD_BALANCERS,
+  IP_IN_IP_TUNNELS,
+  NUM_SECTIONS,
+};
+
+/*
+ * Per section fingerprints recorded by applyThriftConfig().
+ *
+ * Callers that keep this around and pass it back in on the next
+ * applyThriftConfig() call get incremental config application. A default
+ * constructed instance has no fingerprints and forces every section to be
+ * processed. It must only be passed back in for a state derived from the
+ * state the previous call returned (or the original state, if it returned
+ * null).
+ */
+class AppliedConfigSections {
+ public:
+  static constexpr size_t kNumSections =
+      static_cast<size_t>(ConfigSection::NUM_SECTIONS);
+
+  std::optional<uint64_t> getFingerprint(ConfigSection section) const {
+    return sections_[static_cast<size_t>(section)].fingerprint;
+  }
+
+  void clear() {
+    sections_ = {};
+  }
+
+ private:
+  friend class ThriftConfigApplier;
+
+  struct Section {
+    std::optional<uint64_t> fingerprint;
+    // Identity of the switch state nodes the section was applied against.
+    // Held weakly so that fingerprints never keep old state alive.
+    std::vector<std::weak_ptr<const void>> stateNodes;
+  };
+  std::array<Section, kNumSections> sections_;
+};
+
+/*
+ * Fingerprint of the config fields a given section is derived from.
+ */
+uint64_t configSectionFingerprint(
+    const cfg::SwitchConfig& config,
+    ConfigSection section);
 
 /*
  * Apply a thrift config structure to a SwitchState object.
  *
  * Returns a new SwitchState object with the resulting state, or null if
  * the config file results in no changes.
+ *
+ * If appliedSections is given, sections whose fingerprint and state match
+ * the previous application are skipped, and appliedSections is updated with
+ * the fingerprints of this application.
  */
 
 std::shared_ptr<SwitchState> applyThriftConfig(
@@ -41,7 +110,8 @@ std::shared_ptr<SwitchState> applyThriftConfig(
     const PlatformMapping* platformMapping,
     const HwAsicTable* hwAsicTable,
     RoutingInformationBase* rib = nullptr,
-    AclNexthopHandler* aclNexthopHandler = nullptr);
+    AclNexthopHandler* aclNexthopHandler = nullptr,
+    AppliedConfigSections* appliedSections = nullptr);
 
 std::shared_ptr<SwitchState> applyThriftConfig(
     const std::shared_ptr<SwitchState>& state,
@@ -50,6 +120,7 @@ std::shared_ptr<SwitchState> applyThriftConfig(
     const PlatformMapping* platformMapping,
     const HwAsicTable* hwAsicTable,
     RouteUpdateWrapper* routeUpdater,
-    AclNexthopHandler* aclNexthopHandler = nullptr);
+    AclNexthopHandler* aclNexthopHandler = nullptr,
+    AppliedConfigSections* appliedSections = nullptr);
 
 } // namespace facebook::fboss
@@ -0,0 +1,138 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/FibLpmSnapshot.h"
+
+#include <mutex>
+
+#include <folly/synchronization/Rcu.h>
+
+#include "fboss/agent/state/DeltaFunctions.h"
+#include "fboss/agent/state/StateDelta.h"
+#include "fboss/agent/state/SwitchState.h"
+
+namespace facebook::fboss {
+
+FibLpmSnapshot::FibLpmSnapshot() : vrfs_(new VrfMap()) {}
+
+FibLpmSnapshot::~FibLpmSnapshot() {
+  // No lookups left, retired maps only hold shared tables
+  delete vrfs_.load();
+}
+
+void FibLpmSnapshot::stateUpdated(const StateDelta& delta) {
+  // Lookups miss until the tables are all published
+  generation_.store(kUpdating, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  const auto* oldVrfs = vrfs_.load(std::memory_order_relaxed);
+  std::unique_ptr<VrfMap> newVrfs;
+  auto vrfsToUpdate = [&]() -> VrfMap& {
+    if (!newVrfs) {
+      newVrfs = std::make_unique<VrfMap>(*oldVrfs);
+    }
+    return *newVrfs;
+  };
+  std::vector<std::shared_ptr<VrfTables>> updated;
+
+  for (const auto& routeDelta : delta.getFibsDelta()) {
+    if (!routeDelta.getNew()) {
+      vrfsToUpdate().erase(routeDelta.getOld()->getID());
+      continue;
+    }
+    auto vrf = routeDelta.getNew()->getID();
+    auto it = oldVrfs->find(vrf);
+    std::shared_ptr<VrfTables> tables;
+    if (it != oldVrfs->end()) {
+      tables = it->second;
+    } else {
+      tables = std::make_shared<VrfTables>();
+      vrfsToUpdate().emplace(vrf, tables);
+    }
+    auto processRoutesDelta = [](const auto& fibDelta, auto& table) {
+      DeltaFunctions::forEachChanged(
+          fibDelta,
+          [&](const auto& /*oldRoute*/, const auto& newRoute) {
+            table.insert(
+                newRoute->prefix().network(),
+                newRoute->prefix().mask(),
+                newRoute);
+          },
+          [&](const auto& addedRoute) {
+            table.insert(
+                addedRoute->prefix().network(),
+                addedRoute->prefix().mask(),
+                addedRoute);
+          },
+          [&](const auto& removedRoute) {
+            table.erase(
+                removedRoute->prefix().network(),
+                removedRoute->prefix().mask());
+          });
+    };
+    processRoutesDelta(
+        routeDelta.getFibDelta<folly::IPAddressV4>(), tables->v4);
+    processRoutesDelta(
+        routeDelta.getFibDelta<folly::IPAddressV6>(), tables->v6);
+    updated.push_back(std::move(tables));
+  }
+
+  for (const auto& tables : updated) {
+    tables->v4.publish();
+    tables->v6.publish();
+  }
+  if (newVrfs) {
+    vrfs_.store(newVrfs.release(), std::memory_order_release);
+    folly::rcu_retire(const_cast<VrfMap*>(oldVrfs));
+  }
+  generation_.store(
+      delta.newState()->getGeneration(), std::memory_order_release);
+}
+
+template <typename AddrT>
+std::optional<std::shared_ptr<Route<AddrT>>> FibLpmSnapshot::longestMatch(
+    const std::shared_ptr<SwitchState>& state,
+    const AddrT& addr,
+    RouterID vrf) const {
+  auto generation = generation_.load(std::memory_order_acquire);
+  if (generation != state->getGeneration()) {
+    return std::nullopt;
+  }
+  std::optional<std::shared_ptr<Route<AddrT>>> route;
+  {
+    std::scoped_lock<folly::rcu_domain> guard(folly::rcu_default_domain());
+    const auto* vrfs = vrfs_.load(std::memory_order_acquire);
+    auto it = vrfs->find(vrf);
+    if (it != vrfs->end()) {
+      if constexpr (std::is_same_v<AddrT, folly::IPAddressV4>) {
+        route = it->second->v4.longestMatch(addr);
+      } else {
+        route = it->second->v6.longestMatch(addr);
+      }
+    }
+  }
+  // Tables may have moved on to the next state during the lookup
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (generation_.load(std::memory_order_relaxed) != generation) {
+    return std::nullopt;
+  }
+  return route ? std::move(*route) : nullptr;
+}
+
+template std::optional<std::shared_ptr<Route<folly::IPAddressV4>>>
+FibLpmSnapshot::longestMatch(
+    const std::shared_ptr<SwitchState>& state,
+    const folly::IPAddressV4& addr,
+    RouterID vrf) const;
+template std::optional<std::shared_ptr<Route<folly::IPAddressV6>>>
+FibLpmSnapshot::longestMatch(
+    const std::shared_ptr<SwitchState>& state,
+    const folly::IPAddressV6& addr,
+    RouterID vrf) const;
+
+} // namespace facebook::fboss
@@ -0,0 +1,80 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <optional>
+
+#include <folly/IPAddressV4.h>
+#include <folly/IPAddressV6.h>
+#include <folly/container/F14Map.h>
+
+#include "fboss/agent/state/Route.h"
+#include "fboss/agent/types.h"
+#include "fboss/lib/RcuLpmTable.h"
+
+namespace facebook::fboss {
+
+class StateDelta;
+class SwitchState;
+
+/*
+ * Copy of the FIB for route lookups from the packet rx path. Lookups take
+ * no lock and never wait for the update thread, which applies each state
+ * delta and publishes it as a whole.
+ *
+ * Since it is built from the FIB, lookups only return resolved routes, the
+ * same ones programmed in hardware. Unlike a RIB lookup, an address covered
+ * by an unresolved more specific route matches the less specific resolved
+ * route that hardware forwards it with.
+ *
+ * This is a second full copy of the FIB, next to the one in the switch
+ * state, traded for lookups that don't probe each prefix length.
+ */
+class FibLpmSnapshot {
+ public:
+  FibLpmSnapshot();
+  ~FibLpmSnapshot();
+
+  // From the update thread only
+  void stateUpdated(const StateDelta& delta);
+
+  /*
+   * Longest match in the FIB of state, nullptr if there is none. Returns
+   * nullopt if the snapshot was not built from state (state not yet applied
+   * here, or already replaced), so the route never comes from a different
+   * state than the one the caller looks up interfaces and neighbors in.
+   */
+  template <typename AddrT>
+  std::optional<std::shared_ptr<Route<AddrT>>> longestMatch(
+      const std::shared_ptr<SwitchState>& state,
+      const AddrT& addr,
+      RouterID vrf) const;
+
+ private:
+  template <typename AddrT>
+  using Table = network::RcuLpmTable<AddrT, std::shared_ptr<Route<AddrT>>>;
+
+  struct VrfTables {
+    Table<folly::IPAddressV4> v4;
+    Table<folly::IPAddressV6> v6;
+  };
+  // Replaced whenever a VRF is added or removed, tables are shared
+  using VrfMap = folly::F14FastMap<RouterID, std::shared_ptr<VrfTables>>;
+
+  std::atomic<const VrfMap*> vrfs_;
+  // Generation of the state the tables were built from, kUpdating while
+  // a delta is being applied
+  static constexpr int64_t kUpdating = -1;
+  std::atomic<int64_t> generation_{kUpdating};
+};
+
+} // namespace facebook::fboss
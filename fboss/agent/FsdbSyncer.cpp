@@ -12,10 +12,17 @@
 #include "fboss/fsdb/common/Flags.h"
 #include "fboss/fsdb/if/gen-cpp2/fsdb_common_types.h"
 #include "fboss/fsdb/if/gen-cpp2/fsdb_oper_types.h"
+#include "fboss/thrift_cow/visitors/ThriftObjectPatchBuilder.h"
 
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 #include <optional>
 
+DEFINE_bool(
+    publish_stats_patch_to_fsdb,
+    true,
+    "Publish agent stats to fsdb as patches of the counters that changed "
+    "since the last publish, instead of the whole stats");
+
 namespace {
 
 const thriftpath::RootThriftPath<facebook::fboss::fsdb::FsdbOperStateRoot>
@@ -58,10 +65,16 @@ FsdbSyncer::FsdbSyncer(SwSwitch* sw)
       std::make_unique<AgentFsdbSyncManager>(fsdbPubSubMgr_);
 
   if (FLAGS_publish_stats_to_fsdb) {
-    fsdbPubSubMgr_->createStatPathPublisher(
-        getAgentStatsPath(), [this](auto oldState, auto newState) {
-          fsdbStatPublisherStateChanged(oldState, newState);
-        });
+    auto stateChangeCb = [this](auto oldState, auto newState) {
+      fsdbStatPublisherStateChanged(oldState, newState);
+    };
+    if (FLAGS_publish_stats_patch_to_fsdb) {
+      fsdbPubSubMgr_->createStatPatchPublisher(
+          getAgentStatsPath(), std::move(stateChangeCb));
+    } else {
+      fsdbPubSubMgr_->createStatPathPublisher(
+          getAgentStatsPath(), std::move(stateChangeCb));
+    }
   }
 }
 
@@ -118,10 +131,24 @@ void FsdbSyncer::switchReachabilityChanged(
       switchId, std::move(newReachability));
 }
 
-void FsdbSyncer::statsUpdated(const AgentStats& stats) {
+void FsdbSyncer::statsUpdated(AgentStats stats) {
   if (!readyForStatPublishing_.load()) {
     return;
   }
+  if (FLAGS_publish_stats_patch_to_fsdb) {
+    // FSDB only has to apply and serve the changed counters, instead of
+    // diffing the whole stats tree every interval
+    auto patch = publishFullStats_.exchange(false) || !publishedStats_
+        ? thrift_cow::ThriftObjectPatchBuilder::buildFull(
+              stats, getAgentStatsPath())
+        : thrift_cow::ThriftObjectPatchBuilder::build(
+              *publishedStats_, stats, getAgentStatsPath());
+    publishedStats_ = std::move(stats);
+    if (patch.patch()->getType() != thrift_cow::PatchNode::Type::__EMPTY__) {
+      fsdbPubSubMgr_->publishStat(std::move(patch));
+    }
+    return;
+  }
   fsdb::OperState stateUnit;
   stateUnit.contents() =
       apache::thrift::BinarySerializer::serialize<std::string>(stats);
@@ -136,6 +163,7 @@ void FsdbSyncer::fsdbStatPublisherStateChanged(
   if (newState == fsdb::FsdbStreamClient::State::CONNECTED) {
     // Stats sync at regular intervals, so let the sync
     // happen in that sequence after a connection.
+    publishFullStats_.store(true);
     readyForStatPublishing_.store(true);
   } else {
     readyForStatPublishing_.store(false);
@@ -8,6 +8,7 @@
 #include "fboss/fsdb/client/FsdbStreamClient.h"
 
 #include <memory>
+#include <optional>
 
 namespace facebook::fboss {
 class SwSwitch;
@@ -26,7 +27,7 @@ class FsdbSyncer {
   explicit FsdbSyncer(SwSwitch* sw);
   ~FsdbSyncer();
   void stateUpdated(const StateDelta& stateDelta);
-  void statsUpdated(const AgentStats& stats);
+  void statsUpdated(AgentStats stats);
 
   // TODO - change to AgentConfig once SwSwitch can pass us that
   void cfgUpdated(
@@ -73,6 +74,10 @@ class FsdbSyncer {
   std::shared_ptr<fsdb::FsdbPubSubManager> fsdbPubSubMgr_;
   std::atomic<bool> readyForStatePublishing_{false};
   std::atomic<bool> readyForStatPublishing_{false};
+  // Stats are published as patches against the last published stats,
+  // except for the first publish after (re)connecting
+  std::atomic<bool> publishFullStats_{true};
+  std::optional<AgentStats> publishedStats_;
   std::unique_ptr<AgentFsdbSyncManager> agentFsdbSyncManager_;
 };
 
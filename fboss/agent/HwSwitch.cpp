@@ -19,6 +19,7 @@
 #include "fboss/agent/state/StateDelta.h"
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/state/TransceiverMap.h"
+#include "fboss/lib/FunctionCallTimeReporter.h"
 #include "fboss/lib/HwWriteBehavior.h"
 
 #include <fb303/ThreadCachedServiceData.h>
@@ -261,7 +262,11 @@ fsdb::OperDelta HwSwitch::stateChanged(
     const fsdb::OperDelta& delta,
     const HwWriteBehaviorRAII& /*behavior*/) {
   auto stateDelta = StateDelta(getProgrammedState(), delta);
-  auto state = stateChangedImpl(stateDelta);
+  std::shared_ptr<SwitchState> state;
+  {
+    ScopedStageTimer stageTimer(CallTimeStage::HW_SWITCH);
+    state = stateChangedImpl(stateDelta);
+  }
   setProgrammedState(state);
   if (getProgrammedState() == stateDelta.newState()) {
     return fsdb::OperDelta{};
@@ -0,0 +1,325 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/HwSwitchStatsDelta.h"
+
+#include <ctime>
+#include <string_view>
+#include <type_traits>
+
+#include <thrift/lib/cpp2/op/Get.h>
+
+#include "fboss/agent/FbossError.h"
+
+namespace {
+
+namespace op = apache::thrift::op;
+namespace type = apache::thrift::type;
+
+// Counters can wrap or be reset, deltas wrap around rather than overflow
+int64_t wrappingAdd(int64_t lhs, int64_t rhs) {
+  return static_cast<int64_t>(
+      static_cast<uint64_t>(lhs) + static_cast<uint64_t>(rhs));
+}
+
+int64_t wrappingSub(int64_t lhs, int64_t rhs) {
+  return static_cast<int64_t>(
+      static_cast<uint64_t>(lhs) - static_cast<uint64_t>(rhs));
+}
+
+using QueueCountersTag = type::map<type::i16_t, type::i64_t>;
+
+template <typename Tag>
+constexpr bool kIsCounter =
+    type::is_a_v<Tag, type::integral_c> && !std::is_same_v<Tag, type::bool_t>;
+
+template <typename StatsT, typename Id>
+constexpr int32_t counterKey(int16_t queue = 0) {
+  return (static_cast<int32_t>(op::get_field_id_v<StatsT, Id>) << 16) |
+      static_cast<uint16_t>(queue);
+}
+
+/*
+ * Appends the counter deltas from previous to current. False if they differ
+ * in anything else: optional fields set or unset, per queue maps with
+ * different queues, or non integer fields.
+ */
+template <typename StatsT>
+bool diffCounters(
+    const StatsT& previous,
+    const StatsT& current,
+    facebook::fboss::multiswitch::HwStatsEntryDelta& delta) {
+  bool countersOnly = true;
+  auto add = [&](int32_t key, int64_t change) {
+    delta.counterKeys()->push_back(key);
+    delta.counterDeltas()->push_back(change);
+  };
+  op::for_each_field_id<StatsT>([&]<class Id>(Id) {
+    if (!countersOnly) {
+      return;
+    }
+    using Tag = op::get_type_tag<StatsT, Id>;
+    const auto* prev = op::getValueOrNull(op::get<Id, StatsT>(previous));
+    const auto* cur = op::getValueOrNull(op::get<Id, StatsT>(current));
+    if (!prev || !cur) {
+      countersOnly = !prev && !cur;
+      return;
+    }
+    if constexpr (std::is_same_v<Tag, QueueCountersTag>) {
+      if (prev->size() != cur->size()) {
+        countersOnly = false;
+        return;
+      }
+      for (const auto& [queue, counter] : *cur) {
+        auto it = prev->find(queue);
+        if (it == prev->end()) {
+          countersOnly = false;
+          return;
+        }
+        if (it->second != counter) {
+          add(counterKey<StatsT, Id>(queue), wrappingSub(counter, it->second));
+        }
+      }
+    } else if constexpr (kIsCounter<Tag>) {
+      if (*prev != *cur) {
+        add(counterKey<StatsT, Id>(),
+            wrappingSub(
+                static_cast<int64_t>(*cur), static_cast<int64_t>(*prev)));
+      }
+    } else if (!(*prev == *cur)) {
+      countersOnly = false;
+    }
+  });
+  return countersOnly;
+}
+
+template <typename StatsT>
+void applyCounters(
+    StatsT& stats,
+    const facebook::fboss::multiswitch::HwStatsEntryDelta& delta) {
+  if (delta.counterKeys()->size() != delta.counterDeltas()->size()) {
+    throw facebook::fboss::FbossError("Counter keys and deltas mismatch");
+  }
+  for (size_t i = 0; i < delta.counterKeys()->size(); ++i) {
+    auto key = delta.counterKeys()->at(i);
+    auto change = delta.counterDeltas()->at(i);
+    auto fieldId = static_cast<int16_t>(static_cast<uint32_t>(key) >> 16);
+    auto queue = static_cast<int16_t>(key & 0xffff);
+    bool applied = false;
+    op::for_each_field_id<StatsT>([&]<class Id>(Id) {
+      using Tag = op::get_type_tag<StatsT, Id>;
+      if (applied ||
+          static_cast<int16_t>(op::get_field_id_v<StatsT, Id>) != fieldId) {
+        return;
+      }
+      auto* value = op::getValueOrNull(op::get<Id, StatsT>(stats));
+      if (!value) {
+        return;
+      }
+      if constexpr (std::is_same_v<Tag, QueueCountersTag>) {
+        auto it = value->find(queue);
+        if (it != value->end()) {
+          it->second = wrappingAdd(it->second, change);
+          applied = true;
+        }
+      } else if constexpr (kIsCounter<Tag>) {
+        using ValueT = std::remove_reference_t<decltype(*value)>;
+        *value = static_cast<ValueT>(
+            wrappingAdd(static_cast<int64_t>(*value), change));
+        applied = true;
+      }
+    });
+    if (!applied) {
+      throw facebook::fboss::FbossError(
+          "Counter delta for unknown counter, field ", fieldId, " queue ",
+          queue);
+    }
+  }
+}
+
+// HwSwitchStats without the port and system port stats
+facebook::fboss::multiswitch::HwSwitchStats otherStats(
+    const facebook::fboss::multiswitch::HwSwitchStats& stats) {
+  using HwSwitchStats = facebook::fboss::multiswitch::HwSwitchStats;
+  HwSwitchStats other;
+  op::for_each_field_id<HwSwitchStats>([&]<class Id>(Id) {
+    constexpr std::string_view field = op::get_name_v<HwSwitchStats, Id>;
+    if constexpr (field != "hwPortStats" && field != "sysPortStats") {
+      op::get<Id, HwSwitchStats>(other).copy_from(
+          op::get<Id, HwSwitchStats>(stats));
+    }
+  });
+  return other;
+}
+
+} // namespace
+
+namespace facebook::fboss {
+
+template <typename StatsT, typename MapT>
+void HwSwitchStatsDeltaEncoder::encodeEntries(
+    const MapT& current,
+    folly::F14FastMap<std::string, StatsT>& previous,
+    folly::F14FastMap<std::string, int32_t>& indices,
+    std::map<int32_t, std::string>& newNames,
+    std::map<int32_t, multiswitch::HwStatsEntryDelta>& deltas,
+    std::map<int32_t, StatsT>& whole,
+    std::vector<int32_t>& removed) {
+  for (const auto& [name, stats] : current) {
+    auto [index, inserted] = indices.emplace(name, nextIndex_);
+    if (inserted) {
+      newNames.emplace(nextIndex_++, name);
+    }
+    auto prev = previous.find(name);
+    if (prev == previous.end()) {
+      whole.emplace(index->second, stats);
+      previous.emplace(name, stats);
+      continue;
+    }
+    multiswitch::HwStatsEntryDelta delta;
+    if (!diffCounters(prev->second, stats, delta)) {
+      whole.emplace(index->second, stats);
+    } else if (!delta.counterKeys()->empty()) {
+      deltas.emplace(index->second, std::move(delta));
+    } else {
+      continue;
+    }
+    prev->second = stats;
+  }
+  if (previous.size() == current.size()) {
+    return;
+  }
+  std::vector<std::string> removedNames;
+  for (const auto& [name, _] : previous) {
+    if (current.find(name) == current.end()) {
+      removedNames.push_back(name);
+    }
+  }
+  for (const auto& name : removedNames) {
+    auto index = indices.find(name);
+    removed.push_back(index->second);
+    indices.erase(index);
+    previous.erase(name);
+  }
+}
+
+multiswitch::HwSwitchStatsDelta HwSwitchStatsDeltaEncoder::encode(
+    const multiswitch::HwSwitchStats& stats) {
+  multiswitch::HwSwitchStatsDelta delta;
+  delta.timestamp() = *stats.timestamp();
+  if (!snapshotSent_) {
+    portIndices_.clear();
+    sysPortIndices_.clear();
+    lastPortStats_.clear();
+    lastSysPortStats_.clear();
+    delta.fullSnapshot() = true;
+    snapshotSent_ = true;
+  }
+  encodeEntries(
+      *stats.hwPortStats(),
+      lastPortStats_,
+      portIndices_,
+      *delta.newPortNames(),
+      *delta.hwPortStatsDelta(),
+      *delta.hwPortStats(),
+      *delta.removedPorts());
+  encodeEntries(
+      *stats.sysPortStats(),
+      lastSysPortStats_,
+      sysPortIndices_,
+      *delta.newSysPortNames(),
+      *delta.sysPortStatsDelta(),
+      *delta.sysPortStats(),
+      *delta.removedSysPorts());
+
+  auto other = otherStats(stats);
+  other.timestamp() = 0;
+  if (*delta.fullSnapshot() || !(other == lastOtherStats_)) {
+    delta.otherStats() = other;
+    lastOtherStats_ = std::move(other);
+  }
+  return delta;
+}
+
+bool HwSwitchStatsDeltaDecoder::apply(
+    multiswitch::HwSwitchStats& stats,
+    multiswitch::HwSwitchStatsDelta delta) {
+  if (*delta.fullSnapshot()) {
+    stats = multiswitch::HwSwitchStats();
+    portNames_.clear();
+    sysPortNames_.clear();
+    haveSnapshot_ = true;
+  } else if (!haveSnapshot_) {
+    return false;
+  }
+
+  auto applyEntries = [](auto& statsMap,
+                         auto& names,
+                         auto& newNames,
+                         auto& whole,
+                         const auto& deltas,
+                         const auto& removed) {
+    for (auto& [index, name] : newNames) {
+      names[index] = std::move(name);
+    }
+    auto nameOf = [&](int32_t index) -> const std::string& {
+      auto it = names.find(index);
+      if (it == names.end()) {
+        throw FbossError("Stats delta for unknown index ", index);
+      }
+      return it->second;
+    };
+    for (auto& [index, entry] : whole) {
+      statsMap[nameOf(index)] = std::move(entry);
+    }
+    for (const auto& [index, entryDelta] : deltas) {
+      auto it = statsMap.find(nameOf(index));
+      if (it == statsMap.end()) {
+        throw FbossError("Stats delta for missing entry ", index);
+      }
+      applyCounters(it->second, entryDelta);
+    }
+    for (auto index : removed) {
+      statsMap.erase(nameOf(index));
+      names.erase(index);
+    }
+  };
+  applyEntries(
+      *stats.hwPortStats(),
+      portNames_,
+      *delta.newPortNames(),
+      *delta.hwPortStats(),
+      *delta.hwPortStatsDelta(),
+      *delta.removedPorts());
+  applyEntries(
+      *stats.sysPortStats(),
+      sysPortNames_,
+      *delta.newSysPortNames(),
+      *delta.sysPortStats(),
+      *delta.sysPortStatsDelta(),
+      *delta.removedSysPorts());
+
+  if (delta.otherStats()) {
+    auto& other = *delta.otherStats();
+    other.hwPortStats() = std::move(*stats.hwPortStats());
+    other.sysPortStats() = std::move(*stats.sysPortStats());
+    stats = std::move(other);
+  }
+  stats.timestamp() = *delta.timestamp();
+  return true;
+}
+
+int64_t threadCpuTimeUsec() {
+  timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+} // namespace facebook::fboss
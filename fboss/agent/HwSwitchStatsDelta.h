@@ -0,0 +1,82 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <folly/container/F14Map.h>
+
+#include "fboss/agent/if/gen-cpp2/multiswitch_ctrl_types.h"
+
+namespace facebook::fboss {
+
+/*
+ * HwAgent side of the syncHwStatsDelta sink. Turns each interval's
+ * HwSwitchStats into the changes since the previous one: changed counters
+ * of ports and system ports as deltas keyed by a compact port index and
+ * thrift field id, and the other HwSwitchStats fields only when they
+ * changed.
+ */
+class HwSwitchStatsDeltaEncoder {
+ public:
+  // The next encode() sends a full snapshot, e.g. after reconnecting
+  void reset() {
+    snapshotSent_ = false;
+  }
+  multiswitch::HwSwitchStatsDelta encode(
+      const multiswitch::HwSwitchStats& stats);
+
+ private:
+  template <typename StatsT, typename MapT>
+  void encodeEntries(
+      const MapT& current,
+      folly::F14FastMap<std::string, StatsT>& previous,
+      folly::F14FastMap<std::string, int32_t>& indices,
+      std::map<int32_t, std::string>& newNames,
+      std::map<int32_t, multiswitch::HwStatsEntryDelta>& deltas,
+      std::map<int32_t, StatsT>& whole,
+      std::vector<int32_t>& removed);
+
+  bool snapshotSent_{false};
+  int32_t nextIndex_{0};
+  folly::F14FastMap<std::string, int32_t> portIndices_;
+  folly::F14FastMap<std::string, int32_t> sysPortIndices_;
+  folly::F14FastMap<std::string, HwPortStats> lastPortStats_;
+  folly::F14FastMap<std::string, HwSysPortStats> lastSysPortStats_;
+  // Everything but the port and system port stats, timestamp cleared
+  multiswitch::HwSwitchStats lastOtherStats_;
+};
+
+/*
+ * SwSwitch side of the syncHwStatsDelta sink, one per connection. Applies
+ * deltas to the full HwSwitchStats view of the switch.
+ */
+class HwSwitchStatsDeltaDecoder {
+ public:
+  /*
+   * False if the delta was dropped, because no full snapshot was received
+   * on this connection yet. Throws FbossError on deltas inconsistent with
+   * the view, after which the view must be rebuilt from a new snapshot.
+   */
+  bool apply(
+      multiswitch::HwSwitchStats& stats,
+      multiswitch::HwSwitchStatsDelta delta);
+
+ private:
+  bool haveSnapshot_{false};
+  folly::F14FastMap<int32_t, std::string> portNames_;
+  folly::F14FastMap<int32_t, std::string> sysPortNames_;
+};
+
+// CPU time used by the calling thread so far
+int64_t threadCpuTimeUsec();
+
+} // namespace facebook::fboss
@@ -416,7 +416,9 @@ bool IPv4Handler::resolveMac(
   // need to find out our own IP and MAC addresses so that we can send the
   // ARP request out. Since the request will be broadcast, there is no need to
   // worry about which port to send the packet out.
-  auto route = sw_->longestMatch(state, dest, RouterID(0));
+  // Resolved routes only: a destination covered by an unresolved more
+  // specific route is resolved through the route hardware forwards it with
+  auto route = sw_->fibLongestMatch(state, dest, RouterID(0));
 
   if (!route || !route->isResolved()) {
     sw_->portStats(ingressPort)->ipv4DstLookupFailure();
@@ -937,7 +937,7 @@ void IPv6Handler::resolveDestAndHandlePacket(
     }
   }
 
-  auto route = sw_->longestMatch(state, targetIP, RouterID(0));
+  auto route = sw_->fibLongestMatch(state, targetIP, RouterID(0));
   if (!route || !route->isResolved()) {
     sw_->portStats(ingressPort)->ipv6DstLookupFailure();
     // No way to reach targetIP
@@ -998,7 +998,7 @@ void IPv6Handler::sendMulticastNeighborSolicitations(
 
   auto state = sw_->getState();
 
-  auto route = sw_->longestMatch(state, targetIP, RouterID(0));
+  auto route = sw_->fibLongestMatch(state, targetIP, RouterID(0));
   if (!route || !route->isResolved()) {
     sw_->portStats(ingressPort)->ipv6DstLookupFailure();
     // No way to reach targetIP
@@ -2,12 +2,24 @@
 
 #include "fboss/agent/MultiSwitchPacketStreamMap.h"
 
+#include <folly/Conv.h>
+#include <folly/logging/xlog.h>
+#include <folly/system/ThreadName.h>
+
 #include "fboss/agent/FbossError.h"
 
 using apache::thrift::ServerStream;
 using apache::thrift::ServerStreamPublisher;
 
+namespace {
+constexpr auto kRxRingWait = std::chrono::milliseconds(100);
+} // namespace
+
 namespace facebook::fboss {
+MultiSwitchPacketStreamMap::~MultiSwitchPacketStreamMap() {
+  removeAllPacketRings();
+}
+
 void MultiSwitchPacketStreamMap::addPacketStream(
     SwitchID switchId,
     std::unique_ptr<
@@ -28,4 +40,106 @@ MultiSwitchPacketStreamMap::getStream(SwitchID switchId) const {
   }
   return *it->second;
 }
+
+void MultiSwitchPacketStreamMap::addPacketRings(
+    SwitchID switchId,
+    std::unique_ptr<ShmPacketRing> rxRing,
+    std::unique_ptr<ShmPacketRing> txRing,
+    RxPacketHandler rxHandler) {
+  auto rings = std::make_shared<PacketRings>(
+      switchId, std::move(rxRing), std::move(txRing), std::move(rxHandler));
+  auto oldRings =
+      std::exchange((*packetRingsMap_.wlock())[switchId], std::move(rings));
+  // Rings of a previous connection are stopped outside the lock, before the
+  // last reference to them can be dropped by a sender on their rx thread
+  if (oldRings) {
+    oldRings->stop();
+  }
+}
+
+void MultiSwitchPacketStreamMap::removePacketRings(SwitchID switchId) {
+  std::shared_ptr<PacketRings> rings;
+  {
+    auto packetRingsMap = packetRingsMap_.wlock();
+    auto it = packetRingsMap->find(switchId);
+    if (it == packetRingsMap->end()) {
+      return;
+    }
+    rings = std::move(it->second);
+    packetRingsMap->erase(it);
+  }
+  rings->stop();
+}
+
+void MultiSwitchPacketStreamMap::removeAllPacketRings() {
+  std::unordered_map<SwitchID, std::shared_ptr<PacketRings>> packetRings;
+  packetRingsMap_.wlock()->swap(packetRings);
+  for (auto& [_, rings] : packetRings) {
+    rings->stop();
+  }
+}
+
+std::optional<bool> MultiSwitchPacketStreamMap::sendPacketToRing(
+    SwitchID switchId,
+    const ShmPacketRing::PacketInfo& info,
+    const folly::IOBuf& buf) const {
+  std::shared_ptr<PacketRings> rings;
+  {
+    auto packetRingsMap = packetRingsMap_.rlock();
+    auto it = packetRingsMap->find(switchId);
+    if (it == packetRingsMap->end()) {
+      return std::nullopt;
+    }
+    rings = it->second;
+  }
+  return rings->send(info, buf);
+}
+
+MultiSwitchPacketStreamMap::PacketRings::PacketRings(
+    SwitchID switchId,
+    std::unique_ptr<ShmPacketRing> rxRing,
+    std::unique_ptr<ShmPacketRing> txRing,
+    RxPacketHandler rxHandler)
+    : rxRing_(std::move(rxRing)),
+      txRing_(std::move(txRing)),
+      rxHandler_(std::move(rxHandler)) {
+  rxThread_ = std::thread([this, switchId] {
+    folly::setThreadName(folly::to<std::string>("RxPktRing", switchId));
+    rxLoop();
+  });
+}
+
+MultiSwitchPacketStreamMap::PacketRings::~PacketRings() {
+  stop();
+}
+
+void MultiSwitchPacketStreamMap::PacketRings::stop() {
+  if (exiting_.exchange(true)) {
+    return;
+  }
+  rxRing_->notify();
+  rxThread_.join();
+}
+
+bool MultiSwitchPacketStreamMap::PacketRings::send(
+    const ShmPacketRing::PacketInfo& info,
+    const folly::IOBuf& buf) {
+  std::lock_guard<std::mutex> g(txLock_);
+  return txRing_->tryPush(info, buf);
+}
+
+void MultiSwitchPacketStreamMap::PacketRings::rxLoop() {
+  while (!exiting_.load(std::memory_order_acquire)) {
+    auto pkt = rxRing_->tryPop();
+    if (!pkt) {
+      rxRing_->wait(kRxRingWait);
+      continue;
+    }
+    try {
+      rxHandler_(*pkt);
+    } catch (const std::exception& ex) {
+      XLOG(ERR) << "Error handling packet from rx ring: " << ex.what();
+    }
+  }
+}
 } // namespace facebook::fboss
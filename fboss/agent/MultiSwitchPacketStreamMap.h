@@ -4,7 +4,12 @@
 
 #include "fboss/agent/if/gen-cpp2/MultiSwitchCtrl.h"
 #include "fboss/agent/types.h"
+#include "fboss/lib/ShmPacketRing.h"
 
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 
 #include <folly/Synchronized.h>
@@ -13,6 +18,10 @@ namespace facebook::fboss {
 
 class MultiSwitchPacketStreamMap {
  public:
+  using RxPacketHandler = std::function<void(ShmPacketRing::Packet&)>;
+
+  ~MultiSwitchPacketStreamMap();
+
   void addPacketStream(
       SwitchID switchId,
       std::unique_ptr<
@@ -21,12 +30,57 @@ class MultiSwitchPacketStreamMap {
   apache::thrift::ServerStreamPublisher<multiswitch::TxPacket>& getStream(
       SwitchID switchId) const;
 
+  /*
+   * Shared memory rings attached by a HwAgent. Packets popped from the rx
+   * ring are passed to rxHandler on a thread of its own, and tx packets go
+   * to the tx ring instead of the stream while the rings are attached.
+   */
+  void addPacketRings(
+      SwitchID switchId,
+      std::unique_ptr<ShmPacketRing> rxRing,
+      std::unique_ptr<ShmPacketRing> txRing,
+      RxPacketHandler rxHandler);
+  void removePacketRings(SwitchID switchId);
+  void removeAllPacketRings();
+  // std::nullopt if no rings are attached, else whether the packet was queued
+  std::optional<bool> sendPacketToRing(
+      SwitchID switchId,
+      const ShmPacketRing::PacketInfo& info,
+      const folly::IOBuf& buf) const;
+
  private:
+  class PacketRings {
+   public:
+    PacketRings(
+        SwitchID switchId,
+        std::unique_ptr<ShmPacketRing> rxRing,
+        std::unique_ptr<ShmPacketRing> txRing,
+        RxPacketHandler rxHandler);
+    ~PacketRings();
+    // Joins the rx thread, must not be called from it
+    void stop();
+    bool send(const ShmPacketRing::PacketInfo& info, const folly::IOBuf& buf);
+
+   private:
+    void rxLoop();
+
+    std::unique_ptr<ShmPacketRing> rxRing_;
+    std::unique_ptr<ShmPacketRing> txRing_;
+    RxPacketHandler rxHandler_;
+    // Many threads send packets, the ring has a single producer
+    std::mutex txLock_;
+    std::atomic<bool> exiting_{false};
+    std::thread rxThread_;
+  };
+
   folly::Synchronized<std::unordered_map<
       SwitchID,
       std::unique_ptr<
           apache::thrift::ServerStreamPublisher<multiswitch::TxPacket>>>>
       txPacketStreamMap_;
+  folly::Synchronized<
+      std::unordered_map<SwitchID, std::shared_ptr<PacketRings>>>
+      packetRingsMap_;
 };
 
 } // namespace facebook::fboss
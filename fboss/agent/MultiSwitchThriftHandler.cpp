@@ -2,6 +2,7 @@
 
 #include <memory>
 
+#include "fboss/agent/HwSwitchStatsDelta.h"
 #include "fboss/agent/MultiSwitchPacketStreamMap.h"
 #include "fboss/agent/MultiSwitchThriftHandler.h"
 #include "fboss/agent/SwRxPacket.h"
@@ -141,6 +142,76 @@ void MultiSwitchThriftHandler::processSwitchReachabilityChangeEvent(
   sw_->switchReachabilityChanged(switchId, switchId2FabricPortIds);
 }
 
+void MultiSwitchThriftHandler::processRxPacket(
+    int64_t switchId,
+    int16_t switchIndex,
+    multiswitch::RxPacket& rxPkt) {
+  XLOG(DBG4) << "Got rx packet from switch " << switchId << " for port "
+             << *rxPkt.port();
+  sw_->stats()->hwAgentRxPktReceived(switchIndex);
+  auto pkt = make_unique<SwRxPacket>(std::move(*rxPkt.data()));
+  pkt->setSrcPort(PortID(*rxPkt.port()));
+  if (rxPkt.vlan()) {
+    pkt->setSrcVlan(VlanID(*rxPkt.vlan()));
+  } else {
+    // clear default vlan id(0)
+    // TODO - retire this once the default value for vlan id is
+    // removed
+    pkt->setSrcVlan(std::nullopt);
+  }
+  if (rxPkt.aggPort()) {
+    pkt->setSrcAggregatePort(AggregatePortID(*rxPkt.aggPort()));
+  }
+  if (rxPkt.cosQueue()) {
+    pkt->setCosQueue(static_cast<uint8_t>(*rxPkt.cosQueue()));
+  }
+  // Agent pkt handling code assumes single buffer, so coalesce
+  pkt->buf()->coalesce();
+  if (*rxPkt.length() != pkt->buf()->length()) {
+    XLOG(ERR) << "Rx packet length mismatch for switch " << switchId;
+    sw_->stats()->hwAgentRxBadPktReceived(switchIndex);
+    return;
+  }
+  if (FLAGS_rx_sw_priority) {
+    sw_->rxPacketReceived(std::move(pkt));
+  } else {
+    sw_->packetReceived(std::move(pkt));
+  }
+}
+
+void MultiSwitchThriftHandler::attachPacketRings(
+    int64_t switchId,
+    std::unique_ptr<multiswitch::PacketRings> rings) {
+  ensureConfigured(__func__);
+  auto switchIndex =
+      sw_->getSwitchInfoTable().getSwitchIndexFromSwitchId(SwitchID(switchId));
+  // HwAgent produces to its rx ring and consumes from its tx ring
+  auto rxRing = ShmPacketRing::attach(*rings->pid(), *rings->rxRingFd());
+  auto txRing = ShmPacketRing::attach(*rings->pid(), *rings->txRingFd());
+  sw_->getPacketStreamMap()->addPacketRings(
+      SwitchID(switchId),
+      std::move(rxRing),
+      std::move(txRing),
+      [this, switchId, switchIndex](ShmPacketRing::Packet& pkt) {
+        multiswitch::RxPacket rxPkt;
+        rxPkt.port() = pkt.info.port.value_or(0);
+        if (pkt.info.vlan) {
+          rxPkt.vlan() = *pkt.info.vlan;
+        }
+        if (pkt.info.aggPort) {
+          rxPkt.aggPort() = *pkt.info.aggPort;
+        }
+        if (pkt.info.queue) {
+          rxPkt.cosQueue() = static_cast<CpuCosQueueId>(*pkt.info.queue);
+        }
+        rxPkt.length() = pkt.buf->length();
+        rxPkt.data() = std::move(pkt.buf);
+        processRxPacket(switchId, switchIndex, rxPkt);
+      });
+  XLOG(DBG2) << "Attached packet rings of switch " << switchId << " from pid "
+             << *rings->pid();
+}
+
 #if FOLLY_HAS_COROUTINES
 folly::coro::Task<
     apache::thrift::SinkConsumer<multiswitch::LinkChangeEvent, bool>>
@@ -257,37 +328,7 @@ MultiSwitchThriftHandler::co_notifyRxPacket(int64_t switchId) {
         try {
           while (auto item = co_await folly::coro::co_withCancellation(
                      rxPktCancellationSource_.getToken(), gen.next())) {
-            XLOG(DBG4) << "Got rx packet from switch " << switchId
-                       << " for port " << *item->port();
-            sw_->stats()->hwAgentRxPktReceived(switchIndex);
-            auto pkt = make_unique<SwRxPacket>(std::move(*item->data()));
-            pkt->setSrcPort(PortID(*item->port()));
-            if (item->vlan()) {
-              pkt->setSrcVlan(VlanID(*item->vlan()));
-            } else {
-              // clear default vlan id(0)
-              // TODO - retire this once the default value for vlan id is
-              // removed
-              pkt->setSrcVlan(std::nullopt);
-            }
-            if (item->aggPort()) {
-              pkt->setSrcAggregatePort(AggregatePortID(*item->aggPort()));
-            }
-            if (item->cosQueue()) {
-              pkt->setCosQueue(static_cast<uint8_t>(*item->cosQueue()));
-            }
-            // Agent pkt handling code assumes single buffer, so coalesce
-            pkt->buf()->coalesce();
-            if (*item->length() != pkt->buf()->length()) {
-              XLOG(ERR) << "Rx packet length mismatch for switch " << switchId;
-              sw_->stats()->hwAgentRxBadPktReceived(switchIndex);
-              continue;
-            }
-            if (FLAGS_rx_sw_priority) {
-              sw_->rxPacketReceived(std::move(pkt));
-            } else {
-              sw_->packetReceived(std::move(pkt));
-            }
+            processRxPacket(switchId, switchIndex, *item);
           }
         } catch (const std::exception& e) {
           XLOG(DBG2) << "Rx packet event sink cancelled for switch " << switchId
@@ -310,6 +351,7 @@ MultiSwitchThriftHandler::co_getTxPackets(int64_t switchId) {
       apache::thrift::ServerStream<multiswitch::TxPacket>::createPublisher(
           [this, switchId, switchIndex] {
             sw_->getPacketStreamMap()->removePacketStream(SwitchID(switchId));
+            sw_->getPacketStreamMap()->removePacketRings(SwitchID(switchId));
             XLOG(DBG2) << "Removed stream for switch " << switchId;
             sw_->stats()->hwAgentTxPktEventStreamConnectionStatus(
                 switchIndex, false);
@@ -353,6 +395,46 @@ MultiSwitchThriftHandler::co_syncHwStats(int16_t switchIndex) {
       FLAGS_stats_event_buffer_size};
 }
 
+folly::coro::Task<
+    apache::thrift::SinkConsumer<multiswitch::HwSwitchStatsDelta, bool>>
+MultiSwitchThriftHandler::co_syncHwStatsDelta(int16_t switchIndex) {
+  ensureConfigured(__func__);
+  co_return apache::thrift::SinkConsumer<multiswitch::HwSwitchStatsDelta, bool>{
+      [this, switchIndex](
+          folly::coro::AsyncGenerator<multiswitch::HwSwitchStatsDelta&&> gen)
+          -> folly::coro::Task<bool> {
+        sw_->stats()->hwAgentStatsEventSinkConnectionStatus(switchIndex, true);
+        // Deltas are relative to what was sent on this connection, a new
+        // connection always starts with a full snapshot
+        HwSwitchStatsDeltaDecoder decoder;
+        try {
+          while (auto item = co_await folly::coro::co_withCancellation(
+                     statsCancellationSource_.getToken(), gen.next())) {
+            XLOG(DBG3) << "Got stats delta from switchIndex " << switchIndex;
+            bool fullSnapshot = *item->fullSnapshot();
+            auto startUsec = threadCpuTimeUsec();
+            if (!sw_->updateHwSwitchStats(
+                    switchIndex, decoder, std::move(*item))) {
+              continue;
+            }
+            sw_->stats()->hwAgentStatsDeltaApplied(
+                switchIndex, threadCpuTimeUsec() - startUsec, fullSnapshot);
+            sw_->stats()->hwAgentStatsReceived(switchIndex);
+          }
+        } catch (const std::exception& e) {
+          // Includes deltas that do not apply, hw agent reconnects and
+          // starts over with a snapshot
+          XLOG(DBG2) << "Stats delta sink cancelled for switchIndex "
+                     << switchIndex << " with exception " << e.what();
+          sw_->stats()->hwAgentStatsEventSinkConnectionStatus(
+              switchIndex, false);
+          co_return false;
+        }
+        co_return true;
+      },
+      FLAGS_stats_event_buffer_size};
+}
+
 #endif
 
 void MultiSwitchThriftHandler::getNextStateOperDelta(
@@ -375,6 +457,7 @@ void MultiSwitchThriftHandler::cancelEventSyncers() {
   rxPktCancellationSource_.requestCancellation();
   statsCancellationSource_.requestCancellation();
   switchReachabilityCancellationSource_.requestCancellation();
+  sw_->getPacketStreamMap()->removeAllPacketRings();
 }
 
 } // namespace facebook::fboss
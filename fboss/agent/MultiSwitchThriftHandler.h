@@ -31,6 +31,10 @@ class MultiSwitchThriftHandler
       apache::thrift::SinkConsumer<multiswitch::HwSwitchStats, bool>>
   co_syncHwStats(int16_t switchIndex) override;
 
+  folly::coro::Task<
+      apache::thrift::SinkConsumer<multiswitch::HwSwitchStatsDelta, bool>>
+  co_syncHwStatsDelta(int16_t switchIndex) override;
+
   folly::coro::Task<apache::thrift::SinkConsumer<
       multiswitch::SwitchReachabilityChangeEvent,
       bool>>
@@ -44,6 +48,10 @@ class MultiSwitchThriftHandler
 
   void gracefulExit(int64_t switchId) override;
 
+  void attachPacketRings(
+      int64_t switchId,
+      std::unique_ptr<multiswitch::PacketRings> rings) override;
+
   static L2Entry getL2Entry(L2EntryThrift thriftEntry);
 
  private:
@@ -60,6 +68,10 @@ class MultiSwitchThriftHandler
       SwitchID switchId,
       const multiswitch::SwitchReachabilityChangeEvent&
           switchReachabilityChangeEvent);
+  void processRxPacket(
+      int64_t switchId,
+      int16_t switchIndex,
+      multiswitch::RxPacket& rxPkt);
   void ensureConfigured(folly::StringPiece function) const;
   SwSwitch* sw_;
   folly::CancellationSource rxPktCancellationSource_;
@@ -0,0 +1,441 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/PortStatsHistory.h"
+
+#include <algorithm>
+#include <string_view>
+#include <type_traits>
+
+#include <folly/Conv.h>
+#include <folly/Range.h>
+#include <folly/Varint.h>
+#include <thrift/lib/cpp2/Thrift.h>
+#include <thrift/lib/cpp2/op/Get.h>
+
+DEFINE_int32(
+    port_stats_history_memory_mb,
+    64,
+    "Memory budget of the in-agent port stats history served by "
+    "getPortStatsHistory. 0 disables the history.");
+DEFINE_int32(
+    port_stats_history_raw_window_s,
+    300,
+    "Seconds of port stats history kept at full resolution");
+DEFINE_int32(
+    port_stats_history_downsample_interval_s,
+    60,
+    "Port stats history older than the full resolution window is "
+    "downsampled to one sample per this many seconds");
+DEFINE_int32(
+    port_stats_history_downsampled_window_s,
+    3600,
+    "Seconds of downsampled port stats history kept");
+
+namespace {
+
+constexpr std::string_view kTimestampField = "timestamp_";
+
+// Wrap around rather than overflow on counter resets
+int64_t wrappingAdd(int64_t lhs, int64_t rhs) {
+  return static_cast<int64_t>(
+      static_cast<uint64_t>(lhs) + static_cast<uint64_t>(rhs));
+}
+
+int64_t wrappingSub(int64_t lhs, int64_t rhs) {
+  return static_cast<int64_t>(
+      static_cast<uint64_t>(lhs) - static_cast<uint64_t>(rhs));
+}
+
+/*
+ * Calls fn(field, queue, value) for every integer field, and every entry of
+ * the per queue map fields, set in a port stats struct.
+ */
+template <typename StatsT, typename Fn>
+void forEachCounter(const StatsT& stats, Fn&& fn) {
+  namespace op = apache::thrift::op;
+  namespace type = apache::thrift::type;
+  op::for_each_field_id<StatsT>([&]<class Id>(Id) {
+    using Tag = op::get_type_tag<StatsT, Id>;
+    const auto* value = op::getValueOrNull(op::get<Id, StatsT>(stats));
+    if (!value) {
+      return;
+    }
+    std::string_view field = op::get_name_v<StatsT, Id>;
+    if constexpr (std::is_same_v<Tag, type::map<type::i16_t, type::i64_t>>) {
+      for (const auto& [queue, counter] : *value) {
+        fn(field, std::optional<int16_t>(queue), counter);
+      }
+    } else if constexpr (
+        type::is_a_v<Tag, type::integral_c> &&
+        !std::is_same_v<Tag, type::bool_t>) {
+      if (field != kTimestampField) {
+        fn(field, std::optional<int16_t>(), static_cast<int64_t>(*value));
+      }
+    }
+  });
+}
+
+} // namespace
+
+namespace facebook::fboss {
+
+void PortStatsHistory::Column::append(int64_t value) {
+  auto delta = empty_ ? 0 : wrappingSub(value, last_);
+  auto encoded = empty_ ? value : wrappingSub(delta, lastDelta_);
+  uint8_t buf[folly::kMaxVarintLength64];
+  auto len = folly::encodeVarint(folly::encodeZigZag(encoded), buf);
+  data_.append(reinterpret_cast<const char*>(buf), len);
+  last_ = value;
+  lastDelta_ = delta;
+  empty_ = false;
+}
+
+std::vector<int64_t> PortStatsHistory::Column::decode(uint32_t count) const {
+  std::vector<int64_t> values;
+  values.reserve(count);
+  folly::ByteRange data{folly::StringPiece(data_)};
+  int64_t last = 0;
+  int64_t lastDelta = 0;
+  for (uint32_t i = 0; i < count; ++i) {
+    auto encoded = folly::decodeZigZag(folly::decodeVarint(data));
+    if (i == 0) {
+      last = encoded;
+    } else {
+      lastDelta = wrappingAdd(lastDelta, encoded);
+      last = wrappingAdd(last, lastDelta);
+    }
+    values.push_back(last);
+  }
+  return values;
+}
+
+void PortStatsHistory::Column::shrink() {
+  data_.shrink_to_fit();
+}
+
+size_t PortStatsHistory::Column::bytes() const {
+  return sizeof(Column) + data_.capacity();
+}
+
+void PortStatsHistory::Chunk::seal() {
+  timestamps.shrink();
+  for (auto& [_, column] : counters) {
+    column.shrink();
+  }
+  sealedBytes = bytes();
+}
+
+size_t PortStatsHistory::Chunk::bytes() const {
+  if (sealedBytes) {
+    return *sealedBytes;
+  }
+  auto bytes = sizeof(Chunk) + timestamps.bytes();
+  for (const auto& [_, column] : counters) {
+    bytes += sizeof(uint32_t) + column.bytes();
+  }
+  return bytes;
+}
+
+size_t PortStatsHistory::PortHistory::bytes() const {
+  size_t bytes = sizeof(PortHistory) +
+      pendingValues.size() * sizeof(std::pair<uint32_t, int64_t>);
+  for (const auto& chunk : raw) {
+    bytes += chunk.bytes();
+  }
+  for (const auto& chunk : downsampled) {
+    bytes += chunk.bytes();
+  }
+  return bytes;
+}
+
+PortStatsHistory::PortStatsHistory()
+    : PortStatsHistory(Config{
+          std::chrono::seconds(FLAGS_port_stats_history_raw_window_s),
+          std::chrono::seconds(FLAGS_port_stats_history_downsample_interval_s),
+          std::chrono::seconds(FLAGS_port_stats_history_downsampled_window_s),
+          static_cast<size_t>(FLAGS_port_stats_history_memory_mb) << 20}) {}
+
+PortStatsHistory::PortStatsHistory(Config config) : config_(config) {
+  CHECK_GT(config_.downsampleInterval.count(), 0);
+}
+
+void PortStatsHistory::addStats(
+    const std::map<std::string, HwPortStats>& portStats,
+    const std::map<std::string, HwSysPortStats>& sysPortStats) {
+  auto now = std::chrono::duration_cast<std::chrono::seconds>(
+                 std::chrono::system_clock::now().time_since_epoch())
+                 .count();
+  // Age history by the newest sample rather than the wall clock, so that a
+  // stalled stats thread does not expire what it has not replaced yet
+  std::optional<int64_t> latest;
+  auto state = state_.wlock();
+  for (const auto& [portName, stats] : portStats) {
+    latest = std::max(latest, addPortStats(*state, portName, stats, now));
+  }
+  for (const auto& [portName, stats] : sysPortStats) {
+    latest = std::max(latest, addPortStats(*state, portName, stats, now));
+  }
+  if (latest) {
+    expire(*state, *latest);
+  }
+  enforceBudget(*state);
+}
+
+template <typename StatsT>
+std::optional<int64_t> PortStatsHistory::addPortStats(
+    State& state,
+    const std::string& portName,
+    const StatsT& stats,
+    int64_t now) const {
+  auto timestamp = *stats.timestamp_();
+  if (timestamp <= 0) {
+    timestamp = now;
+  }
+  auto& port = state.ports[portName];
+  if (!port.raw.empty() && port.raw.back().endTime >= timestamp) {
+    return std::nullopt;
+  }
+  Sample sample;
+  std::string counter;
+  forEachCounter(
+      stats,
+      [&](std::string_view field, std::optional<int16_t> queue, int64_t value) {
+        counter.assign(field);
+        if (queue) {
+          folly::toAppend('.', *queue, &counter);
+        }
+        sample.emplace_back(counterId(state, counter), value);
+      });
+  appendSample(port.raw, timestamp, sample);
+  return timestamp;
+}
+
+uint32_t PortStatsHistory::counterId(State& state, const std::string& name) {
+  auto it = state.counterIds.find(name);
+  if (it != state.counterIds.end()) {
+    return it->second;
+  }
+  uint32_t id = state.counterNames.size();
+  state.counterNames.push_back(name);
+  state.isWatermark.push_back(name.find("Watermark") != std::string::npos);
+  state.counterIds.emplace(name, id);
+  return id;
+}
+
+void PortStatsHistory::appendSample(
+    std::deque<Chunk>& chunks,
+    int64_t timestamp,
+    const Sample& sample) {
+  // Columns of a chunk all hold the same samples, so a counter appearing or
+  // disappearing starts a new chunk
+  auto sameCounters = [&](const Chunk& chunk) {
+    return chunk.counters.size() == sample.size() &&
+        std::all_of(sample.begin(), sample.end(), [&](const auto& counter) {
+             return chunk.counters.contains(counter.first);
+           });
+  };
+  if (chunks.empty() || chunks.back().full() || !sameCounters(chunks.back())) {
+    if (!chunks.empty()) {
+      chunks.back().seal();
+    }
+    chunks.emplace_back();
+    chunks.back().beginTime = timestamp;
+  }
+  auto& chunk = chunks.back();
+  chunk.timestamps.append(timestamp);
+  for (const auto& [id, value] : sample) {
+    chunk.counters[id].append(value);
+  }
+  chunk.endTime = timestamp;
+  ++chunk.size;
+}
+
+void PortStatsHistory::expire(State& state, int64_t now) const {
+  auto rawCutoff = now - config_.rawWindow.count();
+  auto downsampledCutoff = now - config_.downsampledWindow.count();
+  for (auto it = state.ports.begin(); it != state.ports.end();) {
+    auto& port = it->second;
+    if (port.raw.empty() || port.raw.back().endTime < downsampledCutoff) {
+      // Port has not been reported for longer than we keep history
+      it = state.ports.erase(it);
+      continue;
+    }
+    // Never expire the chunk being appended to
+    while (port.raw.size() > 1 && port.raw.front().endTime < rawCutoff) {
+      downsample(state, port, port.raw.front());
+      port.raw.pop_front();
+    }
+    while (!port.downsampled.empty() &&
+           port.downsampled.front().endTime < downsampledCutoff) {
+      port.downsampled.pop_front();
+    }
+    ++it;
+  }
+}
+
+void PortStatsHistory::downsample(
+    const State& state,
+    PortHistory& port,
+    const Chunk& chunk) const {
+  auto interval = config_.downsampleInterval.count();
+  auto timestamps = chunk.timestamps.decode(chunk.size);
+  std::vector<std::pair<uint32_t, std::vector<int64_t>>> columns;
+  columns.reserve(chunk.counters.size());
+  for (const auto& [id, column] : chunk.counters) {
+    columns.emplace_back(id, column.decode(chunk.size));
+  }
+  for (uint32_t i = 0; i < chunk.size; ++i) {
+    auto bucket = timestamps[i] / interval;
+    if (bucket != port.pendingBucket) {
+      flushPending(port);
+      port.pendingBucket = bucket;
+    }
+    port.pendingTime = timestamps[i];
+    for (const auto& [id, values] : columns) {
+      auto [entry, inserted] = port.pendingValues.try_emplace(id, values[i]);
+      if (!inserted) {
+        entry->second = state.isWatermark[id]
+            ? std::max(entry->second, values[i])
+            : values[i];
+      }
+    }
+  }
+}
+
+void PortStatsHistory::flushPending(PortHistory& port) {
+  if (port.pendingValues.empty()) {
+    return;
+  }
+  Sample sample(port.pendingValues.begin(), port.pendingValues.end());
+  appendSample(port.downsampled, port.pendingTime, sample);
+  port.pendingValues.clear();
+}
+
+void PortStatsHistory::enforceBudget(State& state) const {
+  auto usage = memoryUsage(state);
+  // Drop the oldest downsampled chunks first, then the oldest full
+  // resolution ones, but never a chunk still being appended to
+  auto dropOldest = [&state](bool downsampled) -> std::optional<size_t> {
+    std::deque<Chunk>* oldest = nullptr;
+    for (auto& [_, port] : state.ports) {
+      auto& chunks = downsampled ? port.downsampled : port.raw;
+      if (chunks.size() > (downsampled ? 0 : 1) &&
+          (!oldest || chunks.front().beginTime < oldest->front().beginTime)) {
+        oldest = &chunks;
+      }
+    }
+    if (!oldest) {
+      return std::nullopt;
+    }
+    auto bytes = oldest->front().bytes();
+    oldest->pop_front();
+    return bytes;
+  };
+  while (usage > config_.memoryBudgetBytes) {
+    auto dropped = dropOldest(true);
+    if (!dropped) {
+      dropped = dropOldest(false);
+    }
+    if (!dropped) {
+      break;
+    }
+    usage -= std::min(usage, *dropped);
+  }
+}
+
+size_t PortStatsHistory::memoryUsage() const {
+  return memoryUsage(*state_.rlock());
+}
+
+size_t PortStatsHistory::memoryUsage(const State& state) {
+  size_t bytes = 0;
+  for (const auto& [portName, port] : state.ports) {
+    bytes += portName.capacity() + port.bytes();
+  }
+  return bytes;
+}
+
+std::vector<PortCounterHistory> PortStatsHistory::getHistory(
+    const std::set<std::string>& ports,
+    const std::set<std::string>& counters,
+    int64_t beginTime,
+    int64_t endTime) const {
+  std::vector<PortCounterHistory> result;
+  auto state = state_.rlock();
+  for (const auto& [portName, port] : state->ports) {
+    if (!ports.empty() && !ports.count(portName)) {
+      continue;
+    }
+    // Oldest first: downsampled chunks, the interval still being
+    // downsampled, then the full resolution chunks
+    std::map<std::string, PortCounterHistory> histories;
+    for (const auto& chunk : port.downsampled) {
+      appendHistory(
+          *state, portName, chunk, counters, beginTime, endTime, histories);
+    }
+    if (!port.pendingValues.empty() && port.pendingTime >= beginTime &&
+        port.pendingTime <= endTime) {
+      for (const auto& [id, value] : port.pendingValues) {
+        const auto& counter = state->counterNames[id];
+        if (!counters.empty() && !counters.count(counter)) {
+          continue;
+        }
+        auto& history = histories[counter];
+        history.portName() = portName;
+        history.counter() = counter;
+        history.timestamps()->push_back(port.pendingTime);
+        history.values()->push_back(value);
+      }
+    }
+    for (const auto& chunk : port.raw) {
+      appendHistory(
+          *state, portName, chunk, counters, beginTime, endTime, histories);
+    }
+    for (auto& [_, history] : histories) {
+      if (!history.timestamps()->empty()) {
+        result.push_back(std::move(history));
+      }
+    }
+  }
+  return result;
+}
+
+void PortStatsHistory::appendHistory(
+    const State& state,
+    const std::string& portName,
+    const Chunk& chunk,
+    const std::set<std::string>& counters,
+    int64_t beginTime,
+    int64_t endTime,
+    std::map<std::string, PortCounterHistory>& histories) {
+  if (chunk.endTime < beginTime || chunk.beginTime > endTime) {
+    return;
+  }
+  auto timestamps = chunk.timestamps.decode(chunk.size);
+  for (const auto& [id, column] : chunk.counters) {
+    const auto& counter = state.counterNames[id];
+    if (!counters.empty() && !counters.count(counter)) {
+      continue;
+    }
+    auto values = column.decode(chunk.size);
+    auto& history = histories[counter];
+    history.portName() = portName;
+    history.counter() = counter;
+    for (uint32_t i = 0; i < chunk.size; ++i) {
+      if (timestamps[i] >= beginTime && timestamps[i] <= endTime) {
+        history.timestamps()->push_back(timestamps[i]);
+        history.values()->push_back(values[i]);
+      }
+    }
+  }
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,167 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+#include <gflags/gflags.h>
+
+#include "fboss/agent/hw/gen-cpp2/hardware_stats_types.h"
+#include "fboss/agent/if/gen-cpp2/ctrl_types.h"
+
+DECLARE_int32(port_stats_history_memory_mb);
+
+namespace facebook::fboss {
+
+/*
+ * In memory history of the HwPortStats and HwSysPortStats snapshots the
+ * agent collects, for looking at the last few minutes of counters on the
+ * box without an external FSDB subscriber.
+ *
+ * Samples are stored per port, in chunks holding a timestamp column and one
+ * column per counter. Columns are delta-of-delta, zigzag varint encoded, so
+ * counters growing at a steady rate, or not at all, take about a byte per
+ * sample. Chunks older than the full resolution window are downsampled to
+ * one sample per interval (the last value, or the max for watermarks) and
+ * dropped once older than the downsampled window. If the history still
+ * exceeds its memory budget, the oldest chunks are dropped first.
+ *
+ * Counters are named after their thrift field, with per queue counters
+ * suffixed by the queue id, e.g. "inBytes_" or "queueOutBytes_.3". Nested
+ * structs (macsecStats) are not kept.
+ */
+class PortStatsHistory {
+ public:
+  struct Config {
+    std::chrono::seconds rawWindow;
+    std::chrono::seconds downsampleInterval;
+    std::chrono::seconds downsampledWindow;
+    size_t memoryBudgetBytes;
+  };
+  static constexpr uint32_t kSamplesPerChunk = 60;
+
+  // Configured from the port_stats_history_* flags
+  PortStatsHistory();
+  explicit PortStatsHistory(Config config);
+
+  /*
+   * Ports are sampled at their timestamp_, or now if not set. Snapshots no
+   * newer than the last one kept for a port are ignored, so the same stats
+   * can be passed in again.
+   */
+  void addStats(
+      const std::map<std::string, HwPortStats>& portStats,
+      const std::map<std::string, HwSysPortStats>& sysPortStats);
+
+  // Empty ports or counters select all of them. Times are seconds since epoch.
+  std::vector<PortCounterHistory> getHistory(
+      const std::set<std::string>& ports,
+      const std::set<std::string>& counters,
+      int64_t beginTime,
+      int64_t endTime) const;
+
+  // Bytes held by the encoded history
+  size_t memoryUsage() const;
+
+ private:
+  // Delta-of-delta, zigzag varint encoded samples
+  class Column {
+   public:
+    void append(int64_t value);
+    std::vector<int64_t> decode(uint32_t count) const;
+    void shrink();
+    size_t bytes() const;
+
+   private:
+    std::string data_;
+    int64_t last_{0};
+    int64_t lastDelta_{0};
+    bool empty_{true};
+  };
+
+  using Sample = std::vector<std::pair<uint32_t, int64_t>>;
+
+  struct Chunk {
+    bool full() const {
+      return size == kSamplesPerChunk;
+    }
+    void seal();
+    size_t bytes() const;
+
+    Column timestamps;
+    // Keyed by counter id
+    folly::F14FastMap<uint32_t, Column> counters;
+    int64_t beginTime{0};
+    int64_t endTime{0};
+    uint32_t size{0};
+    std::optional<size_t> sealedBytes;
+  };
+
+  struct PortHistory {
+    size_t bytes() const;
+
+    // back() is the chunk being appended to
+    std::deque<Chunk> raw;
+    std::deque<Chunk> downsampled;
+    // Downsample interval being filled from expired raw chunks
+    int64_t pendingBucket{-1};
+    int64_t pendingTime{0};
+    folly::F14FastMap<uint32_t, int64_t> pendingValues;
+  };
+
+  struct State {
+    std::vector<std::string> counterNames;
+    std::vector<bool> isWatermark;
+    folly::F14FastMap<std::string, uint32_t> counterIds;
+    folly::F14FastMap<std::string, PortHistory> ports;
+  };
+
+  // Timestamp of the sample added, if any
+  template <typename StatsT>
+  std::optional<int64_t> addPortStats(
+      State& state,
+      const std::string& portName,
+      const StatsT& stats,
+      int64_t now) const;
+  static uint32_t counterId(State& state, const std::string& name);
+  static void appendSample(
+      std::deque<Chunk>& chunks,
+      int64_t timestamp,
+      const Sample& sample);
+  void expire(State& state, int64_t now) const;
+  void downsample(const State& state, PortHistory& port, const Chunk& chunk)
+      const;
+  static void flushPending(PortHistory& port);
+  void enforceBudget(State& state) const;
+  static size_t memoryUsage(const State& state);
+  static void appendHistory(
+      const State& state,
+      const std::string& portName,
+      const Chunk& chunk,
+      const std::set<std::string>& counters,
+      int64_t beginTime,
+      int64_t endTime,
+      std::map<std::string, PortCounterHistory>& histories);
+
+  const Config config_;
+  folly::Synchronized<State> state_;
+};
+
+} // namespace facebook::fboss
@@ -13,6 +13,8 @@
 #include "fboss/agent/state/DeltaFunctions.h"
 #include "fboss/agent/state/SwitchState.h"
 
+#include <folly/hash/Hash.h>
+
 DEFINE_int32(
     ecmp_resource_percentage,
     75,
@@ -36,6 +38,22 @@ ResourceAccountant::ResourceAccountant(const HwAsicTable* asicTable)
   checkRouteUpdate_ = shouldCheckRouteUpdate();
 }
 
+size_t ResourceAccountant::NextHopSetHash::operator()(
+    const RouteNextHopEntry::NextHopSet& nhops) const {
+  size_t hash = nhops.size();
+  for (const auto& nhop : nhops) {
+    // Label actions are left out, next hops equal by operator== still hash
+    // the same
+    hash = folly::hash::hash_combine(
+        hash,
+        nhop.addr().hash(),
+        static_cast<uint32_t>(nhop.intfID().value_or(InterfaceID(0))),
+        nhop.weight(),
+        nhop.disableTTLDecrement().value_or(false));
+  }
+  return hash;
+}
+
 bool ResourceAccountant::isEcmp(const RouteNextHopEntry& fwd) const {
   for (const auto& nhop : fwd.normalizedNextHops()) {
     if (nhop.weight() && nhop.weight() > 1) {
@@ -142,28 +160,63 @@ bool ResourceAccountant::checkAndUpdateEcmpResource(
     const std::shared_ptr<Route<AddrT>>& route,
     bool add) {
   const auto& fwd = route->getForwardInfo();
-
+  if (fwd.getAction() != RouteForwardAction::NEXTHOPS) {
+    return true;
+  }
   // Forwarding to nextHops and more than one nextHop - use ECMP
-  if (fwd.getAction() == RouteForwardAction::NEXTHOPS &&
-      fwd.getNextHopSet().size() > 1) {
-    const auto& nhSet = fwd.getNextHopSet();
-    if (auto it = ecmpGroupRefMap_.find(nhSet); it != ecmpGroupRefMap_.end()) {
-      it->second = it->second + (add ? 1 : -1);
-      CHECK(it->second >= 0);
-      if (!add && it->second == 0) {
+  auto nhSet = fwd.getNextHopSet();
+  if (nhSet.size() <= 1) {
+    return true;
+  }
+
+  bool valid = true;
+  uint32_t memberCount = 0;
+  if (add) {
+    auto [it, inserted] = ecmpGroupRefMap_.try_emplace(nhSet, 0);
+    ++it->second;
+    if (inserted) {
+      // ECMP group does not exists in hw - Check if any usage exceeds ASIC
+      // limit
+      memberCount = getMemberCountForEcmpGroup(fwd);
+      ecmpMemberUsage_ += memberCount;
+      valid = checkEcmpResource(true /* intermediateState */);
+    }
+  } else {
+    auto it = ecmpGroupRefMap_.find(nhSet);
+    CHECK(it != ecmpGroupRefMap_.end());
+    if (--it->second == 0) {
+      ecmpGroupRefMap_.erase(it);
+      memberCount = getMemberCountForEcmpGroup(fwd);
+      ecmpMemberUsage_ -= memberCount;
+    }
+  }
+  if (journalEcmpGroupUpdates_) {
+    ecmpGroupUpdateJournal_.push_back({std::move(nhSet), add, memberCount});
+  }
+  return valid;
+}
+
+void ResourceAccountant::rollbackEcmpGroupUpdates() {
+  for (auto update = ecmpGroupUpdateJournal_.rbegin();
+       update != ecmpGroupUpdateJournal_.rend();
+       ++update) {
+    if (update->add) {
+      auto it = ecmpGroupRefMap_.find(update->nhSet);
+      CHECK(it != ecmpGroupRefMap_.end());
+      if (--it->second == 0) {
         ecmpGroupRefMap_.erase(it);
-        ecmpMemberUsage_ -= getMemberCountForEcmpGroup(fwd);
+        ecmpMemberUsage_ -= update->memberCount;
+      }
+    } else {
+      auto [it, inserted] =
+          ecmpGroupRefMap_.try_emplace(std::move(update->nhSet), 0);
+      ++it->second;
+      if (inserted) {
+        ecmpMemberUsage_ += update->memberCount;
       }
-      return true;
     }
-    // ECMP group does not exists in hw - Check if any usage exceeds ASIC
-    // limit
-    CHECK(add);
-    ecmpGroupRefMap_[nhSet] = 1;
-    ecmpMemberUsage_ += getMemberCountForEcmpGroup(fwd);
-    return checkEcmpResource(true /* intermediateState */);
   }
-  return true;
+  ecmpGroupUpdateJournal_.clear();
 }
 
 bool ResourceAccountant::shouldCheckRouteUpdate() const {
@@ -310,13 +363,22 @@ void ResourceAccountant::stateChanged(const StateDelta& delta) {
 }
 
 bool ResourceAccountant::isValidUpdate(const StateDelta& delta) {
+  auto l2Entries = l2Entries_;
+  journalEcmpGroupUpdates_ = true;
   bool validRouteUpdate = isValidRouteUpdate(delta);
+  journalEcmpGroupUpdates_ = false;
   bool validL2Update = true;
 
   if (FLAGS_enable_mac_update_protection) {
     validL2Update = l2StateChangedImpl(delta);
   }
 
-  return validRouteUpdate && validL2Update;
+  if (!validRouteUpdate || !validL2Update) {
+    rollbackEcmpGroupUpdates();
+    l2Entries_ = l2Entries;
+    return false;
+  }
+  ecmpGroupUpdateJournal_.clear();
+  return true;
 }
 } // namespace facebook::fboss
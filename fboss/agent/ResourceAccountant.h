@@ -14,6 +14,7 @@
 #include "fboss/agent/state/RouteNextHopEntry.h"
 #include "fboss/agent/state/StateDelta.h"
 
+#include <folly/container/F14Map.h>
 #include <gtest/gtest.h>
 
 DECLARE_int32(max_l2_entries);
@@ -26,12 +27,29 @@ class ResourceAccountant {
  public:
   explicit ResourceAccountant(const HwAsicTable* asicTable);
 
+  /*
+   * Accounts for the delta and returns true if it fits in HW resources.
+   * Otherwise the accounting is rolled back to before the delta and false
+   * is returned.
+   */
   bool isValidUpdate(const StateDelta& delta);
   bool isValidRouteUpdate(const StateDelta& delta);
   void stateChanged(const StateDelta& delta);
   void enableDlbResourceCheck(bool enable);
 
  private:
+  struct NextHopSetHash {
+    size_t operator()(const RouteNextHopEntry::NextHopSet& nhops) const;
+  };
+
+  // ECMP group refcount change made by the update being validated
+  struct EcmpGroupUpdate {
+    RouteNextHopEntry::NextHopSet nhSet;
+    bool add;
+    // Members of the group if this change created or erased it, 0 otherwise
+    uint32_t memberCount;
+  };
+
   int getMemberCountForEcmpGroup(const RouteNextHopEntry& fwd) const;
   bool checkEcmpResource(bool intermediateState) const;
   bool checkDlbResource(uint32_t resourcePercentage) const;
@@ -47,10 +65,17 @@ class ResourceAccountant {
       const std::shared_ptr<Route<AddrT>>& route,
       bool add);
 
+  void rollbackEcmpGroupUpdates();
+
   bool l2StateChangedImpl(const StateDelta& delta);
 
   uint32_t ecmpMemberUsage_{0};
-  std::map<RouteNextHopEntry::NextHopSet, uint32_t> ecmpGroupRefMap_;
+  folly::F14FastMap<RouteNextHopEntry::NextHopSet, uint32_t, NextHopSetHash>
+      ecmpGroupRefMap_;
+  // Changes are only journaled while validating an update, so that a
+  // rejected update is undone without walking the reverse delta
+  bool journalEcmpGroupUpdates_{false};
+  std::vector<EcmpGroupUpdate> ecmpGroupUpdateJournal_;
 
   const HwAsicTable* asicTable_;
   bool nativeWeightedEcmp_{true};
@@ -62,6 +87,7 @@ class ResourceAccountant {
   FRIEND_TEST(ResourceAccountantTest, checkDlbResource);
   FRIEND_TEST(ResourceAccountantTest, checkEcmpResource);
   FRIEND_TEST(ResourceAccountantTest, checkAndUpdateEcmpResource);
+  FRIEND_TEST(ResourceAccountantTest, rollbackEcmpGroupUpdates);
   FRIEND_TEST(ResourceAccountantTest, computeWeightedEcmpMemberCount);
   FRIEND_TEST(MacTableManagerTest, MacLearnedBulkCb);
 };
@@ -0,0 +1,280 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/RouteUpdateTrace.h"
+
+#include <fb303/ThreadCachedServiceData.h>
+#include <folly/Conv.h>
+#include <folly/FileUtil.h>
+#include <folly/Indestructible.h>
+#include <folly/String.h>
+#include <folly/Synchronized.h>
+#include <folly/json/dynamic.h>
+#include <folly/json/json.h>
+#include <folly/logging/xlog.h>
+#include <folly/system/ThreadId.h>
+#include <gflags/gflags.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <utility>
+
+DEFINE_bool(
+    enable_route_update_trace,
+    false,
+    "Trace per stage latency of route update requests through RIB, "
+    "SwSwitch and HwSwitch");
+DEFINE_int32(
+    route_update_trace_sample_rate,
+    0,
+    "Keep 1 in N route update traces for dumping in Chrome trace format, "
+    "0 to keep none");
+DEFINE_int32(
+    route_update_trace_buffer_size,
+    64,
+    "Number of sampled route update traces to keep");
+DEFINE_string(
+    route_update_trace_file,
+    "",
+    "File sampled route update traces are written to in Chrome trace "
+    "format, empty to only keep them in memory");
+
+namespace facebook::fboss {
+
+namespace {
+
+struct HistogramRange {
+  int64_t bucketUsecs;
+  int64_t maxUsecs;
+};
+
+HistogramRange histogramRange(RouteUpdateStage stage) {
+  switch (stage) {
+    case RouteUpdateStage::RIB:
+    case RouteUpdateStage::QUEUE_WAIT:
+    case RouteUpdateStage::STATE_UPDATE:
+    case RouteUpdateStage::FSDB_ENQUEUE:
+      // [0, 100ms], 100us width (1000 bins)
+      return {100, 100000};
+    case RouteUpdateStage::HW_UPDATE:
+    case RouteUpdateStage::TOTAL:
+    case RouteUpdateStage::NUM_STAGES:
+      break;
+  }
+  // Programming a large update takes seconds: [0, 2s], 1ms width (2000
+  // bins)
+  return {1000, 2000000};
+}
+
+using SampledTraces =
+    folly::Synchronized<std::deque<std::shared_ptr<const RouteUpdateTrace>>>;
+
+SampledTraces& sampledTraces() {
+  static folly::Indestructible<SampledTraces> traces;
+  return *traces;
+}
+
+std::shared_ptr<RouteUpdateTrace>& currentTrace() {
+  static thread_local std::shared_ptr<RouteUpdateTrace> trace;
+  return trace;
+}
+
+std::string histogramName(RouteUpdateStage stage) {
+  return folly::to<std::string>(
+      "route_update.", routeUpdateStageName(stage), ".us");
+}
+
+void addHistograms() {
+  static std::once_flag once;
+  std::call_once(once, [] {
+    for (size_t i = 0; i < static_cast<size_t>(RouteUpdateStage::NUM_STAGES);
+         ++i) {
+      auto stage = static_cast<RouteUpdateStage>(i);
+      auto name = histogramName(stage);
+      auto range = histogramRange(stage);
+      fb303::ThreadCachedServiceData::get()->addHistogram(
+          name, range.bucketUsecs, 0, range.maxUsecs);
+      fb303::ThreadCachedServiceData::get()->exportHistogram(name, 50, 95, 99);
+    }
+  });
+}
+
+int64_t toUsecs(RouteUpdateTrace::Clock::duration duration) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(duration)
+      .count();
+}
+
+} // namespace
+
+const char* routeUpdateStageName(RouteUpdateStage stage) {
+  switch (stage) {
+    case RouteUpdateStage::RIB:
+      return "rib";
+    case RouteUpdateStage::QUEUE_WAIT:
+      return "queue_wait";
+    case RouteUpdateStage::STATE_UPDATE:
+      return "state_update";
+    case RouteUpdateStage::HW_UPDATE:
+      return "hw_update";
+    case RouteUpdateStage::FSDB_ENQUEUE:
+      return "fsdb_enqueue";
+    case RouteUpdateStage::TOTAL:
+      return "total";
+    case RouteUpdateStage::NUM_STAGES:
+      break;
+  }
+  return "unknown";
+}
+
+RouteUpdateTrace::RouteUpdateTrace(
+    folly::StringPiece name,
+    uint64_t id,
+    bool sampled)
+    : name_(name.str()), id_(id), sampled_(sampled) {
+  begin(RouteUpdateStage::TOTAL);
+}
+
+std::shared_ptr<RouteUpdateTrace> RouteUpdateTrace::start(
+    folly::StringPiece name) {
+  if (!FLAGS_enable_route_update_trace) {
+    return nullptr;
+  }
+  static std::atomic<uint64_t> nextID{0};
+  auto id = nextID++;
+  auto sampled = FLAGS_route_update_trace_sample_rate > 0 &&
+      id % FLAGS_route_update_trace_sample_rate == 0;
+  return std::make_shared<RouteUpdateTrace>(name, id, sampled);
+}
+
+const std::shared_ptr<RouteUpdateTrace>& RouteUpdateTrace::current() {
+  return currentTrace();
+}
+
+void RouteUpdateTrace::begin(RouteUpdateStage stage) {
+  auto now = Clock::now();
+  std::lock_guard<std::mutex> guard(lock_);
+  openStages_[static_cast<size_t>(stage)] = now;
+}
+
+void RouteUpdateTrace::end(RouteUpdateStage stage) {
+  auto now = Clock::now();
+  auto idx = static_cast<size_t>(stage);
+  std::lock_guard<std::mutex> guard(lock_);
+  auto& start = openStages_[idx];
+  if (!start) {
+    return;
+  }
+  stageDurations_[idx] += now - *start;
+  stageRecorded_[idx] = true;
+  spans_.push_back(Span{stage, *start, now, folly::getOSThreadID()});
+  start.reset();
+}
+
+void RouteUpdateTrace::finish() {
+  end(RouteUpdateStage::TOTAL);
+  addHistograms();
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    for (size_t i = 0; i < kNumStages; ++i) {
+      if (stageRecorded_[i]) {
+        fb303::ThreadCachedServiceData::get()->addHistogramValue(
+            histogramName(static_cast<RouteUpdateStage>(i)),
+            toUsecs(stageDurations_[i]));
+      }
+    }
+  }
+  if (!sampled_) {
+    return;
+  }
+  sampledTraces().withWLock([this](auto& traces) {
+    traces.push_back(shared_from_this());
+    while (traces.size() >
+           std::max<size_t>(1, FLAGS_route_update_trace_buffer_size)) {
+      traces.pop_front();
+    }
+  });
+  if (!FLAGS_route_update_trace_file.empty()) {
+    auto chromeTrace = toChromeTrace(getSampledTraces());
+    if (auto err = folly::writeFileAtomicNoThrow(
+            FLAGS_route_update_trace_file, chromeTrace)) {
+      XLOG(ERR) << "Failed to write route update traces to "
+                << FLAGS_route_update_trace_file << ": "
+                << folly::errnoStr(err);
+    }
+  }
+}
+
+std::chrono::microseconds RouteUpdateTrace::getStageDuration(
+    RouteUpdateStage stage) const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      stageDurations_[static_cast<size_t>(stage)]);
+}
+
+std::vector<RouteUpdateTrace::Span> RouteUpdateTrace::getSpans() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return spans_;
+}
+
+std::vector<std::shared_ptr<const RouteUpdateTrace>>
+RouteUpdateTrace::getSampledTraces() {
+  auto traces = sampledTraces().rlock();
+  return {traces->begin(), traces->end()};
+}
+
+void RouteUpdateTrace::clearSampledTraces() {
+  sampledTraces().wlock()->clear();
+}
+
+std::string RouteUpdateTrace::toChromeTrace(
+    const std::vector<std::shared_ptr<const RouteUpdateTrace>>& traces) {
+  // Complete ("X") events, one process per request so the stages of a
+  // request line up by thread
+  folly::dynamic events = folly::dynamic::array;
+  for (const auto& trace : traces) {
+    for (const auto& span : trace->getSpans()) {
+      folly::dynamic event = folly::dynamic::object;
+      event["name"] = routeUpdateStageName(span.stage);
+      event["cat"] = trace->getName();
+      event["ph"] = "X";
+      event["ts"] = toUsecs(span.start.time_since_epoch());
+      event["dur"] = toUsecs(span.end - span.start);
+      event["pid"] = static_cast<int64_t>(trace->getID());
+      event["tid"] = static_cast<int64_t>(span.threadId);
+      events.push_back(std::move(event));
+    }
+  }
+  folly::dynamic chromeTrace = folly::dynamic::object;
+  chromeTrace["traceEvents"] = std::move(events);
+  chromeTrace["displayTimeUnit"] = "ms";
+  return folly::toJson(chromeTrace);
+}
+
+RouteUpdateTrace::Scope::Scope(std::shared_ptr<RouteUpdateTrace> trace)
+    : previous_(std::exchange(currentTrace(), std::move(trace))) {}
+
+RouteUpdateTrace::Scope::~Scope() {
+  currentTrace() = std::move(previous_);
+}
+
+RouteUpdateTrace::ScopedStage::ScopedStage(RouteUpdateStage stage)
+    : trace_(currentTrace().get()), stage_(stage) {
+  if (trace_) {
+    trace_->begin(stage_);
+  }
+}
+
+RouteUpdateTrace::ScopedStage::~ScopedStage() {
+  if (trace_) {
+    trace_->end(stage_);
+  }
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,155 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <folly/Range.h>
+
+namespace facebook::fboss {
+
+/*
+ * Stages a route update request goes through, from the thrift handler to
+ * the hardware. FSDB_ENQUEUE only covers handing the state delta to the
+ * FSDB syncer, which publishes it asynchronously. TOTAL covers the whole
+ * request.
+ */
+enum class RouteUpdateStage : uint8_t {
+  RIB,
+  QUEUE_WAIT,
+  STATE_UPDATE,
+  HW_UPDATE,
+  FSDB_ENQUEUE,
+  TOTAL,
+  NUM_STAGES,
+};
+
+const char* routeUpdateStageName(RouteUpdateStage stage);
+
+/*
+ * Latency trace of a single route update request (addUnicastRoutes,
+ * syncFib etc.), enabled with --enable_route_update_trace.
+ *
+ * The trace is started on the thrift thread and made current on every
+ * thread that works on the request: the RIB thread and, through the
+ * StateUpdate it queues, the SwSwitch update thread. Each stage records a
+ * span, stage durations are exported as route_update.<stage>.us
+ * histograms and 1 in --route_update_trace_sample_rate traces are kept so
+ * they can be dumped in Chrome trace format.
+ */
+class RouteUpdateTrace
+    : public std::enable_shared_from_this<RouteUpdateTrace> {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Span {
+    RouteUpdateStage stage;
+    Clock::time_point start;
+    Clock::time_point end;
+    uint64_t threadId;
+  };
+
+  RouteUpdateTrace(folly::StringPiece name, uint64_t id, bool sampled);
+
+  /*
+   * Returns a new trace if tracing is enabled, nullptr otherwise.
+   */
+  static std::shared_ptr<RouteUpdateTrace> start(folly::StringPiece name);
+
+  /*
+   * Trace of the request being worked on by this thread, if any.
+   */
+  static const std::shared_ptr<RouteUpdateTrace>& current();
+
+  void begin(RouteUpdateStage stage);
+  void end(RouteUpdateStage stage);
+
+  /*
+   * Ends the TOTAL stage, exports stage histograms and keeps the trace if
+   * it was sampled. Called once the request is done.
+   */
+  void finish();
+
+  const std::string& getName() const {
+    return name_;
+  }
+  uint64_t getID() const {
+    return id_;
+  }
+  bool isSampled() const {
+    return sampled_;
+  }
+  std::chrono::microseconds getStageDuration(RouteUpdateStage stage) const;
+  std::vector<Span> getSpans() const;
+
+  /*
+   * Most recent sampled traces, oldest first.
+   */
+  static std::vector<std::shared_ptr<const RouteUpdateTrace>>
+  getSampledTraces();
+  static void clearSampledTraces();
+  static std::string toChromeTrace(
+      const std::vector<std::shared_ptr<const RouteUpdateTrace>>& traces);
+
+  /*
+   * Makes a trace current on this thread for the lifetime of the scope.
+   */
+  class Scope {
+   public:
+    explicit Scope(std::shared_ptr<RouteUpdateTrace> trace);
+    ~Scope();
+
+   private:
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    std::shared_ptr<RouteUpdateTrace> previous_;
+  };
+
+  /*
+   * Records a stage of the current trace, no-op if there is none.
+   */
+  class ScopedStage {
+   public:
+    explicit ScopedStage(RouteUpdateStage stage);
+    ~ScopedStage();
+
+   private:
+    ScopedStage(const ScopedStage&) = delete;
+    ScopedStage& operator=(const ScopedStage&) = delete;
+
+    RouteUpdateTrace* trace_;
+    RouteUpdateStage stage_;
+  };
+
+ private:
+  static constexpr auto kNumStages =
+      static_cast<size_t>(RouteUpdateStage::NUM_STAGES);
+
+  const std::string name_;
+  const uint64_t id_;
+  const bool sampled_;
+
+  // Stages are handed off between threads, so guard them with a lock
+  mutable std::mutex lock_;
+  std::array<std::optional<Clock::time_point>, kNumStages> openStages_;
+  std::array<Clock::duration, kNumStages> stageDurations_{};
+  std::array<bool, kNumStages> stageRecorded_{};
+  std::vector<Span> spans_;
+};
+
+} // namespace facebook::fboss
@@ -20,6 +20,7 @@
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/FbossHwUpdateError.h"
 #include "fboss/agent/FibHelpers.h"
+#include "fboss/agent/FibLpmSnapshot.h"
 #include "fboss/agent/LinkConnectivityProcessor.h"
 #include "fboss/agent/Utils.h"
 
@@ -44,6 +45,7 @@
 #include "fboss/agent/BuildInfoWrapper.h"
 #include "fboss/agent/DsfSubscriber.h"
 #include "fboss/agent/FsdbSyncer.h"
+#include "fboss/agent/HwSwitchStatsDelta.h"
 #include "fboss/agent/HwSwitchThriftClientTable.h"
 #include "fboss/agent/MPLSHandler.h"
 #include "fboss/agent/MacTableManager.h"
@@ -56,12 +58,14 @@
 #include "fboss/agent/PacketObserver.h"
 #include "fboss/agent/PhySnapshotManager.h"
 #include "fboss/agent/PortStats.h"
+#include "fboss/agent/PortStatsHistory.h"
 #include "fboss/agent/PortUpdateHandler.h"
 #include "fboss/agent/RemoteNeighborUpdater.h"
 #include "fboss/agent/ResolvedNexthopMonitor.h"
 #include "fboss/agent/ResolvedNexthopProbeScheduler.h"
 #include "fboss/agent/RestartTimeTracker.h"
 #include "fboss/agent/RouteUpdateLogger.h"
+#include "fboss/agent/RouteUpdateTrace.h"
 #include "fboss/agent/RxPacket.h"
 #include "fboss/agent/StaticL2ForNeighborObserver.h"
 #include "fboss/agent/SwSwitchRouteUpdateWrapper.h"
@@ -90,6 +94,7 @@
 #include "fboss/agent/state/StateDelta.h"
 #include "fboss/agent/state/StateUpdateHelpers.h"
 #include "fboss/agent/state/SwitchState.h"
+#include "fboss/lib/FunctionCallTimeReporter.h"
 #include "fboss/lib/config/PlatformConfigUtils.h"
 #include "fboss/lib/phy/gen-cpp2/phy_types.h"
 #include "fboss/lib/platforms/PlatformProductInfo.h"
@@ -148,6 +153,19 @@ using namespace apache::thrift::transport;
 using namespace apache::thrift::protocol;
 
 DEFINE_int32(thread_heartbeat_ms, 1000, "Thread heartbeat interval (ms)");
+DEFINE_bool(
+    enable_thread_stall_profiler,
+    false,
+    "Capture stack samples of agent threads whose heartbeat is late");
+DEFINE_int32(
+    thread_stall_profiler_threshold_ms,
+    500,
+    "Heartbeat lag (ms) after which a thread is considered stalled and its "
+    "stack is sampled");
+DEFINE_int32(
+    thread_stall_profiler_max_samples,
+    32,
+    "Number of most recent thread stall samples to keep");
 DEFINE_int32(
     distribution_timeout_ms,
     1000,
@@ -485,6 +503,10 @@ SwSwitch::SwSwitch(
     multiSwitchFb303Stats_ =
         std::make_unique<MultiSwitchFb303Stats>(getHwAsicTable()->getHwAsics());
   }
+  if (FLAGS_port_stats_history_memory_mb > 0) {
+    portStatsHistory_ = std::make_unique<PortStatsHistory>();
+  }
+  fibLpmSnapshot_ = std::make_unique<FibLpmSnapshot>();
   fsdbSyncer_.withWLock(
       [this](auto& syncer) { syncer = std::make_unique<FsdbSyncer>(this); });
   if (initialState) {
@@ -593,6 +615,10 @@ void SwSwitch::stop(bool isGracefulStop, bool revertToMinAlpmState) {
     heartbeatWatchdog_->stop();
     heartbeatWatchdog_.reset();
   }
+  if (threadStallProfiler_) {
+    threadStallProfiler_->stop();
+    threadStallProfiler_.reset();
+  }
   bgThreadHeartbeat_.reset();
   updThreadHeartbeat_.reset();
   packetTxThreadHeartbeat_.reset();
@@ -1501,6 +1527,7 @@ void SwSwitch::notifyStateObservers(const StateDelta& delta) {
   // Update AddrToLocalIntf map maintained in sw switch, for fast interface
   // lookup in rx path.
   updateAddrToLocalIntf(delta);
+  fibLpmSnapshot_->stateUpdated(delta);
 
   for (auto observerName : stateObservers_) {
     try {
@@ -1512,6 +1539,7 @@ void SwSwitch::notifyStateObservers(const StateDelta& delta) {
                   << " of update: " << folly::exceptionStr(ex);
     }
   }
+  RouteUpdateTrace::ScopedStage traceStage(RouteUpdateStage::FSDB_ENQUEUE);
   runFsdbSyncFunction([&delta](auto& syncer) { syncer->stateUpdated(delta); });
 }
 
@@ -1530,6 +1558,13 @@ bool SwSwitch::updateState(unique_ptr<StateUpdate> update) {
                << " since exit already started";
     return false;
   }
+  // Updates queued by state observers on the update thread are not part of
+  // the route update being applied, so they don't inherit its trace.
+  const auto& trace = RouteUpdateTrace::current();
+  if (trace && !updateEventBase_.isInEventBaseThread()) {
+    trace->begin(RouteUpdateStage::QUEUE_WAIT);
+    update->trace_ = trace;
+  }
   {
     std::unique_lock guard(pendingUpdatesLock_);
     pendingUpdates_.push_back(*update.release());
@@ -1627,6 +1662,15 @@ void SwSwitch::handlePendingUpdates() {
     return;
   }
 
+  for (auto& update : updates) {
+    if (update.trace_) {
+      update.trace_->end(RouteUpdateStage::QUEUE_WAIT);
+    }
+  }
+  // Route update stages are only traced for updates applied by themselves
+  RouteUpdateTrace::Scope traceScope(
+      updates.size() == 1 ? updates.begin()->trace_ : nullptr);
+
   // Non coalescing updates should be applied individually
   bool isNonCoalescing = updates.begin()->isNonCoalescing();
   if (isNonCoalescing) {
@@ -1654,6 +1698,7 @@ void SwSwitch::handlePendingUpdates() {
     shared_ptr<SwitchState> intermediateState;
     XLOG(DBG2) << "preparing state update " << update->getName();
     try {
+      RouteUpdateTrace::ScopedStage traceStage(RouteUpdateStage::STATE_UPDATE);
       intermediateState = update->applyUpdate(newDesiredState);
     } catch (const std::exception& ex) {
       // Call the update's onError() function, and then immediately delete
@@ -1764,6 +1809,7 @@ std::shared_ptr<SwitchState> SwSwitch::applyUpdate(
   // Check that we are starting from what has been already applied
   DCHECK_EQ(oldState, getAppliedState());
 
+  ScopedStageTimer stageTimer(CallTimeStage::DELTA);
   auto start = std::chrono::steady_clock::now();
   XLOG(DBG2) << "Updating state: old_gen=" << oldState->getGeneration()
              << " new_gen=" << newState->getGeneration();
@@ -1777,9 +1823,8 @@ std::shared_ptr<SwitchState> SwSwitch::applyUpdate(
     return oldState;
   }
 
+  // Resource accountant rolls itself back on an invalid update
   if (!resourceAccountant_->isValidUpdate(delta)) {
-    // Notify resource account to revert back to previous state
-    resourceAccountant_->stateChanged(StateDelta(newState, oldState));
     return oldState;
   }
 
@@ -1798,6 +1843,7 @@ std::shared_ptr<SwitchState> SwSwitch::applyUpdate(
   // undesirable.  So far I don't think this brief discrepancy should cause
   // major issues.
   try {
+    RouteUpdateTrace::ScopedStage traceStage(RouteUpdateStage::HW_UPDATE);
     newAppliedState = stateChanged(delta, isTransaction);
   } catch (const std::exception& ex) {
     // Notify the hw_ of the crash so it can execute any device specific
@@ -2531,6 +2577,24 @@ void SwSwitch::postInit() {
       dsfSubscriberStreamThreadHeartbeat_);
   heartbeatWatchdog_->start();
 
+  if (FLAGS_enable_thread_stall_profiler) {
+    threadStallProfiler_ = std::make_unique<ThreadStallProfiler>(
+        std::chrono::milliseconds(FLAGS_thread_stall_profiler_threshold_ms),
+        FLAGS_thread_stall_profiler_max_samples,
+        std::chrono::milliseconds(FLAGS_thread_heartbeat_ms));
+    for (const auto& heartbeat :
+         {bgThreadHeartbeat_,
+          packetTxThreadHeartbeat_,
+          updThreadHeartbeat_,
+          lacpThreadHeartbeat_,
+          neighborCacheThreadHeartbeat_,
+          dsfSubscriberReconnectThreadHeartbeat_,
+          dsfSubscriberStreamThreadHeartbeat_}) {
+      threadStallProfiler_->startProfilingHeartbeat(heartbeat);
+    }
+    threadStallProfiler_->start();
+  }
+
   setSwitchRunState(SwitchRunState::INITIALIZED);
 }
 
@@ -2625,10 +2689,15 @@ std::unique_ptr<TxPacket> SwSwitch::allocateL3TxPacket(uint32_t l3Len) {
   auto len = std::max(l2Len + l3Len, minLen);
   auto pkt = multiHwSwitchHandler_->allocatePacket(len);
   auto buf = pkt->buf();
-  // make sure the whole buffer is available
-  buf->clear();
-  // reserve for l2 header
-  buf->advance(l2Len);
+  if (buf->headroom() >= l2Len) {
+    // Pooled buffers already have headroom for the l2 header, keep it
+    buf->trimEnd(buf->length());
+  } else {
+    // make sure the whole buffer is available
+    buf->clear();
+    // reserve for l2 header
+    buf->advance(l2Len);
+  }
   return pkt;
 }
 
@@ -2752,6 +2821,25 @@ void SwSwitch::sendPacketOutViaThriftStream(
     SwitchID switchId,
     std::optional<PortID> portID,
     std::optional<uint8_t> queue) noexcept {
+  auto switchIndex =
+      getSwitchInfoTable().getSwitchIndexFromSwitchId(SwitchID(switchId));
+  ShmPacketRing::PacketInfo info;
+  if (portID) {
+    info.port = portID.value();
+  }
+  if (queue) {
+    info.queue = queue.value();
+  }
+  if (auto queued = getPacketStreamMap()->sendPacketToRing(
+          switchId, info, *pkt->buf())) {
+    if (*queued) {
+      stats()->hwAgentTxPktSent(switchIndex);
+    } else {
+      stats()->pktDropped();
+    }
+    return;
+  }
+
   multiswitch::TxPacket txPacket;
   if (portID) {
     txPacket.port() = portID.value();
@@ -2761,8 +2849,6 @@ void SwSwitch::sendPacketOutViaThriftStream(
   }
   txPacket.length() = pkt->buf()->computeChainDataLength();
   txPacket.data() = Packet::extractIOBuf(std::move(pkt));
-  auto switchIndex =
-      getSwitchInfoTable().getSwitchIndexFromSwitchId(SwitchID(switchId));
   try {
     getPacketStreamMap()->getStream(switchId).next(std::move(txPacket));
     stats()->hwAgentTxPktSent(switchIndex);
@@ -3025,6 +3111,13 @@ void SwSwitch::applyConfigImpl(
   // us.
   auto routeUpdater = getRouteUpdater();
   auto oldConfig = getConfig();
+  // Fingerprints are only valid for the state they were recorded against, so
+  // drop them until this application succeeds.
+  AppliedConfigSections appliedSections;
+  appliedConfigSections_.swap(appliedSections);
+  if (!FLAGS_skip_unchanged_config_sections) {
+    appliedSections.clear();
+  }
   updateStateBlocking(
       reason,
       [&](const shared_ptr<SwitchState>& state) -> shared_ptr<SwitchState> {
@@ -3036,7 +3129,8 @@ void SwSwitch::applyConfigImpl(
             platformMapping_.get(),
             hwAsicTable_.get(),
             &routeUpdater,
-            aclNexthopHandler_.get());
+            aclNexthopHandler_.get(),
+            &appliedSections);
 
         if (newState && !isValidStateUpdate(StateDelta(state, newState))) {
           throw FbossError("Invalid config passed in, skipping");
@@ -3053,6 +3147,7 @@ void SwSwitch::applyConfigImpl(
   // Since we're using blocking state update, once we reach here, the new
   // config should be already applied and programmed into hardware.
   updateConfigAppliedInfo();
+  appliedConfigSections_.swap(appliedSections);
 
   /*
    * For RIB always make route programming go through the routeUpdater wrapper
@@ -3221,6 +3316,29 @@ template std::shared_ptr<Route<folly::IPAddressV6>> SwSwitch::longestMatch(
     const folly::IPAddressV6& address,
     RouterID vrf);
 
+template <typename AddressT>
+std::shared_ptr<Route<AddressT>> SwSwitch::fibLongestMatch(
+    const std::shared_ptr<SwitchState>& state,
+    const AddressT& address,
+    RouterID vrf) const {
+  if (auto route = fibLpmSnapshot_->longestMatch(state, address, vrf)) {
+    return std::move(*route);
+  }
+  // The snapshot is at another state, which is rare outside route churn.
+  // Fall back to the RIB instead of probing each prefix length in the FIB
+  // of state, which is what makes lookups slow during churn.
+  return findLongestMatchRoute(getRib(), vrf, address, state);
+}
+
+template std::shared_ptr<Route<folly::IPAddressV4>> SwSwitch::fibLongestMatch(
+    const std::shared_ptr<SwitchState>& state,
+    const folly::IPAddressV4& address,
+    RouterID vrf) const;
+template std::shared_ptr<Route<folly::IPAddressV6>> SwSwitch::fibLongestMatch(
+    const std::shared_ptr<SwitchState>& state,
+    const folly::IPAddressV6& address,
+    RouterID vrf) const;
+
 void SwSwitch::l2LearningUpdateReceived(
     L2Entry l2Entry,
     L2EntryUpdateType l2EntryUpdateType) {
@@ -3522,9 +3640,29 @@ bool SwSwitch::needL2EntryForNeighbor() const {
 void SwSwitch::updateHwSwitchStats(
     uint16_t switchIndex,
     multiswitch::HwSwitchStats hwStats) {
+  if (portStatsHistory_) {
+    portStatsHistory_->addStats(
+        *hwStats.hwPortStats(), *hwStats.sysPortStats());
+  }
   (*hwSwitchStats_.wlock())[switchIndex] = std::move(hwStats);
 }
 
+bool SwSwitch::updateHwSwitchStats(
+    uint16_t switchIndex,
+    HwSwitchStatsDeltaDecoder& decoder,
+    multiswitch::HwSwitchStatsDelta delta) {
+  auto lockedStats = hwSwitchStats_.wlock();
+  auto& hwStats = (*lockedStats)[switchIndex];
+  if (!decoder.apply(hwStats, std::move(delta))) {
+    return false;
+  }
+  if (portStatsHistory_) {
+    portStatsHistory_->addStats(
+        *hwStats.hwPortStats(), *hwStats.sysPortStats());
+  }
+  return true;
+}
+
 multiswitch::HwSwitchStats SwSwitch::getHwSwitchStatsExpensive(
     uint16_t switchIndex) const {
   auto lockedStats = hwSwitchStats_.rlock();
@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include "fboss/agent/ApplyThriftConfig.h"
 #include "fboss/agent/FbossEventBase.h"
 #include "fboss/agent/HwSwitchHandler.h"
 #include "fboss/agent/L2LearnEventObserver.h"
@@ -32,6 +33,7 @@
 #include "fboss/agent/types.h"
 #include "fboss/lib/HwWriteBehavior.h"
 #include "fboss/lib/ThreadHeartbeat.h"
+#include "fboss/lib/ThreadStallProfiler.h"
 #include "fboss/lib/phy/gen-cpp2/phy_types.h"
 
 #include <folly/IntrusiveList.h>
@@ -65,11 +67,14 @@ class LinkAggregationManager;
 class LldpManager;
 class MPLSHandler;
 class PktCaptureManager;
+class FibLpmSnapshot;
+class HwSwitchStatsDeltaDecoder;
 class PlatformMapping;
 class PlatformProductInfo;
 class Port;
 class PortDescriptor;
 class PortStats;
+class PortStatsHistory;
 class PortUpdateHandler;
 class RxPacket;
 class SwitchState;
@@ -590,6 +595,10 @@ class SwSwitch : public HwSwitchCallback {
 
   /*
    * Allocate a new TxPacket.
+   *
+   * SAI and multi-switch packets are allocated from the TxPacketBufferPool
+   * with headroom reserved for the L2 header. The buffer goes back to the
+   * pool when the packet is destroyed.
    */
   std::unique_ptr<TxPacket> allocatePacket(uint32_t size) const;
 
@@ -765,6 +774,20 @@ class SwSwitch : public HwSwitchCallback {
     return resolvedNexthopMonitor_.get();
   }
 
+  /*
+   * Get the ThreadStallProfiler, null unless stall profiling is enabled
+   */
+  const ThreadStallProfiler* getThreadStallProfiler() const {
+    return threadStallProfiler_.get();
+  }
+
+  /*
+   * Get the port stats history, null if --port_stats_history_memory_mb is 0
+   */
+  const PortStatsHistory* getPortStatsHistory() const {
+    return portStatsHistory_.get();
+  }
+
   LookupClassUpdater* getLookupClassUpdater() {
     return lookupClassUpdater_.get();
   }
@@ -859,6 +882,17 @@ class SwSwitch : public HwSwitchCallback {
       const AddressT& address,
       RouterID vrf);
 
+  /*
+   * Lock free lookup in the FIB of state, for the packet rx path, which
+   * only returns resolved routes, see FibLpmSnapshot. Falls back to the RIB,
+   * which may return unresolved routes, if the FIB snapshot is not at state.
+   */
+  template <typename AddressT>
+  std::shared_ptr<Route<AddressT>> fibLongestMatch(
+      const std::shared_ptr<SwitchState>& state,
+      const AddressT& address,
+      RouterID vrf) const;
+
   ResolvedNexthopProbeScheduler* getResolvedNexthopProbeScheduler() {
     return resolvedNexthopProbeScheduler_.get();
   }
@@ -951,6 +985,12 @@ class SwSwitch : public HwSwitchCallback {
   void updateHwSwitchStats(
       uint16_t switchIndex,
       multiswitch::HwSwitchStats hwStats);
+  // Applies a syncHwStatsDelta message to the stats of the switch. False
+  // if it was dropped, see HwSwitchStatsDeltaDecoder::apply.
+  bool updateHwSwitchStats(
+      uint16_t switchIndex,
+      HwSwitchStatsDeltaDecoder& decoder,
+      multiswitch::HwSwitchStatsDelta delta);
 
   // Returns a copy of hwswitch exported stats.
   // To be used only in tests as copy is expensive.
@@ -1248,6 +1288,12 @@ class SwSwitch : public HwSwitchCallback {
    */
   std::unique_ptr<ThreadHeartbeatWatchdog> heartbeatWatchdog_;
 
+  /*
+   * Samples stacks of the above threads when their heartbeats stall.
+   * Only created if FLAGS_enable_thread_stall_profiler is set.
+   */
+  std::unique_ptr<ThreadStallProfiler> threadStallProfiler_;
+
   /*
    * A callback for listening to neighbors coming and going.
    */
@@ -1309,8 +1355,12 @@ class SwSwitch : public HwSwitchCallback {
   std::unique_ptr<SwitchIdScopeResolver> scopeResolver_;
   std::unique_ptr<SwitchStatsObserver> switchStatsObserver_;
   std::unique_ptr<ResourceAccountant> resourceAccountant_;
+  std::unique_ptr<PortStatsHistory> portStatsHistory_;
 
   folly::Synchronized<ConfigAppliedInfo> configAppliedInfo_;
+  // Section fingerprints of the last successfully applied config, used to
+  // skip unchanged config sections on the next config application.
+  folly::Synchronized<AppliedConfigSections> appliedConfigSections_;
   std::optional<std::chrono::time_point<std::chrono::steady_clock>>
       publishedStatsToFsdbAt_;
   std::unique_ptr<MultiSwitchPacketStreamMap> packetStreamMap_;
@@ -1326,6 +1376,8 @@ class SwSwitch : public HwSwitchCallback {
   // rx handling path.
   folly::ConcurrentHashMap<std::pair<RouterID, folly::IPAddress>, InterfaceID>
       addrToLocalIntf_;
+  // FIB copy for route lookups in rx handling path.
+  std::unique_ptr<FibLpmSnapshot> fibLpmSnapshot_;
   folly::Synchronized<
       std::map<SwitchID, switch_reachability::SwitchReachability>>
       hwSwitchReachability_;
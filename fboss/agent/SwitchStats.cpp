@@ -672,6 +672,26 @@ SwitchStats::HwAgentStreamConnectionStatus::HwAgentStreamConnectionStatus(
               ".",
               "rx_bad_pkt_received"),
           SUM,
+          RATE)),
+      statsDeltaApplyCpuUsec_(TLTimeseries(
+          map,
+          folly::to<std::string>(
+              kCounterPrefix,
+              "switch.",
+              switchIndex,
+              ".",
+              "stats_delta_apply_cpu_us"),
+          SUM,
+          RATE)),
+      statsDeltaSnapshotsReceived_(TLTimeseries(
+          map,
+          folly::to<std::string>(
+              kCounterPrefix,
+              "switch.",
+              switchIndex,
+              ".",
+              "stats_delta_snapshot_received"),
+          SUM,
           RATE)) {}
 
 void SwitchStats::setFabricOverdrainPct(
@@ -571,6 +571,14 @@ class SwitchStats : public boost::noncopyable {
     thriftStreamConnectionStatus_[switchIndex].statsEventReceived();
   }
 
+  void hwAgentStatsDeltaApplied(
+      int switchIndex,
+      int64_t cpuUsec,
+      bool fullSnapshot) {
+    thriftStreamConnectionStatus_[switchIndex].statsDeltaApplied(
+        cpuUsec, fullSnapshot);
+  }
+
   void hwAgentLinkStatusReceived(int switchIndex) {
     thriftStreamConnectionStatus_[switchIndex].linkEventReceived();
   }
@@ -582,6 +590,10 @@ class SwitchStats : public boost::noncopyable {
   void hwAgentRxPktReceived(int switchIndex) {
     thriftStreamConnectionStatus_[switchIndex].rxPktEventReceived();
   }
+  int64_t getHwAgentRxPktReceivedCount(int switchIndex) const {
+    return thriftStreamConnectionStatus_[switchIndex]
+        .getRxPktEventReceivedCount();
+  }
 
   void hwAgentTxPktSent(int switchIndex) {
     thriftStreamConnectionStatus_[switchIndex].txPktEventSent();
@@ -706,6 +718,12 @@ class SwitchStats : public boost::noncopyable {
     void rxBadPktReceived() {
       rxBadPktReceived_.addValue(1);
     }
+    void statsDeltaApplied(int64_t cpuUsec, bool fullSnapshot) {
+      statsDeltaApplyCpuUsec_.addValue(cpuUsec);
+      if (fullSnapshot) {
+        statsDeltaSnapshotsReceived_.addValue(1);
+      }
+    }
     int64_t getStatsEventSinkDisconnectCount() const {
       return getCumulativeValue(statsEventSinkDisconnects_);
     }
@@ -768,6 +786,9 @@ class SwitchStats : public boost::noncopyable {
     TLTimeseries txPktEventsSent_;
     TLTimeseries switchReachabilityChangeEventsReceived_;
     TLTimeseries rxBadPktReceived_;
+    // CPU spent rebuilding HwSwitchStats from syncHwStatsDelta messages
+    TLTimeseries statsDeltaApplyCpuUsec_;
+    TLTimeseries statsDeltaSnapshotsReceived_;
   };
 
   const int numSwitches_;
@@ -23,7 +23,9 @@
 #include "fboss/agent/LinkAggregationManager.h"
 #include "fboss/agent/LldpManager.h"
 #include "fboss/agent/NeighborUpdater.h"
+#include "fboss/agent/PortStatsHistory.h"
 #include "fboss/agent/RouteUpdateLogger.h"
+#include "fboss/agent/RouteUpdateTrace.h"
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/SwSwitchRouteUpdateWrapper.h"
 #include "fboss/agent/SwitchIdScopeResolver.h"
@@ -98,6 +100,7 @@ using std::string;
 using std::unique_ptr;
 using std::vector;
 using std::chrono::duration_cast;
+using std::chrono::milliseconds;
 using std::chrono::seconds;
 using std::chrono::steady_clock;
 
@@ -895,6 +898,13 @@ void ThriftHandler::updateUnicastRoutesImpl(
     const std::unique_ptr<std::vector<UnicastRoute>>& routes,
     const std::string& updType,
     bool sync) {
+  auto trace = RouteUpdateTrace::start(updType);
+  RouteUpdateTrace::Scope traceScope(trace);
+  SCOPE_EXIT {
+    if (trace) {
+      trace->finish();
+    }
+  };
   auto updater = sw_->getRouteUpdater();
   auto routerID = RouterID(vrf);
   auto clientID = ClientID(client);
@@ -3226,6 +3236,25 @@ void ThriftHandler::getHwPortStats(
   sw_->getAllHwPortStats(hwPortStats);
 }
 
+void ThriftHandler::getPortStatsHistory(
+    std::vector<PortCounterHistory>& history,
+    std::unique_ptr<std::vector<std::string>> ports,
+    std::unique_ptr<std::vector<std::string>> counters,
+    int64_t beginTime,
+    int64_t endTime) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  auto portStatsHistory = sw_->getPortStatsHistory();
+  if (!portStatsHistory) {
+    throw FbossError("Port stats history is disabled");
+  }
+  history = portStatsHistory->getHistory(
+      std::set<std::string>(ports->begin(), ports->end()),
+      std::set<std::string>(counters->begin(), counters->end()),
+      beginTime,
+      endTime);
+}
+
 void ThriftHandler::getFabricReachabilityStats(
     FabricReachabilityStats& fabricReachabilityStats) {
   auto log = LOG_THRIFT_CALL(DBG1);
@@ -3301,4 +3330,23 @@ void ThriftHandler::getSwitchIdToSwitchInfo(
   }
 }
 
+void ThriftHandler::getThreadStallSamples(
+    std::vector<ThreadStallSample>& samples) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  auto profiler = sw_->getThreadStallProfiler();
+  if (!profiler) {
+    return;
+  }
+  for (const auto& sample : profiler->getSamples()) {
+    ThreadStallSample thriftSample;
+    thriftSample.threadName() = sample.threadName;
+    thriftSample.timestampMsecs() =
+        duration_cast<milliseconds>(sample.timestamp.time_since_epoch())
+            .count();
+    thriftSample.lagMsecs() = sample.lag.count();
+    thriftSample.frames() = sample.frames;
+    samples.push_back(std::move(thriftSample));
+  }
+}
+
 } // namespace facebook::fboss
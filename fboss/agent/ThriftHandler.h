@@ -297,6 +297,12 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
   void getCpuPortStats(CpuPortStats& hwCpuPortStats) override;
   void getAllCpuPortStats(std::map<int, CpuPortStats>& hwCpuPortStats) override;
   void getHwPortStats(std::map<std::string, HwPortStats>& hwPortStats) override;
+  void getPortStatsHistory(
+      std::vector<PortCounterHistory>& history,
+      std::unique_ptr<std::vector<std::string>> ports,
+      std::unique_ptr<std::vector<std::string>> counters,
+      int64_t beginTime,
+      int64_t endTime) override;
   void getFabricReachabilityStats(
       FabricReachabilityStats& fabricReachabilityStats) override;
   void getAllEcmpDetails(std::vector<EcmpDetails>& ecmpDetails) override;
@@ -484,6 +490,8 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
   void getSwitchIdToSwitchInfo(
       std::map<int64_t, cfg::SwitchInfo>& switchIdToSwitchInfo) override;
 
+  void getThreadStallSamples(std::vector<ThreadStallSample>& samples) override;
+
   /*
    * A pointer to the SwSwitch.  We don't own this.
    * It's the main program's responsibility to ensure that the SwSwitch exists
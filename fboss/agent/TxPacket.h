@@ -11,6 +11,7 @@
 
 #include <folly/MacAddress.h>
 #include "fboss/agent/Packet.h"
+#include "fboss/agent/TxPacketBufferPool.h"
 #include "fboss/agent/types.h"
 
 namespace facebook::fboss {
@@ -70,19 +71,38 @@ class TxPacket : public Packet {
 
   TxPacket() {}
 
+  ~TxPacket() override {
+    if (pooled_) {
+      TxPacketBufferPool::release(std::move(buf_));
+    }
+  }
+
   static std::unique_ptr<TxPacket> allocateTxPacket(size_t size) {
     return std::unique_ptr<TxPacket>(new TxPacket(size));
   }
 
+ protected:
+  /*
+   * Allocate the packet buffer from the TxPacketBufferPool. The buffer has
+   * TxPacketBufferPool::kHeadroom bytes of headroom for the L2 header and
+   * goes back to the pool when the packet is destroyed, unless it is larger
+   * than any size class.
+   */
+  void allocatePooledBuf(uint32_t size) {
+    buf_ = TxPacketBufferPool::allocate(size);
+    pooled_ = size <= TxPacketBufferPool::kMaxPooledSize;
+  }
+
  private:
   explicit TxPacket(size_t size) {
-    buf_ = folly::IOBuf::create(size);
-    buf_->append(size);
+    allocatePooledBuf(size);
   }
 
   // Forbidden copy constructor and assignment operator
   TxPacket(TxPacket const&) = delete;
   TxPacket& operator=(TxPacket const&) = delete;
+
+  bool pooled_{false};
 };
 
 template <typename CursorType>
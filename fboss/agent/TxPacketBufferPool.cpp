@@ -0,0 +1,136 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/TxPacketBufferPool.h"
+
+#include <fb303/ThreadCachedServiceData.h>
+#include <gflags/gflags.h>
+
+#include <array>
+#include <optional>
+#include <vector>
+
+DEFINE_int32(
+    tx_packet_pool_cache_size,
+    64,
+    "Number of free TX packet buffers each thread caches per size class, "
+    "0 to disable the TX packet buffer pool");
+
+using facebook::fb303::RATE;
+using facebook::fb303::SUM;
+
+namespace facebook::fboss {
+
+namespace {
+
+// Packet sizes (excluding headroom) of the pooled buffers: control packets,
+// LLDP, MTU sized packets and jumbo frames
+constexpr std::array<uint32_t, 5> kSizeClasses{{256, 512, 2048, 4096, 10240}};
+static_assert(kSizeClasses.back() == TxPacketBufferPool::kMaxPooledSize);
+
+using TLTimeseries = fb303::ThreadCachedServiceData::TLTimeseries;
+
+struct ThreadCache {
+  ThreadCache()
+      : hitsCounter(
+            fb303::ThreadCachedServiceData::get()->getThreadStats(),
+            "tx_pkt_pool.hits",
+            SUM,
+            RATE),
+        missesCounter(
+            fb303::ThreadCachedServiceData::get()->getThreadStats(),
+            "tx_pkt_pool.misses",
+            SUM,
+            RATE) {}
+
+  std::array<std::vector<std::unique_ptr<folly::IOBuf>>, kSizeClasses.size()>
+      freeBufs;
+  TxPacketBufferPool::Stats stats;
+  TLTimeseries hitsCounter;
+  TLTimeseries missesCounter;
+};
+
+ThreadCache& threadCache() {
+  static thread_local ThreadCache cache;
+  return cache;
+}
+
+// Smallest size class a packet of size fits in
+std::optional<size_t> allocSizeClass(uint32_t size) {
+  for (size_t i = 0; i < kSizeClasses.size(); ++i) {
+    if (size <= kSizeClasses[i]) {
+      return i;
+    }
+  }
+  return std::nullopt;
+}
+
+// Largest size class a buffer of capacity can hold. Capacity may have
+// been rounded up by the allocator.
+std::optional<size_t> releaseSizeClass(std::size_t capacity) {
+  std::optional<size_t> sizeClass;
+  for (size_t i = 0; i < kSizeClasses.size(); ++i) {
+    if (kSizeClasses[i] + TxPacketBufferPool::kHeadroom > capacity) {
+      break;
+    }
+    sizeClass = i;
+  }
+  return sizeClass;
+}
+
+} // namespace
+
+std::unique_ptr<folly::IOBuf> TxPacketBufferPool::allocate(uint32_t size) {
+  auto& cache = threadCache();
+  auto sizeClass = allocSizeClass(size);
+  std::unique_ptr<folly::IOBuf> buf;
+  if (sizeClass && !cache.freeBufs[*sizeClass].empty()) {
+    buf = std::move(cache.freeBufs[*sizeClass].back());
+    cache.freeBufs[*sizeClass].pop_back();
+    buf->clear();
+    ++cache.stats.hits;
+    cache.hitsCounter.addValue(1);
+  } else {
+    buf = folly::IOBuf::createCombined(
+        (sizeClass ? kSizeClasses[*sizeClass] : size) + kHeadroom);
+    ++cache.stats.misses;
+    cache.missesCounter.addValue(1);
+  }
+  buf->advance(kHeadroom);
+  buf->append(size);
+  return buf;
+}
+
+void TxPacketBufferPool::release(std::unique_ptr<folly::IOBuf> buf) {
+  // Packets extracted or cloned (e.g. by packet capture) keep their buffer
+  if (!buf || buf->isChained() || buf->isShared() ||
+      FLAGS_tx_packet_pool_cache_size <= 0) {
+    return;
+  }
+  auto sizeClass = releaseSizeClass(buf->capacity());
+  if (!sizeClass) {
+    return;
+  }
+  auto& freeBufs = threadCache().freeBufs[*sizeClass];
+  if (freeBufs.size() < static_cast<size_t>(FLAGS_tx_packet_pool_cache_size)) {
+    freeBufs.push_back(std::move(buf));
+  }
+}
+
+TxPacketBufferPool::Stats TxPacketBufferPool::getThreadStats() {
+  return threadCache().stats;
+}
+
+void TxPacketBufferPool::clearThreadCache() {
+  for (auto& freeBufs : threadCache().freeBufs) {
+    freeBufs.clear();
+  }
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,75 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/io/IOBuf.h>
+
+#include <cstdint>
+#include <memory>
+
+namespace facebook::fboss {
+
+/*
+ * Pool of TX packet buffers, so that the protocol packets the agent sends
+ * (LLDP, LACP, ARP/NDP, RA, DHCP relay etc.) don't malloc and free a
+ * buffer each.
+ *
+ * Buffers come in a few size classes and are cached per thread, up to
+ * --tx_packet_pool_cache_size buffers per class. A buffer is a single
+ * combined IOBuf, so allocating from a warm cache does no allocation at
+ * all. Every buffer has kHeadroom bytes reserved in front of the data for
+ * prepending the L2 header. Pool hits and misses are exported as
+ * tx_pkt_pool.hits and tx_pkt_pool.misses.
+ *
+ * Buffers go back to the cache of the thread that releases them, i.e. the
+ * one destroying the TxPacket, not the one that allocated them. Senders
+ * whose packets are destroyed on another thread, e.g. on async TX
+ * completion, keep missing while the other thread's cache fills up. In
+ * multi switch mode, packets sent over the thrift stream to the HwAgent
+ * have their buffer extracted and never return to the pool at all.
+ */
+class TxPacketBufferPool {
+ public:
+  // Room for a VLAN tagged ethernet header plus an extra tag
+  static constexpr uint32_t kHeadroom = 32;
+  // Size of the largest size class, larger buffers are not pooled
+  static constexpr uint32_t kMaxPooledSize = 10240;
+
+  struct Stats {
+    uint64_t hits{0};
+    uint64_t misses{0};
+  };
+
+  /*
+   * Returns a buffer of length size with at least kHeadroom bytes of
+   * headroom. Sizes above the largest size class are not pooled.
+   */
+  static std::unique_ptr<folly::IOBuf> allocate(uint32_t size);
+
+  /*
+   * Returns a buffer to the pool of the calling thread. Buffers that are
+   * shared, chained or in excess of the cache size are freed instead. Only
+   * buffers allocated with a size up to kMaxPooledSize may be released: a
+   * larger buffer can't be told apart from one of the largest size class.
+   */
+  static void release(std::unique_ptr<folly::IOBuf> buf);
+
+  /*
+   * Hits and misses of the calling thread.
+   */
+  static Stats getThreadStats();
+
+  /*
+   * Frees the buffers cached by the calling thread.
+   */
+  static void clearThreadCache();
+};
+
+} // namespace facebook::fboss
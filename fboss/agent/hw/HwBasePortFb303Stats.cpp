@@ -10,12 +10,15 @@
 
 #include "fboss/agent/hw/HwBasePortFb303Stats.h"
 
+#include "fboss/agent/FbossError.h"
 #include "fboss/agent/hw/CounterUtils.h"
 #include "fboss/agent/hw/StatsConstants.h"
 
 #include <fb303/ServiceData.h>
 #include <folly/logging/xlog.h>
 
+#include <algorithm>
+
 #include "common/stats/DynamicStats.h"
 
 namespace {
@@ -114,6 +117,7 @@ void HwBasePortFb303Stats::reinitStats(std::optional<std::string> oldPortName) {
       portCounters_.reinitStat(newStatName, oldStatName);
     }
   }
+  resolveStatHandles();
 }
 
 /*
@@ -130,6 +134,7 @@ void HwBasePortFb303Stats::reinitMacsecStats(
   reinitStats(kOutMacsecPortMonotonicCounterStatKeys());
 
   macsecStatsInited_ = true;
+  resolveStatHandles();
 }
 /*
  * Reinit port stat
@@ -169,6 +174,7 @@ void HwBasePortFb303Stats::queueChanged(
   for (auto statKey : kQueueMonotonicCounterStatKeys()) {
     reinitStat(statKey, queueId, oldQueueName);
   }
+  resolveStatHandles();
 }
 
 void HwBasePortFb303Stats::queueRemoved(int queueId) {
@@ -177,6 +183,7 @@ void HwBasePortFb303Stats::queueRemoved(int queueId) {
         statName(statKey, portName_, queueId, queueId2Name_[queueId]));
   }
   queueId2Name_.erase(queueId);
+  resolveStatHandles();
 }
 
 void HwBasePortFb303Stats::pfcPriorityChanged(
@@ -211,36 +218,131 @@ void HwBasePortFb303Stats::pfcPriorityChanged(
       portCounters_.removeStat(statName(statKey, portName_));
     }
   }
+  resolveStatHandles();
+}
+
+std::array<const std::vector<folly::StringPiece>*, 4>
+HwBasePortFb303Stats::portStatKeys() const {
+  return {
+      &kPortMonotonicCounterStatKeys(),
+      &kInMacsecPortMonotonicCounterStatKeys(),
+      &kOutMacsecPortMonotonicCounterStatKeys(),
+      &kPfcMonotonicCounterStatKeys()};
+}
+
+void HwBasePortFb303Stats::resolveStatHandles() {
+  portStatHandles_.clear();
+  for (const auto* statKeys : portStatKeys()) {
+    for (auto statKey : *statKeys) {
+      portStatHandles_.push_back(
+          portCounters_.getHandleIf(statName(statKey, portName_)));
+    }
+  }
+
+  const auto& queueStatKeys = kQueueMonotonicCounterStatKeys();
+  int maxQueueId = -1;
+  for (const auto& queueIdAndName : queueId2Name_) {
+    maxQueueId = std::max(maxQueueId, queueIdAndName.first);
+  }
+  queueStatHandles_.assign(
+      (maxQueueId + 1) * queueStatKeys.size(), std::nullopt);
+  for (const auto& [queueId, queueName] : queueId2Name_) {
+    for (size_t i = 0; i < queueStatKeys.size(); ++i) {
+      queueStatHandles_[queueId * queueStatKeys.size() + i] =
+          portCounters_.getHandleIf(
+              statName(queueStatKeys[i], portName_, queueId, queueName));
+    }
+  }
+
+  const auto& pfcStatKeys = kPfcMonotonicCounterStatKeys();
+  pfcStatHandles_.clear();
+  for (auto priority : enabledPfcPriorities_) {
+    auto offset = static_cast<size_t>(priority) * pfcStatKeys.size();
+    if (pfcStatHandles_.size() < offset + pfcStatKeys.size()) {
+      pfcStatHandles_.resize(offset + pfcStatKeys.size());
+    }
+    for (size_t i = 0; i < pfcStatKeys.size(); ++i) {
+      pfcStatHandles_[offset + i] = portCounters_.getHandleIf(
+          statName(pfcStatKeys[i], portName_, priority));
+    }
+  }
+}
+
+size_t HwBasePortFb303Stats::portStatKeyIndex(
+    folly::StringPiece statKey) const {
+  size_t offset = 0;
+  for (const auto* statKeys : portStatKeys()) {
+    auto keyItr = std::find(statKeys->begin(), statKeys->end(), statKey);
+    if (keyItr != statKeys->end()) {
+      return offset + std::distance(statKeys->begin(), keyItr);
+    }
+    offset += statKeys->size();
+  }
+  throw FbossError("Unknown port stat ", statKey, " for port ", portName_);
+}
+
+size_t HwBasePortFb303Stats::queueStatKeyIndex(
+    folly::StringPiece statKey) const {
+  const auto& queueStatKeys = kQueueMonotonicCounterStatKeys();
+  for (size_t i = 0; i < queueStatKeys.size(); ++i) {
+    if (queueStatKeys[i] == statKey) {
+      return i;
+    }
+  }
+  throw FbossError("Unknown queue stat ", statKey, " for port ", portName_);
+}
+
+size_t HwBasePortFb303Stats::pfcStatKeyIndex(folly::StringPiece statKey) const {
+  const auto& pfcStatKeys = kPfcMonotonicCounterStatKeys();
+  auto keyItr = std::find(pfcStatKeys.begin(), pfcStatKeys.end(), statKey);
+  if (keyItr == pfcStatKeys.end()) {
+    throw FbossError("Unknown PFC stat ", statKey, " for port ", portName_);
+  }
+  return std::distance(pfcStatKeys.begin(), keyItr);
 }
 
 void HwBasePortFb303Stats::updateLeakyBucketFlapCnt(int cnt) {
   auto now = duration_cast<std::chrono::seconds>(
       std::chrono::system_clock::now().time_since_epoch());
-  updateStat(now, kLeakyBucketFlapCnt(), cnt);
+  updatePortStat(now, portStatKeyIndex(kLeakyBucketFlapCnt()), cnt);
 }
 
-void HwBasePortFb303Stats::updateStat(
+void HwBasePortFb303Stats::updatePortStat(
     const std::chrono::seconds& now,
-    folly::StringPiece statKey,
-    int queueId,
+    size_t statKeyIndex,
     int64_t val) {
-  portCounters_.updateStat(
-      now, statName(statKey, portName_, queueId, queueId2Name_[queueId]), val);
+  CHECK_LT(statKeyIndex, portStatHandles_.size());
+  const auto& handle = portStatHandles_[statKeyIndex];
+  CHECK(handle) << "No stat " << statKeyIndex << " for " << portName_;
+  portCounters_.updateStat(now, *handle, val);
 }
 
-void HwBasePortFb303Stats::updateStat(
+void HwBasePortFb303Stats::updateQueueStat(
     const std::chrono::seconds& now,
-    folly::StringPiece statKey,
+    size_t statKeyIndex,
+    int queueId,
     int64_t val) {
-  portCounters_.updateStat(now, statName(statKey, portName_), val);
+  auto index =
+      queueId * kQueueMonotonicCounterStatKeys().size() + statKeyIndex;
+  CHECK_LT(index, queueStatHandles_.size());
+  const auto& handle = queueStatHandles_[index];
+  CHECK(handle) << "No stat for queue " << queueId << " of " << portName_;
+  portCounters_.updateStat(now, *handle, val);
 }
 
-void HwBasePortFb303Stats::updateStat(
+void HwBasePortFb303Stats::updatePfcStat(
     const std::chrono::seconds& now,
-    folly::StringPiece statKey,
+    size_t statKeyIndex,
     PfcPriority priority,
     int64_t val) {
-  portCounters_.updateStat(now, statName(statKey, portName_, priority), val);
+  auto index = static_cast<size_t>(priority) *
+          kPfcMonotonicCounterStatKeys().size() +
+      statKeyIndex;
+  CHECK_LT(index, pfcStatHandles_.size());
+  const auto& handle = pfcStatHandles_[index];
+  CHECK(handle) << "No PFC stat " << statKeyIndex << " for priority "
+                << static_cast<int>(priority) << " of " << portName_;
+  portCounters_.updateStat(now, *handle, val);
 }
 
 void HwBasePortFb303Stats::updateQueueWatermarkStats(
@@ -16,8 +16,10 @@
 
 #include "folly/container/F14Map.h"
 
+#include <array>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace facebook::fboss {
 
@@ -94,36 +96,47 @@ class HwBasePortFb303Stats {
  protected:
   void reinitStats(std::optional<std::string> oldPortName);
   void reinitMacsecStats(std::optional<std::string> oldPortName);
+
+  void updateQueueWatermarkStats(
+      const std::map<int16_t, int64_t>& queueWatermarkBytes) const;
+
+  void updateEgressGvoqWatermarkStats(
+      const std::map<int16_t, int64_t>& gvoqWatermarks) const;
+
   /*
-   * update port stat
+   * Stats are updated by stat key index rather than by name. Stat key
+   * indices never change, so callers look them up once and then each update
+   * is a single array access into the handles resolved by reinitStats().
    */
-  void updateStat(
+
+  /*
+   * Index of statKey among the port stats, i.e. the port, macsec and
+   * aggregated PFC stat keys
+   */
+  size_t portStatKeyIndex(folly::StringPiece statKey) const;
+  void updatePortStat(
       const std::chrono::seconds& now,
-      folly::StringPiece statKey,
+      size_t statKeyIndex,
       int64_t val);
   /*
-   * update port queue stat
+   * Index of statKey in kQueueMonotonicCounterStatKeys()
    */
-  void updateStat(
+  size_t queueStatKeyIndex(folly::StringPiece statKey) const;
+  void updateQueueStat(
       const std::chrono::seconds& now,
-      folly::StringPiece statKey,
+      size_t statKeyIndex,
       int queueId,
       int64_t val);
   /*
-   * update port PFC stat
+   * Index of statKey in kPfcMonotonicCounterStatKeys()
    */
-  void updateStat(
+  size_t pfcStatKeyIndex(folly::StringPiece statKey) const;
+  void updatePfcStat(
       const std::chrono::seconds& now,
-      folly::StringPiece statKey,
+      size_t statKeyIndex,
       PfcPriority priority,
       int64_t val);
 
-  void updateQueueWatermarkStats(
-      const std::map<int16_t, int64_t>& queueWatermarkBytes) const;
-
-  void updateEgressGvoqWatermarkStats(
-      const std::map<int16_t, int64_t>& gvoqWatermarks) const;
-
   bool macsecStatsInited() const {
     return macsecStatsInited_;
   }
@@ -150,11 +163,29 @@ class HwBasePortFb303Stats {
       int queueId,
       std::optional<std::string> oldQueueName);
 
+  /*
+   * Resolve stat names to HwFb303Stats handles, so that per stats cycle
+   * updates don't need to build stat names. Must be called whenever the set
+   * of stats or their names change.
+   */
+  void resolveStatHandles();
+  /*
+   * Port stat keys, in port stat key index order
+   */
+  std::array<const std::vector<folly::StringPiece>*, 4> portStatKeys() const;
+
   std::string portName_;
   HwFb303Stats portCounters_;
   QueueId2Name queueId2Name_;
   bool macsecStatsInited_{false};
   std::vector<PfcPriority> enabledPfcPriorities_{};
+
+  // Indexed by port stat key index
+  std::vector<std::optional<HwFb303Stats::Handle>> portStatHandles_;
+  // Indexed by queueId * numQueueStatKeys + statKeyIndex
+  std::vector<std::optional<HwFb303Stats::Handle>> queueStatHandles_;
+  // Indexed by priority * numPfcStatKeys + statKeyIndex
+  std::vector<std::optional<HwFb303Stats::Handle>> pfcStatHandles_;
 };
 
 } // namespace facebook::fboss
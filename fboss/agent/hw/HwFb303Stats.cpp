@@ -17,15 +17,35 @@
 namespace facebook::fboss {
 
 HwFb303Stats::~HwFb303Stats() {
-  for (const auto& statNameAndStat : counters_) {
-    utility::deleteCounter(statNameAndStat.second.fb303Counter.getName());
+  for (const auto& counter : counters_) {
+    if (counter) {
+      utility::deleteCounter(counter->fb303Counter.getName());
+    }
+  }
+}
+
+HwFb303Stats::Handle HwFb303Stats::allocateHandle(HwFb303Counter counter) {
+  if (freeHandles_.empty()) {
+    counters_.emplace_back(std::move(counter));
+    return counters_.size() - 1;
   }
+  auto handle = freeHandles_.back();
+  freeHandles_.pop_back();
+  counters_[handle].emplace(std::move(counter));
+  return handle;
+}
+
+std::optional<HwFb303Stats::Handle> HwFb303Stats::getHandleIf(
+    const std::string& statName) const {
+  auto hitr = handles_.find(statName);
+  return hitr != handles_.end() ? std::optional<Handle>(hitr->second)
+                                : std::nullopt;
 }
 
 const stats::MonotonicCounter* HwFb303Stats::getCounterIf(
     const std::string& statName) const {
-  auto pcitr = counters_.find(statName);
-  return pcitr != counters_.end() ? &pcitr->second.fb303Counter : nullptr;
+  auto handle = getHandleIf(statName);
+  return handle ? &counters_[*handle]->fb303Counter : nullptr;
 }
 
 stats::MonotonicCounter* HwFb303Stats::getCounterIf(
@@ -57,42 +77,54 @@ void HwFb303Stats::reinitStat(
     if (oldStatName == statName) {
       return;
     }
-    auto stat = getCounterIf(*oldStatName);
+    auto hitr = handles_.find(*oldStatName);
+    CHECK(hitr != handles_.end());
+    auto handle = hitr->second;
+    auto& stat = counters_[handle]->fb303Counter;
     stats::MonotonicCounter newStat{
         getMonotonicCounterName(statName), fb303::SUM, fb303::RATE};
-    stat->swap(newStat);
+    stat.swap(newStat);
     utility::deleteCounter(newStat.getName());
-    counters_.insert(
-        std::make_pair(statName, HwFb303Counter(std::move(*stat))));
-    counters_.erase(*oldStatName);
-  } else {
-    counters_.emplace(
+    handles_.erase(hitr);
+    handles_.emplace(statName, handle);
+  } else if (!handles_.contains(statName)) {
+    handles_.emplace(
         statName,
-        HwFb303Counter(stats::MonotonicCounter(
-            getMonotonicCounterName(statName), fb303::SUM, fb303::RATE)));
+        allocateHandle(HwFb303Counter(stats::MonotonicCounter(
+            getMonotonicCounterName(statName), fb303::SUM, fb303::RATE))));
   }
 }
 
 void HwFb303Stats::removeStat(const std::string& statName) {
-  auto stat = getCounterIf(statName);
-  if (stat == nullptr) {
+  auto hitr = handles_.find(statName);
+  if (hitr == handles_.end()) {
     XLOG(ERR) << "Counter with " << statName << " missing";
     return;
   }
-  utility::deleteCounter(getMonotonicCounterName(stat->getName()));
-  counters_.erase(stat->getName());
+  auto handle = hitr->second;
+  utility::deleteCounter(counters_[handle]->fb303Counter.getName());
+  counters_[handle].reset();
+  freeHandles_.push_back(handle);
+  handles_.erase(hitr);
 }
 
 void HwFb303Stats::updateStat(
     const std::chrono::seconds& now,
     const std::string& statName,
     int64_t val) {
-  auto stat = getCounterIf(statName);
-  CHECK(stat);
-  stat->updateValue(now, val);
-  auto pcitr = counters_.find(statName);
-  CHECK(pcitr != counters_.end());
-  pcitr->second.cumulativeValue = val;
+  auto handle = getHandleIf(statName);
+  CHECK(handle);
+  updateStat(now, *handle, val);
+}
+
+void HwFb303Stats::updateStat(
+    const std::chrono::seconds& now,
+    Handle handle,
+    int64_t val) {
+  auto& counter = counters_[handle];
+  DCHECK(counter);
+  counter->fb303Counter.updateValue(now, val);
+  counter->cumulativeValue = val;
 }
 
 const std::string HwFb303Stats::getMonotonicCounterName(
@@ -102,8 +134,8 @@ const std::string HwFb303Stats::getMonotonicCounterName(
 }
 
 uint64_t HwFb303Stats::getCumulativeValueIf(const std::string& statName) const {
-  auto pcitr = counters_.find(statName);
-  return pcitr != counters_.end() ? pcitr->second.cumulativeValue : 0;
+  auto handle = getHandleIf(statName);
+  return handle ? counters_[*handle]->cumulativeValue : 0;
 }
 
 } // namespace facebook::fboss
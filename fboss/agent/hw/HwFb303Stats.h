@@ -15,6 +15,7 @@
 
 #include <optional>
 #include <string>
+#include <vector>
 #include "fboss/agent/FbossError.h"
 #include "folly/container/F14Map.h"
 
@@ -29,6 +30,14 @@ struct HwFb303Counter {
 
 class HwFb303Stats {
  public:
+  /*
+   * Stable index of a stat, valid until the stat is removed. Reiniting a stat
+   * under a new name keeps its handle, so callers updating many stats every
+   * stats cycle can resolve names to handles once and skip building names and
+   * looking them up on every update.
+   */
+  using Handle = size_t;
+
   explicit HwFb303Stats(std::optional<std::string> multiSwitchStatsPrefix)
       : multiSwitchStatsPrefix_(multiSwitchStatsPrefix) {}
   ~HwFb303Stats();
@@ -47,6 +56,8 @@ class HwFb303Stats {
       const std::chrono::seconds& now,
       const std::string& statName,
       int64_t val);
+  void updateStat(const std::chrono::seconds& now, Handle handle, int64_t val);
+  std::optional<Handle> getHandleIf(const std::string& statName) const;
   void removeStat(const std::string& statName);
   const std::string getMonotonicCounterName(const std::string& statName) const;
   uint64_t getCumulativeValueIf(const std::string& statName) const;
@@ -59,7 +70,12 @@ class HwFb303Stats {
   const facebook::stats::MonotonicCounter* getCounterIf(
       const std::string& statName) const;
 
-  folly::F14FastMap<std::string, HwFb303Counter> counters_;
+  Handle allocateHandle(HwFb303Counter counter);
+
+  folly::F14FastMap<std::string, Handle> handles_;
+  // Indexed by handle, removed stats leave a free slot
+  std::vector<std::optional<HwFb303Counter>> counters_;
+  std::vector<Handle> freeHandles_;
   std::optional<std::string> multiSwitchStatsPrefix_;
 };
 } // namespace facebook::fboss
@@ -130,86 +130,150 @@ void HwPortFb303Stats::updateStats(
     const HwPortStats& curPortStats,
     const std::chrono::seconds& retrievedAt) {
   timeRetrieved_ = retrievedAt;
-  updateStat(timeRetrieved_, kInBytes(), *curPortStats.inBytes_());
-  updateStat(timeRetrieved_, kInUnicastPkts(), *curPortStats.inUnicastPkts_());
-  updateStat(
-      timeRetrieved_, kInMulticastPkts(), *curPortStats.inMulticastPkts_());
-  updateStat(
-      timeRetrieved_, kInBroadcastPkts(), *curPortStats.inBroadcastPkts_());
-  updateStat(timeRetrieved_, kInDiscardsRaw(), *curPortStats.inDiscardsRaw_());
-  updateStat(timeRetrieved_, kInDiscards(), *curPortStats.inDiscards_());
-  updateStat(timeRetrieved_, kInErrors(), *curPortStats.inErrors_());
-  updateStat(timeRetrieved_, kInPause(), *curPortStats.inPause_());
-  updateStat(
-      timeRetrieved_, kInIpv4HdrErrors(), *curPortStats.inIpv4HdrErrors_());
-  updateStat(
-      timeRetrieved_, kInIpv6HdrErrors(), *curPortStats.inIpv6HdrErrors_());
-  updateStat(
-      timeRetrieved_, kInDstNullDiscards(), *curPortStats.inDstNullDiscards_());
+  // Update stats by handle rather than by name, stat key indices are looked
+  // up on the first update only
+  static const auto kInBytesIdx = portStatKeyIndex(kInBytes());
+  static const auto kInUnicastPktsIdx = portStatKeyIndex(kInUnicastPkts());
+  static const auto kInMulticastPktsIdx =
+      portStatKeyIndex(kInMulticastPkts());
+  static const auto kInBroadcastPktsIdx =
+      portStatKeyIndex(kInBroadcastPkts());
+  static const auto kInDiscardsRawIdx = portStatKeyIndex(kInDiscardsRaw());
+  static const auto kInDiscardsIdx = portStatKeyIndex(kInDiscards());
+  static const auto kInErrorsIdx = portStatKeyIndex(kInErrors());
+  static const auto kInPauseIdx = portStatKeyIndex(kInPause());
+  static const auto kInIpv4HdrErrorsIdx =
+      portStatKeyIndex(kInIpv4HdrErrors());
+  static const auto kInIpv6HdrErrorsIdx =
+      portStatKeyIndex(kInIpv6HdrErrors());
+  static const auto kInDstNullDiscardsIdx =
+      portStatKeyIndex(kInDstNullDiscards());
+  static const auto kOutBytesIdx = portStatKeyIndex(kOutBytes());
+  static const auto kOutUnicastPktsIdx = portStatKeyIndex(kOutUnicastPkts());
+  static const auto kOutMulticastPktsIdx =
+      portStatKeyIndex(kOutMulticastPkts());
+  static const auto kOutBroadcastPktsIdx =
+      portStatKeyIndex(kOutBroadcastPkts());
+  static const auto kOutDiscardsIdx = portStatKeyIndex(kOutDiscards());
+  static const auto kOutErrorsIdx = portStatKeyIndex(kOutErrors());
+  static const auto kOutPauseIdx = portStatKeyIndex(kOutPause());
+  static const auto kOutCongestionDiscardsIdx =
+      portStatKeyIndex(kOutCongestionDiscards());
+  static const auto kWredDroppedPacketsIdx =
+      portStatKeyIndex(kWredDroppedPackets());
+  static const auto kOutEcnCounterIdx = portStatKeyIndex(kOutEcnCounter());
+  static const auto kFecCorrectableIdx = portStatKeyIndex(kFecCorrectable());
+  static const auto kFecUncorrectableIdx =
+      portStatKeyIndex(kFecUncorrectable());
+  static const auto kLeakyBucketFlapCntIdx =
+      portStatKeyIndex(kLeakyBucketFlapCnt());
+  static const auto kInLabelMissDiscardsIdx =
+      portStatKeyIndex(kInLabelMissDiscards());
+  static const auto kInCongestionDiscardsIdx =
+      portStatKeyIndex(kInCongestionDiscards());
+  static const auto kInAclDiscardsIdx = portStatKeyIndex(kInAclDiscards());
+  static const auto kInTrapDiscardsIdx = portStatKeyIndex(kInTrapDiscards());
+  static const auto kOutForwardingDiscardsIdx =
+      portStatKeyIndex(kOutForwardingDiscards());
+  static const auto kPqpErrorEgressDroppedPacketsIdx =
+      portStatKeyIndex(kPqpErrorEgressDroppedPackets());
+  static const auto kFabricLinkDownDroppedCellsIdx =
+      portStatKeyIndex(kFabricLinkDownDroppedCells());
+  static const auto kLinkLayerFlowControlWatermarkIdx =
+      portStatKeyIndex(kLinkLayerFlowControlWatermark());
+
+  updatePortStat(timeRetrieved_, kInBytesIdx, *curPortStats.inBytes_());
+  updatePortStat(
+      timeRetrieved_, kInUnicastPktsIdx, *curPortStats.inUnicastPkts_());
+  updatePortStat(
+      timeRetrieved_, kInMulticastPktsIdx, *curPortStats.inMulticastPkts_());
+  updatePortStat(
+      timeRetrieved_, kInBroadcastPktsIdx, *curPortStats.inBroadcastPkts_());
+  updatePortStat(
+      timeRetrieved_, kInDiscardsRawIdx, *curPortStats.inDiscardsRaw_());
+  updatePortStat(timeRetrieved_, kInDiscardsIdx, *curPortStats.inDiscards_());
+  updatePortStat(timeRetrieved_, kInErrorsIdx, *curPortStats.inErrors_());
+  updatePortStat(timeRetrieved_, kInPauseIdx, *curPortStats.inPause_());
+  updatePortStat(
+      timeRetrieved_, kInIpv4HdrErrorsIdx, *curPortStats.inIpv4HdrErrors_());
+  updatePortStat(
+      timeRetrieved_, kInIpv6HdrErrorsIdx, *curPortStats.inIpv6HdrErrors_());
+  updatePortStat(
+      timeRetrieved_,
+      kInDstNullDiscardsIdx,
+      *curPortStats.inDstNullDiscards_());
   // Egress Stats
-  updateStat(timeRetrieved_, kOutBytes(), *curPortStats.outBytes_());
-  updateStat(
-      timeRetrieved_, kOutUnicastPkts(), *curPortStats.outUnicastPkts_());
-  updateStat(
-      timeRetrieved_, kOutMulticastPkts(), *curPortStats.outMulticastPkts_());
-  updateStat(
-      timeRetrieved_, kOutBroadcastPkts(), *curPortStats.outBroadcastPkts_());
-  updateStat(timeRetrieved_, kOutDiscards(), *curPortStats.outDiscards_());
-  updateStat(timeRetrieved_, kOutErrors(), *curPortStats.outErrors_());
-  updateStat(timeRetrieved_, kOutPause(), *curPortStats.outPause_());
-  updateStat(
+  updatePortStat(timeRetrieved_, kOutBytesIdx, *curPortStats.outBytes_());
+  updatePortStat(
+      timeRetrieved_, kOutUnicastPktsIdx, *curPortStats.outUnicastPkts_());
+  updatePortStat(
       timeRetrieved_,
-      kOutCongestionDiscards(),
+      kOutMulticastPktsIdx,
+      *curPortStats.outMulticastPkts_());
+  updatePortStat(
+      timeRetrieved_,
+      kOutBroadcastPktsIdx,
+      *curPortStats.outBroadcastPkts_());
+  updatePortStat(
+      timeRetrieved_, kOutDiscardsIdx, *curPortStats.outDiscards_());
+  updatePortStat(timeRetrieved_, kOutErrorsIdx, *curPortStats.outErrors_());
+  updatePortStat(timeRetrieved_, kOutPauseIdx, *curPortStats.outPause_());
+  updatePortStat(
+      timeRetrieved_,
+      kOutCongestionDiscardsIdx,
       *curPortStats.outCongestionDiscardPkts_());
-  updateStat(
+  updatePortStat(
       timeRetrieved_,
-      kWredDroppedPackets(),
+      kWredDroppedPacketsIdx,
       *curPortStats.wredDroppedPackets_());
-  updateStat(timeRetrieved_, kOutEcnCounter(), *curPortStats.outEcnCounter_());
-  updateStat(
-      timeRetrieved_, kFecCorrectable(), *curPortStats.fecCorrectableErrors());
-  updateStat(
+  updatePortStat(
+      timeRetrieved_, kOutEcnCounterIdx, *curPortStats.outEcnCounter_());
+  updatePortStat(
       timeRetrieved_,
-      kFecUncorrectable(),
+      kFecCorrectableIdx,
+      *curPortStats.fecCorrectableErrors());
+  updatePortStat(
+      timeRetrieved_,
+      kFecUncorrectableIdx,
       *curPortStats.fecUncorrectableErrors());
   if (curPortStats.leakyBucketFlapCount_().has_value()) {
-    updateStat(
+    updatePortStat(
         timeRetrieved_,
-        kLeakyBucketFlapCnt(),
+        kLeakyBucketFlapCntIdx,
         *curPortStats.leakyBucketFlapCount_());
   }
-  updateStat(
+  updatePortStat(
       timeRetrieved_,
-      kInLabelMissDiscards(),
+      kInLabelMissDiscardsIdx,
       *curPortStats.inLabelMissDiscards_());
-  updateStat(
+  updatePortStat(
       timeRetrieved_,
-      kInCongestionDiscards(),
+      kInCongestionDiscardsIdx,
       *curPortStats.inCongestionDiscards_());
   if (curPortStats.inAclDiscards_().has_value()) {
-    updateStat(
-        timeRetrieved_, kInAclDiscards(), *curPortStats.inAclDiscards_());
+    updatePortStat(
+        timeRetrieved_, kInAclDiscardsIdx, *curPortStats.inAclDiscards_());
   }
   if (curPortStats.inTrapDiscards_().has_value()) {
-    updateStat(
-        timeRetrieved_, kInTrapDiscards(), *curPortStats.inTrapDiscards_());
+    updatePortStat(
+        timeRetrieved_, kInTrapDiscardsIdx, *curPortStats.inTrapDiscards_());
   }
   if (curPortStats.outForwardingDiscards_().has_value()) {
-    updateStat(
+    updatePortStat(
         timeRetrieved_,
-        kOutForwardingDiscards(),
+        kOutForwardingDiscardsIdx,
         *curPortStats.outForwardingDiscards_());
   }
   if (curPortStats.pqpErrorEgressDroppedPackets_().has_value()) {
-    updateStat(
+    updatePortStat(
         timeRetrieved_,
-        kPqpErrorEgressDroppedPackets(),
+        kPqpErrorEgressDroppedPacketsIdx,
         *curPortStats.pqpErrorEgressDroppedPackets_());
   }
   if (curPortStats.fabricLinkDownDroppedCells_().has_value()) {
-    updateStat(
+    updatePortStat(
         timeRetrieved_,
-        kFabricLinkDownDroppedCells(),
+        kFabricLinkDownDroppedCellsIdx,
         *curPortStats.fabricLinkDownDroppedCells_());
   }
   // Set fb303 counter stats
@@ -226,48 +290,62 @@ void HwPortFb303Stats::updateStats(
         *curPortStats.dataCellsFilterOn() ? 1 : 0);
   }
   if (curPortStats.linkLayerFlowControlWatermark_().has_value()) {
-    updateStat(
+    updatePortStat(
         timeRetrieved_,
-        kLinkLayerFlowControlWatermark(),
+        kLinkLayerFlowControlWatermarkIdx,
         *curPortStats.linkLayerFlowControlWatermark_());
   }
 
   // Update queue stats
-  auto updateQueueStat = [this](
-                             folly::StringPiece statKey,
-                             int queueId,
-                             const std::map<int16_t, int64_t>& queueStats) {
+  static const auto kQueueOutCongestionDiscardsBytesIdx =
+      queueStatKeyIndex(kOutCongestionDiscardsBytes());
+  static const auto kQueueOutCongestionDiscardsIdx =
+      queueStatKeyIndex(kOutCongestionDiscards());
+  static const auto kQueueOutBytesIdx = queueStatKeyIndex(kOutBytes());
+  static const auto kQueueOutPktsIdx = queueStatKeyIndex(kOutPkts());
+  static const auto kQueueWredDroppedPacketsIdx =
+      queueStatKeyIndex(kWredDroppedPackets());
+  static const auto kQueueOutEcnCounterIdx =
+      queueStatKeyIndex(kOutEcnCounter());
+  auto updateQueueStatIf = [this](
+                               size_t statKeyIndex,
+                               int queueId,
+                               const std::map<int16_t, int64_t>& queueStats) {
     auto qitr = queueStats.find(queueId);
     /*
      * Not all queue stats are available on all ASICs. Hence the queue stats
      * maps are sparsely populated. So skip over keys that are not found.
      */
     if (qitr != queueStats.end()) {
-      updateStat(timeRetrieved_, statKey, queueId, qitr->second);
+      updateQueueStat(timeRetrieved_, statKeyIndex, queueId, qitr->second);
     }
   };
   for (const auto& queueIdAndName : queueId2Name()) {
-    updateQueueStat(
-        kOutCongestionDiscardsBytes(),
+    updateQueueStatIf(
+        kQueueOutCongestionDiscardsBytesIdx,
         queueIdAndName.first,
         *curPortStats.queueOutDiscardBytes_());
-    updateQueueStat(
-        kOutCongestionDiscards(),
+    updateQueueStatIf(
+        kQueueOutCongestionDiscardsIdx,
         queueIdAndName.first,
         *curPortStats.queueOutDiscardPackets_());
-    updateQueueStat(
-        kOutBytes(), queueIdAndName.first, *curPortStats.queueOutBytes_());
-    updateQueueStat(
-        kOutPkts(), queueIdAndName.first, *curPortStats.queueOutPackets_());
+    updateQueueStatIf(
+        kQueueOutBytesIdx,
+        queueIdAndName.first,
+        *curPortStats.queueOutBytes_());
+    updateQueueStatIf(
+        kQueueOutPktsIdx,
+        queueIdAndName.first,
+        *curPortStats.queueOutPackets_());
     if (curPortStats.queueWredDroppedPackets_()->size()) {
-      updateQueueStat(
-          kWredDroppedPackets(),
+      updateQueueStatIf(
+          kQueueWredDroppedPacketsIdx,
           queueIdAndName.first,
           *curPortStats.queueWredDroppedPackets_());
     }
     if (curPortStats.queueEcnMarkedPackets_()->size()) {
-      updateQueueStat(
-          kOutEcnCounter(),
+      updateQueueStatIf(
+          kQueueOutEcnCounterIdx,
           queueIdAndName.first,
           *curPortStats.queueEcnMarkedPackets_());
     }
@@ -289,84 +367,130 @@ void HwPortFb303Stats::updateStats(
     if (!macsecStatsInited()) {
       reinitMacsecStats(std::nullopt);
     }
+    static const auto kInPreMacsecDropPktsIdx =
+        portStatKeyIndex(kInPreMacsecDropPkts());
+    static const auto kOutPreMacsecDropPktsIdx =
+        portStatKeyIndex(kOutPreMacsecDropPkts());
+    static const auto kInMacsecDataPktsIdx =
+        portStatKeyIndex(kInMacsecDataPkts());
+    static const auto kOutMacsecDataPktsIdx =
+        portStatKeyIndex(kOutMacsecDataPkts());
+    static const auto kInMacsecControlPktsIdx =
+        portStatKeyIndex(kInMacsecControlPkts());
+    static const auto kOutMacsecControlPktsIdx =
+        portStatKeyIndex(kOutMacsecControlPkts());
+    static const auto kInMacsecDecryptedBytesIdx =
+        portStatKeyIndex(kInMacsecDecryptedBytes());
+    static const auto kOutMacsecEncryptedBytesIdx =
+        portStatKeyIndex(kOutMacsecEncryptedBytes());
+    static const auto kInMacsecBadOrNoTagDroppedPktsIdx =
+        portStatKeyIndex(kInMacsecBadOrNoTagDroppedPkts());
+    static const auto kInMacsecNoSciDroppedPktsIdx =
+        portStatKeyIndex(kInMacsecNoSciDroppedPkts());
+    static const auto kInMacsecUnknownSciPktsIdx =
+        portStatKeyIndex(kInMacsecUnknownSciPkts());
+    static const auto kInMacsecOverrunDroppedPktsIdx =
+        portStatKeyIndex(kInMacsecOverrunDroppedPkts());
+    static const auto kInMacsecDelayedPktsIdx =
+        portStatKeyIndex(kInMacsecDelayedPkts());
+    static const auto kInMacsecLateDroppedPktsIdx =
+        portStatKeyIndex(kInMacsecLateDroppedPkts());
+    static const auto kInMacsecNotValidDroppedPktsIdx =
+        portStatKeyIndex(kInMacsecNotValidDroppedPkts());
+    static const auto kInMacsecInvalidPktsIdx =
+        portStatKeyIndex(kInMacsecInvalidPkts());
+    static const auto kInMacsecNoSADroppedPktsIdx =
+        portStatKeyIndex(kInMacsecNoSADroppedPkts());
+    static const auto kInMacsecUnusedSAPktsIdx =
+        portStatKeyIndex(kInMacsecUnusedSAPkts());
+    static const auto kInMacsecUntaggedPktsIdx =
+        portStatKeyIndex(kInMacsecUntaggedPkts());
+    static const auto kInMacsecCurrentXpnIdx =
+        portStatKeyIndex(kInMacsecCurrentXpn());
+    static const auto kOutMacsecUntaggedPktsIdx =
+        portStatKeyIndex(kOutMacsecUntaggedPkts());
+    static const auto kOutMacsecTooLongDroppedPktsIdx =
+        portStatKeyIndex(kOutMacsecTooLongDroppedPkts());
+    static const auto kOutMacsecCurrentXpnIdx =
+        portStatKeyIndex(kOutMacsecCurrentXpn());
     auto updateMacsecPortStats = [this](auto& macsecPortStats, bool ingress) {
-      updateStat(
+      updatePortStat(
           timeRetrieved_,
-          ingress ? kInPreMacsecDropPkts() : kOutPreMacsecDropPkts(),
+          ingress ? kInPreMacsecDropPktsIdx : kOutPreMacsecDropPktsIdx,
           *macsecPortStats.preMacsecDropPkts());
-      updateStat(
+      updatePortStat(
           timeRetrieved_,
-          ingress ? kInMacsecDataPkts() : kOutMacsecDataPkts(),
+          ingress ? kInMacsecDataPktsIdx : kOutMacsecDataPktsIdx,
           *macsecPortStats.dataPkts());
-      updateStat(
+      updatePortStat(
           timeRetrieved_,
-          ingress ? kInMacsecControlPkts() : kOutMacsecControlPkts(),
+          ingress ? kInMacsecControlPktsIdx : kOutMacsecControlPktsIdx,
           *macsecPortStats.controlPkts());
-      updateStat(
+      updatePortStat(
           timeRetrieved_,
-          ingress ? kInMacsecDecryptedBytes() : kOutMacsecEncryptedBytes(),
+          ingress ? kInMacsecDecryptedBytesIdx : kOutMacsecEncryptedBytesIdx,
           *macsecPortStats.octetsEncrypted());
       if (ingress) {
-        updateStat(
+        updatePortStat(
             timeRetrieved_,
-            kInMacsecBadOrNoTagDroppedPkts(),
+            kInMacsecBadOrNoTagDroppedPktsIdx,
             *macsecPortStats.inBadOrNoMacsecTagDroppedPkts());
-        updateStat(
+        updatePortStat(
             timeRetrieved_,
-            kInMacsecNoSciDroppedPkts(),
+            kInMacsecNoSciDroppedPktsIdx,
             *macsecPortStats.inNoSciDroppedPkts());
-        updateStat(
+        updatePortStat(
             timeRetrieved_,
-            kInMacsecUnknownSciPkts(),
+            kInMacsecUnknownSciPktsIdx,
             *macsecPortStats.inUnknownSciPkts());
-        updateStat(
+        updatePortStat(
             timeRetrieved_,
-            kInMacsecOverrunDroppedPkts(),
+            kInMacsecOverrunDroppedPktsIdx,
             *macsecPortStats.inOverrunDroppedPkts());
-        updateStat(
+        updatePortStat(
             timeRetrieved_,
-            kInMacsecDelayedPkts(),
+            kInMacsecDelayedPktsIdx,
             *macsecPortStats.inDelayedPkts());
-        updateStat(
+        updatePortStat(
             timeRetrieved_,
-            kInMacsecLateDroppedPkts(),
+            kInMacsecLateDroppedPktsIdx,
             *macsecPortStats.inLateDroppedPkts());
-        updateStat(
+        updatePortStat(
             timeRetrieved_,
-            kInMacsecNotValidDroppedPkts(),
+            kInMacsecNotValidDroppedPktsIdx,
             *macsecPortStats.inNotValidDroppedPkts());
-        updateStat(
+        updatePortStat(
             timeRetrieved_,
-            kInMacsecInvalidPkts(),
+            kInMacsecInvalidPktsIdx,
             *macsecPortStats.inInvalidPkts());
-        updateStat(
+        updatePortStat(
             timeRetrieved_,
-            kInMacsecNoSADroppedPkts(),
+            kInMacsecNoSADroppedPktsIdx,
             *macsecPortStats.inNoSaDroppedPkts());
-        updateStat(
+        updatePortStat(
             timeRetrieved_,
-            kInMacsecUnusedSAPkts(),
+            kInMacsecUnusedSAPktsIdx,
             *macsecPortStats.inUnusedSaPkts());
-        updateStat(
+        updatePortStat(
             timeRetrieved_,
-            kInMacsecUntaggedPkts(),
+            kInMacsecUntaggedPktsIdx,
             *macsecPortStats.noMacsecTagPkts());
-        updateStat(
+        updatePortStat(
             timeRetrieved_,
-            kInMacsecCurrentXpn(),
+            kInMacsecCurrentXpnIdx,
             *macsecPortStats.inCurrentXpn());
       } else {
-        updateStat(
+        updatePortStat(
             timeRetrieved_,
-            kOutMacsecUntaggedPkts(),
+            kOutMacsecUntaggedPktsIdx,
             *macsecPortStats.noMacsecTagPkts());
-        updateStat(
+        updatePortStat(
             timeRetrieved_,
-            kOutMacsecTooLongDroppedPkts(),
+            kOutMacsecTooLongDroppedPktsIdx,
             *macsecPortStats.outTooLongDroppedPkts());
-        updateStat(
+        updatePortStat(
             timeRetrieved_,
-            kOutMacsecCurrentXpn(),
+            kOutMacsecCurrentXpnIdx,
             *macsecPortStats.outCurrentXpn());
       }
     };
@@ -377,14 +501,17 @@ void HwPortFb303Stats::updateStats(
   }
 
   // PFC stats
-  auto updatePfcStat = [this](
-                           folly::StringPiece statKey,
-                           PfcPriority priority,
-                           const std::map<int16_t, int64_t>& pfcStats,
-                           int64_t* counter) {
+  static const auto kPfcInPfcIdx = pfcStatKeyIndex(kInPfc());
+  static const auto kPfcInPfcXonIdx = pfcStatKeyIndex(kInPfcXon());
+  static const auto kPfcOutPfcIdx = pfcStatKeyIndex(kOutPfc());
+  auto updatePfcStatIf = [this](
+                             size_t statKeyIndex,
+                             PfcPriority priority,
+                             const std::map<int16_t, int64_t>& pfcStats,
+                             int64_t* counter) {
     auto pitr = pfcStats.find(priority);
     if (pitr != pfcStats.end()) {
-      updateStat(timeRetrieved_, statKey, priority, pitr->second);
+      updatePfcStat(timeRetrieved_, statKeyIndex, priority, pitr->second);
       if (counter) {
         *counter += pitr->second;
       }
@@ -392,14 +519,17 @@ void HwPortFb303Stats::updateStats(
   };
   int64_t inPfc = 0, outPfc = 0;
   for (auto priority : getEnabledPfcPriorities()) {
-    updatePfcStat(kInPfc(), priority, *curPortStats.inPfc_(), &inPfc);
-    updatePfcStat(
-        kInPfcXon(), priority, *curPortStats.inPfcXon_(), std::nullptr_t());
-    updatePfcStat(kOutPfc(), priority, *curPortStats.outPfc_(), &outPfc);
+    updatePfcStatIf(kPfcInPfcIdx, priority, *curPortStats.inPfc_(), &inPfc);
+    updatePfcStatIf(
+        kPfcInPfcXonIdx, priority, *curPortStats.inPfcXon_(), nullptr);
+    updatePfcStatIf(
+        kPfcOutPfcIdx, priority, *curPortStats.outPfc_(), &outPfc);
   }
   if (getEnabledPfcPriorities().size()) {
-    updateStat(timeRetrieved_, kInPfc(), inPfc);
-    updateStat(timeRetrieved_, kOutPfc(), outPfc);
+    static const auto kInPfcIdx = portStatKeyIndex(kInPfc());
+    static const auto kOutPfcIdx = portStatKeyIndex(kOutPfc());
+    updatePortStat(timeRetrieved_, kInPfcIdx, inPfc);
+    updatePortStat(timeRetrieved_, kOutPfcIdx, outPfc);
   }
 
   portStats_ = curPortStats;
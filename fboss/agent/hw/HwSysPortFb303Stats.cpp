@@ -67,37 +67,47 @@ void HwSysPortFb303Stats::updateStats(
     const HwSysPortStats& curPortStats,
     const std::chrono::seconds& retrievedAt) {
   timeRetrieved_ = retrievedAt;
-  auto updateQueueStat = [this](
-                             folly::StringPiece statKey,
-                             int queueId,
-                             const std::map<int16_t, int64_t>& queueStats) {
+  // There are tens of thousands of sys ports on VOQ switches, so update
+  // queue stats by handle rather than by name
+  static const auto kOutDiscardsIdx = queueStatKeyIndex(kOutDiscards());
+  static const auto kOutBytesIdx = queueStatKeyIndex(kOutBytes());
+  static const auto kWredDroppedPacketsIdx =
+      queueStatKeyIndex(kWredDroppedPackets());
+  static const auto kCreditWatchdogDeletedPacketsIdx =
+      queueStatKeyIndex(kCreditWatchdogDeletedPackets());
+  static const auto kLatencyWatermarkNsecIdx =
+      queueStatKeyIndex(kLatencyWatermarkNsec());
+  auto updateQueueStatIf = [this](
+                               size_t statKeyIndex,
+                               int queueId,
+                               const std::map<int16_t, int64_t>& queueStats) {
     auto qitr = queueStats.find(queueId);
     if (qitr != queueStats.end()) {
-      updateStat(timeRetrieved_, statKey, queueId, qitr->second);
+      updateQueueStat(timeRetrieved_, statKeyIndex, queueId, qitr->second);
     }
   };
   for (const auto& queueIdAndName : queueId2Name()) {
-    updateQueueStat(
-        kOutDiscards(),
+    updateQueueStatIf(
+        kOutDiscardsIdx,
         queueIdAndName.first,
         *curPortStats.queueOutDiscardBytes_());
-    updateQueueStat(
-        kOutBytes(), queueIdAndName.first, *curPortStats.queueOutBytes_());
+    updateQueueStatIf(
+        kOutBytesIdx, queueIdAndName.first, *curPortStats.queueOutBytes_());
     if (curPortStats.queueWredDroppedPackets_()->size()) {
-      updateQueueStat(
-          kWredDroppedPackets(),
+      updateQueueStatIf(
+          kWredDroppedPacketsIdx,
           queueIdAndName.first,
           *curPortStats.queueWredDroppedPackets_());
     }
     if (curPortStats.queueCreditWatchdogDeletedPackets_()->size()) {
-      updateQueueStat(
-          kCreditWatchdogDeletedPackets(),
+      updateQueueStatIf(
+          kCreditWatchdogDeletedPacketsIdx,
           queueIdAndName.first,
           *curPortStats.queueCreditWatchdogDeletedPackets_());
     }
     if (curPortStats.queueLatencyWatermarkNsec_()->size()) {
-      updateQueueStat(
-          kLatencyWatermarkNsec(),
+      updateQueueStatIf(
+          kLatencyWatermarkNsecIdx,
           queueIdAndName.first,
           *curPortStats.queueLatencyWatermarkNsec_());
     }
@@ -0,0 +1,57 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/benchmarks/HwPktioAllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+/*
+ * This is process wide, so background agent threads (stats collection etc.)
+ * contribute to the count as well, which is why runs should be long enough
+ * for the packet path to dominate.
+ */
+std::atomic<bool> countAllocations{false};
+std::atomic<uint64_t> numAllocations{0};
+} // namespace
+
+void* operator new(size_t size) {
+  if (countAllocations.load(std::memory_order_relaxed)) {
+    numAllocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (auto ptr = std::malloc(size ? size : 1)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t /* size */) noexcept {
+  std::free(ptr);
+}
+
+namespace facebook::fboss {
+
+void startCountingAllocations() {
+  numAllocations = 0;
+  countAllocations = true;
+}
+
+uint64_t stopCountingAllocations() {
+  countAllocations = false;
+  return numAllocations.load();
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,26 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace facebook::fboss {
+
+/*
+ * Count allocations made through operator new between start and stop.
+ *
+ * Defined in HwPktioAllocationCounter.cpp, which replaces the global
+ * operator new and so must only be compiled into the packet io benchmark
+ * executable itself, never into a library.
+ */
+void startCountingAllocations();
+uint64_t stopCountingAllocations();
+
+} // namespace facebook::fboss
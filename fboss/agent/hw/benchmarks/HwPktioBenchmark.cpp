@@ -0,0 +1,473 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/LacpTypes.h"
+#include "fboss/agent/LldpManager.h"
+#include "fboss/agent/PacketObserver.h"
+#include "fboss/agent/RxPacket.h"
+#include "fboss/agent/TxPacket.h"
+#include "fboss/agent/benchmarks/AgentBenchmarks.h"
+#include "fboss/agent/hw/benchmarks/HwPktioAllocationCounter.h"
+#include "fboss/agent/hw/sai/fake/FakeSai.h"
+#include "fboss/agent/hw/sai/switch/SaiPortManager.h"
+#include "fboss/agent/hw/sai/switch/SaiSwitch.h"
+#include "fboss/agent/packet/ICMPHdr.h"
+#include "fboss/agent/packet/IPProto.h"
+#include "fboss/agent/packet/PktFactory.h"
+#include "fboss/agent/test/utils/ConfigUtils.h"
+
+#include <folly/Benchmark.h>
+#include <folly/IPAddress.h>
+#include <folly/String.h>
+#include <folly/Synchronized.h>
+#include <folly/io/Cursor.h>
+#include <folly/json/dynamic.h>
+#include <folly/json/json.h>
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <iostream>
+#include <thread>
+
+DEFINE_int32(
+    pktio_bench_pps,
+    0,
+    "Rate to inject packets at, 0 to inject as fast as possible");
+DEFINE_int32(pktio_bench_packets, 100000, "Number of packets to inject");
+DEFINE_string(
+    pktio_bench_mix,
+    "arp:1,ndp:1,lldp:1,lacp:1,dhcp:1",
+    "Packet mix to inject, as comma separated <type>:<weight> pairs. "
+    "Types are arp, ndp, lldp, lacp and dhcp");
+
+namespace facebook::fboss {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+enum class PktType : uint8_t { ARP, NDP, LLDP, LACP, DHCP, NUM_TYPES };
+constexpr auto kNumPktTypes = static_cast<size_t>(PktType::NUM_TYPES);
+const std::array<std::string, kNumPktTypes> kPktTypeNames = {
+    "arp",
+    "ndp",
+    "lldp",
+    "lacp",
+    "dhcp"};
+
+const auto kNeighborMac = folly::MacAddress("fa:ce:b0:00:00:0c");
+constexpr uint32_t kMinFrameLength = 64;
+constexpr auto kDrainTimeout = std::chrono::seconds(30);
+
+struct Classified {
+  PktType type;
+  // ARP reply or neighbor advertisement
+  bool isReply{false};
+};
+
+// Just enough parsing to tell apart the packets we inject and their replies
+std::optional<Classified> classify(folly::io::Cursor cursor) {
+  try {
+    cursor.skip(12);
+    auto etherType = cursor.readBE<uint16_t>();
+    if (etherType == static_cast<uint16_t>(ETHERTYPE::ETHERTYPE_VLAN)) {
+      cursor.skip(2);
+      etherType = cursor.readBE<uint16_t>();
+    }
+    switch (static_cast<ETHERTYPE>(etherType)) {
+      case ETHERTYPE::ETHERTYPE_ARP:
+        // htype, ptype, hlen, plen
+        cursor.skip(6);
+        return Classified{
+            PktType::ARP,
+            cursor.readBE<uint16_t>() ==
+                static_cast<uint16_t>(ARP_OPER::ARP_OPER_REPLY)};
+      case ETHERTYPE::ETHERTYPE_LLDP:
+        return Classified{PktType::LLDP};
+      case ETHERTYPE::ETHERTYPE_SLOW_PROTOCOLS:
+        return Classified{PktType::LACP};
+      case ETHERTYPE::ETHERTYPE_IPV4:
+        return Classified{PktType::DHCP};
+      case ETHERTYPE::ETHERTYPE_IPV6: {
+        cursor.skip(6);
+        if (cursor.read<uint8_t>() !=
+            static_cast<uint8_t>(IP_PROTO::IP_PROTO_IPV6_ICMP)) {
+          return std::nullopt;
+        }
+        // Rest of the IPv6 header
+        cursor.skip(33);
+        return Classified{
+            PktType::NDP,
+            cursor.read<uint8_t>() ==
+                static_cast<uint8_t>(
+                    ICMPv6Type::ICMPV6_TYPE_NDP_NEIGHBOR_ADVERTISEMENT)};
+      }
+      default:
+        return std::nullopt;
+    }
+  } catch (const std::out_of_range&) {
+    return std::nullopt;
+  }
+}
+
+std::vector<PktType> parsePktMix(const std::string& mix) {
+  std::vector<PktType> schedule;
+  std::vector<folly::StringPiece> entries;
+  folly::split(',', mix, entries);
+  for (auto entry : entries) {
+    folly::StringPiece name, weight;
+    if (!folly::split(':', entry, name, weight)) {
+      throw FbossError("Invalid packet mix entry: ", entry);
+    }
+    auto it = std::find(kPktTypeNames.begin(), kPktTypeNames.end(), name);
+    if (it == kPktTypeNames.end()) {
+      throw FbossError("Unknown packet type in packet mix: ", name);
+    }
+    auto type = static_cast<PktType>(it - kPktTypeNames.begin());
+    schedule.insert(schedule.end(), folly::to<uint32_t>(weight), type);
+  }
+  if (schedule.empty()) {
+    throw FbossError("Empty packet mix");
+  }
+  return schedule;
+}
+
+std::vector<uint8_t> toBytes(std::unique_ptr<TxPacket> pkt) {
+  auto buf = pkt->buf();
+  buf->coalesce();
+  std::vector<uint8_t> bytes(buf->data(), buf->tail());
+  // SwSwitch drops runts, pad as the sender's NIC would
+  if (bytes.size() < kMinFrameLength) {
+    bytes.resize(kMinFrameLength, 0);
+  }
+  return bytes;
+}
+
+folly::IPAddress neighborIp(const folly::CIDRNetwork& intfSubnet) {
+  auto subnet = intfSubnet.first.mask(intfSubnet.second);
+  if (subnet.isV4()) {
+    return folly::IPAddressV4::fromLongHBO(subnet.asV4().toLongHBO() + 100);
+  }
+  auto bytes = subnet.asV6().toByteArray();
+  bytes[15] = 100;
+  return folly::IPAddressV6(bytes);
+}
+
+std::array<std::vector<uint8_t>, kNumPktTypes> makePackets(
+    const SwSwitch* sw,
+    const std::vector<folly::CIDRNetwork>& intfSubnets) {
+  std::optional<folly::CIDRNetwork> v4Subnet, v6Subnet;
+  for (const auto& subnet : intfSubnets) {
+    auto& dst = subnet.first.isV4() ? v4Subnet : v6Subnet;
+    if (!dst) {
+      dst = subnet;
+    }
+  }
+  CHECK(v4Subnet && v6Subnet) << "Interface needs v4 and v6 addresses";
+
+  std::array<std::vector<uint8_t>, kNumPktTypes> packets;
+  // Requests for the interface address, so the agent replies to them
+  packets[static_cast<size_t>(PktType::ARP)] =
+      toBytes(utility::makeARPTxPacket(
+          sw,
+          std::nullopt,
+          kNeighborMac,
+          folly::MacAddress::BROADCAST,
+          neighborIp(*v4Subnet),
+          v4Subnet->first,
+          ARP_OPER::ARP_OPER_REQUEST));
+  packets[static_cast<size_t>(PktType::NDP)] =
+      toBytes(utility::makeNeighborSolicitation(
+          sw,
+          std::nullopt,
+          kNeighborMac,
+          neighborIp(*v6Subnet).asV6(),
+          v6Subnet->first.asV6()));
+  packets[static_cast<size_t>(PktType::LLDP)] =
+      toBytes(LldpManager::createLldpPkt(
+          utility::makeAllocator(sw),
+          kNeighborMac,
+          std::nullopt,
+          "pktio-bench-neighbor",
+          "eth1/1/1",
+          "pktio bench neighbor port",
+          120 /* ttl */,
+          0 /* capabilities */));
+  // Payload starts with the LACP subtype
+  std::vector<uint8_t> lacpPayload(LACPDU::LENGTH, 0);
+  lacpPayload[0] = LACPDU::EtherSubtype::LACP;
+  packets[static_cast<size_t>(PktType::LACP)] =
+      toBytes(utility::makeEthTxPacket(
+          sw,
+          std::nullopt,
+          kNeighborMac,
+          LACPDU::kSlowProtocolsDstMac(),
+          ETHERTYPE::ETHERTYPE_SLOW_PROTOCOLS,
+          lacpPayload));
+  // DHCP discover
+  packets[static_cast<size_t>(PktType::DHCP)] =
+      toBytes(utility::makeUDPTxPacket(
+          sw,
+          std::nullopt,
+          kNeighborMac,
+          folly::MacAddress::BROADCAST,
+          folly::IPAddressV4("0.0.0.0"),
+          folly::IPAddressV4("255.255.255.255"),
+          68,
+          67));
+  return packets;
+}
+
+folly::dynamic percentiles(std::vector<uint64_t> samplesNs) {
+  folly::dynamic result = folly::dynamic::object;
+  result["count"] = samplesNs.size();
+  if (samplesNs.empty()) {
+    return result;
+  }
+  std::sort(samplesNs.begin(), samplesNs.end());
+  auto percentileUs = [&](double pct) {
+    auto idx = static_cast<size_t>(pct / 100 * (samplesNs.size() - 1));
+    return samplesNs[idx] / 1000.0;
+  };
+  result["p50_us"] = percentileUs(50);
+  result["p90_us"] = percentileUs(90);
+  result["p99_us"] = percentileUs(99);
+  result["max_us"] = samplesNs.back() / 1000.0;
+  return result;
+}
+
+/*
+ * Tracks each injected packet through the software packet path:
+ *  - rx: fake SAI packet event notification up to SwSwitch packet observers,
+ *    i.e. SaiSwitch::packetRxCallback, SwSwitch::packetReceived and the rx
+ *    handler queues when rx_sw_priority is enabled.
+ *  - reply: packet observers up to the reply reaching the fake SAI
+ *    send_hostif_packet, i.e. handler dispatch, ARP/NDP handling and
+ *    sendPacketSwitchedAsync. Only ARP and NDP requests get replies.
+ *
+ * Packets of the same type are never reordered (they share a priority), so
+ * timestamps are matched FIFO per packet type.
+ */
+class PktioTracker : public PacketObserverIf {
+ public:
+  void injected(PktType type, Clock::time_point time) {
+    state_.wlock()->perType[static_cast<size_t>(type)].pendingRx.push_back(
+        time);
+  }
+
+  void packetSent(const void* buffer, sai_size_t size) {
+    auto now = Clock::now();
+    auto buf = folly::IOBuf::wrapBufferAsValue(buffer, size);
+    auto classified = classify(folly::io::Cursor(&buf));
+    if (!classified || !classified->isReply) {
+      return;
+    }
+    auto state = state_.wlock();
+    auto& perType = state->perType[static_cast<size_t>(classified->type)];
+    if (perType.pendingReply.empty()) {
+      // Not a reply to one of our requests
+      return;
+    }
+    state->replySamples.push_back(elapsedNs(perType.pendingReply.front(), now));
+    perType.pendingReply.pop_front();
+    ++numReplies_;
+  }
+
+  uint64_t numReceived() const {
+    return numReceived_.load();
+  }
+
+  uint64_t numReplies() const {
+    return numReplies_.load();
+  }
+
+  std::vector<uint64_t> rxSamples() const {
+    return state_.rlock()->rxSamples;
+  }
+
+  std::vector<uint64_t> replySamples() const {
+    return state_.rlock()->replySamples;
+  }
+
+ private:
+  static uint64_t elapsedNs(Clock::time_point from, Clock::time_point to) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(to - from)
+        .count();
+  }
+
+  void packetReceived(const RxPacket* pkt) noexcept override {
+    auto now = Clock::now();
+    auto classified = classify(folly::io::Cursor(pkt->buf()));
+    if (!classified) {
+      return;
+    }
+    auto state = state_.wlock();
+    auto& perType = state->perType[static_cast<size_t>(classified->type)];
+    if (perType.pendingRx.empty()) {
+      return;
+    }
+    state->rxSamples.push_back(elapsedNs(perType.pendingRx.front(), now));
+    perType.pendingRx.pop_front();
+    if (classified->type == PktType::ARP || classified->type == PktType::NDP) {
+      perType.pendingReply.push_back(now);
+    }
+    ++numReceived_;
+  }
+
+  struct PerType {
+    std::deque<Clock::time_point> pendingRx;
+    std::deque<Clock::time_point> pendingReply;
+  };
+  struct State {
+    std::array<PerType, kNumPktTypes> perType;
+    std::vector<uint64_t> rxSamples;
+    std::vector<uint64_t> replySamples;
+  };
+  folly::Synchronized<State> state_;
+  std::atomic<uint64_t> numReceived_{0};
+  std::atomic<uint64_t> numReplies_{0};
+};
+
+template <typename Fn>
+bool waitFor(Fn done) {
+  auto deadline = Clock::now() + kDrainTimeout;
+  while (!done()) {
+    if (Clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+} // namespace
+
+/*
+ * Packet io benchmark for the software packet path, runnable against the fake
+ * SAI so it can catch CPU regressions without an ASIC. Packets are injected
+ * through the fake SAI hostif as if trapped to CPU on the first interface
+ * port, at --pktio_bench_pps, with the --pktio_bench_mix packet mix.
+ */
+BENCHMARK(PktioBenchmark) {
+  folly::BenchmarkSuspender suspender;
+  AgentEnsembleSwitchConfigFn initialConfigFn =
+      [](const AgentEnsemble& ensemble) {
+        return utility::onePortPerInterfaceConfig(
+            ensemble.getSw(), {ensemble.masterLogicalInterfacePortIds()[0]});
+      };
+  auto ensemble =
+      createAgentEnsemble(initialConfigFn, false /*disableLinkStateToggler*/);
+  auto sw = ensemble->getSw();
+  auto saiSwitch = static_cast<SaiSwitch*>(ensemble->getHwSwitch());
+  auto switchId = saiSwitch->getSaiSwitchId();
+  auto ingressPort = saiSwitch->managerTable()
+                         ->portManager()
+                         .getPortHandle(
+                             ensemble->masterLogicalInterfacePortIds()[0])
+                         ->port->adapterKey();
+
+  std::vector<folly::CIDRNetwork> intfSubnets;
+  for (const auto& ip :
+       *ensemble->getCurrentConfig().interfaces()->at(0).ipAddresses()) {
+    intfSubnets.push_back(folly::IPAddress::createNetwork(ip, -1, false));
+  }
+  auto packets = makePackets(sw, intfSubnets);
+  auto schedule = parsePktMix(FLAGS_pktio_bench_mix);
+
+  PktioTracker tracker;
+  sw->getPacketObservers()->registerPacketObserver(&tracker, "PktioBenchmark");
+  setFakeHostifTxCallback(
+      [&tracker](sai_object_id_t, const void* buffer, sai_size_t size) {
+        tracker.packetSent(buffer, size);
+      });
+
+  std::array<uint64_t, kNumPktTypes> numInjected{};
+  std::vector<uint64_t> callbackSamples;
+  callbackSamples.reserve(FLAGS_pktio_bench_packets);
+  auto interval = FLAGS_pktio_bench_pps
+      ? std::chrono::nanoseconds(std::chrono::seconds(1)) /
+          FLAGS_pktio_bench_pps
+      : std::chrono::nanoseconds(0);
+
+  suspender.dismiss();
+  startCountingAllocations();
+  auto start = Clock::now();
+  for (auto i = 0; i < FLAGS_pktio_bench_packets; ++i) {
+    if (interval.count()) {
+      std::this_thread::sleep_until(start + interval * i);
+    }
+    auto type = schedule[i % schedule.size()];
+    const auto& pkt = packets[static_cast<size_t>(type)];
+    auto injectTime = Clock::now();
+    tracker.injected(type, injectTime);
+    auto rv = fakeHostifInjectRxPacket(
+        switchId, ingressPort, pkt.data(), pkt.size());
+    CHECK_EQ(rv, SAI_STATUS_SUCCESS);
+    callbackSamples.push_back(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now() - injectTime)
+            .count());
+    ++numInjected[static_cast<size_t>(type)];
+  }
+  auto numRequests = numInjected[static_cast<size_t>(PktType::ARP)] +
+      numInjected[static_cast<size_t>(PktType::NDP)];
+  bool drained = waitFor([&]() {
+    return tracker.numReceived() == FLAGS_pktio_bench_packets &&
+        tracker.numReplies() == numRequests;
+  });
+  auto end = Clock::now();
+  auto numAllocations = stopCountingAllocations();
+  suspender.rehire();
+
+  setFakeHostifTxCallback(nullptr);
+  sw->getPacketObservers()->unregisterPacketObserver(
+      &tracker, "PktioBenchmark");
+  if (!drained) {
+    XLOG(ERR) << "Timed out waiting for packets, received: "
+              << tracker.numReceived() << " replies: " << tracker.numReplies();
+  }
+
+  std::chrono::duration<double> duration = end - start;
+  auto pps = tracker.numReceived() / duration.count();
+  auto allocsPerPkt =
+      static_cast<double>(numAllocations) / FLAGS_pktio_bench_packets;
+
+  if (FLAGS_json) {
+    folly::dynamic pktioJson = folly::dynamic::object;
+    pktioJson["pps"] = pps;
+    pktioJson["allocations_per_packet"] = allocsPerPkt;
+    folly::dynamic injected = folly::dynamic::object;
+    for (size_t i = 0; i < kNumPktTypes; ++i) {
+      injected[kPktTypeNames[i]] = numInjected[i];
+    }
+    pktioJson["injected"] = std::move(injected);
+    pktioJson["replies"] = tracker.numReplies();
+    folly::dynamic stages = folly::dynamic::object;
+    stages["rx_callback"] = percentiles(std::move(callbackSamples));
+    stages["rx"] = percentiles(tracker.rxSamples());
+    stages["reply"] = percentiles(tracker.replySamples());
+    pktioJson["stage_latency"] = std::move(stages);
+    std::cout << toPrettyJson(pktioJson) << std::endl;
+  } else {
+    XLOG(DBG2) << "Injected: " << FLAGS_pktio_bench_packets
+               << " received: " << tracker.numReceived()
+               << " replies: " << tracker.numReplies() << " pps: " << pps
+               << " allocations per packet: " << allocsPerPkt
+               << " rx callback latency: "
+               << toJson(percentiles(std::move(callbackSamples)))
+               << " rx latency: " << toJson(percentiles(tracker.rxSamples()))
+               << " reply latency: "
+               << toJson(percentiles(tracker.replySamples()));
+  }
+}
+
+} // namespace facebook::fboss
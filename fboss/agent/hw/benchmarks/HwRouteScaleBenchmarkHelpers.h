@@ -21,6 +21,7 @@
 #include "fboss/agent/test/utils/VoqTestUtils.h"
 
 #include <folly/Benchmark.h>
+#include <folly/json/json.h>
 #include <iostream>
 #include "fboss/agent/FibHelpers.h"
 #include "fboss/agent/Utils.h"
@@ -37,6 +38,31 @@ const auto kEcmpGroup = 8;
 
 namespace facebook::fboss {
 
+/*
+ * Break down the time spent programming routes so far by CallTimeStage, when
+ * call timing is on (--enable_call_timing). Against fake SAI, use
+ * --fake_sai_call_latency_us to model SDK call cost.
+ */
+inline void reportCallTimeStages() {
+  auto reporter = FunctionCallTimeReporter::getInstance();
+  if (!reporter->isOn()) {
+    return;
+  }
+  auto stageTimes = reporter->getStageTimes();
+  folly::dynamic stages = folly::dynamic::object;
+  stages["total_msecs"] = reporter->getElapsed().count() / 1000.0;
+  for (size_t i = 0; i < stageTimes.size(); ++i) {
+    auto name = callTimeStageName(static_cast<CallTimeStage>(i));
+    stages[folly::to<std::string>(name, "_msecs")] =
+        stageTimes[i].count() / 1000.0;
+  }
+  if (FLAGS_json) {
+    std::cout << toPrettyJson(stages) << std::endl;
+  } else {
+    XLOG(DBG2) << "route programming stages: " << folly::toJson(stages);
+  }
+}
+
 /*
  * Helper function to benchmark speed of route insertion, deletion
  * in HW. This function inits the ASIC, generate switch states for
@@ -142,6 +168,7 @@ void routeAddDelBenchmarker(bool measureAdd) {
       // We are about to blow away all routes, before that
       // deactivate benchmark measurement.
       suspender.rehire();
+      reportCallTimeStages();
     }
     // Do a sync fib and have it compete with route lookups
     auto syncFib =
@@ -174,6 +201,7 @@ void routeAddDelBenchmarker(bool measureAdd) {
     suspender.dismiss();
     ensemble->unprogramRoutes(kRid, ClientID::BGPD, routeChunks);
     suspender.rehire();
+    reportCallTimeStages();
   }
   done = true;
   lookupThread.join();
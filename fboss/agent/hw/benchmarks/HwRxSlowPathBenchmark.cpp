@@ -10,6 +10,7 @@
 
 #include "fboss/agent/HwAsicTable.h"
 #include "fboss/agent/IPv6Handler.h"
+#include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/TxPacket.h"
 #include "fboss/agent/hw/test/ConfigFactory.h"
 #include "fboss/agent/packet/PktFactory.h"
@@ -126,6 +127,11 @@ BENCHMARK(RxSlowPathBenchmark) {
   auto statsBefore = cpuStatsBefore[0];
   auto [pktsBefore, bytesBefore] = utility::getCpuQueueOutPacketsAndBytes(
       *statsBefore.portStats_(), kCpuQueue);
+  // With split agents, also count what made it across to SwSwitch, over
+  // thrift or the shared memory packet rings (--split_agent_packet_rings)
+  auto swRxPktsBefore = FLAGS_multi_switch
+      ? ensemble->getSw()->stats()->getHwAgentRxPktReceivedCount(0)
+      : 0;
   auto timeBefore = std::chrono::steady_clock::now();
   CHECK_NE(pktsBefore, 0);
   std::this_thread::sleep_for(std::chrono::seconds(kBurnIntevalInSeconds));
@@ -134,6 +140,9 @@ BENCHMARK(RxSlowPathBenchmark) {
   auto statsAfter = cpuStatsAfter[0];
   auto [pktsAfter, bytesAfter] = utility::getCpuQueueOutPacketsAndBytes(
       *statsAfter.portStats_(), kCpuQueue);
+  auto swRxPktsAfter = FLAGS_multi_switch
+      ? ensemble->getSw()->stats()->getHwAgentRxPktReceivedCount(0)
+      : 0;
   auto timeAfter = std::chrono::steady_clock::now();
   std::chrono::duration<double, std::milli> durationMillseconds =
       timeAfter - timeBefore;
@@ -143,16 +152,23 @@ BENCHMARK(RxSlowPathBenchmark) {
   uint32_t bytesPerSec = (static_cast<double>(bytesAfter - bytesBefore) /
                           durationMillseconds.count()) *
       1000;
+  uint32_t swRxPps = (static_cast<double>(swRxPktsAfter - swRxPktsBefore) /
+                      durationMillseconds.count()) *
+      1000;
 
   if (FLAGS_json) {
     folly::dynamic cpuRxRateJson = folly::dynamic::object;
     cpuRxRateJson["cpu_rx_pps"] = pps;
     cpuRxRateJson["cpu_rx_bytes_per_sec"] = bytesPerSec;
+    if (FLAGS_multi_switch) {
+      cpuRxRateJson["sw_rx_pps"] = swRxPps;
+    }
     std::cout << toPrettyJson(cpuRxRateJson) << std::endl;
   } else {
     XLOG(DBG2) << " Pkts before: " << pktsBefore << " Pkts after: " << pktsAfter
                << " interval ms: " << durationMillseconds.count()
-               << " pps: " << pps << " bytes per sec: " << bytesPerSec;
+               << " pps: " << pps << " bytes per sec: " << bytesPerSec
+               << " sw rx pps: " << swRxPps;
   }
 }
 } // namespace facebook::fboss
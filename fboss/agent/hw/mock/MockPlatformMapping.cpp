@@ -12,7 +12,7 @@
 namespace facebook::fboss {
 
 MockPlatformMapping::MockPlatformMapping() : Wedge100PlatformMapping() {
-  for (auto& entry : platformPorts_) {
+  for (auto& entry : getMutablePlatformPorts()) {
     auto& platformPort = entry.second;
     platformPort.mapping()->attachedCoreId() = 0;
     platformPort.mapping()->attachedCorePortIndex() = 0;
@@ -150,6 +150,13 @@ class NeighborApi : public SaiApi<NeighborApi> {
       sai_attribute_t* attr) const {
     return api_->get_neighbor_entry_attribute(neighborEntry.entry(), 1, attr);
   }
+  sai_status_t _getAttributes(
+      const SaiNeighborTraits::NeighborEntry& neighborEntry,
+      uint32_t count,
+      sai_attribute_t* attrs) const {
+    return api_->get_neighbor_entry_attribute(
+        neighborEntry.entry(), count, attrs);
+  }
   sai_status_t _setAttribute(
       const SaiNeighborTraits::NeighborEntry& neighborEntry,
       const sai_attribute_t* attr) const {
@@ -190,6 +190,12 @@ class NextHopApi : public SaiApi<NextHopApi> {
   sai_status_t _getAttribute(NextHopSaiId id, sai_attribute_t* attr) const {
     return api_->get_next_hop_attribute(id, 1, attr);
   }
+  sai_status_t _getAttributes(
+      NextHopSaiId id,
+      uint32_t count,
+      sai_attribute_t* attrs) const {
+    return api_->get_next_hop_attribute(id, count, attrs);
+  }
   sai_status_t _setAttribute(NextHopSaiId id, const sai_attribute_t* attr)
       const {
     return api_->set_next_hop_attribute(id, attr);
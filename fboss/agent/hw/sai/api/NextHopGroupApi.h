@@ -144,6 +144,12 @@ class NextHopGroupApi : public SaiApi<NextHopGroupApi> {
       const {
     return api_->get_next_hop_group_member_attribute(id, 1, attr);
   }
+  sai_status_t _getAttributes(
+      NextHopGroupMemberSaiId id,
+      uint32_t count,
+      sai_attribute_t* attrs) const {
+    return api_->get_next_hop_group_member_attribute(id, count, attrs);
+  }
   sai_status_t _setAttribute(NextHopGroupSaiId id, const sai_attribute_t* attr)
       const {
     return api_->set_next_hop_group_attribute(id, attr);
@@ -137,6 +137,12 @@ class RouteApi : public SaiApi<RouteApi> {
       sai_attribute_t* attr) const {
     return api_->get_route_entry_attribute(routeEntry.entry(), 1, attr);
   }
+  sai_status_t _getAttributes(
+      const SaiRouteTraits::RouteEntry& routeEntry,
+      uint32_t count,
+      sai_attribute_t* attrs) const {
+    return api_->get_route_entry_attribute(routeEntry.entry(), count, attrs);
+  }
   sai_status_t _setAttribute(
       const SaiRouteTraits::RouteEntry& routeEntry,
       const sai_attribute_t* attr) const {
@@ -25,6 +25,7 @@
 #include <algorithm>
 #include <exception>
 #include <mutex>
+#include <optional>
 #include <stdexcept>
 #include <type_traits>
 #include <vector>
@@ -37,6 +38,14 @@ extern "C" {
 
 namespace facebook::fboss {
 
+namespace detail {
+template <typename T>
+struct IsOptionalSaiAttribute : std::false_type {};
+
+template <typename AttrT>
+struct IsOptionalSaiAttribute<std::optional<AttrT>> : IsSaiAttribute<AttrT> {};
+} // namespace detail
+
 template <typename ApiT>
 class SaiApi {
  public:
@@ -305,6 +314,31 @@ class SaiApi {
     }
   }
 
+  /*
+   * Same as getAttribute() on a tuple of attributes, but for apis which
+   * implement _getAttributes(), gets all of the attributes in a single SAI
+   * call instead of one call per attribute. This matters when loading objects
+   * with many instances, like routes and next hops, on warm boot.
+   *
+   * If the combined get fails, e.g. because a list attribute needs a bigger
+   * buffer or an attribute with a default getter is not implemented, falls
+   * back to getting attributes one at a time, which handles those cases.
+   */
+  template <typename AdapterKeyT, typename AttrsT>
+  auto getAttributes(const AdapterKeyT& key, AttrsT& attrs) const {
+    if constexpr (IsTuple<AttrsT>::value) {
+      if constexpr (requires(sai_attribute_t * saiAttrs) {
+                      impl()._getAttributes(key, 1, saiAttrs);
+                    }) {
+        AttrsT result = attrs;
+        if (getAttributesInOneCall(key, result)) {
+          return result;
+        }
+      }
+    }
+    return getAttribute(key, attrs);
+  }
+
 #if SAI_API_VERSION >= SAI_VERSION(1, 13, 0)
   template <typename AdapterKeyT, typename AttrT>
   std::vector<typename std::remove_reference_t<AttrT>::ValueType>
@@ -620,6 +654,83 @@ class SaiApi {
       saiApiCheckError(status, apiType(), "Failed to clear stats");
     }
   }
+  /*
+   * Get every attribute of attrTuple in a single _getAttributes() call,
+   * filling in attrTuple on success. Returns false, leaving attrTuple in an
+   * unspecified state, if any attribute can't be part of a combined get or if
+   * the adapter fails it.
+   */
+  template <typename AdapterKeyT, typename TupleT>
+  bool getAttributesInOneCall(const AdapterKeyT& key, TupleT& attrTuple)
+      const {
+    bool supported = true;
+    std::vector<sai_attribute_t> saiAttrs;
+    saiAttrs.reserve(std::tuple_size_v<TupleT>);
+    tupleForEach(
+        [&](auto& attr) {
+          using T = std::decay_t<decltype(attr)>;
+          if constexpr (
+              IsSaiAttribute<T>::value && !IsSaiExtensionAttribute<T>::value) {
+            saiAttrs.push_back(*attr.saiAttr());
+          } else if constexpr (detail::IsOptionalSaiAttribute<T>::value) {
+            using AttrT = typename T::value_type;
+            if constexpr (IsSaiExtensionAttribute<AttrT>::value) {
+              // May not be supported by the adapter, see getAttribute()
+              supported = false;
+            } else {
+              if (!attr) {
+                attr = AttrT{};
+              }
+              saiAttrs.push_back(*attr->saiAttr());
+            }
+          } else {
+            supported = false;
+          }
+        },
+        attrTuple);
+    if (!supported) {
+      return false;
+    }
+
+    sai_status_t status;
+    {
+      auto g{SaiApiLock::getInstance()->lock()};
+      TIME_CALL;
+      status = impl()._getAttributes(key, saiAttrs.size(), saiAttrs.data());
+    }
+    if (status != SAI_STATUS_SUCCESS) {
+      XLOGF(
+          DBG5,
+          "failed to get all SAI attributes of {} in one call: {}",
+          key,
+          status);
+      return false;
+    }
+
+    // List attributes point to storage owned by attrTuple, so copying back
+    // the sai_attribute_t (incl. list counts) is enough to fill them in.
+    size_t idx = 0;
+    tupleForEach(
+        [&](auto& attr) {
+          using T = std::decay_t<decltype(attr)>;
+          if constexpr (IsSaiAttribute<T>::value) {
+            *attr.saiAttr() = saiAttrs[idx++];
+            XLOGF(DBG5, "got SAI attribute: {}: {}", key, attr);
+          } else {
+            *attr->saiAttr() = saiAttrs[idx++];
+            // Empty lists are treated as unset, same as in getAttribute()
+            if constexpr (IsVector<
+                              typename T::value_type::ValueType>::value) {
+              if (attr->value().empty()) {
+                attr.reset();
+              }
+            }
+          }
+        },
+        attrTuple);
+    return true;
+  }
+
   ApiT& impl() {
     return static_cast<ApiT&>(*this);
   }
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "fboss/agent/hw/sai/api/SaiApiError.h"
+#include "fboss/agent/hw/sai/api/SaiApiLock.h"
 #include "fboss/agent/hw/sai/api/SaiVersion.h"
 #include "fboss/agent/hw/sai/api/Traits.h"
 
@@ -49,8 +50,12 @@ getAdapterKey(const sai_object_key_t& key) {
 template <typename SaiObjectTraits>
 uint32_t getObjectCount(sai_object_id_t switch_id) {
   uint32_t count = 0;
-  sai_status_t status =
-      sai_get_object_count(switch_id, SaiObjectTraits::ObjectType, &count);
+  sai_status_t status;
+  {
+    auto g{SaiApiLock::getInstance()->lock()};
+    status =
+        sai_get_object_count(switch_id, SaiObjectTraits::ObjectType, &count);
+  }
   // For objects that are not supported yet by SAI SDK, return count 0.
   if (status == SAI_STATUS_NOT_IMPLEMENTED ||
       status == SAI_STATUS_NOT_SUPPORTED) {
@@ -71,8 +76,12 @@ std::vector<typename SaiObjectTraits::AdapterKey> getObjectKeys(
   std::vector<sai_object_key_t> keys;
   uint32_t c = getObjectCount<SaiObjectTraits>(switch_id);
   keys.resize(c);
-  sai_status_t status = sai_get_object_key(
-      switch_id, SaiObjectTraits::ObjectType, &c, keys.data());
+  sai_status_t status;
+  {
+    auto g{SaiApiLock::getInstance()->lock()};
+    status = sai_get_object_key(
+        switch_id, SaiObjectTraits::ObjectType, &c, keys.data());
+  }
   saiLogError(
       status,
       SAI_API_UNSPECIFIED,
@@ -20,12 +20,36 @@ using namespace facebook::fboss;
 
 static constexpr folly::StringPiece str4 = "42.42.12.34";
 
+namespace {
+// Wraps the fake next hop get so tests can tell combined gets from
+// per-attribute ones.
+int multiAttributeGets;
+decltype(sai_next_hop_api_t::get_next_hop_attribute) fakeGetNextHopAttribute;
+
+sai_status_t getNextHopAttribute(
+    sai_object_id_t nextHopId,
+    uint32_t attrCount,
+    sai_attribute_t* attrList) {
+  if (attrCount > 1) {
+    ++multiAttributeGets;
+  }
+  return fakeGetNextHopAttribute(nextHopId, attrCount, attrList);
+}
+} // namespace
+
 class NextHopApiTest : public ::testing::Test {
  public:
   void SetUp() override {
     fs = FakeSai::getInstance();
     sai_api_initialize(0, nullptr);
     nextHopApi = std::make_unique<NextHopApi>();
+    sai_api_query(SAI_API_NEXT_HOP, reinterpret_cast<void**>(&fakeNextHopApi));
+    fakeGetNextHopAttribute = fakeNextHopApi->get_next_hop_attribute;
+    fakeNextHopApi->get_next_hop_attribute = &getNextHopAttribute;
+    multiAttributeGets = 0;
+  }
+  void TearDown() override {
+    fakeNextHopApi->get_next_hop_attribute = fakeGetNextHopAttribute;
   }
   NextHopSaiId createNextHop(folly::IPAddress ip) {
     SaiIpNextHopTraits::Attributes::Type typeAttribute(SAI_NEXT_HOP_TYPE_IP);
@@ -66,6 +90,7 @@ class NextHopApiTest : public ::testing::Test {
 
     return nextHopId;
   }
+  sai_next_hop_api_t* fakeNextHopApi;
   std::shared_ptr<FakeSai> fs;
   std::unique_ptr<NextHopApi> nextHopApi;
   folly::IPAddress ip4{str4};
@@ -173,3 +198,34 @@ TEST_F(NextHopApiTest, formatNextHopAttributes) {
   SaiMplsNextHopTraits::Attributes::LabelStack ls{{42, 100}};
   EXPECT_EQ("LabelStack: [42, 100]", fmt::format("{}", ls));
 }
+
+TEST_F(NextHopApiTest, getAttributesInOneCall) {
+  auto nextHopId = createNextHop(ip4);
+  SaiIpNextHopTraits::CreateAttributes attrs{};
+  auto oneCall = nextHopApi->getAttributes(nextHopId, attrs);
+  EXPECT_EQ(1, multiAttributeGets);
+
+  auto perAttribute = nextHopApi->getAttribute(nextHopId, attrs);
+  EXPECT_EQ(
+      ip4, std::get<SaiIpNextHopTraits::Attributes::Ip>(oneCall).value());
+  EXPECT_EQ(perAttribute, oneCall);
+}
+
+TEST_F(NextHopApiTest, getAttributesBufferOverflowFallsBack) {
+  std::vector<sai_uint32_t> stack{1001, 2001, 3001};
+  auto nextHopId = createMplsNextHop(ip4, stack);
+  SaiMplsNextHopTraits::CreateAttributes attrs{};
+  // The combined get can't size the label stack, so it is redone attribute
+  // by attribute, reallocating the list on BUFFER_OVERFLOW.
+  auto fallback = nextHopApi->getAttributes(nextHopId, attrs);
+  EXPECT_EQ(1, multiAttributeGets);
+
+  auto perAttribute = nextHopApi->getAttribute(nextHopId, attrs);
+  EXPECT_EQ(
+      stack,
+      std::get<SaiMplsNextHopTraits::Attributes::LabelStack>(fallback)
+          .value());
+  EXPECT_EQ(
+      ip4, std::get<SaiMplsNextHopTraits::Attributes::Ip>(fallback).value());
+  EXPECT_EQ(perAttribute, fallback);
+}
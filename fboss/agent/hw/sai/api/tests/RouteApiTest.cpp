@@ -25,13 +25,64 @@ static constexpr folly::StringPiece str6 =
     "4242:4242:4242:4242:1234:1234:1234:1234";
 static constexpr folly::StringPiece strMac = "42:42:42:12:34:56";
 
+namespace {
+// Wraps the fake route get so tests can count combined gets and make the
+// adapter reject attributes it would otherwise support.
+int multiAttributeGets;
+bool metadataNotSupported;
+decltype(sai_route_api_t::get_route_entry_attribute) fakeGetRouteAttribute;
+
+sai_status_t getRouteAttribute(
+    const sai_route_entry_t* routeEntry,
+    uint32_t attrCount,
+    sai_attribute_t* attrList) {
+  if (attrCount > 1) {
+    ++multiAttributeGets;
+  }
+  for (uint32_t i = 0; metadataNotSupported && i < attrCount; ++i) {
+    if (attrList[i].id == SAI_ROUTE_ENTRY_ATTR_META_DATA) {
+      return SAI_STATUS_NOT_SUPPORTED;
+    }
+  }
+  return fakeGetRouteAttribute(routeEntry, attrCount, attrList);
+}
+} // namespace
+
 class RouteApiTest : public ::testing::Test {
  public:
   void SetUp() override {
     fs = FakeSai::getInstance();
     sai_api_initialize(0, nullptr);
     routeApi = std::make_unique<RouteApi>();
+    sai_api_query(SAI_API_ROUTE, reinterpret_cast<void**>(&fakeRouteApi));
+    fakeGetRouteAttribute = fakeRouteApi->get_route_entry_attribute;
+    fakeRouteApi->get_route_entry_attribute = &getRouteAttribute;
+    multiAttributeGets = 0;
+    metadataNotSupported = false;
+  }
+  void TearDown() override {
+    fakeRouteApi->get_route_entry_attribute = fakeGetRouteAttribute;
   }
+  SaiRouteTraits::RouteEntry createRouteWithMetadata() {
+    folly::CIDRNetwork prefix(ip4, 24);
+    SaiRouteTraits::RouteEntry r(0, 0, prefix);
+    SaiRouteTraits::Attributes::PacketAction packetActionAttribute{
+        SAI_PACKET_ACTION_FORWARD};
+    SaiRouteTraits::Attributes::NextHopId nextHopIdAttribute(5);
+    SaiRouteTraits::Attributes::Metadata metadataAttribute(42);
+    routeApi->create<SaiRouteTraits>(
+        r,
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+        {packetActionAttribute,
+         nextHopIdAttribute,
+         metadataAttribute,
+         std::nullopt});
+#else
+        {packetActionAttribute, nextHopIdAttribute, metadataAttribute});
+#endif
+    return r;
+  }
+  sai_route_api_t* fakeRouteApi;
   std::shared_ptr<FakeSai> fs;
   std::unique_ptr<RouteApi> routeApi;
   folly::IPAddress ip4{str4};
@@ -252,3 +303,68 @@ TEST(RouteEntryTest, serDeserv4) {
   EXPECT_EQ(
       r, SaiRouteTraits::RouteEntry::fromFollyDynamic(r.toFollyDynamic()));
 }
+
+TEST_F(RouteApiTest, getAttributesInOneCall) {
+  auto r = createRouteWithMetadata();
+  SaiRouteTraits::CreateAttributes attrs{};
+  auto oneCall = routeApi->getAttributes(r, attrs);
+  EXPECT_EQ(1, multiAttributeGets);
+
+  multiAttributeGets = 0;
+  auto perAttribute = routeApi->getAttribute(r, attrs);
+  EXPECT_EQ(0, multiAttributeGets);
+  EXPECT_EQ(
+      SAI_PACKET_ACTION_FORWARD,
+      std::get<SaiRouteTraits::Attributes::PacketAction>(oneCall).value());
+  EXPECT_EQ(
+      std::get<SaiRouteTraits::Attributes::PacketAction>(perAttribute),
+      std::get<SaiRouteTraits::Attributes::PacketAction>(oneCall));
+  EXPECT_EQ(
+      5,
+      std::get<std::optional<SaiRouteTraits::Attributes::NextHopId>>(oneCall)
+          ->value());
+  EXPECT_EQ(
+      std::get<std::optional<SaiRouteTraits::Attributes::NextHopId>>(
+          perAttribute),
+      std::get<std::optional<SaiRouteTraits::Attributes::NextHopId>>(oneCall));
+  EXPECT_EQ(
+      42,
+      std::get<std::optional<SaiRouteTraits::Attributes::Metadata>>(oneCall)
+          ->value());
+  EXPECT_EQ(
+      std::get<std::optional<SaiRouteTraits::Attributes::Metadata>>(
+          perAttribute),
+      std::get<std::optional<SaiRouteTraits::Attributes::Metadata>>(oneCall));
+}
+
+TEST_F(RouteApiTest, getAttributesNotSupportedFallsBack) {
+  auto r = createRouteWithMetadata();
+  metadataNotSupported = true;
+  SaiRouteTraits::CreateAttributes attrs{};
+  auto fallback = routeApi->getAttributes(r, attrs);
+  // The combined get was tried, failed and was redone attribute by attribute
+  EXPECT_EQ(1, multiAttributeGets);
+
+  auto perAttribute = routeApi->getAttribute(r, attrs);
+  EXPECT_EQ(
+      std::get<SaiRouteTraits::Attributes::PacketAction>(perAttribute),
+      std::get<SaiRouteTraits::Attributes::PacketAction>(fallback));
+  EXPECT_EQ(
+      5,
+      std::get<std::optional<SaiRouteTraits::Attributes::NextHopId>>(fallback)
+          ->value());
+  EXPECT_EQ(
+      std::get<std::optional<SaiRouteTraits::Attributes::NextHopId>>(
+          perAttribute),
+      std::get<std::optional<SaiRouteTraits::Attributes::NextHopId>>(
+          fallback));
+  // Unsupported optional attribute with a default getter is defaulted
+  auto metadata =
+      std::get<std::optional<SaiRouteTraits::Attributes::Metadata>>(fallback);
+  ASSERT_TRUE(metadata.has_value());
+  EXPECT_EQ(0, metadata->value());
+  EXPECT_EQ(
+      std::get<std::optional<SaiRouteTraits::Attributes::Metadata>>(
+          perAttribute),
+      metadata);
+}
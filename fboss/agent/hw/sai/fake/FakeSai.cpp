@@ -11,6 +11,15 @@
 
 #include <folly/FileUtil.h>
 #include <folly/Singleton.h>
+#include <gflags/gflags.h>
+
+#include <chrono>
+
+DEFINE_int32(
+    fake_sai_call_latency_us,
+    0,
+    "Artificial latency of route, next hop and next hop group writes "
+    "in fake SAI");
 
 namespace {
 struct singleton_tag_type {};
@@ -69,6 +78,22 @@ void FakeSai::clear() {
   fs->systemPortManager.clear();
 }
 
+namespace facebook::fboss {
+
+void fakeSaiCallLatency() {
+  if (FLAGS_fake_sai_call_latency_us <= 0) {
+    return;
+  }
+  // spin rather than sleep, sleeps are too coarse for usecs and an SDK call
+  // keeps the calling thread busy
+  auto until = std::chrono::steady_clock::now() +
+      std::chrono::microseconds(FLAGS_fake_sai_call_latency_us);
+  while (std::chrono::steady_clock::now() < until) {
+  }
+}
+
+} // namespace facebook::fboss
+
 sai_object_id_t FakeSai::getCpuPort() {
   return cpuPortId;
 }
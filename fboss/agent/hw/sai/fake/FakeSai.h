@@ -42,6 +42,7 @@
 #include "fboss/agent/hw/sai/fake/FakeSaiVlan.h"
 #include "fboss/agent/hw/sai/fake/FakeSaiWred.h"
 
+#include <atomic>
 #include <memory>
 #include <set>
 
@@ -109,12 +110,22 @@ struct FakeSai {
   FakeMacsecFlowManager macsecFlowManager;
   FakeSystemPortManager systemPortManager;
   bool initialized = false;
+  FakeHostifTxCallback hostifTxCallback;
+  std::atomic<uint64_t> hostifTxPackets{0};
+  std::atomic<uint64_t> hostifRxPackets{0};
   sai_object_id_t cpuPortId;
   sai_object_id_t cpuSystemPortId;
   sai_object_id_t getCpuPort();
   sai_object_id_t getCpuSystemPort();
 };
 
+/*
+ * Spins for --fake_sai_call_latency_us, so benchmarks against fake SAI see a
+ * per call cost closer to an ASIC SDK. Called from route, next hop and next
+ * hop group writes.
+ */
+void fakeSaiCallLatency();
+
 } // namespace facebook::fboss
 
 sai_status_t sai_api_initialize(
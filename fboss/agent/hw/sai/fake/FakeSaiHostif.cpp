@@ -11,6 +11,7 @@
 #include "fboss/agent/hw/sai/fake/FakeSai.h"
 
 #include <folly/logging/xlog.h>
+#include <array>
 #include <optional>
 
 using facebook::fboss::FakeHostifTrapGroupManager;
@@ -20,11 +21,11 @@ using facebook::fboss::FakeSai;
 
 sai_status_t send_hostif_fn(
     sai_object_id_t /* switch_id */,
-    sai_size_t /* buffer_size */,
-    const void* /* buffer */,
+    sai_size_t buffer_size,
+    const void* buffer,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
-  sai_object_id_t tx_port;
+  sai_object_id_t tx_port = SAI_NULL_OBJECT_ID;
   sai_hostif_tx_type_t tx_type;
   sai_uint8_t queueId = 0;
   for (int i = 0; i < attr_count; ++i) {
@@ -42,6 +43,11 @@ sai_status_t send_hostif_fn(
   }
   XLOG(DBG2) << "Sending packet on port : " << std::hex << tx_port
              << " tx type : " << tx_type << " on queue: " << queueId;
+  auto fs = FakeSai::getInstance();
+  fs->hostifTxPackets++;
+  if (fs->hostifTxCallback) {
+    fs->hostifTxCallback(tx_port, buffer, buffer_size);
+  }
 
   return SAI_STATUS_SUCCESS;
 }
@@ -318,4 +324,37 @@ void populate_hostif_api(sai_hostif_api_t** hostif_api) {
   *hostif_api = &_hostif_api;
 }
 
+void setFakeHostifTxCallback(FakeHostifTxCallback callback) {
+  FakeSai::getInstance()->hostifTxCallback = std::move(callback);
+}
+
+sai_status_t fakeHostifInjectRxPacket(
+    sai_object_id_t switchId,
+    sai_object_id_t ingressPort,
+    const void* buffer,
+    sai_size_t bufferSize,
+    uint8_t queueId,
+    sai_object_id_t trapId) {
+  auto fs = FakeSai::getInstance();
+  auto rxCallback = fs->switchManager.get(switchId).getPacketEventNotify();
+  if (!rxCallback) {
+    XLOG(ERR) << "No packet event notification registered on switch "
+              << switchId;
+    return SAI_STATUS_FAILURE;
+  }
+  std::array<sai_attribute_t, 3> attrs;
+  uint32_t attrCount = 0;
+  attrs[attrCount].id = SAI_HOSTIF_PACKET_ATTR_INGRESS_PORT;
+  attrs[attrCount++].value.oid = ingressPort;
+  attrs[attrCount].id = SAI_HOSTIF_PACKET_ATTR_EGRESS_QUEUE_INDEX;
+  attrs[attrCount++].value.u8 = queueId;
+  if (trapId != SAI_NULL_OBJECT_ID) {
+    attrs[attrCount].id = SAI_HOSTIF_PACKET_ATTR_HOSTIF_TRAP_ID;
+    attrs[attrCount++].value.oid = trapId;
+  }
+  fs->hostifRxPackets++;
+  rxCallback(switchId, bufferSize, buffer, attrCount, attrs.data());
+  return SAI_STATUS_SUCCESS;
+}
+
 } // namespace facebook::fboss
@@ -11,6 +11,8 @@
 
 #include "fboss/agent/hw/sai/fake/FakeManager.h"
 
+#include <functional>
+
 extern "C" {
 #include <sai.h>
 }
@@ -63,6 +65,31 @@ using FakeHostifUserDefinedTrapManager =
 using FakeHostifTrapGroupManager =
     FakeManager<sai_object_id_t, FakeHostifTrapGroup>;
 
+/*
+ * Called for every packet sent through send_hostif_packet, lets benchmarks
+ * and tests observe agent TX without an ASIC. Must be set before packets
+ * are sent, as it is invoked without synchronization.
+ */
+using FakeHostifTxCallback = std::function<void(
+    sai_object_id_t egressPort,
+    const void* buffer,
+    sai_size_t bufferSize)>;
+
+void setFakeHostifTxCallback(FakeHostifTxCallback callback);
+
+/*
+ * Deliver a packet to the packet event notification registered on switchId,
+ * as if it was trapped to CPU on ingressPort. Runs the callback on the
+ * calling thread, like an SDK rx thread would.
+ */
+sai_status_t fakeHostifInjectRxPacket(
+    sai_object_id_t switchId,
+    sai_object_id_t ingressPort,
+    const void* buffer,
+    sai_size_t bufferSize,
+    uint8_t queueId = 0,
+    sai_object_id_t trapId = SAI_NULL_OBJECT_ID);
+
 void populate_hostif_api(sai_hostif_api_t** hostif_api);
 
 } // namespace facebook::fboss
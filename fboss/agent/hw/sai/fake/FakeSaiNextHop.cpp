@@ -15,12 +15,14 @@
 
 using facebook::fboss::FakePort;
 using facebook::fboss::FakeSai;
+using facebook::fboss::fakeSaiCallLatency;
 
 sai_status_t create_next_hop_fn(
     sai_object_id_t* next_hop_id,
     sai_object_id_t /* switch_id */,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  fakeSaiCallLatency();
   auto fs = FakeSai::getInstance();
   std::optional<sai_next_hop_type_t> type;
   std::optional<folly::IPAddress> ip;
@@ -68,6 +70,7 @@ sai_status_t create_next_hop_fn(
 }
 
 sai_status_t remove_next_hop_fn(sai_object_id_t next_hop_id) {
+  fakeSaiCallLatency();
   auto fs = FakeSai::getInstance();
   fs->nextHopManager.remove(next_hop_id);
   return SAI_STATUS_SUCCESS;
@@ -76,6 +79,7 @@ sai_status_t remove_next_hop_fn(sai_object_id_t next_hop_id) {
 sai_status_t set_next_hop_attribute_fn(
     sai_object_id_t /* next_hop_id */,
     const sai_attribute_t* attr) {
+  fakeSaiCallLatency();
   switch (attr->id) {
     default:
       return SAI_STATUS_INVALID_PARAMETER;
@@ -17,12 +17,14 @@
 using facebook::fboss::FakeNextHopGroup;
 using facebook::fboss::FakeNextHopGroupMember;
 using facebook::fboss::FakeSai;
+using facebook::fboss::fakeSaiCallLatency;
 
 sai_status_t create_next_hop_group_fn(
     sai_object_id_t* next_hop_group_id,
     sai_object_id_t /* switch_id */,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  fakeSaiCallLatency();
   auto fs = FakeSai::getInstance();
   std::optional<int32_t> type;
   sai_object_id_t ars_id = SAI_NULL_OBJECT_ID;
@@ -50,6 +52,7 @@ sai_status_t create_next_hop_group_fn(
 }
 
 sai_status_t remove_next_hop_group_fn(sai_object_id_t next_hop_group_id) {
+  fakeSaiCallLatency();
   auto fs = FakeSai::getInstance();
   fs->nextHopGroupManager.remove(next_hop_group_id);
   return SAI_STATUS_SUCCESS;
@@ -92,6 +95,7 @@ sai_status_t get_next_hop_group_attribute_fn(
 sai_status_t set_next_hop_group_attribute_fn(
     sai_object_id_t next_hop_group_id,
     const sai_attribute_t* attr) {
+  fakeSaiCallLatency();
   auto fs = FakeSai::getInstance();
   auto& nextHopGroup = fs->nextHopGroupManager.get(next_hop_group_id);
   switch (attr->id) {
@@ -109,6 +113,7 @@ sai_status_t create_next_hop_group_member_fn(
     sai_object_id_t /* switch_id */,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  fakeSaiCallLatency();
   auto fs = FakeSai::getInstance();
   std::optional<sai_object_id_t> nextHopGroupId;
   std::optional<sai_object_id_t> nextHopId;
@@ -141,6 +146,7 @@ sai_status_t create_next_hop_group_member_fn(
 
 sai_status_t remove_next_hop_group_member_fn(
     sai_object_id_t next_hop_group_member_id) {
+  fakeSaiCallLatency();
   auto fs = FakeSai::getInstance();
   fs->nextHopGroupManager.removeMember(next_hop_group_member_id);
   return SAI_STATUS_SUCCESS;
@@ -176,6 +182,7 @@ sai_status_t get_next_hop_group_member_attribute_fn(
 sai_status_t set_next_hop_group_member_attribute_fn(
     sai_object_id_t next_hop_group_member_id,
     const sai_attribute_t* attr) {
+  fakeSaiCallLatency();
   auto fs = FakeSai::getInstance();
   auto& nextHopGroupMember =
       fs->nextHopGroupManager.getMember(next_hop_group_member_id);
@@ -195,6 +202,7 @@ sai_status_t set_next_hop_group_members_attribute_fn(
     const sai_attribute_t* attr_list,
     sai_bulk_op_error_mode_t /* mode */,
     sai_status_t* object_statuses) {
+  fakeSaiCallLatency();
   auto fs = FakeSai::getInstance();
   auto setMemberAttribute = [](auto& attr, auto& member) {
     switch (attr.id) {
@@ -14,8 +14,10 @@
 
 using facebook::fboss::FakeRoute;
 using facebook::fboss::FakeSai;
+using facebook::fboss::fakeSaiCallLatency;
 
-sai_status_t set_route_entry_attribute_fn(
+namespace {
+sai_status_t setRouteEntryAttribute(
     const sai_route_entry_t* route_entry,
     const sai_attribute_t* attr) {
   auto fs = FakeSai::getInstance();
@@ -42,11 +44,20 @@ sai_status_t set_route_entry_attribute_fn(
   }
   return SAI_STATUS_SUCCESS;
 }
+} // namespace
+
+sai_status_t set_route_entry_attribute_fn(
+    const sai_route_entry_t* route_entry,
+    const sai_attribute_t* attr) {
+  fakeSaiCallLatency();
+  return setRouteEntryAttribute(route_entry, attr);
+}
 
 sai_status_t create_route_entry_fn(
     const sai_route_entry_t* route_entry,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  fakeSaiCallLatency();
   auto fs = FakeSai::getInstance();
   auto re = std::make_tuple(
       route_entry->switch_id,
@@ -54,12 +65,13 @@ sai_status_t create_route_entry_fn(
       facebook::fboss::fromSaiIpPrefix(route_entry->destination));
   fs->routeManager.create(re);
   for (int i = 0; i < attr_count; ++i) {
-    set_route_entry_attribute_fn(route_entry, &attr_list[i]);
+    setRouteEntryAttribute(route_entry, &attr_list[i]);
   }
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_route_entry_fn(const sai_route_entry_t* route_entry) {
+  fakeSaiCallLatency();
   auto fs = FakeSai::getInstance();
   auto re = std::make_tuple(
       route_entry->switch_id,
@@ -207,11 +207,15 @@ sai_status_t set_switch_attribute_fn(
       return sw.setLed(attr);
     case SAI_SWITCH_ATTR_PORT_STATE_CHANGE_NOTIFY:
     case SAI_SWITCH_ATTR_FDB_EVENT_NOTIFY:
-    case SAI_SWITCH_ATTR_PACKET_EVENT_NOTIFY:
     case SAI_SWITCH_ATTR_TAM_EVENT_NOTIFY:
     case SAI_SWITCH_ATTR_QUEUE_PFC_DEADLOCK_NOTIFY:
       // No callback implementation in SAI
       break;
+    case SAI_SWITCH_ATTR_PACKET_EVENT_NOTIFY:
+      // Stored so tests can inject packets, see fakeHostifInjectRxPacket
+      sw.setPacketEventNotify(
+          reinterpret_cast<sai_packet_event_notification_fn>(attr->value.ptr));
+      break;
     case SAI_SWITCH_ATTR_COUNTER_REFRESH_INTERVAL:
       sw.setCounterRefreshInterval(attr->value.u32);
       break;
@@ -290,6 +290,14 @@ class FakeSwitch {
     return tamObjectId_;
   }
 
+  void setPacketEventNotify(sai_packet_event_notification_fn fn) {
+    packetEventNotify_ = fn;
+  }
+
+  sai_packet_event_notification_fn getPacketEventNotify() const {
+    return packetEventNotify_;
+  }
+
   sai_object_id_t id;
 
   sai_status_t setLed(const sai_attribute_t* attr);
@@ -343,6 +351,7 @@ class FakeSwitch {
   uint32_t creditWatchDogMs_{500};
   sai_packet_action_t pfcDlrPacketAction_{SAI_PACKET_ACTION_DROP};
   sai_object_id_t tamObjectId_{SAI_NULL_OBJECT_ID};
+  sai_packet_event_notification_fn packetEventNotify_{nullptr};
 };
 
 using FakeSwitchManager = FakeManager<sai_object_id_t, FakeSwitch>;
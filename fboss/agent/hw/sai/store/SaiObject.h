@@ -209,7 +209,7 @@ class SaiObject {
         SaiApiTable::getInstance()->getApi<typename SaiObjectTraits::SaiApiT>();
     // N.B., fills out attributes_ as a side effect
     // XXX TODO: side-effect mode does NOT work with optionals
-    attributes_ = api.getAttribute(adapterKey_, attributes_);
+    attributes_ = api.getAttributes(adapterKey_, attributes_);
     live_ = true;
     adapterHostKey_ =
         detail::adapterHostKey<SaiObjectTraits>(adapterKey_, attributes_);
@@ -227,7 +227,7 @@ class SaiObject {
         SaiApiTable::getInstance()->getApi<typename SaiObjectTraits::SaiApiT>();
     // N.B., fills out attributes_ as a side effect
     // XXX TODO: side-effect mode does NOT work with optionals
-    attributes_ = api.getAttribute(adapterKey_, attributes_);
+    attributes_ = api.getAttributes(adapterKey_, attributes_);
     live_ = true;
   }
 
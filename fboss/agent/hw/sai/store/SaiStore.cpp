@@ -10,6 +10,18 @@
 
 #include "fboss/agent/hw/sai/store/SaiStore.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
+#include <gflags/gflags.h>
+
+DEFINE_int32(
+    sai_store_reload_threads,
+    1,
+    "Number of threads used to reload object stores on warm boot. Stores are "
+    "reloaded serially by default; only set this above 1 if the SDK is known "
+    "to handle concurrent get calls.");
+
 namespace facebook::fboss {
 
 SaiStore::SaiStore() {}
@@ -27,18 +39,42 @@ void SaiStore::setSwitchId(sai_object_id_t switchId) {
 void SaiStore::reload(
     const folly::dynamic* adapterKeysJson,
     const folly::dynamic* adapterKeys2AdapterHostKeyJson) {
+  auto reloadStore = [adapterKeysJson,
+                      adapterKeys2AdapterHostKeyJson](auto& store) {
+    const folly::dynamic* adapterKeys = adapterKeysJson
+        ? adapterKeysJson->get_ptr(store.objectTypeName())
+        : nullptr;
+    const folly::dynamic* adapterHostKeys = adapterKeys2AdapterHostKeyJson
+        ? adapterKeys2AdapterHostKeyJson->get_ptr(store.objectTypeName())
+        : nullptr;
+
+    store.reload(adapterKeys, adapterHostKeys);
+  };
+  if (FLAGS_sai_store_reload_threads <= 1) {
+    tupleForEach(reloadStore, stores_);
+    return;
+  }
+  /*
+   * Object stores don't reference each other while reloading, so reload them
+   * concurrently. SAI calls are still serialized by SaiApiLock unless the
+   * adapter is thread safe, but reading attributes back into SaiObjects and
+   * building the per store maps is overlapped.
+   */
+  folly::CPUThreadPoolExecutor executor(
+      FLAGS_sai_store_reload_threads,
+      std::make_shared<folly::NamedThreadFactory>("SaiStoreReload"));
+  std::vector<folly::Future<folly::Unit>> futures;
+  futures.reserve(std::tuple_size_v<decltype(stores_)>);
   tupleForEach(
-      [adapterKeysJson, adapterKeys2AdapterHostKeyJson](auto& store) {
-        const folly::dynamic* adapterKeys = adapterKeysJson
-            ? adapterKeysJson->get_ptr(store.objectTypeName())
-            : nullptr;
-        const folly::dynamic* adapterHostKeys = adapterKeys2AdapterHostKeyJson
-            ? adapterKeys2AdapterHostKeyJson->get_ptr(store.objectTypeName())
-            : nullptr;
-
-        store.reload(adapterKeys, adapterHostKeys);
+      [&](auto& store) {
+        futures.push_back(folly::via(&executor, [&reloadStore, &store]() {
+          reloadStore(store);
+        }));
       },
       stores_);
+  for (auto& result : folly::collectAll(futures).get()) {
+    result.throwUnlessValue();
+  }
 }
 
 void SaiStore::release() {
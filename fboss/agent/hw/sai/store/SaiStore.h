@@ -31,6 +31,7 @@
 #include <optional>
 #include <sstream>
 #include <type_traits>
+#include <unordered_map>
 
 extern "C" {
 #include <sai.h>
@@ -166,8 +167,9 @@ class SaiObjectStore {
               }),
           keys.end());
     }
+    auto adapterHostKeys = getAdapterHostKeys(adapterKeys2AdapterHostKey);
     for (const auto& k : keys) {
-      ObjectType obj = getObject(k, adapterKeys2AdapterHostKey);
+      ObjectType obj = getObject(k, adapterHostKeys.get());
       auto adapterHostKey = obj.adapterHostKey();
       XLOGF(DBG5, "SaiStore reloaded {}", obj);
       auto ins = objects_.refOrInsert(adapterHostKey, std::move(obj));
@@ -427,9 +429,13 @@ class SaiObjectStore {
         });
   }
 
+  using AdapterHostKeyMap = std::unordered_map<
+      typename SaiObjectTraits::AdapterKey,
+      typename SaiObjectTraits::AdapterHostKey>;
+
   ObjectType getObject(
       typename ObjectTraits::AdapterKey key,
-      const folly::dynamic* adapterKey2AdapterHostKey) {
+      const AdapterHostKeyMap* adapterKey2AdapterHostKey) {
     if constexpr (!AdapterHostKeyWarmbootRecoverable<SaiObjectTraits>::value) {
       auto ahk = getAdapterHostKey(key, adapterKey2AdapterHostKey);
       if (ahk) {
@@ -499,17 +505,41 @@ class SaiObjectStore {
         : getObjectKeys<SaiObjectTraits>(saiSwitchId_.value());
   }
 
+  /*
+   * Decode the warm boot adapter key -> adapter host key json once, rather
+   * than stringifying every adapter key to look it up in the folly::dynamic.
+   * Only object types whose adapter host key can't be recovered from the
+   * adapter save these, and all of them are keyed by object id.
+   */
+  std::unique_ptr<AdapterHostKeyMap> getAdapterHostKeys(
+      const folly::dynamic* adapterKeys2AdapterHostKey) const {
+    if constexpr (!AdapterHostKeyWarmbootRecoverable<SaiObjectTraits>::value) {
+      if (!adapterKeys2AdapterHostKey) {
+        return nullptr;
+      }
+      auto adapterHostKeys = std::make_unique<AdapterHostKeyMap>();
+      adapterHostKeys->reserve(adapterKeys2AdapterHostKey->size());
+      for (const auto& [key, value] : adapterKeys2AdapterHostKey->items()) {
+        adapterHostKeys->emplace(
+            typename SaiObjectTraits::AdapterKey{
+                folly::to<sai_object_id_t>(key.asString())},
+            SaiObject<SaiObjectTraits>::follyDynamicToAdapterHostKey(value));
+      }
+      return adapterHostKeys;
+    } else {
+      return nullptr;
+    }
+  }
+
   std::optional<typename SaiObjectTraits::AdapterHostKey> getAdapterHostKey(
       const typename SaiObjectTraits::AdapterKey& key,
-      const folly::dynamic* adapterKeys2AdapterHostKey) {
+      const AdapterHostKeyMap* adapterKeys2AdapterHostKey) {
     if (!adapterKeys2AdapterHostKey) {
       return std::nullopt;
     }
-    auto iter = adapterKeys2AdapterHostKey->find(folly::to<std::string>(key));
-    CHECK(iter != adapterKeys2AdapterHostKey->items().end());
-
-    return SaiObject<SaiObjectTraits>::follyDynamicToAdapterHostKey(
-        iter->second);
+    auto iter = adapterKeys2AdapterHostKey->find(key);
+    CHECK(iter != adapterKeys2AdapterHostKey->end());
+    return iter->second;
   }
 
   std::optional<sai_object_id_t> saiSwitchId_;
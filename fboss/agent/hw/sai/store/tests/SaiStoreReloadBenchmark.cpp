@@ -0,0 +1,148 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/IPAddress.h>
+#include <gflags/gflags.h>
+
+#include "fboss/agent/hw/sai/api/NextHopApi.h"
+#include "fboss/agent/hw/sai/api/NextHopGroupApi.h"
+#include "fboss/agent/hw/sai/api/RouteApi.h"
+#include "fboss/agent/hw/sai/api/SaiApiTable.h"
+#include "fboss/agent/hw/sai/fake/FakeSai.h"
+#include "fboss/agent/hw/sai/store/SaiStore.h"
+
+DECLARE_int32(sai_store_reload_threads);
+
+DEFINE_int32(reload_bench_routes, 100000, "number of routes to reload");
+DEFINE_int32(reload_bench_next_hops, 1024, "number of next hops to reload");
+DEFINE_int32(reload_bench_ecmp_width, 64, "members per next hop group");
+
+using namespace facebook::fboss;
+
+namespace {
+
+constexpr sai_object_id_t kSwitchId = 0;
+constexpr sai_object_id_t kRouterInterfaceId = 42;
+
+struct WarmbootState {
+  folly::dynamic adapterKeys;
+  folly::dynamic adapterKeys2AdapterHostKeys;
+};
+
+folly::IPAddressV6 nthAddress(uint32_t base, uint32_t n) {
+  auto bytes = folly::IPAddressV6("2401:db00::").toByteArray();
+  bytes[4] = base;
+  bytes[12] = (n >> 24) & 0xff;
+  bytes[13] = (n >> 16) & 0xff;
+  bytes[14] = (n >> 8) & 0xff;
+  bytes[15] = n & 0xff;
+  return folly::IPAddressV6(bytes);
+}
+
+/*
+ * Program routes over next hop groups directly through the fake SAI, and
+ * return the adapter keys and adapter host keys a warm booting agent would
+ * have saved for them.
+ */
+const WarmbootState& warmbootState() {
+  static const WarmbootState state = []() {
+    FakeSai::getInstance();
+    auto saiApiTable = SaiApiTable::getInstance();
+    saiApiTable->queryApis(nullptr, saiApiTable->getFullApiList());
+
+    std::vector<NextHopSaiId> nextHops;
+    auto& nextHopApi = saiApiTable->nextHopApi();
+    for (auto i = 0; i < FLAGS_reload_bench_next_hops; ++i) {
+      nextHops.push_back(nextHopApi.create<SaiIpNextHopTraits>(
+          {SAI_NEXT_HOP_TYPE_IP,
+           kRouterInterfaceId,
+           folly::IPAddress(nthAddress(1, i)),
+           std::nullopt},
+          kSwitchId));
+    }
+
+    std::vector<NextHopGroupSaiId> nextHopGroups;
+    auto& nextHopGroupApi = saiApiTable->nextHopGroupApi();
+    auto numGroups = std::max(
+        1, FLAGS_reload_bench_next_hops / FLAGS_reload_bench_ecmp_width);
+    for (auto i = 0; i < numGroups; ++i) {
+      auto group = nextHopGroupApi.create<SaiNextHopGroupTraits>(
+          {SAI_NEXT_HOP_GROUP_TYPE_ECMP, std::nullopt}, kSwitchId);
+      for (auto j = 0; j < FLAGS_reload_bench_ecmp_width; ++j) {
+        auto nextHop = nextHops[(i + j) % nextHops.size()];
+        nextHopGroupApi.create<SaiNextHopGroupMemberTraits>(
+            {static_cast<sai_object_id_t>(group),
+             static_cast<sai_object_id_t>(nextHop),
+             1},
+            kSwitchId);
+      }
+      nextHopGroups.push_back(group);
+    }
+
+    auto& routeApi = saiApiTable->routeApi();
+    for (auto i = 0; i < FLAGS_reload_bench_routes; ++i) {
+      SaiRouteTraits::RouteEntry route(
+          kSwitchId, 0, folly::CIDRNetwork(nthAddress(2, i << 8), 120));
+      SaiRouteTraits::Attributes::NextHopId nextHopId{
+          static_cast<sai_object_id_t>(
+              nextHopGroups[i % nextHopGroups.size()])};
+      routeApi.create<SaiRouteTraits>(
+          route,
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+          {SAI_PACKET_ACTION_FORWARD, nextHopId, std::nullopt, std::nullopt}
+#else
+          {SAI_PACKET_ACTION_FORWARD, nextHopId, std::nullopt}
+#endif
+      );
+    }
+
+    SaiStore store(kSwitchId);
+    store.reload();
+    WarmbootState warmboot{
+        store.adapterKeysFollyDynamic(),
+        store.adapterKeys2AdapterHostKeysFollyDynamic()};
+    store.exitForWarmBoot();
+    return warmboot;
+  }();
+  return state;
+}
+
+void reloadStore(unsigned iters, int threads) {
+  folly::BenchmarkSuspender suspender;
+  const auto& state = warmbootState();
+  auto prevThreads = FLAGS_sai_store_reload_threads;
+  FLAGS_sai_store_reload_threads = threads;
+  for (unsigned i = 0; i < iters; ++i) {
+    SaiStore store(kSwitchId);
+    suspender.dismiss();
+    store.reload(&state.adapterKeys, &state.adapterKeys2AdapterHostKeys);
+    suspender.rehire();
+    // Keep the objects in the fake SAI for the next iteration
+    store.exitForWarmBoot();
+  }
+  FLAGS_sai_store_reload_threads = prevThreads;
+}
+
+} // namespace
+
+BENCHMARK(SaiStoreReloadSerial, n) {
+  reloadStore(n, 1);
+}
+
+BENCHMARK_RELATIVE(SaiStoreReloadParallel, n) {
+  reloadStore(n, 8);
+}
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
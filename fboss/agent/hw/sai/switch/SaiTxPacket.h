@@ -18,8 +18,7 @@ namespace facebook::fboss {
 class SaiTxPacket : public TxPacket {
  public:
   explicit SaiTxPacket(uint32_t size) {
-    buf_ = folly::IOBuf::createCombined(size);
-    buf_->append(size);
+    allocatePooledBuf(size);
   }
 };
 
@@ -31,8 +31,21 @@ sai_status_t wrap_create_fdb_entry(
     const sai_fdb_entry_t* fdb_entry,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  auto recorder = SaiRecorder::getInstance();
+  auto recordBegin =
+      recorder ? SaiRecorder::now() : SaiRecorder::Clock::time_point();
   auto rv = SaiTracer::getInstance()->fdbApi_->create_fdb_entry(
       fdb_entry, attr_count, attr_list);
+  if (recorder) {
+    recorder->recordEntry(
+        SaiRecordedOp::CREATE,
+        SAI_OBJECT_TYPE_FDB_ENTRY,
+        fdb_entry,
+        attr_count,
+        attr_list,
+        rv,
+        recordBegin);
+  }
 
   SaiTracer::getInstance()->logFdbEntryCreateFn(
       fdb_entry, attr_count, attr_list, rv);
@@ -40,7 +53,20 @@ sai_status_t wrap_create_fdb_entry(
 }
 
 sai_status_t wrap_remove_fdb_entry(const sai_fdb_entry_t* fdb_entry) {
+  auto recorder = SaiRecorder::getInstance();
+  auto recordBegin =
+      recorder ? SaiRecorder::now() : SaiRecorder::Clock::time_point();
   auto rv = SaiTracer::getInstance()->fdbApi_->remove_fdb_entry(fdb_entry);
+  if (recorder) {
+    recorder->recordEntry(
+        SaiRecordedOp::REMOVE,
+        SAI_OBJECT_TYPE_FDB_ENTRY,
+        fdb_entry,
+        0,
+        nullptr,
+        rv,
+        recordBegin);
+  }
 
   SaiTracer::getInstance()->logFdbEntryRemoveFn(fdb_entry, rv);
   return rv;
@@ -49,8 +75,21 @@ sai_status_t wrap_remove_fdb_entry(const sai_fdb_entry_t* fdb_entry) {
 sai_status_t wrap_set_fdb_entry_attribute(
     const sai_fdb_entry_t* fdb_entry,
     const sai_attribute_t* attr) {
+  auto recorder = SaiRecorder::getInstance();
+  auto recordBegin =
+      recorder ? SaiRecorder::now() : SaiRecorder::Clock::time_point();
   auto rv = SaiTracer::getInstance()->fdbApi_->set_fdb_entry_attribute(
       fdb_entry, attr);
+  if (recorder) {
+    recorder->recordEntry(
+        SaiRecordedOp::SET_ATTRIBUTE,
+        SAI_OBJECT_TYPE_FDB_ENTRY,
+        fdb_entry,
+        1,
+        attr,
+        rv,
+        recordBegin);
+  }
 
   SaiTracer::getInstance()->logFdbEntrySetAttrFn(fdb_entry, attr, rv);
   return rv;
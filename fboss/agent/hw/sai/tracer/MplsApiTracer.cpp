@@ -31,8 +31,21 @@ sai_status_t wrap_create_inseg_entry(
     const sai_inseg_entry_t* inseg_entry,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  auto recorder = SaiRecorder::getInstance();
+  auto recordBegin =
+      recorder ? SaiRecorder::now() : SaiRecorder::Clock::time_point();
   auto rv = SaiTracer::getInstance()->mplsApi_->create_inseg_entry(
       inseg_entry, attr_count, attr_list);
+  if (recorder) {
+    recorder->recordEntry(
+        SaiRecordedOp::CREATE,
+        SAI_OBJECT_TYPE_INSEG_ENTRY,
+        inseg_entry,
+        attr_count,
+        attr_list,
+        rv,
+        recordBegin);
+  }
 
   SaiTracer::getInstance()->logInsegEntryCreateFn(
       inseg_entry, attr_count, attr_list, rv);
@@ -40,7 +53,20 @@ sai_status_t wrap_create_inseg_entry(
 }
 
 sai_status_t wrap_remove_inseg_entry(const sai_inseg_entry_t* inseg_entry) {
+  auto recorder = SaiRecorder::getInstance();
+  auto recordBegin =
+      recorder ? SaiRecorder::now() : SaiRecorder::Clock::time_point();
   auto rv = SaiTracer::getInstance()->mplsApi_->remove_inseg_entry(inseg_entry);
+  if (recorder) {
+    recorder->recordEntry(
+        SaiRecordedOp::REMOVE,
+        SAI_OBJECT_TYPE_INSEG_ENTRY,
+        inseg_entry,
+        0,
+        nullptr,
+        rv,
+        recordBegin);
+  }
 
   SaiTracer::getInstance()->logInsegEntryRemoveFn(inseg_entry, rv);
   return rv;
@@ -49,8 +75,21 @@ sai_status_t wrap_remove_inseg_entry(const sai_inseg_entry_t* inseg_entry) {
 sai_status_t wrap_set_inseg_entry_attribute(
     const sai_inseg_entry_t* inseg_entry,
     const sai_attribute_t* attr) {
+  auto recorder = SaiRecorder::getInstance();
+  auto recordBegin =
+      recorder ? SaiRecorder::now() : SaiRecorder::Clock::time_point();
   auto rv = SaiTracer::getInstance()->mplsApi_->set_inseg_entry_attribute(
       inseg_entry, attr);
+  if (recorder) {
+    recorder->recordEntry(
+        SaiRecordedOp::SET_ATTRIBUTE,
+        SAI_OBJECT_TYPE_INSEG_ENTRY,
+        inseg_entry,
+        1,
+        attr,
+        rv,
+        recordBegin);
+  }
 
   SaiTracer::getInstance()->logInsegEntrySetAttrFn(inseg_entry, attr, rv);
   return rv;
@@ -33,8 +33,21 @@ sai_status_t wrap_create_neighbor_entry(
     const sai_neighbor_entry_t* neighbor_entry,
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
+  auto recorder = SaiRecorder::getInstance();
+  auto recordBegin =
+      recorder ? SaiRecorder::now() : SaiRecorder::Clock::time_point();
   auto rv = SaiTracer::getInstance()->neighborApi_->create_neighbor_entry(
       neighbor_entry, attr_count, attr_list);
+  if (recorder) {
+    recorder->recordEntry(
+        SaiRecordedOp::CREATE,
+        SAI_OBJECT_TYPE_NEIGHBOR_ENTRY,
+        neighbor_entry,
+        attr_count,
+        attr_list,
+        rv,
+        recordBegin);
+  }
 
   SaiTracer::getInstance()->logNeighborEntryCreateFn(
       neighbor_entry, attr_count, attr_list, rv);
@@ -43,8 +56,21 @@ sai_status_t wrap_create_neighbor_entry(
 
 sai_status_t wrap_remove_neighbor_entry(
     const sai_neighbor_entry_t* neighbor_entry) {
+  auto recorder = SaiRecorder::getInstance();
+  auto recordBegin =
+      recorder ? SaiRecorder::now() : SaiRecorder::Clock::time_point();
   auto rv = SaiTracer::getInstance()->neighborApi_->remove_neighbor_entry(
       neighbor_entry);
+  if (recorder) {
+    recorder->recordEntry(
+        SaiRecordedOp::REMOVE,
+        SAI_OBJECT_TYPE_NEIGHBOR_ENTRY,
+        neighbor_entry,
+        0,
+        nullptr,
+        rv,
+        recordBegin);
+  }
 
   SaiTracer::getInstance()->logNeighborEntryRemoveFn(neighbor_entry, rv);
   return rv;
@@ -53,9 +79,22 @@ sai_status_t wrap_remove_neighbor_entry(
 sai_status_t wrap_set_neighbor_entry_attribute(
     const sai_neighbor_entry_t* neighbor_entry,
     const sai_attribute_t* attr) {
+  auto recorder = SaiRecorder::getInstance();
+  auto recordBegin =
+      recorder ? SaiRecorder::now() : SaiRecorder::Clock::time_point();
   auto rv =
       SaiTracer::getInstance()->neighborApi_->set_neighbor_entry_attribute(
           neighbor_entry, attr);
+  if (recorder) {
+    recorder->recordEntry(
+        SaiRecordedOp::SET_ATTRIBUTE,
+        SAI_OBJECT_TYPE_NEIGHBOR_ENTRY,
+        neighbor_entry,
+        1,
+        attr,
+        rv,
+        recordBegin);
+  }
 
   SaiTracer::getInstance()->logNeighborEntrySetAttrFn(neighbor_entry, attr, rv);
   return rv;
@@ -39,8 +39,21 @@ sai_status_t wrap_create_route_entry(
   auto begin = FLAGS_enable_elapsed_time_log
       ? std::chrono::system_clock::now()
       : std::chrono::system_clock::time_point::min();
+  auto recorder = SaiRecorder::getInstance();
+  auto recordBegin =
+      recorder ? SaiRecorder::now() : SaiRecorder::Clock::time_point();
   auto rv = SaiTracer::getInstance()->routeApi_->create_route_entry(
       route_entry, attr_count, attr_list);
+  if (recorder) {
+    recorder->recordEntry(
+        SaiRecordedOp::CREATE,
+        SAI_OBJECT_TYPE_ROUTE_ENTRY,
+        route_entry,
+        attr_count,
+        attr_list,
+        rv,
+        recordBegin);
+  }
   SaiTracer::getInstance()->logPostInvocation(rv, SAI_NULL_OBJECT_ID, begin);
   return rv;
 }
@@ -50,8 +63,21 @@ sai_status_t wrap_remove_route_entry(const sai_route_entry_t* route_entry) {
   auto begin = FLAGS_enable_elapsed_time_log
       ? std::chrono::system_clock::now()
       : std::chrono::system_clock::time_point::min();
+  auto recorder = SaiRecorder::getInstance();
+  auto recordBegin =
+      recorder ? SaiRecorder::now() : SaiRecorder::Clock::time_point();
   auto rv =
       SaiTracer::getInstance()->routeApi_->remove_route_entry(route_entry);
+  if (recorder) {
+    recorder->recordEntry(
+        SaiRecordedOp::REMOVE,
+        SAI_OBJECT_TYPE_ROUTE_ENTRY,
+        route_entry,
+        0,
+        nullptr,
+        rv,
+        recordBegin);
+  }
   SaiTracer::getInstance()->logPostInvocation(rv, SAI_NULL_OBJECT_ID, begin);
   return rv;
 }
@@ -63,8 +89,21 @@ sai_status_t wrap_set_route_entry_attribute(
   auto begin = FLAGS_enable_elapsed_time_log
       ? std::chrono::system_clock::now()
       : std::chrono::system_clock::time_point::min();
+  auto recorder = SaiRecorder::getInstance();
+  auto recordBegin =
+      recorder ? SaiRecorder::now() : SaiRecorder::Clock::time_point();
   auto rv = SaiTracer::getInstance()->routeApi_->set_route_entry_attribute(
       route_entry, attr);
+  if (recorder) {
+    recorder->recordEntry(
+        SaiRecordedOp::SET_ATTRIBUTE,
+        SAI_OBJECT_TYPE_ROUTE_ENTRY,
+        route_entry,
+        1,
+        attr,
+        rv,
+        recordBegin);
+  }
   SaiTracer::getInstance()->logPostInvocation(rv, SAI_NULL_OBJECT_ID, begin);
   return rv;
 }
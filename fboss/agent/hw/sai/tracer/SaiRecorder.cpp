@@ -0,0 +1,231 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/tracer/SaiRecorder.h"
+
+#include <fcntl.h>
+#include <folly/FileUtil.h>
+#include <folly/Singleton.h>
+#include <folly/String.h>
+#include <folly/logging/xlog.h>
+
+DEFINE_string(
+    sai_recorder_file,
+    "",
+    "Record the SAI calls made by the agent, and how long each took, to this "
+    "file for sai_recording_replayer. Disabled if empty.");
+
+namespace {
+
+constexpr size_t kFlushSize = 1 << 20;
+// Recording is disabled rather than buffering more than this many full
+// buffers for a writer thread that can't keep up
+constexpr size_t kMaxQueuedBuffers = 64;
+
+folly::Singleton<facebook::fboss::SaiRecorder> _saiRecorder([]() {
+  return new facebook::fboss::SaiRecorder(FLAGS_sai_recorder_file);
+});
+
+facebook::fboss::SaiRecordedAttribute unsupportedAttribute(
+    sai_object_type_t /*objectType*/,
+    const sai_attribute_t& attr) {
+  facebook::fboss::SaiRecordedAttribute recorded;
+  recorded.id = attr.id;
+  recorded.kind = facebook::fboss::SaiRecordedValueKind::UNSUPPORTED;
+  return recorded;
+}
+
+std::atomic<facebook::fboss::SaiRecorder::AttributeRecorder>
+    attributeRecorder{&unsupportedAttribute};
+
+} // namespace
+
+namespace facebook::fboss {
+
+SaiRecorder::SaiRecorder(const std::string& path) : path_(path) {
+  try {
+    file_ = folly::File(path_, O_WRONLY | O_CREAT | O_TRUNC);
+    buffer_ = saiRecordingHeader();
+  } catch (const std::system_error& ex) {
+    disableLocked(ex.what());
+  }
+  writer_ = std::thread([this]() { writeBuffers(); });
+}
+
+SaiRecorder::~SaiRecorder() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queueBufferLocked();
+    stopping_ = true;
+  }
+  bufferQueued_.notify_one();
+  writer_.join();
+}
+
+void SaiRecorder::setAttributeRecorder(AttributeRecorder recorder) {
+  attributeRecorder.store(recorder, std::memory_order_release);
+}
+
+std::shared_ptr<SaiRecorder> SaiRecorder::getInstance() {
+  if (FLAGS_sai_recorder_file.empty()) {
+    return nullptr;
+  }
+  return _saiRecorder.try_get();
+}
+
+void SaiRecorder::recordCreate(
+    sai_object_type_t objectType,
+    sai_object_id_t objectId,
+    sai_object_id_t switchId,
+    uint32_t attrCount,
+    const sai_attribute_t* attrList,
+    sai_status_t rv,
+    Clock::time_point begin) {
+  record(
+      SaiRecordedOp::CREATE,
+      objectType,
+      objectId,
+      switchId,
+      folly::ByteRange(),
+      attrCount,
+      attrList,
+      rv,
+      begin);
+}
+
+void SaiRecorder::recordRemove(
+    sai_object_type_t objectType,
+    sai_object_id_t objectId,
+    sai_status_t rv,
+    Clock::time_point begin) {
+  record(
+      SaiRecordedOp::REMOVE,
+      objectType,
+      objectId,
+      SAI_NULL_OBJECT_ID,
+      folly::ByteRange(),
+      0,
+      nullptr,
+      rv,
+      begin);
+}
+
+void SaiRecorder::recordSetAttribute(
+    sai_object_type_t objectType,
+    sai_object_id_t objectId,
+    const sai_attribute_t* attr,
+    sai_status_t rv,
+    Clock::time_point begin) {
+  record(
+      SaiRecordedOp::SET_ATTRIBUTE,
+      objectType,
+      objectId,
+      SAI_NULL_OBJECT_ID,
+      folly::ByteRange(),
+      1,
+      attr,
+      rv,
+      begin);
+}
+
+void SaiRecorder::record(
+    SaiRecordedOp op,
+    sai_object_type_t objectType,
+    sai_object_id_t objectId,
+    sai_object_id_t switchId,
+    folly::ByteRange entry,
+    uint32_t attrCount,
+    const sai_attribute_t* attrList,
+    sai_status_t rv,
+    Clock::time_point begin) {
+  auto end = Clock::now();
+  if (!isRecording()) {
+    return;
+  }
+  SaiRecordedCall call;
+  call.op = op;
+  call.objectType = objectType;
+  call.objectId = objectId;
+  call.switchId = switchId;
+  call.entry.assign(entry.begin(), entry.end());
+  call.status = rv;
+  call.start = begin - start_;
+  call.duration = end - begin;
+  call.attributes.reserve(attrCount);
+  auto recordAttribute = attributeRecorder.load(std::memory_order_acquire);
+  for (uint32_t i = 0; i < attrCount; ++i) {
+    call.attributes.push_back(recordAttribute(objectType, attrList[i]));
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!isRecording()) {
+    return;
+  }
+  appendSaiRecordedCall(call, buffer_);
+  if (buffer_.size() >= kFlushSize) {
+    queueBufferLocked();
+  }
+}
+
+void SaiRecorder::flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  queueBufferLocked();
+  buffersWritten_.wait(
+      lock, [this]() { return fullBuffers_.empty() && !writing_; });
+}
+
+void SaiRecorder::queueBufferLocked() {
+  if (buffer_.empty() || !isRecording()) {
+    return;
+  }
+  if (fullBuffers_.size() >= kMaxQueuedBuffers) {
+    disableLocked("writing the recording can't keep up");
+    return;
+  }
+  fullBuffers_.push_back(std::move(buffer_));
+  buffer_.clear();
+  bufferQueued_.notify_one();
+}
+
+void SaiRecorder::disableLocked(const std::string& reason) {
+  XLOG(ERR) << "Disabling SAI recording to " << path_ << ": " << reason;
+  disabled_.store(true, std::memory_order_relaxed);
+  buffer_.clear();
+  fullBuffers_.clear();
+  buffersWritten_.notify_all();
+}
+
+void SaiRecorder::writeBuffers() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    bufferQueued_.wait(
+        lock, [this]() { return stopping_ || !fullBuffers_.empty(); });
+    if (fullBuffers_.empty()) {
+      // Stopping, and everything has been written
+      return;
+    }
+    auto buffer = std::move(fullBuffers_.front());
+    fullBuffers_.pop_front();
+    writing_ = true;
+    lock.unlock();
+    auto written = folly::writeFull(file_.fd(), buffer.data(), buffer.size());
+    auto error = errno;
+    lock.lock();
+    writing_ = false;
+    if (written < 0) {
+      disableLocked(folly::errnoStr(error));
+    }
+    if (fullBuffers_.empty()) {
+      buffersWritten_.notify_all();
+    }
+  }
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,151 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <folly/File.h>
+#include <folly/Range.h>
+#include <gflags/gflags.h>
+
+#include "fboss/agent/hw/sai/tracer/SaiRecording.h"
+
+DECLARE_string(sai_recorder_file);
+
+namespace facebook::fboss {
+
+/*
+ * Records every create, remove and set call going through the tracer's API
+ * wrappers, along with how long the SAI adapter took to serve it, into a
+ * binary recording (see SaiRecording.h). Runs independently of the C code
+ * replayer log and is much cheaper, so it can be left on for a production
+ * run whose programming performance should be reproduced offline.
+ *
+ * Calls are appended to an in memory buffer, and full buffers are written
+ * out by a writer thread, so recording never does file I/O on the SAI
+ * programming path. If the recording can't be written, recording is
+ * disabled with an error log rather than failing the SAI call.
+ */
+class SaiRecorder {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit SaiRecorder(const std::string& path);
+  ~SaiRecorder();
+
+  // nullptr unless --sai_recorder_file is set
+  static std::shared_ptr<SaiRecorder> getInstance();
+
+  /*
+   * How an attribute is recorded depends on its type, which only the
+   * tracer's attribute maps know. SaiTracer sets this when it is created,
+   * until then attributes are recorded as UNSUPPORTED.
+   */
+  using AttributeRecorder =
+      SaiRecordedAttribute (*)(sai_object_type_t, const sai_attribute_t&);
+  static void setAttributeRecorder(AttributeRecorder recorder);
+
+  static Clock::time_point now() {
+    return Clock::now();
+  }
+
+  void recordCreate(
+      sai_object_type_t objectType,
+      sai_object_id_t objectId,
+      sai_object_id_t switchId,
+      uint32_t attrCount,
+      const sai_attribute_t* attrList,
+      sai_status_t rv,
+      Clock::time_point begin);
+
+  void recordRemove(
+      sai_object_type_t objectType,
+      sai_object_id_t objectId,
+      sai_status_t rv,
+      Clock::time_point begin);
+
+  void recordSetAttribute(
+      sai_object_type_t objectType,
+      sai_object_id_t objectId,
+      const sai_attribute_t* attr,
+      sai_status_t rv,
+      Clock::time_point begin);
+
+  // Route, neighbor, fdb and inseg entries, keyed by the entry itself
+  template <typename EntryT>
+  void recordEntry(
+      SaiRecordedOp op,
+      sai_object_type_t objectType,
+      const EntryT* entry,
+      uint32_t attrCount,
+      const sai_attribute_t* attrList,
+      sai_status_t rv,
+      Clock::time_point begin) {
+    record(
+        op,
+        objectType,
+        SAI_NULL_OBJECT_ID,
+        entry->switch_id,
+        folly::ByteRange(
+            reinterpret_cast<const uint8_t*>(entry), sizeof(EntryT)),
+        attrCount,
+        attrList,
+        rv,
+        begin);
+  }
+
+  // Writes out everything recorded so far
+  void flush();
+
+  // False once recording was disabled because of an error
+  bool isRecording() const {
+    return !disabled_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  void record(
+      SaiRecordedOp op,
+      sai_object_type_t objectType,
+      sai_object_id_t objectId,
+      sai_object_id_t switchId,
+      folly::ByteRange entry,
+      uint32_t attrCount,
+      const sai_attribute_t* attrList,
+      sai_status_t rv,
+      Clock::time_point begin);
+
+  // Hands buffer_ to the writer thread
+  void queueBufferLocked();
+  void disableLocked(const std::string& reason);
+  void writeBuffers();
+
+  const Clock::time_point start_{Clock::now()};
+  const std::string path_;
+  folly::File file_;
+  std::atomic<bool> disabled_{false};
+  std::mutex mutex_;
+  std::condition_variable bufferQueued_;
+  std::condition_variable buffersWritten_;
+  std::string buffer_;
+  // Full buffers waiting for the writer thread
+  std::deque<std::string> fullBuffers_;
+  bool writing_{false};
+  bool stopping_{false};
+  std::thread writer_;
+};
+
+} // namespace facebook::fboss
@@ -0,0 +1,159 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/tracer/SaiRecording.h"
+
+#include <cstring>
+#include <type_traits>
+
+#include <folly/FileUtil.h>
+
+#include "fboss/agent/FbossError.h"
+
+namespace {
+
+constexpr folly::StringPiece kMagic{"FBSAIREC"};
+constexpr uint32_t kVersion = 1;
+
+template <typename T>
+void append(const T& value, std::string& out) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+class RecordingReader {
+ public:
+  explicit RecordingReader(folly::ByteRange data) : data_(data) {}
+
+  bool done() const {
+    return data_.empty();
+  }
+
+  template <typename T>
+  T read() {
+    static_assert(std::is_trivially_copyable_v<T>);
+    T value;
+    std::memcpy(&value, take(sizeof(T)).data(), sizeof(T));
+    return value;
+  }
+
+  std::vector<uint8_t> readBytes(size_t size) {
+    auto bytes = take(size);
+    return std::vector<uint8_t>(bytes.begin(), bytes.end());
+  }
+
+ private:
+  folly::ByteRange take(size_t size) {
+    if (data_.size() < size) {
+      throw facebook::fboss::FbossError(
+          "Truncated SAI recording, needed ",
+          size,
+          " bytes but only ",
+          data_.size(),
+          " are left");
+    }
+    auto bytes = data_.subpiece(0, size);
+    data_.advance(size);
+    return bytes;
+  }
+
+  folly::ByteRange data_;
+};
+
+bool hasElements(facebook::fboss::SaiRecordedValueKind kind) {
+  return kind == facebook::fboss::SaiRecordedValueKind::OBJECT_LIST ||
+      kind == facebook::fboss::SaiRecordedValueKind::LIST;
+}
+
+} // namespace
+
+namespace facebook::fboss {
+
+std::string saiRecordingHeader() {
+  std::string header = kMagic.str();
+  append(kVersion, header);
+  append(static_cast<uint32_t>(sizeof(sai_attribute_value_t)), header);
+  return header;
+}
+
+void appendSaiRecordedCall(const SaiRecordedCall& call, std::string& out) {
+  append(call.op, out);
+  append(static_cast<uint32_t>(call.objectType), out);
+  append(call.objectId, out);
+  append(call.switchId, out);
+  append(static_cast<uint32_t>(call.entry.size()), out);
+  out.append(
+      reinterpret_cast<const char*>(call.entry.data()), call.entry.size());
+  append(call.status, out);
+  append(static_cast<int64_t>(call.start.count()), out);
+  append(static_cast<int64_t>(call.duration.count()), out);
+  append(static_cast<uint32_t>(call.attributes.size()), out);
+  for (const auto& attr : call.attributes) {
+    append(attr.id, out);
+    append(attr.kind, out);
+    if (hasElements(attr.kind)) {
+      append(attr.elementSize, out);
+      append(static_cast<uint32_t>(attr.elements.size()), out);
+      out.append(
+          reinterpret_cast<const char*>(attr.elements.data()),
+          attr.elements.size());
+    } else if (attr.kind != SaiRecordedValueKind::UNSUPPORTED) {
+      append(attr.value, out);
+    }
+  }
+}
+
+std::vector<SaiRecordedCall> parseSaiRecording(folly::ByteRange recording) {
+  auto header = saiRecordingHeader();
+  if (recording.size() < header.size() ||
+      std::memcmp(recording.data(), header.data(), header.size()) != 0) {
+    throw FbossError(
+        "Not a SAI recording, or recorded against different SAI headers");
+  }
+  recording.advance(header.size());
+
+  std::vector<SaiRecordedCall> calls;
+  RecordingReader reader(recording);
+  while (!reader.done()) {
+    SaiRecordedCall call;
+    call.op = reader.read<SaiRecordedOp>();
+    call.objectType = static_cast<sai_object_type_t>(reader.read<uint32_t>());
+    call.objectId = reader.read<sai_object_id_t>();
+    call.switchId = reader.read<sai_object_id_t>();
+    call.entry = reader.readBytes(reader.read<uint32_t>());
+    call.status = reader.read<sai_status_t>();
+    call.start = std::chrono::nanoseconds(reader.read<int64_t>());
+    call.duration = std::chrono::nanoseconds(reader.read<int64_t>());
+    auto attrCount = reader.read<uint32_t>();
+    call.attributes.resize(attrCount);
+    for (auto& attr : call.attributes) {
+      attr.id = reader.read<sai_attr_id_t>();
+      attr.kind = reader.read<SaiRecordedValueKind>();
+      if (hasElements(attr.kind)) {
+        attr.elementSize = reader.read<uint32_t>();
+        attr.elements = reader.readBytes(reader.read<uint32_t>());
+      } else if (attr.kind != SaiRecordedValueKind::UNSUPPORTED) {
+        attr.value = reader.read<sai_attribute_value_t>();
+      }
+    }
+    calls.push_back(std::move(call));
+  }
+  return calls;
+}
+
+std::vector<SaiRecordedCall> readSaiRecording(const std::string& path) {
+  std::string recording;
+  if (!folly::readFile(path.c_str(), recording)) {
+    throw FbossError("Failed to read SAI recording ", path);
+  }
+  return parseSaiRecording(folly::ByteRange(folly::StringPiece(recording)));
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <folly/Range.h>
+
+extern "C" {
+#include <sai.h>
+}
+
+namespace facebook::fboss {
+
+/*
+ * Binary recording of the SAI calls an agent made, written by SaiRecorder
+ * and replayed by SaiRecordingReplayer. Unlike the replayer log, which is C
+ * code that has to be compiled per trace, a recording is read back as data,
+ * so the same harness can replay any recording against any SAI adapter.
+ *
+ * A recording is only meant to be read by binaries built against the same
+ * SAI headers as the agent which wrote it: attribute values are stored as
+ * raw sai_attribute_value_t, and the header records its size so a mismatch
+ * is caught on read.
+ */
+
+enum class SaiRecordedOp : uint8_t {
+  CREATE = 0,
+  REMOVE = 1,
+  SET_ATTRIBUTE = 2,
+};
+
+/*
+ * What the replayer has to fix up in a recorded attribute value. Object ids
+ * are remapped to the ids handed out by the replay target, lists get their
+ * pointer rebuilt from the recorded elements, everything else is copied.
+ */
+enum class SaiRecordedValueKind : uint8_t {
+  VALUE = 0,
+  OBJECT_ID = 1,
+  OBJECT_LIST = 2,
+  LIST = 3,
+  ACL_FIELD_OBJECT_ID = 4,
+  ACL_ACTION_OBJECT_ID = 5,
+  // Attribute type the recorder does not know how to copy, not replayed
+  UNSUPPORTED = 6,
+};
+
+struct SaiRecordedAttribute {
+  sai_attr_id_t id{0};
+  SaiRecordedValueKind kind{SaiRecordedValueKind::VALUE};
+  sai_attribute_value_t value{};
+  // Elements of OBJECT_LIST and LIST values
+  uint32_t elementSize{0};
+  std::vector<uint8_t> elements;
+};
+
+struct SaiRecordedCall {
+  SaiRecordedOp op{SaiRecordedOp::CREATE};
+  sai_object_type_t objectType{SAI_OBJECT_TYPE_NULL};
+  // Created, removed or modified object, SAI_NULL_OBJECT_ID for entries
+  sai_object_id_t objectId{SAI_NULL_OBJECT_ID};
+  sai_object_id_t switchId{SAI_NULL_OBJECT_ID};
+  // sai_route_entry_t, sai_neighbor_entry_t etc. for entry object types
+  std::vector<uint8_t> entry;
+  std::vector<SaiRecordedAttribute> attributes;
+  sai_status_t status{SAI_STATUS_SUCCESS};
+  // Since the first recorded call
+  std::chrono::nanoseconds start{0};
+  std::chrono::nanoseconds duration{0};
+};
+
+// Header every recording starts with
+std::string saiRecordingHeader();
+
+void appendSaiRecordedCall(const SaiRecordedCall& call, std::string& out);
+
+// Throws FbossError if the recording is truncated or was written against
+// different SAI headers
+std::vector<SaiRecordedCall> parseSaiRecording(folly::ByteRange recording);
+
+std::vector<SaiRecordedCall> readSaiRecording(const std::string& path);
+
+} // namespace facebook::fboss
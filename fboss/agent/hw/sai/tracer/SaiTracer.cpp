@@ -10,8 +10,10 @@
 #include <chrono>
 #include <ctime>
 #include <iomanip>
+#include <optional>
 #include <ostream>
 #include <tuple>
+#include <unordered_map>
 
 #include "fboss/agent/SysError.h"
 #include "fboss/agent/hw/sai/api/LoggingUtil.h"
@@ -175,6 +177,9 @@ sai_status_t __wrap_sai_api_uninitialize(void) {
       tracer->logApiUninitialize();
     }
   }
+  if (auto recorder = facebook::fboss::SaiRecorder::getInstance()) {
+    recorder->flush();
+  }
   return __real_sai_api_uninitialize();
 }
 
@@ -192,7 +197,8 @@ sai_status_t __wrap_sai_api_query(
 
   sai_status_t rv = __real_sai_api_query(sai_api_id, api_method_table);
 
-  if (!FLAGS_enable_replayer) {
+  // The wrappers also feed the recorder, which runs without the replayer log
+  if (!FLAGS_enable_replayer && FLAGS_sai_recorder_file.empty()) {
     return rv;
   }
 
@@ -487,6 +493,58 @@ folly::Singleton<facebook::fboss::SaiTracer> _saiTracer;
 constexpr std::string_view kGlobalVarStart = "/* Global Variables Start */";
 constexpr std::string_view kGlobalVarEnd = "/* Global Variables End */";
 
+struct ValueKind {
+  facebook::fboss::SaiRecordedValueKind kind;
+  uint32_t elementSize;
+};
+
+/*
+ * Attribute types, as listed in the tracer's per object attribute maps,
+ * whose value is not a plain copy. Other types the tracer knows how to log
+ * are plain values.
+ */
+const std::unordered_map<std::size_t, ValueKind>& valueKinds() {
+  using facebook::fboss::SaiRecordedValueKind;
+  static const std::unordered_map<std::size_t, ValueKind> kinds{
+      {TYPE_INDEX(sai_object_id_t), {SaiRecordedValueKind::OBJECT_ID, 0}},
+      {TYPE_INDEX(facebook::fboss::SaiObjectIdT),
+       {SaiRecordedValueKind::OBJECT_ID, 0}},
+      {TYPE_INDEX(std::vector<sai_object_id_t>),
+       {SaiRecordedValueKind::OBJECT_LIST, sizeof(sai_object_id_t)}},
+      {TYPE_INDEX(std::vector<sai_int8_t>),
+       {SaiRecordedValueKind::LIST, sizeof(sai_int8_t)}},
+      {TYPE_INDEX(std::vector<sai_uint8_t>),
+       {SaiRecordedValueKind::LIST, sizeof(sai_uint8_t)}},
+      {TYPE_INDEX(std::vector<sai_uint32_t>),
+       {SaiRecordedValueKind::LIST, sizeof(sai_uint32_t)}},
+      {TYPE_INDEX(std::vector<sai_int32_t>),
+       {SaiRecordedValueKind::LIST, sizeof(sai_int32_t)}},
+      {TYPE_INDEX(std::vector<sai_qos_map_t>),
+       {SaiRecordedValueKind::LIST, sizeof(sai_qos_map_t)}},
+      {TYPE_INDEX(std::vector<sai_map_t>),
+       {SaiRecordedValueKind::LIST, sizeof(sai_map_t)}},
+      {TYPE_INDEX(std::vector<sai_system_port_config_t>),
+       {SaiRecordedValueKind::LIST, sizeof(sai_system_port_config_t)}},
+      {TYPE_INDEX(facebook::fboss::AclEntryFieldSaiObjectIdT),
+       {SaiRecordedValueKind::ACL_FIELD_OBJECT_ID, 0}},
+      {TYPE_INDEX(facebook::fboss::AclEntryActionSaiObjectIdT),
+       {SaiRecordedValueKind::ACL_ACTION_OBJECT_ID, 0}},
+  };
+  return kinds;
+}
+
+template <typename ListT>
+void copyList(
+    const ListT& list,
+    uint32_t elementSize,
+    facebook::fboss::SaiRecordedAttribute& recorded) {
+  recorded.elementSize = elementSize;
+  if (list.list && list.count) {
+    auto begin = reinterpret_cast<const uint8_t*>(list.list);
+    recorded.elements.assign(begin, begin + list.count * elementSize);
+  }
+}
+
 } // namespace
 
 namespace facebook::fboss {
@@ -502,6 +560,7 @@ SaiTracer::SaiTracer() {
     setupGlobals();
     initVarCounts();
   }
+  SaiRecorder::setAttributeRecorder(&SaiTracer::recordAttribute);
 }
 
 SaiTracer::~SaiTracer() {
@@ -516,6 +575,60 @@ std::shared_ptr<SaiTracer> SaiTracer::getInstance() {
   return _saiTracer.try_get();
 }
 
+SaiRecordedAttribute SaiTracer::recordAttribute(
+    sai_object_type_t objectType,
+    const sai_attribute_t& attr) {
+  SaiRecordedAttribute recorded;
+  recorded.id = attr.id;
+  recorded.value = attr.value;
+
+  auto tracer = getInstance();
+  std::optional<std::size_t> typeIndex;
+  if (auto attributeMap =
+          tracer ? tracer->getAttributeMap(objectType) : nullptr) {
+    auto attrIter = attributeMap->find(attr.id);
+    if (attrIter != attributeMap->end()) {
+      typeIndex = attrIter->second.second;
+    }
+  }
+  if (!typeIndex) {
+    // Attributes the tracer logs by id rather than by type
+    if (objectType == SAI_OBJECT_TYPE_SWITCH &&
+        (attr.id == SAI_SWITCH_ATTR_SWITCH_HARDWARE_INFO ||
+         attr.id == SAI_SWITCH_ATTR_FIRMWARE_PATH_NAME)) {
+      recorded.kind = SaiRecordedValueKind::LIST;
+      copyList(attr.value.s8list, sizeof(sai_int8_t), recorded);
+    } else if (
+        (objectType == SAI_OBJECT_TYPE_LAG && attr.id == SAI_LAG_ATTR_LABEL) ||
+        (objectType == SAI_OBJECT_TYPE_MACSEC_SA &&
+         (attr.id == SAI_MACSEC_SA_ATTR_AUTH_KEY ||
+          attr.id == SAI_MACSEC_SA_ATTR_SAK ||
+          attr.id == SAI_MACSEC_SA_ATTR_SALT))) {
+      // Fixed size arrays held in the value itself
+      recorded.kind = SaiRecordedValueKind::VALUE;
+    } else {
+      recorded.kind = SaiRecordedValueKind::UNSUPPORTED;
+    }
+    return recorded;
+  }
+
+  auto kindIter = valueKinds().find(*typeIndex);
+  if (kindIter == valueKinds().end()) {
+    recorded.kind = tracer->primitiveFuncMap_.count(*typeIndex) ||
+            tracer->attributeFuncMap_.count(*typeIndex)
+        ? SaiRecordedValueKind::VALUE
+        : SaiRecordedValueKind::UNSUPPORTED;
+    return recorded;
+  }
+  recorded.kind = kindIter->second.kind;
+  if (recorded.kind == SaiRecordedValueKind::OBJECT_LIST ||
+      recorded.kind == SaiRecordedValueKind::LIST) {
+    // All sai_*_list_t share the { count, list } layout
+    copyList(attr.value.objlist, kindIter->second.elementSize, recorded);
+  }
+  return recorded;
+}
+
 void SaiTracer::printHex(std::ostringstream& outStringStream, uint8_t u8) {
   outStringStream << "0x" << std::setfill('0') << std::setw(2) << std::hex
                   << static_cast<int>(u8);
@@ -1553,6 +1666,145 @@ vector<string> SaiTracer::setAttrList(
   return attrLines;
 }
 
+const AttributeMap* SaiTracer::getAttributeMap(
+    sai_object_type_t object_type) {
+#if defined(BRCM_SAI_SDK_DNX_GTE_11_0)
+  if (UNLIKELY(object_type >= SAI_OBJECT_TYPE_MAX)) {
+    switch (static_cast<sai_object_type_extensions_t>(object_type)) {
+      case SAI_OBJECT_TYPE_TAM_EVENT_AGING_GROUP:
+        return &getTamEventAgingGroupAttributeMap();
+      default:
+        return nullptr;
+    }
+  }
+#endif
+
+  switch (object_type) {
+    case SAI_OBJECT_TYPE_ACL_COUNTER:
+      return &getAclCounterAttributeMap();
+    case SAI_OBJECT_TYPE_ACL_ENTRY:
+      return &getAclEntryAttributeMap();
+    case SAI_OBJECT_TYPE_ACL_TABLE:
+      return &getAclTableAttributeMap();
+    case SAI_OBJECT_TYPE_ACL_TABLE_GROUP:
+      return &getAclTableGroupAttributeMap();
+    case SAI_OBJECT_TYPE_ACL_TABLE_GROUP_MEMBER:
+      return &getAclTableGroupMemberAttributeMap();
+#if SAI_API_VERSION >= SAI_VERSION(1, 14, 0)
+    case SAI_OBJECT_TYPE_ARS:
+      return &getArsAttributeMap();
+    case SAI_OBJECT_TYPE_ARS_PROFILE:
+      return &getArsProfileAttributeMap();
+#endif
+    case SAI_OBJECT_TYPE_BRIDGE:
+      return &getBridgeAttributeMap();
+    case SAI_OBJECT_TYPE_BRIDGE_PORT:
+      return &getBridgePortAttributeMap();
+    case SAI_OBJECT_TYPE_BUFFER_POOL:
+      return &getBufferPoolAttributeMap();
+    case SAI_OBJECT_TYPE_BUFFER_PROFILE:
+      return &getBufferProfileAttributeMap();
+    case SAI_OBJECT_TYPE_COUNTER:
+      return &getCounterAttributeMap();
+    case SAI_OBJECT_TYPE_DEBUG_COUNTER:
+      return &getDebugCounterAttributeMap();
+    case SAI_OBJECT_TYPE_FDB_ENTRY:
+      return &getFdbEntryAttributeMap();
+    case SAI_OBJECT_TYPE_HASH:
+      return &getHashAttributeMap();
+    case SAI_OBJECT_TYPE_HOSTIF_PACKET:
+      return &getHostifPacketAttributeMap();
+    case SAI_OBJECT_TYPE_HOSTIF_TRAP:
+      return &getHostifTrapAttributeMap();
+    case SAI_OBJECT_TYPE_HOSTIF_USER_DEFINED_TRAP:
+      return &getHostifUserDefinedTrapAttributeMap();
+    case SAI_OBJECT_TYPE_HOSTIF_TRAP_GROUP:
+      return &getHostifTrapGroupAttributeMap();
+    case SAI_OBJECT_TYPE_INSEG_ENTRY:
+      return &getInsegEntryAttributeMap();
+    case SAI_OBJECT_TYPE_INGRESS_PRIORITY_GROUP:
+      return &getIngressPriorityGroupAttributeMap();
+    case SAI_OBJECT_TYPE_LAG:
+      return &getLagAttributeMap();
+    case SAI_OBJECT_TYPE_LAG_MEMBER:
+      return &getLagMemberAttributeMap();
+    case SAI_OBJECT_TYPE_MACSEC:
+      return &getMacsecAttributeMap();
+    case SAI_OBJECT_TYPE_MACSEC_PORT:
+      return &getMacsecPortAttributeMap();
+    case SAI_OBJECT_TYPE_MACSEC_FLOW:
+      return &getMacsecFlowAttributeMap();
+    case SAI_OBJECT_TYPE_MACSEC_SA:
+      return &getMacsecSAAttributeMap();
+    case SAI_OBJECT_TYPE_MACSEC_SC:
+      return &getMacsecSCAttributeMap();
+    case SAI_OBJECT_TYPE_MIRROR_SESSION:
+      return &getMirrorSessionAttributeMap();
+    case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
+      return &getNeighborEntryAttributeMap();
+    case SAI_OBJECT_TYPE_NEXT_HOP:
+      return &getNextHopAttributeMap();
+    case SAI_OBJECT_TYPE_NEXT_HOP_GROUP:
+      return &getNextHopGroupAttributeMap();
+    case SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER:
+      return &getNextHopGroupMemberAttributeMap();
+    case SAI_OBJECT_TYPE_PORT:
+      return &getPortAttributeMap();
+    case SAI_OBJECT_TYPE_PORT_SERDES:
+      return &getPortSerdesAttributeMap();
+    case SAI_OBJECT_TYPE_PORT_CONNECTOR:
+      return &getPortConnectorAttributeMap();
+    case SAI_OBJECT_TYPE_QOS_MAP:
+      return &getQosMapAttributeMap();
+    case SAI_OBJECT_TYPE_QUEUE:
+      return &getQueueAttributeMap();
+    case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+      return &getRouteEntryAttributeMap();
+    case SAI_OBJECT_TYPE_ROUTER_INTERFACE:
+      return &getRouterInterfaceAttributeMap();
+    case SAI_OBJECT_TYPE_SAMPLEPACKET:
+      return &getSamplePacketAttributeMap();
+    case SAI_OBJECT_TYPE_SCHEDULER:
+      return &getSchedulerAttributeMap();
+    case SAI_OBJECT_TYPE_SWITCH:
+      return &getSwitchAttributeMap();
+    case SAI_OBJECT_TYPE_SYSTEM_PORT:
+      return &getSystemPortAttributeMap();
+    case SAI_OBJECT_TYPE_TAM:
+      return &getTamAttributeMap();
+    case SAI_OBJECT_TYPE_TAM_EVENT:
+      return &getTamEventAttributeMap();
+    case SAI_OBJECT_TYPE_TAM_EVENT_ACTION:
+      return &getTamEventActionAttributeMap();
+    case SAI_OBJECT_TYPE_TAM_REPORT:
+      return &getTamReportAttributeMap();
+    case SAI_OBJECT_TYPE_TAM_TRANSPORT:
+      return &getTamTransportAttributeMap();
+    case SAI_OBJECT_TYPE_TAM_COLLECTOR:
+      return &getTamCollectorAttributeMap();
+    case SAI_OBJECT_TYPE_TUNNEL:
+      return &getTunnelAttributeMap();
+    case SAI_OBJECT_TYPE_TUNNEL_TERM_TABLE_ENTRY:
+      return &getTunnelTermAttributeMap();
+    case SAI_OBJECT_TYPE_UDF:
+      return &getUdfAttributeMap();
+    case SAI_OBJECT_TYPE_UDF_MATCH:
+      return &getUdfMatchAttributeMap();
+    case SAI_OBJECT_TYPE_UDF_GROUP:
+      return &getUdfGroupAttributeMap();
+    case SAI_OBJECT_TYPE_VIRTUAL_ROUTER:
+      return &getVirtualRouterAttributeMap();
+    case SAI_OBJECT_TYPE_VLAN:
+      return &getVlanAttributeMap();
+    case SAI_OBJECT_TYPE_VLAN_MEMBER:
+      return &getVlanMemberAttributeMap();
+    case SAI_OBJECT_TYPE_WRED:
+      return &getWredAttributeMap();
+    default:
+      return nullptr;
+  }
+}
+
 string SaiTracer::createFnCall(
     const string& fn_name,
     const string& var1,
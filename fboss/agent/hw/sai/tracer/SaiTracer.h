@@ -17,6 +17,7 @@
 #include "fboss/agent/AsyncLogger.h"
 #include "fboss/agent/hw/sai/api/SaiVersion.h"
 #include "fboss/agent/hw/sai/api/Traits.h"
+#include "fboss/agent/hw/sai/tracer/SaiRecorder.h"
 #include "fboss/agent/hw/sai/tracer/Utils.h"
 
 #include <folly/File.h>
@@ -52,6 +53,7 @@ using ListFunction = void (*)(
     uint32_t,
     std::vector<std::string>&,
     bool);
+using AttributeMap = std::map<int32_t, std::pair<std::string, std::size_t>>;
 
 #define TYPE_INDEX(type) std::type_index(typeid(type)).hash_code()
 
@@ -204,6 +206,14 @@ class SaiTracer {
 
   std::string getVariable(sai_object_id_t object_id);
 
+  // Attribute names and types of an object type, nullptr if not traced
+  const AttributeMap* getAttributeMap(sai_object_type_t object_type);
+
+  // SaiRecorder::AttributeRecorder, by the type in the attribute maps
+  static SaiRecordedAttribute recordAttribute(
+      sai_object_type_t objectType,
+      const sai_attribute_t& attr);
+
   uint32_t
   checkListCount(uint32_t list_count, uint32_t elem_size, uint32_t elem_count);
 
@@ -594,7 +604,8 @@ class SaiTracer {
       const sai_attribute_t* attr_list,          \
       uint32_t attr_count,                       \
       std::vector<std::string>& attrLines,       \
-      sai_status_t rv);
+      sai_status_t rv);                          \
+  const AttributeMap& get##obj_type##AttributeMap();
 
 #define WRAP_CREATE_FUNC(obj_type, sai_obj_type, api_type)                 \
   sai_status_t wrap_create_##obj_type(                                     \
@@ -612,8 +623,21 @@ class SaiTracer {
     auto begin = FLAGS_enable_elapsed_time_log                             \
         ? std::chrono::system_clock::now()                                 \
         : std::chrono::system_clock::time_point::min();                    \
+    auto recorder = SaiRecorder::getInstance();                            \
+    auto recordBegin =                                                     \
+        recorder ? SaiRecorder::now() : SaiRecorder::Clock::time_point();  \
     auto rv = SaiTracer::getInstance()->api_type##Api_->create_##obj_type( \
         obj_type##_id, switch_id, attr_count, attr_list);                  \
+    if (recorder) {                                                        \
+      recorder->recordCreate(                                              \
+          sai_obj_type,                                                    \
+          *obj_type##_id,                                                  \
+          switch_id,                                                       \
+          attr_count,                                                      \
+          attr_list,                                                       \
+          rv,                                                              \
+          recordBegin);                                                    \
+    }                                                                      \
     SaiTracer::getInstance()->logPostInvocation(                           \
         rv, *obj_type##_id, begin, varName);                               \
     return rv;                                                             \
@@ -626,8 +650,15 @@ class SaiTracer {
     auto begin = FLAGS_enable_elapsed_time_log                             \
         ? std::chrono::system_clock::now()                                 \
         : std::chrono::system_clock::time_point::min();                    \
+    auto recorder = SaiRecorder::getInstance();                            \
+    auto recordBegin =                                                     \
+        recorder ? SaiRecorder::now() : SaiRecorder::Clock::time_point();  \
     auto rv = SaiTracer::getInstance()->api_type##Api_->remove_##obj_type( \
         obj_type##_id);                                                    \
+    if (recorder) {                                                        \
+      recorder->recordRemove(                                              \
+          sai_obj_type, obj_type##_id, rv, recordBegin);                   \
+    }                                                                      \
     SaiTracer::getInstance()->logPostInvocation(rv, obj_type##_id, begin); \
                                                                            \
     return rv;                                                             \
@@ -641,9 +672,16 @@ class SaiTracer {
     auto begin = FLAGS_enable_elapsed_time_log                                \
         ? std::chrono::system_clock::now()                                    \
         : std::chrono::system_clock::time_point::min();                       \
+    auto recorder = SaiRecorder::getInstance();                               \
+    auto recordBegin =                                                        \
+        recorder ? SaiRecorder::now() : SaiRecorder::Clock::time_point();     \
     auto rv =                                                                 \
         SaiTracer::getInstance()->api_type##Api_->set_##obj_type##_attribute( \
             obj_type##_id, attr);                                             \
+    if (recorder) {                                                           \
+      recorder->recordSetAttribute(                                           \
+          sai_obj_type, obj_type##_id, attr, rv, recordBegin);                \
+    }                                                                         \
     SaiTracer::getInstance()->logPostInvocation(rv, obj_type##_id, begin);    \
                                                                               \
     return rv;                                                                \
@@ -841,6 +879,10 @@ class SaiTracer {
   }
 
 #define SET_SAI_REGULAR_ATTRIBUTES(obj_type)                                 \
+  const AttributeMap& get##obj_type##AttributeMap() {                        \
+    return _##obj_type##Map;                                                 \
+  }                                                                          \
+                                                                             \
   void set##obj_type##Attributes(                                            \
       const sai_attribute_t* attr_list,                                      \
       uint32_t attr_count,                                                   \
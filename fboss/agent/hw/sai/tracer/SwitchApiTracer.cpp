@@ -154,8 +154,21 @@ sai_status_t wrap_create_switch(
       ? std::chrono::system_clock::now()
       : std::chrono::system_clock::time_point::min();
   SaiTracer::getInstance()->logSwitchCreateFn(switch_id, attr_count, attr_list);
+  auto recorder = SaiRecorder::getInstance();
+  auto recordBegin =
+      recorder ? SaiRecorder::now() : SaiRecorder::Clock::time_point();
   auto rv = SaiTracer::getInstance()->switchApi_->create_switch(
       switch_id, attr_count, attr_list);
+  if (recorder) {
+    recorder->recordCreate(
+        SAI_OBJECT_TYPE_SWITCH,
+        *switch_id,
+        SAI_NULL_OBJECT_ID,
+        attr_count,
+        attr_list,
+        rv,
+        recordBegin);
+  }
   SaiTracer::getInstance()->logPostInvocation(rv, *switch_id, begin);
   return rv;
 }
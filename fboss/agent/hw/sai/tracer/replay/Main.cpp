@@ -0,0 +1,71 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+/*
+ * Replays a recording made with --sai_recorder_file against the SAI adapter
+ * this binary is linked with, and reports per API latencies of the original
+ * run next to the replayed ones:
+ *
+ *   sai_recording_replayer-fake --sai_recording=/tmp/sai.rec
+ */
+
+#include <iostream>
+
+#include <folly/init/Init.h>
+#include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
+
+#include "fboss/agent/hw/sai/tracer/SaiRecording.h"
+#include "fboss/agent/hw/sai/tracer/replay/SaiRecordingReplayer.h"
+
+DEFINE_string(sai_recording, "", "Recording to replay");
+
+namespace {
+
+const char* saiProfileGetValue(
+    sai_switch_profile_id_t /* profile_id */,
+    const char* /* variable */) {
+  return nullptr;
+}
+
+int saiProfileGetNextValue(
+    sai_switch_profile_id_t /* profile_id */,
+    const char** /* variable */,
+    const char** /* value */) {
+  return -1;
+}
+
+sai_service_method_table_t kSaiServiceMethodTable = {
+    .profile_get_value = saiProfileGetValue,
+    .profile_get_next_value = saiProfileGetNextValue,
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+  if (FLAGS_sai_recording.empty()) {
+    XLOG(ERR) << "--sai_recording is required";
+    return 1;
+  }
+  auto calls = facebook::fboss::readSaiRecording(FLAGS_sai_recording);
+  XLOG(INFO) << "Replaying " << calls.size() << " SAI calls from "
+             << FLAGS_sai_recording;
+
+  auto rv = sai_api_initialize(0, &kSaiServiceMethodTable);
+  if (rv != SAI_STATUS_SUCCESS) {
+    XLOG(ERR) << "Failed to initialize SAI: " << rv;
+    return 1;
+  }
+  facebook::fboss::SaiRecordingReplayer replayer;
+  std::cout << replayer.replay(calls).toString();
+  sai_api_uninitialize();
+  return 0;
+}
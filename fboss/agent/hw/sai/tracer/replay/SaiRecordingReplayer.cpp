@@ -0,0 +1,454 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/tracer/replay/SaiRecordingReplayer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <fmt/format.h>
+#include <folly/logging/xlog.h>
+
+#include "fboss/agent/hw/sai/api/LoggingUtil.h"
+
+#define REPLAY_OBJECT_API(obj_type, sai_obj_type, api) \
+  do {                                                 \
+    if (api) {                                         \
+      objectApis_[sai_obj_type] = ObjectApi{           \
+          api->create_##obj_type,                      \
+          api->remove_##obj_type,                      \
+          api->set_##obj_type##_attribute};            \
+    }                                                  \
+  } while (0)
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::string apiName(const facebook::fboss::SaiRecordedCall& call) {
+  folly::StringPiece op;
+  switch (call.op) {
+    case facebook::fboss::SaiRecordedOp::CREATE:
+      op = "create";
+      break;
+    case facebook::fboss::SaiRecordedOp::REMOVE:
+      op = "remove";
+      break;
+    case facebook::fboss::SaiRecordedOp::SET_ATTRIBUTE:
+      op = "set";
+      break;
+  }
+  return fmt::format(
+      "{} {}", op, facebook::fboss::saiObjectTypeToString(call.objectType));
+}
+
+std::string percentiles(std::vector<std::chrono::nanoseconds> latencies) {
+  if (latencies.empty()) {
+    return "-";
+  }
+  std::sort(latencies.begin(), latencies.end());
+  auto micros = [&](size_t percentile) {
+    auto index =
+        std::min(latencies.size() - 1, latencies.size() * percentile / 100);
+    return latencies[index].count() / 1000.0;
+  };
+  return fmt::format(
+      "{:.1f}/{:.1f}/{:.1f}/{:.1f}",
+      micros(50),
+      micros(90),
+      micros(99),
+      latencies.back().count() / 1000.0);
+}
+
+template <typename EntryT>
+std::optional<EntryT> recordedEntry(
+    const facebook::fboss::SaiRecordedCall& call) {
+  if (call.entry.size() != sizeof(EntryT)) {
+    return std::nullopt;
+  }
+  EntryT entry;
+  std::memcpy(&entry, call.entry.data(), sizeof(EntryT));
+  return entry;
+}
+
+} // namespace
+
+namespace facebook::fboss {
+
+std::string SaiReplayReport::toString() const {
+  std::string report = fmt::format(
+      "{:<48} {:>8} {:>10}  {:<32} {:<32}\n",
+      "API",
+      "calls",
+      "mismatched",
+      "recorded p50/p90/p99/max us",
+      "replayed p50/p90/p99/max us");
+  for (const auto& [api, stats] : apis) {
+    report += fmt::format(
+        "{:<48} {:>8} {:>10}  {:<32} {:<32}\n",
+        api,
+        stats.replayed.size(),
+        stats.mismatched,
+        percentiles(stats.recorded),
+        percentiles(stats.replayed));
+  }
+  report += fmt::format(
+      "Total time in SAI: recorded {:.3f}ms, replayed {:.3f}ms\n"
+      "Skipped calls: {}, dropped attributes: {}\n",
+      recordedTime.count() / 1e6,
+      replayedTime.count() / 1e6,
+      skipped,
+      droppedAttributes);
+  return report;
+}
+
+SaiRecordingReplayer::SaiRecordingReplayer() {
+  auto aclApi = queryApi<sai_acl_api_t>(SAI_API_ACL);
+  REPLAY_OBJECT_API(acl_table, SAI_OBJECT_TYPE_ACL_TABLE, aclApi);
+  REPLAY_OBJECT_API(acl_entry, SAI_OBJECT_TYPE_ACL_ENTRY, aclApi);
+  REPLAY_OBJECT_API(acl_counter, SAI_OBJECT_TYPE_ACL_COUNTER, aclApi);
+  REPLAY_OBJECT_API(acl_table_group, SAI_OBJECT_TYPE_ACL_TABLE_GROUP, aclApi);
+  REPLAY_OBJECT_API(
+      acl_table_group_member, SAI_OBJECT_TYPE_ACL_TABLE_GROUP_MEMBER, aclApi);
+  auto bridgeApi = queryApi<sai_bridge_api_t>(SAI_API_BRIDGE);
+  REPLAY_OBJECT_API(bridge, SAI_OBJECT_TYPE_BRIDGE, bridgeApi);
+  REPLAY_OBJECT_API(bridge_port, SAI_OBJECT_TYPE_BRIDGE_PORT, bridgeApi);
+  auto bufferApi = queryApi<sai_buffer_api_t>(SAI_API_BUFFER);
+  REPLAY_OBJECT_API(buffer_pool, SAI_OBJECT_TYPE_BUFFER_POOL, bufferApi);
+  REPLAY_OBJECT_API(buffer_profile, SAI_OBJECT_TYPE_BUFFER_PROFILE, bufferApi);
+  REPLAY_OBJECT_API(
+      ingress_priority_group,
+      SAI_OBJECT_TYPE_INGRESS_PRIORITY_GROUP,
+      bufferApi);
+  auto counterApi = queryApi<sai_counter_api_t>(SAI_API_COUNTER);
+  REPLAY_OBJECT_API(counter, SAI_OBJECT_TYPE_COUNTER, counterApi);
+  auto debugCounterApi =
+      queryApi<sai_debug_counter_api_t>(SAI_API_DEBUG_COUNTER);
+  REPLAY_OBJECT_API(
+      debug_counter, SAI_OBJECT_TYPE_DEBUG_COUNTER, debugCounterApi);
+  auto hashApi = queryApi<sai_hash_api_t>(SAI_API_HASH);
+  REPLAY_OBJECT_API(hash, SAI_OBJECT_TYPE_HASH, hashApi);
+  auto hostifApi = queryApi<sai_hostif_api_t>(SAI_API_HOSTIF);
+  REPLAY_OBJECT_API(hostif_trap, SAI_OBJECT_TYPE_HOSTIF_TRAP, hostifApi);
+  REPLAY_OBJECT_API(
+      hostif_trap_group, SAI_OBJECT_TYPE_HOSTIF_TRAP_GROUP, hostifApi);
+  REPLAY_OBJECT_API(
+      hostif_user_defined_trap,
+      SAI_OBJECT_TYPE_HOSTIF_USER_DEFINED_TRAP,
+      hostifApi);
+  auto lagApi = queryApi<sai_lag_api_t>(SAI_API_LAG);
+  REPLAY_OBJECT_API(lag, SAI_OBJECT_TYPE_LAG, lagApi);
+  REPLAY_OBJECT_API(lag_member, SAI_OBJECT_TYPE_LAG_MEMBER, lagApi);
+  auto mirrorApi = queryApi<sai_mirror_api_t>(SAI_API_MIRROR);
+  REPLAY_OBJECT_API(mirror_session, SAI_OBJECT_TYPE_MIRROR_SESSION, mirrorApi);
+  auto nextHopApi = queryApi<sai_next_hop_api_t>(SAI_API_NEXT_HOP);
+  REPLAY_OBJECT_API(next_hop, SAI_OBJECT_TYPE_NEXT_HOP, nextHopApi);
+  auto nextHopGroupApi =
+      queryApi<sai_next_hop_group_api_t>(SAI_API_NEXT_HOP_GROUP);
+  REPLAY_OBJECT_API(
+      next_hop_group, SAI_OBJECT_TYPE_NEXT_HOP_GROUP, nextHopGroupApi);
+  REPLAY_OBJECT_API(
+      next_hop_group_member,
+      SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER,
+      nextHopGroupApi);
+  auto portApi = queryApi<sai_port_api_t>(SAI_API_PORT);
+  REPLAY_OBJECT_API(port, SAI_OBJECT_TYPE_PORT, portApi);
+  REPLAY_OBJECT_API(port_serdes, SAI_OBJECT_TYPE_PORT_SERDES, portApi);
+  auto qosMapApi = queryApi<sai_qos_map_api_t>(SAI_API_QOS_MAP);
+  REPLAY_OBJECT_API(qos_map, SAI_OBJECT_TYPE_QOS_MAP, qosMapApi);
+  auto queueApi = queryApi<sai_queue_api_t>(SAI_API_QUEUE);
+  REPLAY_OBJECT_API(queue, SAI_OBJECT_TYPE_QUEUE, queueApi);
+  auto routerInterfaceApi =
+      queryApi<sai_router_interface_api_t>(SAI_API_ROUTER_INTERFACE);
+  REPLAY_OBJECT_API(
+      router_interface, SAI_OBJECT_TYPE_ROUTER_INTERFACE, routerInterfaceApi);
+  auto samplePacketApi =
+      queryApi<sai_samplepacket_api_t>(SAI_API_SAMPLEPACKET);
+  REPLAY_OBJECT_API(
+      samplepacket, SAI_OBJECT_TYPE_SAMPLEPACKET, samplePacketApi);
+  auto schedulerApi = queryApi<sai_scheduler_api_t>(SAI_API_SCHEDULER);
+  REPLAY_OBJECT_API(scheduler, SAI_OBJECT_TYPE_SCHEDULER, schedulerApi);
+  auto systemPortApi = queryApi<sai_system_port_api_t>(SAI_API_SYSTEM_PORT);
+  REPLAY_OBJECT_API(system_port, SAI_OBJECT_TYPE_SYSTEM_PORT, systemPortApi);
+  auto tunnelApi = queryApi<sai_tunnel_api_t>(SAI_API_TUNNEL);
+  REPLAY_OBJECT_API(tunnel, SAI_OBJECT_TYPE_TUNNEL, tunnelApi);
+  REPLAY_OBJECT_API(
+      tunnel_term_table_entry,
+      SAI_OBJECT_TYPE_TUNNEL_TERM_TABLE_ENTRY,
+      tunnelApi);
+  auto udfApi = queryApi<sai_udf_api_t>(SAI_API_UDF);
+  REPLAY_OBJECT_API(udf, SAI_OBJECT_TYPE_UDF, udfApi);
+  REPLAY_OBJECT_API(udf_match, SAI_OBJECT_TYPE_UDF_MATCH, udfApi);
+  REPLAY_OBJECT_API(udf_group, SAI_OBJECT_TYPE_UDF_GROUP, udfApi);
+  auto virtualRouterApi =
+      queryApi<sai_virtual_router_api_t>(SAI_API_VIRTUAL_ROUTER);
+  REPLAY_OBJECT_API(
+      virtual_router, SAI_OBJECT_TYPE_VIRTUAL_ROUTER, virtualRouterApi);
+  auto vlanApi = queryApi<sai_vlan_api_t>(SAI_API_VLAN);
+  REPLAY_OBJECT_API(vlan, SAI_OBJECT_TYPE_VLAN, vlanApi);
+  REPLAY_OBJECT_API(vlan_member, SAI_OBJECT_TYPE_VLAN_MEMBER, vlanApi);
+  auto wredApi = queryApi<sai_wred_api_t>(SAI_API_WRED);
+  REPLAY_OBJECT_API(wred, SAI_OBJECT_TYPE_WRED, wredApi);
+
+  switchApi_ = queryApi<sai_switch_api_t>(SAI_API_SWITCH);
+  routeApi_ = queryApi<sai_route_api_t>(SAI_API_ROUTE);
+  neighborApi_ = queryApi<sai_neighbor_api_t>(SAI_API_NEIGHBOR);
+  fdbApi_ = queryApi<sai_fdb_api_t>(SAI_API_FDB);
+  mplsApi_ = queryApi<sai_mpls_api_t>(SAI_API_MPLS);
+}
+
+template <typename ApiT>
+ApiT* SaiRecordingReplayer::queryApi(sai_api_t apiId) {
+  ApiT* api = nullptr;
+  auto rv = sai_api_query(apiId, reinterpret_cast<void**>(&api));
+  if (rv != SAI_STATUS_SUCCESS) {
+    XLOG(WARN) << "Failed to query SAI api " << apiId
+               << ", calls on its objects will not be replayed";
+    return nullptr;
+  }
+  return api;
+}
+
+sai_object_id_t SaiRecordingReplayer::remap(sai_object_id_t recorded) const {
+  auto iter = objectIds_.find(recorded);
+  return iter == objectIds_.end() ? recorded : iter->second;
+}
+
+SaiRecordingReplayer::ReplayedAttributes
+SaiRecordingReplayer::replayedAttributes(
+    const SaiRecordedCall& call,
+    SaiReplayReport& report) const {
+  ReplayedAttributes replayed;
+  replayed.attrs.reserve(call.attributes.size());
+  replayed.lists.reserve(call.attributes.size());
+  for (const auto& recorded : call.attributes) {
+    sai_attribute_t attr;
+    attr.id = recorded.id;
+    attr.value = recorded.value;
+    switch (recorded.kind) {
+      case SaiRecordedValueKind::VALUE:
+        break;
+      case SaiRecordedValueKind::OBJECT_ID:
+        attr.value.oid = remap(attr.value.oid);
+        break;
+      case SaiRecordedValueKind::ACL_FIELD_OBJECT_ID:
+        attr.value.aclfield.data.oid = remap(attr.value.aclfield.data.oid);
+        break;
+      case SaiRecordedValueKind::ACL_ACTION_OBJECT_ID:
+        attr.value.aclaction.parameter.oid =
+            remap(attr.value.aclaction.parameter.oid);
+        break;
+      case SaiRecordedValueKind::OBJECT_LIST:
+      case SaiRecordedValueKind::LIST: {
+        auto& list = replayed.lists.emplace_back(recorded.elements);
+        if (recorded.kind == SaiRecordedValueKind::OBJECT_LIST) {
+          auto oids = reinterpret_cast<sai_object_id_t*>(list.data());
+          for (size_t i = 0; i < list.size() / sizeof(sai_object_id_t); ++i) {
+            oids[i] = remap(oids[i]);
+          }
+        }
+        // All sai_*_list_t share the { count, list } layout
+        attr.value.objlist.count = recorded.elementSize
+            ? list.size() / recorded.elementSize
+            : 0;
+        attr.value.objlist.list =
+            reinterpret_cast<sai_object_id_t*>(list.data());
+        break;
+      }
+      case SaiRecordedValueKind::UNSUPPORTED:
+        ++report.droppedAttributes;
+        continue;
+    }
+    replayed.attrs.push_back(attr);
+  }
+  return replayed;
+}
+
+std::optional<sai_status_t> SaiRecordingReplayer::replayObjectCall(
+    const SaiRecordedCall& call,
+    const ReplayedAttributes& attributes) {
+  const auto& attrs = attributes.attrs;
+  if (call.objectType == SAI_OBJECT_TYPE_SWITCH) {
+    if (!switchApi_) {
+      return std::nullopt;
+    }
+    switch (call.op) {
+      case SaiRecordedOp::CREATE: {
+        sai_object_id_t switchId;
+        auto rv = switchApi_->create_switch(
+            &switchId, attrs.size(), attrs.data());
+        if (rv == SAI_STATUS_SUCCESS) {
+          objectIds_[call.objectId] = switchId;
+        }
+        return rv;
+      }
+      case SaiRecordedOp::REMOVE:
+        return switchApi_->remove_switch(remap(call.objectId));
+      case SaiRecordedOp::SET_ATTRIBUTE:
+        if (attrs.empty()) {
+          return std::nullopt;
+        }
+        return switchApi_->set_switch_attribute(
+            remap(call.objectId), attrs.data());
+    }
+  }
+
+  auto apiIter = objectApis_.find(call.objectType);
+  if (apiIter == objectApis_.end()) {
+    return std::nullopt;
+  }
+  const auto& api = apiIter->second;
+  switch (call.op) {
+    case SaiRecordedOp::CREATE: {
+      if (!api.create) {
+        return std::nullopt;
+      }
+      sai_object_id_t objectId;
+      auto rv = api.create(
+          &objectId, remap(call.switchId), attrs.size(), attrs.data());
+      if (rv == SAI_STATUS_SUCCESS) {
+        objectIds_[call.objectId] = objectId;
+      }
+      return rv;
+    }
+    case SaiRecordedOp::REMOVE: {
+      if (!api.remove) {
+        return std::nullopt;
+      }
+      auto rv = api.remove(remap(call.objectId));
+      if (rv == SAI_STATUS_SUCCESS) {
+        objectIds_.erase(call.objectId);
+      }
+      return rv;
+    }
+    case SaiRecordedOp::SET_ATTRIBUTE:
+      if (!api.set || attrs.empty()) {
+        return std::nullopt;
+      }
+      return api.set(remap(call.objectId), attrs.data());
+  }
+  return std::nullopt;
+}
+
+std::optional<sai_status_t> SaiRecordingReplayer::replayEntryCall(
+    const SaiRecordedCall& call,
+    const ReplayedAttributes& attributes) {
+  const auto& attrs = attributes.attrs;
+  if (call.op == SaiRecordedOp::SET_ATTRIBUTE && attrs.empty()) {
+    return std::nullopt;
+  }
+  switch (call.objectType) {
+    case SAI_OBJECT_TYPE_ROUTE_ENTRY: {
+      auto entry = recordedEntry<sai_route_entry_t>(call);
+      if (!entry || !routeApi_) {
+        return std::nullopt;
+      }
+      entry->switch_id = remap(entry->switch_id);
+      entry->vr_id = remap(entry->vr_id);
+      switch (call.op) {
+        case SaiRecordedOp::CREATE:
+          return routeApi_->create_route_entry(
+              &*entry, attrs.size(), attrs.data());
+        case SaiRecordedOp::REMOVE:
+          return routeApi_->remove_route_entry(&*entry);
+        case SaiRecordedOp::SET_ATTRIBUTE:
+          return routeApi_->set_route_entry_attribute(&*entry, attrs.data());
+      }
+      break;
+    }
+    case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY: {
+      auto entry = recordedEntry<sai_neighbor_entry_t>(call);
+      if (!entry || !neighborApi_) {
+        return std::nullopt;
+      }
+      entry->switch_id = remap(entry->switch_id);
+      entry->rif_id = remap(entry->rif_id);
+      switch (call.op) {
+        case SaiRecordedOp::CREATE:
+          return neighborApi_->create_neighbor_entry(
+              &*entry, attrs.size(), attrs.data());
+        case SaiRecordedOp::REMOVE:
+          return neighborApi_->remove_neighbor_entry(&*entry);
+        case SaiRecordedOp::SET_ATTRIBUTE:
+          return neighborApi_->set_neighbor_entry_attribute(
+              &*entry, attrs.data());
+      }
+      break;
+    }
+    case SAI_OBJECT_TYPE_FDB_ENTRY: {
+      auto entry = recordedEntry<sai_fdb_entry_t>(call);
+      if (!entry || !fdbApi_) {
+        return std::nullopt;
+      }
+      entry->switch_id = remap(entry->switch_id);
+      entry->bv_id = remap(entry->bv_id);
+      switch (call.op) {
+        case SaiRecordedOp::CREATE:
+          return fdbApi_->create_fdb_entry(
+              &*entry, attrs.size(), attrs.data());
+        case SaiRecordedOp::REMOVE:
+          return fdbApi_->remove_fdb_entry(&*entry);
+        case SaiRecordedOp::SET_ATTRIBUTE:
+          return fdbApi_->set_fdb_entry_attribute(&*entry, attrs.data());
+      }
+      break;
+    }
+    case SAI_OBJECT_TYPE_INSEG_ENTRY: {
+      auto entry = recordedEntry<sai_inseg_entry_t>(call);
+      if (!entry || !mplsApi_) {
+        return std::nullopt;
+      }
+      entry->switch_id = remap(entry->switch_id);
+      switch (call.op) {
+        case SaiRecordedOp::CREATE:
+          return mplsApi_->create_inseg_entry(
+              &*entry, attrs.size(), attrs.data());
+        case SaiRecordedOp::REMOVE:
+          return mplsApi_->remove_inseg_entry(&*entry);
+        case SaiRecordedOp::SET_ATTRIBUTE:
+          return mplsApi_->set_inseg_entry_attribute(&*entry, attrs.data());
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  return std::nullopt;
+}
+
+SaiReplayReport SaiRecordingReplayer::replay(
+    const std::vector<SaiRecordedCall>& calls) {
+  SaiReplayReport report;
+  for (const auto& call : calls) {
+    auto attributes = replayedAttributes(call, report);
+    auto begin = Clock::now();
+    auto rv = call.entry.empty() ? replayObjectCall(call, attributes)
+                                 : replayEntryCall(call, attributes);
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now() - begin);
+    if (!rv) {
+      ++report.skipped;
+      continue;
+    }
+    auto& stats = report.apis[apiName(call)];
+    stats.recorded.push_back(call.duration);
+    stats.replayed.push_back(duration);
+    if (*rv != call.status) {
+      ++stats.mismatched;
+      XLOG(DBG2) << apiName(call) << " returned " << *rv << ", recorded "
+                 << call.status;
+    }
+    report.recordedTime += call.duration;
+    report.replayedTime += duration;
+  }
+  return report;
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,103 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "fboss/agent/hw/sai/tracer/SaiRecording.h"
+
+namespace facebook::fboss {
+
+struct SaiReplayApiStats {
+  std::vector<std::chrono::nanoseconds> recorded;
+  std::vector<std::chrono::nanoseconds> replayed;
+  // Calls which returned a different status than in the recording
+  uint64_t mismatched{0};
+};
+
+struct SaiReplayReport {
+  // Keyed by API, e.g. "create route-entry"
+  std::map<std::string, SaiReplayApiStats> apis;
+  std::chrono::nanoseconds recordedTime{0};
+  std::chrono::nanoseconds replayedTime{0};
+  // Calls on object types the replayer has no API for
+  uint64_t skipped{0};
+  // Attributes dropped because the recorder could not copy them
+  uint64_t droppedAttributes{0};
+
+  // Per API count, mismatches and p50/p90/p99/max latencies, recorded and
+  // replayed, followed by the totals
+  std::string toString() const;
+};
+
+/*
+ * Replays a SaiRecorder recording against the SAI adapter the binary is
+ * linked with (the fake SAI in CI), timing every call. Object ids in the
+ * recording are remapped to the ids the adapter hands out, so the adapter
+ * does not need to allocate ids the way the recording one did. Ids the
+ * recording never created, e.g. the default virtual router, are passed
+ * through as is.
+ *
+ * sai_api_initialize must have been called before replaying.
+ */
+class SaiRecordingReplayer {
+ public:
+  SaiRecordingReplayer();
+
+  SaiReplayReport replay(const std::vector<SaiRecordedCall>& calls);
+
+ private:
+  struct ObjectApi {
+    sai_status_t (*create)(
+        sai_object_id_t*,
+        sai_object_id_t,
+        uint32_t,
+        const sai_attribute_t*){nullptr};
+    sai_status_t (*remove)(sai_object_id_t){nullptr};
+    sai_status_t (*set)(sai_object_id_t, const sai_attribute_t*){nullptr};
+  };
+
+  // Owns the lists the replayed attributes point to
+  struct ReplayedAttributes {
+    std::vector<sai_attribute_t> attrs;
+    std::vector<std::vector<uint8_t>> lists;
+  };
+
+  template <typename ApiT>
+  ApiT* queryApi(sai_api_t apiId);
+
+  sai_object_id_t remap(sai_object_id_t recorded) const;
+  ReplayedAttributes replayedAttributes(
+      const SaiRecordedCall& call,
+      SaiReplayReport& report) const;
+  // std::nullopt if there is no API for the call's object type
+  std::optional<sai_status_t> replayObjectCall(
+      const SaiRecordedCall& call,
+      const ReplayedAttributes& attributes);
+  std::optional<sai_status_t> replayEntryCall(
+      const SaiRecordedCall& call,
+      const ReplayedAttributes& attributes);
+
+  std::unordered_map<sai_object_type_t, ObjectApi> objectApis_;
+  sai_switch_api_t* switchApi_{nullptr};
+  sai_route_api_t* routeApi_{nullptr};
+  sai_neighbor_api_t* neighborApi_{nullptr};
+  sai_fdb_api_t* fdbApi_{nullptr};
+  sai_mpls_api_t* mplsApi_{nullptr};
+  // Recorded object id to replayed object id
+  std::unordered_map<sai_object_id_t, sai_object_id_t> objectIds_;
+};
+
+} // namespace facebook::fboss
@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/tracer/SaiRecorder.h"
+#include "fboss/agent/hw/sai/tracer/SaiRecording.h"
+
+#include <folly/testing/TestUtil.h>
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+using namespace facebook::fboss;
+
+namespace {
+
+constexpr sai_object_id_t kSwitchId = 1;
+constexpr sai_object_id_t kVlanId = 1000;
+
+// Stands in for SaiTracer::recordAttribute, which knows attribute types
+SaiRecordedAttribute recordValueAttribute(
+    sai_object_type_t /*objectType*/,
+    const sai_attribute_t& attr) {
+  SaiRecordedAttribute recorded;
+  recorded.id = attr.id;
+  recorded.kind = SaiRecordedValueKind::VALUE;
+  recorded.value = attr.value;
+  return recorded;
+}
+
+class SaiRecorderTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    SaiRecorder::setAttributeRecorder(&recordValueAttribute);
+  }
+
+ protected:
+  std::string recordingPath() const {
+    return (tmpDir_.path() / "sai_recording").string();
+  }
+
+ private:
+  folly::test::TemporaryDirectory tmpDir_;
+};
+
+} // namespace
+
+TEST_F(SaiRecorderTest, RecordAndParse) {
+  sai_attribute_t vlanId;
+  vlanId.id = SAI_VLAN_ATTR_VLAN_ID;
+  vlanId.value.u16 = 42;
+  sai_route_entry_t routeEntry{};
+  routeEntry.switch_id = kSwitchId;
+  routeEntry.vr_id = 5;
+
+  SaiRecorder recorder(recordingPath());
+  auto begin = SaiRecorder::now();
+  recorder.recordCreate(
+      SAI_OBJECT_TYPE_VLAN,
+      kVlanId,
+      kSwitchId,
+      1,
+      &vlanId,
+      SAI_STATUS_SUCCESS,
+      begin);
+  recorder.recordEntry(
+      SaiRecordedOp::CREATE,
+      SAI_OBJECT_TYPE_ROUTE_ENTRY,
+      &routeEntry,
+      0,
+      nullptr,
+      SAI_STATUS_SUCCESS,
+      begin);
+  recorder.recordRemove(
+      SAI_OBJECT_TYPE_VLAN, kVlanId, SAI_STATUS_OBJECT_IN_USE, begin);
+  recorder.flush();
+  EXPECT_TRUE(recorder.isRecording());
+
+  auto calls = readSaiRecording(recordingPath());
+  ASSERT_EQ(calls.size(), 3);
+
+  EXPECT_EQ(calls[0].op, SaiRecordedOp::CREATE);
+  EXPECT_EQ(calls[0].objectType, SAI_OBJECT_TYPE_VLAN);
+  EXPECT_EQ(calls[0].objectId, kVlanId);
+  EXPECT_EQ(calls[0].switchId, kSwitchId);
+  ASSERT_EQ(calls[0].attributes.size(), 1);
+  EXPECT_EQ(calls[0].attributes[0].id, SAI_VLAN_ATTR_VLAN_ID);
+  EXPECT_EQ(calls[0].attributes[0].kind, SaiRecordedValueKind::VALUE);
+  EXPECT_EQ(calls[0].attributes[0].value.u16, 42);
+  EXPECT_EQ(calls[0].status, SAI_STATUS_SUCCESS);
+
+  EXPECT_EQ(calls[1].op, SaiRecordedOp::CREATE);
+  EXPECT_EQ(calls[1].objectType, SAI_OBJECT_TYPE_ROUTE_ENTRY);
+  ASSERT_EQ(calls[1].entry.size(), sizeof(routeEntry));
+  EXPECT_EQ(
+      std::memcmp(calls[1].entry.data(), &routeEntry, sizeof(routeEntry)), 0);
+  EXPECT_TRUE(calls[1].attributes.empty());
+
+  EXPECT_EQ(calls[2].op, SaiRecordedOp::REMOVE);
+  EXPECT_EQ(calls[2].objectId, kVlanId);
+  EXPECT_EQ(calls[2].status, SAI_STATUS_OBJECT_IN_USE);
+}
+
+TEST_F(SaiRecorderTest, WriteFullBuffersInOrder) {
+  // Enough calls to fill several buffers for the writer thread
+  constexpr sai_object_id_t kNumCalls = 100000;
+  {
+    SaiRecorder recorder(recordingPath());
+    for (sai_object_id_t id = 1; id <= kNumCalls; ++id) {
+      recorder.recordRemove(
+          SAI_OBJECT_TYPE_VLAN, id, SAI_STATUS_SUCCESS, SaiRecorder::now());
+    }
+    // Remaining calls are written out on destruction
+  }
+  auto calls = readSaiRecording(recordingPath());
+  ASSERT_EQ(calls.size(), kNumCalls);
+  for (sai_object_id_t id = 1; id <= kNumCalls; ++id) {
+    EXPECT_EQ(calls[id - 1].objectId, id);
+  }
+}
+
+TEST_F(SaiRecorderTest, WriteErrorDisablesRecording) {
+  // Writes to /dev/full fail with ENOSPC
+  SaiRecorder recorder("/dev/full");
+  recorder.recordRemove(
+      SAI_OBJECT_TYPE_VLAN, kVlanId, SAI_STATUS_SUCCESS, SaiRecorder::now());
+  EXPECT_NO_THROW(recorder.flush());
+  EXPECT_FALSE(recorder.isRecording());
+  EXPECT_NO_THROW(recorder.recordRemove(
+      SAI_OBJECT_TYPE_VLAN, kVlanId, SAI_STATUS_SUCCESS, SaiRecorder::now()));
+}
@@ -0,0 +1,171 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/tracer/replay/SaiRecordingReplayer.h"
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/hw/sai/fake/FakeSai.h"
+#include "fboss/agent/hw/sai/tracer/SaiRecording.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss;
+
+namespace {
+
+constexpr sai_object_id_t kRecordedVlanId = 1000;
+constexpr sai_object_id_t kRecordedVlanMemberId = 1001;
+constexpr sai_object_id_t kBridgePortId = 77;
+
+SaiRecordedAttribute valueAttr(sai_attr_id_t id, sai_attribute_value_t value) {
+  SaiRecordedAttribute attr;
+  attr.id = id;
+  attr.kind = SaiRecordedValueKind::VALUE;
+  attr.value = value;
+  return attr;
+}
+
+SaiRecordedAttribute oidAttr(sai_attr_id_t id, sai_object_id_t oid) {
+  SaiRecordedAttribute attr;
+  attr.id = id;
+  attr.kind = SaiRecordedValueKind::OBJECT_ID;
+  attr.value.oid = oid;
+  return attr;
+}
+
+SaiRecordedCall recordedCall(
+    SaiRecordedOp op,
+    sai_object_type_t objectType,
+    sai_object_id_t objectId,
+    std::vector<SaiRecordedAttribute> attributes = {}) {
+  SaiRecordedCall call;
+  call.op = op;
+  call.objectType = objectType;
+  call.objectId = objectId;
+  call.attributes = std::move(attributes);
+  call.duration = std::chrono::microseconds(10);
+  return call;
+}
+
+std::vector<SaiRecordedCall> vlanMemberCalls() {
+  sai_attribute_value_t vlanId{};
+  vlanId.u16 = 42;
+  return {
+      recordedCall(
+          SaiRecordedOp::CREATE,
+          SAI_OBJECT_TYPE_VLAN,
+          kRecordedVlanId,
+          {valueAttr(SAI_VLAN_ATTR_VLAN_ID, vlanId)}),
+      recordedCall(
+          SaiRecordedOp::CREATE,
+          SAI_OBJECT_TYPE_VLAN_MEMBER,
+          kRecordedVlanMemberId,
+          {oidAttr(SAI_VLAN_MEMBER_ATTR_VLAN_ID, kRecordedVlanId),
+           oidAttr(SAI_VLAN_MEMBER_ATTR_BRIDGE_PORT_ID, kBridgePortId)}),
+      recordedCall(
+          SaiRecordedOp::REMOVE,
+          SAI_OBJECT_TYPE_VLAN_MEMBER,
+          kRecordedVlanMemberId),
+  };
+}
+
+} // namespace
+
+class SaiRecordingReplayerTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    fs = FakeSai::getInstance();
+    if (!fs->initialized) {
+      ASSERT_EQ(sai_api_initialize(0, nullptr), SAI_STATUS_SUCCESS);
+    }
+  }
+  void TearDown() override {
+    FakeSai::clear();
+  }
+  std::shared_ptr<FakeSai> fs;
+};
+
+TEST_F(SaiRecordingReplayerTest, serDeser) {
+  auto calls = vlanMemberCalls();
+  SaiRecordedAttribute ports;
+  ports.id = SAI_VLAN_ATTR_MEMBER_LIST;
+  ports.kind = SaiRecordedValueKind::OBJECT_LIST;
+  ports.elementSize = sizeof(sai_object_id_t);
+  ports.elements.resize(3 * sizeof(sai_object_id_t), 0xab);
+  calls[0].attributes.push_back(ports);
+  calls[0].start = std::chrono::milliseconds(5);
+
+  auto recording = saiRecordingHeader();
+  for (const auto& call : calls) {
+    appendSaiRecordedCall(call, recording);
+  }
+  auto parsed =
+      parseSaiRecording(folly::ByteRange(folly::StringPiece(recording)));
+
+  ASSERT_EQ(parsed.size(), calls.size());
+  for (size_t i = 0; i < calls.size(); ++i) {
+    EXPECT_EQ(parsed[i].op, calls[i].op);
+    EXPECT_EQ(parsed[i].objectType, calls[i].objectType);
+    EXPECT_EQ(parsed[i].objectId, calls[i].objectId);
+    EXPECT_EQ(parsed[i].start, calls[i].start);
+    EXPECT_EQ(parsed[i].duration, calls[i].duration);
+    ASSERT_EQ(parsed[i].attributes.size(), calls[i].attributes.size());
+    for (size_t j = 0; j < calls[i].attributes.size(); ++j) {
+      const auto& attr = parsed[i].attributes[j];
+      EXPECT_EQ(attr.id, calls[i].attributes[j].id);
+      EXPECT_EQ(attr.kind, calls[i].attributes[j].kind);
+      EXPECT_EQ(attr.elements, calls[i].attributes[j].elements);
+    }
+  }
+  EXPECT_EQ(parsed[0].attributes[0].value.u16, 42);
+  EXPECT_EQ(parsed[1].attributes[0].value.oid, kRecordedVlanId);
+
+  recording.pop_back();
+  EXPECT_THROW(
+      parseSaiRecording(folly::ByteRange(folly::StringPiece(recording))),
+      FbossError);
+}
+
+TEST_F(SaiRecordingReplayerTest, replayRemapsObjectIds) {
+  auto calls = vlanMemberCalls();
+  // Keep the member this time, to check what it was created with
+  calls.pop_back();
+  // No API to replay this on, should be skipped rather than fail the replay
+  calls.push_back(recordedCall(
+      SaiRecordedOp::REMOVE, SAI_OBJECT_TYPE_TAM_REPORT, kRecordedVlanId));
+
+  SaiRecordingReplayer replayer;
+  auto report = replayer.replay(calls);
+
+  EXPECT_EQ(report.skipped, 1);
+  EXPECT_EQ(report.apis.size(), 2);
+  for (const auto& [api, stats] : report.apis) {
+    EXPECT_EQ(stats.replayed.size(), 1) << api;
+    EXPECT_EQ(stats.mismatched, 0) << api;
+  }
+  EXPECT_EQ(report.recordedTime, std::chrono::microseconds(20));
+
+  ASSERT_EQ(fs->vlanManager.map().size(), 1);
+  const auto& [vlanId, vlan] = *fs->vlanManager.map().begin();
+  EXPECT_EQ(vlan.vlanId, 42);
+  ASSERT_EQ(vlan.fm().map().size(), 1);
+  const auto& member = vlan.fm().map().begin()->second;
+  EXPECT_EQ(member.vlanId, vlanId);
+  EXPECT_EQ(member.bridgePortId, kBridgePortId);
+}
+
+TEST_F(SaiRecordingReplayerTest, replayRemove) {
+  SaiRecordingReplayer replayer;
+  auto report = replayer.replay(vlanMemberCalls());
+
+  EXPECT_EQ(report.skipped, 0);
+  EXPECT_EQ(report.apis.at("remove vlan-member").mismatched, 0);
+  ASSERT_EQ(fs->vlanManager.map().size(), 1);
+  EXPECT_TRUE(fs->vlanManager.map().begin()->second.fm().map().empty());
+}
@@ -0,0 +1,294 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/HwFb303Stats.h"
+#include "fboss/agent/hw/HwPortFb303Stats.h"
+#include "fboss/agent/hw/HwSysPortFb303Stats.h"
+#include "fboss/agent/hw/StatsConstants.h"
+
+#include <folly/Benchmark.h>
+#include <gflags/gflags.h>
+
+DEFINE_int32(bench_sys_ports, 20000, "Number of system ports");
+DEFINE_int32(bench_sys_port_queues, 8, "Number of queues per system port");
+DEFINE_int32(bench_ports, 512, "Number of ports");
+DEFINE_int32(bench_port_queues, 8, "Number of queues per port");
+DEFINE_int32(bench_port_pfc_priorities, 2, "Number of PFC priorities per port");
+
+using namespace facebook::fboss;
+
+namespace {
+
+std::string sysPortName(int port) {
+  return folly::to<std::string>("rdsw", port / 512, ":eth1/", port % 512, "/1");
+}
+
+HwBasePortFb303Stats::QueueId2Name queueId2Name(int numQueues) {
+  HwBasePortFb303Stats::QueueId2Name queues;
+  for (auto queue = 0; queue < numQueues; ++queue) {
+    queues.emplace(queue, folly::to<std::string>("queue", queue));
+  }
+  return queues;
+}
+
+HwSysPortStats sysPortStats(int64_t value) {
+  HwSysPortStats stats;
+  for (auto queue = 0; queue < FLAGS_bench_sys_port_queues; ++queue) {
+    stats.queueOutDiscardBytes_()[queue] = value;
+    stats.queueOutBytes_()[queue] = value;
+    stats.queueWredDroppedPackets_()[queue] = value;
+    stats.queueCreditWatchdogDeletedPackets_()[queue] = value;
+    stats.queueLatencyWatermarkNsec_()[queue] = value;
+  }
+  return stats;
+}
+
+std::string portName(int port) {
+  return folly::to<std::string>("eth1/", port / 4 + 1, "/", port % 4 + 1);
+}
+
+std::vector<PfcPriority> pfcPriorities() {
+  std::vector<PfcPriority> priorities;
+  for (auto priority = 0; priority < FLAGS_bench_port_pfc_priorities;
+       ++priority) {
+    priorities.push_back(static_cast<PfcPriority>(priority));
+  }
+  return priorities;
+}
+
+// Port stats with every stat HwPortFb303Stats updates populated
+HwPortStats hwPortStats(int64_t value) {
+  HwPortStats stats;
+  for (auto* stat :
+       {&*stats.inBytes_(),
+        &*stats.inUnicastPkts_(),
+        &*stats.inMulticastPkts_(),
+        &*stats.inBroadcastPkts_(),
+        &*stats.inDiscards_(),
+        &*stats.inErrors_(),
+        &*stats.inPause_(),
+        &*stats.inIpv4HdrErrors_(),
+        &*stats.inIpv6HdrErrors_(),
+        &*stats.inDstNullDiscards_(),
+        &*stats.inDiscardsRaw_(),
+        &*stats.outBytes_(),
+        &*stats.outUnicastPkts_(),
+        &*stats.outMulticastPkts_(),
+        &*stats.outBroadcastPkts_(),
+        &*stats.outDiscards_(),
+        &*stats.outErrors_(),
+        &*stats.outPause_(),
+        &*stats.outCongestionDiscardPkts_(),
+        &*stats.wredDroppedPackets_(),
+        &*stats.outEcnCounter_(),
+        &*stats.fecCorrectableErrors(),
+        &*stats.fecUncorrectableErrors(),
+        &*stats.inLabelMissDiscards_(),
+        &*stats.inCongestionDiscards_()}) {
+    *stat = value;
+  }
+  stats.leakyBucketFlapCount_() = value;
+  stats.inAclDiscards_() = value;
+  stats.inTrapDiscards_() = value;
+  stats.outForwardingDiscards_() = value;
+  stats.pqpErrorEgressDroppedPackets_() = value;
+  stats.fabricLinkDownDroppedCells_() = value;
+  stats.linkLayerFlowControlWatermark_() = value;
+  for (auto queue = 0; queue < FLAGS_bench_port_queues; ++queue) {
+    stats.queueOutDiscardBytes_()[queue] = value;
+    stats.queueOutDiscardPackets_()[queue] = value;
+    stats.queueOutBytes_()[queue] = value;
+    stats.queueOutPackets_()[queue] = value;
+    stats.queueWredDroppedPackets_()[queue] = value;
+    stats.queueEcnMarkedPackets_()[queue] = value;
+  }
+  for (auto priority : pfcPriorities()) {
+    stats.inPfc_()[priority] = value;
+    stats.inPfcXon_()[priority] = value;
+    stats.outPfc_()[priority] = value;
+  }
+  return stats;
+}
+
+} // namespace
+
+/*
+ * A stats cycle on a switch with FLAGS_bench_ports ports, updating every
+ * port, queue and PFC stat by name, which is how HwPortFb303Stats used to
+ * update them. Like HwPortFb303Stats::updateStats, this keeps a copy of
+ * the latest stats.
+ */
+BENCHMARK(PortStatsUpdateByName, iters) {
+  folly::BenchmarkSuspender suspender;
+  HwFb303Stats stats(std::nullopt);
+  std::vector<std::string> portNames;
+  auto queues = queueId2Name(FLAGS_bench_port_queues);
+  auto priorities = pfcPriorities();
+  // No queues or PFC priorities, so this registers no queue or PFC counters
+  HwPortFb303Stats keys("keys");
+  const auto& portStatKeys = keys.kPortMonotonicCounterStatKeys();
+  const auto& queueStatKeys = keys.kQueueMonotonicCounterStatKeys();
+  const auto& pfcStatKeys = keys.kPfcMonotonicCounterStatKeys();
+  for (auto port = 0; port < FLAGS_bench_ports; ++port) {
+    portNames.push_back(portName(port));
+    const auto& name = portNames.back();
+    for (auto statKey : portStatKeys) {
+      stats.reinitStat(
+          HwBasePortFb303Stats::statName(statKey, name), std::nullopt);
+    }
+    for (const auto& [queueId, queueName] : queues) {
+      for (auto statKey : queueStatKeys) {
+        stats.reinitStat(
+            HwBasePortFb303Stats::statName(statKey, name, queueId, queueName),
+            std::nullopt);
+      }
+    }
+    for (auto statKey : pfcStatKeys) {
+      stats.reinitStat(
+          HwBasePortFb303Stats::statName(statKey, name), std::nullopt);
+      for (auto priority : priorities) {
+        stats.reinitStat(
+            HwBasePortFb303Stats::statName(statKey, name, priority),
+            std::nullopt);
+      }
+    }
+  }
+  std::vector<HwPortStats> latestStats;
+  for (unsigned i = 0; i < iters; ++i) {
+    latestStats.push_back(hwPortStats(i));
+  }
+  HwPortStats lastStats;
+  suspender.dismiss();
+
+  for (unsigned i = 0; i < iters; ++i) {
+    std::chrono::seconds now(i + 1);
+    for (const auto& name : portNames) {
+      for (auto statKey : portStatKeys) {
+        stats.updateStat(
+            now, HwBasePortFb303Stats::statName(statKey, name), i);
+      }
+      for (const auto& [queueId, queueName] : queues) {
+        for (auto statKey : queueStatKeys) {
+          stats.updateStat(
+              now,
+              HwBasePortFb303Stats::statName(
+                  statKey, name, queueId, queueName),
+              i);
+        }
+      }
+      for (auto statKey : pfcStatKeys) {
+        for (auto priority : priorities) {
+          stats.updateStat(
+              now,
+              HwBasePortFb303Stats::statName(statKey, name, priority),
+              i);
+        }
+        stats.updateStat(
+            now, HwBasePortFb303Stats::statName(statKey, name), i);
+      }
+      lastStats = latestStats[i];
+    }
+  }
+  folly::doNotOptimizeAway(lastStats);
+}
+
+BENCHMARK_RELATIVE(PortStatsUpdateByHandle, iters) {
+  folly::BenchmarkSuspender suspender;
+  std::vector<std::unique_ptr<HwPortFb303Stats>> portStats;
+  auto queues = queueId2Name(FLAGS_bench_port_queues);
+  auto priorities = pfcPriorities();
+  for (auto port = 0; port < FLAGS_bench_ports; ++port) {
+    portStats.push_back(std::make_unique<HwPortFb303Stats>(
+        portName(port), queues, priorities));
+  }
+  std::vector<HwPortStats> latestStats;
+  for (unsigned i = 0; i < iters; ++i) {
+    latestStats.push_back(hwPortStats(i));
+  }
+  suspender.dismiss();
+
+  for (unsigned i = 0; i < iters; ++i) {
+    std::chrono::seconds now(i + 1);
+    for (auto& stats : portStats) {
+      stats->updateStats(latestStats[i], now);
+    }
+  }
+}
+
+BENCHMARK_DRAW_LINE();
+
+/*
+ * A stats cycle on a VOQ switch, updating every queue stat of every system
+ * port by name, which is how HwSysPortFb303Stats used to update them.
+ */
+BENCHMARK(SysPortQueueStatsUpdateByName, iters) {
+  folly::BenchmarkSuspender suspender;
+  HwFb303Stats stats(std::nullopt);
+  std::vector<std::string> portNames;
+  auto queues = queueId2Name(FLAGS_bench_sys_port_queues);
+  // No queues, so this registers no counters of its own
+  const auto& statKeys =
+      HwSysPortFb303Stats("keys").kQueueMonotonicCounterStatKeys();
+  for (auto port = 0; port < FLAGS_bench_sys_ports; ++port) {
+    portNames.push_back(sysPortName(port));
+    for (const auto& [queueId, queueName] : queues) {
+      for (auto statKey : statKeys) {
+        stats.reinitStat(
+            HwBasePortFb303Stats::statName(
+                statKey, portNames.back(), queueId, queueName),
+            std::nullopt);
+      }
+    }
+  }
+  suspender.dismiss();
+
+  for (unsigned i = 0; i < iters; ++i) {
+    std::chrono::seconds now(i + 1);
+    for (const auto& portName : portNames) {
+      for (const auto& [queueId, queueName] : queues) {
+        for (auto statKey : statKeys) {
+          stats.updateStat(
+              now,
+              HwBasePortFb303Stats::statName(
+                  statKey, portName, queueId, queueName),
+              i);
+        }
+      }
+    }
+  }
+}
+
+BENCHMARK_RELATIVE(SysPortQueueStatsUpdateByHandle, iters) {
+  folly::BenchmarkSuspender suspender;
+  std::vector<std::unique_ptr<HwSysPortFb303Stats>> portStats;
+  auto queues = queueId2Name(FLAGS_bench_sys_port_queues);
+  for (auto port = 0; port < FLAGS_bench_sys_ports; ++port) {
+    portStats.push_back(
+        std::make_unique<HwSysPortFb303Stats>(sysPortName(port), queues));
+  }
+  std::vector<HwSysPortStats> latestStats;
+  for (unsigned i = 0; i < iters; ++i) {
+    latestStats.push_back(sysPortStats(i));
+  }
+  suspender.dismiss();
+
+  for (unsigned i = 0; i < iters; ++i) {
+    std::chrono::seconds now(i + 1);
+    for (auto& stats : portStats) {
+      stats->updateStats(latestStats[i], now);
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
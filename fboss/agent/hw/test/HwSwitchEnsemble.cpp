@@ -163,6 +163,24 @@ class HwEnsembleMultiSwitchThriftHandler
         100 /* buffer size */
     };
   }
+
+  folly::coro::Task<
+      apache::thrift::SinkConsumer<multiswitch::HwSwitchStatsDelta, bool>>
+  co_syncHwStatsDelta(int16_t switchIndex) override {
+    co_return apache::thrift::
+        SinkConsumer<multiswitch::HwSwitchStatsDelta, bool>{
+            [switchIndex](
+                folly::coro::AsyncGenerator<multiswitch::HwSwitchStatsDelta&&>
+                    gen) -> folly::coro::Task<bool> {
+              while (auto item = co_await gen.next()) {
+                XLOG(DBG3) << "Got stats delta from switchIndex "
+                           << switchIndex;
+              }
+              co_return true;
+            },
+            100 /* buffer size */
+        };
+  }
 #endif
 
   void enqueueTxPacket(multiswitch::TxPacket pkt) {
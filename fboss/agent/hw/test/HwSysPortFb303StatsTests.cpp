@@ -247,3 +247,26 @@ TEST(HwSysPortFb303Stats, queueNameChangeResetsValue) {
     }
   }
 }
+
+TEST(HwSysPortFb303Stats, UpdateStatsAfterRename) {
+  constexpr auto kNewPortName = "fab1/1/1";
+  HwSysPortFb303Stats portStats(kPortName, kQueue2Name);
+  portStats.portNameChanged(kNewPortName);
+  portStats.queueChanged(1, "platinum");
+  updateStats(portStats);
+  HwSysPortFb303Stats::QueueId2Name newQueues = {
+      {1, "platinum"}, {2, "silver"}};
+  auto curValue{1};
+  for (auto counterName : portStats.kQueueMonotonicCounterStatKeys()) {
+    for (const auto& queueIdAndName : newQueues) {
+      EXPECT_EQ(
+          portStats.getCounterLastIncrement(HwSysPortFb303Stats::statName(
+              counterName,
+              kNewPortName,
+              queueIdAndName.first,
+              queueIdAndName.second)),
+          curValue);
+    }
+    ++curValue;
+  }
+}
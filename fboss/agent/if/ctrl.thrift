@@ -762,6 +762,28 @@ struct MultiSwitchRunState {
   3: bool multiSwitchEnabled;
 }
 
+// Stack sample of a thread whose heartbeat was late
+struct ThreadStallSample {
+  1: string threadName;
+  // When the sample was taken, ms since epoch
+  2: i64 timestampMsecs;
+  // How late the thread heartbeat was when sampled
+  3: i64 lagMsecs;
+  // Symbolized stack frames, innermost first
+  4: list<string> frames;
+}
+
+// Samples of one counter from the agent's port stats history
+struct PortCounterHistory {
+  1: string portName;
+  // HwPortStats/HwSysPortStats field, suffixed with .<queue> for per queue
+  // counters, e.g. queueOutBytes_.3
+  2: string counter;
+  // Seconds since epoch, oldest first
+  3: list<i64> timestamps;
+  4: list<i64> values;
+}
+
 struct EcmpDetails {
   1: i32 ecmpId;
   2: bool flowletEnabled;
@@ -1095,6 +1117,17 @@ service FbossCtrl extends phy.FbossCommonPhyCtrl {
   map<string, hardware_stats.HwPortStats> getHwPortStats() throws (
     1: fboss.FbossBaseError error,
   );
+  /*
+   * Counter history kept by the agent for the given ports and counters, all
+   * if empty, between beginTime and endTime (seconds since epoch). History
+   * older than --port_stats_history_raw_window_s is downsampled.
+   */
+  list<PortCounterHistory> getPortStatsHistory(
+    1: list<string> ports,
+    2: list<string> counters,
+    3: i64 beginTime,
+    4: i64 endTime,
+  ) throws (1: fboss.FbossBaseError error);
   hardware_stats.CpuPortStats getCpuPortStats() throws (
     1: fboss.FbossBaseError error,
   );
@@ -1464,6 +1497,12 @@ service FbossCtrl extends phy.FbossCommonPhyCtrl {
    * Get SwitchID to SwitchInfo for all SwitchIDs.
    */
   map<i64, switch_config.SwitchInfo> getSwitchIdToSwitchInfo();
+
+  /*
+   * Get the most recent thread stall samples, oldest first. Empty unless the
+   * thread stall profiler is enabled.
+   */
+  list<ThreadStallSample> getThreadStallSamples();
 }
 
 service NeighborListenerClient extends fb303.FacebookService {
@@ -70,6 +70,16 @@ struct RxPacket {
   6: optional ctrl.CpuCosQueueId cosQueue;
 }
 
+/*
+ * Shared memory packet rings created by HwAgent, attached by SwSwitch
+ * through /proc/<pid>/fd/<fd>
+ */
+struct PacketRings {
+  1: i32 pid;
+  2: i32 rxRingFd;
+  3: i32 txRingFd;
+}
+
 struct StateOperDelta {
   1: fsdb_oper.OperDelta operDelta;
   2: bool transaction;
@@ -99,6 +109,45 @@ struct HwSwitchStats {
   16: hardware_stats.HwSwitchWatermarkStats switchWatermarkStats;
 }
 
+/*
+ * Counters of a port or system port that changed since the previous
+ * interval. Keys are (thrift field id << 16) | queue id for the per queue
+ * maps, and thrift field id << 16 for the other integer fields. Values are
+ * the change since the previous interval.
+ */
+struct HwStatsEntryDelta {
+  1: list<i32> counterKeys;
+  2: list<i64> counterDeltas;
+}
+
+/*
+ * HwSwitchStats as the changes since the previous message on the same
+ * connection. The first message after connecting is a full snapshot.
+ * Ports and system ports are keyed by an index assigned the first time
+ * their name is sent.
+ */
+struct HwSwitchStatsDelta {
+  1: i64 timestamp;
+  2: bool fullSnapshot;
+  3: map<i32, string> newPortNames;
+  4: map<i32, string> newSysPortNames;
+  5: map<i32, HwStatsEntryDelta> hwPortStatsDelta;
+  6: map<i32, HwStatsEntryDelta> sysPortStatsDelta;
+  /*
+   * Entries that changed in ways counter deltas can't express (new
+   * entries, set or unset optional fields, non integer fields), sent whole
+   */
+  7: map<i32, hardware_stats.HwPortStats> hwPortStats;
+  8: map<i32, hardware_stats.HwSysPortStats> sysPortStats;
+  9: list<i32> removedPorts;
+  10: list<i32> removedSysPorts;
+  /*
+   * All other HwSwitchStats fields, with hwPortStats and sysPortStats
+   * empty. Only sent when they changed.
+   */
+  11: optional HwSwitchStats otherStats;
+}
+
 service MultiSwitchCtrl {
   /* notify fdb event through sink */
   sink<FdbEvent, bool> notifyFdbEvent(1: i64 switchId);
@@ -106,6 +155,12 @@ service MultiSwitchCtrl {
   /* notify rx packet through sink */
   sink<RxPacket, bool> notifyRxPacket(1: i64 switchId);
 
+  /*
+   * carry rx and tx packets over shared memory rings instead of the
+   * notifyRxPacket sink and getTxPackets stream
+   */
+  void attachPacketRings(1: i64 switchId, 2: PacketRings rings);
+
   /* keep getting tx packet from SwSwitch, through stream */
   stream<TxPacket> getTxPackets(1: i64 switchId);
 
@@ -133,4 +188,8 @@ service MultiSwitchCtrl {
   /* send hardware stats through sink */
   @thrift.Priority{level = thrift.RpcPriority.BEST_EFFORT}
   sink<HwSwitchStats, bool> syncHwStats(1: i16 switchIndex);
+
+  /* send hardware stats as deltas through sink */
+  @thrift.Priority{level = thrift.RpcPriority.BEST_EFFORT}
+  sink<HwSwitchStatsDelta, bool> syncHwStatsDelta(1: i16 switchIndex);
 }
@@ -8,10 +8,25 @@
  *
  */
 #include "fboss/agent/mnpu/HwSwitchStatsSinkClient.h"
+
+#include <folly/Conv.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
 #if FOLLY_HAS_COROUTINES
 #include <folly/coro/BlockingWait.h>
 #endif
 
+namespace {
+std::string statName(
+    const std::optional<std::string>& multiSwitchStatsPrefix,
+    const std::string& name) {
+  return folly::to<std::string>(
+      multiSwitchStatsPrefix ? *multiSwitchStatsPrefix + "." : "",
+      "HwSwitchStatsSinkClient.",
+      name);
+}
+} // namespace
+
 namespace facebook::fboss {
 
 HwSwitchStatsSinkClient::HwSwitchStatsSinkClient(
@@ -20,7 +35,7 @@ HwSwitchStatsSinkClient::HwSwitchStatsSinkClient(
     uint16_t switchIndex,
     folly::EventBase* connRetryEvb,
     std::optional<std::string> multiSwitchStatsPrefix)
-    : ThriftSinkClient<multiswitch::HwSwitchStats, StatsEventQueueType>::
+    : ThriftSinkClient<multiswitch::HwSwitchStatsDelta, StatsEventQueueType>::
           ThriftSinkClient(
               "HwSwitchStatsSinkClient",
               serverPort,
@@ -37,20 +52,49 @@ HwSwitchStatsSinkClient::HwSwitchStatsSinkClient(
               eventQueue_,
 #endif
               connRetryEvb,
-              multiSwitchStatsPrefix) {
+              multiSwitchStatsPrefix),
+      deltaBytes_(
+          statName(multiSwitchStatsPrefix, "delta_bytes"),
+          fb303::SUM,
+          fb303::RATE),
+      encodeCpuUsec_(
+          statName(multiSwitchStatsPrefix, "encode_cpu_us"),
+          fb303::SUM,
+          fb303::RATE),
+      fullSnapshots_(
+          statName(multiSwitchStatsPrefix, "full_snapshots"),
+          fb303::SUM,
+          fb303::RATE) {
 }
 
-ThriftSinkClient<multiswitch::HwSwitchStats, StatsEventQueueType>::
+ThriftSinkClient<multiswitch::HwSwitchStatsDelta, StatsEventQueueType>::
     EventNotifierSinkClient
     HwSwitchStatsSinkClient::initHwSwitchStatsSinkClient(
         SwitchID /*switchId*/,
         uint16_t switchIndex,
         apache::thrift::Client<multiswitch::MultiSwitchCtrl>* client) {
 #if FOLLY_HAS_COROUTINES
-  return folly::coro::blockingWait(client->co_syncHwStats(switchIndex));
+  return folly::coro::blockingWait(client->co_syncHwStatsDelta(switchIndex));
 #else
-  return apache::thrift::ClientSink<multiswitch::HwSwitchStats, bool>();
+  return apache::thrift::ClientSink<multiswitch::HwSwitchStatsDelta, bool>();
 #endif
 }
 
+void HwSwitchStatsSinkClient::updateHwSwitchStats(
+    const multiswitch::HwSwitchStats& stats) {
+  // Deltas queued before a reconnect are either discarded or arrive ahead
+  // of the new snapshot, where SwSwitch drops them
+  if (resync_.exchange(false, std::memory_order_acq_rel)) {
+    encoder_.reset();
+  }
+  auto startUsec = threadCpuTimeUsec();
+  auto delta = encoder_.encode(stats);
+  encodeCpuUsec_.add(threadCpuTimeUsec() - startUsec);
+  deltaBytes_.add(apache::thrift::CompactSerializer::serializedSize(delta));
+  if (*delta.fullSnapshot()) {
+    fullSnapshots_.add(1);
+  }
+  enqueue(std::move(delta));
+}
+
 } // namespace facebook::fboss
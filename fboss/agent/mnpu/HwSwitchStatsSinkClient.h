@@ -8,8 +8,10 @@
  *
  */
 #pragma once
+#include <atomic>
 #include <memory>
 
+#include "fboss/agent/HwSwitchStatsDelta.h"
 #include "fboss/agent/MultiSwitchThriftHandler.h"
 #include "fboss/agent/mnpu/SplitAgentThriftSyncerClient.h"
 
@@ -20,8 +22,13 @@ namespace facebook::fboss {
 
 class HwSwitch;
 
-class HwSwitchStatsSinkClient
-    : public ThriftSinkClient<multiswitch::HwSwitchStats, StatsEventQueueType> {
+/*
+ * Sends HwSwitchStats over the syncHwStatsDelta sink: a full snapshot on
+ * every (re)connect, then only what changed since the previous interval.
+ */
+class HwSwitchStatsSinkClient : public ThriftSinkClient<
+                                    multiswitch::HwSwitchStatsDelta,
+                                    StatsEventQueueType> {
  public:
   HwSwitchStatsSinkClient(
       uint16_t serverPort,
@@ -30,15 +37,25 @@ class HwSwitchStatsSinkClient
       folly::EventBase* connRetryEvb,
       std::optional<std::string> multiSwitchStatsPrefix);
 
-  ThriftSinkClient<multiswitch::HwSwitchStats, StatsEventQueueType>::
+  ThriftSinkClient<multiswitch::HwSwitchStatsDelta, StatsEventQueueType>::
       EventNotifierSinkClient
       initHwSwitchStatsSinkClient(
           SwitchID switchId,
           uint16_t switchIndex,
           apache::thrift::Client<multiswitch::MultiSwitchCtrl>* client);
 
+  // Called from the stats collection thread only
+  void updateHwSwitchStats(const multiswitch::HwSwitchStats& stats);
+
  private:
-  void connected() override {}
+  void connected() override {
+    resync_.store(true, std::memory_order_release);
+  }
+  std::atomic<bool> resync_{true};
+  HwSwitchStatsDeltaEncoder encoder_;
+  fb303::TimeseriesWrapper deltaBytes_;
+  fb303::TimeseriesWrapper encodeCpuUsec_;
+  fb303::TimeseriesWrapper fullSnapshots_;
 #if FOLLY_HAS_COROUTINES
   StatsEventQueueType eventQueue_;
 #endif
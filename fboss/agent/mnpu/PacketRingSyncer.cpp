@@ -0,0 +1,160 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/mnpu/PacketRingSyncer.h"
+
+#include <folly/Conv.h>
+#include <folly/io/Cursor.h>
+#include <folly/logging/xlog.h>
+#include <folly/system/ThreadName.h>
+
+#include "fboss/agent/HwSwitch.h"
+#include "fboss/agent/TxPacket.h"
+
+#if FOLLY_HAS_COROUTINES
+#include <folly/coro/BlockingWait.h>
+#endif
+
+#include <unistd.h>
+
+DEFINE_bool(
+    split_agent_packet_rings,
+    false,
+    "Carry rx and tx packets between hw agent and sw agent over shared "
+    "memory rings instead of thrift sink and stream");
+DEFINE_int32(
+    split_agent_packet_ring_bytes,
+    16 << 20,
+    "Size of each shared memory packet ring");
+
+namespace {
+constexpr auto kTxRingWait = std::chrono::milliseconds(100);
+} // namespace
+
+namespace facebook::fboss {
+
+PacketRingSyncer::PacketRingSyncer(
+    HwSwitch* hw,
+    SwitchID switchId,
+    std::optional<std::string> multiSwitchStatsPrefix)
+    : hw_(hw),
+      switchId_(switchId),
+      rxRing_(ShmPacketRing::create(
+          folly::to<std::string>("fboss_rx_ring_", switchId),
+          FLAGS_split_agent_packet_ring_bytes)),
+      txRing_(ShmPacketRing::create(
+          folly::to<std::string>("fboss_tx_ring_", switchId),
+          FLAGS_split_agent_packet_ring_bytes)),
+      rxPktDropped_(
+          folly::to<std::string>(
+              multiSwitchStatsPrefix ? *multiSwitchStatsPrefix + "." : "",
+              "rx_pkt_ring.events_dropped"),
+          fb303::SUM,
+          fb303::RATE),
+      rxPktSent_(
+          folly::to<std::string>(
+              multiSwitchStatsPrefix ? *multiSwitchStatsPrefix + "." : "",
+              "rx_pkt_ring.events_sent"),
+          fb303::SUM,
+          fb303::RATE),
+      txPktReceived_(
+          folly::to<std::string>(
+              multiSwitchStatsPrefix ? *multiSwitchStatsPrefix + "." : "",
+              "tx_pkt_ring.events_received"),
+          fb303::SUM,
+          fb303::RATE) {
+  txThread_ = std::thread([this] {
+    folly::setThreadName("TxPktRingThread");
+    txLoop();
+  });
+}
+
+PacketRingSyncer::~PacketRingSyncer() {
+  stop();
+}
+
+void PacketRingSyncer::attach(
+    apache::thrift::Client<multiswitch::MultiSwitchCtrl>* client) {
+  multiswitch::PacketRings rings;
+  rings.pid() = ::getpid();
+  rings.rxRingFd() = rxRing_->fd();
+  rings.txRingFd() = txRing_->fd();
+  attached_.store(false, std::memory_order_release);
+  try {
+#if FOLLY_HAS_COROUTINES
+    folly::coro::blockingWait(
+        client->co_attachPacketRings(switchId_, std::move(rings)));
+#else
+    client->sync_attachPacketRings(switchId_, std::move(rings));
+#endif
+    attached_.store(true, std::memory_order_release);
+    XLOG(DBG2) << "Packet rings attached for switch " << switchId_;
+  } catch (const std::exception& ex) {
+    // Older SwSwitch, or one that cannot open the rings. Packets keep
+    // going over thrift.
+    XLOG(ERR) << "Failed to attach packet rings for switch " << switchId_
+              << ", using thrift for packets: " << ex.what();
+  }
+}
+
+void PacketRingSyncer::sendRxPacket(
+    const ShmPacketRing::PacketInfo& info,
+    const folly::IOBuf& buf) {
+  if (rxRing_->tryPush(info, buf)) {
+    rxPktSent_.add(1);
+  } else {
+    rxPktDropped_.add(1);
+  }
+}
+
+void PacketRingSyncer::txLoop() {
+  while (!exiting_.load(std::memory_order_acquire)) {
+    auto pkt = txRing_->tryPop();
+    if (!pkt) {
+      txRing_->wait(kTxRingWait);
+      continue;
+    }
+    txPktReceived_.add(1);
+    sendTxPacket(*pkt);
+  }
+}
+
+void PacketRingSyncer::sendTxPacket(ShmPacketRing::Packet& txPkt) {
+  if (hw_->getRunState() == SwitchRunState::EXITING) {
+    XLOG(DBG4) << "PacketRingSyncer: hwswitch exiting, dropping packet";
+    return;
+  }
+  auto len = txPkt.buf->computeChainDataLength();
+  auto pkt = hw_->allocatePacket(len);
+  folly::io::Cursor inCursor(txPkt.buf.get());
+  folly::io::RWPrivateCursor outCursor(pkt->buf());
+  outCursor.pushAtMost(inCursor, len);
+
+  if (txPkt.info.port) {
+    std::optional<uint8_t> queue;
+    if (txPkt.info.queue) {
+      queue = static_cast<uint8_t>(*txPkt.info.queue);
+    }
+    hw_->sendPacketOutOfPortAsync(
+        std::move(pkt), PortID(*txPkt.info.port), queue);
+  } else {
+    hw_->sendPacketSwitchedAsync(std::move(pkt));
+  }
+}
+
+void PacketRingSyncer::stop() {
+  if (exiting_.exchange(true)) {
+    return;
+  }
+  attached_.store(false, std::memory_order_release);
+  txRing_->notify();
+  txThread_.join();
+}
+
+} // namespace facebook::fboss
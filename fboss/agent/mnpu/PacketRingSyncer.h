@@ -0,0 +1,69 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include <fb303/ThreadCachedServiceData.h>
+#include <gflags/gflags.h>
+
+#include "fboss/agent/if/gen-cpp2/MultiSwitchCtrl.h"
+#include "fboss/agent/types.h"
+#include "fboss/lib/ShmPacketRing.h"
+
+DECLARE_bool(split_agent_packet_rings);
+
+namespace facebook::fboss {
+
+class HwSwitch;
+
+/*
+ * HwAgent side of the shared memory packet rings. Rx packets are pushed to
+ * the rx ring instead of the notifyRxPacket sink, and tx packets are popped
+ * from the tx ring instead of the getTxPackets stream, once SwSwitch has
+ * attached to the rings.
+ */
+class PacketRingSyncer {
+ public:
+  PacketRingSyncer(
+      HwSwitch* hw,
+      SwitchID switchId,
+      std::optional<std::string> multiSwitchStatsPrefix);
+  ~PacketRingSyncer();
+
+  // Hands the rings to SwSwitch, on every (re)connect
+  void attach(apache::thrift::Client<multiswitch::MultiSwitchCtrl>* client);
+  bool isAttached() const {
+    return attached_.load(std::memory_order_acquire);
+  }
+  void sendRxPacket(
+      const ShmPacketRing::PacketInfo& info,
+      const folly::IOBuf& buf);
+  void stop();
+
+ private:
+  void txLoop();
+  void sendTxPacket(ShmPacketRing::Packet& pkt);
+
+  HwSwitch* hw_;
+  SwitchID switchId_;
+  std::unique_ptr<ShmPacketRing> rxRing_;
+  std::unique_ptr<ShmPacketRing> txRing_;
+  std::atomic<bool> attached_{false};
+  std::atomic<bool> exiting_{false};
+  fb303::TimeseriesWrapper rxPktDropped_;
+  fb303::TimeseriesWrapper rxPktSent_;
+  fb303::TimeseriesWrapper txPktReceived_;
+  std::thread txThread_;
+};
+
+} // namespace facebook::fboss
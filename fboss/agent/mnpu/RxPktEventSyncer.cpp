@@ -8,6 +8,7 @@
  *
  */
 #include "fboss/agent/mnpu/RxPktEventSyncer.h"
+#include "fboss/agent/mnpu/PacketRingSyncer.h"
 #if FOLLY_HAS_COROUTINES
 #include <folly/coro/BlockingWait.h>
 #endif
@@ -18,13 +19,24 @@ RxPktEventSyncer::RxPktEventSyncer(
     uint16_t serverPort,
     SwitchID switchId,
     folly::EventBase* connRetryEvb,
-    std::optional<std::string> multiSwitchStatsPrefix)
+    std::optional<std::string> multiSwitchStatsPrefix,
+    PacketRingSyncer* packetRings)
     : ThriftSinkClient<multiswitch::RxPacket, RxPktEventQueueType>::
           ThriftSinkClient(
               "RxPktEventThriftSyncer",
               serverPort,
               switchId,
-              RxPktEventSyncer::initRxPktEventSink,
+              [packetRings](
+                  SwitchID switchId,
+                  apache::thrift::Client<multiswitch::MultiSwitchCtrl>*
+                      client) {
+                // Rings are handed over before the sink is opened, so
+                // SwSwitch is ready for packets on either
+                if (packetRings) {
+                  packetRings->attach(client);
+                }
+                return RxPktEventSyncer::initRxPktEventSink(switchId, client);
+              },
               std::make_shared<folly::ScopedEventBaseThread>(
                   "RxPktEventSyncerThread"),
 #if FOLLY_HAS_COROUTINES
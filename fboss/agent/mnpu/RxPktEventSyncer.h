@@ -19,6 +19,7 @@
 namespace facebook::fboss {
 
 class HwSwitch;
+class PacketRingSyncer;
 
 class RxPktEventSyncer
     : public ThriftSinkClient<multiswitch::RxPacket, RxPktEventQueueType> {
@@ -27,7 +28,8 @@ class RxPktEventSyncer
       uint16_t serverPort,
       SwitchID switchId,
       folly::EventBase* connRetryEvb,
-      std::optional<std::string> multiSwitchStatsPrefix);
+      std::optional<std::string> multiSwitchStatsPrefix,
+      PacketRingSyncer* packetRings = nullptr);
 
   static ThriftSinkClient<multiswitch::RxPacket, RxPktEventQueueType>::
       EventNotifierSinkClient
@@ -13,6 +13,7 @@
 #include "fboss/agent/mnpu/HwSwitchStatsSinkClient.h"
 #include "fboss/agent/mnpu/LinkChangeEventSyncer.h"
 #include "fboss/agent/mnpu/OperDeltaSyncer.h"
+#include "fboss/agent/mnpu/PacketRingSyncer.h"
 #include "fboss/agent/mnpu/RxPktEventSyncer.h"
 #include "fboss/agent/mnpu/SwitchReachabilityChangeEventSyncer.h"
 #include "fboss/agent/mnpu/TxPktEventSyncer.h"
@@ -48,11 +49,19 @@ SplitAgentThriftSyncer::SplitAgentThriftSyncer(
           switchId_,
           retryThread_->getEventBase(),
           multiSwitchStatsPrefix)),
+      packetRingSyncer_(
+          FLAGS_split_agent_packet_rings
+              ? std::make_unique<PacketRingSyncer>(
+                    hw,
+                    switchId_,
+                    multiSwitchStatsPrefix)
+              : nullptr),
       rxPktEventSinkClient_(std::make_unique<RxPktEventSyncer>(
           serverPort,
           switchId_,
           retryThread_->getEventBase(),
-          multiSwitchStatsPrefix)),
+          multiSwitchStatsPrefix,
+          packetRingSyncer_.get())),
       hwSwitchStatsSinkClient_(std::make_unique<HwSwitchStatsSinkClient>(
           serverPort,
           switchId_,
@@ -83,6 +92,17 @@ void SplitAgentThriftSyncer::packetReceived(
         hwSwitch_->getPlatform()->getAsic(),
         hwSwitch_->getSwitchStats());
   }
+  if (packetRingSyncer_ && packetRingSyncer_->isAttached()) {
+    ShmPacketRing::PacketInfo info;
+    info.port = *rxPkt.port();
+    info.vlan = rxPkt.vlan().to_optional();
+    info.aggPort = rxPkt.aggPort().to_optional();
+    if (rxPkt.cosQueue()) {
+      info.queue = static_cast<int16_t>(*rxPkt.cosQueue());
+    }
+    packetRingSyncer_->sendRxPacket(info, *pkt->buf());
+    return;
+  }
   // coalesce the IOBuf before copy
   pkt->buf()->coalesce();
   rxPkt.data() = IOBuf::copyBuffer(pkt->buf()->data(), pkt->buf()->length());
@@ -181,7 +201,7 @@ void SplitAgentThriftSyncer::l2LearningUpdateReceived(
 void SplitAgentThriftSyncer::updateHwSwitchStats(
     multiswitch::HwSwitchStats stats) {
   if (hwSwitchStatsSinkClient_->isConnectedToServer()) {
-    hwSwitchStatsSinkClient_->enqueue(std::move(stats));
+    hwSwitchStatsSinkClient_->updateHwSwitchStats(stats);
   }
 }
 
@@ -214,6 +234,9 @@ void SplitAgentThriftSyncer::start() {
 
 void SplitAgentThriftSyncer::stop() {
   // Stop any started services
+  if (packetRingSyncer_) {
+    packetRingSyncer_->stop();
+  }
   linkChangeEventSinkClient_->cancel();
   txPktEventStreamClient_->cancel();
   fdbEventSinkClient_->cancel();
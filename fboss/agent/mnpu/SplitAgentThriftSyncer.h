@@ -28,6 +28,7 @@ class LinkChangeEventSyncer;
 class RxPktEventSyncer;
 class TxPktEventSyncer;
 class OperDeltaSyncer;
+class PacketRingSyncer;
 class HwSwitchStatsSinkClient;
 class SwitchReachabilityChangeEventSyncer;
 
@@ -83,6 +84,8 @@ class SplitAgentThriftSyncer : public HwSwitchCallback {
   std::unique_ptr<TxPktEventSyncer> txPktEventStreamClient_;
   std::unique_ptr<OperDeltaSyncer> operDeltaClient_;
   std::unique_ptr<FdbEventSyncer> fdbEventSinkClient_;
+  // Only with --split_agent_packet_rings
+  std::unique_ptr<PacketRingSyncer> packetRingSyncer_;
   std::unique_ptr<RxPktEventSyncer> rxPktEventSinkClient_;
   std::unique_ptr<HwSwitchStatsSinkClient> hwSwitchStatsSinkClient_;
   std::unique_ptr<SwitchReachabilityChangeEventSyncer>
@@ -318,7 +318,7 @@ template class ThriftSinkClient<multiswitch::FdbEvent, FdbEventQueueType>;
 template class ThriftSinkClient<multiswitch::RxPacket, RxPktEventQueueType>;
 template class ThriftStreamClient<multiswitch::TxPacket>;
 template class ThriftSinkClient<
-    multiswitch::HwSwitchStats,
+    multiswitch::HwSwitchStatsDelta,
     StatsEventQueueType>;
 template class ThriftSinkClient<
     multiswitch::SwitchReachabilityChangeEvent,
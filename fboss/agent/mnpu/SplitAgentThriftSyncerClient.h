@@ -82,11 +82,11 @@ using FdbEventQueueType = std::queue<multiswitch::FdbEvent>;
 
 #if FOLLY_HAS_COROUTINES
 using StatsEventQueueType = folly::coro::UnboundedQueue<
-    multiswitch::HwSwitchStats,
+    multiswitch::HwSwitchStatsDelta,
     true /*SingleProducer*/,
     true /* SingleConsumer*/>;
 #else
-using FdbEventQueueType = std::queue<multiswitch::HwSwitchStats>;
+using StatsEventQueueType = std::queue<multiswitch::HwSwitchStatsDelta>;
 #endif
 
 #if FOLLY_HAS_COROUTINES
@@ -149,3 +149,14 @@ struct PlatformMapping {
   5: optional list<PlatformPortConfigOverride> portConfigOverrides;
   7: list<PlatformPortProfileConfigEntry> platformSupportedProfiles;
 }
+
+/*
+ * PlatformMapping precompiled at build time, see PlatformMapping::compile().
+ * Port entries are serialized individually with CompactProtocol so that
+ * they can be decoded on first access instead of all at startup.
+ */
+struct CompiledPlatformMapping {
+  // Everything except the ports
+  1: PlatformMapping mapping;
+  2: map<i32, binary> ports;
+}
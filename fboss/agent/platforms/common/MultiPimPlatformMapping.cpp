@@ -20,7 +20,7 @@ namespace facebook::fboss {
 MultiPimPlatformMapping::MultiPimPlatformMapping(
     const std::string& jsonPlatformMappingStr)
     : PlatformMapping(jsonPlatformMappingStr) {
-  for (auto& port : platformPorts_) {
+  for (const auto& port : getPlatformPorts()) {
     int portPimID = getPimID(port.second);
 
     if (pims_.find(portPimID) == pims_.end()) {
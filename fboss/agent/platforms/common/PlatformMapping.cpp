@@ -166,6 +166,29 @@ PlatformMapping::PlatformMapping(const cfg::PlatformMapping& mapping) {
   init(mapping);
 }
 
+PlatformMapping::PlatformMapping(folly::ByteRange compiledPlatformMapping) {
+  auto compiled = apache::thrift::CompactSerializer::deserialize<
+      cfg::CompiledPlatformMapping>(compiledPlatformMapping);
+  init(*compiled.mapping());
+  encodedPlatformPorts_ = std::move(*compiled.ports());
+  hasEncodedPlatformPorts_ = !encodedPlatformPorts_.empty();
+}
+
+std::string PlatformMapping::compile(const cfg::PlatformMapping& mapping) {
+  cfg::CompiledPlatformMapping compiled;
+  compiled.mapping()->chips() = *mapping.chips();
+  compiled.mapping()->platformSettings().copy_from(mapping.platformSettings());
+  compiled.mapping()->portConfigOverrides().copy_from(
+      mapping.portConfigOverrides());
+  compiled.mapping()->platformSupportedProfiles() =
+      *mapping.platformSupportedProfiles();
+  for (const auto& [portId, port] : *mapping.ports()) {
+    (*compiled.ports())[portId] =
+        apache::thrift::CompactSerializer::serialize<std::string>(port);
+  }
+  return apache::thrift::CompactSerializer::serialize<std::string>(compiled);
+}
+
 void PlatformMapping::init(const cfg::PlatformMapping& mapping) {
   platformPorts_ = std::move(*mapping.ports());
   platformSupportedProfiles_ = std::move(*mapping.platformSupportedProfiles());
@@ -179,7 +202,7 @@ void PlatformMapping::init(const cfg::PlatformMapping& mapping) {
 
 cfg::PlatformMapping PlatformMapping::toThrift() const {
   cfg::PlatformMapping newMapping;
-  newMapping.ports() = this->platformPorts_;
+  newMapping.ports() = getPlatformPorts();
   newMapping.platformSupportedProfiles() = this->platformSupportedProfiles_;
   for (const auto& nameChipPair : this->chips_) {
     newMapping.chips()->push_back(nameChipPair.second);
@@ -189,7 +212,8 @@ cfg::PlatformMapping PlatformMapping::toThrift() const {
 }
 
 void PlatformMapping::merge(PlatformMapping* mapping) {
-  for (auto port : mapping->platformPorts_) {
+  decodePlatformPorts();
+  for (auto port : mapping->getPlatformPorts()) {
     platformPorts_.emplace(port.first, std::move(port.second));
     mergePortConfigOverrides(
         port.first, mapping->getPortConfigOverrides(port.first));
@@ -251,11 +275,11 @@ void PlatformMapping::mergePlatformSupportedProfile(
 }
 
 int PlatformMapping::getPimID(PortID portID) const {
-  auto itPlatformPort = platformPorts_.find(portID);
-  if (itPlatformPort == platformPorts_.end()) {
+  auto platformPort = findPlatformPort(portID);
+  if (!platformPort) {
     throw FbossError("Unrecoganized port:", portID);
   }
-  return getPimID(itPlatformPort->second);
+  return getPimID(*platformPort);
 }
 
 int PlatformMapping::getPimID(
@@ -275,23 +299,22 @@ int PlatformMapping::getPimID(
 
 const phy::DataPlanePhyChip& PlatformMapping::getPortIphyChip(
     PortID portID) const {
-  auto itPlatformPort = platformPorts_.find(portID);
-  if (itPlatformPort == platformPorts_.end()) {
+  auto platformPort = findPlatformPort(portID);
+  if (!platformPort) {
     throw FbossError("Unrecoganized port:", portID);
   }
-  const auto& coreName =
-      itPlatformPort->second.mapping()->pins()[0].a()->get_chip();
+  const auto& coreName = platformPort->mapping()->pins()[0].a()->get_chip();
   return chips_.at(coreName);
 }
 
 cfg::PortSpeed PlatformMapping::getPortMaxSpeed(PortID portID) const {
-  auto itPlatformPort = platformPorts_.find(portID);
-  if (itPlatformPort == platformPorts_.end()) {
+  auto platformPort = findPlatformPort(portID);
+  if (!platformPort) {
     throw FbossError("Unrecoganized port:", portID);
   }
 
   cfg::PortSpeed maxSpeed{cfg::PortSpeed::DEFAULT};
-  for (const auto& profile : *itPlatformPort->second.supportedProfiles()) {
+  for (const auto& profile : *platformPort->supportedProfiles()) {
     if (auto profileConfig = getPortProfileConfig(
             PlatformPortProfileConfigMatcher(profile.first, portID))) {
       if (static_cast<int>(maxSpeed) <
@@ -304,11 +327,11 @@ cfg::PortSpeed PlatformMapping::getPortMaxSpeed(PortID portID) const {
 }
 
 cfg::Scope PlatformMapping::getPortScope(PortID portID) const {
-  auto itPlatformPort = platformPorts_.find(portID);
-  if (itPlatformPort == platformPorts_.end()) {
+  auto platformPort = findPlatformPort(portID);
+  if (!platformPort) {
     throw FbossError("Unrecoganized port:", portID);
   }
-  return *itPlatformPort->second.mapping()->scope();
+  return *platformPort->mapping()->scope();
 }
 
 std::vector<phy::PinConfig> PlatformMapping::getPortIphyPinConfigs(
@@ -427,15 +450,12 @@ std::set<uint8_t> PlatformMapping::getTransceiverHostLanes(
 }
 
 int PlatformMapping::getTransceiverIdFromSwPort(PortID swPort) const {
-  const auto& platformPorts = getPlatformPorts();
-  const auto& chips = getChips();
-
-  auto platformPortItr = platformPorts.find(static_cast<int32_t>(swPort));
-  if (platformPortItr == platformPorts.end()) {
+  auto platformPort = findPlatformPort(static_cast<int32_t>(swPort));
+  if (!platformPort) {
     throw FbossError("Can't find Platform Port for portId ", swPort);
   }
 
-  auto tcvrID = utility::getTransceiverId(platformPortItr->second, chips);
+  auto tcvrID = utility::getTransceiverId(*platformPort, getChips());
   if (!tcvrID.has_value()) {
     throw FbossError("Can't find Tcvr ID for portId ", swPort);
   }
@@ -645,7 +665,7 @@ void PlatformMapping::mergePortConfigOverrides(
 }
 
 const PortID PlatformMapping::getPortID(const std::string& portName) const {
-  for (const auto& platPortEntry : platformPorts_) {
+  for (const auto& platPortEntry : getPlatformPorts()) {
     if (*platPortEntry.second.mapping()->name() == portName) {
       return PortID(*platPortEntry.second.mapping()->id());
     }
@@ -655,17 +675,15 @@ const PortID PlatformMapping::getPortID(const std::string& portName) const {
 
 std::optional<std::string> PlatformMapping::getPortNameByPortId(
     PortID portId) const {
-  const auto& platformPorts = getPlatformPorts();
-  int32_t portIdInt = static_cast<int32_t>(portId);
-  if (platformPorts.find(portIdInt) != platformPorts.end()) {
-    return *platformPorts.at(portIdInt).mapping()->name();
+  if (auto platformPort = findPlatformPort(static_cast<int32_t>(portId))) {
+    return *platformPort->mapping()->name();
   }
   return std::nullopt;
 }
 
 std::optional<int32_t> PlatformMapping::getVirtualDeviceID(
     const std::string& portName) const {
-  for (const auto& platPortEntry : platformPorts_) {
+  for (const auto& platPortEntry : getPlatformPorts()) {
     if (*platPortEntry.second.mapping()->name() == portName) {
       return platPortEntry.second.mapping()->virtualDeviceId()
           ? *platPortEntry.second.mapping()->virtualDeviceId()
@@ -679,12 +697,12 @@ std::optional<int32_t> PlatformMapping::getVirtualDeviceID(
 const cfg::PlatformPortConfig& PlatformMapping::getPlatformPortConfig(
     PortID id,
     cfg::PortProfileID profileID) const {
-  auto itPlatformPort = platformPorts_.find(id);
-  if (itPlatformPort == platformPorts_.end()) {
+  auto platformPort = findPlatformPort(id);
+  if (!platformPort) {
     throw FbossError("No PlatformPortEntry found for port ", id);
   }
 
-  auto& supportedProfiles = *itPlatformPort->second.supportedProfiles();
+  auto& supportedProfiles = *platformPort->supportedProfiles();
   auto platformPortConfig = supportedProfiles.find(profileID);
   if (platformPortConfig == supportedProfiles.end()) {
     throw FbossError(
@@ -721,13 +739,49 @@ PlatformMapping::getCorePinMapping(const std::vector<cfg::Port>& ports) const {
 
 const cfg::PlatformPortEntry& PlatformMapping::getPlatformPort(
     int32_t portId) const {
-  auto entry = platformPorts_.find(portId);
-  if (entry != platformPorts_.end()) {
-    return entry->second;
+  if (auto platformPort = findPlatformPort(portId)) {
+    return *platformPort;
   }
   throw FbossError("No PlatformMapping entry for port ", portId);
 }
 
+const cfg::PlatformPortEntry* PlatformMapping::findPlatformPort(
+    int32_t portId) const {
+  // Once all ports are decoded platformPorts_ is no longer modified
+  if (hasEncodedPlatformPorts_.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> g(encodedPlatformPortsLock_);
+    auto encoded = encodedPlatformPorts_.find(portId);
+    if (encoded != encodedPlatformPorts_.end()) {
+      platformPorts_.emplace(
+          portId,
+          apache::thrift::CompactSerializer::deserialize<
+              cfg::PlatformPortEntry>(encoded->second));
+      encodedPlatformPorts_.erase(encoded);
+      hasEncodedPlatformPorts_.store(
+          !encodedPlatformPorts_.empty(), std::memory_order_release);
+    }
+    auto entry = platformPorts_.find(portId);
+    return entry != platformPorts_.end() ? &entry->second : nullptr;
+  }
+  auto entry = platformPorts_.find(portId);
+  return entry != platformPorts_.end() ? &entry->second : nullptr;
+}
+
+void PlatformMapping::decodePlatformPorts() const {
+  if (!hasEncodedPlatformPorts_.load(std::memory_order_acquire)) {
+    return;
+  }
+  std::lock_guard<std::mutex> g(encodedPlatformPortsLock_);
+  for (const auto& [portId, encoded] : encodedPlatformPorts_) {
+    platformPorts_.emplace(
+        portId,
+        apache::thrift::CompactSerializer::deserialize<cfg::PlatformPortEntry>(
+            encoded));
+  }
+  encodedPlatformPorts_.clear();
+  hasEncodedPlatformPorts_.store(false, std::memory_order_release);
+}
+
 std::map<std::string, phy::DataPlanePhyChip>
 PlatformMapping::getPortDataplaneChips(
     PlatformPortProfileConfigMatcher matcher) const {
@@ -808,7 +862,7 @@ std::map<std::string, std::vector<cfg::PortProfileID>>
 PlatformMapping::getAllPortProfiles() const {
   std::map<std::string, std::vector<cfg::PortProfileID>> portProfileIds;
 
-  for (auto& platformPort : platformPorts_) {
+  for (auto& platformPort : getPlatformPorts()) {
     auto& portName = *platformPort.second.mapping()->name();
     auto& portProfiles = *platformPort.second.supportedProfiles();
     std::vector<cfg::PortProfileID> profiles;
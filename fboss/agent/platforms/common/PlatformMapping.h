@@ -14,6 +14,11 @@
 #include "fboss/lib/phy/gen-cpp2/phy_types.h"
 #include "fboss/qsfp_service/if/gen-cpp2/transceiver_types.h"
 
+#include <folly/Range.h>
+
+#include <atomic>
+#include <mutex>
+
 DECLARE_string(platform_mapping_override_path);
 DECLARE_bool(multi_npu_platform_mapping);
 DECLARE_int32(platform_mapping_profile);
@@ -75,11 +80,21 @@ class PlatformMapping {
   PlatformMapping() = default;
   explicit PlatformMapping(const std::string& jsonPlatformMappingStr);
   explicit PlatformMapping(const cfg::PlatformMapping& mapping);
+  /*
+   * Load a mapping produced by compile(). This is much cheaper than parsing
+   * the JSON mapping, and port entries are only decoded when first accessed,
+   * so processes which only look up a few ports don't pay for the rest.
+   */
+  explicit PlatformMapping(folly::ByteRange compiledPlatformMapping);
   virtual ~PlatformMapping() = default;
 
+  // Serialize mapping into a cfg::CompiledPlatformMapping
+  static std::string compile(const cfg::PlatformMapping& mapping);
+
   cfg::PlatformMapping toThrift() const;
 
   const std::map<int32_t, cfg::PlatformPortEntry>& getPlatformPorts() const {
+    decodePlatformPorts();
     return platformPorts_;
   }
 
@@ -189,7 +204,6 @@ class PlatformMapping {
   std::vector<PortID> getPlatformPorts(cfg::PortType portType) const;
 
  protected:
-  std::map<int32_t, cfg::PlatformPortEntry> platformPorts_;
   std::vector<cfg::PlatformPortProfileConfigEntry> platformSupportedProfiles_;
   std::map<std::string, phy::DataPlanePhyChip> chips_;
   std::vector<cfg::PlatformPortConfigOverride> portConfigOverrides_;
@@ -198,8 +212,29 @@ class PlatformMapping {
       PortID id,
       cfg::PortProfileID profileID) const;
 
+  const cfg::PlatformPortEntry* findPlatformPort(int32_t portId) const;
+
+  // For subclasses adjusting port entries, decodes every port first
+  std::map<int32_t, cfg::PlatformPortEntry>& getMutablePlatformPorts() {
+    decodePlatformPorts();
+    return platformPorts_;
+  }
+
  private:
   void init(const cfg::PlatformMapping& mapping);
+
+  // Decode any remaining compiled port entries into platformPorts_
+  void decodePlatformPorts() const;
+
+  // Decoded lazily when loaded from a compiled mapping, only access through
+  // getPlatformPorts() or findPlatformPort()
+  mutable std::map<int32_t, cfg::PlatformPortEntry> platformPorts_;
+
+  // Compact serialized port entries not yet decoded into platformPorts_
+  mutable std::map<int32_t, std::string> encodedPlatformPorts_;
+  mutable std::atomic<bool> hasEncodedPlatformPorts_{false};
+  mutable std::mutex encodedPlatformPortsLock_;
+
   // Forbidden copy constructor and assignment operator
   PlatformMapping(PlatformMapping const&) = delete;
   PlatformMapping& operator=(PlatformMapping const&) = delete;
@@ -0,0 +1,78 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+/*
+ * Build time tool which converts a JSON platform mapping into a header
+ * defining the compiled mapping as a byte array, to be loaded with
+ * PlatformMapping(folly::ByteRange) instead of parsing JSON at startup:
+ *
+ *   platform_mapping_compiler --platform_mapping_json=mapping.json \
+ *     --symbol=kFooCompiledPlatformMapping --output=FooPlatformMapping-inl.h
+ */
+
+#include <fmt/format.h>
+#include <folly/FileUtil.h>
+#include <folly/init/Init.h>
+#include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include "fboss/agent/platforms/common/PlatformMapping.h"
+
+DEFINE_string(platform_mapping_json, "", "Platform mapping JSON to compile");
+DEFINE_string(symbol, "", "Name of the byte array holding the mapping");
+DEFINE_string(output, "", "Header to write the compiled mapping to");
+
+namespace {
+constexpr auto kBytesPerLine = 16;
+
+std::string toHeader(const std::string& compiled) {
+  std::string header = fmt::format(
+      "// @{} by platform_mapping_compiler from {}\n"
+      "#pragma once\n\n"
+      "namespace facebook::fboss {{\n"
+      "inline constexpr unsigned char {}[] = {{",
+      "generated",
+      FLAGS_platform_mapping_json,
+      FLAGS_symbol);
+  for (size_t i = 0; i < compiled.size(); ++i) {
+    header += i % kBytesPerLine ? " " : "\n    ";
+    header += fmt::format("0x{:02x},", static_cast<uint8_t>(compiled[i]));
+  }
+  header += "\n};\n} // namespace facebook::fboss\n";
+  return header;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+  if (FLAGS_platform_mapping_json.empty() || FLAGS_symbol.empty() ||
+      FLAGS_output.empty()) {
+    XLOG(ERR)
+        << "--platform_mapping_json, --symbol and --output are all required";
+    return 1;
+  }
+
+  std::string json;
+  if (!folly::readFile(FLAGS_platform_mapping_json.c_str(), json)) {
+    XLOG(ERR) << "Failed to read " << FLAGS_platform_mapping_json;
+    return 1;
+  }
+  auto compiled = facebook::fboss::PlatformMapping::compile(
+      apache::thrift::SimpleJSONSerializer::deserialize<
+          facebook::fboss::cfg::PlatformMapping>(json));
+  if (!folly::writeFile(toHeader(compiled), FLAGS_output.c_str())) {
+    XLOG(ERR) << "Failed to write " << FLAGS_output;
+    return 1;
+  }
+  XLOG(INFO) << "Compiled " << json.size() << " bytes of JSON into "
+             << compiled.size() << " bytes";
+  return 0;
+}
@@ -0,0 +1,107 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include <folly/Benchmark.h>
+#include <gflags/gflags.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include "fboss/agent/platforms/common/PlatformMapping.h"
+#include "fboss/agent/platforms/common/PlatformMappingUtils.h"
+
+using namespace facebook::fboss;
+
+namespace {
+
+struct EncodedPlatformMapping {
+  std::string json;
+  std::string compiled;
+  int32_t portId;
+};
+
+const EncodedPlatformMapping& getEncodedPlatformMapping(PlatformType type) {
+  static std::map<PlatformType, EncodedPlatformMapping> encodedMappings;
+  auto it = encodedMappings.find(type);
+  if (it == encodedMappings.end()) {
+    auto mapping = utility::initPlatformMapping(type)->toThrift();
+    EncodedPlatformMapping encoded{
+        apache::thrift::SimpleJSONSerializer::serialize<std::string>(mapping),
+        PlatformMapping::compile(mapping),
+        mapping.ports()->rbegin()->first};
+    it = encodedMappings.emplace(type, std::move(encoded)).first;
+  }
+  return it->second;
+}
+
+/*
+ * Startup cost of a process which loads the mapping and looks up a single
+ * port, e.g. led_service or a test binary.
+ */
+void jsonPlatformMapping(unsigned iters, PlatformType type) {
+  folly::BenchmarkSuspender suspender;
+  const auto& encoded = getEncodedPlatformMapping(type);
+  suspender.dismiss();
+  for (unsigned i = 0; i < iters; ++i) {
+    PlatformMapping mapping(encoded.json);
+    folly::doNotOptimizeAway(mapping.getPlatformPort(encoded.portId));
+  }
+}
+
+void compiledPlatformMapping(unsigned iters, PlatformType type) {
+  folly::BenchmarkSuspender suspender;
+  const auto& encoded = getEncodedPlatformMapping(type);
+  suspender.dismiss();
+  for (unsigned i = 0; i < iters; ++i) {
+    PlatformMapping mapping(
+        folly::ByteRange(folly::StringPiece(encoded.compiled)));
+    folly::doNotOptimizeAway(mapping.getPlatformPort(encoded.portId));
+  }
+}
+
+// Cost when every port ends up being decoded, e.g. wedge_agent
+void compiledPlatformMappingAllPorts(unsigned iters, PlatformType type) {
+  folly::BenchmarkSuspender suspender;
+  const auto& encoded = getEncodedPlatformMapping(type);
+  suspender.dismiss();
+  for (unsigned i = 0; i < iters; ++i) {
+    PlatformMapping mapping(
+        folly::ByteRange(folly::StringPiece(encoded.compiled)));
+    folly::doNotOptimizeAway(mapping.getPlatformPorts().size());
+  }
+}
+
+} // namespace
+
+#define PLATFORM_MAPPING_BENCHMARK(name, type)                          \
+  BENCHMARK_NAMED_PARAM(jsonPlatformMapping, name, type)                \
+  BENCHMARK_RELATIVE_NAMED_PARAM(compiledPlatformMapping, name, type)   \
+  BENCHMARK_RELATIVE_NAMED_PARAM(compiledPlatformMappingAllPorts, name, type) \
+  BENCHMARK_DRAW_LINE();
+
+PLATFORM_MAPPING_BENCHMARK(Wedge100, PlatformType::PLATFORM_WEDGE100)
+PLATFORM_MAPPING_BENCHMARK(Wedge400, PlatformType::PLATFORM_WEDGE400)
+PLATFORM_MAPPING_BENCHMARK(Wedge400C, PlatformType::PLATFORM_WEDGE400C)
+PLATFORM_MAPPING_BENCHMARK(Minipack, PlatformType::PLATFORM_MINIPACK)
+PLATFORM_MAPPING_BENCHMARK(Yamp, PlatformType::PLATFORM_YAMP)
+PLATFORM_MAPPING_BENCHMARK(Fuji, PlatformType::PLATFORM_FUJI)
+PLATFORM_MAPPING_BENCHMARK(Elbert, PlatformType::PLATFORM_ELBERT)
+PLATFORM_MAPPING_BENCHMARK(Darwin, PlatformType::PLATFORM_DARWIN)
+PLATFORM_MAPPING_BENCHMARK(Montblanc, PlatformType::PLATFORM_MONTBLANC)
+PLATFORM_MAPPING_BENCHMARK(Meru400biu, PlatformType::PLATFORM_MERU400BIU)
+PLATFORM_MAPPING_BENCHMARK(Meru400bfu, PlatformType::PLATFORM_MERU400BFU)
+PLATFORM_MAPPING_BENCHMARK(Meru800bia, PlatformType::PLATFORM_MERU800BIA)
+PLATFORM_MAPPING_BENCHMARK(Meru800bfa, PlatformType::PLATFORM_MERU800BFA)
+PLATFORM_MAPPING_BENCHMARK(Janga800bic, PlatformType::PLATFORM_JANGA800BIC)
+PLATFORM_MAPPING_BENCHMARK(Tahan800bc, PlatformType::PLATFORM_TAHAN800BC)
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -1328,4 +1328,31 @@ TEST_F(PlatformMappingTest, VerifyYampXphyLinePolaritySwap) {
   verifyXphyLinePolaritySwapByProfile(
       mapping.get(), mapping->getPlatformPorts(), expectedPolaritySwap);
 }
+
+TEST_F(PlatformMappingTest, VerifyCompiledPlatformMapping) {
+  auto mapping = std::make_unique<Wedge400PlatformMapping>();
+  auto expected = mapping->toThrift();
+  auto compiled = PlatformMapping::compile(expected);
+  PlatformMapping compiledMapping{
+      folly::ByteRange(folly::StringPiece(compiled))};
+
+  // Single port lookups only decode the port being looked up
+  auto portID = PortID(expected.ports()->begin()->first);
+  EXPECT_EQ(
+      compiledMapping.getPlatformPort(portID),
+      mapping->getPlatformPort(portID));
+  EXPECT_EQ(
+      compiledMapping.getPortIphyChip(portID),
+      mapping->getPortIphyChip(portID));
+  EXPECT_EQ(
+      compiledMapping.getPortMaxSpeed(portID),
+      mapping->getPortMaxSpeed(portID));
+  EXPECT_THROW(compiledMapping.getPlatformPort(-1), FbossError);
+
+  EXPECT_EQ(compiledMapping.getChips(), mapping->getChips());
+  EXPECT_EQ(compiledMapping.toThrift(), expected);
+  EXPECT_EQ(
+      compiledMapping.getPlatformPorts().size(),
+      mapping->getPlatformPorts().size());
+}
 } // namespace facebook::fboss::test
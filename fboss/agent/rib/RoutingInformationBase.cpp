@@ -13,6 +13,7 @@
 #include "fboss/agent/AddressUtil.h"
 #include "fboss/agent/Constants.h"
 #include "fboss/agent/FbossHwUpdateError.h"
+#include "fboss/agent/RouteUpdateTrace.h"
 #include "fboss/agent/Utils.h"
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 #include "fboss/agent/rib/ConfigApplier.h"
@@ -22,6 +23,7 @@
 #include "fboss/agent/state/ForwardingInformationBaseMap.h"
 #include "fboss/agent/state/NodeMap-defs.h"
 #include "fboss/agent/state/SwitchState.h"
+#include "fboss/lib/FunctionCallTimeReporter.h"
 
 #include "fboss/agent/rib/RouteUpdater.h"
 
@@ -328,13 +330,17 @@ void RibRouteTables::update(
     folly::StringPiece updateType,
     const FibUpdateFunction& fibUpdateCallback,
     void* cookie) {
-  updateRib(routerID, [&](auto& routeTable) {
-    RibRouteUpdater updater(
-        &(routeTable.v4NetworkToRoute),
-        &(routeTable.v6NetworkToRoute),
-        &(routeTable.labelToRoute));
-    updater.update(clientID, toAddRoutes, toDelPrefixes, resetClientsRoutes);
-  });
+  {
+    ScopedStageTimer stageTimer(CallTimeStage::RIB);
+    RouteUpdateTrace::ScopedStage traceStage(RouteUpdateStage::RIB);
+    updateRib(routerID, [&](auto& routeTable) {
+      RibRouteUpdater updater(
+          &(routeTable.v4NetworkToRoute),
+          &(routeTable.v6NetworkToRoute),
+          &(routeTable.labelToRoute));
+      updater.update(clientID, toAddRoutes, toDelPrefixes, resetClientsRoutes);
+    });
+  }
   updateFib(resolver, routerID, fibUpdateCallback, cookie);
 }
 
@@ -560,7 +566,9 @@ RoutingInformationBase::UpdateStatistics RoutingInformationBase::updateImpl(
   std::shared_ptr<SwitchState> appliedState;
   Timer updateTimer(&duration);
   std::exception_ptr updateException;
+  auto trace = RouteUpdateTrace::current();
   auto updateFn = [&]() {
+    RouteUpdateTrace::Scope traceScope(trace);
     std::vector<typename TraitsType::RibRoute> toAddRoutes;
     toAddRoutes.reserve(toAdd.size());
 
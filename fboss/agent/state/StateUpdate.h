@@ -16,6 +16,7 @@
 
 namespace facebook::fboss {
 
+class RouteUpdateTrace;
 class SwitchState;
 
 /*
@@ -98,6 +99,8 @@ class StateUpdate {
 
   std::string name_;
   int behaviorFlags_{static_cast<int>(BehaviorFlags::NONE)};
+  // Trace of the route update request that queued this update, if any
+  std::shared_ptr<RouteUpdateTrace> trace_;
 
   // An intrusive list hook for maintaining the list of pending updates.
   folly::IntrusiveListHook listHook_;
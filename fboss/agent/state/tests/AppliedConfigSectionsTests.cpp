@@ -0,0 +1,162 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/ApplyThriftConfig.h"
+#include "fboss/agent/gen-cpp2/switch_config_types.h"
+#include "fboss/agent/hw/mock/MockPlatform.h"
+#include "fboss/agent/state/AclEntry.h"
+#include "fboss/agent/state/AclMap.h"
+#include "fboss/agent/state/Port.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss;
+
+DECLARE_bool(enable_acl_table_group);
+
+namespace {
+HwSwitchMatcher scope() {
+  return HwSwitchMatcher{std::unordered_set<SwitchID>{SwitchID(0)}};
+}
+
+cfg::SwitchConfig makeConfig() {
+  cfg::SwitchConfig config;
+  config.ports()->resize(2);
+  preparedMockPortConfig(config.ports()[0], 1);
+  preparedMockPortConfig(config.ports()[1], 2);
+  config.vlans()->resize(1);
+  *config.vlans()[0].id() = 2;
+  config.vlanPorts()->resize(2);
+  for (int i = 0; i < 2; ++i) {
+    *config.vlanPorts()[i].logicalPort() = i + 1;
+    *config.vlanPorts()[i].vlanID() = 2;
+  }
+  config.interfaces()->resize(1);
+  *config.interfaces()[0].intfID() = 2;
+  *config.interfaces()[0].vlanID() = 2;
+  config.interfaces()[0].mac() = "00:00:00:00:00:22";
+  config.acls()->resize(1);
+  *config.acls()[0].name() = "acl1";
+  *config.acls()[0].actionType() = cfg::AclActionType::DENY;
+  config.acls()[0].dstIp() = "192.168.0.0/24";
+  return config;
+}
+
+std::shared_ptr<SwitchState> makeInitState() {
+  auto state = std::make_shared<SwitchState>();
+  registerPort(state, PortID(1), "port1", scope());
+  registerPort(state, PortID(2), "port2", scope());
+  return state;
+}
+} // namespace
+
+TEST(AppliedConfigSections, fingerprintPerSection) {
+  auto config = makeConfig();
+  auto aclsBefore = configSectionFingerprint(config, ConfigSection::ACLS);
+  auto portsBefore = configSectionFingerprint(config, ConfigSection::PORTS);
+  EXPECT_EQ(aclsBefore, configSectionFingerprint(config, ConfigSection::ACLS));
+
+  config.acls()[0].dstIp() = "192.168.1.0/24";
+  EXPECT_NE(aclsBefore, configSectionFingerprint(config, ConfigSection::ACLS));
+  EXPECT_EQ(
+      portsBefore, configSectionFingerprint(config, ConfigSection::PORTS));
+
+  config.ports()[0].description() = "changed";
+  EXPECT_NE(
+      portsBefore, configSectionFingerprint(config, ConfigSection::PORTS));
+}
+
+TEST(AppliedConfigSections, applySameConfig) {
+  FLAGS_enable_acl_table_group = false;
+  auto platform = createMockPlatform();
+  auto config = makeConfig();
+  AppliedConfigSections appliedSections;
+  EXPECT_FALSE(appliedSections.getFingerprint(ConfigSection::PORTS));
+
+  auto stateV1 = publishAndApplyConfig(
+      makeInitState(), &config, platform.get(), nullptr, &appliedSections);
+  ASSERT_NE(nullptr, stateV1);
+  for (size_t i = 0; i < AppliedConfigSections::kNumSections; ++i) {
+    auto section = static_cast<ConfigSection>(i);
+    EXPECT_EQ(
+        configSectionFingerprint(config, section),
+        appliedSections.getFingerprint(section));
+  }
+  EXPECT_EQ(
+      nullptr,
+      publishAndApplyConfig(
+          stateV1, &config, platform.get(), nullptr, &appliedSections));
+}
+
+TEST(AppliedConfigSections, applyChangedAcl) {
+  FLAGS_enable_acl_table_group = false;
+  auto platform = createMockPlatform();
+  auto config = makeConfig();
+  AppliedConfigSections appliedSections;
+  auto stateV1 = publishAndApplyConfig(
+      makeInitState(), &config, platform.get(), nullptr, &appliedSections);
+  ASSERT_NE(nullptr, stateV1);
+
+  config.acls()[0].dstIp() = "192.168.1.0/24";
+  auto stateV2 = publishAndApplyConfig(
+      stateV1, &config, platform.get(), nullptr, &appliedSections);
+  ASSERT_NE(nullptr, stateV2);
+  EXPECT_EQ(stateV1->getPorts(), stateV2->getPorts());
+  auto acl = stateV2->getAcl("acl1");
+  ASSERT_NE(nullptr, acl);
+  EXPECT_EQ(
+      folly::IPAddress::createNetwork("192.168.1.0/24"), acl->getDstIp());
+
+  // Result must match a full, non incremental application
+  auto fullStateV2 = publishAndApplyConfig(stateV1, &config, platform.get());
+  ASSERT_NE(nullptr, fullStateV2);
+  EXPECT_EQ(fullStateV2->getAcls()->toThrift(), stateV2->getAcls()->toThrift());
+  EXPECT_EQ(
+      fullStateV2->getPorts()->toThrift(), stateV2->getPorts()->toThrift());
+}
+
+TEST(AppliedConfigSections, stateChangedOutsideConfig) {
+  FLAGS_enable_acl_table_group = false;
+  auto platform = createMockPlatform();
+  auto config = makeConfig();
+  AppliedConfigSections appliedSections;
+  auto stateV1 = publishAndApplyConfig(
+      makeInitState(), &config, platform.get(), nullptr, &appliedSections);
+  ASSERT_NE(nullptr, stateV1);
+  stateV1->publish();
+
+  // Override port admin state outside of config, as e.g. setPortState does
+  auto stateV2 = stateV1->clone();
+  auto port = stateV2->getPorts()->getNodeIf(PortID(1))->modify(&stateV2);
+  port->setAdminState(cfg::PortState::DISABLED);
+
+  // Ports config is unchanged, but port state is not what config produced,
+  // so the ports section must still be re-applied.
+  auto stateV3 = publishAndApplyConfig(
+      stateV2, &config, platform.get(), nullptr, &appliedSections);
+  ASSERT_NE(nullptr, stateV3);
+  EXPECT_EQ(
+      cfg::PortState::ENABLED,
+      stateV3->getPorts()->getNodeIf(PortID(1))->getAdminState());
+}
+
+TEST(AppliedConfigSections, clear) {
+  FLAGS_enable_acl_table_group = false;
+  auto platform = createMockPlatform();
+  auto config = makeConfig();
+  AppliedConfigSections appliedSections;
+  publishAndApplyConfig(
+      makeInitState(), &config, platform.get(), nullptr, &appliedSections);
+  EXPECT_TRUE(appliedSections.getFingerprint(ConfigSection::ACLS).has_value());
+  appliedSections.clear();
+  EXPECT_FALSE(appliedSections.getFingerprint(ConfigSection::ACLS).has_value());
+}
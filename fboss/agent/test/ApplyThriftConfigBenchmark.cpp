@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/Format.h>
+#include <folly/init/Init.h>
+
+#include "fboss/agent/ApplyThriftConfig.h"
+#include "fboss/agent/gen-cpp2/switch_config_types.h"
+#include "fboss/agent/hw/mock/MockPlatform.h"
+#include "fboss/agent/hw/mock/MockPlatformMapping.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/TestUtils.h"
+
+DECLARE_bool(enable_acl_table_group);
+
+namespace facebook::fboss {
+
+namespace {
+// Roughly the number of ACLs on a large chassis config
+constexpr auto kNumAcls = 2000;
+
+/*
+ * Config with every port of the mock platform, one VLAN interface per port
+ * and kNumAcls ACLs. This approximates the shape of large chassis configs
+ * with the mock platform mapping, so it can run without hardware.
+ */
+cfg::SwitchConfig makeScaleConfig() {
+  cfg::SwitchConfig config;
+  config.switchSettings()->switchIdToSwitchInfo() = {
+      {0, createSwitchInfo(cfg::SwitchType::NPU)}};
+  MockPlatformMapping platformMapping;
+  int vlanId = 100;
+  for (const auto& [portId, _] : platformMapping.getPlatformPorts()) {
+    cfg::Port port;
+    preparedMockPortConfig(port, portId);
+    config.ports()->push_back(port);
+
+    cfg::Vlan vlan;
+    vlan.id() = vlanId;
+    vlan.name() = folly::to<std::string>("vlan", vlanId);
+    vlan.intfID() = vlanId;
+    config.vlans()->push_back(vlan);
+
+    cfg::VlanPort vlanPort;
+    vlanPort.logicalPort() = portId;
+    vlanPort.vlanID() = vlanId;
+    config.vlanPorts()->push_back(vlanPort);
+
+    cfg::Interface intf;
+    intf.intfID() = vlanId;
+    intf.vlanID() = vlanId;
+    intf.routerID() = 0;
+    intf.mac() = "00:02:00:00:00:01";
+    intf.ipAddresses() = {
+        folly::sformat("10.{}.{}.1/24", vlanId / 256, vlanId % 256),
+        folly::sformat("2401:db00:{:x}::1/64", vlanId)};
+    config.interfaces()->push_back(intf);
+    ++vlanId;
+  }
+  for (int i = 0; i < kNumAcls; ++i) {
+    cfg::AclEntry acl;
+    acl.name() = folly::to<std::string>("acl", i);
+    acl.actionType() = cfg::AclActionType::DENY;
+    acl.dstIp() = folly::sformat("2401:db00:{:x}::/64", i);
+    config.acls()->push_back(acl);
+  }
+  return config;
+}
+
+struct ReloadHelper {
+  ReloadHelper() {
+    FLAGS_enable_acl_table_group = false;
+    platform = createMockPlatform();
+    config = makeScaleConfig();
+    state = publishAndApplyConfig(
+        std::make_shared<SwitchState>(),
+        &config,
+        platform.get(),
+        nullptr,
+        &appliedSections);
+    state->publish();
+    // Change a single ACL
+    changedConfig = config;
+    changedConfig.acls()[kNumAcls / 2].dstIp() = "2401:db00:ffff::/64";
+  }
+
+  std::unique_ptr<MockPlatform> platform;
+  cfg::SwitchConfig config;
+  cfg::SwitchConfig changedConfig;
+  std::shared_ptr<SwitchState> state;
+  AppliedConfigSections appliedSections;
+};
+
+void reloadAfterOneAclChange(size_t numIters, bool incremental) {
+  std::unique_ptr<ReloadHelper> helper;
+  BENCHMARK_SUSPEND {
+    helper = std::make_unique<ReloadHelper>();
+  }
+  for (size_t n = 0; n < numIters; ++n) {
+    AppliedConfigSections appliedSections;
+    BENCHMARK_SUSPEND {
+      appliedSections = helper->appliedSections;
+    }
+    auto newState = publishAndApplyConfig(
+        helper->state,
+        &helper->changedConfig,
+        helper->platform.get(),
+        nullptr,
+        incremental ? &appliedSections : nullptr);
+    folly::doNotOptimizeAway(newState);
+  }
+}
+} // namespace
+
+BENCHMARK(ReloadAfterOneAclChangeFull, numIters) {
+  reloadAfterOneAclChange(numIters, false /* incremental */);
+}
+
+BENCHMARK_RELATIVE(ReloadAfterOneAclChangeIncremental, numIters) {
+  reloadAfterOneAclChange(numIters, true /* incremental */);
+}
+
+} // namespace facebook::fboss
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,167 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/HwSwitchStatsDelta.h"
+
+#include <gtest/gtest.h>
+
+#include "fboss/agent/FbossError.h"
+
+using namespace facebook::fboss;
+
+namespace {
+
+HwPortStats portStats(int64_t sample) {
+  HwPortStats stats;
+  stats.timestamp_() = 1000 + sample;
+  stats.inBytes_() = 1000 * sample;
+  stats.outBytes_() = 2000 * sample;
+  stats.queueOutBytes_() = {{0, 10 * sample}, {1, 20 * sample}};
+  stats.portName_() = "eth1/1/1";
+  return stats;
+}
+
+HwSysPortStats sysPortStats(int64_t sample) {
+  HwSysPortStats stats;
+  stats.timestamp_() = 1000 + sample;
+  stats.queueOutBytes_() = {{0, 30 * sample}};
+  return stats;
+}
+
+multiswitch::HwSwitchStats switchStats(int64_t sample) {
+  multiswitch::HwSwitchStats stats;
+  stats.timestamp() = 1000 + sample;
+  stats.hwPortStats() = {
+      {"eth1/1/1", portStats(sample)}, {"eth1/2/1", portStats(sample)}};
+  stats.sysPortStats() = {{"rdsw1:eth1/1/1", sysPortStats(sample)}};
+  stats.hwResourceStats()->acl_counters_free() = 50;
+  return stats;
+}
+
+class HwSwitchStatsDeltaTest : public ::testing::Test {
+ public:
+  multiswitch::HwSwitchStatsDelta sync(
+      const multiswitch::HwSwitchStats& stats) {
+    auto delta = encoder_.encode(stats);
+    EXPECT_TRUE(decoder_.apply(received_, delta));
+    EXPECT_EQ(received_, stats);
+    return delta;
+  }
+
+ protected:
+  HwSwitchStatsDeltaEncoder encoder_;
+  HwSwitchStatsDeltaDecoder decoder_;
+  multiswitch::HwSwitchStats received_;
+};
+
+} // namespace
+
+TEST_F(HwSwitchStatsDeltaTest, snapshotThenCounterDeltas) {
+  auto snapshot = sync(switchStats(1));
+  EXPECT_TRUE(*snapshot.fullSnapshot());
+  EXPECT_EQ(snapshot.newPortNames()->size(), 2);
+  EXPECT_EQ(snapshot.hwPortStats()->size(), 2);
+  EXPECT_EQ(snapshot.sysPortStats()->size(), 1);
+  EXPECT_TRUE(snapshot.otherStats().has_value());
+
+  auto delta = sync(switchStats(2));
+  EXPECT_FALSE(*delta.fullSnapshot());
+  EXPECT_TRUE(delta.newPortNames()->empty());
+  EXPECT_TRUE(delta.hwPortStats()->empty());
+  EXPECT_EQ(delta.hwPortStatsDelta()->size(), 2);
+  EXPECT_EQ(delta.sysPortStatsDelta()->size(), 1);
+  EXPECT_FALSE(delta.otherStats().has_value());
+  // timestamp_, inBytes_, outBytes_ and both queues
+  const auto& portDelta = delta.hwPortStatsDelta()->begin()->second;
+  EXPECT_EQ(portDelta.counterKeys()->size(), 5);
+  EXPECT_EQ(portDelta.counterDeltas()->size(), 5);
+}
+
+TEST_F(HwSwitchStatsDeltaTest, unchangedEntriesSkipped) {
+  sync(switchStats(1));
+  auto delta = sync(switchStats(1));
+  EXPECT_TRUE(delta.hwPortStatsDelta()->empty());
+  EXPECT_TRUE(delta.sysPortStatsDelta()->empty());
+}
+
+TEST_F(HwSwitchStatsDeltaTest, counterResetAndOptionalSet) {
+  sync(switchStats(5));
+  auto stats = switchStats(6);
+  stats.hwPortStats()->at("eth1/1/1").inBytes_() = 0;
+  stats.hwPortStats()->at("eth1/1/1").inAclDiscards_() = -1;
+  sync(stats);
+}
+
+TEST_F(HwSwitchStatsDeltaTest, portsAddedAndRemoved) {
+  sync(switchStats(1));
+  auto stats = switchStats(2);
+  stats.hwPortStats()->erase("eth1/2/1");
+  stats.hwPortStats()->emplace("eth1/3/1", portStats(2));
+  auto delta = sync(stats);
+  EXPECT_EQ(delta.removedPorts()->size(), 1);
+  EXPECT_EQ(delta.newPortNames()->size(), 1);
+  EXPECT_EQ(delta.hwPortStats()->size(), 1);
+  EXPECT_EQ(delta.hwPortStatsDelta()->size(), 1);
+
+  // Port coming back gets a new index
+  stats = switchStats(3);
+  delta = sync(stats);
+  EXPECT_EQ(delta.removedPorts()->size(), 1);
+  EXPECT_EQ(delta.newPortNames()->size(), 1);
+  EXPECT_NE(delta.newPortNames()->begin()->first, 1);
+}
+
+TEST_F(HwSwitchStatsDeltaTest, nonCounterChangesSentWhole) {
+  sync(switchStats(1));
+  auto stats = switchStats(2);
+  stats.hwPortStats()->at("eth1/1/1").portName_() = "eth1/1/2";
+  stats.hwPortStats()->at("eth1/2/1").queueOutBytes_()[7] = 1;
+  auto& sysPort = stats.sysPortStats()->at("rdsw1:eth1/1/1");
+  sysPort.queueCreditWatchdogDeletedPackets_()[0] = 1;
+  auto delta = sync(stats);
+  EXPECT_EQ(delta.hwPortStats()->size(), 2);
+  EXPECT_TRUE(delta.hwPortStatsDelta()->empty());
+  EXPECT_EQ(delta.sysPortStats()->size(), 1);
+}
+
+TEST_F(HwSwitchStatsDeltaTest, otherStatsSentOnChange) {
+  sync(switchStats(1));
+  auto stats = switchStats(2);
+  stats.hwResourceStats()->acl_counters_free() = 40;
+  auto delta = sync(stats);
+  ASSERT_TRUE(delta.otherStats().has_value());
+  EXPECT_TRUE(delta.otherStats()->hwPortStats()->empty());
+  EXPECT_EQ(*delta.otherStats()->hwResourceStats()->acl_counters_free(), 40);
+}
+
+TEST_F(HwSwitchStatsDeltaTest, resetSendsSnapshot) {
+  sync(switchStats(1));
+  sync(switchStats(2));
+  encoder_.reset();
+  auto snapshot = encoder_.encode(switchStats(3));
+  EXPECT_TRUE(*snapshot.fullSnapshot());
+
+  // A fresh receiver drops deltas until it sees the snapshot
+  HwSwitchStatsDeltaDecoder decoder;
+  multiswitch::HwSwitchStats received;
+  EXPECT_FALSE(decoder.apply(received, encoder_.encode(switchStats(4))));
+  encoder_.reset();
+  EXPECT_TRUE(decoder.apply(received, encoder_.encode(switchStats(5))));
+  EXPECT_TRUE(decoder.apply(received, encoder_.encode(switchStats(6))));
+  EXPECT_EQ(received, switchStats(6));
+}
+
+TEST_F(HwSwitchStatsDeltaTest, inconsistentDeltaThrows) {
+  sync(switchStats(1));
+  auto delta = encoder_.encode(switchStats(2));
+  auto& portDeltas = *delta.hwPortStatsDelta();
+  portDeltas[1000] = portDeltas.begin()->second;
+  EXPECT_THROW(decoder_.apply(received_, delta), FbossError);
+}
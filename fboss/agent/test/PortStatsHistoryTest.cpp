@@ -0,0 +1,169 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/PortStatsHistory.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr int64_t kStartTime = 1700000000;
+
+PortStatsHistory::Config config() {
+  return PortStatsHistory::Config{10s, 5s, 100s, 64 << 20};
+}
+
+HwPortStats portStats(int64_t timestamp, int64_t sample) {
+  HwPortStats stats;
+  stats.timestamp_() = timestamp;
+  stats.inBytes_() = 1000 * sample;
+  stats.outDiscards_() = 0;
+  stats.queueOutBytes_()[1] = 10 * sample;
+  // Goes up and down, to check watermarks keep their max when downsampled
+  stats.queueWatermarkBytes_()[1] = sample % 5 == 2 ? 1000 : sample;
+  stats.inAclDiscards_() = -sample;
+  return stats;
+}
+
+void addSamples(
+    PortStatsHistory& history,
+    const std::vector<std::string>& ports,
+    int64_t count) {
+  for (int64_t sample = 0; sample < count; ++sample) {
+    std::map<std::string, HwPortStats> stats;
+    for (const auto& port : ports) {
+      stats.emplace(port, portStats(kStartTime + sample, sample));
+    }
+    history.addStats(stats, {});
+  }
+}
+
+std::map<std::string, PortCounterHistory> byCounter(
+    const std::vector<PortCounterHistory>& histories) {
+  std::map<std::string, PortCounterHistory> result;
+  for (const auto& history : histories) {
+    result.emplace(*history.counter(), history);
+  }
+  return result;
+}
+
+} // namespace
+
+TEST(PortStatsHistoryTest, fullResolution) {
+  PortStatsHistory history(config());
+  addSamples(history, {"eth1/1/1", "eth1/2/1"}, 8);
+
+  auto histories = byCounter(history.getHistory(
+      {"eth1/1/1"}, {}, kStartTime, kStartTime + 1000));
+  for (const auto& [counter, counterHistory] : histories) {
+    EXPECT_EQ(*counterHistory.portName(), "eth1/1/1");
+    EXPECT_EQ(counterHistory.timestamps()->size(), 8) << counter;
+  }
+  EXPECT_EQ(histories.count("timestamp_"), 0);
+  ASSERT_EQ(histories.count("queueOutBytes_.1"), 1);
+  ASSERT_EQ(histories.count("inAclDiscards_"), 1);
+  // Unset optional counters are not kept
+  EXPECT_EQ(histories.count("inTrapDiscards_"), 0);
+  for (int64_t sample = 0; sample < 8; ++sample) {
+    EXPECT_EQ(
+        histories["inBytes_"].timestamps()->at(sample), kStartTime + sample);
+    EXPECT_EQ(histories["inBytes_"].values()->at(sample), 1000 * sample);
+    EXPECT_EQ(histories["queueOutBytes_.1"].values()->at(sample), 10 * sample);
+    EXPECT_EQ(histories["inAclDiscards_"].values()->at(sample), -sample);
+  }
+
+  auto selected = history.getHistory(
+      {}, {"outDiscards_"}, kStartTime + 2, kStartTime + 4);
+  ASSERT_EQ(selected.size(), 2);
+  for (const auto& counterHistory : selected) {
+    EXPECT_EQ(
+        *counterHistory.timestamps(),
+        std::vector<int64_t>({kStartTime + 2, kStartTime + 3, kStartTime + 4}));
+    EXPECT_EQ(*counterHistory.values(), std::vector<int64_t>(3, 0));
+  }
+}
+
+TEST(PortStatsHistoryTest, staleSnapshotsIgnored) {
+  PortStatsHistory history(config());
+  history.addStats({{"eth1/1/1", portStats(kStartTime, 1)}}, {});
+  history.addStats({{"eth1/1/1", portStats(kStartTime, 2)}}, {});
+  history.addStats({{"eth1/1/1", portStats(kStartTime - 1, 3)}}, {});
+
+  auto histories =
+      byCounter(history.getHistory({}, {"inBytes_"}, 0, kStartTime + 1));
+  EXPECT_EQ(*histories["inBytes_"].values(), std::vector<int64_t>({1000}));
+}
+
+TEST(PortStatsHistoryTest, sysPortStats) {
+  PortStatsHistory history(config());
+  HwSysPortStats stats;
+  stats.timestamp_() = kStartTime;
+  stats.queueOutBytes_()[2] = 42;
+  history.addStats({}, {{"rdsw1:eth1/1/1", stats}});
+
+  auto histories = history.getHistory({}, {}, 0, kStartTime);
+  ASSERT_EQ(histories.size(), 1);
+  EXPECT_EQ(*histories[0].portName(), "rdsw1:eth1/1/1");
+  EXPECT_EQ(*histories[0].counter(), "queueOutBytes_.2");
+  EXPECT_EQ(*histories[0].values(), std::vector<int64_t>({42}));
+}
+
+TEST(PortStatsHistoryTest, downsample) {
+  PortStatsHistory history(config());
+  // Only the last 10s are guaranteed to be at full resolution, and only the
+  // last 100s are kept. Both expire a whole chunk at a time.
+  addSamples(history, {"eth1/1/1"}, 600);
+
+  auto histories =
+      byCounter(history.getHistory({}, {}, 0, kStartTime + 1000));
+  const auto& inBytes = histories["inBytes_"];
+  const auto& watermark = histories["queueWatermarkBytes_.1"];
+  ASSERT_FALSE(inBytes.timestamps()->empty());
+  EXPECT_GE(
+      inBytes.timestamps()->front(),
+      kStartTime + 599 - 100 - 5 * PortStatsHistory::kSamplesPerChunk);
+  EXPECT_EQ(inBytes.timestamps()->back(), kStartTime + 599);
+
+  int downsampled = 0;
+  for (size_t i = 0; i < inBytes.timestamps()->size(); ++i) {
+    auto sample = inBytes.timestamps()->at(i) - kStartTime;
+    EXPECT_EQ(inBytes.values()->at(i), 1000 * sample);
+    if (i + 1 < inBytes.timestamps()->size() &&
+        inBytes.timestamps()->at(i + 1) - kStartTime - sample == 5) {
+      // Last sample of its 5s interval, watermark is the interval's max
+      ++downsampled;
+      EXPECT_EQ(watermark.values()->at(i), 1000);
+    }
+  }
+  EXPECT_GT(downsampled, 10);
+  EXPECT_LT(inBytes.timestamps()->size(), 200);
+}
+
+TEST(PortStatsHistoryTest, memoryBudget) {
+  auto budgetConfig = config();
+  budgetConfig.rawWindow = 1000s;
+  budgetConfig.downsampledWindow = 1000s;
+  budgetConfig.memoryBudgetBytes = 64 << 10;
+  PortStatsHistory history(budgetConfig);
+  std::vector<std::string> ports{"eth1/1/1", "eth1/2/1", "eth1/3/1"};
+  addSamples(history, ports, 900);
+
+  EXPECT_LE(history.memoryUsage(), budgetConfig.memoryBudgetBytes);
+  auto histories = history.getHistory({}, {"inBytes_"}, 0, kStartTime + 1000);
+  ASSERT_EQ(histories.size(), ports.size());
+  for (const auto& counterHistory : histories) {
+    // Oldest samples were dropped to stay in budget, newest are all there
+    EXPECT_GT(counterHistory.timestamps()->front(), kStartTime);
+    EXPECT_EQ(counterHistory.timestamps()->back(), kStartTime + 899);
+  }
+}
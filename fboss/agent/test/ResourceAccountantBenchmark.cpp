@@ -0,0 +1,164 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/Format.h>
+#include <folly/init/Init.h>
+
+#include "fboss/agent/HwAsicTable.h"
+#include "fboss/agent/HwSwitchMatcher.h"
+#include "fboss/agent/ResourceAccountant.h"
+#include "fboss/agent/state/ForwardingInformationBaseContainer.h"
+#include "fboss/agent/state/ForwardingInformationBaseMap.h"
+#include "fboss/agent/state/Route.h"
+#include "fboss/agent/state/StateDelta.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/TestUtils.h"
+
+namespace facebook::fboss {
+
+namespace {
+constexpr auto kNumRoutes = 100000;
+constexpr auto kNumEcmpGroups = 5000;
+// Groups share next hops, each group takes one from each of 4 slots of
+// kNextHopPoolSlot next hops
+constexpr auto kNextHopPoolSlot = 64;
+
+RouteNextHopSet makeEcmpGroup(int group) {
+  RouteNextHopSet nhops;
+  auto addNextHop = [&nhops](int idx) {
+    nhops.insert(ResolvedNextHop(
+        folly::IPAddress(folly::sformat("2401:db00:ffff::{:x}", idx + 1)),
+        InterfaceID(idx % kNextHopPoolSlot + 1),
+        ECMP_WEIGHT));
+  };
+  addNextHop(group % kNextHopPoolSlot);
+  addNextHop(kNextHopPoolSlot + (group / kNextHopPoolSlot) % kNextHopPoolSlot);
+  addNextHop(
+      2 * kNextHopPoolSlot + group / (kNextHopPoolSlot * kNextHopPoolSlot));
+  addNextHop(3 * kNextHopPoolSlot);
+  return nhops;
+}
+
+/*
+ * kNumRoutes v6 routes spread over kNumEcmpGroups ECMP groups. shift
+ * moves every route to the next group, so two states with different
+ * shifts differ in every route but use the same groups.
+ */
+std::shared_ptr<SwitchState> makeRouteState(
+    const std::vector<RouteNextHopSet>& groups,
+    int shift) {
+  auto state = std::make_shared<SwitchState>();
+  auto fibs = state->getFibs()->modify(&state);
+  auto fibContainer =
+      std::make_shared<ForwardingInformationBaseContainer>(RouterID(0));
+  fibs->addNode(
+      fibContainer, HwSwitchMatcher(std::unordered_set<SwitchID>{SwitchID(0)}));
+  for (int i = 0; i < kNumRoutes; ++i) {
+    RoutePrefixV6 prefix{
+        folly::IPAddressV6(
+            folly::sformat("2401:db00:{:x}:{:x}::", i / 65536, i % 65536)),
+        64};
+    auto route = std::make_shared<RouteV6>(RouteV6::makeThrift(prefix));
+    route->setResolved(RouteNextHopEntry(
+        groups[(i + shift) % kNumEcmpGroups], AdminDistance::EBGP));
+    fibContainer->getFibV6()->addNode(route);
+  }
+  state->publish();
+  return state;
+}
+
+struct AccountantHelper {
+  AccountantHelper() {
+    std::map<int64_t, cfg::SwitchInfo> switchIdToSwitchInfo{
+        {0, createSwitchInfo(cfg::SwitchType::NPU)}};
+    asicTable =
+        std::make_unique<HwAsicTable>(switchIdToSwitchInfo, std::nullopt);
+    std::vector<RouteNextHopSet> groups;
+    for (int group = 0; group < kNumEcmpGroups; ++group) {
+      groups.push_back(makeEcmpGroup(group));
+    }
+    emptyState = std::make_shared<SwitchState>();
+    emptyState->publish();
+    routeState = makeRouteState(groups, 0);
+    shiftedRouteState = makeRouteState(groups, 1);
+  }
+
+  std::unique_ptr<ResourceAccountant> makeAccountant(
+      const std::shared_ptr<SwitchState>& state) const {
+    auto accountant = std::make_unique<ResourceAccountant>(asicTable.get());
+    accountant->stateChanged(StateDelta(emptyState, state));
+    return accountant;
+  }
+
+  std::unique_ptr<HwAsicTable> asicTable;
+  std::shared_ptr<SwitchState> emptyState;
+  std::shared_ptr<SwitchState> routeState;
+  std::shared_ptr<SwitchState> shiftedRouteState;
+};
+} // namespace
+
+BENCHMARK(ResourceAccountantAddRoutes, numIters) {
+  std::unique_ptr<AccountantHelper> helper;
+  BENCHMARK_SUSPEND {
+    helper = std::make_unique<AccountantHelper>();
+  }
+  for (size_t n = 0; n < numIters; ++n) {
+    std::unique_ptr<ResourceAccountant> accountant;
+    BENCHMARK_SUSPEND {
+      accountant =
+          std::make_unique<ResourceAccountant>(helper->asicTable.get());
+    }
+    accountant->stateChanged(
+        StateDelta(helper->emptyState, helper->routeState));
+    BENCHMARK_SUSPEND {
+      accountant.reset();
+    }
+  }
+}
+
+BENCHMARK(ResourceAccountantChangeAllRoutes, numIters) {
+  std::unique_ptr<AccountantHelper> helper;
+  std::unique_ptr<ResourceAccountant> accountant;
+  BENCHMARK_SUSPEND {
+    helper = std::make_unique<AccountantHelper>();
+    accountant = helper->makeAccountant(helper->routeState);
+  }
+  for (size_t n = 0; n < numIters; ++n) {
+    const auto& oldState =
+        n % 2 ? helper->shiftedRouteState : helper->routeState;
+    const auto& newState =
+        n % 2 ? helper->routeState : helper->shiftedRouteState;
+    accountant->stateChanged(StateDelta(oldState, newState));
+  }
+}
+
+// 5k ECMP groups are above the mock ASIC limits, so every update is
+// rejected and rolled back
+BENCHMARK(ResourceAccountantRejectChangeAllRoutes, numIters) {
+  std::unique_ptr<AccountantHelper> helper;
+  std::unique_ptr<ResourceAccountant> accountant;
+  BENCHMARK_SUSPEND {
+    helper = std::make_unique<AccountantHelper>();
+    accountant = helper->makeAccountant(helper->routeState);
+  }
+  for (size_t n = 0; n < numIters; ++n) {
+    folly::doNotOptimizeAway(accountant->isValidUpdate(
+        StateDelta(helper->routeState, helper->shiftedRouteState)));
+  }
+}
+
+} // namespace facebook::fboss
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
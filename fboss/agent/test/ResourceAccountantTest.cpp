@@ -284,6 +284,56 @@ TEST_F(ResourceAccountantTest, checkAndUpdateEcmpResource) {
           route0, false /* add */));
 }
 
+TEST_F(ResourceAccountantTest, rollbackEcmpGroupUpdates) {
+  auto makeEcmpRoute = [this](int i) {
+    auto ecmpNextHops = RouteNextHopSet{
+        ResolvedNextHop(
+            folly::IPAddress(folly::to<std::string>("1.1.1.", i + 1)),
+            InterfaceID(i + 1),
+            ecmpWeight),
+        ResolvedNextHop(
+            folly::IPAddress(folly::to<std::string>("1.1.1.", i + 2)),
+            InterfaceID(i + 2),
+            ecmpWeight)};
+    return makeV6Route(
+        {folly::IPAddressV6(folly::to<std::string>(i + 1, "00::1")), 128},
+        {ecmpNextHops, AdminDistance::EBGP});
+  };
+  const auto route0 = makeEcmpRoute(0);
+  const auto route1 = makeEcmpRoute(1);
+  EXPECT_TRUE(
+      this->resourceAccountant_->checkAndUpdateEcmpResource<folly::IPAddressV6>(
+          route0, true /* add */));
+  const auto ecmpMemberUsage = this->resourceAccountant_->ecmpMemberUsage_;
+
+  // Replace route0 by route1 and add another reference to route1's group
+  this->resourceAccountant_->journalEcmpGroupUpdates_ = true;
+  EXPECT_TRUE(
+      this->resourceAccountant_->checkAndUpdateEcmpResource<folly::IPAddressV6>(
+          route1, true /* add */));
+  EXPECT_TRUE(
+      this->resourceAccountant_->checkAndUpdateEcmpResource<folly::IPAddressV6>(
+          route1, true /* add */));
+  EXPECT_TRUE(
+      this->resourceAccountant_->checkAndUpdateEcmpResource<folly::IPAddressV6>(
+          route0, false /* add */));
+  this->resourceAccountant_->journalEcmpGroupUpdates_ = false;
+  EXPECT_EQ(this->resourceAccountant_->ecmpGroupRefMap_.size(), 1);
+  EXPECT_EQ(
+      this->resourceAccountant_->ecmpGroupRefMap_.at(
+          route1->getForwardInfo().getNextHopSet()),
+      2);
+
+  this->resourceAccountant_->rollbackEcmpGroupUpdates();
+  EXPECT_TRUE(this->resourceAccountant_->ecmpGroupUpdateJournal_.empty());
+  EXPECT_EQ(this->resourceAccountant_->ecmpGroupRefMap_.size(), 1);
+  EXPECT_EQ(
+      this->resourceAccountant_->ecmpGroupRefMap_.at(
+          route0->getForwardInfo().getNextHopSet()),
+      1);
+  EXPECT_EQ(this->resourceAccountant_->ecmpMemberUsage_, ecmpMemberUsage);
+}
+
 TEST_F(ResourceAccountantTest, computeWeightedEcmpMemberCount) {
   RouteNextHopSet ecmpNexthops;
   for (int i = 0; i < getMaxEcmpMembers(); i++) {
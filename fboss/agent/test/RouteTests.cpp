@@ -887,6 +887,79 @@ TEST_F(RouteTest, dropRoutes) {
       RouteNextHopEntry(RouteForwardAction::DROP, DISTANCE));
 }
 
+TEST_F(RouteTest, fibLongestMatch) {
+  auto rid = RouterID(0);
+  auto u1 = this->sw_->getRouteUpdater();
+  // resolved through interface 1
+  u1.addRoute(
+      rid,
+      IPAddress("10.1.1.0"),
+      24,
+      kClientA,
+      RouteNextHopEntry(makeNextHops({"1.1.1.10"}), DISTANCE));
+  u1.addRoute(
+      rid,
+      IPAddress("2001:1::"),
+      64,
+      kClientA,
+      RouteNextHopEntry(makeNextHops({"1::10"}), DISTANCE));
+  // unresolvable, more specific
+  u1.addRoute(
+      rid,
+      IPAddress("10.1.1.10"),
+      32,
+      kClientA,
+      RouteNextHopEntry(makeNextHops({"99.99.99.99"}), DISTANCE));
+  u1.addRoute(
+      rid,
+      IPAddress("2001:1::10"),
+      128,
+      kClientA,
+      RouteNextHopEntry(makeNextHops({"99::99"}), DISTANCE));
+  u1.program();
+  auto state1 = this->sw_->getState();
+
+  // The RIB matches the unresolved route, the FIB the resolved one that
+  // hardware forwards with
+  auto ip4 = IPAddressV4("10.1.1.10");
+  auto ip6 = IPAddressV6("2001:1::10");
+  auto ribRoute4 = this->sw_->longestMatch(state1, ip4, rid);
+  ASSERT_NE(nullptr, ribRoute4);
+  EXPECT_EQ(ribRoute4->prefix(), makePrefixV4("10.1.1.10/32"));
+  EXPECT_FALSE(ribRoute4->isResolved());
+  auto fibRoute4 = this->sw_->fibLongestMatch(state1, ip4, rid);
+  EXPECT_RESOLVED(fibRoute4);
+  EXPECT_EQ(fibRoute4->prefix(), makePrefixV4("10.1.1.0/24"));
+  auto ribRoute6 = this->sw_->longestMatch(state1, ip6, rid);
+  ASSERT_NE(nullptr, ribRoute6);
+  EXPECT_EQ(ribRoute6->prefix(), makePrefixV6("2001:1::10/128"));
+  EXPECT_FALSE(ribRoute6->isResolved());
+  auto fibRoute6 = this->sw_->fibLongestMatch(state1, ip6, rid);
+  EXPECT_RESOLVED(fibRoute6);
+  EXPECT_EQ(fibRoute6->prefix(), makePrefixV6("2001:1::/64"));
+
+  // Resolved more specific route
+  auto u2 = this->sw_->getRouteUpdater();
+  u2.addRoute(
+      rid,
+      IPAddress("10.1.1.0"),
+      25,
+      kClientA,
+      RouteNextHopEntry(makeNextHops({"2.2.2.10"}), DISTANCE));
+  u2.program();
+  auto state2 = this->sw_->getState();
+  EXPECT_EQ(
+      this->sw_->fibLongestMatch(state2, ip4, rid)->prefix(),
+      makePrefixV4("10.1.1.0/25"));
+  // Lookups with an older state than the snapshot's fall back to the RIB
+  EXPECT_EQ(
+      this->sw_->fibLongestMatch(state1, ip4, rid),
+      this->sw_->longestMatch(state1, ip4, rid));
+  EXPECT_EQ(
+      this->sw_->fibLongestMatch(state1, IPAddressV4("10.2.2.2"), rid),
+      this->sw_->longestMatch(state1, IPAddressV4("10.2.2.2"), rid));
+}
+
 TEST_F(RouteTest, toCPURoutes) {
   auto rid = RouterID(0);
   auto u1 = this->sw_->getRouteUpdater();
@@ -0,0 +1,112 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/RouteUpdateTrace.h"
+
+#include <folly/json/json.h>
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+DECLARE_bool(enable_route_update_trace);
+DECLARE_int32(route_update_trace_sample_rate);
+DECLARE_int32(route_update_trace_buffer_size);
+
+using namespace facebook::fboss;
+using namespace std::chrono_literals;
+
+class RouteUpdateTraceTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    FLAGS_enable_route_update_trace = true;
+    RouteUpdateTrace::clearSampledTraces();
+  }
+
+ private:
+  gflags::FlagSaver flagSaver_;
+};
+
+TEST_F(RouteUpdateTraceTest, Disabled) {
+  FLAGS_enable_route_update_trace = false;
+  auto trace = RouteUpdateTrace::start("addUnicastRoutesInVrf");
+  EXPECT_EQ(trace, nullptr);
+  RouteUpdateTrace::Scope traceScope(trace);
+  // no-op without a current trace
+  RouteUpdateTrace::ScopedStage traceStage(RouteUpdateStage::RIB);
+  EXPECT_EQ(RouteUpdateTrace::current(), nullptr);
+}
+
+TEST_F(RouteUpdateTraceTest, StagesAcrossThreads) {
+  auto trace = RouteUpdateTrace::start("syncFibInVrf");
+  ASSERT_NE(trace, nullptr);
+  {
+    RouteUpdateTrace::Scope traceScope(trace);
+    EXPECT_EQ(RouteUpdateTrace::current(), trace);
+
+    // hand off to another thread, like the RIB thread does
+    auto current = RouteUpdateTrace::current();
+    std::thread ribThread([current] {
+      RouteUpdateTrace::Scope ribScope(current);
+      {
+        RouteUpdateTrace::ScopedStage ribStage(RouteUpdateStage::RIB);
+        std::this_thread::sleep_for(1ms);
+      }
+      RouteUpdateTrace::current()->begin(RouteUpdateStage::QUEUE_WAIT);
+    });
+    ribThread.join();
+    trace->end(RouteUpdateStage::QUEUE_WAIT);
+    {
+      RouteUpdateTrace::ScopedStage hwStage(RouteUpdateStage::HW_UPDATE);
+      std::this_thread::sleep_for(1ms);
+    }
+  }
+  EXPECT_EQ(RouteUpdateTrace::current(), nullptr);
+  trace->finish();
+
+  EXPECT_GE(trace->getStageDuration(RouteUpdateStage::RIB), 1ms);
+  EXPECT_GE(trace->getStageDuration(RouteUpdateStage::HW_UPDATE), 1ms);
+  EXPECT_EQ(
+      trace->getStageDuration(RouteUpdateStage::FSDB_ENQUEUE).count(), 0);
+  EXPECT_GE(
+      trace->getStageDuration(RouteUpdateStage::TOTAL),
+      trace->getStageDuration(RouteUpdateStage::RIB) +
+          trace->getStageDuration(RouteUpdateStage::QUEUE_WAIT) +
+          trace->getStageDuration(RouteUpdateStage::HW_UPDATE));
+  // rib, queue_wait, hw_update and total
+  EXPECT_EQ(trace->getSpans().size(), 4);
+  EXPECT_TRUE(RouteUpdateTrace::getSampledTraces().empty());
+}
+
+TEST_F(RouteUpdateTraceTest, SampledChromeTrace) {
+  FLAGS_route_update_trace_sample_rate = 1;
+  FLAGS_route_update_trace_buffer_size = 2;
+  for (auto i = 0; i < 3; ++i) {
+    auto trace = RouteUpdateTrace::start("addUnicastRoutesInVrf");
+    RouteUpdateTrace::Scope traceScope(trace);
+    { RouteUpdateTrace::ScopedStage ribStage(RouteUpdateStage::RIB); }
+    trace->finish();
+  }
+  auto traces = RouteUpdateTrace::getSampledTraces();
+  ASSERT_EQ(traces.size(), 2);
+  EXPECT_LT(traces[0]->getID(), traces[1]->getID());
+
+  auto chromeTrace =
+      folly::parseJson(RouteUpdateTrace::toChromeTrace(traces));
+  const auto& events = chromeTrace["traceEvents"];
+  ASSERT_EQ(events.size(), 4);
+  for (const auto& event : events) {
+    EXPECT_EQ(event["ph"].asString(), "X");
+    EXPECT_EQ(event["cat"].asString(), "addUnicastRoutesInVrf");
+    EXPECT_GE(event["dur"].asInt(), 0);
+  }
+  EXPECT_EQ(events[0]["name"].asString(), "rib");
+  EXPECT_EQ(events[1]["name"].asString(), "total");
+}
@@ -15,6 +15,8 @@
 #include "fboss/agent/MultiSwitchFb303Stats.h"
 #include "fboss/agent/NeighborUpdater.h"
 #include "fboss/agent/PortStats.h"
+#include "fboss/agent/RouteUpdateTrace.h"
+#include "fboss/agent/StateObserver.h"
 #include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/state/ArpTable.h"
 #include "fboss/agent/state/Interface.h"
@@ -29,9 +31,12 @@
 #include <folly/IPAddressV4.h>
 #include <folly/IPAddressV6.h>
 #include <folly/MacAddress.h>
+#include <gflags/gflags.h>
 
 #include <algorithm>
 
+DECLARE_bool(enable_route_update_trace);
+
 using namespace facebook::fboss;
 using folly::IPAddressV4;
 using folly::IPAddressV6;
@@ -46,6 +51,44 @@ namespace {
 HwSwitchMatcher scope() {
   return HwSwitchMatcher{std::unordered_set<SwitchID>{SwitchID(0)}};
 }
+
+// Queues a follow up update from the update thread when notified of a traced
+// update, like MirrorManager and AclNexthopHandler do.
+class FollowUpUpdateObserver : public StateObserver {
+ public:
+  explicit FollowUpUpdateObserver(SwSwitch* sw) : sw_(sw) {
+    sw_->registerStateObserver(this, "FollowUpUpdateObserver");
+  }
+  ~FollowUpUpdateObserver() override {
+    sw_->unregisterStateObserver(this);
+  }
+
+  void stateUpdated(const StateDelta& /*delta*/) override {
+    if (queued_ || !RouteUpdateTrace::current()) {
+      return;
+    }
+    queued_ = true;
+    sw_->updateState(
+        "follow up", [this](const std::shared_ptr<SwitchState>& /*state*/) {
+          followUpApplied_ = true;
+          followUpTrace_ = RouteUpdateTrace::current();
+          return std::shared_ptr<SwitchState>();
+        });
+  }
+
+  bool followUpApplied() const {
+    return followUpApplied_;
+  }
+  const std::shared_ptr<RouteUpdateTrace>& followUpTrace() const {
+    return followUpTrace_;
+  }
+
+ private:
+  SwSwitch* sw_;
+  bool queued_{false};
+  bool followUpApplied_{false};
+  std::shared_ptr<RouteUpdateTrace> followUpTrace_;
+};
 } // namespace
 
 class SwSwitchTest : public ::testing::Test {
@@ -291,6 +334,34 @@ TEST_F(SwSwitchTest, swSwitchRunState) {
   EXPECT_EQ(switchSettings->getSwSwitchRunState(), SwitchRunState::CONFIGURED);
 }
 
+TEST_F(SwSwitchTest, observerUpdateDoesNotInheritRouteTrace) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_enable_route_update_trace = true;
+  FollowUpUpdateObserver observer(sw);
+
+  auto trace = RouteUpdateTrace::start("addUnicastRoutesInVrf");
+  ASSERT_NE(trace, nullptr);
+  std::shared_ptr<RouteUpdateTrace> updateTrace;
+  {
+    RouteUpdateTrace::Scope traceScope(trace);
+    sw->updateStateBlocking(
+        "Flap port 2", [&](const std::shared_ptr<SwitchState>& state) {
+          updateTrace = RouteUpdateTrace::current();
+          std::shared_ptr<SwitchState> newState(state);
+          auto* port = newState->getPorts()->getNodeIf(PortID(2)).get();
+          port = port->modify(&newState);
+          port->setOperState(!port->isUp());
+          return newState;
+        });
+  }
+  // The follow up was queued while notifying observers of the traced update
+  waitForStateUpdates(sw);
+
+  EXPECT_EQ(updateTrace, trace);
+  EXPECT_TRUE(observer.followUpApplied());
+  EXPECT_EQ(observer.followUpTrace(), nullptr);
+}
+
 template <bool enableIntfNbrTable>
 struct EnableIntfNbrTable {
   static constexpr auto intfNbrTable = enableIntfNbrTable;
@@ -695,20 +695,22 @@ shared_ptr<SwitchState> publishAndApplyConfig(
     const shared_ptr<SwitchState>& state,
     cfg::SwitchConfig* config,
     const Platform* platform,
-    RoutingInformationBase* rib) {
+    RoutingInformationBase* rib,
+    AppliedConfigSections* appliedSections) {
   if (config->switchSettings()->switchIdToSwitchInfo()->empty()) {
     config->switchSettings()->switchIdToSwitchInfo() = {
         {0, createSwitchInfo(cfg::SwitchType::NPU)}};
   }
   return publishAndApplyConfig(
-      state, (const cfg::SwitchConfig*)config, platform, rib);
+      state, (const cfg::SwitchConfig*)config, platform, rib, appliedSections);
 }
 
 shared_ptr<SwitchState> publishAndApplyConfig(
     const shared_ptr<SwitchState>& state,
     const cfg::SwitchConfig* config,
     const Platform* platform,
-    RoutingInformationBase* rib) {
+    RoutingInformationBase* rib,
+    AppliedConfigSections* appliedSections) {
   state->publish();
   auto platformMapping = std::make_unique<MockPlatformMapping>();
   auto hwAsicTable = HwAsicTable(
@@ -723,7 +725,9 @@ shared_ptr<SwitchState> publishAndApplyConfig(
       platform->supportsAddRemovePort(),
       platformMapping.get(),
       &hwAsicTable,
-      rib);
+      rib,
+      nullptr /* aclNexthopHandler */,
+      appliedSections);
 }
 
 std::unique_ptr<SwSwitch> setupMockSwitchWithoutHW(
@@ -12,6 +12,7 @@
 #include "common/network/if/gen-cpp2/Address_types.h"
 #include "fboss/agent/AddressUtil.h"
 #include "fboss/agent/ApplyThriftConfig.h"
+#include "fboss/agent/HwSwitchStatsDelta.h"
 #include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/ThriftHandler.h"
 #include "fboss/agent/TxPacket.h"
@@ -635,3 +636,42 @@ CO_TEST_F(ThriftServerTest, statsUpdate) {
   handler.getAllCpuPortStats(cpuPortStats);
   EXPECT_EQ(cpuPortStats[0], getTestStatUpdate().cpuPortStats().value());
 }
+
+CO_TEST_F(ThriftServerTest, statsDeltaUpdate) {
+  // setup server and clients
+  setupServerAndClients();
+
+  auto portName = sw_->getState()->getPorts()->getNodeIf(PortID(5))->getName();
+  auto getTestStatUpdate = [&portName](int64_t timestamp, int64_t inBytes) {
+    multiswitch::HwSwitchStats stats;
+    stats.timestamp() = timestamp;
+    HwPortStats portStats;
+    portStats.inBytes_() = inBytes;
+    portStats.queueOutBytes_() = {{1, inBytes / 2}};
+    stats.hwPortStats() = {{portName, std::move(portStats)}};
+    stats.hwResourceStats()->acl_counters_free() = 50;
+    return stats;
+  };
+
+  uint16_t switchIndex = 0;
+  CounterCache counters(sw_);
+  HwSwitchStatsDeltaEncoder encoder;
+  auto result = co_await multiSwitchClient_->co_syncHwStatsDelta(switchIndex);
+  auto ret = co_await result.sink(
+      [&]() -> folly::coro::AsyncGenerator<multiswitch::HwSwitchStatsDelta&&> {
+        WITH_RETRIES({
+          counters.update();
+          EXPECT_EVENTUALLY_EQ(
+              counters.value("switch.0.stats_event_sync_active"), 1);
+        });
+        co_yield encoder.encode(getTestStatUpdate(1000, 10000));
+        auto delta = encoder.encode(getTestStatUpdate(1001, 12000));
+        EXPECT_FALSE(*delta.fullSnapshot());
+        EXPECT_EQ(delta.hwPortStatsDelta()->size(), 1);
+        co_yield std::move(delta);
+      }());
+  EXPECT_TRUE(ret);
+  EXPECT_EQ(
+      sw_->getHwSwitchStatsExpensive(switchIndex),
+      getTestStatUpdate(1001, 12000));
+}
@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <folly/io/IOBuf.h>
+
+#include "fboss/agent/TxPacket.h"
+#include "fboss/agent/TxPacketBufferPool.h"
+
+namespace facebook::fboss {
+
+namespace {
+// Size of an LLDP packet
+constexpr uint32_t kPktSize = 300;
+} // namespace
+
+// Each iteration allocates a packet buffer and frees it, like a packet
+// that is sent right away
+
+BENCHMARK(IOBufCreate, numIters) {
+  for (size_t n = 0; n < numIters; ++n) {
+    auto buf = folly::IOBuf::create(kPktSize);
+    buf->append(kPktSize);
+    folly::doNotOptimizeAway(buf->writableData());
+  }
+}
+
+BENCHMARK_RELATIVE(IOBufCreateCombined, numIters) {
+  for (size_t n = 0; n < numIters; ++n) {
+    auto buf = folly::IOBuf::createCombined(kPktSize);
+    buf->append(kPktSize);
+    folly::doNotOptimizeAway(buf->writableData());
+  }
+}
+
+BENCHMARK_RELATIVE(TxPacketBufferPoolAllocate, numIters) {
+  for (size_t n = 0; n < numIters; ++n) {
+    auto buf = TxPacketBufferPool::allocate(kPktSize);
+    folly::doNotOptimizeAway(buf->writableData());
+    TxPacketBufferPool::release(std::move(buf));
+  }
+}
+
+BENCHMARK_RELATIVE(AllocateTxPacket, numIters) {
+  for (size_t n = 0; n < numIters; ++n) {
+    auto pkt = TxPacket::allocateTxPacket(kPktSize);
+    folly::doNotOptimizeAway(pkt->buf()->writableData());
+  }
+}
+
+} // namespace facebook::fboss
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
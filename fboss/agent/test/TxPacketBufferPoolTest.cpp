@@ -0,0 +1,146 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/TxPacketBufferPool.h"
+#include "fboss/agent/TxPacket.h"
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+DECLARE_int32(tx_packet_pool_cache_size);
+
+using namespace facebook::fboss;
+
+class TxPacketBufferPoolTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    TxPacketBufferPool::clearThreadCache();
+    startStats_ = TxPacketBufferPool::getThreadStats();
+  }
+
+  void TearDown() override {
+    TxPacketBufferPool::clearThreadCache();
+  }
+
+ protected:
+  uint64_t hits() const {
+    return TxPacketBufferPool::getThreadStats().hits - startStats_.hits;
+  }
+  uint64_t misses() const {
+    return TxPacketBufferPool::getThreadStats().misses - startStats_.misses;
+  }
+
+ private:
+  gflags::FlagSaver flagSaver_;
+  TxPacketBufferPool::Stats startStats_;
+};
+
+TEST_F(TxPacketBufferPoolTest, ReuseBuffer) {
+  auto buf = TxPacketBufferPool::allocate(64);
+  EXPECT_EQ(buf->length(), 64);
+  EXPECT_GE(buf->headroom(), TxPacketBufferPool::kHeadroom);
+  auto data = buf->data();
+  TxPacketBufferPool::release(std::move(buf));
+
+  // same size class
+  buf = TxPacketBufferPool::allocate(128);
+  EXPECT_EQ(buf->length(), 128);
+  EXPECT_EQ(buf->headroom(), TxPacketBufferPool::kHeadroom);
+  EXPECT_EQ(buf->data(), data);
+  EXPECT_EQ(hits(), 1);
+  EXPECT_EQ(misses(), 1);
+
+  // different size class
+  auto bigBuf = TxPacketBufferPool::allocate(1500);
+  EXPECT_EQ(bigBuf->length(), 1500);
+  EXPECT_EQ(hits(), 1);
+  EXPECT_EQ(misses(), 2);
+}
+
+TEST_F(TxPacketBufferPoolTest, TxPacketReleasesBuffer) {
+  const uint8_t* data;
+  {
+    auto pkt = TxPacket::allocateTxPacket(64);
+    EXPECT_EQ(pkt->buf()->length(), 64);
+    EXPECT_GE(pkt->buf()->headroom(), TxPacketBufferPool::kHeadroom);
+    data = pkt->buf()->data();
+  }
+  auto pkt = TxPacket::allocateTxPacket(64);
+  EXPECT_EQ(pkt->buf()->data(), data);
+  EXPECT_EQ(hits(), 1);
+
+  // Buffers extracted from the packet are not returned to the pool
+  auto buf = Packet::extractIOBuf(std::move(pkt));
+  pkt = TxPacket::allocateTxPacket(64);
+  EXPECT_NE(pkt->buf()->data(), buf->data());
+  EXPECT_EQ(hits(), 1);
+}
+
+TEST_F(TxPacketBufferPoolTest, NotPooled) {
+  // shared buffers stay with their clones
+  auto buf = TxPacketBufferPool::allocate(64);
+  auto clone = buf->clone();
+  TxPacketBufferPool::release(std::move(buf));
+  buf = TxPacketBufferPool::allocate(64);
+  EXPECT_NE(buf->data(), clone->data());
+
+  // larger than any size class
+  auto hugeBuf = TxPacketBufferPool::allocate(65536);
+  EXPECT_EQ(hugeBuf->length(), 65536);
+  EXPECT_GE(hugeBuf->headroom(), TxPacketBufferPool::kHeadroom);
+
+  // pool disabled
+  FLAGS_tx_packet_pool_cache_size = 0;
+  TxPacketBufferPool::release(std::move(buf));
+  buf = TxPacketBufferPool::allocate(64);
+  EXPECT_EQ(hits(), 0);
+  EXPECT_EQ(misses(), 4);
+}
+
+TEST_F(TxPacketBufferPoolTest, CacheSize) {
+  FLAGS_tx_packet_pool_cache_size = 2;
+  std::vector<std::unique_ptr<folly::IOBuf>> bufs;
+  for (auto i = 0; i < 3; ++i) {
+    bufs.push_back(TxPacketBufferPool::allocate(64));
+  }
+  for (auto& buf : bufs) {
+    TxPacketBufferPool::release(std::move(buf));
+  }
+  for (auto& buf : bufs) {
+    buf = TxPacketBufferPool::allocate(64);
+  }
+  EXPECT_EQ(hits(), 2);
+  EXPECT_EQ(misses(), 4);
+}
+
+TEST_F(TxPacketBufferPoolTest, OversizedTxPacketNotPooled) {
+  // Just above the largest size class, the buffer must not end up in it
+  const auto size = TxPacketBufferPool::kMaxPooledSize + 1;
+  TxPacket::allocateTxPacket(size).reset();
+  auto pkt = TxPacket::allocateTxPacket(TxPacketBufferPool::kMaxPooledSize);
+  EXPECT_EQ(pkt->buf()->length(), TxPacketBufferPool::kMaxPooledSize);
+  EXPECT_EQ(hits(), 0);
+  EXPECT_EQ(misses(), 2);
+}
+
+TEST_F(TxPacketBufferPoolTest, ReleasedToReleasingThread) {
+  auto pkt = TxPacket::allocateTxPacket(64);
+  std::thread releaser([&pkt] {
+    pkt.reset();
+    TxPacketBufferPool::clearThreadCache();
+  });
+  releaser.join();
+  // The buffer went to the releasing thread's cache, not this one's
+  pkt = TxPacket::allocateTxPacket(64);
+  EXPECT_EQ(hits(), 0);
+  EXPECT_EQ(misses(), 2);
+}
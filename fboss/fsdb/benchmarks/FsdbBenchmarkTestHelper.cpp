@@ -2,6 +2,8 @@
 
 #include "fboss/fsdb/benchmarks/FsdbBenchmarkTestHelper.h"
 
+#include "fboss/thrift_cow/visitors/ThriftObjectPatchBuilder.h"
+
 namespace {
 
 const thriftpath::RootThriftPath<facebook::fboss::fsdb::FsdbOperStateRoot>
@@ -33,7 +35,26 @@ void FsdbBenchmarkTestHelper::publishPath(
   pubsubMgr_->publishStat(std::move(state));
 }
 
-void FsdbBenchmarkTestHelper::startPublisher() {
+void FsdbBenchmarkTestHelper::publishFullPatch(
+    const AgentStats& stats,
+    uint64_t stamp) {
+  auto patch = thrift_cow::ThriftObjectPatchBuilder::buildFull(
+      stats, getAgentStatsPath());
+  patch.metadata()->lastConfirmedAt() = stamp;
+  pubsubMgr_->publishStat(std::move(patch));
+}
+
+void FsdbBenchmarkTestHelper::publishPatch(
+    const AgentStats& prevStats,
+    const AgentStats& stats,
+    uint64_t stamp) {
+  auto patch = thrift_cow::ThriftObjectPatchBuilder::build(
+      prevStats, stats, getAgentStatsPath());
+  patch.metadata()->lastConfirmedAt() = stamp;
+  pubsubMgr_->publishStat(std::move(patch));
+}
+
+void FsdbBenchmarkTestHelper::startPublisher(bool usePatch) {
   auto stateChangeCb = [this](
                            fsdb::FsdbStreamClient::State /* oldState */,
                            fsdb::FsdbStreamClient::State newState) {
@@ -44,9 +65,15 @@ void FsdbBenchmarkTestHelper::startPublisher() {
       readyForPublishing_.store(false);
     }
   };
-  // agent is Path publisher for stats
-  pubsubMgr_->createStatPathPublisher(
-      getAgentStatsPath(), std::move(stateChangeCb));
+  usePatch_ = usePatch;
+  if (usePatch_) {
+    pubsubMgr_->createStatPatchPublisher(
+        getAgentStatsPath(), std::move(stateChangeCb));
+  } else {
+    // agent is Path publisher for stats
+    pubsubMgr_->createStatPathPublisher(
+        getAgentStatsPath(), std::move(stateChangeCb));
+  }
 }
 
 void FsdbBenchmarkTestHelper::waitForPublisherConnected() {
@@ -55,7 +82,11 @@ void FsdbBenchmarkTestHelper::waitForPublisherConnected() {
 
 void FsdbBenchmarkTestHelper::stopPublisher(bool gr) {
   readyForPublishing_.store(false);
-  pubsubMgr_->removeStatPathPublisher(gr);
+  if (usePatch_) {
+    pubsubMgr_->removeStatPatchPublisher(gr);
+  } else {
+    pubsubMgr_->removeStatPathPublisher(gr);
+  }
 }
 
 void FsdbBenchmarkTestHelper::TearDown() {
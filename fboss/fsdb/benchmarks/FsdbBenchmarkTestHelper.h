@@ -13,7 +13,13 @@ class FsdbBenchmarkTestHelper {
  public:
   void setup();
   void publishPath(const AgentStats& stats, uint64_t stamp);
-  void startPublisher();
+  // Patch publisher only, see startPublisher(usePatch)
+  void publishFullPatch(const AgentStats& stats, uint64_t stamp);
+  void publishPatch(
+      const AgentStats& prevStats,
+      const AgentStats& stats,
+      uint64_t stamp);
+  void startPublisher(bool usePatch = false);
   void stopPublisher(bool gr = false);
   void TearDown();
   void waitForPublisherConnected();
@@ -33,6 +39,7 @@ class FsdbBenchmarkTestHelper {
   std::unique_ptr<fsdb::FsdbPubSubManager> pubsubMgr_;
   folly::Baton<> publisherConnected_;
   std::atomic_bool readyForPublishing_ = false;
+  bool usePatch_{false};
 };
 
 } // namespace facebook::fboss::fsdb::test
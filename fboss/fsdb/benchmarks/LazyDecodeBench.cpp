@@ -0,0 +1,111 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include <folly/Benchmark.h>
+#include <gflags/gflags.h>
+
+#include "fboss/agent/gen-cpp2/switch_state_fatal_types.h"
+#include "fboss/fsdb/benchmarks/StateGenerator.h"
+#include "fboss/thrift_cow/nodes/Serializer.h"
+#include "fboss/thrift_cow/nodes/ThriftLazyStructNode.h"
+#include "fboss/thrift_cow/nodes/Types.h"
+
+DEFINE_int32(lazy_decode_n_sysports, 10000, "number of SysPorts");
+DEFINE_int32(lazy_decode_n_ports, 512, "number of Ports");
+
+namespace facebook::fboss::fsdb::test {
+
+namespace {
+
+using k = state::switch_state_tags::strings;
+using SwitchStateNode = thrift_cow::ThriftStructNode<state::SwitchState>;
+using LazySwitchStateNode =
+    thrift_cow::ThriftLazyStructNode<state::SwitchState>;
+
+constexpr auto kProtocol = OperProtocol::BINARY;
+
+folly::IOBuf encodedSwitchState() {
+  state::SwitchState state;
+  StateGenerator::fillSwitchState(
+      &state, FLAGS_lazy_decode_n_sysports, FLAGS_lazy_decode_n_ports);
+  return thrift_cow::serializeBuf<apache::thrift::type_class::structure>(
+      kProtocol, state);
+}
+
+} // namespace
+
+/*
+ * A subscriber to switch state which only reads ports, e.g. led_service.
+ * Full decode pays for all system ports, lazy decode only for the ports.
+ */
+BENCHMARK(FullDecodeSwitchStateCow, n) {
+  folly::BenchmarkSuspender suspender;
+  auto encoded = encodedSwitchState();
+  suspender.dismiss();
+
+  for (unsigned i = 0; i < n; ++i) {
+    auto node = std::make_shared<SwitchStateNode>();
+    node->fromEncodedBuf(kProtocol, encoded.cloneAsValue());
+    folly::doNotOptimizeAway(node->cref<k::portMaps>()->size());
+  }
+}
+
+BENCHMARK_RELATIVE(LazyDecodeSwitchStateCow, n) {
+  folly::BenchmarkSuspender suspender;
+  auto encoded = encodedSwitchState();
+  suspender.dismiss();
+
+  for (unsigned i = 0; i < n; ++i) {
+    LazySwitchStateNode node(kProtocol, encoded.cloneAsValue());
+    folly::doNotOptimizeAway(node.cref<k::portMaps>()->size());
+  }
+}
+
+BENCHMARK(FullDecodeSwitchStateThrift, n) {
+  folly::BenchmarkSuspender suspender;
+  auto encoded = encodedSwitchState();
+  suspender.dismiss();
+
+  for (unsigned i = 0; i < n; ++i) {
+    auto switchState = thrift_cow::deserializeBuf<
+        apache::thrift::type_class::structure,
+        state::SwitchState>(kProtocol, encoded.cloneAsValue());
+    folly::doNotOptimizeAway(switchState.portMaps()->size());
+  }
+}
+
+BENCHMARK_RELATIVE(LazyDecodeSwitchStateThrift, n) {
+  folly::BenchmarkSuspender suspender;
+  auto encoded = encodedSwitchState();
+  suspender.dismiss();
+
+  for (unsigned i = 0; i < n; ++i) {
+    LazySwitchStateNode node(kProtocol, encoded.cloneAsValue());
+    folly::doNotOptimizeAway(node.getThrift<k::portMaps>().size());
+  }
+}
+
+// Cost of lazy decoding when everything ends up being read
+BENCHMARK(FullDecodeSwitchStateAll, n) {
+  folly::BenchmarkSuspender suspender;
+  auto encoded = encodedSwitchState();
+  suspender.dismiss();
+
+  for (unsigned i = 0; i < n; ++i) {
+    auto node = std::make_shared<SwitchStateNode>();
+    node->fromEncodedBuf(kProtocol, encoded.cloneAsValue());
+    folly::doNotOptimizeAway(node);
+  }
+}
+
+BENCHMARK_RELATIVE(LazyDecodeSwitchStateAll, n) {
+  folly::BenchmarkSuspender suspender;
+  auto encoded = encodedSwitchState();
+  suspender.dismiss();
+
+  for (unsigned i = 0; i < n; ++i) {
+    LazySwitchStateNode node(kProtocol, encoded.cloneAsValue());
+    folly::doNotOptimizeAway(node.materialize());
+  }
+}
+
+} // namespace facebook::fboss::fsdb::test
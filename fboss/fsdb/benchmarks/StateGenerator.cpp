@@ -67,4 +67,41 @@ void StateGenerator::updateVoqStats(AgentStats* stats, int increment) {
   }
 }
 
+void StateGenerator::fillSwitchState(
+    state::SwitchState* state,
+    int nSysPorts,
+    int nPorts,
+    int nVoqsPerSysPort) {
+  const std::string switchIds = "id=0";
+  auto& sysPorts = (*state->systemPortMaps())[switchIds];
+  for (int portId = 0; portId < nSysPorts; ++portId) {
+    state::SystemPortFields sysPort;
+    sysPort.portId() = portId;
+    sysPort.switchId() = 0;
+    sysPort.portName() = folly::to<std::string>("rdsw0::eth/", portId, "/1");
+    sysPort.coreIndex() = portId % 8;
+    sysPort.corePortIndex() = portId;
+    sysPort.speedMbps() = 400000;
+    sysPort.numVoqs() = nVoqsPerSysPort;
+    for (int queueId = 0; queueId < nVoqsPerSysPort; queueId++) {
+      PortQueueFields queue;
+      queue.id() = queueId;
+      queue.scalingFactor() = "ONE";
+      sysPort.queues()->push_back(std::move(queue));
+    }
+    sysPorts.emplace(portId, std::move(sysPort));
+  }
+
+  auto& ports = (*state->portMaps())[switchIds];
+  for (int portId = 0; portId < nPorts; ++portId) {
+    state::PortFields port;
+    port.portId() = portId;
+    port.portName() = folly::to<std::string>("eth/", portId, "/1");
+    port.portState() = "ENABLED";
+    port.portOperState() = true;
+    port.portSpeed() = "FOURHUNDREDG";
+    ports.emplace(portId, std::move(port));
+  }
+}
+
 } // namespace facebook::fboss::fsdb::test
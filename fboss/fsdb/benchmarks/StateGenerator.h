@@ -3,6 +3,7 @@
 #pragma once
 
 #include "fboss/agent/gen-cpp2/agent_stats_types.h"
+#include "fboss/agent/gen-cpp2/switch_state_types.h"
 
 namespace facebook::fboss::fsdb::test {
 
@@ -14,6 +15,11 @@ class StateGenerator {
       int nVoqsPerSysPort,
       int value = 1);
   static void updateVoqStats(AgentStats* stats, int increment = 1);
+  static void fillSwitchState(
+      state::SwitchState* state,
+      int nSysPorts,
+      int nPorts,
+      int nVoqsPerSysPort = 8);
 };
 
 } // namespace facebook::fboss::fsdb::test
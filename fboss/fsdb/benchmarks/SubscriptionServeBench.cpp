@@ -0,0 +1,148 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include <folly/Benchmark.h>
+#include <gflags/gflags.h>
+
+#include "fboss/fsdb/benchmarks/StateGenerator.h"
+#include "fboss/fsdb/oper/CowSubscriptionTraverseHelper.h"
+#include "fboss/fsdb/oper/Subscription.h"
+#include "fboss/fsdb/oper/SubscriptionPathStore.h"
+#include "fboss/fsdb/oper/instantiations/FsdbCowRoot.h"
+#include "fboss/fsdb/oper/instantiations/FsdbPathConverter.h"
+#include "fboss/thrift_cow/visitors/DeltaVisitor.h"
+
+DEFINE_int32(serve_n_sysports, 2500, "number of SysPorts");
+DEFINE_int32(serve_n_voqs_per_sysport, 4, "number of VOQs per SysPort");
+
+namespace facebook::fboss::fsdb::test {
+
+namespace {
+
+/*
+ * One path subscription per VOQ counter of every system port, 10k with the
+ * default flags, and a publish that changes all of them. Serving walks the
+ * delta and looks up the subscription path store at every changed node,
+ * the same as CowSubscriptionManager::serveSubscriptions.
+ */
+class FineGrainedSubscriptions {
+ public:
+  explicit FineGrainedSubscriptions(bool useIdPaths)
+      : useIdPaths_(useIdPaths), store_(&storeStats_) {
+    FsdbOperStatsRoot root;
+    StateGenerator::fillVoqStats(
+        &*root.agent(),
+        FLAGS_serve_n_sysports,
+        FLAGS_serve_n_voqs_per_sysport);
+    oldRoot_ = std::make_shared<thrift_cow::FsdbCowStatsRoot>(root);
+    StateGenerator::updateVoqStats(&*root.agent());
+    newRoot_ = std::make_shared<thrift_cow::FsdbCowStatsRoot>(root);
+
+    for (const auto& [switchIdx, sysPortStats] :
+         *root.agent()->sysPortStatsMap()) {
+      for (const auto& [portName, stats] : sysPortStats) {
+        for (const auto& [queueId, _] : *stats.queueOutBytes_()) {
+          paths_.push_back(
+              {"agent",
+               "sysPortStatsMap",
+               folly::to<std::string>(switchIdx),
+               portName,
+               "queueOutBytes_",
+               folly::to<std::string>(queueId)});
+          if (useIdPaths_) {
+            paths_.back() =
+                PathConverter<FsdbOperStatsRoot>::pathToIdTokens(
+                    paths_.back());
+          }
+        }
+      }
+    }
+  }
+
+  void subscribe() {
+    for (const auto& path : paths_) {
+      auto [generator, subscription] = PathSubscription::create(
+          "bench",
+          path.begin(),
+          path.end(),
+          OperProtocol::BINARY,
+          std::nullopt,
+          nullptr,
+          std::chrono::milliseconds(0));
+      store_.add(subscription.get(), &storeStats_);
+      subscriptions_.push_back(std::move(subscription));
+    }
+  }
+
+  size_t serve() {
+    size_t served{0};
+    std::optional<thrift_cow::PatchNodeBuilder> patchBuilder;
+    CowSubscriptionTraverseHelper traverser(&store_, patchBuilder);
+    thrift_cow::RootDeltaVisitor::visit(
+        traverser,
+        oldRoot_,
+        newRoot_,
+        thrift_cow::DeltaVisitOptions(
+            thrift_cow::DeltaVisitMode::FULL,
+            thrift_cow::DeltaVisitOrder::CHILDREN_FIRST,
+            useIdPaths_),
+        [&](CowSubscriptionTraverseHelper& helper,
+            auto& /* oldNode */,
+            auto& /* newNode */,
+            thrift_cow::DeltaElemTag /* visitTag */) {
+          if (const auto* lookup = helper.currentStore()) {
+            served += lookup->subscriptions().size();
+          }
+        });
+    return served;
+  }
+
+ private:
+  const bool useIdPaths_;
+  std::shared_ptr<thrift_cow::FsdbCowStatsRoot> oldRoot_;
+  std::shared_ptr<thrift_cow::FsdbCowStatsRoot> newRoot_;
+  std::vector<std::vector<std::string>> paths_;
+  std::vector<std::unique_ptr<PathSubscription>> subscriptions_;
+  SubscriptionPathStoreTreeStats storeStats_;
+  SubscriptionPathStore store_;
+};
+
+void subscribeFineGrained(unsigned n, bool useIdPaths) {
+  folly::BenchmarkSuspender suspender;
+  for (unsigned i = 0; i < n; ++i) {
+    FineGrainedSubscriptions subscriptions(useIdPaths);
+    suspender.dismiss();
+    subscriptions.subscribe();
+    suspender.rehire();
+  }
+}
+
+void serveFineGrained(unsigned n, bool useIdPaths) {
+  folly::BenchmarkSuspender suspender;
+  FineGrainedSubscriptions subscriptions(useIdPaths);
+  subscriptions.subscribe();
+  suspender.dismiss();
+
+  for (unsigned i = 0; i < n; ++i) {
+    folly::doNotOptimizeAway(subscriptions.serve());
+  }
+}
+
+} // namespace
+
+BENCHMARK(SubscribeFineGrainedPaths, n) {
+  subscribeFineGrained(n, false /* useIdPaths */);
+}
+
+BENCHMARK_RELATIVE(SubscribeFineGrainedIdPaths, n) {
+  subscribeFineGrained(n, true /* useIdPaths */);
+}
+
+BENCHMARK(ServeFineGrainedPaths, n) {
+  serveFineGrained(n, false /* useIdPaths */);
+}
+
+BENCHMARK_RELATIVE(ServeFineGrainedIdPaths, n) {
+  serveFineGrained(n, true /* useIdPaths */);
+}
+
+} // namespace facebook::fboss::fsdb::test
@@ -55,4 +55,46 @@ BENCHMARK(FsdbPublishVoqStats) {
   helper.TearDown();
 }
 
+BENCHMARK(FsdbPublishVoqStatsPatch) {
+  auto n_iterations = FLAGS_n_publish_iters;
+
+  folly::BenchmarkSuspender suspender;
+
+  FsdbBenchmarkTestHelper helper;
+  helper.setup();
+
+  // start patch publisher and publish initial full stats
+  helper.startPublisher(true /* usePatch */);
+
+  auto stats = std::make_shared<AgentStats>();
+  StateGenerator::fillVoqStats(
+      stats.get(), FLAGS_n_sysports, FLAGS_n_voqs_per_sysport);
+
+  helper.waitForPublisherConnected();
+  helper.publishFullPatch(*stats, 0);
+
+  // benchmark test: publish N iterations of changed counters only. Keeping
+  // the previous stats around is the publisher's cost, so it is measured.
+  suspender.dismiss();
+
+  for (int round = 0; round < n_iterations; round++) {
+    auto prevStats = *stats;
+    StateGenerator::updateVoqStats(stats.get());
+    helper.publishPatch(prevStats, *stats, round + 1);
+  }
+
+  // wait for server to process all the updates
+  while (true) {
+    auto md = helper.getPublisherRootMetadata(true);
+    if (md && *md->operMetadata.get_lastConfirmedAt() == n_iterations) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  suspender.rehire();
+
+  helper.TearDown();
+}
+
 } // namespace facebook::fboss::fsdb::test
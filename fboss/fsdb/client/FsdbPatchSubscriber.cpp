@@ -1,12 +1,30 @@
 // (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
 
 #include "fboss/fsdb/client/FsdbPatchSubscriber.h"
+#include "fboss/fsdb/common/Flags.h"
 #include "fboss/fsdb/if/gen-cpp2/FsdbService.h"
+#include "fboss/thrift_cow/visitors/PatchHelpers.h"
 
 #include <folly/logging/xlog.h>
 
+#include <mutex>
+
 namespace facebook::fboss::fsdb {
 
+namespace {
+// Compressed patches reference dictionaries by id, which we need to have
+// loaded to decompress them
+void loadPatchCompressionDictionaries() {
+  static std::once_flag loaded;
+  std::call_once(loaded, []() {
+    if (!FLAGS_fsdb_patch_compression_dictionary_dir.empty()) {
+      thrift_cow::loadPatchCompressionDictionaries(
+          FLAGS_fsdb_patch_compression_dictionary_dir);
+    }
+  });
+}
+} // namespace
+
 template <typename MessageType, typename SubUnit, typename PathElement>
 SubRequest
 FsdbPatchSubscriberImpl<MessageType, SubUnit, PathElement>::createRequest()
@@ -16,6 +34,14 @@ FsdbPatchSubscriberImpl<MessageType, SubUnit, PathElement>::createRequest()
   RawOperPath path;
   request.paths() = this->subscribePaths();
   request.forceSubscribe() = this->subscriptionOptions().forceSubscribe_;
+  request.patchCompression() = this->subscriptionOptions().patchCompression_;
+  if (*request.patchCompression() != thrift_cow::CompressionCodec::NONE) {
+    loadPatchCompressionDictionaries();
+    for (auto id : thrift_cow::getPatchCompressionDictionaryIds()) {
+      request.patchCompressionDictionaryIds()->push_back(
+          static_cast<int32_t>(id));
+    }
+  }
   return request;
 }
 
@@ -98,6 +98,9 @@ struct SubscriptionOptions {
   uint32_t grHoldTimeSec_{0};
   bool requireInitialSyncToMarkConnect_{false};
   bool forceSubscribe_{false};
+  // Only used by patch subscriptions
+  thrift_cow::CompressionCodec patchCompression_{
+      thrift_cow::CompressionCodec::NONE};
 };
 
 struct SubscriptionInfo {
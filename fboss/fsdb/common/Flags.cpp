@@ -28,3 +28,9 @@ DEFINE_bool(
     subscribe_to_state_from_fsdb,
     false,
     "Whether to subscribe to state from fsdb");
+DEFINE_string(
+    fsdb_patch_compression_dictionary_dir,
+    "",
+    "Directory of trained zstd dictionaries (<publisher root>_<state|stats>"
+    ".zdict) used for compressed patch subscriptions, as written by fsdb "
+    "test_client train_patch_dictionary");
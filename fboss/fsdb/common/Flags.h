@@ -11,3 +11,4 @@ DECLARE_bool(publish_stats_to_fsdb);
 DECLARE_bool(publish_state_to_fsdb);
 DECLARE_bool(subscribe_to_stats_from_fsdb);
 DECLARE_bool(subscribe_to_state_from_fsdb);
+DECLARE_string(fsdb_patch_compression_dictionary_dir);
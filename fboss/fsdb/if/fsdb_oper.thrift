@@ -136,6 +136,12 @@ struct SubRequest {
   3: fsdb_common.ClientId clientId;
   // Forcefully subscribe even if there is already a subscriber with the same SubscriberId
   4: bool forceSubscribe = false;
+  // Compression to apply to served patches. With ZSTD, server uses the
+  // trained dictionary for the publisher root if the subscriber has it too.
+  5: patch.CompressionCodec patchCompression = patch.CompressionCodec.NONE;
+  // Ids of the zstd dictionaries loaded by the subscriber. Server falls back
+  // to plain zstd if its dictionary for the root is not in this list.
+  6: list<i32> patchCompressionDictionaryIds;
 }
 
 struct Patch {
@@ -20,6 +20,7 @@ struct CowDeletePathTraverseHelper
     : thrift_cow::TraverseHelper<CowDeletePathTraverseHelper> {
   using Base = thrift_cow::TraverseHelper<CowDeletePathTraverseHelper>;
 
+  using Base::lastToken;
   using Base::path;
   using Base::shouldShortCircuit;
 
@@ -32,14 +33,11 @@ struct CowDeletePathTraverseHelper
   }
 
   void onPushImpl(thrift_cow::ThriftTCType /* tc */) {
-    const auto& currPath = path();
-    auto lastTok = currPath.back();
-
     auto* lastPathStore = pathStores_.back();
     // Even if PathStore is not added for currPath (or its parent), traversal
     // will continue. So ensure that sizeof(pathStores_) == pathlen.
     if (lastPathStore) {
-      auto* child = lastPathStore->child(lastTok);
+      auto* child = lastPathStore->child(lastToken());
       if (child) {
         pathStores_.emplace_back(child);
         return;
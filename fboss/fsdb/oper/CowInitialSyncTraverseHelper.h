@@ -11,6 +11,7 @@ struct CowInitialSyncTraverseHelper
     : thrift_cow::TraverseHelper<CowInitialSyncTraverseHelper> {
   using Base = thrift_cow::TraverseHelper<CowInitialSyncTraverseHelper>;
 
+  using Base::lastToken;
   using Base::path;
   using Base::shouldShortCircuit;
 
@@ -23,10 +24,9 @@ struct CowInitialSyncTraverseHelper
   }
 
   void onPushImpl(thrift_cow::ThriftTCType tc) {
-    const auto& newTok = path().back();
     const auto* lookup = elementsAlongPath_.back();
     CHECK(lookup);
-    auto* child = lookup->child(newTok);
+    auto* child = lookup->child(lastToken());
     elementsAlongPath_.push_back(child);
   }
 
@@ -25,7 +25,7 @@ void CowPublishAndAddTraverseHelper::onPushImpl(
   SubscriptionPathStore* child{nullptr};
   if (lastPathStore) {
     if (FLAGS_lazyPathStoreCreation) {
-      child = lastPathStore->child(newTok);
+      child = lastPathStore->child(lastToken());
     } else {
       child =
           lastPathStore->getOrCreateChild(newTok, store_->getPathStoreStats());
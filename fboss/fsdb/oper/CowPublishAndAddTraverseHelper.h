@@ -20,6 +20,7 @@ struct CowPublishAndAddTraverseHelper
     : thrift_cow::TraverseHelper<CowPublishAndAddTraverseHelper> {
   using Base = thrift_cow::TraverseHelper<CowPublishAndAddTraverseHelper>;
 
+  using Base::lastToken;
   using Base::path;
   using Base::shouldShortCircuit;
 
@@ -331,9 +331,8 @@ class CowSubscriptionManager
         if (currStore && (currStore->numSubsRecursive() == 0)) {
           auto parentStore = traverser.parentStore();
           if (parentStore) {
-            auto path = traverser.path();
-            auto lastTok = path.back();
-            parentStore->removeChild(lastTok, store.getPathStoreStats());
+            parentStore->removeChild(
+                traverser.lastToken(), store.getPathStoreStats());
           }
         }
       }
@@ -394,6 +393,7 @@ class CowSubscriptionManager
 
       if (lookup) {
         const auto& exactSubscriptions = lookup->subscriptions();
+        std::optional<PatchCompressionCache> patchCache;
         for (auto& relevant : exactSubscriptions) {
           if (relevant->type() == PubSubType::PATH) {
             auto* pathSubscription =
@@ -416,7 +416,11 @@ class CowSubscriptionManager
               traverser.patchBuilder()) {
             // patches only supported when using id paths
             auto* patchSubscription = static_cast<PatchSubscription*>(relevant);
-            patchSubscription->offer(traverser.patchBuilder()->curPatch());
+            if (!patchCache) {
+              patchCache.emplace(traverser.patchBuilder()->curPatch());
+            }
+            patchSubscription->offer(
+                patchCache->get(patchSubscription->patchCompression()));
           }
         }
       }
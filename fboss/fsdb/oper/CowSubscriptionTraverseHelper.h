@@ -30,6 +30,7 @@ struct CowSubscriptionTraverseHelper
     : thrift_cow::TraverseHelper<CowSubscriptionTraverseHelper> {
   using Base = thrift_cow::TraverseHelper<CowSubscriptionTraverseHelper>;
 
+  using Base::lastToken;
   using Base::path;
   using Base::shouldShortCircuit;
 
@@ -63,7 +64,8 @@ struct CowSubscriptionTraverseHelper
   void onPushImpl(thrift_cow::ThriftTCType tc) {
     const auto& newTok = path().back();
     const auto& lastElem = elementsAlongPath_.back();
-    auto* child = (lastElem.lookup) ? lastElem.lookup->child(newTok) : nullptr;
+    auto* child =
+        (lastElem.lookup) ? lastElem.lookup->child(lastToken()) : nullptr;
     bool hasAncestorSubs =
         lastElem.hasAncestorSubs || (child && child->numSubs());
     elementsAlongPath_.emplace_back(child, hasAncestorSubs);
@@ -361,7 +361,8 @@ NaivePeriodicSubscribableStorageBase::subscribe_delta_extended_impl(
 folly::coro::AsyncGenerator<SubscriberMessage&&>
 NaivePeriodicSubscribableStorageBase::subscribe_patch_impl(
     SubscriberId subscriber,
-    std::map<SubscriptionKey, RawOperPath> rawPaths) {
+    std::map<SubscriptionKey, RawOperPath> rawPaths,
+    thrift_cow::PatchCompressionOptions patchCompression) {
   for (auto& [key, path] : rawPaths) {
     auto convertedPath = convertPath(std::move(*path.path()));
     path.path() = std::move(convertedPath);
@@ -373,7 +374,8 @@ NaivePeriodicSubscribableStorageBase::subscribe_patch_impl(
       patchOperProtocol_,
       std::move(root),
       heartbeatThread_ ? heartbeatThread_->getEventBase() : nullptr,
-      params_.subscriptionHeartbeatInterval_);
+      params_.subscriptionHeartbeatInterval_,
+      std::move(patchCompression));
   subMgr().registerExtendedSubscription(std::move(subscription));
   return std::move(gen);
 }
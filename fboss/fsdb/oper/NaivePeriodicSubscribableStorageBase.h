@@ -134,7 +134,8 @@ class NaivePeriodicSubscribableStorageBase {
 
   folly::coro::AsyncGenerator<SubscriberMessage&&> subscribe_patch_impl(
       SubscriberId subscriber,
-      std::map<SubscriptionKey, RawOperPath> rawPaths);
+      std::map<SubscriptionKey, RawOperPath> rawPaths,
+      thrift_cow::PatchCompressionOptions patchCompression = {});
 
   folly::coro::AsyncGenerator<SubscriberMessage&&>
   subscribe_patch_extended_impl(
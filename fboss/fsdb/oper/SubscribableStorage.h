@@ -14,6 +14,7 @@
 #include <chrono>
 #include "fboss/fsdb/if/gen-cpp2/fsdb_common_types.h"
 #include "fboss/fsdb/if/gen-cpp2/fsdb_oper_types.h"
+#include "fboss/thrift_cow/visitors/PatchHelpers.h"
 
 namespace facebook::fboss::fsdb {
 
@@ -162,9 +163,12 @@ class SubscribableStorage {
   }
   folly::coro::AsyncGenerator<SubscriberMessage&&> subscribe_patch(
       SubscriberId subscriber,
-      std::map<SubscriptionKey, RawOperPath> rawPaths) {
+      std::map<SubscriptionKey, RawOperPath> rawPaths,
+      thrift_cow::PatchCompressionOptions patchCompression = {}) {
     return static_cast<Impl*>(this)->subscribe_patch_impl(
-        std::move(subscriber), std::move(rawPaths));
+        std::move(subscriber),
+        std::move(rawPaths),
+        std::move(patchCompression));
   }
   folly::coro::AsyncGenerator<SubscriberMessage&&> subscribe_patch_extended(
       SubscriberId subscriber,
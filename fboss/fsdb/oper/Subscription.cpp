@@ -3,6 +3,7 @@
 #include "fboss/fsdb/oper/Subscription.h"
 
 #include <boost/core/noncopyable.hpp>
+#include <fb303/ThreadCachedServiceData.h>
 #include <folly/coro/BlockingWait.h>
 #include <folly/coro/Sleep.h>
 #include <optional>
@@ -408,6 +409,11 @@ void PatchSubscription::offer(thrift_cow::PatchNode node) {
   subscription_.buffer(key_, std::move(patch));
 }
 
+const thrift_cow::PatchCompressionOptions&
+PatchSubscription::patchCompression() const {
+  return subscription_.patchCompression();
+}
+
 bool PatchSubscription::isActive() const {
   return subscription_.isActive();
 }
@@ -421,7 +427,8 @@ ExtendedPatchSubscription::create(
     OperProtocol protocol,
     std::optional<std::string> publisherRoot,
     folly::EventBase* heartbeatEvb,
-    std::chrono::milliseconds heartbeatInterval) {
+    std::chrono::milliseconds heartbeatInterval,
+    thrift_cow::PatchCompressionOptions patchCompression) {
   RawOperPath p;
   p.path() = std::move(path);
   return create(
@@ -430,7 +437,8 @@ ExtendedPatchSubscription::create(
       std::move(protocol),
       std::move(publisherRoot),
       std::move(heartbeatEvb),
-      std::move(heartbeatInterval));
+      std::move(heartbeatInterval),
+      std::move(patchCompression));
 }
 
 std::pair<
@@ -442,7 +450,8 @@ ExtendedPatchSubscription::create(
     OperProtocol protocol,
     std::optional<std::string> publisherRoot,
     folly::EventBase* heartbeatEvb,
-    std::chrono::milliseconds heartbeatInterval) {
+    std::chrono::milliseconds heartbeatInterval,
+    thrift_cow::PatchCompressionOptions patchCompression) {
   std::map<SubscriptionKey, ExtendedOperPath> extendedPaths;
   for (auto& [key, path] : paths) {
     std::vector<OperPathElem> extendedPath;
@@ -458,7 +467,8 @@ ExtendedPatchSubscription::create(
       std::move(protocol),
       std::move(publisherRoot),
       std::move(heartbeatEvb),
-      std::move(heartbeatInterval));
+      std::move(heartbeatInterval),
+      std::move(patchCompression));
 }
 
 std::pair<
@@ -470,7 +480,8 @@ ExtendedPatchSubscription::create(
     OperProtocol protocol,
     std::optional<std::string> publisherRoot,
     folly::EventBase* heartbeatEvb,
-    std::chrono::milliseconds heartbeatInterval) {
+    std::chrono::milliseconds heartbeatInterval,
+    thrift_cow::PatchCompressionOptions patchCompression) {
   auto [generator, pipe] = folly::coro::AsyncPipe<gen_type>::create();
   auto subscription = std::make_unique<ExtendedPatchSubscription>(
       std::move(subscriber),
@@ -479,7 +490,8 @@ ExtendedPatchSubscription::create(
       std::move(protocol),
       std::move(publisherRoot),
       std::move(heartbeatEvb),
-      std::move(heartbeatInterval));
+      std::move(heartbeatInterval),
+      std::move(patchCompression));
   return std::make_pair(std::move(generator), std::move(subscription));
 }
 
@@ -512,6 +524,36 @@ std::optional<SubscriberChunk> ExtendedPatchSubscription::moveCurChunk(
   return chunk;
 }
 
+thrift_cow::PatchNode PatchCompressionCache::get(
+    const thrift_cow::PatchCompressionOptions& options) {
+  if (options.codec == thrift_cow::CompressionCodec::NONE) {
+    return patch_;
+  }
+  auto it = compressed_.find(options.dictionary.get());
+  if (it == compressed_.end()) {
+    auto node = patch_;
+    auto start = std::chrono::steady_clock::now();
+    auto result = thrift_cow::compressPatch(node, options);
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    if (result) {
+      auto stats = fb303::ThreadCachedServiceData::get();
+      stats->addStatValue(
+          "fsdb.patch_compression.serialized_bytes",
+          result->serializedBytes,
+          fb303::SUM);
+      stats->addStatValue(
+          "fsdb.patch_compression.compressed_bytes",
+          result->compressedBytes,
+          fb303::SUM);
+      stats->addStatValue(
+          "fsdb.patch_compression.compress_us", elapsed.count(), fb303::SUM);
+    }
+    it = compressed_.emplace(options.dictionary.get(), std::move(node)).first;
+  }
+  return it->second;
+}
+
 void ExtendedPatchSubscription::flush(
     const SubscriptionMetadataServer& metadataServer) {
   if (auto chunk = moveCurChunk(metadataServer)) {
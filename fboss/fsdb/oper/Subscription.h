@@ -9,6 +9,8 @@
 #include "fboss/fsdb/oper/DeltaValue.h"
 #include "fboss/fsdb/oper/SubscriptionMetadataServer.h"
 #include "fboss/thrift_cow/gen-cpp2/patch_types.h"
+#include "fboss/thrift_cow/visitors/PatchHelpers.h"
+#include "fboss/thrift_cow/visitors/PathToken.h"
 
 #include <boost/core/noncopyable.hpp>
 #include <folly/coro/AsyncPipe.h>
@@ -100,6 +102,11 @@ class Subscription : public BaseSubscription {
     return path_;
   }
 
+  // path(), tokenized once at subscription time for path store lookups
+  const std::vector<thrift_cow::PathToken>& pathTokens() const {
+    return pathTokens_;
+  }
+
   bool needsFirstChunk() const {
     return needsFirstChunk_;
   }
@@ -126,10 +133,12 @@ class Subscription : public BaseSubscription {
             std::move(publisherRoot),
             heartbeatEvb,
             std::move(heartbeatInterval)),
-        path_(std::move(path)) {}
+        path_(std::move(path)),
+        pathTokens_(thrift_cow::PathToken::intern(path_)) {}
 
  private:
   const std::vector<std::string> path_;
+  const std::vector<thrift_cow::PathToken> pathTokens_;
   bool needsFirstChunk_{true};
 };
 
@@ -582,6 +591,8 @@ class PatchSubscription : public Subscription, private boost::noncopyable {
 
   void offer(thrift_cow::PatchNode node);
 
+  const thrift_cow::PatchCompressionOptions& patchCompression() const;
+
   void serveHeartbeat() override;
 
   void sendEmptyInitialChunk() override;
@@ -619,7 +630,8 @@ class ExtendedPatchSubscription : public ExtendedSubscription,
       OperProtocol protocol,
       std::optional<std::string> publisherRoot,
       folly::EventBase* heartbeatEvb,
-      std::chrono::milliseconds heartbeatInterval);
+      std::chrono::milliseconds heartbeatInterval,
+      thrift_cow::PatchCompressionOptions patchCompression = {});
 
   // Multipath
   static std::pair<
@@ -631,7 +643,8 @@ class ExtendedPatchSubscription : public ExtendedSubscription,
       OperProtocol protocol,
       std::optional<std::string> publisherRoot,
       folly::EventBase* heartbeatEvb,
-      std::chrono::milliseconds heartbeatInterval);
+      std::chrono::milliseconds heartbeatInterval,
+      thrift_cow::PatchCompressionOptions patchCompression = {});
 
   // Extended paths
   static std::pair<
@@ -643,7 +656,8 @@ class ExtendedPatchSubscription : public ExtendedSubscription,
       OperProtocol protocol,
       std::optional<std::string> publisherRoot,
       folly::EventBase* heartbeatEvb,
-      std::chrono::milliseconds heartbeatInterval);
+      std::chrono::milliseconds heartbeatInterval,
+      thrift_cow::PatchCompressionOptions patchCompression = {});
 
   ExtendedPatchSubscription(
       SubscriberId subscriber,
@@ -652,7 +666,8 @@ class ExtendedPatchSubscription : public ExtendedSubscription,
       OperProtocol protocol,
       std::optional<std::string> publisherTreeRoot,
       folly::EventBase* heartbeatEvb,
-      std::chrono::milliseconds heartbeatInterval)
+      std::chrono::milliseconds heartbeatInterval,
+      thrift_cow::PatchCompressionOptions patchCompression = {})
       : ExtendedSubscription(
             std::move(subscriber),
             std::move(paths),
@@ -660,7 +675,8 @@ class ExtendedPatchSubscription : public ExtendedSubscription,
             std::move(publisherTreeRoot),
             std::move(heartbeatEvb),
             std::move(heartbeatInterval)),
-        pipe_(std::move(pipe)) {}
+        pipe_(std::move(pipe)),
+        patchCompression_(std::move(patchCompression)) {}
 
   PubSubType type() const override {
     return PubSubType::PATCH;
@@ -672,6 +688,10 @@ class ExtendedPatchSubscription : public ExtendedSubscription,
 
   void buffer(const SubscriptionKey& key, Patch&& newVal);
 
+  const thrift_cow::PatchCompressionOptions& patchCompression() const {
+    return patchCompression_;
+  }
+
   void flush(const SubscriptionMetadataServer& metadataServer) override;
 
   void serveHeartbeat() override;
@@ -687,6 +707,26 @@ class ExtendedPatchSubscription : public ExtendedSubscription,
 
   std::map<SubscriptionKey, std::vector<Patch>> buffered_;
   folly::coro::AsyncPipe<gen_type> pipe_;
+  const thrift_cow::PatchCompressionOptions patchCompression_;
+};
+
+/*
+ * Compresses the patch served at a path once per compression setting
+ * instead of once per subscriber, and exports the cost of doing so.
+ */
+class PatchCompressionCache {
+ public:
+  explicit PatchCompressionCache(const thrift_cow::PatchNode& patch)
+      : patch_(patch) {}
+
+  thrift_cow::PatchNode get(
+      const thrift_cow::PatchCompressionOptions& options);
+
+ private:
+  const thrift_cow::PatchNode& patch_;
+  // keyed by dictionary, null for plain zstd
+  std::map<const thrift_cow::PatchCompressionDictionary*, thrift_cow::PatchNode>
+      compressed_;
 };
 
 } // namespace facebook::fboss::fsdb
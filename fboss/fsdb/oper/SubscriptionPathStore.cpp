@@ -5,6 +5,23 @@
 
 namespace facebook::fboss::fsdb {
 
+using thrift_cow::PathToken;
+
+namespace {
+
+std::vector<PathToken> findTokens(
+    SubscriptionPathStore::PathIter begin,
+    SubscriptionPathStore::PathIter end) {
+  std::vector<PathToken> tokens;
+  tokens.reserve(std::distance(begin, end));
+  for (auto it = begin; it != end; ++it) {
+    tokens.push_back(PathToken::find(*it));
+  }
+  return tokens;
+}
+
+} // namespace
+
 DEFINE_bool(lazyPathStoreCreation, true, "Lazy path store creation");
 
 SubscriptionPathStore::SubscriptionPathStore(
@@ -24,13 +41,13 @@ void SubscriptionPathStore::freePathStore(
 void SubscriptionPathStore::add(
     Subscription* subscription,
     SubscriptionPathStoreTreeStats* stats) {
-  auto path = subscription->path();
-  add(stats, path.begin(), path.end(), subscription);
+  const auto& tokens = subscription->pathTokens();
+  add(stats, tokens.begin(), tokens.end(), subscription);
 }
 
 void SubscriptionPathStore::remove(Subscription* subscription) {
-  auto path = subscription->path();
-  remove(path.begin(), path.end(), subscription);
+  const auto& tokens = subscription->pathTokens();
+  remove(tokens.begin(), tokens.end(), subscription);
 }
 
 void SubscriptionPathStore::incrementallyResolve(
@@ -67,13 +84,10 @@ void SubscriptionPathStore::incrementallyResolve(
   }
 
   const auto& key = path.at(idx).raw_ref().value();
-  if (auto it = children_.find(key); it == children_.end()) {
-    children_.emplace(
-        key,
-        std::make_shared<SubscriptionPathStore>(store.getPathStoreStats()));
-  }
+  auto* childStore =
+      getOrCreateChild(PathToken::intern(key), store.getPathStoreStats());
   pathSoFar.emplace_back(key);
-  children_.at(key)->incrementallyResolve(
+  childStore->incrementallyResolve(
       store, std::move(subscription), subKey, pathSoFar);
   pathSoFar.pop_back();
 }
@@ -90,19 +104,13 @@ void SubscriptionPathStore::processAddedPath(
     return;
   }
 
-  auto key = *curr++;
+  const auto& key = *curr++;
 
   // if child PathStore is not already created, don't create one unless
   // there are any partially resolved subscriptions that match this key
-  bool childStorePresent{true};
-  if (auto it = children_.find(key); it == children_.end()) {
-    if (!FLAGS_lazyPathStoreCreation) {
-      children_.emplace(
-          key,
-          std::make_shared<SubscriptionPathStore>(store.getPathStoreStats()));
-    } else {
-      childStorePresent = false;
-    }
+  auto* childStore = child(key);
+  if (!childStore && !FLAGS_lazyPathStoreCreation) {
+    childStore = getOrCreateChild(key, store.getPathStoreStats());
   }
 
   auto it = partiallyResolvedSubs_.begin();
@@ -137,13 +145,10 @@ void SubscriptionPathStore::processAddedPath(
       // we match this wildcard, incrementally resolve the
       // partial subscription to next wilcard or the end.
       std::vector<std::string> pathSoFar(begin, curr);
-      if (!childStorePresent) {
-        children_.emplace(
-            key,
-            std::make_shared<SubscriptionPathStore>(store.getPathStoreStats()));
-        childStorePresent = true;
+      if (!childStore) {
+        childStore = getOrCreateChild(key, store.getPathStoreStats());
       }
-      children_.at(key)->incrementallyResolve(
+      childStore->incrementallyResolve(
           store, std::move(subscription), partial.subKey, pathSoFar);
     }
 
@@ -153,8 +158,8 @@ void SubscriptionPathStore::processAddedPath(
   // if child PathStore is not created, that means there is no subscription
   // to resolve under this key. So process further only if child PathStore
   // is present.
-  if (childStorePresent) {
-    children_.at(key)->processAddedPath(store, begin, curr, end);
+  if (childStore) {
+    childStore->processAddedPath(store, begin, curr, end);
   }
 }
 
@@ -162,12 +167,26 @@ std::vector<Subscription*> SubscriptionPathStore::find(
     PathIter begin,
     PathIter end,
     std::unordered_set<LookupType> lookupTypes) {
-  if (lookupTypes.empty()) {
-    return {};
-  }
+  auto tokens = findTokens(begin, end);
+  return find(tokens.cbegin(), tokens.cend(), lookupTypes);
+}
 
+std::vector<Subscription*> SubscriptionPathStore::find(
+    TokenIter begin,
+    TokenIter end,
+    const std::unordered_set<LookupType>& lookupTypes) {
   std::vector<Subscription*> gathered;
+  if (!lookupTypes.empty()) {
+    find(begin, end, lookupTypes, gathered);
+  }
+  return gathered;
+}
 
+void SubscriptionPathStore::find(
+    TokenIter begin,
+    TokenIter end,
+    const std::unordered_set<LookupType>& lookupTypes,
+    std::vector<Subscription*>& gathered) {
   if (begin == end) {
     if (lookupTypes.count(LookupType::TARGET)) {
       std::copy(
@@ -189,19 +208,21 @@ std::vector<Subscription*> SubscriptionPathStore::find(
           std::back_inserter(gathered));
     }
 
-    auto key = *begin++;
-    if (auto it = children_.find(key); it != children_.end()) {
-      auto toAppend = it->second->find(begin, end, std::move(lookupTypes));
-      std::copy(toAppend.begin(), toAppend.end(), std::back_inserter(gathered));
+    const auto& token = *begin++;
+    if (auto it = children_.find(token); it != children_.end()) {
+      it->second->find(begin, end, lookupTypes, gathered);
     }
   }
-
-  return gathered;
 }
 
 SubscriptionPathStore* FOLLY_NULLABLE
 SubscriptionPathStore::child(const std::string& key) const {
-  if (auto it = children_.find(key); it != children_.end()) {
+  return child(PathToken::find(key));
+}
+
+SubscriptionPathStore* FOLLY_NULLABLE
+SubscriptionPathStore::child(const PathToken& token) const {
+  if (auto it = children_.find(token); it != children_.end()) {
     return it->second.get();
   } else {
     return nullptr;
@@ -211,25 +232,37 @@ SubscriptionPathStore::child(const std::string& key) const {
 SubscriptionPathStore* SubscriptionPathStore::getOrCreateChild(
     const std::string& key,
     SubscriptionPathStoreTreeStats* stats) {
-  if (auto it2 = children_.find(key); it2 != children_.end()) {
+  return getOrCreateChild(PathToken::intern(key), stats);
+}
+
+SubscriptionPathStore* SubscriptionPathStore::getOrCreateChild(
+    const PathToken& token,
+    SubscriptionPathStoreTreeStats* stats) {
+  DCHECK(token.isResolved());
+  if (auto it2 = children_.find(token); it2 != children_.end()) {
     return it2->second.get();
   }
   auto [it, added] =
-      children_.emplace(key, std::make_shared<SubscriptionPathStore>(stats));
+      children_.emplace(token, std::make_shared<SubscriptionPathStore>(stats));
   return it->second.get();
 }
 
 void SubscriptionPathStore::removeChild(
     const std::string& key,
     SubscriptionPathStoreTreeStats* stats) {
-  if (auto it = children_.find(key); it == children_.end()) {
+  removeChild(PathToken::find(key), stats);
+}
+
+void SubscriptionPathStore::removeChild(
+    const PathToken& token,
+    SubscriptionPathStoreTreeStats* stats) {
+  auto it = children_.find(token);
+  if (it == children_.end()) {
     return;
   }
-  auto child = children_[key];
-  CHECK_EQ(children_[key]->numSubsRecursive(), 0);
-  child->freePathStore(stats);
-  children_.erase(key);
-  return;
+  CHECK_EQ(it->second->numSubsRecursive(), 0);
+  it->second->freePathStore(stats);
+  children_.erase(it);
 }
 
 void SubscriptionPathStore::gatherChildren(
@@ -246,8 +279,8 @@ void SubscriptionPathStore::gatherChildren(
 
 void SubscriptionPathStore::add(
     SubscriptionPathStoreTreeStats* stats,
-    PathIter begin,
-    PathIter end,
+    TokenIter begin,
+    TokenIter end,
     Subscription* subscription) {
   if (begin == end) {
     subscriptions_.push_back(subscription);
@@ -255,18 +288,14 @@ void SubscriptionPathStore::add(
     return;
   }
 
-  auto key = *begin++;
-  if (auto it = children_.find(key); it == children_.end()) {
-    children_.emplace(key, std::make_shared<SubscriptionPathStore>(stats));
-  }
-
-  children_[key]->add(stats, begin, end, subscription);
+  const auto& token = *begin++;
+  getOrCreateChild(token, stats)->add(stats, begin, end, subscription);
   incrementCounts(subscription, true);
 }
 
 bool SubscriptionPathStore::remove(
-    PathIter begin,
-    PathIter end,
+    TokenIter begin,
+    TokenIter end,
     Subscription* subscription) {
   if (begin == end) {
     auto it =
@@ -279,12 +308,12 @@ bool SubscriptionPathStore::remove(
     return false;
   }
 
-  auto key = *begin++;
-  if (auto it = children_.find(key); it == children_.end()) {
+  auto it = children_.find(*begin++);
+  if (it == children_.end()) {
     return false;
   }
 
-  if (children_[key]->remove(begin, end, subscription)) {
+  if (it->second->remove(begin, end, subscription)) {
     decrementCounts(subscription, true);
     return true;
   }
@@ -323,12 +352,17 @@ void SubscriptionPathStore::decrementCounts(
 
 const SubscriptionPathStore* FOLLY_NULLABLE
 SubscriptionPathStore::findStore(PathIter begin, PathIter end) const {
+  auto tokens = findTokens(begin, end);
+  return findStore(tokens.cbegin(), tokens.cend());
+}
+
+const SubscriptionPathStore* FOLLY_NULLABLE
+SubscriptionPathStore::findStore(TokenIter begin, TokenIter end) const {
   if (begin == end) {
     return this;
   }
 
-  auto key = *begin++;
-  if (auto it = children_.find(key); it != children_.end()) {
+  if (auto it = children_.find(*begin++); it != children_.end()) {
     return it->second->findStore(begin, end);
   }
 
@@ -351,7 +385,7 @@ void SubscriptionPathStore::debugPrint(
   if (!children_.empty()) {
     std::vector<std::string> children;
     for (const auto& [child, _] : children_) {
-      children.emplace_back(child);
+      children.emplace_back(child.str());
     }
     XLOG(INFO) << "Children: " << folly::join(',', children);
   }
@@ -362,7 +396,7 @@ void SubscriptionPathStore::debugPrint(
     }
   }
   for (const auto& [child, childStore] : children_) {
-    pathSoFar.emplace_back(child);
+    pathSoFar.emplace_back(child.str());
     childStore->debugPrint(pathSoFar);
     pathSoFar.pop_back();
   }
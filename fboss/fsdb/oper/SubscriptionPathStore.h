@@ -3,6 +3,7 @@
 #pragma once
 
 #include "fboss/fsdb/oper/Subscription.h"
+#include "fboss/thrift_cow/visitors/PathToken.h"
 
 #include <folly/CppAttributes.h>
 #include <folly/FBString.h>
@@ -39,6 +40,7 @@ struct SubscriptionPathStoreTreeStats {
 class SubscriptionPathStore {
  public:
   using PathIter = std::vector<std::string>::const_iterator;
+  using TokenIter = std::vector<thrift_cow::PathToken>::const_iterator;
 
   explicit SubscriptionPathStore(SubscriptionPathStoreTreeStats* stats);
 
@@ -63,16 +65,32 @@ class SubscriptionPathStore {
       PathIter end,
       std::unordered_set<LookupType> lookupTypes);
 
+  std::vector<Subscription*> find(
+      TokenIter begin,
+      TokenIter end,
+      const std::unordered_set<LookupType>& lookupTypes);
+
   SubscriptionPathStore* FOLLY_NULLABLE child(const std::string& key) const;
 
+  SubscriptionPathStore* FOLLY_NULLABLE
+  child(const thrift_cow::PathToken& token) const;
+
   SubscriptionPathStore* getOrCreateChild(
       const std::string& key,
       SubscriptionPathStoreTreeStats* stats);
 
+  SubscriptionPathStore* getOrCreateChild(
+      const thrift_cow::PathToken& token,
+      SubscriptionPathStoreTreeStats* stats);
+
   void removeChild(
       const std::string& key,
       SubscriptionPathStoreTreeStats* stats);
 
+  void removeChild(
+      const thrift_cow::PathToken& token,
+      SubscriptionPathStoreTreeStats* stats);
+
   void clear(SubscriptionPathStoreTreeStats* stats);
 
   void debugPrint() const;
@@ -97,6 +115,9 @@ class SubscriptionPathStore {
   const SubscriptionPathStore* FOLLY_NULLABLE
   findStore(PathIter begin, PathIter end) const;
 
+  const SubscriptionPathStore* FOLLY_NULLABLE
+  findStore(TokenIter begin, TokenIter end) const;
+
   const std::vector<Subscription*>& subscriptions() const {
     return subscriptions_;
   }
@@ -112,19 +133,29 @@ class SubscriptionPathStore {
 
   void gatherChildren(std::vector<Subscription*>& gathered);
 
+  void find(
+      TokenIter begin,
+      TokenIter end,
+      const std::unordered_set<LookupType>& lookupTypes,
+      std::vector<Subscription*>& gathered);
+
   void add(
       SubscriptionPathStoreTreeStats* stats,
-      PathIter begin,
-      PathIter end,
+      TokenIter begin,
+      TokenIter end,
       Subscription* subscription);
 
   // returns true if a subscription was actually removed
-  bool remove(PathIter begin, PathIter end, Subscription* subscription);
+  bool remove(TokenIter begin, TokenIter end, Subscription* subscription);
 
   void incrementCounts(Subscription* subscription, bool isChild);
   void decrementCounts(Subscription* subscription, bool isChild);
 
-  folly::F14FastMap<folly::fbstring, std::shared_ptr<SubscriptionPathStore>>
+  // keyed by interned tokens, so lookups while traversing don't hash or
+  // compare strings
+  folly::F14FastMap<
+      thrift_cow::PathToken,
+      std::shared_ptr<SubscriptionPathStore>>
       children_;
   std::vector<Subscription*> subscriptions_;
   std::vector<PartiallyResolvedExtendedSubscription> partiallyResolvedSubs_;
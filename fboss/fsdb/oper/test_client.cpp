@@ -2,6 +2,7 @@
 
 #include <iostream>
 
+#include <folly/Conv.h>
 #include <folly/FileUtil.h>
 #include <folly/String.h>
 #include <folly/coro/BlockingWait.h>
@@ -11,6 +12,7 @@
 #include "fboss/fsdb/if/gen-cpp2/FsdbService.h"
 #include "fboss/fsdb/if/gen-cpp2/fsdb_common_constants.h"
 #include "fboss/fsdb/if/gen-cpp2/fsdb_common_types.h"
+#include "fboss/thrift_cow/visitors/PatchHelpers.h"
 #include "servicerouter/client/cpp2/ServiceRouter.h"
 
 using namespace facebook::fboss::fsdb;
@@ -121,6 +123,53 @@ folly::coro::Task<void> subscribeDeltaExtended(
   co_return;
 }
 
+/*
+ * Collect numSamples patches served for rawPath and train a zstd dictionary
+ * on them. The output should be named <publisher root>_<state|stats>.zdict,
+ * e.g. agent_stats.zdict, and installed in
+ * --fsdb_patch_compression_dictionary_dir of both fsdb and its subscribers.
+ */
+folly::coro::Task<void> trainPatchDictionary(
+    std::vector<std::string> rawPath,
+    std::string outputFile,
+    size_t numSamples,
+    bool isStats) {
+  auto client = fsdbClient();
+  SubRequest req;
+  (*req.paths())[0].path() = rawPath;
+  req.clientId()->client() = FsdbClient::ADHOC;
+  req.clientId()->instanceId() = "patch_dictionary_trainer";
+
+  auto result = co_await (
+      isStats ? client->co_subscribeStats(req)
+              : client->co_subscribeState(req));
+  auto gen = std::move(result.stream).toAsyncGenerator();
+  std::vector<facebook::fboss::thrift_cow::PatchNode> samples;
+  while (samples.size() < numSamples) {
+    auto message = co_await gen.next();
+    if (!message) {
+      break;
+    }
+    if (message->getType() != SubscriberMessage::Type::chunk) {
+      continue;
+    }
+    for (auto& [_, patches] : *message->chunk_ref()->patchGroups()) {
+      for (auto& patch : patches) {
+        samples.push_back(std::move(*patch.patch()));
+      }
+    }
+    std::cout << "Collected " << samples.size() << "/" << numSamples
+              << " patches" << std::endl;
+  }
+  auto dictionary =
+      facebook::fboss::thrift_cow::PatchCompressionDictionary::train(samples);
+  folly::writeFileAtomic(outputFile, dictionary->bytes());
+  std::cout << "Wrote dictionary id " << dictionary->id() << ", "
+            << dictionary->bytes().size() << " bytes to " << outputFile
+            << std::endl;
+  co_return;
+}
+
 ExtendedOperPath parseExtendedOperPath(
     const std::vector<std::string>& rawPath) {
   ExtendedOperPath extendedPath;
@@ -248,9 +297,22 @@ int main(int argc, char** argv) {
             (state.state()->contents()) ? *state.state()->contents() : "null";
         std::cout << "Contents=" << contents << std::endl << std::endl;
       }
+    } else if (function == "train_patch_dictionary") {
+      // train_patch_dictionary <path> <output.zdict> [num samples] [stats]
+      if (argc < 4) {
+        std::cout << "Incorrect usage. Expected at least 3 arguments, "
+                     "function, path and output file"
+                  << std::endl;
+        return 1;
+      }
+      size_t numSamples = argc > 4 ? folly::to<size_t>(argv[4]) : 1000;
+      bool isStats = argc > 5 && std::string(argv[5]) == "stats";
+      folly::coro::blockingWait(trainPatchDictionary(
+          std::move(rawPath), argv[3], numSamples, isStats));
     } else {
       std::cout << "Incorrect usage. Choose from 'get', 'get_extended', "
-                << "'subscribe', 'subscribe_delta' or 'set'" << std::endl;
+                << "'subscribe', 'subscribe_delta', 'set' or "
+                << "'train_patch_dictionary'" << std::endl;
       return 1;
     }
   } catch (const FsdbException& e) {
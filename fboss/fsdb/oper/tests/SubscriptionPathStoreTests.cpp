@@ -184,6 +184,49 @@ TEST(SubscriptionPathStoreTests, FindSimple) {
       ::testing::UnorderedElementsAre(subs[4].get(), subs[5].get()));
 }
 
+TEST(SubscriptionPathStoreTests, FindByTokens) {
+  using namespace facebook::fboss::fsdb;
+  using facebook::fboss::thrift_cow::PathToken;
+
+  std::array<std::unique_ptr<TestSubscription>, 3> subs = {
+      makeSubscription({"a", "1", "c"}),
+      makeSubscription({"a", "01", "c"}),
+      makeSubscription({"a", "-1", "c"})};
+
+  SubscriptionPathStoreTreeStats stats;
+  SubscriptionPathStore store(&stats);
+  for (const auto& sub : subs) {
+    store.add(sub.get(), &stats);
+  }
+
+  // integer tokens are matched by value, other tokens by name
+  std::vector<PathToken> tokens = {
+      PathToken::find("a"), PathToken(1), PathToken::find("c")};
+  EXPECT_THAT(
+      store.find(tokens.cbegin(), tokens.cend(), {LookupType::TARGET}),
+      ::testing::UnorderedElementsAre(subs[0].get()));
+  tokens[1] = PathToken(-1);
+  EXPECT_THAT(
+      store.find(tokens.cbegin(), tokens.cend(), {LookupType::TARGET}),
+      ::testing::UnorderedElementsAre(subs[2].get()));
+
+  std::vector<std::string> path = {"a", "01", "c"};
+  EXPECT_THAT(
+      store.find(path.begin(), path.end(), {LookupType::TARGET}),
+      ::testing::UnorderedElementsAre(subs[1].get()));
+  path = {"a", "neverSubscribed", "c"};
+  EXPECT_TRUE(
+      store.find(path.begin(), path.end(), {LookupType::TARGET}).empty());
+  EXPECT_EQ(store.child("a")->child(PathToken(1))->numSubs(), 0);
+  EXPECT_EQ(store.child("a")->child(PathToken(1))->numChildSubs(), 1);
+
+  store.remove(subs[0].get());
+  tokens[1] = PathToken(1);
+  EXPECT_TRUE(
+      store.find(tokens.cbegin(), tokens.cend(), {LookupType::TARGET})
+          .empty());
+}
+
 TEST(SubscriptionPathStoreTests, IncrementalResolveExtended) {
   using namespace facebook::fboss::fsdb;
 
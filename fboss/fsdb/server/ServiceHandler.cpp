@@ -10,6 +10,7 @@
 #include "fboss/fsdb/common/Flags.h"
 #include "fboss/fsdb/if/gen-cpp2/fsdb_common_constants.h"
 #include "fboss/fsdb/oper/PathValidator.h"
+#include "fboss/thrift_cow/visitors/PatchHelpers.h"
 #include "folly/CancellationToken.h"
 
 #include <algorithm>
@@ -155,6 +156,45 @@ Path buildPathUnion(facebook::fboss::fsdb::OperPublisherInfo info) {
   return pathUnion;
 }
 
+/*
+ * Compression to use for a patch subscription. Patches from one publisher
+ * root are compressed with the dictionary trained for it, e.g.
+ * agent_stats.zdict, if one was loaded here and by the subscriber. Otherwise
+ * fall back to plain zstd, which every subscriber can decompress.
+ */
+facebook::fboss::thrift_cow::PatchCompressionOptions getPatchCompression(
+    const SubRequest& request,
+    bool isStats) {
+  using facebook::fboss::thrift_cow::CompressionCodec;
+  facebook::fboss::thrift_cow::PatchCompressionOptions options;
+  options.codec = *request.patchCompression();
+  if (options.codec == CompressionCodec::NONE) {
+    return options;
+  }
+  // Only use a dictionary if all paths are under the same publisher root
+  std::optional<std::string> root;
+  for (const auto& [_, path] : *request.paths()) {
+    if (path.path()->empty() || (root && *root != path.path()->front())) {
+      return options;
+    }
+    root = path.path()->front();
+  }
+  if (root) {
+    auto name = fmt::format("{}_{}", *root, isStats ? "stats" : "state");
+    auto dictionary =
+        facebook::fboss::thrift_cow::getPatchCompressionDictionary(name);
+    const auto& subscriberIds = *request.patchCompressionDictionaryIds();
+    if (dictionary &&
+        std::find(
+            subscriberIds.begin(),
+            subscriberIds.end(),
+            static_cast<int32_t>(dictionary->id())) != subscriberIds.end()) {
+      options.dictionary = std::move(dictionary);
+    }
+  }
+  return options;
+}
+
 void updateMetadata(facebook::fboss::fsdb::OperMetadata& metadata) {
   // Timestamp at server if chunk was not timestamped
   // by publisher
@@ -267,6 +307,11 @@ ServiceHandler::ServiceHandler(
 
   initPerStreamCounters();
 
+  if (!FLAGS_fsdb_patch_compression_dictionary_dir.empty()) {
+    thrift_cow::loadPatchCompressionDictionaries(
+        FLAGS_fsdb_patch_compression_dictionary_dir);
+  }
+
   operStorage_.start();
   operStatsStorage_.start();
   tcData().setCounter(kWatchdogThreadHeartbeatMissed, 0);
@@ -1128,7 +1173,9 @@ ServiceHandler::co_subscribeState(std::unique_ptr<SubRequest> request) {
        cleanupSubscriber = std::move(cleanupSubscriber)]() mutable
       -> folly::coro::AsyncGenerator<SubscriberMessage&&> {
         return operStorage_.subscribe_patch(
-            *request->clientId()->instanceId(), *request->paths());
+            *request->clientId()->instanceId(),
+            *request->paths(),
+            getPatchCompression(*request, false /* isStats */));
       });
   co_return {{}, std::move(stream)};
 }
@@ -1151,7 +1198,9 @@ ServiceHandler::co_subscribeStats(std::unique_ptr<SubRequest> request) {
        cleanupSubscriber = std::move(cleanupSubscriber)]() mutable
       -> folly::coro::AsyncGenerator<SubscriberMessage&&> {
         return operStatsStorage_.subscribe_patch(
-            *request->clientId()->instanceId(), *request->paths());
+            *request->clientId()->instanceId(),
+            *request->paths(),
+            getPatchCompression(*request, true /* isStats */));
       });
   co_return {{}, std::move(stream)};
 }
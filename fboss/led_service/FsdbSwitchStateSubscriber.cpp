@@ -2,10 +2,11 @@
 
 #include "fboss/led_service/FsdbSwitchStateSubscriber.h"
 #include <folly/logging/xlog.h>
-#include <thrift/lib/cpp2/protocol/Serializer.h>
+#include "fboss/agent/gen-cpp2/switch_state_fatal_types.h"
 #include "fboss/fsdb/client/FsdbPubSubManager.h"
 #include "fboss/fsdb/if/gen-cpp2/fsdb_oper_types.h"
 #include "fboss/led_service/LedManager.h"
+#include "fboss/thrift_cow/nodes/ThriftLazyStructNode.h"
 
 namespace facebook::fboss {
 
@@ -47,12 +48,15 @@ void FsdbSwitchStateSubscriber::subscribeToState(
                     fsdb::SubscriptionState /*new*/) {};
   auto dataCb = [=](fsdb::OperState&& state) {
     if (auto contents = state.contents()) {
-      // Deserialize the FSDB update to switch state struct. This will be
-      // used by LED manager thread later
-      auto newSwitchStateData = apache::thrift::BinarySerializer::deserialize<
-          fboss::state::SwitchState>(*contents);
-      auto& swSettings = newSwitchStateData.switchSettingsMap().value();
-      auto swPortMaps = newSwitchStateData.portMaps().value();
+      // Deserialize the switch settings and ports from the FSDB update. This
+      // will be used by LED manager thread later. The rest of switch state,
+      // e.g. system ports on VOQ switches, can be large and is not decoded.
+      using k = state::switch_state_tags::strings;
+      thrift_cow::ThriftLazyStructNode<state::SwitchState> newSwitchStateData(
+          fsdb::OperProtocol::BINARY,
+          folly::IOBuf::wrapBufferAsValue(contents->data(), contents->size()));
+      auto swSettings = newSwitchStateData.getThrift<k::switchSettingsMap>();
+      auto swPortMaps = newSwitchStateData.getThrift<k::portMaps>();
 
       std::map<short, LedManager::LedSwitchStateUpdate> ledSwitchStateUpdate;
 
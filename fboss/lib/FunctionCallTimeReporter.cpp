@@ -39,6 +39,26 @@ namespace facebook::fboss {
 
 thread_local FunctionCallTimeReporter::CallTimeTracker
     FunctionCallTimeReporter::tracker_;
+thread_local FunctionCallTimeReporter::StageTracker
+    FunctionCallTimeReporter::stageTracker_;
+
+const char* callTimeStageName(CallTimeStage stage) {
+  switch (stage) {
+    case CallTimeStage::RIB:
+      return "rib";
+    case CallTimeStage::STATE_UPDATE:
+      return "state_update";
+    case CallTimeStage::DELTA:
+      return "delta";
+    case CallTimeStage::HW_SWITCH:
+      return "hw_switch";
+    case CallTimeStage::CALL:
+      return "call";
+    case CallTimeStage::NUM_STAGES:
+      break;
+  }
+  return "unknown";
+}
 
 FunctionCallTimeReporter::CallTimeTracker::~CallTimeTracker() {
   std::string threadIdStr;
@@ -56,20 +76,72 @@ FunctionCallTimeReporter::CallTimeTracker::~CallTimeTracker() {
              << " function time msecs: " << (cumalativeUsecs_.count() / 1000.0);
 }
 
+void FunctionCallTimeReporter::StageTracker::stageStart(
+    CallTimeStage stage,
+    uint64_t generation) {
+  if (generation != generation_) {
+    generation_ = generation;
+    depth_ = 0;
+  }
+  // Only calls made while programming count, not e.g. stats collection
+  if ((stage == CallTimeStage::CALL && depth_ == 0) || depth_ == kMaxDepth) {
+    return;
+  }
+  frames_[depth_++] = {stage, std::chrono::steady_clock::now()};
+}
+
+void FunctionCallTimeReporter::StageTracker::stageEnd(
+    CallTimeStage stage,
+    StageNsecs& stageNsecs) {
+  if (depth_ == 0 || frames_[depth_ - 1].stage != stage) {
+    // started before timing was turned on, or not tracked
+    return;
+  }
+  const auto& frame = frames_[--depth_];
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - frame.startTime);
+  stageNsecs[static_cast<size_t>(stage)] += (elapsed - frame.nested).count();
+  if (depth_ > 0) {
+    frames_[depth_ - 1].nested += elapsed;
+  }
+}
+
 void FunctionCallTimeReporter::start() {
   CHECK(!isOn_);
+  for (auto& stageNsecs : stageNsecs_) {
+    stageNsecs = 0;
+  }
+  ++generation_;
   isOn_ = true;
   startTime_ = std::chrono::steady_clock::now();
 }
 
 void FunctionCallTimeReporter::end() {
   CHECK(isOn_);
-  std::chrono::duration<double, std::micro> durationUsecs =
-      std::chrono::steady_clock::now() - startTime_;
+  auto durationUsecs = getElapsed();
   XLOG(INFO) << "Total time, msecs: " << (durationUsecs.count() / 1000.0);
+  auto stageTimes = getStageTimes();
+  for (size_t i = 0; i < stageTimes.size(); ++i) {
+    XLOG(INFO) << " Stage: " << callTimeStageName(static_cast<CallTimeStage>(i))
+               << " time msecs: " << (stageTimes[i].count() / 1000.0);
+  }
   isOn_ = false;
 }
 
+FunctionCallTimeReporter::StageTimes FunctionCallTimeReporter::getStageTimes()
+    const {
+  StageTimes stageTimes;
+  for (size_t i = 0; i < stageTimes.size(); ++i) {
+    stageTimes[i] = std::chrono::nanoseconds(stageNsecs_[i].load());
+  }
+  return stageTimes;
+}
+
+std::chrono::duration<double, std::micro>
+FunctionCallTimeReporter::getElapsed() const {
+  return std::chrono::steady_clock::now() - startTime_;
+}
+
 ScopedCallTimer::ScopedCallTimer() {
   if (FLAGS_enable_call_timing) {
     FunctionCallTimeReporter::getInstance()->start();
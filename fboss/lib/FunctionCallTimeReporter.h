@@ -15,10 +15,29 @@
 #include <folly/ScopeGuard.h>
 #include <folly/Singleton.h>
 
+#include <array>
+#include <atomic>
 #include <chrono>
 
 namespace facebook::fboss {
 
+/*
+ * Stages of programming a state update, timed with ScopedStageTimer while
+ * call timing is on. A stage is timed exclusive of stages nested in it on the
+ * same thread. TIME_CALL calls (SAI/SDK) made inside a stage are the
+ * innermost CALL stage, so stages add up to the time spent programming.
+ */
+enum class CallTimeStage : uint8_t {
+  RIB, // route updates and resolution in the RIB
+  STATE_UPDATE, // building the new switch state, e.g. FIB from RIB
+  DELTA, // applying the update in SwSwitch, outside of HW programming
+  HW_SWITCH, // HwSwitch and its managers processing the delta
+  CALL, // SAI/SDK calls
+  NUM_STAGES,
+};
+
+const char* callTimeStageName(CallTimeStage stage);
+
 class FunctionCallTimeReporter {
  public:
   static std::shared_ptr<FunctionCallTimeReporter> getInstance();
@@ -28,17 +47,39 @@ class FunctionCallTimeReporter {
   ~FunctionCallTimeReporter() = default;
   void start();
   void end();
+  bool isOn() const {
+    return isOn_;
+  }
   void callStart() {
     if (UNLIKELY(isOn_)) {
       tracker_.callStart();
+      stageTracker_.stageStart(CallTimeStage::CALL, generation_);
     }
   }
   void callEnd() {
     if (UNLIKELY(isOn_)) {
       tracker_.callEnd();
+      stageTracker_.stageEnd(CallTimeStage::CALL, stageNsecs_);
+    }
+  }
+  void stageStart(CallTimeStage stage) {
+    if (UNLIKELY(isOn_)) {
+      stageTracker_.stageStart(stage, generation_);
+    }
+  }
+  void stageEnd(CallTimeStage stage) {
+    if (UNLIKELY(isOn_)) {
+      stageTracker_.stageEnd(stage, stageNsecs_);
     }
   }
 
+  using StageTimes = std::array<
+      std::chrono::duration<double, std::micro>,
+      static_cast<size_t>(CallTimeStage::NUM_STAGES)>;
+  // Time spent in each stage, across threads, since start()
+  StageTimes getStageTimes() const;
+  std::chrono::duration<double, std::micro> getElapsed() const;
+
  private:
   struct CallTimeTracker {
     ~CallTimeTracker();
@@ -55,6 +96,26 @@ class FunctionCallTimeReporter {
     std::chrono::duration<double, std::micro> cumalativeUsecs_{0};
   };
 
+  using StageNsecs = std::array<
+      std::atomic<uint64_t>,
+      static_cast<size_t>(CallTimeStage::NUM_STAGES)>;
+
+  struct StageTracker {
+    void stageStart(CallTimeStage stage, uint64_t generation);
+    void stageEnd(CallTimeStage stage, StageNsecs& stageNsecs);
+
+    struct Frame {
+      CallTimeStage stage;
+      std::chrono::time_point<std::chrono::steady_clock> startTime;
+      std::chrono::nanoseconds nested{0};
+    };
+    static constexpr size_t kMaxDepth = 16;
+    std::array<Frame, kMaxDepth> frames_;
+    size_t depth_{0};
+    // frames left open by a previous start()/end() are dropped
+    uint64_t generation_{0};
+  };
+
   std::chrono::time_point<std::chrono::steady_clock> startTime_;
   /*
    * Use a bool to track on/off. Another option was to wrap startTime in
@@ -63,7 +124,10 @@ class FunctionCallTimeReporter {
    * and would need heavier means of synchronization
    */
   std::atomic<bool> isOn_{false};
+  std::atomic<uint64_t> generation_{0};
+  StageNsecs stageNsecs_{};
   static thread_local CallTimeTracker tracker_;
+  static thread_local StageTracker stageTracker_;
 };
 
 #define TIME_CALL                                       \
@@ -79,4 +143,19 @@ class ScopedCallTimer {
   ScopedCallTimer(const ScopedCallTimer&) = delete;
   ScopedCallTimer& operator=(const ScopedCallTimer&) = delete;
 };
+
+class ScopedStageTimer {
+ public:
+  explicit ScopedStageTimer(CallTimeStage stage) : stage_(stage) {
+    FunctionCallTimeReporter::getInstance()->stageStart(stage_);
+  }
+  ~ScopedStageTimer() {
+    FunctionCallTimeReporter::getInstance()->stageEnd(stage_);
+  }
+  ScopedStageTimer(const ScopedStageTimer&) = delete;
+  ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+ private:
+  const CallTimeStage stage_;
+};
 } // namespace facebook::fboss
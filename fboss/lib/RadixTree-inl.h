@@ -5,6 +5,46 @@
 
 namespace facebook::network {
 
+template <typename NODE>
+RadixTreeNodePool<NODE>::~RadixTreeNodePool() {
+  for (auto& [slab, count] : slabs_) {
+    std::allocator<Slot>().deallocate(slab, count);
+  }
+}
+
+template <typename NODE>
+template <typename... Args>
+NODE* RadixTreeNodePool<NODE>::create(Args&&... args) {
+  if (!freeList_) {
+    auto count = nextSlabNodes_;
+    auto slab = std::allocator<Slot>().allocate(count);
+    slabs_.emplace_back(slab, count);
+    nextSlabNodes_ = std::min(nextSlabNodes_ * 2, kMaxSlabNodes);
+    // Chain in address order, so consecutive creates are adjacent
+    for (size_t i = count; i > 0; --i) {
+      slab[i - 1].next = freeList_;
+      freeList_ = &slab[i - 1];
+    }
+  }
+  auto slot = freeList_;
+  freeList_ = slot->next;
+  try {
+    return new (slot->storage) NODE(std::forward<Args>(args)...);
+  } catch (...) {
+    slot->next = freeList_;
+    freeList_ = slot;
+    throw;
+  }
+}
+
+template <typename NODE>
+void RadixTreeNodePool<NODE>::destroy(NODE* node) {
+  node->~NODE();
+  auto slot = reinterpret_cast<Slot*>(node);
+  slot->next = freeList_;
+  freeList_ = slot;
+}
+
 template <typename IPADDRTYPE, typename T>
 typename RadixTreeNode<IPADDRTYPE, T>::TreeDirection
 RadixTreeNode<IPADDRTYPE, T>::searchDirection(
@@ -146,7 +186,7 @@ RadixTree<IPADDRTYPE, T, TreeTraits>::insert(
       // specific root.
       auto prefix = IPADDRTYPE::longestCommonPrefix(
           {root_->ipAddress(), root_->masklen()}, {toAdd, mask});
-      std::unique_ptr<TreeNode> newRoot = nullptr;
+      NodePtr newRoot = nullptr;
       if (prefix.first == toAdd && prefix.second == mask) {
         // To be added node is the new root
         newRoot = std::move(newNode);
@@ -217,7 +257,7 @@ RadixTree<IPADDRTYPE, T, TreeTraits>::insert(
         // bestMatchChild and new node.
         auto internalNode = makeNode(prefix.first, prefix.second);
         auto internalNodeRaw = internalNode.get();
-        std::unique_ptr<TreeNode> oldBestMatchChild = nullptr;
+        NodePtr oldBestMatchChild = nullptr;
         if (toAddDirection == TreeDirection::LEFT) {
           oldBestMatchChild = bestMatch->resetLeft(std::move(internalNode));
         } else {
@@ -237,7 +277,7 @@ RadixTree<IPADDRTYPE, T, TreeTraits>::insert(
         CHECK(internalNode == nullptr);
       } else {
         // New node needs to be inserted  b/w bestMatch and bestMatchChild
-        std::unique_ptr<TreeNode> oldBestMatchChild = nullptr;
+        NodePtr oldBestMatchChild = nullptr;
         if (toAddDirection == TreeDirection::LEFT) {
           oldBestMatchChild = bestMatch->resetLeft(std::move(newNode));
         } else {
@@ -402,22 +442,14 @@ bool RadixTree<IPADDRTYPE, T, TreeTraits>::radixSubTreesEqual(
 }
 
 template <typename IPADDRTYPE, typename T, typename TreeTraits>
-std::unique_ptr<typename RadixTree<IPADDRTYPE, T, TreeTraits>::TreeNode>
+typename RadixTree<IPADDRTYPE, T, TreeTraits>::NodePtr
 RadixTree<IPADDRTYPE, T, TreeTraits>::cloneSubTree(const TreeNode* node) {
   if (!node) {
     return nullptr;
   }
-  std::unique_ptr<TreeNode> copy;
-  if (node->isValueNode()) {
-    copy = std::make_unique<TreeNode>(
-        node->ipAddress(),
-        node->masklen(),
-        node->value(),
-        node->nodeDeleteCallback());
-  } else {
-    copy = std::make_unique<TreeNode>(
-        node->ipAddress(), node->masklen(), node->nodeDeleteCallback());
-  }
+  auto copy = node->isValueNode()
+      ? makeNode(node->ipAddress(), node->masklen(), node->value())
+      : makeNode(node->ipAddress(), node->masklen());
   copy->resetLeft(cloneSubTree(node->left()));
   copy->resetRight(cloneSubTree(node->right()));
   return copy;
@@ -22,6 +22,50 @@
 #include <optional>
 
 namespace facebook::network {
+/*
+ * Allocator for the nodes of a RadixTree. Nodes are carved out of slabs
+ * which double in size as the tree grows, so nodes inserted together sit
+ * next to each other in memory, and freed nodes are kept on a free list
+ * for reuse rather than returned to the heap.
+ *
+ * The pool also holds the tree's node delete callback, so nodes only need
+ * a pointer back to their pool.
+ */
+template <typename NODE>
+class RadixTreeNodePool {
+ public:
+  typedef std::function<void(const NODE&)> NodeDeleteCallback;
+
+  explicit RadixTreeNodePool(NodeDeleteCallback deleteCallback)
+      : deleteCallback_(std::move(deleteCallback)) {}
+  ~RadixTreeNodePool();
+
+  RadixTreeNodePool(const RadixTreeNodePool&) = delete;
+  RadixTreeNodePool& operator=(const RadixTreeNodePool&) = delete;
+
+  template <typename... Args>
+  NODE* create(Args&&... args);
+  void destroy(NODE* node);
+
+  const NodeDeleteCallback& deleteCallback() const {
+    return deleteCallback_;
+  }
+
+ private:
+  static constexpr size_t kMinSlabNodes = 16;
+  static constexpr size_t kMaxSlabNodes = 4096;
+
+  union Slot {
+    Slot* next;
+    alignas(NODE) unsigned char storage[sizeof(NODE)];
+  };
+
+  NodeDeleteCallback deleteCallback_;
+  std::vector<std::pair<Slot*, size_t>> slabs_;
+  Slot* freeList_{nullptr};
+  size_t nextSlabNodes_{kMinSlabNodes};
+};
+
 /*
  * Node in RadixTree, holds IP, mask. Will hold  value for nodes
  * created as a result of user inserts. Other type of nodes are
@@ -32,30 +76,35 @@ namespace facebook::network {
 template <typename IPADDRTYPE, typename T>
 class RadixTreeNode {
  public:
+  typedef RadixTreeNodePool<RadixTreeNode> NodePool;
   // Optional function parameter to call from destructor
-  typedef std::function<void(const RadixTreeNode<IPADDRTYPE, T>&)>
-      NodeDeleteCallback;
+  typedef typename NodePool::NodeDeleteCallback NodeDeleteCallback;
 
-  RadixTreeNode(
-      const IPADDRTYPE& ipAddr,
-      uint8_t mlen,
-      NodeDeleteCallback deleteCallback)
-      : ipAddress_(ipAddr), masklen_(mlen), deleteCallback_(deleteCallback) {}
+  // Returns nodes to the pool they were allocated from
+  struct Deleter {
+    void operator()(RadixTreeNode* node) const {
+      node->pool_->destroy(node);
+    }
+  };
+  typedef std::unique_ptr<RadixTreeNode, Deleter> UniquePtr;
+
+  RadixTreeNode(NodePool* pool, const IPADDRTYPE& ipAddr, uint8_t mlen)
+      : ipAddress_(ipAddr), masklen_(mlen), pool_(pool) {}
 
   template <typename VALUE>
   RadixTreeNode(
+      NodePool* pool,
       const IPADDRTYPE& ipAddr,
       uint8_t mlen,
-      VALUE&& val,
-      NodeDeleteCallback deleteCallback)
+      VALUE&& val)
       : ipAddress_(ipAddr),
         masklen_(mlen),
         value_(std::forward<VALUE>(val)),
-        deleteCallback_(deleteCallback) {}
+        pool_(pool) {}
 
   ~RadixTreeNode() {
-    if (deleteCallback_) {
-      deleteCallback_(*this);
+    if (pool_->deleteCallback()) {
+      pool_->deleteCallback()(*this);
     }
   }
 
@@ -101,10 +150,10 @@ class RadixTreeNode {
     return value_.value();
   }
   NodeDeleteCallback nodeDeleteCallback() const {
-    return deleteCallback_;
+    return pool_->deleteCallback();
   }
   std::string str(bool printValue = true) const {
-    auto nodeStr = folly::to<std::string>(ipAddress_.str(), "/", masklen_);
+    auto nodeStr = folly::to<std::string>(ipAddress_.str(), "/", masklen());
     if (printValue) {
       nodeStr += isNonValueNode()
           ? "(*)"
@@ -129,8 +178,7 @@ class RadixTreeNode {
         (!isValueNode() || this->value() == r.value());
   }
 
-  std::unique_ptr<RadixTreeNode> resetLeft(
-      std::unique_ptr<RadixTreeNode> newLeft) {
+  UniquePtr resetLeft(UniquePtr newLeft) {
     auto old = std::move(left_);
     left_ = std::move(newLeft);
     if (left_) {
@@ -139,8 +187,7 @@ class RadixTreeNode {
     return old;
   }
 
-  std::unique_ptr<RadixTreeNode> resetRight(
-      std::unique_ptr<RadixTreeNode> newRight) {
+  UniquePtr resetRight(UniquePtr newRight) {
     auto old = std::move(right_);
     right_ = std::move(newRight);
     if (right_) {
@@ -164,12 +211,12 @@ class RadixTreeNode {
 
  protected:
   IPADDRTYPE ipAddress_;
-  uint32_t masklen_{0}; // Number of bits to match.
+  uint8_t masklen_{0}; // Number of bits to match.
   std::optional<T> value_;
-  std::unique_ptr<RadixTreeNode> left_{nullptr};
-  std::unique_ptr<RadixTreeNode> right_{nullptr};
+  UniquePtr left_{nullptr};
+  UniquePtr right_{nullptr};
   RadixTreeNode* parent_{nullptr};
-  NodeDeleteCallback deleteCallback_;
+  NodePool* pool_;
 };
 
 /*
@@ -378,6 +425,8 @@ class RadixTree {
   typedef RadixTreeNode<IPADDRTYPE, T> TreeNode;
   typedef typename TreeNode::TreeDirection TreeDirection;
   typedef typename TreeNode::NodeDeleteCallback NodeDeleteCallback;
+  typedef typename TreeNode::NodePool NodePool;
+  typedef typename TreeNode::UniquePtr NodePtr;
   typedef typename TreeTraits::Iterator Iterator;
   typedef typename TreeTraits::ConstIterator ConstIterator;
   typedef typename std::vector<ConstIterator> VecConstIterators;
@@ -407,6 +456,7 @@ class RadixTree {
   void clear() {
     root_.reset(nullptr);
     size_ = 0;
+    adoptedPools_.clear();
   }
   RadixTree(RadixTree&& r) noexcept
       : nodeDeleteCallback_(r.nodeDeleteCallback_), traits_(r.traits_) {
@@ -418,6 +468,14 @@ class RadixTree {
     // ones with which this Radix tree was created
     size_ = r.size_;
     makeRoot(std::move(r.root_));
+    // Our old nodes are gone, keep the pools of the moved in ones alive
+    adoptedPools_ = std::move(r.adoptedPools_);
+    r.adoptedPools_.clear();
+    if (r.pool_ && r.pool_ != pool_) {
+      // r gets a new pool on its next insert, so a pool is never shared by
+      // two trees which may be used from different threads
+      adoptedPools_.push_back(std::move(r.pool_));
+    }
     r.size_ = 0;
     return *this;
   }
@@ -430,7 +488,7 @@ class RadixTree {
         "clone template type must be the same as Radix tree value type");
     RadixTree copy(nodeDeleteCallback_, traits_);
     copy.size_ = size_;
-    copy.root_ = cloneSubTree(root_.get());
+    copy.root_ = copy.cloneSubTree(root_.get());
     return copy;
   }
   /*
@@ -590,7 +648,7 @@ class RadixTree {
   }
 
  private:
-  static std::unique_ptr<TreeNode> cloneSubTree(const TreeNode* node);
+  NodePtr cloneSubTree(const TreeNode* node);
   // Worker function to do the actual longest match lookup.
   const TreeNode* longestMatchImpl(
       const IPADDRTYPE& ipaddr,
@@ -611,18 +669,27 @@ class RadixTree {
             ipaddr, masklen, foundExact, includeNonValueNodes, trail));
   }
 
-  std::unique_ptr<TreeNode> makeNode(const IPADDRTYPE& ip, uint8_t masklen) {
-    return std::make_unique<TreeNode>(ip, masklen, nodeDeleteCallback_);
+  NodePool* pool() {
+    if (!pool_) {
+      // Created on first insert, so empty trees don't allocate
+      pool_ = std::make_shared<NodePool>(nodeDeleteCallback_);
+    }
+    return pool_.get();
+  }
+
+  NodePtr makeNode(const IPADDRTYPE& ip, uint8_t masklen) {
+    auto nodePool = pool();
+    return NodePtr(nodePool->create(nodePool, ip, masklen));
   }
 
   template <typename VALUE>
-  std::unique_ptr<TreeNode>
-  makeNode(const IPADDRTYPE& ip, uint8_t masklen, VALUE&& value) {
-    return std::make_unique<TreeNode>(
-        ip, masklen, std::forward<VALUE>(value), nodeDeleteCallback_);
+  NodePtr makeNode(const IPADDRTYPE& ip, uint8_t masklen, VALUE&& value) {
+    auto nodePool = pool();
+    return NodePtr(
+        nodePool->create(nodePool, ip, masklen, std::forward<VALUE>(value)));
   }
 
-  void makeRoot(std::unique_ptr<TreeNode> newRoot) {
+  void makeRoot(NodePtr newRoot) {
     CHECK(root_ != newRoot || root_ == nullptr);
     if (newRoot) {
       newRoot->setParent(nullptr);
@@ -635,10 +702,14 @@ class RadixTree {
       bool includeNonValueNodes,
       const TreeNode* node) const;
 
-  std::unique_ptr<TreeNode> root_{nullptr};
-  size_t size_{0};
   NodeDeleteCallback nodeDeleteCallback_;
   TreeTraits traits_;
+  // Pools must outlive the nodes allocated from them. Nodes moved in from
+  // other trees stay in those trees' pools.
+  std::shared_ptr<NodePool> pool_;
+  std::vector<std::shared_ptr<NodePool>> adoptedPools_;
+  NodePtr root_{nullptr};
+  size_t size_{0};
 };
 
 // RadixTreeIteratorImpl for IPAddress
@@ -0,0 +1,397 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include <folly/Hash.h>
+#include <folly/container/F14Map.h>
+#include <folly/container/F14Set.h>
+#include <folly/lang/Bits.h>
+#include <folly/synchronization/Rcu.h>
+
+namespace facebook::network {
+
+/*
+ * Longest prefix match table for lookups from any thread without locks,
+ * while a single writer keeps updating it.
+ *
+ * The table is a multibit trie with one address byte per level, so an IPv4
+ * lookup visits at most 4 nodes and an IPv6 one at most 16. Within a node,
+ * prefixes ending in that byte are expanded into the 256 slots, and both the
+ * slots and the child pointers are stored compressed, poptrie style: a
+ * bitmap marks the slots which start a new run of values (or have a child)
+ * and the popcount of the bitmap below a slot indexes the packed array.
+ *
+ * Nodes are immutable once published. The writer stages inserts and erases,
+ * and publish() rebuilds every node the staged changes touch exactly once,
+ * swaps in the new root and retires the replaced nodes and values with RCU,
+ * so readers never block and never see a partially applied batch.
+ */
+template <typename IPADDRTYPE, typename T>
+class RcuLpmTable {
+ public:
+  RcuLpmTable() : root_(new Root()) {}
+  ~RcuLpmTable();
+
+  RcuLpmTable(const RcuLpmTable&) = delete;
+  RcuLpmTable& operator=(const RcuLpmTable&) = delete;
+
+  /*
+   * Writer side, from a single thread. Changes are only visible to readers
+   * once published.
+   */
+  void insert(const IPADDRTYPE& ip, uint8_t masklen, T value);
+  void erase(const IPADDRTYPE& ip, uint8_t masklen);
+  void publish();
+  // Number of prefixes, including unpublished changes
+  size_t size() const {
+    return entries_.size();
+  }
+
+  /*
+   * Reader side, from any thread.
+   */
+  std::optional<T> longestMatch(const IPADDRTYPE& ip) const;
+
+ private:
+  static constexpr size_t kBytes = IPADDRTYPE::byteCount();
+  static constexpr size_t kSlots = 256;
+  using Bytes = std::array<uint8_t, kBytes>;
+  using Bitmap = std::array<uint64_t, kSlots / 64>;
+
+  struct Entry {
+    T value;
+    uint8_t masklen;
+  };
+
+  struct Node {
+    // Slots which have a child
+    Bitmap childBits{};
+    // Slots which start a new run of values
+    Bitmap runBits{};
+    std::vector<const Node*> children;
+    // Longest prefix ending in this node for each run, if any
+    std::vector<const Entry*> runs;
+  };
+
+  struct Root {
+    const Node* node{nullptr};
+    // The default route does not end in any node
+    const Entry* defaultEntry{nullptr};
+  };
+
+  struct Prefix {
+    Bytes addr;
+    uint8_t masklen;
+    bool operator==(const Prefix& other) const {
+      return masklen == other.masklen && addr == other.addr;
+    }
+    bool operator<(const Prefix& other) const {
+      return std::tie(addr, masklen) < std::tie(other.addr, other.masklen);
+    }
+  };
+
+  struct PrefixHash {
+    size_t operator()(const Prefix& prefix) const {
+      return folly::hash::hash_combine(
+          folly::hash::hash_range(prefix.addr.begin(), prefix.addr.end()),
+          prefix.masklen);
+    }
+  };
+
+  static bool testBit(const Bitmap& bits, size_t pos) {
+    return bits[pos / 64] & (uint64_t(1) << (pos % 64));
+  }
+  static void setBit(Bitmap& bits, size_t pos) {
+    bits[pos / 64] |= uint64_t(1) << (pos % 64);
+  }
+  // Number of bits set below pos
+  static uint32_t rank(const Bitmap& bits, size_t pos) {
+    uint32_t count = 0;
+    for (size_t word = 0; word < pos / 64; ++word) {
+      count += folly::popcount(bits[word]);
+    }
+    if (pos % 64) {
+      count += folly::popcount(
+          bits[pos / 64] & ((uint64_t(1) << (pos % 64)) - 1));
+    }
+    return count;
+  }
+  static const Entry* runEntry(const Node& node, size_t slot) {
+    return node.runs[rank(node.runBits, slot + 1) - 1];
+  }
+
+  static Prefix makePrefix(const IPADDRTYPE& ip, uint8_t masklen);
+  static Bytes maskBytes(const Bytes& addr, uint8_t masklen);
+  // Depth of the node a prefix ends in, for non default prefixes
+  static size_t depthOf(uint8_t masklen) {
+    return (masklen - 1) / 8;
+  }
+
+  const Node* rebuild(
+      const Node* old,
+      size_t depth,
+      typename std::vector<Prefix>::const_iterator begin,
+      typename std::vector<Prefix>::const_iterator end,
+      std::vector<const Node*>& replaced) const;
+  const Entry* findEntry(const Prefix& prefix) const;
+  static void freeNodes(const Node* node);
+
+  std::atomic<const Root*> root_;
+
+  // Writer state: all prefixes including unpublished changes, prefixes
+  // changed since the last publish, and values they replaced which readers
+  // may still see.
+  folly::F14FastMap<Prefix, const Entry*, PrefixHash> entries_;
+  folly::F14FastSet<Prefix, PrefixHash> staged_;
+  std::vector<const Entry*> replacedEntries_;
+};
+
+template <typename IPADDRTYPE, typename T>
+RcuLpmTable<IPADDRTYPE, T>::~RcuLpmTable() {
+  // No readers left, and whatever was already retired is freed by RCU
+  auto root = root_.load();
+  freeNodes(root->node);
+  delete root;
+  for (auto& [_, entry] : entries_) {
+    delete entry;
+  }
+  for (auto entry : replacedEntries_) {
+    delete entry;
+  }
+}
+
+template <typename IPADDRTYPE, typename T>
+void RcuLpmTable<IPADDRTYPE, T>::freeNodes(const Node* node) {
+  if (!node) {
+    return;
+  }
+  for (auto child : node->children) {
+    freeNodes(child);
+  }
+  delete node;
+}
+
+template <typename IPADDRTYPE, typename T>
+typename RcuLpmTable<IPADDRTYPE, T>::Bytes
+RcuLpmTable<IPADDRTYPE, T>::maskBytes(const Bytes& addr, uint8_t masklen) {
+  Bytes masked{};
+  for (size_t i = 0; i < kBytes && masklen; ++i) {
+    auto bits = std::min<uint8_t>(masklen, 8);
+    masked[i] = addr[i] & static_cast<uint8_t>(0xff00 >> bits);
+    masklen -= bits;
+  }
+  return masked;
+}
+
+template <typename IPADDRTYPE, typename T>
+typename RcuLpmTable<IPADDRTYPE, T>::Prefix
+RcuLpmTable<IPADDRTYPE, T>::makePrefix(const IPADDRTYPE& ip, uint8_t masklen) {
+  CHECK_LE(masklen, kBytes * 8);
+  auto bytes = ip.toByteArray();
+  Bytes addr;
+  std::copy(bytes.begin(), bytes.end(), addr.begin());
+  return Prefix{maskBytes(addr, masklen), masklen};
+}
+
+template <typename IPADDRTYPE, typename T>
+void RcuLpmTable<IPADDRTYPE, T>::insert(
+    const IPADDRTYPE& ip,
+    uint8_t masklen,
+    T value) {
+  auto prefix = makePrefix(ip, masklen);
+  auto entry = new Entry{std::move(value), masklen};
+  auto [it, inserted] = entries_.try_emplace(prefix, entry);
+  if (!inserted) {
+    replacedEntries_.push_back(it->second);
+    it->second = entry;
+  }
+  staged_.insert(prefix);
+}
+
+template <typename IPADDRTYPE, typename T>
+void RcuLpmTable<IPADDRTYPE, T>::erase(const IPADDRTYPE& ip, uint8_t masklen) {
+  auto prefix = makePrefix(ip, masklen);
+  auto it = entries_.find(prefix);
+  if (it == entries_.end()) {
+    return;
+  }
+  replacedEntries_.push_back(it->second);
+  entries_.erase(it);
+  staged_.insert(prefix);
+}
+
+template <typename IPADDRTYPE, typename T>
+const typename RcuLpmTable<IPADDRTYPE, T>::Entry*
+RcuLpmTable<IPADDRTYPE, T>::findEntry(const Prefix& prefix) const {
+  auto it = entries_.find(prefix);
+  return it == entries_.end() ? nullptr : it->second;
+}
+
+template <typename IPADDRTYPE, typename T>
+void RcuLpmTable<IPADDRTYPE, T>::publish() {
+  if (staged_.empty()) {
+    return;
+  }
+  // Sorted by address, prefixes sharing a node are next to each other
+  std::vector<Prefix> staged(staged_.begin(), staged_.end());
+  staged_.clear();
+  std::sort(staged.begin(), staged.end());
+
+  auto oldRoot = root_.load(std::memory_order_relaxed);
+  auto newRoot = new Root(*oldRoot);
+  auto begin = staged.cbegin();
+  if (begin->masklen == 0) {
+    newRoot->defaultEntry = findEntry(*begin);
+    ++begin;
+  }
+  std::vector<const Node*> replaced;
+  if (begin != staged.cend()) {
+    newRoot->node = rebuild(oldRoot->node, 0, begin, staged.cend(), replaced);
+  }
+  root_.store(newRoot, std::memory_order_release);
+
+  folly::rcu_retire(const_cast<Root*>(oldRoot));
+  for (auto node : replaced) {
+    folly::rcu_retire(const_cast<Node*>(node));
+  }
+  for (auto entry : replacedEntries_) {
+    folly::rcu_retire(const_cast<Entry*>(entry));
+  }
+  replacedEntries_.clear();
+}
+
+template <typename IPADDRTYPE, typename T>
+const typename RcuLpmTable<IPADDRTYPE, T>::Node*
+RcuLpmTable<IPADDRTYPE, T>::rebuild(
+    const Node* old,
+    size_t depth,
+    typename std::vector<Prefix>::const_iterator begin,
+    typename std::vector<Prefix>::const_iterator end,
+    std::vector<const Node*>& replaced) const {
+  std::array<const Entry*, kSlots> slots{};
+  std::array<const Node*, kSlots> children{};
+  if (old) {
+    for (size_t slot = 0; slot < kSlots; ++slot) {
+      slots[slot] = runEntry(*old, slot);
+      if (testBit(old->childBits, slot)) {
+        children[slot] = old->children[rank(old->childBits, slot)];
+      }
+    }
+    replaced.push_back(old);
+  }
+
+  // Prefixes ending here, shortest first so longer ones win their slots
+  std::vector<Prefix> ending;
+  for (auto it = begin; it != end; ++it) {
+    if (depthOf(it->masklen) == depth) {
+      ending.push_back(*it);
+    }
+  }
+  std::stable_sort(
+      ending.begin(), ending.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.masklen < rhs.masklen;
+      });
+  for (const auto& prefix : ending) {
+    auto bitsHere = prefix.masklen - depth * 8;
+    size_t first = prefix.addr[depth];
+    size_t count = size_t(1) << (8 - bitsHere);
+    if (auto entry = findEntry(prefix)) {
+      for (auto slot = first; slot < first + count; ++slot) {
+        if (!slots[slot] || slots[slot]->masklen <= prefix.masklen) {
+          slots[slot] = entry;
+        }
+      }
+      continue;
+    }
+    // Erased: slots it owned fall back to the longest shorter prefix which
+    // ends in this node. Shorter ones ending above are found by the lookup.
+    const Entry* fallback = nullptr;
+    for (int masklen = prefix.masklen - 1;
+         !fallback && masklen > static_cast<int>(depth * 8);
+         --masklen) {
+      auto shorter = static_cast<uint8_t>(masklen);
+      fallback = findEntry(Prefix{maskBytes(prefix.addr, shorter), shorter});
+    }
+    for (auto slot = first; slot < first + count; ++slot) {
+      if (slots[slot] && slots[slot]->masklen == prefix.masklen) {
+        slots[slot] = fallback;
+      }
+    }
+  }
+
+  // Prefixes ending deeper, grouped by their byte at this depth
+  auto it = begin;
+  while (it != end) {
+    if (depthOf(it->masklen) == depth) {
+      ++it;
+      continue;
+    }
+    auto slot = it->addr[depth];
+    auto groupEnd = it;
+    std::vector<Prefix> group;
+    while (groupEnd != end && groupEnd->addr[depth] == slot) {
+      if (depthOf(groupEnd->masklen) != depth) {
+        group.push_back(*groupEnd);
+      }
+      ++groupEnd;
+    }
+    children[slot] = rebuild(
+        children[slot], depth + 1, group.cbegin(), group.cend(), replaced);
+    it = groupEnd;
+  }
+
+  auto node = std::make_unique<Node>();
+  for (size_t slot = 0; slot < kSlots; ++slot) {
+    if (slot == 0 || slots[slot] != slots[slot - 1]) {
+      setBit(node->runBits, slot);
+      node->runs.push_back(slots[slot]);
+    }
+    if (children[slot]) {
+      setBit(node->childBits, slot);
+      node->children.push_back(children[slot]);
+    }
+  }
+  if (node->children.empty() && node->runs.size() == 1 && !node->runs[0]) {
+    // Nothing left under this node
+    return nullptr;
+  }
+  return node.release();
+}
+
+template <typename IPADDRTYPE, typename T>
+std::optional<T> RcuLpmTable<IPADDRTYPE, T>::longestMatch(
+    const IPADDRTYPE& ip) const {
+  std::scoped_lock<folly::rcu_domain> guard(folly::rcu_default_domain());
+  auto root = root_.load(std::memory_order_acquire);
+  auto bytes = ip.toByteArray();
+  const Entry* best = root->defaultEntry;
+  const Node* node = root->node;
+  for (size_t depth = 0; node && depth < kBytes; ++depth) {
+    size_t slot = bytes[depth];
+    if (auto entry = runEntry(*node, slot)) {
+      best = entry;
+    }
+    node = testBit(node->childBits, slot)
+        ? node->children[rank(node->childBits, slot)]
+        : nullptr;
+  }
+  if (!best) {
+    return std::nullopt;
+  }
+  return best->value;
+}
+
+} // namespace facebook::network
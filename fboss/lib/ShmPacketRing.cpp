@@ -0,0 +1,280 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/lib/ShmPacketRing.h"
+
+#include <cstring>
+
+#include <folly/Exception.h>
+#include <folly/Format.h>
+#include <folly/lang/Bits.h>
+#include <folly/logging/xlog.h>
+
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+constexpr uint64_t kMagic = 0x46425353484d5231; // "FBSSHMR1"
+constexpr size_t kHeaderBytes = 4096;
+constexpr size_t kMinCapacity = 64 << 10;
+// Marks the filler record at the end of the data area when a record would
+// not fit before wrapping around
+constexpr uint32_t kWrapLength = 0xffffffff;
+
+enum : uint16_t {
+  kHasPort = 1 << 0,
+  kHasAggPort = 1 << 1,
+  kHasVlan = 1 << 2,
+  kHasQueue = 1 << 3,
+};
+
+// Not FUTEX_WAIT_PRIVATE, the other side of the futex is another process
+long futex(std::atomic<uint32_t>* addr, int op, uint32_t val, timespec* ts) {
+  return syscall(SYS_futex, addr, op, val, ts, nullptr, 0);
+}
+} // namespace
+
+namespace facebook::fboss {
+
+struct ShmPacketRing::Header {
+  uint64_t magic;
+  uint64_t capacity;
+  std::atomic<uint64_t> dropped;
+  // Free running byte offsets, written by the producer and consumer resp.
+  alignas(64) std::atomic<uint64_t> head;
+  alignas(64) std::atomic<uint64_t> tail;
+  alignas(64) std::atomic<uint32_t> doorbell;
+  std::atomic<uint32_t> consumerWaiting;
+};
+
+// Records are multiples of the record header size, so there is always room
+// for the wrap filler at the end of the data area
+struct ShmPacketRing::RecordHeader {
+  uint32_t size;
+  uint32_t length;
+  int32_t port;
+  int32_t aggPort;
+  int32_t vlan;
+  int16_t queue;
+  uint16_t flags;
+  uint64_t reserved;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+std::unique_ptr<ShmPacketRing> ShmPacketRing::create(
+    const std::string& name,
+    size_t capacity) {
+  static_assert(sizeof(Header) <= kHeaderBytes);
+  capacity = folly::nextPowTwo(std::max(capacity, kMinCapacity));
+  auto fd = ::memfd_create(name.c_str(), MFD_CLOEXEC);
+  folly::checkUnixError(fd, "memfd_create failed for ", name);
+  folly::File file(fd, true /* ownsFd */);
+  folly::checkUnixError(
+      ::ftruncate(file.fd(), kHeaderBytes + capacity),
+      "ftruncate failed for ",
+      name);
+
+  std::unique_ptr<ShmPacketRing> ring(
+      new ShmPacketRing(std::move(file), kHeaderBytes + capacity));
+  auto header = new (ring->header_) Header();
+  header->magic = kMagic;
+  header->capacity = capacity;
+  XLOG(DBG2) << "Created packet ring " << name << " of " << capacity
+             << " bytes, fd " << ring->fd();
+  return ring;
+}
+
+std::unique_ptr<ShmPacketRing> ShmPacketRing::attach(pid_t pid, int fd) {
+  auto path = folly::sformat("/proc/{}/fd/{}", pid, fd);
+  folly::File file(path, O_RDWR | O_CLOEXEC);
+  struct stat st;
+  folly::checkUnixError(::fstat(file.fd(), &st), "fstat failed for ", path);
+  auto bytes = static_cast<size_t>(st.st_size);
+  if (bytes <= kHeaderBytes) {
+    folly::throwSystemErrorExplicit(EINVAL, path, " is not a packet ring");
+  }
+
+  std::unique_ptr<ShmPacketRing> ring(
+      new ShmPacketRing(std::move(file), bytes));
+  if (ring->header_->magic != kMagic ||
+      ring->header_->capacity + kHeaderBytes != bytes) {
+    folly::throwSystemErrorExplicit(EINVAL, path, " is not a packet ring");
+  }
+  return ring;
+}
+
+ShmPacketRing::ShmPacketRing(folly::File file, size_t mappedBytes)
+    : file_(std::move(file)), mappedBytes_(mappedBytes) {
+  auto addr = ::mmap(
+      nullptr,
+      mappedBytes_,
+      PROT_READ | PROT_WRITE,
+      MAP_SHARED,
+      file_.fd(),
+      0);
+  if (addr == MAP_FAILED) {
+    folly::throwSystemError("mmap of packet ring failed");
+  }
+  header_ = static_cast<Header*>(addr);
+}
+
+ShmPacketRing::~ShmPacketRing() {
+  ::munmap(header_, mappedBytes_);
+}
+
+uint8_t* ShmPacketRing::data() const {
+  return reinterpret_cast<uint8_t*>(header_) + kHeaderBytes;
+}
+
+size_t ShmPacketRing::capacity() const {
+  return header_->capacity;
+}
+
+uint64_t ShmPacketRing::dropped() const {
+  return header_->dropped.load(std::memory_order_relaxed);
+}
+
+bool ShmPacketRing::empty() const {
+  return header_->head.load(std::memory_order_acquire) ==
+      header_->tail.load(std::memory_order_relaxed);
+}
+
+bool ShmPacketRing::tryPush(const PacketInfo& info, const folly::IOBuf& buf) {
+  const uint64_t capacity = header_->capacity;
+  const auto length = buf.computeChainDataLength();
+  const uint64_t size = (sizeof(RecordHeader) + length +
+                         sizeof(RecordHeader) - 1) &
+      ~(sizeof(RecordHeader) - 1);
+  auto head = header_->head.load(std::memory_order_relaxed);
+  const auto tail = header_->tail.load(std::memory_order_acquire);
+  const auto offset = head & (capacity - 1);
+  const auto contiguous = capacity - offset;
+  const auto needed = size + (contiguous < size ? contiguous : 0);
+  if (size > capacity / 2 || capacity - (head - tail) < needed) {
+    header_->dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  if (contiguous < size) {
+    auto filler = reinterpret_cast<RecordHeader*>(data() + offset);
+    filler->size = contiguous;
+    filler->length = kWrapLength;
+    head += contiguous;
+  }
+  auto record =
+      reinterpret_cast<RecordHeader*>(data() + (head & (capacity - 1)));
+  record->size = size;
+  record->length = length;
+  record->flags = 0;
+  if (info.port) {
+    record->port = *info.port;
+    record->flags |= kHasPort;
+  }
+  if (info.aggPort) {
+    record->aggPort = *info.aggPort;
+    record->flags |= kHasAggPort;
+  }
+  if (info.vlan) {
+    record->vlan = *info.vlan;
+    record->flags |= kHasVlan;
+  }
+  if (info.queue) {
+    record->queue = *info.queue;
+    record->flags |= kHasQueue;
+  }
+  auto payload = reinterpret_cast<uint8_t*>(record + 1);
+  for (const auto& range : buf) {
+    std::memcpy(payload, range.data(), range.size());
+    payload += range.size();
+  }
+  header_->head.store(head + size, std::memory_order_release);
+
+  // Pairs with the fence in wait(), either the consumer sees the new head
+  // or we see it waiting
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (header_->consumerWaiting.load(std::memory_order_relaxed)) {
+    notify();
+  }
+  return true;
+}
+
+std::optional<ShmPacketRing::Packet> ShmPacketRing::tryPop() {
+  const uint64_t capacity = header_->capacity;
+  auto tail = header_->tail.load(std::memory_order_relaxed);
+  const auto head = header_->head.load(std::memory_order_acquire);
+  while (tail != head) {
+    auto record =
+        reinterpret_cast<const RecordHeader*>(data() + (tail & (capacity - 1)));
+    const uint64_t size = record->size;
+    if (size < sizeof(RecordHeader) || size > head - tail ||
+        (record->length != kWrapLength &&
+         record->length > size - sizeof(RecordHeader))) {
+      // Only a misbehaving producer gets us here, drop everything queued
+      XLOG(ERR) << "Corrupt packet ring record of size " << size
+                << ", dropping " << head - tail << " bytes";
+      header_->dropped.fetch_add(1, std::memory_order_relaxed);
+      header_->tail.store(head, std::memory_order_release);
+      return std::nullopt;
+    }
+    if (record->length == kWrapLength) {
+      tail += size;
+      continue;
+    }
+
+    Packet pkt;
+    if (record->flags & kHasPort) {
+      pkt.info.port = record->port;
+    }
+    if (record->flags & kHasAggPort) {
+      pkt.info.aggPort = record->aggPort;
+    }
+    if (record->flags & kHasVlan) {
+      pkt.info.vlan = record->vlan;
+    }
+    if (record->flags & kHasQueue) {
+      pkt.info.queue = record->queue;
+    }
+    pkt.buf = folly::IOBuf::copyBuffer(record + 1, record->length);
+    header_->tail.store(tail + size, std::memory_order_release);
+    return pkt;
+  }
+  header_->tail.store(tail, std::memory_order_release);
+  return std::nullopt;
+}
+
+bool ShmPacketRing::wait(std::chrono::milliseconds timeout) {
+  auto doorbell = header_->doorbell.load(std::memory_order_acquire);
+  header_->consumerWaiting.store(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (empty()) {
+    auto secs = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+    timespec ts{
+        static_cast<time_t>(secs.count()),
+        static_cast<long>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                timeout - secs)
+                .count())};
+    // EAGAIN if the doorbell already rang, EINTR and ETIMEDOUT are fine too
+    futex(&header_->doorbell, FUTEX_WAIT, doorbell, &ts);
+  }
+  header_->consumerWaiting.store(0, std::memory_order_relaxed);
+  return !empty();
+}
+
+void ShmPacketRing::notify() {
+  header_->doorbell.fetch_add(1, std::memory_order_release);
+  futex(&header_->doorbell, FUTEX_WAKE, 1, nullptr);
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <folly/File.h>
+#include <folly/io/IOBuf.h>
+
+#include <sys/types.h>
+
+namespace facebook::fboss {
+
+/*
+ * Single producer, single consumer ring of packets in a memfd, shared
+ * between two processes. Each record is the packet metadata followed by a
+ * copy of the payload, so moving a packet across is two memcpys and no
+ * serialization.
+ *
+ * One process creates the ring and hands its (pid, fd) to the other over
+ * some control channel, which then attaches by opening /proc/<pid>/fd/<fd>.
+ * The consumer sleeps on a futex in the shared header and the producer only
+ * rings it when the consumer is waiting, so a busy ring costs no syscalls.
+ *
+ * A full ring drops the packet and counts it, like a full rx queue would.
+ */
+class ShmPacketRing {
+ public:
+  struct PacketInfo {
+    std::optional<int32_t> port;
+    std::optional<int32_t> aggPort;
+    std::optional<int32_t> vlan;
+    // Egress queue on tx, cpu cos queue on rx
+    std::optional<int16_t> queue;
+  };
+
+  struct Packet {
+    PacketInfo info;
+    std::unique_ptr<folly::IOBuf> buf;
+  };
+
+  // Data capacity is rounded up to a power of two
+  static std::unique_ptr<ShmPacketRing> create(
+      const std::string& name,
+      size_t capacity);
+  // Attach to a ring created by another process
+  static std::unique_ptr<ShmPacketRing> attach(pid_t pid, int fd);
+
+  ~ShmPacketRing();
+  ShmPacketRing(const ShmPacketRing&) = delete;
+  ShmPacketRing& operator=(const ShmPacketRing&) = delete;
+
+  // Producer side. Copies the whole chain, false if it was dropped.
+  bool tryPush(const PacketInfo& info, const folly::IOBuf& buf);
+
+  // Consumer side
+  std::optional<Packet> tryPop();
+  // Block until the ring is not empty, or timeout. True if not empty.
+  bool wait(std::chrono::milliseconds timeout);
+  // Wake up a consumer blocked in wait(), e.g. to have it exit
+  void notify();
+
+  bool empty() const;
+  int fd() const {
+    return file_.fd();
+  }
+  size_t capacity() const;
+  uint64_t dropped() const;
+
+ private:
+  struct Header;
+  struct RecordHeader;
+
+  ShmPacketRing(folly::File file, size_t mappedBytes);
+  uint8_t* data() const;
+
+  folly::File file_;
+  size_t mappedBytes_;
+  Header* header_;
+};
+
+} // namespace facebook::fboss
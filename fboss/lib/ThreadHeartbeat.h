@@ -13,7 +13,9 @@
 #include <folly/io/async/AsyncTimeout.h>
 #include <folly/io/async/EventBase.h>
 #include <folly/logging/xlog.h>
+#include <pthread.h>
 #include <chrono>
+#include <optional>
 
 namespace facebook::fboss {
 
@@ -51,6 +53,19 @@ class ThreadHeartbeat : private folly::AsyncTimeout {
     return threadName_;
   }
 
+  std::chrono::milliseconds getIntervalMsecs() const {
+    return intervalMsecs_;
+  }
+
+  // Native handle of the thread running the event base. Only known once the
+  // first heartbeat has been scheduled from that thread.
+  std::optional<pthread_t> getNativeThread() const {
+    if (!nativeThreadSet_.load(std::memory_order_acquire)) {
+      return std::nullopt;
+    }
+    return nativeThread_;
+  }
+
   void setMonitoringPaused(bool pause) {
     monitoringPaused_ = pause;
   }
@@ -64,6 +79,8 @@ class ThreadHeartbeat : private folly::AsyncTimeout {
 
   void scheduleFirstHeartbeat() {
     CHECK(evb_->inRunningEventBaseThread());
+    nativeThread_ = pthread_self();
+    nativeThreadSet_.store(true, std::memory_order_release);
     lastTime_ = std::chrono::steady_clock::now();
     scheduleTimeout(intervalMsecs_);
   }
@@ -78,6 +95,8 @@ class ThreadHeartbeat : private folly::AsyncTimeout {
   int delayThresholdMsecs_ = 1000;
   int backlogThreshold_ = 10;
   std::atomic_bool monitoringPaused_{false};
+  pthread_t nativeThread_{};
+  std::atomic_bool nativeThreadSet_{false};
 };
 
 // monitor thread heartbeats, and alarm if heartbeat timestamp
@@ -0,0 +1,332 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/lib/ThreadStallProfiler.h"
+
+#include <folly/Conv.h>
+#include <folly/Demangle.h>
+#include <folly/Format.h>
+#include <folly/String.h>
+#include <folly/debugging/symbolizer/SignalHandler.h>
+#include <folly/debugging/symbolizer/StackTrace.h>
+#include <folly/debugging/symbolizer/Symbolizer.h>
+#include <folly/logging/xlog.h>
+
+#include <signal.h>
+#include <unistd.h>
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+using namespace std::chrono;
+
+namespace facebook::fboss {
+
+namespace {
+constexpr size_t kMaxFrames = 64;
+// The signal handler and the kernel signal trampoline sit on top of the
+// interrupted frames, skip them.
+constexpr size_t kSkipFrames = 2;
+constexpr size_t kMaxProfilers = 16;
+
+/*
+ * A single in-flight sample request. The profiler thread fills in target and
+ * sets active, the signal handler running on target writes the addresses
+ * and sets done. inHandler lets the requester wait out a late handler before
+ * reusing the slot.
+ */
+struct SampleRequest {
+  pthread_t target{};
+  std::atomic_bool active{false};
+  std::atomic_bool done{false};
+  std::atomic_int inHandler{0};
+  ssize_t numFrames{0};
+  uintptr_t addresses[kMaxFrames];
+};
+
+SampleRequest gSampleRequest;
+std::mutex gSampleRequestMutex;
+std::once_flag gInstallOnce;
+std::array<std::atomic<const ThreadStallProfiler*>, kMaxProfilers>
+    gProfilers{};
+
+int sampleSignal() {
+  // SIGRTMIN is not a compile time constant with glibc
+  return SIGRTMIN + 4;
+}
+
+void sampleSignalHandler(int /* signum */) {
+  auto savedErrno = errno;
+  auto& request = gSampleRequest;
+  request.inHandler.fetch_add(1, std::memory_order_acq_rel);
+  if (request.active.load(std::memory_order_acquire) &&
+      pthread_equal(request.target, pthread_self())) {
+    request.numFrames =
+        folly::symbolizer::getStackTraceSafe(request.addresses, kMaxFrames);
+    request.done.store(true, std::memory_order_release);
+  }
+  request.inHandler.fetch_sub(1, std::memory_order_acq_rel);
+  errno = savedErrno;
+}
+
+void dumpAllProfilers() {
+  for (auto& profiler : gProfilers) {
+    if (auto p = profiler.load(std::memory_order_acquire)) {
+      p->dumpSamples(STDERR_FILENO);
+    }
+  }
+}
+
+void installHandlers() {
+  std::call_once(gInstallOnce, []() {
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = sampleSignalHandler;
+    // Don't make syscalls in the stalled thread fail with EINTR
+    sa.sa_flags = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    if (sigaction(sampleSignal(), &sa, nullptr) != 0) {
+      XLOG(ERR) << "Failed to install stall sampling signal handler: "
+                << folly::errnoStr(errno);
+    }
+    folly::symbolizer::addFatalSignalCallback(dumpAllProfilers);
+  });
+}
+
+void registerProfiler(const ThreadStallProfiler* profiler) {
+  for (auto& slot : gProfilers) {
+    const ThreadStallProfiler* expected = nullptr;
+    if (slot.compare_exchange_strong(expected, profiler)) {
+      return;
+    }
+  }
+  XLOG(WARN) << "Too many stall profilers, samples won't be dumped on crash";
+}
+
+void unregisterProfiler(const ThreadStallProfiler* profiler) {
+  for (auto& slot : gProfilers) {
+    const ThreadStallProfiler* expected = profiler;
+    slot.compare_exchange_strong(expected, nullptr);
+  }
+}
+
+void writeStr(int fd, const char* str, size_t len) {
+  while (len > 0) {
+    auto written = ::write(fd, str, len);
+    if (written <= 0) {
+      if (written < 0 && errno == EINTR) {
+        continue;
+      }
+      return;
+    }
+    str += written;
+    len -= written;
+  }
+}
+
+void writeStr(int fd, const char* str) {
+  writeStr(fd, str, strlen(str));
+}
+
+void writeStr(int fd, const std::string& str) {
+  writeStr(fd, str.data(), str.size());
+}
+
+void writeInt(int fd, int64_t value) {
+  char buf[20];
+  if (value < 0) {
+    writeStr(fd, "-");
+    value = -value;
+  }
+  writeStr(fd, buf, folly::uint64ToBufferUnsafe(value, buf));
+}
+} // namespace
+
+ThreadStallProfiler::ThreadStallProfiler(
+    milliseconds stallThreshold,
+    size_t maxSamples,
+    milliseconds checkInterval)
+    : stallThreshold_(stallThreshold),
+      maxSamples_(maxSamples),
+      checkInterval_(checkInterval) {}
+
+ThreadStallProfiler::~ThreadStallProfiler() {
+  stop();
+}
+
+void ThreadStallProfiler::startProfilingHeartbeat(
+    std::shared_ptr<ThreadHeartbeat> heartbeat) {
+  if (running_) {
+    throw std::runtime_error(
+        "Cannot add heartbeat of thread " + heartbeat->getThreadName() +
+        " to a running stall profiler");
+  }
+  if (heartbeats_.find(heartbeat) != heartbeats_.end()) {
+    throw std::runtime_error(
+        "Heartbeat already profiled for thread " + heartbeat->getThreadName());
+  }
+  heartbeats_.emplace(std::move(heartbeat), std::nullopt);
+}
+
+void ThreadStallProfiler::start() {
+  if (!running_) {
+    installHandlers();
+    registerProfiler(this);
+    running_ = true;
+    thread_ = std::thread([this]() {
+      XLOG(INFO) << "Start thread stall profiler, stall threshold ms: "
+                 << stallThreshold_.count();
+      profilerLoop();
+    });
+  }
+}
+
+void ThreadStallProfiler::stop() {
+  if (running_) {
+    running_ = false;
+    XLOG(INFO) << "Stopping thread stall profiler";
+    cv_.notify_one();
+    thread_.join();
+    unregisterProfiler(this);
+  }
+}
+
+std::vector<ThreadStallProfiler::Sample> ThreadStallProfiler::getSamples()
+    const {
+  std::lock_guard<std::mutex> g(samplesMutex_);
+  return std::vector<Sample>(samples_.begin(), samples_.end());
+}
+
+void ThreadStallProfiler::dumpSamples(int fd) const {
+  std::unique_lock<std::mutex> g(samplesMutex_, std::try_to_lock);
+  if (!g.owns_lock()) {
+    writeStr(fd, "*** Thread stall samples busy, skipping dump ***\n");
+    return;
+  }
+  for (const auto& sample : samples_) {
+    writeStr(fd, "*** Thread stall: ");
+    writeStr(fd, sample.threadName);
+    writeStr(fd, " lag ms: ");
+    writeInt(fd, sample.lag.count());
+    writeStr(fd, " at epoch ms: ");
+    writeInt(
+        fd,
+        duration_cast<milliseconds>(sample.timestamp.time_since_epoch())
+            .count());
+    writeStr(fd, " ***\n");
+    for (const auto& frame : sample.frames) {
+      writeStr(fd, "    @ ");
+      writeStr(fd, frame);
+      writeStr(fd, "\n");
+    }
+  }
+}
+
+std::optional<std::vector<std::string>> ThreadStallProfiler::sampleThread(
+    pthread_t thread,
+    milliseconds timeout) {
+  installHandlers();
+  std::lock_guard<std::mutex> g(gSampleRequestMutex);
+  auto& request = gSampleRequest;
+  request.target = thread;
+  request.numFrames = 0;
+  request.done.store(false, std::memory_order_relaxed);
+  request.active.store(true, std::memory_order_release);
+
+  bool done = false;
+  if (pthread_kill(thread, sampleSignal()) == 0) {
+    auto deadline = steady_clock::now() + timeout;
+    while (!(done = request.done.load(std::memory_order_acquire)) &&
+           steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(microseconds(100));
+    }
+  }
+  request.active.store(false, std::memory_order_release);
+  // A handler that already passed the active check may still be writing
+  while (request.inHandler.load(std::memory_order_acquire) != 0) {
+    std::this_thread::yield();
+  }
+  if (!done || request.numFrames <= static_cast<ssize_t>(kSkipFrames)) {
+    return std::nullopt;
+  }
+
+  size_t numFrames = request.numFrames - kSkipFrames;
+  std::vector<folly::symbolizer::SymbolizedFrame> symbolized(numFrames);
+  folly::symbolizer::Symbolizer symbolizer(
+      folly::symbolizer::LocationInfoMode::DISABLED);
+  symbolizer.symbolize(
+      folly::Range<const uintptr_t*>(
+          request.addresses + kSkipFrames, numFrames),
+      folly::range(symbolized));
+
+  std::vector<std::string> frames;
+  frames.reserve(numFrames);
+  for (size_t i = 0; i < numFrames; ++i) {
+    const auto& frame = symbolized[i];
+    frames.push_back(folly::sformat(
+        "{:#x} {}",
+        request.addresses[kSkipFrames + i],
+        frame.found ? folly::demangle(frame.name).toStdString()
+                    : std::string("(unknown)")));
+  }
+  return frames;
+}
+
+void ThreadStallProfiler::profilerLoop() {
+  while (running_) {
+    checkHeartbeats();
+    std::unique_lock<std::mutex> l(loopMutex_);
+    cv_.wait_for(l, checkInterval_, [this]() { return !running_; });
+  }
+}
+
+void ThreadStallProfiler::checkHeartbeats() {
+  for (auto& [heartbeat, lastSampled] : heartbeats_) {
+    auto timestamp = heartbeat->getTimestamp();
+    auto thread = heartbeat->getNativeThread();
+    if (timestamp == steady_clock::time_point::min() || !thread ||
+        heartbeat->getMonitoringPaused()) {
+      continue;
+    }
+    auto now = steady_clock::now();
+    auto lag = duration_cast<milliseconds>(now - timestamp) -
+        heartbeat->getIntervalMsecs();
+    // Sample a long stall once every stallThreshold_ so we can see whether
+    // the thread is stuck in one place or making slow progress.
+    if (lag <= stallThreshold_ ||
+        (lastSampled && now - *lastSampled < stallThreshold_)) {
+      continue;
+    }
+    lastSampled = now;
+    auto frames = sampleThread(*thread);
+    if (!frames) {
+      XLOG(WARN) << heartbeat->getThreadName() << " stalled for "
+                 << lag.count() << "ms, but could not capture its stack";
+      continue;
+    }
+    XLOG(WARN) << heartbeat->getThreadName() << " stalled for "
+               << lag.count() << "ms, captured " << frames->size()
+               << " frames";
+    addSample(Sample{
+        heartbeat->getThreadName(),
+        system_clock::now(),
+        lag,
+        std::move(*frames)});
+  }
+}
+
+void ThreadStallProfiler::addSample(Sample sample) {
+  std::lock_guard<std::mutex> g(samplesMutex_);
+  samples_.push_back(std::move(sample));
+  while (samples_.size() > maxSamples_) {
+    samples_.pop_front();
+  }
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,106 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "fboss/lib/ThreadHeartbeat.h"
+
+namespace facebook::fboss {
+
+/*
+ * Samples the stack of threads whose heartbeat is late.
+ *
+ * ThreadHeartbeatWatchdog only tells us that a thread missed its heartbeat.
+ * The profiler polls the same heartbeats and, once a thread has been lagging
+ * for longer than stallThreshold, interrupts it with a signal and records a
+ * symbolized stack trace of what it was doing. The last maxSamples samples
+ * are kept in a ring buffer which can be read back (e.g. over thrift) and is
+ * dumped to stderr if the process crashes.
+ *
+ * Capturing is done from a signal handler, so at most one stall is sampled
+ * at a time across all profilers in the process.
+ */
+class ThreadStallProfiler {
+ public:
+  struct Sample {
+    std::string threadName;
+    std::chrono::system_clock::time_point timestamp;
+    // How late the heartbeat was when the sample was taken
+    std::chrono::milliseconds lag;
+    // Symbolized frames, innermost first
+    std::vector<std::string> frames;
+  };
+
+  ThreadStallProfiler(
+      std::chrono::milliseconds stallThreshold,
+      size_t maxSamples,
+      std::chrono::milliseconds checkInterval);
+  virtual ~ThreadStallProfiler();
+
+  void startProfilingHeartbeat(std::shared_ptr<ThreadHeartbeat> heartbeat);
+
+  void start();
+  void stop();
+
+  // Oldest sample first
+  std::vector<Sample> getSamples() const;
+
+  // Write all samples to fd. Only takes the sample lock if it is free and
+  // does not allocate, so it is safe to call from the fatal signal handler.
+  void dumpSamples(int fd) const;
+
+  /*
+   * Capture the current stack of thread. Returns std::nullopt if the thread
+   * did not respond to the sampling signal in time.
+   */
+  static std::optional<std::vector<std::string>> sampleThread(
+      pthread_t thread,
+      std::chrono::milliseconds timeout = std::chrono::milliseconds(100));
+
+ private:
+  void profilerLoop();
+  void checkHeartbeats();
+  void addSample(Sample sample);
+
+  const std::chrono::milliseconds stallThreshold_;
+  const size_t maxSamples_;
+  const std::chrono::milliseconds checkInterval_;
+
+  std::thread thread_;
+  std::atomic_bool running_{false};
+  std::mutex loopMutex_;
+  std::condition_variable cv_;
+
+  // Heartbeat to the time its thread was last sampled, if ever. Only
+  // modified before start(), afterwards only accessed from the profiler
+  // thread.
+  std::map<
+      std::shared_ptr<ThreadHeartbeat>,
+      std::optional<std::chrono::steady_clock::time_point>>
+      heartbeats_;
+
+  // Ring buffer of the last maxSamples_ samples. A plain mutex so the crash
+  // handler can try_lock it.
+  mutable std::mutex samplesMutex_;
+  std::deque<Sample> samples_;
+};
+
+} // namespace facebook::fboss
@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/lib/FunctionCallTimeReporter.h"
+
+#include <gtest/gtest.h>
+
+#include <optional>
+
+using namespace facebook::fboss;
+using namespace std::chrono_literals;
+
+namespace {
+void spinFor(std::chrono::microseconds duration) {
+  auto until = std::chrono::steady_clock::now() + duration;
+  while (std::chrono::steady_clock::now() < until) {
+  }
+}
+
+std::chrono::duration<double, std::micro> stageTime(
+    const FunctionCallTimeReporter::StageTimes& stageTimes,
+    CallTimeStage stage) {
+  return stageTimes[static_cast<size_t>(stage)];
+}
+} // namespace
+
+TEST(FunctionCallTimeReporterTest, NestedStagesAreExclusive) {
+  auto reporter = FunctionCallTimeReporter::getInstance();
+  reporter->start();
+  {
+    ScopedStageTimer delta(CallTimeStage::DELTA);
+    spinFor(2ms);
+    {
+      ScopedStageTimer hwSwitch(CallTimeStage::HW_SWITCH);
+      spinFor(2ms);
+      {
+        TIME_CALL;
+        spinFor(2ms);
+      }
+    }
+  }
+  auto elapsed = reporter->getElapsed();
+  auto stageTimes = reporter->getStageTimes();
+  reporter->end();
+
+  std::chrono::duration<double, std::micro> total{0};
+  for (auto stage :
+       {CallTimeStage::DELTA, CallTimeStage::HW_SWITCH, CallTimeStage::CALL}) {
+    EXPECT_GE(stageTime(stageTimes, stage), 2ms)
+        << callTimeStageName(stage);
+    total += stageTime(stageTimes, stage);
+  }
+  // nested time is only counted once
+  EXPECT_LE(total, elapsed);
+  EXPECT_EQ(stageTime(stageTimes, CallTimeStage::RIB).count(), 0);
+}
+
+TEST(FunctionCallTimeReporterTest, CallsOutsideStagesNotCounted) {
+  auto reporter = FunctionCallTimeReporter::getInstance();
+  reporter->start();
+  {
+    TIME_CALL;
+    spinFor(1ms);
+  }
+  auto stageTimes = reporter->getStageTimes();
+  reporter->end();
+  EXPECT_EQ(stageTime(stageTimes, CallTimeStage::CALL).count(), 0);
+}
+
+TEST(FunctionCallTimeReporterTest, StagesOpenBeforeStartIgnored) {
+  auto reporter = FunctionCallTimeReporter::getInstance();
+  std::optional<ScopedStageTimer> before;
+  reporter->start();
+  before.emplace(CallTimeStage::RIB);
+  reporter->end();
+
+  reporter->start();
+  {
+    ScopedStageTimer stateUpdate(CallTimeStage::STATE_UPDATE);
+    spinFor(1ms);
+  }
+  before.reset();
+  auto stageTimes = reporter->getStageTimes();
+  reporter->end();
+  EXPECT_GE(stageTime(stageTimes, CallTimeStage::STATE_UPDATE), 1ms);
+  EXPECT_EQ(stageTime(stageTimes, CallTimeStage::RIB).count(), 0);
+}
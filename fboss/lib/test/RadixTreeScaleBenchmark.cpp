@@ -0,0 +1,111 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <folly/Benchmark.h>
+#include <folly/IPAddressV4.h>
+#include <folly/IPAddressV6.h>
+#include <folly/Random.h>
+#include <vector>
+#include "common/init/Init.h"
+#include "fboss/lib/RadixTree.h"
+
+using namespace folly;
+using namespace facebook::network;
+
+DEFINE_int32(route_count, 1000000, "The number of routes in each tree");
+DEFINE_int32(
+    lookup_count,
+    100000,
+    "The number of addresses to look up on each lookup iteration");
+
+namespace {
+std::vector<std::pair<IPAddressV4, uint8_t>> routes4;
+std::vector<std::pair<IPAddressV6, uint8_t>> routes6;
+std::vector<IPAddressV4> lookups4;
+std::vector<IPAddressV6> lookups6;
+
+IPAddressV6 randomV6() {
+  ByteArray16 ba;
+  *(uint64_t*)(ba.data()) = folly::Random::rand64();
+  *(uint64_t*)(&ba[8]) = folly::Random::rand64();
+  return IPAddressV6(ba);
+}
+
+template <typename TREE, typename ROUTES>
+void setupTree(TREE& tree, const ROUTES& routes) {
+  int value = 0;
+  for (const auto& [ip, mask] : routes) {
+    tree.insert(ip, mask, value++);
+  }
+}
+
+BENCHMARK(RadixTreeInsert4) {
+  RadixTree<IPAddressV4, int> rtree;
+  setupTree(rtree, routes4);
+  BENCHMARK_SUSPEND {
+    rtree.clear();
+  }
+}
+
+BENCHMARK(RadixTreeInsert6) {
+  RadixTree<IPAddressV6, int> rtree;
+  setupTree(rtree, routes6);
+  BENCHMARK_SUSPEND {
+    rtree.clear();
+  }
+}
+
+BENCHMARK(RadixTreeLongestMatch4, iters) {
+  RadixTree<IPAddressV4, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupTree(rtree, routes4);
+  }
+  while (iters--) {
+    for (const auto& ip : lookups4) {
+      doNotOptimizeAway(rtree.longestMatch(ip, 32));
+    }
+  }
+}
+
+BENCHMARK(RadixTreeLongestMatch6, iters) {
+  RadixTree<IPAddressV6, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupTree(rtree, routes6);
+  }
+  while (iters--) {
+    for (const auto& ip : lookups6) {
+      doNotOptimizeAway(rtree.longestMatch(ip, 128));
+    }
+  }
+}
+
+BENCHMARK(RadixTreeEraseInsert6) {
+  // Route churn: nodes freed by erase are reused by the next inserts
+  RadixTree<IPAddressV6, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupTree(rtree, routes6);
+  }
+  for (size_t i = 0; i < lookups6.size(); ++i) {
+    const auto& [ip, mask] = routes6[i];
+    rtree.erase(ip, mask);
+    rtree.insert(ip, mask, i);
+  }
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+  facebook::initFacebook(&argc, &argv);
+  // Route table like mask lengths: mostly /24s for v4, /48s and /64s for v6
+  for (int i = 0; i < FLAGS_route_count; ++i) {
+    uint8_t mask4 = 24 - folly::Random::rand32(8);
+    routes4.emplace_back(
+        IPAddressV4::fromLongHBO(folly::Random::rand32()).mask(mask4), mask4);
+    uint8_t mask6 = folly::Random::oneIn(2) ? 64 : 48;
+    routes6.emplace_back(randomV6().mask(mask6), mask6);
+  }
+  for (int i = 0; i < FLAGS_lookup_count; ++i) {
+    auto index = folly::Random::rand32(FLAGS_route_count);
+    lookups4.push_back(routes4[index].first);
+    lookups6.push_back(routes6[index].first);
+  }
+  runBenchmarks();
+}
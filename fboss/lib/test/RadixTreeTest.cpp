@@ -1345,6 +1345,51 @@ TEST(RadixTree, MoveConstructible) {
       accumulate(ipRtree.begin(), ipRtree.end(), 0, counterIP));
 }
 
+/*
+ * Nodes are allocated from a per tree pool. Check nodes moved between
+ * trees keep working and are freed with the delete callback of the tree
+ * they were created in.
+ */
+TEST(RadixTree, MoveBetweenPools) {
+  auto deleteCount = 0;
+  auto deleteCallback = [&](const RadixTreeNode<IPAddressV4, int>& /*node*/) {
+    ++deleteCount;
+  };
+  RadixTree<IPAddressV4, int> rtree(deleteCallback);
+  RadixTree<IPAddressV4, int> rtreeOrig;
+  setupTestTree4(rtree);
+  setupTestTree4(rtreeOrig);
+
+  RadixTree<IPAddressV4, int> moved;
+  moved.insert(IPAddressV4("10.0.0.0"), 8, 1);
+  moved = std::move(rtree);
+  EXPECT_TRUE(moved == rtreeOrig);
+  EXPECT_EQ(0, rtree.size());
+  EXPECT_EQ(0, deleteCount);
+
+  // Moved from tree is still usable
+  rtree.insert(IPAddressV4("10.0.0.0"), 8, 1);
+  EXPECT_EQ(1, rtree.size());
+
+  // Churn the moved tree, mixing nodes from both pools
+  auto erased = 0;
+  for (auto itr = rtreeOrig.begin(); itr != rtreeOrig.end(); ++itr) {
+    if (erased++ % 2) {
+      moved.erase(itr->ipAddress(), itr->masklen());
+    }
+  }
+  EXPECT_GT(deleteCount, 0);
+  for (auto itr = rtreeOrig.begin(); itr != rtreeOrig.end(); ++itr) {
+    moved.insert(itr->ipAddress(), itr->masklen(), itr->value());
+  }
+  EXPECT_TRUE(moved == rtreeOrig);
+
+  auto deleteCountBefore = deleteCount;
+  moved.clear();
+  EXPECT_GT(deleteCount, deleteCountBefore);
+  EXPECT_EQ(moved.begin(), moved.end());
+}
+
 TEST(RadixTree, Clone) {
   RadixTree<IPAddressV4, int> v4Tree;
   RadixTree<IPAddressV6, int> v6Tree;
@@ -0,0 +1,138 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <folly/Benchmark.h>
+#include <folly/IPAddressV4.h>
+#include <folly/IPAddressV6.h>
+#include <folly/Random.h>
+#include <vector>
+#include "common/init/Init.h"
+#include "fboss/lib/RadixTree.h"
+#include "fboss/lib/RcuLpmTable.h"
+
+using namespace folly;
+using namespace facebook::network;
+
+DEFINE_int32(prefix_count, 1000000, "The number of prefixes in each table");
+DEFINE_int32(
+    lookup_count,
+    100000,
+    "The number of addresses to look up on each lookup iteration");
+
+namespace {
+std::vector<std::pair<IPAddressV4, uint8_t>> prefixes4;
+std::vector<std::pair<IPAddressV6, uint8_t>> prefixes6;
+std::vector<IPAddressV4> lookups4;
+std::vector<IPAddressV6> lookups6;
+
+IPAddressV6 randomV6() {
+  ByteArray16 ba;
+  *(uint64_t*)(ba.data()) = folly::Random::rand64();
+  *(uint64_t*)(&ba[8]) = folly::Random::rand64();
+  return IPAddressV6(ba);
+}
+
+// Route table like mask lengths: mostly /24s for v4, /48s and /64s for v6
+uint8_t randomMask4() {
+  auto mask = 24 - folly::Random::rand32(3);
+  return folly::Random::oneIn(4) ? mask - folly::Random::rand32(8) : mask;
+}
+
+uint8_t randomMask6() {
+  return folly::Random::oneIn(2) ? 64 : 48 - folly::Random::rand32(16);
+}
+
+template <typename TREE, typename PREFIXES>
+void setupRadixTree(TREE& tree, const PREFIXES& prefixes) {
+  int value = 0;
+  for (const auto& [ip, mask] : prefixes) {
+    tree.insert(ip, mask, value++);
+  }
+}
+
+template <typename TABLE, typename PREFIXES>
+void setupRcuLpmTable(TABLE& table, const PREFIXES& prefixes) {
+  int value = 0;
+  for (const auto& [ip, mask] : prefixes) {
+    table.insert(ip, mask, value++);
+  }
+  table.publish();
+}
+
+BENCHMARK(RadixTreeLongestMatch4, iters) {
+  RadixTree<IPAddressV4, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupRadixTree(rtree, prefixes4);
+  }
+  while (iters--) {
+    for (const auto& ip : lookups4) {
+      doNotOptimizeAway(rtree.longestMatch(ip, 32));
+    }
+  }
+}
+
+BENCHMARK_RELATIVE(RcuLpmTableLongestMatch4, iters) {
+  RcuLpmTable<IPAddressV4, int> table;
+  BENCHMARK_SUSPEND {
+    setupRcuLpmTable(table, prefixes4);
+  }
+  while (iters--) {
+    for (const auto& ip : lookups4) {
+      doNotOptimizeAway(table.longestMatch(ip));
+    }
+  }
+}
+
+BENCHMARK(RadixTreeLongestMatch6, iters) {
+  RadixTree<IPAddressV6, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupRadixTree(rtree, prefixes6);
+  }
+  while (iters--) {
+    for (const auto& ip : lookups6) {
+      doNotOptimizeAway(rtree.longestMatch(ip, 128));
+    }
+  }
+}
+
+BENCHMARK_RELATIVE(RcuLpmTableLongestMatch6, iters) {
+  RcuLpmTable<IPAddressV6, int> table;
+  BENCHMARK_SUSPEND {
+    setupRcuLpmTable(table, prefixes6);
+  }
+  while (iters--) {
+    for (const auto& ip : lookups6) {
+      doNotOptimizeAway(table.longestMatch(ip));
+    }
+  }
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(RcuLpmTablePublish4) {
+  RcuLpmTable<IPAddressV4, int> table;
+  setupRcuLpmTable(table, prefixes4);
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+  facebook::initFacebook(&argc, &argv);
+  for (int i = 0; i < FLAGS_prefix_count; ++i) {
+    auto mask4 = randomMask4();
+    prefixes4.emplace_back(
+        IPAddressV4::fromLongHBO(folly::Random::rand32()).mask(mask4), mask4);
+    auto mask6 = randomMask6();
+    prefixes6.emplace_back(randomV6().mask(mask6), mask6);
+  }
+  // Half the lookups hit a prefix, the rest are random
+  for (int i = 0; i < FLAGS_lookup_count; ++i) {
+    if (i % 2) {
+      lookups4.push_back(IPAddressV4::fromLongHBO(folly::Random::rand32()));
+      lookups6.push_back(randomV6());
+    } else {
+      auto index = folly::Random::rand32(FLAGS_prefix_count);
+      lookups4.push_back(prefixes4[index].first);
+      lookups6.push_back(prefixes6[index].first);
+    }
+  }
+  runBenchmarks();
+}
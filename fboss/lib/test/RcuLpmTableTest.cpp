@@ -0,0 +1,124 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <gtest/gtest.h>
+
+#include <folly/IPAddressV4.h>
+#include <folly/IPAddressV6.h>
+#include <folly/Random.h>
+
+#include "fboss/lib/RadixTree.h"
+#include "fboss/lib/RcuLpmTable.h"
+
+using namespace facebook::network;
+using folly::IPAddressV4;
+using folly::IPAddressV6;
+
+namespace {
+
+template <typename IPAddrType>
+IPAddrType randomIP(std::mt19937& rng);
+
+template <>
+IPAddressV4 randomIP<IPAddressV4>(std::mt19937& rng) {
+  // Keep addresses in a small range, so prefixes overlap
+  return IPAddressV4::fromLongHBO(
+      0x0a000000 | folly::Random::rand32(1 << 16, rng));
+}
+
+template <>
+IPAddressV6 randomIP<IPAddressV6>(std::mt19937& rng) {
+  folly::ByteArray16 bytes{};
+  bytes[0] = 0x20;
+  bytes[1] = 0x01;
+  bytes[2] = folly::Random::rand32(4, rng);
+  for (size_t i = 3; i < bytes.size(); ++i) {
+    bytes[i] = folly::Random::rand32(256, rng);
+  }
+  return IPAddressV6(bytes);
+}
+
+template <typename IPAddrType>
+void checkMatches(
+    const RcuLpmTable<IPAddrType, int>& table,
+    const RadixTree<IPAddrType, int>& expected,
+    std::mt19937& rng) {
+  for (int i = 0; i < 1000; ++i) {
+    auto ip = randomIP<IPAddrType>(rng);
+    auto match = table.longestMatch(ip);
+    auto expectedMatch = expected.longestMatch(ip, IPAddrType::bitCount());
+    if (expectedMatch == expected.end()) {
+      EXPECT_FALSE(match.has_value()) << ip;
+    } else {
+      ASSERT_TRUE(match.has_value()) << ip;
+      EXPECT_EQ(*match, expectedMatch->value()) << ip;
+    }
+  }
+}
+
+template <typename IPAddrType>
+void randomUpdates() {
+  std::mt19937 rng(42);
+  RcuLpmTable<IPAddrType, int> table;
+  RadixTree<IPAddrType, int> expected;
+  std::vector<std::pair<IPAddrType, uint8_t>> prefixes;
+  auto maxMask = IPAddrType::bitCount();
+  for (int round = 0; round < 20; ++round) {
+    for (int i = 0; i < 200; ++i) {
+      if (!prefixes.empty() && folly::Random::oneIn(3, rng)) {
+        auto index = folly::Random::rand32(prefixes.size(), rng);
+        auto [ip, mask] = prefixes[index];
+        prefixes[index] = prefixes.back();
+        prefixes.pop_back();
+        table.erase(ip, mask);
+        expected.erase(ip, mask);
+        continue;
+      }
+      uint8_t mask = folly::Random::rand32(maxMask + 1, rng);
+      auto ip = randomIP<IPAddrType>(rng).mask(mask);
+      int value = folly::Random::rand32(rng);
+      table.insert(ip, mask, value);
+      if (!expected.insert(ip, mask, value).second) {
+        expected.exactMatch(ip, mask)->value() = value;
+      } else {
+        prefixes.emplace_back(ip, mask);
+      }
+    }
+    table.publish();
+    EXPECT_EQ(table.size(), expected.size());
+    checkMatches(table, expected, rng);
+  }
+}
+
+} // namespace
+
+TEST(RcuLpmTable, RandomUpdatesV4) {
+  randomUpdates<IPAddressV4>();
+}
+
+TEST(RcuLpmTable, RandomUpdatesV6) {
+  randomUpdates<IPAddressV6>();
+}
+
+TEST(RcuLpmTable, PublishMakesChangesVisible) {
+  RcuLpmTable<IPAddressV4, int> table;
+  table.insert(IPAddressV4("10.0.0.0"), 8, 1);
+  EXPECT_FALSE(table.longestMatch(IPAddressV4("10.1.1.1")).has_value());
+  table.publish();
+  EXPECT_EQ(table.longestMatch(IPAddressV4("10.1.1.1")), 1);
+
+  table.insert(IPAddressV4("10.1.0.0"), 16, 2);
+  table.insert(IPAddressV4("0.0.0.0"), 0, 3);
+  table.erase(IPAddressV4("10.0.0.0"), 8);
+  EXPECT_EQ(table.longestMatch(IPAddressV4("10.1.1.1")), 1);
+  EXPECT_FALSE(table.longestMatch(IPAddressV4("11.1.1.1")).has_value());
+  table.publish();
+  EXPECT_EQ(table.longestMatch(IPAddressV4("10.1.1.1")), 2);
+  EXPECT_EQ(table.longestMatch(IPAddressV4("10.2.1.1")), 3);
+  EXPECT_EQ(table.longestMatch(IPAddressV4("11.1.1.1")), 3);
+
+  table.erase(IPAddressV4("10.1.0.0"), 16);
+  table.erase(IPAddressV4("0.0.0.0"), 0);
+  table.publish();
+  EXPECT_EQ(table.size(), 0);
+  EXPECT_FALSE(table.longestMatch(IPAddressV4("10.1.1.1")).has_value());
+}
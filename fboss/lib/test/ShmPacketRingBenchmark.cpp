@@ -0,0 +1,69 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <folly/Benchmark.h>
+#include <folly/io/IOBuf.h>
+#include <atomic>
+#include <thread>
+#include "common/init/Init.h"
+#include "fboss/lib/ShmPacketRing.h"
+
+#include <unistd.h>
+
+using namespace facebook::fboss;
+
+DEFINE_int32(packet_size, 128, "Size of each packet, e.g. an ARP or NDP");
+DEFINE_int32(ring_bytes, 16 << 20, "Size of the ring");
+
+namespace {
+
+/*
+ * Packets moved from one thread to another through the ring, with the
+ * consumer sleeping on the doorbell whenever it catches up, as the rx and
+ * tx threads of the split agent do.
+ */
+void ringThroughput(uint32_t iters, size_t packetSize) {
+  std::unique_ptr<ShmPacketRing> producer;
+  std::unique_ptr<ShmPacketRing> consumer;
+  std::unique_ptr<folly::IOBuf> pkt;
+  BENCHMARK_SUSPEND {
+    producer = ShmPacketRing::create("bench", FLAGS_ring_bytes);
+    consumer = ShmPacketRing::attach(::getpid(), producer->fd());
+    pkt = folly::IOBuf::create(packetSize);
+    pkt->append(packetSize);
+  }
+  std::thread consumerThread([&] {
+    uint32_t received = 0;
+    while (received < iters) {
+      if (consumer->tryPop()) {
+        ++received;
+      } else {
+        consumer->wait(std::chrono::milliseconds(10));
+      }
+    }
+  });
+  ShmPacketRing::PacketInfo info;
+  info.port = 1;
+  info.vlan = 2000;
+  info.queue = 2;
+  for (uint32_t i = 0; i < iters;) {
+    if (producer->tryPush(info, *pkt)) {
+      ++i;
+    }
+  }
+  consumerThread.join();
+}
+
+BENCHMARK(ShmPacketRingThroughput, iters) {
+  ringThroughput(iters, FLAGS_packet_size);
+}
+
+BENCHMARK(ShmPacketRingThroughputJumbo, iters) {
+  ringThroughput(iters, 9000);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+}
@@ -0,0 +1,127 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <thread>
+
+#include <folly/io/IOBuf.h>
+
+#include "fboss/lib/ShmPacketRing.h"
+
+#include <unistd.h>
+
+using namespace facebook::fboss;
+
+namespace {
+
+std::unique_ptr<folly::IOBuf> makePacket(uint32_t seq, size_t length) {
+  auto buf = folly::IOBuf::create(length);
+  buf->append(length);
+  std::memset(buf->writableData(), 0xab, length);
+  std::memcpy(buf->writableData(), &seq, sizeof(seq));
+  return buf;
+}
+
+uint32_t packetSeq(const folly::IOBuf& buf) {
+  uint32_t seq;
+  std::memcpy(&seq, buf.data(), sizeof(seq));
+  return seq;
+}
+
+} // namespace
+
+TEST(ShmPacketRing, pushPop) {
+  auto producer = ShmPacketRing::create("test", 1000);
+  EXPECT_EQ(producer->capacity(), 64 << 10);
+  auto consumer = ShmPacketRing::attach(::getpid(), producer->fd());
+  EXPECT_TRUE(consumer->empty());
+  EXPECT_FALSE(consumer->tryPop());
+
+  ShmPacketRing::PacketInfo info;
+  info.port = 5;
+  info.vlan = 1;
+  info.queue = 7;
+  // A chained buffer goes in whole
+  auto pkt = makePacket(42, 60);
+  pkt->appendToChain(folly::IOBuf::copyBuffer("tail"));
+  EXPECT_TRUE(producer->tryPush(info, *pkt));
+  EXPECT_TRUE(producer->tryPush({}, *makePacket(43, 1500)));
+
+  auto first = consumer->tryPop();
+  ASSERT_TRUE(first);
+  EXPECT_EQ(first->info.port, 5);
+  EXPECT_EQ(first->info.vlan, 1);
+  EXPECT_EQ(first->info.queue, 7);
+  EXPECT_FALSE(first->info.aggPort);
+  EXPECT_EQ(first->buf->length(), 64);
+  EXPECT_EQ(packetSeq(*first->buf), 42);
+  EXPECT_EQ(std::memcmp(first->buf->data() + 60, "tail", 4), 0);
+
+  auto second = consumer->tryPop();
+  ASSERT_TRUE(second);
+  EXPECT_FALSE(second->info.port);
+  EXPECT_EQ(second->buf->length(), 1500);
+  EXPECT_EQ(packetSeq(*second->buf), 43);
+  EXPECT_FALSE(consumer->tryPop());
+  EXPECT_EQ(producer->dropped(), 0);
+}
+
+TEST(ShmPacketRing, dropWhenFull) {
+  auto producer = ShmPacketRing::create("test", 64 << 10);
+  auto consumer = ShmPacketRing::attach(::getpid(), producer->fd());
+  auto pkt = makePacket(0, 992);
+  int pushed = 0;
+  while (producer->tryPush({}, *pkt)) {
+    ++pushed;
+  }
+  EXPECT_EQ(pushed, (64 << 10) / 1024);
+  EXPECT_EQ(consumer->dropped(), 1);
+  // Larger than half the ring never fits
+  EXPECT_FALSE(producer->tryPush({}, *makePacket(0, 40 << 10)));
+  EXPECT_EQ(consumer->dropped(), 2);
+
+  for (int i = 0; i < pushed; ++i) {
+    EXPECT_TRUE(consumer->tryPop());
+  }
+  EXPECT_TRUE(consumer->empty());
+  EXPECT_TRUE(producer->tryPush({}, *pkt));
+}
+
+TEST(ShmPacketRing, attachInvalid) {
+  EXPECT_ANY_THROW(ShmPacketRing::attach(::getpid(), STDIN_FILENO));
+}
+
+TEST(ShmPacketRing, producerConsumerThreads) {
+  constexpr uint32_t kPackets = 200000;
+  auto producer = ShmPacketRing::create("test", 64 << 10);
+  auto consumer = ShmPacketRing::attach(::getpid(), producer->fd());
+
+  std::thread consumerThread([&] {
+    uint32_t expected = 0;
+    while (expected < kPackets) {
+      auto pkt = consumer->tryPop();
+      if (!pkt) {
+        consumer->wait(std::chrono::milliseconds(100));
+        continue;
+      }
+      // Varying sizes exercise wrapping around the end of the ring
+      ASSERT_EQ(packetSeq(*pkt->buf), expected);
+      ASSERT_EQ(pkt->buf->length(), 64 + expected % 1500);
+      ASSERT_EQ(pkt->info.port, expected % 512);
+      ++expected;
+    }
+  });
+
+  for (uint32_t seq = 0; seq < kPackets;) {
+    ShmPacketRing::PacketInfo info;
+    info.port = seq % 512;
+    if (producer->tryPush(info, *makePacket(seq, 64 + seq % 1500))) {
+      ++seq;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  consumerThread.join();
+  EXPECT_TRUE(consumer->empty());
+}
@@ -0,0 +1,133 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/lib/ThreadStallProfiler.h"
+#include <folly/io/async/EventBase.h>
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss;
+
+static constexpr int heartbeatInterval = 10;
+static constexpr auto stallThreshold = std::chrono::milliseconds(50);
+
+// Not static so it has a symbol we can look for in the sampled stack
+FOLLY_NOINLINE void threadStallProfilerTestStall(std::chrono::milliseconds d) {
+  /* sleep override */
+  std::this_thread::sleep_for(d);
+}
+
+class ThreadStallProfilerTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    testThread_ = std::thread([this]() { testEvb_.loopForever(); });
+    testHb_ = std::make_shared<ThreadHeartbeat>(
+        &testEvb_, "testThread", heartbeatInterval, [](int, int) {});
+  }
+
+  void TearDown() override {
+    testHb_.reset();
+    testEvb_.terminateLoopSoon();
+    testThread_.join();
+  }
+
+  void stall(std::chrono::milliseconds d) {
+    testEvb_.runInEventBaseThreadAndWait(
+        [d]() { threadStallProfilerTestStall(d); });
+  }
+
+ protected:
+  folly::EventBase testEvb_;
+  std::thread testThread_;
+  std::shared_ptr<ThreadHeartbeat> testHb_;
+};
+
+TEST_F(ThreadStallProfilerTest, noStallNoSamples) {
+  ThreadStallProfiler profiler(
+      stallThreshold, 10, std::chrono::milliseconds(heartbeatInterval));
+  profiler.startProfilingHeartbeat(testHb_);
+  profiler.start();
+  /* sleep override */
+  std::this_thread::sleep_for(stallThreshold * 4);
+  profiler.stop();
+  EXPECT_TRUE(profiler.getSamples().empty());
+}
+
+TEST_F(ThreadStallProfilerTest, stallIsSampled) {
+  ThreadStallProfiler profiler(
+      stallThreshold, 10, std::chrono::milliseconds(heartbeatInterval));
+  profiler.startProfilingHeartbeat(testHb_);
+  profiler.start();
+  stall(stallThreshold * 4);
+  profiler.stop();
+
+  auto samples = profiler.getSamples();
+  ASSERT_FALSE(samples.empty());
+  bool foundStallFrame = false;
+  for (const auto& sample : samples) {
+    EXPECT_EQ("testThread", sample.threadName);
+    EXPECT_GT(sample.lag, stallThreshold);
+    EXPECT_FALSE(sample.frames.empty());
+    for (const auto& frame : sample.frames) {
+      if (frame.find("threadStallProfilerTestStall") != std::string::npos) {
+        foundStallFrame = true;
+      }
+    }
+  }
+  EXPECT_TRUE(foundStallFrame);
+}
+
+TEST_F(ThreadStallProfilerTest, firstStallSampledOnce) {
+  ThreadStallProfiler profiler(
+      stallThreshold, 10, std::chrono::milliseconds(heartbeatInterval));
+  profiler.startProfilingHeartbeat(testHb_);
+  profiler.start();
+  // Sampled as soon as the lag passes stallThreshold, but over before it
+  // is due to be sampled again
+  stall(stallThreshold * 3 / 2);
+  profiler.stop();
+
+  auto samples = profiler.getSamples();
+  ASSERT_EQ(1, samples.size());
+  EXPECT_EQ("testThread", samples[0].threadName);
+  EXPECT_GT(samples[0].lag, stallThreshold);
+}
+
+TEST_F(ThreadStallProfilerTest, ringBufferKeepsLastSamples) {
+  ThreadStallProfiler profiler(
+      stallThreshold, 2, std::chrono::milliseconds(heartbeatInterval));
+  profiler.startProfilingHeartbeat(testHb_);
+  profiler.start();
+  // Long stalls are resampled every stallThreshold
+  stall(stallThreshold * 10);
+  profiler.stop();
+
+  auto samples = profiler.getSamples();
+  ASSERT_EQ(2, samples.size());
+  EXPECT_LE(samples[0].timestamp, samples[1].timestamp);
+  EXPECT_LT(samples[0].lag, samples[1].lag);
+}
+
+TEST_F(ThreadStallProfilerTest, pausedHeartbeatNotSampled) {
+  ThreadStallProfiler profiler(
+      stallThreshold, 10, std::chrono::milliseconds(heartbeatInterval));
+  profiler.startProfilingHeartbeat(testHb_);
+  testHb_->setMonitoringPaused(true);
+  profiler.start();
+  stall(stallThreshold * 4);
+  profiler.stop();
+  EXPECT_TRUE(profiler.getSamples().empty());
+}
+
+TEST_F(ThreadStallProfilerTest, addHeartbeatTwice) {
+  ThreadStallProfiler profiler(
+      stallThreshold, 10, std::chrono::milliseconds(heartbeatInterval));
+  profiler.startProfilingHeartbeat(testHb_);
+  EXPECT_THROW(profiler.startProfilingHeartbeat(testHb_), std::runtime_error);
+}
@@ -3,12 +3,15 @@
 #pragma once
 
 #include <map>
+#include <mutex>
 #include <optional>
 #include <string>
 
 #include "fboss/platform/platform_manager/gen-cpp2/platform_manager_config_types.h"
 
 namespace facebook::fboss::platform::platform_manager {
+// All accessors are thread safe, since PlatformExplorer explores independent
+// slots and devices concurrently.
 class DataStore {
  public:
   explicit DataStore(const PlatformConfig& config);
@@ -94,5 +97,7 @@ class DataStore {
   std::map<std::string, PmUnitInfo> slotPathToPmUnitInfo{};
 
   const PlatformConfig& platformConfig_;
+
+  mutable std::mutex mutex_;
 };
 } // namespace facebook::fboss::platform::platform_manager
@@ -49,6 +49,9 @@ uint16_t I2cExplorer::extractBusNumFromPath(const fs::path& busPath) {
 std::map<std::string, uint16_t> I2cExplorer::getBusNums(
     const std::vector<std::string>& i2cAdaptersFromCpu) {
   std::map<std::string, uint16_t> busNums;
+  if (i2cAdaptersFromCpu.empty()) {
+    return busNums;
+  }
   const auto deviceRoot = fs::path("/sys/bus/i2c/devices");
   const int maxRetries = 10;
   for (int attempt = 1; attempt <= maxRetries; attempt++) {
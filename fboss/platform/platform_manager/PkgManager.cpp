@@ -2,8 +2,17 @@
 
 #include "fboss/platform/platform_manager/PkgManager.h"
 
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <set>
+
 #include <fb303/ServiceData.h>
 #include <folly/String.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/futures/Future.h>
+#include <folly/hash/Hash.h>
 #include <folly/logging/xlog.h>
 #include <sys/utsname.h>
 
@@ -25,20 +34,48 @@ DEFINE_string(
     "",
     "Path to the local rpm file that needs to be installed on the system.");
 
+DEFINE_uint32(
+    kmod_load_threads,
+    8,
+    "Number of kernel modules without dependencies on each other to load "
+    "concurrently");
+
 namespace facebook::fboss::platform::platform_manager {
 namespace {
 constexpr auto kBspKmodsRpmName = "fboss_bsp_kmods_rpm";
 constexpr auto kBspKmodsRpmVersionCounter = "bsp_kmods_rpm_version.{}";
+constexpr auto kKmodLoadTimeMs = "kmod_load_time_ms.{}";
+constexpr auto kKmodsLoadTimeMs = "kmods_load_time_ms";
+constexpr auto kBspKmodsFingerprintPath =
+    "/var/facebook/fboss/platform_manager/bsp_kmods_fingerprint";
 
 std::string getHostKernelVersion() {
   utsname result;
   uname(&result);
   return result.release;
 }
+
+std::string getModulesDepPath() {
+  return fmt::format("/lib/modules/{}/modules.dep", getHostKernelVersion());
+}
+
+// Kmod name as modprobe and lsmod see it, e.g. kernel/drivers/foo-bar.ko.xz
+// and foo-bar are both foo_bar.
+std::string getKmodName(const std::string& moduleNameOrPath) {
+  auto name = std::filesystem::path(moduleNameOrPath).filename().string();
+  name = name.substr(0, name.find(".ko"));
+  std::replace(name.begin(), name.end(), '-', '_');
+  return name;
+}
 } // namespace
 
-PkgManager::PkgManager(const PlatformConfig& config)
-    : platformConfig_(config) {}
+PkgManager::PkgManager(
+    const PlatformConfig& config,
+    const std::shared_ptr<PlatformUtils>& platformUtils,
+    const std::shared_ptr<PlatformFsUtils>& platformFsUtils)
+    : platformConfig_(config),
+      platformUtils_(platformUtils),
+      platformFsUtils_(platformFsUtils) {}
 
 void PkgManager::processAll() const {
   loadUpstreamKmods();
@@ -73,17 +110,33 @@ void PkgManager::processAll() const {
 
 bool PkgManager::processRpms() const {
   auto bspKmodsRpmName = getKmodsRpmName();
+  // Querying dnf takes seconds, so skip it (and hence installing the rpm and
+  // running depmod) when neither the rpm nor modules.dep changed since the
+  // last successful check.
+  if (platformFsUtils_->getStringFileContent(kBspKmodsFingerprintPath) ==
+      getKmodsFingerprint()) {
+    XLOG(INFO) << fmt::format(
+        "BSP Kmods {} and modules.dep are unchanged since the last check",
+        bspKmodsRpmName);
+    return false;
+  }
+  bool newRpmInstalled{false};
   if (!isRpmInstalled(bspKmodsRpmName)) {
     XLOG(INFO) << fmt::format("Installing BSP Kmods {}", bspKmodsRpmName);
     removeOldRpms(getKmodsRpmBaseWithKernelName());
     installRpm(bspKmodsRpmName, 3 /* maxAttempts */);
     runDepmod();
-    return true;
+    kmodDepsParsed_ = false;
+    newRpmInstalled = true;
   } else {
     XLOG(INFO) << fmt::format(
         "BSP Kmods {} is already installed", bspKmodsRpmName);
-    return false;
   }
+  if (!platformFsUtils_->writeStringToFile(
+          getKmodsFingerprint(), kBspKmodsFingerprintPath, true /* atomic */)) {
+    XLOG(ERR) << "Failed to write " << kBspKmodsFingerprintPath;
+  }
+  return newRpmInstalled;
 }
 
 void PkgManager::processLocalRpms() const {
@@ -107,26 +160,143 @@ void PkgManager::processKmods() const {
 }
 
 void PkgManager::loadBSPKmods() const {
+  // Shared kmods are still all loaded before any BSP kmod, in case BSP kmods
+  // depend on them in ways modules.dep doesn't capture.
   XLOG(INFO) << fmt::format(
       "Loading {} shared kernel modules",
       platformConfig_.sharedKmodsToReload()->size());
-  for (int i = 0; i < platformConfig_.sharedKmodsToReload()->size(); ++i) {
-    loadKmod((*platformConfig_.sharedKmodsToReload())[i]);
-  }
+  loadKmods(*platformConfig_.sharedKmodsToReload());
   XLOG(INFO) << fmt::format(
       "Loading {} kernel modules", platformConfig_.bspKmodsToReload()->size());
-  for (int i = 0; i < platformConfig_.bspKmodsToReload()->size(); ++i) {
-    loadKmod((*platformConfig_.bspKmodsToReload())[i]);
-  }
+  loadKmods(*platformConfig_.bspKmodsToReload());
 }
 
 void PkgManager::loadUpstreamKmods() const {
   XLOG(INFO) << fmt::format(
       "Loading {} upstream kernel modules",
       platformConfig_.upstreamKmodsToLoad()->size());
-  for (int i = 0; i < platformConfig_.upstreamKmodsToLoad()->size(); ++i) {
-    loadKmod((*platformConfig_.upstreamKmodsToLoad())[i]);
+  loadKmods(*platformConfig_.upstreamKmodsToLoad());
+}
+
+void PkgManager::loadKmods(const std::vector<std::string>& moduleNames) const {
+  auto startTime = std::chrono::steady_clock::now();
+  auto waves = getKmodLoadWaves(moduleNames);
+  folly::CPUThreadPoolExecutor executor(std::max(FLAGS_kmod_load_threads, 1u));
+  for (size_t i = 0; i < waves.size(); ++i) {
+    XLOG(INFO) << fmt::format(
+        "Loading wave {} of kernel modules: {}",
+        i,
+        folly::join(", ", waves[i]));
+    std::vector<folly::Future<folly::Unit>> loads;
+    for (const auto& moduleName : waves[i]) {
+      loads.push_back(folly::via(
+          &executor, [this, moduleName]() { loadKmod(moduleName); }));
+    }
+    // Let the whole wave finish before surfacing the first failure.
+    for (auto& load : folly::collectAll(std::move(loads)).get()) {
+      load.value();
+    }
   }
+  auto loadTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - startTime);
+  XLOG(INFO) << fmt::format(
+      "Loaded {} kernel modules in {} waves in {}ms",
+      moduleNames.size(),
+      waves.size(),
+      loadTime.count());
+  fb303::fbData->incrementCounter(kKmodsLoadTimeMs, loadTime.count());
+}
+
+std::vector<std::vector<std::string>> PkgManager::getKmodLoadWaves(
+    const std::vector<std::string>& moduleNames) const {
+  std::vector<std::vector<std::string>> waves;
+  const auto& kmodDeps = getKmodDeps();
+  if (!kmodDeps) {
+    for (const auto& moduleName : moduleNames) {
+      waves.push_back({moduleName});
+    }
+    return waves;
+  }
+
+  std::set<std::string> requestedKmods;
+  for (const auto& moduleName : moduleNames) {
+    requestedKmods.insert(getKmodName(moduleName));
+  }
+  // modules.dep lists transitive dependencies, so a kmod's wave is one past
+  // the latest wave among the requested kmods it depends on.
+  std::map<std::string, size_t> kmodWaves;
+  std::function<size_t(const std::string&)> getWave =
+      [&](const std::string& kmod) -> size_t {
+    if (auto it = kmodWaves.find(kmod); it != kmodWaves.end()) {
+      return it->second;
+    }
+    // Guards against a cyclic modules.dep.
+    kmodWaves[kmod] = 0;
+    size_t wave = 0;
+    if (auto it = kmodDeps->find(kmod); it != kmodDeps->end()) {
+      for (const auto& dep : it->second) {
+        if (requestedKmods.contains(dep)) {
+          wave = std::max(wave, getWave(dep) + 1);
+        }
+      }
+    }
+    return kmodWaves[kmod] = wave;
+  };
+  std::set<std::string> placedKmods;
+  for (const auto& moduleName : moduleNames) {
+    auto kmod = getKmodName(moduleName);
+    if (!placedKmods.insert(kmod).second) {
+      continue;
+    }
+    auto wave = getWave(kmod);
+    if (waves.size() <= wave) {
+      waves.resize(wave + 1);
+    }
+    waves[wave].push_back(moduleName);
+  }
+  return waves;
+}
+
+const std::optional<std::map<std::string, std::vector<std::string>>>&
+PkgManager::getKmodDeps() const {
+  if (kmodDepsParsed_) {
+    return kmodDeps_;
+  }
+  kmodDepsParsed_ = true;
+  auto modulesDep = platformFsUtils_->getStringFileContent(getModulesDepPath());
+  if (!modulesDep) {
+    XLOG(WARNING) << fmt::format(
+        "Could not read {}. Loading kernel modules one at a time",
+        getModulesDepPath());
+    kmodDeps_ = std::nullopt;
+    return kmodDeps_;
+  }
+  kmodDeps_.emplace();
+  std::vector<folly::StringPiece> lines;
+  folly::split('\n', *modulesDep, lines, true);
+  for (const auto& line : lines) {
+    // kernel/drivers/foo.ko.xz: kernel/drivers/bar.ko.xz ...
+    auto colon = line.find(':');
+    if (colon == folly::StringPiece::npos) {
+      continue;
+    }
+    std::vector<std::string> deps;
+    folly::split(' ', line.subpiece(colon + 1), deps, true);
+    auto& kmodDeps = (*kmodDeps_)[getKmodName(line.subpiece(0, colon).str())];
+    for (const auto& dep : deps) {
+      kmodDeps.push_back(getKmodName(dep));
+    }
+  }
+  return kmodDeps_;
+}
+
+std::string PkgManager::getKmodsFingerprint() const {
+  return fmt::format(
+      "{} {:016x}",
+      getKmodsRpmName(),
+      folly::hash::fnv64(
+          platformFsUtils_->getStringFileContent(getModulesDepPath())
+              .value_or("")));
 }
 
 bool PkgManager::isRpmInstalled(const std::string& rpmFullName) const {
@@ -134,7 +304,7 @@ bool PkgManager::isRpmInstalled(const std::string& rpmFullName) const {
       "Checking whether BSP Kmods {} is installed", rpmFullName);
   auto cmd = fmt::format("dnf list {} --installed", rpmFullName);
   XLOG(INFO) << fmt::format("Running command ({})", cmd);
-  auto [exitStatus, standardOut] = PlatformUtils().execCommand(cmd);
+  auto [exitStatus, standardOut] = platformUtils_->execCommand(cmd);
   return exitStatus == 0;
 }
 
@@ -146,7 +316,7 @@ void PkgManager::installRpm(const std::string& rpmFullName, int maxAttempts)
   do {
     XLOG(INFO) << fmt::format(
         "Running command ({}); Attempt: {}", cmd, attempt++);
-    std::tie(exitStatus, standardOut) = PlatformUtils().execCommand(cmd);
+    std::tie(exitStatus, standardOut) = platformUtils_->execCommand(cmd);
     XLOG(INFO) << standardOut;
   } while (attempt <= maxAttempts && exitStatus != 0);
   if (exitStatus != 0) {
@@ -164,7 +334,7 @@ void PkgManager::removeOldRpms(const std::string& rpmBaseName) const {
   int exitStatus{0};
   auto getInstalledRpmNamesCmd = fmt::format("rpm -qa | grep ^{}", rpmBaseName);
   std::tie(exitStatus, stdOut) =
-      PlatformUtils().execCommand(getInstalledRpmNamesCmd);
+      platformUtils_->execCommand(getInstalledRpmNamesCmd);
   if (exitStatus) {
     XLOG(INFO) << "No old rpms to remove";
     return;
@@ -176,7 +346,7 @@ void PkgManager::removeOldRpms(const std::string& rpmBaseName) const {
       "Removing old rpms: {}", folly::join(", ", installedRpms));
   auto removeOldRpmsCmd =
       fmt::format("rpm -e --allmatches {}", folly::join(" ", installedRpms));
-  std::tie(exitStatus, stdOut) = PlatformUtils().execCommand(removeOldRpmsCmd);
+  std::tie(exitStatus, stdOut) = platformUtils_->execCommand(removeOldRpmsCmd);
   if (exitStatus) {
     XLOG(ERR) << fmt::format(
         "Command ({}) failed with exit code {}", removeOldRpmsCmd, exitStatus);
@@ -192,7 +362,7 @@ void PkgManager::runDepmod() const {
   std::string standardOut{};
   auto depmodCmd = "depmod -a";
   XLOG(INFO) << fmt::format("Running command ({})", depmodCmd);
-  std::tie(exitStatus, standardOut) = PlatformUtils().execCommand(depmodCmd);
+  std::tie(exitStatus, standardOut) = platformUtils_->execCommand(depmodCmd);
   if (exitStatus != 0) {
     XLOG(ERR) << fmt::format(
         "Command ({}) failed with exit code {}", depmodCmd, exitStatus);
@@ -206,7 +376,7 @@ void PkgManager::installLocalRpm(int maxAttempts) const {
   do {
     XLOG(INFO) << fmt::format(
         "Running command ({}); Attempt: {}", cmd, attempt++);
-    std::tie(exitStatus, standardOut) = PlatformUtils().execCommand(cmd);
+    std::tie(exitStatus, standardOut) = platformUtils_->execCommand(cmd);
     XLOG(INFO) << standardOut;
   } while (attempt <= maxAttempts && exitStatus != 0);
   if (exitStatus != 0) {
@@ -217,6 +387,9 @@ void PkgManager::installLocalRpm(int maxAttempts) const {
         FLAGS_local_rpm_path,
         exitStatus));
   }
+  kmodDepsParsed_ = false;
+  // The next boot without a local rpm must check the BSP rpm again.
+  platformFsUtils_->writeStringToFile("", kBspKmodsFingerprintPath);
 }
 
 void PkgManager::unloadKmod(const std::string& moduleName) const {
@@ -224,7 +397,7 @@ void PkgManager::unloadKmod(const std::string& moduleName) const {
   std::string standardOut{};
   auto unloadCmd = fmt::format("modprobe --remove {}", moduleName);
   XLOG(INFO) << fmt::format("Running command ({})", unloadCmd);
-  std::tie(exitStatus, standardOut) = PlatformUtils().execCommand(unloadCmd);
+  std::tie(exitStatus, standardOut) = platformUtils_->execCommand(unloadCmd);
   if (exitStatus != 0) {
     XLOG(ERR) << fmt::format(
         "Command ({}) failed with exit code {}", unloadCmd, exitStatus);
@@ -240,7 +413,13 @@ void PkgManager::loadKmod(const std::string& moduleName) const {
   std::string standardOut{};
   auto loadCmd = fmt::format("modprobe {}", moduleName);
   XLOG(INFO) << fmt::format("Running command ({})", loadCmd);
-  std::tie(exitStatus, standardOut) = PlatformUtils().execCommand(loadCmd);
+  auto startTime = std::chrono::steady_clock::now();
+  std::tie(exitStatus, standardOut) = platformUtils_->execCommand(loadCmd);
+  fb303::fbData->setCounter(
+      fmt::format(kKmodLoadTimeMs, moduleName),
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - startTime)
+          .count());
   if (exitStatus != 0) {
     XLOG(ERR) << fmt::format(
         "Command ({}) failed with exit code {}", loadCmd, exitStatus);
@@ -2,6 +2,14 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "fboss/platform/helpers/PlatformFsUtils.h"
+#include "fboss/platform/helpers/PlatformUtils.h"
 #include "fboss/platform/platform_manager/gen-cpp2/platform_manager_config_types.h"
 
 DECLARE_bool(enable_pkg_mgmnt);
@@ -12,7 +20,12 @@ namespace facebook::fboss::platform::platform_manager {
 
 class PkgManager {
  public:
-  explicit PkgManager(const PlatformConfig& config);
+  explicit PkgManager(
+      const PlatformConfig& config,
+      const std::shared_ptr<PlatformUtils>& platformUtils =
+          std::make_shared<PlatformUtils>(),
+      const std::shared_ptr<PlatformFsUtils>& platformFsUtils =
+          std::make_shared<PlatformFsUtils>());
   virtual ~PkgManager() = default;
   void processAll() const;
   // Returns true if the rpm is newly installed, false otherwise.
@@ -23,8 +36,18 @@ class PkgManager {
   virtual void loadUpstreamKmods() const;
   std::string getKmodsRpmName() const;
   std::string getKmodsRpmBaseWithKernelName() const;
+  // Fingerprint of the installed BSP kmods: the rpm name and a hash of the
+  // running kernel's modules.dep.
+  std::string getKmodsFingerprint() const;
+  // Group the given kmods into waves which can be loaded concurrently. Each
+  // kmod only depends, per modules.dep, on kmods of earlier waves. Kmods not
+  // found in modules.dep go in the first wave. Without a modules.dep, every
+  // kmod gets its own wave.
+  std::vector<std::vector<std::string>> getKmodLoadWaves(
+      const std::vector<std::string>& moduleNames) const;
 
  private:
+  void loadKmods(const std::vector<std::string>& moduleNames) const;
   void loadKmod(const std::string& moduleName) const;
   void unloadKmod(const std::string& moduleName) const;
   bool isRpmInstalled(const std::string& rpmFullName) const;
@@ -33,7 +56,17 @@ class PkgManager {
   void runDepmod() const;
   void installLocalRpm(int maxAttempts) const;
 
+  // Map from kmod name to the kmods it depends on, parsed from modules.dep
+  // on first use. std::nullopt if modules.dep could not be read.
+  const std::optional<std::map<std::string, std::vector<std::string>>>&
+  getKmodDeps() const;
+
   const PlatformConfig& platformConfig_;
+  const std::shared_ptr<PlatformUtils> platformUtils_;
+  const std::shared_ptr<PlatformFsUtils> platformFsUtils_;
+  mutable bool kmodDepsParsed_{false};
+  mutable std::optional<std::map<std::string, std::vector<std::string>>>
+      kmodDeps_;
 };
 
 } // namespace facebook::fboss::platform::platform_manager
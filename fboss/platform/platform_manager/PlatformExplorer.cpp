@@ -3,10 +3,12 @@
 #include "fboss/platform/platform_manager/PlatformExplorer.h"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <exception>
 #include <filesystem>
 #include <ranges>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -14,7 +16,9 @@
 #include <fb303/ServiceData.h>
 #include <folly/FileUtil.h>
 #include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
 #include <re2/re2.h>
+#include <thrift/lib/cpp/util/EnumUtils.h>
 
 #include "fboss/platform/helpers/PlatformFsUtils.h"
 #include "fboss/platform/helpers/PlatformUtils.h"
@@ -22,10 +26,21 @@
 #include "fboss/platform/platform_manager/gen-cpp2/platform_manager_config_constants.h"
 #include "fboss/platform/weutil/IoctlSmbusEepromReader.h"
 
+DEFINE_uint32(
+    explore_threads,
+    8,
+    "Number of threads exploring independent slots, PCI devices and I2C "
+    "buses concurrently. 1 explores the platform one node at a time.");
+
 namespace facebook::fboss::platform::platform_manager {
 namespace {
 constexpr auto kTotalFailures = "platform_explorer.total_failures";
 constexpr auto kExplorationFail = "platform_explorer.exploration_fail";
+constexpr auto kExplorationTimeMs = "platform_explorer.exploration_time_ms";
+constexpr auto kExplorationNodeTimeMs =
+    "platform_explorer.exploration_node_time_ms";
+constexpr auto kExplorationCriticalPathTimeMs =
+    "platform_explorer.exploration_critical_path_time_ms";
 constexpr auto kRootSlotPath = "/";
 
 std::string getSlotPath(
@@ -127,13 +142,31 @@ PlatformManagerStatus createPmStatus(
 
 namespace constants = platform_manager_config_constants;
 
+// Exploration graph of one PmUnit. Its PCI devices and I2C buses are nodes;
+// each I2C bus waits on the PCI device or mux (i.e. the bus of the mux)
+// creating it, if any is part of this PmUnit.
+struct PlatformExplorer::PmUnitExploration {
+  std::string slotPath;
+  PmUnitConfig pmUnitConfig;
+  // I2C devices grouped by the bus they sit on, in config order.
+  std::map<std::string, std::vector<I2cDeviceConfig>> i2cDevicesByBus;
+  // I2C buses to explore once the given PCI device or I2C bus is explored.
+  std::vector<std::vector<std::string>> pciDeviceDependents;
+  std::map<std::string, std::vector<std::string>> i2cBusDependents;
+  // PCI device and I2C bus nodes yet to complete.
+  std::atomic<size_t> remainingNodes{0};
+};
+
 PlatformExplorer::PlatformExplorer(
     const PlatformConfig& config,
     const std::shared_ptr<PlatformFsUtils> platformFsUtils)
     : platformConfig_(config),
       dataStore_(platformConfig_),
       devicePathResolver_(dataStore_),
-      presenceChecker_(devicePathResolver_),
+      presenceChecker_(
+          devicePathResolver_,
+          std::make_shared<Utils>(),
+          platformFsUtils),
       explorationErrMap_(platformConfig_, dataStore_),
       platformFsUtils_(platformFsUtils) {
   updatePmStatus(createPmStatus(ExplorationStatus::UNSTARTED));
@@ -142,6 +175,14 @@ PlatformExplorer::PlatformExplorer(
 void PlatformExplorer::explore() {
   XLOG(INFO) << "Exploring the platform";
   updatePmStatus(createPmStatus(ExplorationStatus::IN_PROGRESS));
+  {
+    std::lock_guard<std::mutex> lock(explorationMutex_);
+    explorationStartTime_ = std::chrono::steady_clock::now();
+    explorationNodes_.clear();
+    explorationError_ = nullptr;
+    explorationExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        std::max(FLAGS_explore_threads, 1u));
+  }
   for (const auto& [busName, busNum] :
        i2cExplorer_.getBusNums(*platformConfig_.i2cAdaptersFromCpu())) {
     dataStore_.updateI2cBusNum(std::nullopt, busName, busNum);
@@ -149,7 +190,13 @@ void PlatformExplorer::explore() {
   auto pmUnitName =
       getPmUnitNameFromSlot(*platformConfig_.rootSlotType(), kRootSlotPath);
   CHECK(pmUnitName == *platformConfig_.rootPmUnitName());
-  explorePmUnit(kRootSlotPath, *platformConfig_.rootPmUnitName());
+  scheduleNode(
+      fmt::format("PmUnit {} at {}", *pmUnitName, kRootSlotPath),
+      std::nullopt,
+      [this, pmUnitName = *pmUnitName](size_t nodeId) {
+        explorePmUnit(kRootSlotPath, pmUnitName, nodeId);
+      });
+  waitForExploration();
   XLOG(INFO) << "Creating symbolic links ...";
   for (const auto& [linkPath, devicePath] :
        *platformConfig_.symbolicLinkToDevicePath()) {
@@ -157,6 +204,7 @@ void PlatformExplorer::explore() {
   }
   publishFirmwareVersions();
   auto explorationStatus = concludeExploration();
+  reportExplorationSummary(explorationStatus);
   fb303::fbData->setCounter(
       kExplorationFail,
       explorationStatus != ExplorationStatus::SUCCEEDED &&
@@ -169,26 +217,72 @@ void PlatformExplorer::explore() {
           .count()));
 }
 
+void PlatformExplorer::scheduleNode(
+    std::string name,
+    std::optional<size_t> predecessor,
+    folly::Function<void(size_t)> fn) {
+  std::lock_guard<std::mutex> lock(explorationMutex_);
+  auto nodeId = explorationNodes_.size();
+  explorationNodes_.push_back(
+      ExplorationNode{std::move(name), {}, {}, predecessor});
+  ++pendingExplorationNodes_;
+  explorationExecutor_->add([this, nodeId, fn = std::move(fn)]() mutable {
+    auto elapsed = [this]() {
+      return std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - explorationStartTime_);
+    };
+    auto startTime = elapsed();
+    std::exception_ptr error;
+    // Catch everything, as a node which doesn't complete leaves
+    // waitForExploration() waiting forever.
+    try {
+      fn(nodeId);
+    } catch (const std::exception& ex) {
+      XLOG(ERR) << "Exploration failed: " << ex.what();
+      error = std::current_exception();
+    } catch (...) {
+      XLOG(ERR) << "Exploration failed with an unknown exception";
+      error = std::current_exception();
+    }
+    auto endTime = elapsed();
+    std::lock_guard<std::mutex> nodeLock(explorationMutex_);
+    explorationNodes_[nodeId].startTime = startTime;
+    explorationNodes_[nodeId].endTime = endTime;
+    if (error && !explorationError_) {
+      explorationError_ = error;
+    }
+    // Nodes schedule their successors before completing, so the graph is
+    // only done once nothing is pending.
+    if (--pendingExplorationNodes_ == 0) {
+      explorationDone_.notify_all();
+    }
+  });
+}
+
+void PlatformExplorer::waitForExploration() {
+  std::unique_lock<std::mutex> lock(explorationMutex_);
+  explorationDone_.wait(lock, [this]() {
+    return pendingExplorationNodes_ == 0;
+  });
+  auto executor = std::move(explorationExecutor_);
+  auto error = explorationError_;
+  lock.unlock();
+  executor->join();
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
 void PlatformExplorer::explorePmUnit(
     const std::string& slotPath,
-    const std::string& pmUnitName) {
-  auto pmUnitConfig = dataStore_.resolvePmUnitConfig(slotPath);
+    const std::string& pmUnitName,
+    size_t nodeId) {
+  auto pmUnit = std::make_shared<PmUnitExploration>();
+  pmUnit->slotPath = slotPath;
+  pmUnit->pmUnitConfig = dataStore_.resolvePmUnitConfig(slotPath);
+  const auto& pmUnitConfig = pmUnit->pmUnitConfig;
   XLOG(INFO) << fmt::format("Exploring PmUnit {} at {}", pmUnitName, slotPath);
 
-  XLOG(INFO) << fmt::format(
-      "Exploring PCI Devices for PmUnit {} at SlotPath {}. Count {}",
-      pmUnitName,
-      slotPath,
-      pmUnitConfig.pciDeviceConfigs()->size());
-  explorePciDevices(slotPath, *pmUnitConfig.pciDeviceConfigs());
-
-  XLOG(INFO) << fmt::format(
-      "Exploring I2C Devices for PmUnit {} at SlotPath {}. Count {}",
-      pmUnitName,
-      slotPath,
-      pmUnitConfig.i2cDeviceConfigs()->size());
-  exploreI2cDevices(slotPath, *pmUnitConfig.i2cDeviceConfigs());
-
   if (!pmUnitConfig.embeddedSensorConfigs()->empty()) {
     XLOG(INFO) << fmt::format(
         "Processing Embedded Sensors for PmUnit {} at SlotPath {}. Count {}",
@@ -205,20 +299,181 @@ void PlatformExplorer::explorePmUnit(
   }
 
   XLOG(INFO) << fmt::format(
-      "Exploring Slots for PmUnit {} at SlotPath {}. Count {}",
+      "Exploring PCI Devices for PmUnit {} at SlotPath {}. Count {}",
       pmUnitName,
       slotPath,
-      pmUnitConfig.outgoingSlotConfigs_ref()->size());
+      pmUnitConfig.pciDeviceConfigs()->size());
+  XLOG(INFO) << fmt::format(
+      "Exploring I2C Devices for PmUnit {} at SlotPath {}. Count {}",
+      pmUnitName,
+      slotPath,
+      pmUnitConfig.i2cDeviceConfigs()->size());
+
+  // Find which PCI device or I2C bus (of a mux) creates each bus.
+  std::map<std::string, size_t> busToPciDevice;
+  const auto& pciDeviceConfigs = *pmUnitConfig.pciDeviceConfigs();
+  for (size_t i = 0; i < pciDeviceConfigs.size(); i++) {
+    for (const auto& i2cAdapterConfig :
+         *pciDeviceConfigs[i].i2cAdapterConfigs()) {
+      const auto& busName =
+          *i2cAdapterConfig.fpgaIpBlockConfig()->pmUnitScopedName();
+      if (*i2cAdapterConfig.numberOfAdapters() > 1) {
+        for (auto j = 0; j < *i2cAdapterConfig.numberOfAdapters(); j++) {
+          busToPciDevice[fmt::format("{}@{}", busName, j)] = i;
+        }
+      } else {
+        busToPciDevice[busName] = i;
+      }
+    }
+  }
+  std::vector<std::string> busNames;
+  std::map<std::string, std::string> busToMuxBus;
+  for (const auto& i2cDeviceConfig : *pmUnitConfig.i2cDeviceConfigs()) {
+    const auto& busName = *i2cDeviceConfig.busName();
+    if (!pmUnit->i2cDevicesByBus.contains(busName)) {
+      busNames.push_back(busName);
+    }
+    pmUnit->i2cDevicesByBus[busName].push_back(i2cDeviceConfig);
+    if (auto numChannels = i2cDeviceConfig.numOutgoingChannels()) {
+      for (auto channel = 0; channel < *numChannels; channel++) {
+        busToMuxBus[fmt::format(
+            "{}@{}", *i2cDeviceConfig.pmUnitScopedName(), channel)] = busName;
+      }
+    }
+  }
+
+  // Build the graph, only keeping edges reachable from the nodes which are
+  // ready now. Anything else (e.g. a mux behind its own channel in a broken
+  // config) is explored right away and fails the same way it would serially.
+  pmUnit->pciDeviceDependents.resize(pciDeviceConfigs.size());
+  std::vector<std::string> readyBuses;
+  std::set<std::string> reachedBuses;
+  auto addDependent = [&](const std::string& busName) {
+    if (auto it = busToPciDevice.find(busName); it != busToPciDevice.end()) {
+      pmUnit->pciDeviceDependents[it->second].push_back(busName);
+    } else if (auto muxIt = busToMuxBus.find(busName);
+               muxIt != busToMuxBus.end() &&
+               reachedBuses.contains(muxIt->second)) {
+      pmUnit->i2cBusDependents[muxIt->second].push_back(busName);
+    } else {
+      return false;
+    }
+    reachedBuses.insert(busName);
+    return true;
+  };
+  for (const auto& busName : busNames) {
+    if (!busToMuxBus.contains(busName) || busToPciDevice.contains(busName)) {
+      if (!addDependent(busName)) {
+        readyBuses.push_back(busName);
+        reachedBuses.insert(busName);
+      }
+    }
+  }
+  bool added = true;
+  while (added) {
+    added = false;
+    for (const auto& busName : busNames) {
+      if (!reachedBuses.contains(busName) && addDependent(busName)) {
+        added = true;
+      }
+    }
+  }
+  for (const auto& busName : busNames) {
+    if (!reachedBuses.contains(busName)) {
+      readyBuses.push_back(busName);
+    }
+  }
+
+  pmUnit->remainingNodes = pciDeviceConfigs.size() + busNames.size();
+  if (pmUnit->remainingNodes == 0) {
+    scheduleSlots(slotPath, pmUnitConfig, nodeId);
+    return;
+  }
+  for (size_t i = 0; i < pciDeviceConfigs.size(); i++) {
+    // Assign FPGA instance ids in config order before the devices race.
+    getFpgaInstanceId(slotPath, *pciDeviceConfigs[i].pmUnitScopedName());
+    schedulePciDevice(pmUnit, i, nodeId);
+  }
+  for (const auto& busName : readyBuses) {
+    scheduleI2cBus(pmUnit, busName, nodeId);
+  }
+}
+
+void PlatformExplorer::schedulePciDevice(
+    const std::shared_ptr<PmUnitExploration>& pmUnit,
+    size_t pciDeviceIdx,
+    size_t predecessor) {
+  const auto& pciDeviceConfig =
+      pmUnit->pmUnitConfig.pciDeviceConfigs()->at(pciDeviceIdx);
+  scheduleNode(
+      fmt::format(
+          "PCI device {}",
+          Utils().createDevicePath(
+              pmUnit->slotPath, *pciDeviceConfig.pmUnitScopedName())),
+      predecessor,
+      [this, pmUnit, pciDeviceIdx](size_t nodeId) {
+        explorePciDevices(
+            pmUnit->slotPath,
+            {pmUnit->pmUnitConfig.pciDeviceConfigs()->at(pciDeviceIdx)});
+        for (const auto& busName : pmUnit->pciDeviceDependents[pciDeviceIdx]) {
+          scheduleI2cBus(pmUnit, busName, nodeId);
+        }
+        finishPmUnitNode(pmUnit, nodeId);
+      });
+}
+
+void PlatformExplorer::scheduleI2cBus(
+    const std::shared_ptr<PmUnitExploration>& pmUnit,
+    const std::string& busName,
+    size_t predecessor) {
+  scheduleNode(
+      fmt::format("I2C bus {} at {}", busName, pmUnit->slotPath),
+      predecessor,
+      [this, pmUnit, busName](size_t nodeId) {
+        exploreI2cDevices(
+            pmUnit->slotPath, pmUnit->i2cDevicesByBus.at(busName));
+        if (auto it = pmUnit->i2cBusDependents.find(busName);
+            it != pmUnit->i2cBusDependents.end()) {
+          for (const auto& dependentBusName : it->second) {
+            scheduleI2cBus(pmUnit, dependentBusName, nodeId);
+          }
+        }
+        finishPmUnitNode(pmUnit, nodeId);
+      });
+}
+
+void PlatformExplorer::finishPmUnitNode(
+    const std::shared_ptr<PmUnitExploration>& pmUnit,
+    size_t nodeId) {
+  if (--pmUnit->remainingNodes == 0) {
+    scheduleSlots(pmUnit->slotPath, pmUnit->pmUnitConfig, nodeId);
+  }
+}
+
+void PlatformExplorer::scheduleSlots(
+    const std::string& slotPath,
+    const PmUnitConfig& pmUnitConfig,
+    size_t predecessor) {
+  XLOG(INFO) << fmt::format(
+      "Exploring Slots for PmUnit at SlotPath {}. Count {}",
+      slotPath,
+      pmUnitConfig.outgoingSlotConfigs()->size());
   for (const auto& [slotName, slotConfig] :
        *pmUnitConfig.outgoingSlotConfigs()) {
-    exploreSlot(slotPath, slotName, slotConfig);
+    scheduleNode(
+        fmt::format("Slot {}", getSlotPath(slotPath, slotName)),
+        predecessor,
+        [this, slotPath, slotName, slotConfig](size_t nodeId) {
+          exploreSlot(slotPath, slotName, slotConfig, nodeId);
+        });
   }
 }
 
 void PlatformExplorer::exploreSlot(
     const std::string& parentSlotPath,
     const std::string& slotName,
-    const SlotConfig& slotConfig) {
+    const SlotConfig& slotConfig,
+    size_t nodeId) {
   std::string childSlotPath = getSlotPath(parentSlotPath, slotName);
   XLOG(INFO) << fmt::format("Exploring SlotPath {}", childSlotPath);
 
@@ -256,7 +511,13 @@ void PlatformExplorer::exploreSlot(
     return;
   }
 
-  explorePmUnit(childSlotPath, *childPmUnitName);
+  scheduleNode(
+      fmt::format("PmUnit {} at {}", *childPmUnitName, childSlotPath),
+      nodeId,
+      [this, childSlotPath, childPmUnitName = *childPmUnitName](
+          size_t childNodeId) {
+        explorePmUnit(childSlotPath, childPmUnitName, childNodeId);
+      });
 }
 
 std::optional<std::string> PlatformExplorer::getPmUnitNameFromSlot(
@@ -553,11 +814,13 @@ uint32_t PlatformExplorer::getFpgaInstanceId(
     const std::string& slotPath,
     const std::string& fpgaName) {
   auto key = std::make_pair(slotPath, fpgaName);
-  auto it = fpgaInstanceIds_.find(key);
-  if (it == fpgaInstanceIds_.end()) {
-    fpgaInstanceIds_[key] = 1000 * (fpgaInstanceIds_.size() + 1);
+  auto fpgaInstanceIds = fpgaInstanceIds_.wlock();
+  auto it = fpgaInstanceIds->find(key);
+  if (it == fpgaInstanceIds->end()) {
+    it = fpgaInstanceIds->emplace(key, 1000 * (fpgaInstanceIds->size() + 1))
+             .first;
   }
-  return fpgaInstanceIds_[key];
+  return it->second;
 }
 
 void PlatformExplorer::createDeviceSymLink(
@@ -698,6 +961,67 @@ void PlatformExplorer::publishFirmwareVersions() {
   }
 }
 
+void PlatformExplorer::reportExplorationSummary(ExplorationStatus finalStatus) {
+  auto toMs = [](std::chrono::microseconds time) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(time).count();
+  };
+  std::chrono::microseconds explorationTime{0};
+  std::chrono::microseconds nodeTime{0};
+  size_t numNodes = 0;
+  {
+    std::lock_guard<std::mutex> lock(explorationMutex_);
+    numNodes = explorationNodes_.size();
+    for (const auto& node : explorationNodes_) {
+      explorationTime = std::max(explorationTime, node.endTime);
+      nodeTime += node.endTime - node.startTime;
+    }
+  }
+  auto criticalPath = getExplorationCriticalPath();
+  XLOG(INFO) << fmt::format(
+      "Exploration {} in {}ms across {} nodes. Exploring them one at a time "
+      "would have taken {}ms",
+      apache::thrift::util::enumNameSafe(finalStatus),
+      toMs(explorationTime),
+      numNodes,
+      toMs(nodeTime));
+  XLOG(INFO) << "Exploration critical path:";
+  std::chrono::microseconds criticalPathTime{0};
+  for (const auto& node : criticalPath) {
+    criticalPathTime += node.endTime - node.startTime;
+    XLOG(INFO) << fmt::format(
+        "  {}: {}ms (started at {}ms)",
+        node.name,
+        toMs(node.endTime - node.startTime),
+        toMs(node.startTime));
+  }
+  fb303::fbData->setCounter(kExplorationTimeMs, toMs(explorationTime));
+  fb303::fbData->setCounter(kExplorationNodeTimeMs, toMs(nodeTime));
+  fb303::fbData->setCounter(
+      kExplorationCriticalPathTimeMs, toMs(criticalPathTime));
+}
+
+std::vector<ExplorationNode> PlatformExplorer::getExplorationCriticalPath()
+    const {
+  std::lock_guard<std::mutex> lock(explorationMutex_);
+  if (explorationNodes_.empty()) {
+    return {};
+  }
+  auto last = std::max_element(
+      explorationNodes_.begin(),
+      explorationNodes_.end(),
+      [](const auto& lhs, const auto& rhs) {
+        return lhs.endTime < rhs.endTime;
+      });
+  std::vector<ExplorationNode> criticalPath;
+  std::optional<size_t> nodeId = last - explorationNodes_.begin();
+  while (nodeId) {
+    criticalPath.push_back(explorationNodes_[*nodeId]);
+    nodeId = explorationNodes_[*nodeId].predecessor;
+  }
+  std::reverse(criticalPath.begin(), criticalPath.end());
+  return criticalPath;
+}
+
 PlatformManagerStatus PlatformExplorer::getPMStatus() const {
   return platformManagerStatus_.copy();
 }
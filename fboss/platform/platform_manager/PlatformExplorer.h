@@ -3,8 +3,18 @@
 
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
+#include <exception>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <vector>
+
+#include <folly/Function.h>
+#include <folly/Synchronized.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 
 #include "fboss/platform/helpers/PlatformFsUtils.h"
 #include "fboss/platform/platform_manager/DataStore.h"
@@ -18,6 +28,17 @@
 #include "fboss/platform/weutil/CachedFbossEepromParser.h"
 
 namespace facebook::fboss::platform::platform_manager {
+
+// A node of the exploration graph: a PmUnit, a slot, a PCI device or the I2C
+// devices on one bus. Times are relative to the start of the exploration.
+struct ExplorationNode {
+  std::string name;
+  std::chrono::microseconds startTime{0};
+  std::chrono::microseconds endTime{0};
+  // The node whose completion made this node ready to run.
+  std::optional<size_t> predecessor;
+};
+
 class PlatformExplorer {
  public:
   // Regex patterns for matching fw_ver format.
@@ -39,20 +60,30 @@ class PlatformExplorer {
 
   virtual ~PlatformExplorer() = default;
 
-  // Explore the platform.
+  // Explore the platform. Independent slots, PCI devices and I2C buses are
+  // explored concurrently as nodes of a dependency graph:
+  // - A PmUnit's PCI devices, and its I2C buses which are not created by
+  //   one of its own devices, are explored as soon as the PmUnit is known.
+  // - An I2C bus created by a PCI device or a mux is explored once that
+  //   device has been. Devices on the same bus are created in config order.
+  // - A PmUnit's outgoing slots are explored once all its devices have been,
+  //   and each slot then explores the PmUnit plugged into it.
   void explore();
 
-  // Explore the PmUnit present at the given slotPath.
+  // Explore the PmUnit present at the given slotPath, as node `nodeId` of the
+  // exploration graph.
   void explorePmUnit(
       const std::string& slotPath,
-      const std::string& pmUnitName);
+      const std::string& pmUnitName,
+      size_t nodeId);
 
   // Explore the slotName which is located at a PmUnit in the given
-  // parentSlotPath.
+  // parentSlotPath, as node `nodeId` of the exploration graph.
   void exploreSlot(
       const std::string& parentSlotPath,
       const std::string& slotName,
-      const SlotConfig& slotConfig);
+      const SlotConfig& slotConfig,
+      size_t nodeId);
 
   // Get the PmUnit name which has been plugged in at the given slotPath,
   // and the slot is of given slotType.
@@ -87,6 +118,10 @@ class PlatformExplorer {
   // throws if no PmUnit found at the SlotPath.
   PmUnitInfo getPmUnitInfo(const std::string& slotPath) const;
 
+  // Get the chain of nodes which determined how long the last exploration
+  // took, from the root PmUnit to the last node to complete.
+  std::vector<ExplorationNode> getExplorationCriticalPath() const;
+
  protected:
   virtual void updatePmStatus(const PlatformManagerStatus& newStatus);
   // A thrift struct which contains the status of PM exploration.
@@ -95,6 +130,34 @@ class PlatformExplorer {
   folly::Synchronized<PlatformManagerStatus> platformManagerStatus_;
 
  private:
+  struct PmUnitExploration;
+
+  // Run `fn` as a new node of the exploration graph. `predecessor` is the
+  // node whose completion made it ready to run.
+  void scheduleNode(
+      std::string name,
+      std::optional<size_t> predecessor,
+      folly::Function<void(size_t)> fn);
+  // Block until every node of the exploration graph has run. Rethrows the
+  // first exception which escaped a node.
+  void waitForExploration();
+  void schedulePciDevice(
+      const std::shared_ptr<PmUnitExploration>& pmUnit,
+      size_t pciDeviceIdx,
+      size_t predecessor);
+  void scheduleI2cBus(
+      const std::shared_ptr<PmUnitExploration>& pmUnit,
+      const std::string& busName,
+      size_t predecessor);
+  // Called as each PCI device or I2C bus node of a PmUnit completes. Once all
+  // of them have, schedules the PmUnit's outgoing slots.
+  void finishPmUnitNode(
+      const std::shared_ptr<PmUnitExploration>& pmUnit,
+      size_t nodeId);
+  void scheduleSlots(
+      const std::string& slotPath,
+      const PmUnitConfig& pmUnitConfig,
+      size_t predecessor);
   void createDeviceSymLink(
       const std::string& linkPath,
       const std::string& devicePath);
@@ -132,10 +195,20 @@ class PlatformExplorer {
       i2cBusNums_{};
 
   // Map from <slotPath, PmUnitScopedName> to instance ids for FPGAs.
-  std::map<std::pair<std::string, std::string>, uint32_t> fpgaInstanceIds_{};
+  folly::Synchronized<std::map<std::pair<std::string, std::string>, uint32_t>>
+      fpgaInstanceIds_{};
 
   // Map from <SlotPath, GpioChipDeviceName> to gpio chip number.
   std::map<std::pair<std::string, std::string>, uint16_t> gpioChipNums_{};
+
+  // Exploration graph state, all guarded by explorationMutex_.
+  std::unique_ptr<folly::CPUThreadPoolExecutor> explorationExecutor_;
+  std::chrono::steady_clock::time_point explorationStartTime_;
+  std::vector<ExplorationNode> explorationNodes_;
+  size_t pendingExplorationNodes_{0};
+  std::exception_ptr explorationError_;
+  mutable std::mutex explorationMutex_;
+  std::condition_variable explorationDone_;
 };
 
 } // namespace facebook::fboss::platform::platform_manager
@@ -1,12 +1,25 @@
 // (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
 
+#include <sys/utsname.h>
+
+#include <folly/testing/TestUtil.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "fboss/platform/helpers/MockPlatformUtils.h"
+#include "fboss/platform/helpers/PlatformFsUtils.h"
 #include "fboss/platform/platform_manager/PkgManager.h"
 
 using namespace ::testing;
 namespace facebook::fboss::platform::platform_manager {
+namespace {
+std::string getModulesDepPath() {
+  utsname result;
+  uname(&result);
+  return fmt::format("/lib/modules/{}/modules.dep", result.release);
+}
+} // namespace
+
 class MockPkgManager : public PkgManager {
  public:
   explicit MockPkgManager(const PlatformConfig& config) : PkgManager(config) {}
@@ -87,4 +100,73 @@ TEST_F(PkgManagerTest, DisablePkgMgmntWithReloadKmods) {
   EXPECT_CALL(mockPkgManager_, loadBSPKmods()).Times(0);
   EXPECT_NO_THROW(mockPkgManager_.processAll());
 }
-}; // namespace facebook::fboss::platform::platform_manager
+
+TEST(PkgManagerKmodsTest, KmodLoadWaves) {
+  auto tmpDir = folly::test::TemporaryDirectory();
+  auto platformFsUtils =
+      std::make_shared<PlatformFsUtils>(tmpDir.path().string());
+  PlatformConfig platformConfig;
+  PkgManager pkgManager(
+      platformConfig, std::make_shared<MockPlatformUtils>(), platformFsUtils);
+  std::vector<std::string> kmods{
+      "fan_cpld", "fboss_iob_i2c", "fbiob_pci", "spi_bus", "unknown_kmod"};
+
+  // Without modules.dep, kmods are loaded one at a time in config order.
+  EXPECT_EQ(
+      pkgManager.getKmodLoadWaves(kmods),
+      (std::vector<std::vector<std::string>>{
+          {"fan_cpld"},
+          {"fboss_iob_i2c"},
+          {"fbiob_pci"},
+          {"spi_bus"},
+          {"unknown_kmod"}}));
+
+  EXPECT_TRUE(platformFsUtils->writeStringToFile(
+      "kernel/drivers/i2c/i2c-core.ko.xz:\n"
+      "extra/fbiob-pci.ko: kernel/drivers/i2c/i2c-core.ko.xz\n"
+      "extra/fboss_iob_i2c.ko: extra/fbiob-pci.ko "
+      "kernel/drivers/i2c/i2c-core.ko.xz\n"
+      "extra/spi_bus.ko:\n"
+      "extra/fan_cpld.ko: extra/fboss_iob_i2c.ko extra/fbiob-pci.ko\n",
+      getModulesDepPath()));
+  PkgManager pkgManagerWithDeps(
+      platformConfig, std::make_shared<MockPlatformUtils>(), platformFsUtils);
+  EXPECT_EQ(
+      pkgManagerWithDeps.getKmodLoadWaves(kmods),
+      (std::vector<std::vector<std::string>>{
+          {"fbiob_pci", "spi_bus", "unknown_kmod"},
+          {"fboss_iob_i2c"},
+          {"fan_cpld"}}));
+}
+
+TEST(PkgManagerKmodsTest, SkipRpmCheckWhenFingerprintUnchanged) {
+  FLAGS_local_rpm_path = "";
+  auto tmpDir = folly::test::TemporaryDirectory();
+  auto platformFsUtils =
+      std::make_shared<PlatformFsUtils>(tmpDir.path().string());
+  auto platformUtils = std::make_shared<MockPlatformUtils>();
+  PlatformConfig platformConfig;
+  platformConfig.bspKmodsRpmName() = "fboss_bsp_kmods";
+  platformConfig.bspKmodsRpmVersion() = "1.0.0-1";
+  PkgManager pkgManager(platformConfig, platformUtils, platformFsUtils);
+  EXPECT_TRUE(platformFsUtils->writeStringToFile(
+      "extra/fbiob-pci.ko:\n", getModulesDepPath()));
+  auto dnfCheck = fmt::format(
+      "dnf list {} --installed", pkgManager.getKmodsRpmName());
+
+  // First check queries dnf and records the fingerprint.
+  EXPECT_CALL(*platformUtils, execCommand(dnfCheck))
+      .WillOnce(Return(std::make_pair(0, std::string())));
+  EXPECT_FALSE(pkgManager.processRpms());
+  // Nothing changed, so no need to query dnf again.
+  EXPECT_FALSE(pkgManager.processRpms());
+
+  // A new modules.dep means something else changed the installed kmods.
+  EXPECT_TRUE(platformFsUtils->writeStringToFile(
+      "extra/fbiob-pci.ko:\nextra/spi_bus.ko:\n", getModulesDepPath()));
+  EXPECT_CALL(*platformUtils, execCommand(dnfCheck))
+      .WillOnce(Return(std::make_pair(0, std::string())));
+  EXPECT_FALSE(pkgManager.processRpms());
+}
+
+} // namespace facebook::fboss::platform::platform_manager
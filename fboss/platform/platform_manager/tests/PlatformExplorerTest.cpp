@@ -1,10 +1,16 @@
 // (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
 
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+
 #include <fb303/ServiceData.h>
 #include <folly/FileUtil.h>
 #include <folly/testing/TestUtil.h>
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "fboss/platform/helpers/MockPlatformFsUtils.h"
 #include "fboss/platform/helpers/PlatformFsUtils.h"
 #include "fboss/platform/platform_manager/PlatformExplorer.h"
 
@@ -73,4 +79,88 @@ TEST(PlatformExplorerTest, PublishFirmwareVersions) {
   expectVersions("NONE", PlatformExplorer::kFwVerErrorFileNotFound);
 }
 
+TEST(PlatformExplorerTest, ExploreSlotsConcurrently) {
+  // A chassis with PIM slots whose presence is read from a sensor on the
+  // chassis. The last PIM is absent.
+  constexpr auto kNumPims = 4;
+  auto tmpDir = folly::test::TemporaryDirectory();
+  auto sensorPath = tmpDir.path().string() + "/sensor";
+  std::filesystem::create_directories(sensorPath + "/hwmon/hwmon1");
+
+  PlatformConfig platformConfig;
+  platformConfig.platformName() = "test";
+  platformConfig.rootSlotType() = "CHASSIS_SLOT";
+  platformConfig.rootPmUnitName() = "CHASSIS";
+  platformConfig.slotTypeConfigs()["CHASSIS_SLOT"].pmUnitName() = "CHASSIS";
+  platformConfig.slotTypeConfigs()["PIM_SLOT"].pmUnitName() = "PIM";
+  PmUnitConfig chassisConfig;
+  EmbeddedSensorConfig sensorConfig;
+  sensorConfig.pmUnitScopedName() = "PRESENCE_SENSOR";
+  sensorConfig.sysfsPath() = sensorPath;
+  chassisConfig.embeddedSensorConfigs()->push_back(sensorConfig);
+  for (auto i = 0; i < kNumPims; i++) {
+    SysfsFileHandle presenceFile;
+    presenceFile.devicePath() = "/[PRESENCE_SENSOR]";
+    presenceFile.presenceFileName() = fmt::format("pim{}_present", i);
+    presenceFile.desiredValue() = 1;
+    SlotConfig slotConfig;
+    slotConfig.slotType() = "PIM_SLOT";
+    slotConfig.presenceDetection() = PresenceDetection();
+    slotConfig.presenceDetection()->sysfsFileHandle() = presenceFile;
+    chassisConfig.outgoingSlotConfigs()[fmt::format("PIM_SLOT@{}", i)] =
+        slotConfig;
+  }
+  platformConfig.pmUnitConfigs()["CHASSIS"] = chassisConfig;
+  platformConfig.pmUnitConfigs()["PIM"] = PmUnitConfig();
+
+  // Hold every presence read until all slots are being explored at once, so
+  // that a serial exploration would wait out the timeout on each slot.
+  std::mutex mutex;
+  std::condition_variable allInFlight;
+  int inFlight = 0;
+  int maxInFlight = 0;
+  auto platformFsUtils = std::make_shared<MockPlatformFsUtils>();
+  EXPECT_CALL(*platformFsUtils, getStringFileContent(_))
+      .Times(kNumPims)
+      .WillRepeatedly(Invoke([&](const std::filesystem::path& path) {
+        std::unique_lock<std::mutex> lock(mutex);
+        maxInFlight = std::max(maxInFlight, ++inFlight);
+        allInFlight.notify_all();
+        allInFlight.wait_for(lock, std::chrono::seconds(5), [&]() {
+          return maxInFlight == kNumPims;
+        });
+        --inFlight;
+        return std::make_optional<std::string>(
+            path.filename() == fmt::format("pim{}_present", kNumPims - 1)
+                ? "0"
+                : "1");
+      }));
+
+  PlatformExplorer explorer(platformConfig, platformFsUtils);
+  explorer.explore();
+
+  EXPECT_EQ(maxInFlight, kNumPims);
+  EXPECT_EQ(
+      *explorer.getPMStatus().explorationStatus(),
+      ExplorationStatus::SUCCEEDED);
+  for (auto i = 0; i < kNumPims - 1; i++) {
+    EXPECT_EQ(
+        *explorer.getPmUnitInfo(fmt::format("/PIM_SLOT@{}", i)).name(), "PIM");
+  }
+  EXPECT_THROW(
+      explorer.getPmUnitInfo(fmt::format("/PIM_SLOT@{}", kNumPims - 1)),
+      std::runtime_error);
+
+  // The critical path runs from the chassis through one of the PIM slots,
+  // each node starting after its predecessor completed.
+  auto criticalPath = explorer.getExplorationCriticalPath();
+  ASSERT_GE(criticalPath.size(), 2);
+  EXPECT_EQ(criticalPath[0].name, "PmUnit CHASSIS at /");
+  EXPECT_FALSE(criticalPath[0].predecessor);
+  EXPECT_TRUE(criticalPath[1].name.starts_with("Slot /PIM_SLOT@"));
+  for (size_t i = 1; i < criticalPath.size(); i++) {
+    EXPECT_GE(criticalPath[i].startTime, criticalPath[i - 1].endTime);
+  }
+}
+
 } // namespace facebook::fboss::platform::platform_manager
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "fboss/platform/weutil/FbossEepromParser.h"
 
 namespace facebook::fboss::platform {
@@ -14,13 +16,18 @@ class CachedFbossEepromParser {
       const std::string& eepromFilePath,
       uint16_t offset = 0) {
     auto eepromPtr = std::make_pair(eepromFilePath, offset);
-    if (cache_.find(eepromPtr) == cache_.end()) {
-      auto contents = FbossEepromParser(eepromFilePath, offset).getContents();
-      cache_.insert({eepromPtr, contents});
-      return contents;
-    } else {
-      return cache_.at(eepromPtr);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (auto it = cache_.find(eepromPtr); it != cache_.end()) {
+        return it->second;
+      }
     }
+    // Parse outside the lock so that different EEPROMs can be read
+    // concurrently.
+    auto contents = FbossEepromParser(eepromFilePath, offset).getContents();
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_.insert({eepromPtr, contents});
+    return contents;
   }
 
   std::optional<std::string> getProductName(
@@ -74,6 +81,7 @@ class CachedFbossEepromParser {
           std::string /* eeprom key */,
           std::string /* eeprom value */>>>
       cache_{};
+  std::mutex mutex_;
 };
 
 } // namespace facebook::fboss::platform
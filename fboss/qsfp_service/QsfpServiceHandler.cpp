@@ -93,6 +93,22 @@ void QsfpServiceHandler::triggerAllOpticsFwUpgrade(
   ports = manager_->triggerAllOpticsFwUpgrade();
 }
 
+void QsfpServiceHandler::getThreadStallSamples(
+    std::vector<ThreadStallSample>& samples) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  for (const auto& sample : manager_->getThreadStallSamples()) {
+    ThreadStallSample thriftSample;
+    thriftSample.threadName() = sample.threadName;
+    thriftSample.timestampMsecs() =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            sample.timestamp.time_since_epoch())
+            .count();
+    thriftSample.lagMsecs() = sample.lag.count();
+    thriftSample.frames() = sample.frames;
+    samples.push_back(std::move(thriftSample));
+  }
+}
+
 void QsfpServiceHandler::getTransceiverConfigValidationInfo(
     std::map<int32_t, std::string>& info,
     std::unique_ptr<std::vector<int32_t>> ids,
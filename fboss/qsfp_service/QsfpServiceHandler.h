@@ -190,6 +190,8 @@ class QsfpServiceHandler
   void triggerAllOpticsFwUpgrade(
       std::map<std::string, FirmwareUpgradeData>& ports) override;
 
+  void getThreadStallSamples(std::vector<ThreadStallSample>& samples) override;
+
   /*
    * Get the list of supported PRBS polynomials for the given port and
    * prbs component
@@ -38,6 +38,20 @@ DEFINE_int32(
     20000,
     "State machine update thread's heartbeat interval (ms)");
 
+DEFINE_bool(
+    state_machine_thread_stall_profiler,
+    false,
+    "Capture stack samples of state machine threads whose heartbeat is late");
+DEFINE_int32(
+    state_machine_thread_stall_threshold_ms,
+    500,
+    "Heartbeat lag (ms) after which a thread is considered stalled and its "
+    "stack is sampled");
+DEFINE_int32(
+    state_machine_thread_stall_max_samples,
+    32,
+    "Number of most recent thread stall samples to keep");
+
 DEFINE_bool(
     firmware_upgrade_supported,
     false,
@@ -84,6 +98,8 @@ constexpr auto kAgentConfigLastColdbootAppliedInMsKey =
     "agentConfigLastColdbootAppliedInMs";
 static constexpr auto kStateMachineThreadHeartbeatMissed =
     "state_machine_thread_heartbeat_missed";
+static constexpr auto kRefreshTransceiversTimeMs =
+    "refresh_transceivers_time_ms";
 constexpr int kSecAfterModuleOutOfReset = 2;
 
 std::map<int, facebook::fboss::NpuPortStatus> getNpuPortStatus(
@@ -787,6 +803,21 @@ void TransceiverManager::startThreads() {
   }
   // Kick off the heartbeat monitoring
   heartbeatWatchdog_->start();
+
+  if (FLAGS_state_machine_thread_stall_profiler) {
+    // Heartbeat intervals are long here, check for stalls at the threshold
+    // granularity instead.
+    auto stallThreshold = std::chrono::milliseconds(
+        FLAGS_state_machine_thread_stall_threshold_ms);
+    threadStallProfiler_ = std::make_unique<ThreadStallProfiler>(
+        stallThreshold,
+        FLAGS_state_machine_thread_stall_max_samples,
+        stallThreshold);
+    for (auto heartbeat : heartbeats_) {
+      threadStallProfiler_->startProfilingHeartbeat(heartbeat);
+    }
+    threadStallProfiler_->start();
+  }
 }
 
 void TransceiverManager::stopThreads() {
@@ -794,6 +825,10 @@ void TransceiverManager::stopThreads() {
     heartbeatWatchdog_->stop();
     heartbeatWatchdog_.reset();
   }
+  if (threadStallProfiler_) {
+    threadStallProfiler_->stop();
+    threadStallProfiler_.reset();
+  }
   for (auto heartbeat_ : heartbeats_) {
     heartbeat_.reset();
   }
@@ -2824,12 +2859,16 @@ std::vector<TransceiverID> TransceiverManager::refreshTransceivers(
     const std::unordered_set<TransceiverID>& transceivers) {
   std::vector<TransceiverID> transceiverIds;
   std::vector<folly::Future<folly::Unit>> futs;
+  // Transceivers without an I2C event base refresh on this thread, so they
+  // go after the others have been fired to their I2C controllers
+  std::vector<Transceiver*> inlineRefreshTransceivers;
 
   {
     auto lockedTransceivers = transceivers_.rlock();
     auto nTransceivers =
         transceivers.empty() ? lockedTransceivers->size() : transceivers.size();
     XLOG(INFO) << "Start refreshing " << nTransceivers << " transceivers...";
+    auto startTime = std::chrono::steady_clock::now();
 
     for (const auto& transceiver : *lockedTransceivers) {
       TransceiverID id = TransceiverID(transceiver.second->getID());
@@ -2839,13 +2878,25 @@ std::vector<TransceiverID> TransceiverManager::refreshTransceivers(
           transceivers.find(id) == transceivers.end()) {
         continue;
       }
-      XLOG(DBG3) << "Fired to refresh TransceiverID=" << id;
       transceiverIds.push_back(id);
+      if (!transceiver.second->getEvb()) {
+        inlineRefreshTransceivers.push_back(transceiver.second.get());
+        continue;
+      }
+      XLOG(DBG3) << "Fired to refresh TransceiverID=" << id;
       futs.push_back(transceiver.second->futureRefresh());
     }
+    for (auto* transceiver : inlineRefreshTransceivers) {
+      futs.push_back(transceiver->futureRefresh());
+    }
 
     folly::collectAll(futs.begin(), futs.end()).wait();
-    XLOG(INFO) << "Finished refreshing " << nTransceivers << " transceivers";
+    auto refreshTimeMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                             std::chrono::steady_clock::now() - startTime)
+                             .count();
+    tcData().setCounter(kRefreshTransceiversTimeMs, refreshTimeMs);
+    XLOG(INFO) << "Finished refreshing " << nTransceivers << " transceivers in "
+               << refreshTimeMs << "ms";
   }
 
   publishTransceiversToFsdb();
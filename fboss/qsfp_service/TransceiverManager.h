@@ -17,6 +17,7 @@
 #include "fboss/agent/platforms/common/PlatformMapping.h"
 #include "fboss/agent/types.h"
 #include "fboss/lib/ThreadHeartbeat.h"
+#include "fboss/lib/ThreadStallProfiler.h"
 #include "fboss/lib/firmware_storage/FbossFwStorage.h"
 #include "fboss/lib/i2c/gen-cpp2/i2c_controller_stats_types.h"
 #include "fboss/lib/phy/PhyManager.h"
@@ -545,6 +546,15 @@ class TransceiverManager {
     return stateMachineThreadHeartbeatMissedCount_;
   }
 
+  // Stack samples of stalled state machine threads, oldest first. Empty
+  // unless the thread stall profiler is enabled.
+  std::vector<ThreadStallProfiler::Sample> getThreadStallSamples() const {
+    if (!threadStallProfiler_) {
+      return {};
+    }
+    return threadStallProfiler_->getSamples();
+  }
+
   // Dump the transceiver I2C Log for a specific port.
   // Returns the number of lines in log header and number of log entries.
   // To be implemented by derived class.
@@ -941,6 +951,12 @@ class TransceiverManager {
    */
   std::unique_ptr<ThreadHeartbeatWatchdog> heartbeatWatchdog_;
 
+  /*
+   * Samples stacks of the state machine threads when their heartbeats stall.
+   * Only created if FLAGS_state_machine_thread_stall_profiler is set.
+   */
+  std::unique_ptr<ThreadStallProfiler> threadStallProfiler_;
+
   /*
    * Tracks how many times a heart beat (from any of the state machine threads)
    * was missed. This counter is periodically published to ODS by StatsPublisher
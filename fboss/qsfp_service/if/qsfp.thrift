@@ -304,4 +304,10 @@ service QsfpService extends phy.FbossCommonPhyCtrl {
     string,
     transceiver.FirmwareUpgradeData
   > triggerAllOpticsFwUpgrade() throws (1: fboss.FbossBaseError error);
+
+  /*
+   * Get the most recent state machine thread stall samples, oldest first.
+   * Empty unless the thread stall profiler is enabled.
+   */
+  list<ctrl.ThreadStallSample> getThreadStallSamples();
 }
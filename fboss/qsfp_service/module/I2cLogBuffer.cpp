@@ -3,6 +3,7 @@
 #include "fboss/qsfp_service/module/I2cLogBuffer.h"
 
 #include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <sstream>
@@ -28,6 +29,8 @@ I2cLogBuffer::I2cLogBuffer(
     : buffer_(config.bufferSlots().value()),
       size_(config.bufferSlots().value()),
       config_(config),
+      readLog_(config.readLog().value()),
+      writeLog_(config.writeLog().value()),
       logFile_(logFile) {
   if (size_ == 0) {
     throw std::invalid_argument("I2cLogBuffer size must be > 0");
@@ -46,35 +49,37 @@ void I2cLogBuffer::log(
   if (data == nullptr) {
     throw std::invalid_argument("I2cLogBuffer data must be non-null");
   }
-  std::lock_guard<std::mutex> g(mutex_);
-  if ((op == Operation::Read && config_.readLog().value()) ||
-      (op == Operation::Write && config_.writeLog().value())) {
-    auto& bufferHead = buffer_[head_];
-    bufferHead.steadyTime = std::chrono::steady_clock::now();
-    bufferHead.systemTime = std::chrono::system_clock::now();
-    bufferHead.param = param;
-    bufferHead.field = field;
+  if ((op == Operation::Read && readLog_.load(std::memory_order_relaxed)) ||
+      (op == Operation::Write && writeLog_.load(std::memory_order_relaxed))) {
+    I2cLogEntry entry;
+    entry.steadyTime = std::chrono::steady_clock::now();
+    entry.systemTime = std::chrono::system_clock::now();
+    entry.param = param;
+    entry.field = field;
     const size_t len = std::min(param.len, kMaxI2clogDataSize);
-    auto& bufferData = bufferHead.data;
-    std::copy(data, data + len, bufferData.begin());
+    auto& entryData = entry.data;
+    std::copy(data, data + len, entryData.begin());
     if (len < kMaxI2clogDataSize) {
-      std::fill(bufferData.begin() + len, bufferData.end(), 0);
+      std::fill(entryData.begin() + len, entryData.end(), 0);
     }
-    bufferHead.op = op;
-    bufferHead.success = success;
-
-    // Let tail track the oldest entry.
-    if ((head_ == tail_) && (totalEntries_ != 0)) {
-      tail_ = (tail_ + 1) % size_;
+    entry.op = op;
+    entry.success = success;
+    std::array<uint64_t, kSlotWords> words{};
+    std::memcpy(words.data(), &entry, sizeof(entry));
+
+    auto seq = nextSeq_.fetch_add(1, std::memory_order_relaxed);
+    auto& slot = buffer_[seq % size_];
+    slot.seq.store(2 * seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < kSlotWords; i++) {
+      slot.words[i].store(words[i], std::memory_order_relaxed);
     }
-    // advance head_
-    head_ = (head_ + 1) % size_;
-    totalEntries_++;
+    slot.seq.store(2 * seq + 2, std::memory_order_release);
   }
 
   if (!success && config_.disableOnFail().value()) {
-    config_.readLog() = false;
-    config_.writeLog() = false;
+    readLog_.store(false, std::memory_order_relaxed);
+    writeLog_.store(false, std::memory_order_relaxed);
   }
 }
 
@@ -88,50 +93,46 @@ I2cLogBuffer::I2cLogHeader I2cLogBuffer::dump(
     entriesOut.resize(size_);
   }
 
+  // Copy entries from the oldest one still in the buffer to the newest one.
+  // Entries overwritten before or while we copy them are dropped. Copying
+  // stops at the first entry still being written rather than waiting for it,
+  // and the next dump starts from that entry.
+  const uint64_t endSeq = nextSeq_.load(std::memory_order_acquire);
+  const uint64_t dumpedSeq = dumpedSeq_.load(std::memory_order_relaxed);
+  uint64_t seq = std::max(dumpedSeq, endSeq > size_ ? endSeq - size_ : 0);
   size_t entries = 0;
-  // Copy entries from tail to head.
-  // If head < tail:
-  //    Copy around the buffer: [tail -> size], [0 -> head).
-  // If head > tail:
-  //    Copy contents once: [tail -> head).
-  // If head == tail with entries:
-  //    Copy around the buffer: [head -> size], [0 -> head).
-  //    (if head == 0) we just copy entire buffer [Beg -> end].
-  if (head_ < tail_) {
-    std::copy(buffer_.begin() + tail_, buffer_.end(), entriesOut.begin());
-    entries = size_ - tail_;
-    std::copy(
-        buffer_.begin(), buffer_.begin() + head_, entriesOut.begin() + entries);
-    entries += head_;
-  } else if (head_ > tail_) {
-    std::copy(
-        buffer_.begin() + tail_, buffer_.begin() + head_, entriesOut.begin());
-    entries = head_ - tail_;
-  } else if ((head_ == tail_ && totalEntries_ != 0)) {
-    entries = size_ - head_;
-    std::copy(buffer_.begin() + head_, buffer_.end(), entriesOut.begin());
-    if (head_ != 0) {
-      // Go around the buffer.
-      std::copy(
-          buffer_.begin(),
-          buffer_.begin() + head_,
-          entriesOut.begin() + entries);
-      entries += head_;
+  std::array<uint64_t, kSlotWords> words;
+  for (; seq < endSeq; seq++) {
+    const auto& slot = buffer_[seq % size_];
+    const auto complete = 2 * seq + 2;
+    const auto slotSeq = slot.seq.load(std::memory_order_acquire);
+    if (slotSeq < complete) {
+      break;
+    }
+    if (slotSeq > complete) {
+      continue;
+    }
+    for (size_t i = 0; i < kSlotWords; i++) {
+      words[i] = slot.words[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.seq.load(std::memory_order_relaxed) == complete) {
+      std::memcpy(&entriesOut[entries++], words.data(), sizeof(I2cLogEntry));
     }
   }
+  dumpedSeq_.store(seq, std::memory_order_release);
 
   auto end = std::chrono::high_resolution_clock::now();
   auto copyTime =
       std::chrono::duration_cast<std::chrono::microseconds>(end - start);
   I2cLogHeader retval = {
       .mgmtIf = mgmtIf_,
-      .totalEntries = totalEntries_,
+      .totalEntries = seq - dumpedSeq,
       .bufferEntries = entries,
       .portNames = portNames_,
       .fwStatus = fwStatus_,
       .vendor = vendor_,
       .duration = copyTime};
-  totalEntries_ = head_ = tail_ = 0;
   return retval;
 }
 
@@ -229,8 +230,7 @@ std::pair<size_t, size_t> I2cLogBuffer::dumpToFile() {
   // To avoid high latency for lock (during memory allocation), the thrift API
   // call will run this function and the entriesOut will be initialized to the
   // right size before the call to dump();
-  const size_t size = getSize();
-  std::vector<I2cLogEntry> entriesOut(size);
+  std::vector<I2cLogEntry> entriesOut(size_);
   const auto headerInfo = dump(entriesOut);
   std::stringstream ss;
 
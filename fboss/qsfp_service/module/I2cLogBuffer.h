@@ -3,8 +3,10 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <mutex>
+#include <type_traits>
 #include <vector>
 
 #include "fboss/lib/usb/TransceiverAccessParameter.h"
@@ -19,11 +21,16 @@ namespace facebook::fboss {
  * to the transceiver.
  * This class is designed as a circular buffer with the following properties:
  *     * Can hold up to <size_> entries.
- *     * The buffer is full when the head_ == tail_ and there are elements
- *       inserted.
- *     * Tail will track the oldest element still in buffer.
+ *     * Every log() claims the next sequence number, and entry <seq> lives in
+ *       slot <seq % size_>. So the buffer always holds the latest <size_>
+ *       entries.
  *     * When dumping the contents of the buffer, the buffer is cleared.
- *     * The buffer is thread safe (logging/dumping)
+ *     * log() never blocks or allocates, since it runs inside every I2C
+ *       transaction. Each slot is a seqlock instead: its sequence is odd while
+ *       the entry is being written, and the entry is copied in and out
+ *       through relaxed atomics. dump() drops entries which were overwritten
+ *       while it copied them, and stops at the first entry still being
+ *       written, which is left for the next dump.
  *     * The size of valid data in each buffer slot is:
  *       min(kMaxI2clogDataSize, param.len)
  */
@@ -74,6 +81,9 @@ class I2cLogBuffer {
   static_assert(
       sizeof(I2cLogEntry) < 200,
       "I2cLogEntry must be < 200B to not exceed system memory limits.");
+  static_assert(
+      std::is_trivially_copyable_v<I2cLogEntry>,
+      "I2cLogEntry is copied through the words of a buffer slot");
 
   struct I2cReplayEntry {
     TransceiverAccessParameter param;
@@ -120,7 +130,8 @@ class I2cLogBuffer {
   // Get the number of entries logged to the buffer. The size of the
   // buffer can be smaller than total entries logged.
   size_t getTotalEntries() const {
-    return totalEntries_;
+    return nextSeq_.load(std::memory_order_acquire) -
+        dumpedSeq_.load(std::memory_order_acquire);
   }
 
   // Get the capacity
@@ -150,13 +161,29 @@ class I2cLogBuffer {
       const std::optional<Vendor>& vendor);
 
  private:
-  std::vector<I2cLogEntry> buffer_;
+  static constexpr size_t kSlotWords =
+      (sizeof(I2cLogEntry) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+  struct Slot {
+    // 2 * seq + 1 while entry <seq> is being written, 2 * seq + 2 once it is
+    // complete, 0 if the slot was never written
+    std::atomic<uint64_t> seq{0};
+    // The I2cLogEntry bytes
+    std::array<std::atomic<uint64_t>, kSlotWords> words{};
+  };
+
+  std::vector<Slot> buffer_;
   const size_t size_;
-  cfg::TransceiverI2cLogging config_;
-  size_t head_{0};
-  size_t tail_{0};
-  size_t totalEntries_{0};
+  const cfg::TransceiverI2cLogging config_;
+  std::atomic<bool> readLog_;
+  std::atomic<bool> writeLog_;
+  // Sequence number of the next entry to log
+  std::atomic<uint64_t> nextSeq_{0};
+  // Sequence number of the first entry not dumped yet
+  std::atomic<uint64_t> dumpedSeq_{0};
   std::string logFile_;
+  // Serializes dumps, and protects the transceiver info below. Never taken by
+  // log()
   std::mutex mutex_;
   TransceiverManagementInterface mgmtIf_ =
       TransceiverManagementInterface::UNKNOWN;
@@ -164,12 +191,6 @@ class I2cLogBuffer {
   std::optional<FirmwareStatus> fwStatus_;
   std::optional<Vendor> vendor_;
 
-  size_t getSize() {
-    // Avoid the tsan errors. size_ is also a const member variable.
-    std::lock_guard<std::mutex> g(mutex_);
-    return size_;
-  }
-
   void getEntryTime(std::stringstream& ss, const TimePointSystem& time_point);
   void getFieldName(std::stringstream& ss, const int field);
 
@@ -25,9 +25,20 @@
 #include <folly/io/IOBuf.h>
 #include <folly/io/async/EventBase.h>
 #include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
 
 #include <thrift/lib/cpp/util/EnumUtils.h>
 
+DEFINE_int32(
+    cmis_static_page_refresh_interval,
+    300,
+    "seconds between partial refreshes reading the static CMIS pages "
+    "(advertisements, thresholds, VDM config)");
+DEFINE_int32(
+    cmis_vdm_page_refresh_interval,
+    30,
+    "seconds between partial refreshes reading the CMIS VDM sample pages");
+
 using folly::IOBuf;
 using std::lock_guard;
 using std::memcpy;
@@ -163,6 +174,7 @@ static QsfpFieldInfo<CmisField, CmisPages>::QsfpFieldMap cmisFields = {
     {CmisField::RX_CONTROL_PRE_CURSOR, {CmisPages::PAGE10, 162, 4}},
     {CmisField::RX_CONTROL_POST_CURSOR, {CmisPages::PAGE10, 166, 4}},
     {CmisField::RX_CONTROL_MAIN, {CmisPages::PAGE10, 170, 4}},
+    {CmisField::PAGE10_CONTROLS, {CmisPages::PAGE10, 128, 46}},
     // Page 11h
     {CmisField::PAGE_UPPER11H, {CmisPages::PAGE11, 128, 128}},
     {CmisField::DATA_PATH_STATE, {CmisPages::PAGE11, 128, 4}},
@@ -193,6 +205,7 @@ static QsfpFieldInfo<CmisField, CmisPages>::QsfpFieldMap cmisFields = {
     {CmisField::RX_OUT_PRE_CURSOR, {CmisPages::PAGE11, 223, 4}},
     {CmisField::RX_OUT_POST_CURSOR, {CmisPages::PAGE11, 227, 4}},
     {CmisField::RX_OUT_MAIN, {CmisPages::PAGE11, 231, 4}},
+    {CmisField::PAGE11_STATUS, {CmisPages::PAGE11, 128, 107}},
     // Page 13h
     {CmisField::PAGE_UPPER13H, {CmisPages::PAGE13, 128, 128}},
     {CmisField::LOOPBACK_CAPABILITY, {CmisPages::PAGE13, 128, 1}},
@@ -263,6 +276,8 @@ static QsfpFieldInfo<CmisField, CmisPages>::QsfpFieldMap cmisFields = {
     {CmisField::HOST_BER, {CmisPages::PAGE14, 192, 16}},
     {CmisField::MEDIA_BER_HOST_SNR, {CmisPages::PAGE14, 208, 16}},
     {CmisField::MEDIA_SNR, {CmisPages::PAGE14, 240, 16}},
+    // SNR values with DIAG_SEL set to SNR, from MEDIA_BER_HOST_SNR to MEDIA_SNR
+    {CmisField::PAGE14_SNR, {CmisPages::PAGE14, 208, 48}},
     // Page 20h
     {CmisField::PAGE_UPPER20H, {CmisPages::PAGE20, 128, 128}},
     // Page 21h
@@ -602,6 +617,40 @@ void CmisModule::readCmisField(
       CAST_TO_INT(field));
 }
 
+void CmisModule::readCmisPageIfDue(
+    CmisField field,
+    uint8_t* pageCache,
+    CmisPageRefreshClass refreshClass) {
+  int dataLength, dataPage, dataOffset;
+  getQsfpFieldAddress(field, dataPage, dataOffset, dataLength);
+  auto page = static_cast<CmisPages>(dataPage);
+  auto now = std::time(nullptr);
+  auto lastRead = pageReadTime_.find(page);
+  if (lastRead != pageReadTime_.end()) {
+    switch (refreshClass) {
+      case CmisPageRefreshClass::DYNAMIC:
+        break;
+      case CmisPageRefreshClass::VDM:
+        if (now - lastRead->second < FLAGS_cmis_vdm_page_refresh_interval) {
+          return;
+        }
+        break;
+      case CmisPageRefreshClass::STATIC:
+        if (now - lastRead->second < FLAGS_cmis_static_page_refresh_interval) {
+          return;
+        }
+        break;
+    }
+  }
+  // The cache holds the whole page while the field may only cover part of it
+  if (page != CmisPages::LOWER) {
+    dataOffset -= MAX_QSFP_PAGE_SIZE;
+  }
+  CHECK_LE(dataOffset + dataLength, MAX_QSFP_PAGE_SIZE);
+  readCmisField(field, pageCache + dataOffset);
+  pageReadTime_[page] = now;
+}
+
 void CmisModule::writeCmisField(
     CmisField field,
     uint8_t* data,
@@ -2120,15 +2169,29 @@ void CmisModule::updateQsfpData(bool allPages) {
   try {
     QSFP_LOG(DBG2, this) << "Performing " << ((allPages) ? "full" : "partial")
                          << " qsfp data cache refresh";
+    if (allPages) {
+      // Full refreshes follow module insertion, resets and firmware upgrades,
+      // after which nothing in the cache can be trusted
+      invalidatePageCache();
+    }
     readCmisField(CmisField::PAGE_LOWER, lowerPage_);
     lastRefreshTime_ = std::time(nullptr);
     dirty_ = false;
     setQsfpFlatMem();
 
-    readCmisField(CmisField::PAGE_UPPER00H, page0_);
+    // Partial refreshes only read the consumed parts of the dynamic pages, and
+    // the other pages once the refresh interval of their class has passed
+    readCmisPageIfDue(
+        CmisField::PAGE_UPPER00H, page0_, CmisPageRefreshClass::STATIC);
     if (!flatMem_) {
-      readCmisField(CmisField::PAGE_UPPER10H, page10_);
-      readCmisField(CmisField::PAGE_UPPER11H, page11_);
+      readCmisPageIfDue(
+          allPages ? CmisField::PAGE_UPPER10H : CmisField::PAGE10_CONTROLS,
+          page10_,
+          CmisPageRefreshClass::DYNAMIC);
+      readCmisPageIfDue(
+          allPages ? CmisField::PAGE_UPPER11H : CmisField::PAGE11_STATUS,
+          page11_,
+          CmisPageRefreshClass::DYNAMIC);
 
       bool isReady =
           ((CmisModuleState)(getSettingsValue(CmisField::MODULE_STATE) >> 1) ==
@@ -2136,29 +2199,31 @@ void CmisModule::updateQsfpData(bool allPages) {
       if (isReady) {
         auto diagFeature = (uint8_t)DiagnosticFeatureEncoding::SNR;
         writeCmisField(CmisField::DIAG_SEL, &diagFeature);
-        readCmisField(CmisField::PAGE_UPPER14H, page14_);
+        readCmisPageIfDue(
+            allPages ? CmisField::PAGE_UPPER14H : CmisField::PAGE14_SNR,
+            page14_,
+            CmisPageRefreshClass::DYNAMIC);
         updateVdmCacheLocked();
+      } else {
+        // VDM pages are only read from ready modules. Read them all again as
+        // soon as the module is ready, as its VDM config may have changed
+        for (auto page :
+             {CmisPages::PAGE20,
+              CmisPages::PAGE21,
+              CmisPages::PAGE22,
+              CmisPages::PAGE24,
+              CmisPages::PAGE25,
+              CmisPages::PAGE26}) {
+          pageReadTime_.erase(page);
+        }
       }
-    }
 
-    if (!allPages) {
-      // Update the application capabilities once we have read from eeprom.
-      // Note that this function may also need to read information from page01
-      // which is only read when allPages_ is true. However, we always read
-      // allPages the first time so we'll have cached information of page01
-      // (when applicable) by now. That information is also static so it's okay
-      // that we are not reading it again.
-      getApplicationCapabilities();
-      // The information on the following pages are static. Thus no need to
-      // fetch them every time. We just need to do it when we first retriving
-      // the data from this module.
-      return;
-    }
-
-    if (!flatMem_) {
-      readCmisField(CmisField::PAGE_UPPER01H, page01_);
-      readCmisField(CmisField::PAGE_UPPER02H, page02_);
-      readCmisField(CmisField::PAGE_UPPER13H, page13_);
+      readCmisPageIfDue(
+          CmisField::PAGE_UPPER01H, page01_, CmisPageRefreshClass::STATIC);
+      readCmisPageIfDue(
+          CmisField::PAGE_UPPER02H, page02_, CmisPageRefreshClass::STATIC);
+      readCmisPageIfDue(
+          CmisField::PAGE_UPPER13H, page13_, CmisPageRefreshClass::STATIC);
     }
 
     // Update the application capabilities once we have read from eeprom
@@ -2706,6 +2771,7 @@ void CmisModule::remediateFlakyTransceiver(
     // This api accept 1 based module id however the module id in WedgeManager
     // is 0 based.
     triggerModuleReset();
+    invalidatePageCache();
   } else {
     auto portNameToHostLanesMap = getPortNameToHostLanes();
     for (const auto& port : ports) {
@@ -3916,17 +3982,20 @@ void CmisModule::updateVdmCacheLocked() {
     QSFP_LOG(DBG5, this) << "Doesn't support VDM, skip updating VDM cache";
     return;
   }
-  readCmisField(CmisField::PAGE_UPPER20H, page20_);
-  readCmisField(CmisField::PAGE_UPPER21H, page21_);
-  readCmisField(CmisField::PAGE_UPPER24H, page24_);
-  readCmisField(CmisField::PAGE_UPPER25H, page25_);
+  readCmisPageIfDue(
+      CmisField::PAGE_UPPER20H, page20_, CmisPageRefreshClass::STATIC);
+  readCmisPageIfDue(
+      CmisField::PAGE_UPPER21H, page21_, CmisPageRefreshClass::STATIC);
+  readCmisPageIfDue(
+      CmisField::PAGE_UPPER24H, page24_, CmisPageRefreshClass::VDM);
+  readCmisPageIfDue(
+      CmisField::PAGE_UPPER25H, page25_, CmisPageRefreshClass::VDM);
   if (isVdmSupported(3)) {
-    // Cache VDM group 3 page only if it is supported
-    if (!staticPagesCached_) {
-      readCmisField(CmisField::PAGE_UPPER22H, page22_);
-      staticPagesCached_ = true;
-    }
-    readCmisField(CmisField::PAGE_UPPER26H, page26_);
+    // Cache VDM group 3 pages only if they are supported
+    readCmisPageIfDue(
+        CmisField::PAGE_UPPER22H, page22_, CmisPageRefreshClass::STATIC);
+    readCmisPageIfDue(
+        CmisField::PAGE_UPPER26H, page26_, CmisPageRefreshClass::VDM);
   }
 }
 
@@ -9,7 +9,9 @@
 #include "fboss/lib/firmware_storage/FbossFirmware.h"
 #include "fboss/qsfp_service/if/gen-cpp2/transceiver_types.h"
 
+#include <ctime>
 #include <optional>
+#include <unordered_map>
 
 namespace facebook {
 namespace fboss {
@@ -34,6 +36,19 @@ enum class CmisPages : int {
   PAGE2F = 0x2F
 };
 
+/*
+ * Pages are grouped into classes sharing a refresh interval on partial
+ * (allPages = false) refreshes. Full refreshes always read every page.
+ */
+enum class CmisPageRefreshClass {
+  // Module state, flags, monitors and lane controls, read on every refresh
+  DYNAMIC,
+  // VDM samples
+  VDM,
+  // Advertisements, thresholds, diagnostic capabilities and VDM config
+  STATIC,
+};
+
 enum VdmConfigType {
   UNSUPPORTED = 0,
   SNR_MEDIA_IN = 5,
@@ -179,8 +194,27 @@ class CmisModule : public QsfpModule {
   uint8_t page25_[MAX_QSFP_PAGE_SIZE];
   uint8_t page26_[MAX_QSFP_PAGE_SIZE];
 
-  // Some of the pages are static and they need not be read every refresh cycle
-  bool staticPagesCached_{false};
+  // When each page was last read into its cache, for scheduling partial
+  // refreshes. A page without an entry is read on the next refresh
+  std::unordered_map<CmisPages, std::time_t> pageReadTime_;
+
+  /*
+   * Reads the page, or the part of it covered by field, into pageCache unless
+   * the page was read more recently than the interval of its refresh class
+   */
+  void readCmisPageIfDue(
+      CmisField field,
+      uint8_t* pageCache,
+      CmisPageRefreshClass refreshClass);
+
+  /*
+   * Forget when pages were last read, so that they are all read on the next
+   * refresh. Needed whenever the module may have changed underneath the cache,
+   * e.g. after a reset
+   */
+  void invalidatePageCache() {
+    pageReadTime_.clear();
+  }
 
   /*
    * This function returns a pointer to the value in the static cached
@@ -367,6 +401,8 @@ class CmisModule : public QsfpModule {
    * on the first page holds most of the fields that actually change,
    * so unless we have reason to believe the transceiver was unplugged
    * there is not much point in refreshing static data on other pages.
+   * Partial refreshes read the rest of the pages at the interval of their
+   * CmisPageRefreshClass.
    */
   virtual void updateQsfpData(bool allPages = true) override;
 
@@ -220,4 +220,9 @@ enum CmisField {
   VDM_GROUPS_SUPPORT = 188,
   VDM_LATCH_REQUEST = 189,
   VDM_LATCH_DONE = 190,
+  // Parts of the dynamic pages consumed from the cache, which are all that
+  // partial refreshes read
+  PAGE10_CONTROLS = 191,
+  PAGE11_STATUS = 192,
+  PAGE14_SNR = 193,
 }
@@ -15,6 +15,9 @@
 #include "fboss/qsfp_service/module/tests/TransceiverTestsHelper.h"
 #include "fboss/qsfp_service/test/hw_test/HwTransceiverUtils.h"
 
+DECLARE_int32(cmis_static_page_refresh_interval);
+DECLARE_int32(cmis_vdm_page_refresh_interval);
+
 namespace facebook::fboss {
 
 class MockCmisModule : public CmisModule {
@@ -42,6 +45,7 @@ class MockCmisModule : public CmisModule {
   MOCK_METHOD0(ensureTransceiverReadyLocked, bool());
 
   using CmisModule::getApplicationField;
+  using CmisModule::updateQsfpData;
 
  private:
   uint8_t moduleStateChangedReadTimes_{0};
@@ -1255,4 +1259,51 @@ TEST_F(CmisTest, cmis400GDr4TransceiverInfoTest) {
     }
   }
 }
+
+// Tests that partial refreshes read the dynamic pages every time, and the
+// static and VDM pages only once their refresh interval has passed
+TEST_F(CmisTest, cmisPageRefreshIntervalTest) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_cmis_static_page_refresh_interval = 3600;
+  FLAGS_cmis_vdm_page_refresh_interval = 3600;
+  auto xcvrID = TransceiverID(1);
+  auto xcvr = overrideCmisModule<Cmis2x400GFr4Transceiver>(
+      xcvrID, TransceiverModuleIdentifier::OSFP);
+  auto tcvrImpl = static_cast<FakeTransceiverImpl*>(qsfpImpls_.back().get());
+  ASSERT_TRUE(xcvr->isVdmSupported());
+
+  // Full refreshes read every page
+  tcvrImpl->resetReadCounters();
+  xcvr->updateQsfpData(true);
+  for (auto page : {0x00, 0x01, 0x02, 0x10, 0x11, 0x14, 0x20, 0x24}) {
+    EXPECT_EQ(tcvrImpl->getNumUpperPageReads(page), 1) << "page " << page;
+  }
+  auto fullRefreshBytes = tcvrImpl->getNumBytesRead();
+
+  // Partial refreshes only read parts of the dynamic pages
+  tcvrImpl->resetReadCounters();
+  xcvr->updateQsfpData(false);
+  for (auto page : {0x10, 0x11, 0x14}) {
+    EXPECT_EQ(tcvrImpl->getNumUpperPageReads(page), 1) << "page " << page;
+  }
+  for (auto page : {0x00, 0x01, 0x02, 0x13, 0x20, 0x21, 0x24, 0x25}) {
+    EXPECT_EQ(tcvrImpl->getNumUpperPageReads(page), 0) << "page " << page;
+  }
+  EXPECT_LT(tcvrImpl->getNumBytesRead(), fullRefreshBytes / 2);
+
+  // The static and VDM pages are read again once their interval passes
+  FLAGS_cmis_vdm_page_refresh_interval = 0;
+  tcvrImpl->resetReadCounters();
+  xcvr->updateQsfpData(false);
+  EXPECT_EQ(tcvrImpl->getNumUpperPageReads(0x00), 0);
+  EXPECT_EQ(tcvrImpl->getNumUpperPageReads(0x24), 1);
+  EXPECT_EQ(tcvrImpl->getNumUpperPageReads(0x25), 1);
+
+  FLAGS_cmis_static_page_refresh_interval = 0;
+  tcvrImpl->resetReadCounters();
+  xcvr->updateQsfpData(false);
+  for (auto page : {0x00, 0x01, 0x02, 0x20, 0x21, 0x24}) {
+    EXPECT_EQ(tcvrImpl->getNumUpperPageReads(page), 1) << "page " << page;
+  }
+}
 } // namespace facebook::fboss
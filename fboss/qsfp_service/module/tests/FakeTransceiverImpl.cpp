@@ -33,6 +33,8 @@ int FakeTransceiverImpl::readTransceiver(
   auto offset = param.offset;
   auto len = param.len;
   EXPECT_TRUE(dataAddress == 0x50 || dataAddress == 0x51);
+  ++numReads_;
+  numBytesRead_ += len;
 
   if (offset < QsfpModule::MAX_QSFP_PAGE_SIZE) {
     read = len;
@@ -51,6 +53,7 @@ int FakeTransceiverImpl::readTransceiver(
     EXPECT_LE(len + offset, QsfpModule::MAX_QSFP_PAGE_SIZE);
     assert(
         upperPages_[dataAddress].find(page_) != upperPages_[dataAddress].end());
+    ++upperPageReads_[page_];
     std::copy(
         upperPages_[dataAddress][page_].begin() + offset,
         upperPages_[dataAddress][page_].begin() + offset + len,
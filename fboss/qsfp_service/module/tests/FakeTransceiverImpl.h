@@ -44,6 +44,23 @@ class FakeTransceiverImpl : public TransceiverImpl {
   void triggerQsfpHardReset() override;
   void updateTransceiverState(TransceiverStateMachineEvent event) override;
 
+  /* Read counters, to verify how much of the eeprom refreshes read */
+  int getNumReads() const {
+    return numReads_;
+  }
+  int getNumBytesRead() const {
+    return numBytesRead_;
+  }
+  int getNumUpperPageReads(int page) const {
+    auto it = upperPageReads_.find(page);
+    return it == upperPageReads_.end() ? 0 : it->second;
+  }
+  void resetReadCounters() {
+    numReads_ = 0;
+    numBytesRead_ = 0;
+    upperPageReads_.clear();
+  }
+
  private:
   int module_{0};
   std::string moduleName_;
@@ -51,6 +68,9 @@ class FakeTransceiverImpl : public TransceiverImpl {
   std::map<uint8_t, std::map<int, std::array<uint8_t, 128>>> upperPages_;
   std::map<uint8_t, std::array<uint8_t, 128>> lowerPages_;
   TransceiverManager* tcvrManager_;
+  int numReads_{0};
+  int numBytesRead_{0};
+  std::map<int, int> upperPageReads_;
 };
 
 class SffDacTransceiver : public FakeTransceiverImpl {
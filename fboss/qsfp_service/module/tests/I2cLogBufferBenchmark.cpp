@@ -0,0 +1,82 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <folly/Benchmark.h>
+#include <folly/testing/TestUtil.h>
+#include <gflags/gflags.h>
+
+#include "fboss/lib/usb/TransceiverAccessParameter.h"
+#include "fboss/qsfp_service/module/I2cLogBuffer.h"
+#include "fboss/qsfp_service/module/cmis/gen-cpp2/cmis_types.h"
+
+using namespace facebook::fboss;
+
+namespace {
+
+constexpr int kField = static_cast<int>(CmisField::RAW);
+constexpr size_t kBufferSlots = 1024;
+
+std::unique_ptr<I2cLogBuffer> createBuffer(bool enabled) {
+  static folly::test::TemporaryDirectory tmpDir;
+  cfg::TransceiverI2cLogging config;
+  config.readLog() = enabled;
+  config.writeLog() = enabled;
+  config.disableOnFail() = false;
+  config.bufferSlots() = kBufferSlots;
+  return std::make_unique<I2cLogBuffer>(
+      config, tmpDir.path().string() + "/i2cLogBufferBenchmark.txt");
+}
+
+// Cost of logging one transaction of the given length, e.g. a one byte
+// register read or a full page read during a refresh
+void logTransactions(unsigned iters, bool enabled, int len) {
+  folly::BenchmarkSuspender suspender;
+  auto logBuffer = createBuffer(enabled);
+  std::vector<uint8_t> data(len, 0xa5);
+  TransceiverAccessParameter param(0x50, 128, len);
+  suspender.dismiss();
+  for (unsigned i = 0; i < iters; ++i) {
+    logBuffer->log(param, kField, data.data(), I2cLogBuffer::Operation::Read);
+  }
+}
+
+// Same, while another thread keeps dumping the buffer as the thrift handler
+// would
+void logTransactionsWhileDumping(unsigned iters, int len) {
+  folly::BenchmarkSuspender suspender;
+  auto logBuffer = createBuffer(true);
+  std::vector<uint8_t> data(len, 0xa5);
+  TransceiverAccessParameter param(0x50, 128, len);
+  std::atomic<bool> done{false};
+  std::thread dumper([&]() {
+    std::vector<I2cLogBuffer::I2cLogEntry> entries(kBufferSlots);
+    while (!done) {
+      logBuffer->dump(entries);
+    }
+  });
+  suspender.dismiss();
+  for (unsigned i = 0; i < iters; ++i) {
+    logBuffer->log(param, kField, data.data(), I2cLogBuffer::Operation::Read);
+  }
+  suspender.rehire();
+  done = true;
+  dumper.join();
+}
+
+} // namespace
+
+BENCHMARK_NAMED_PARAM(logTransactions, Disabled_1B, false, 1)
+BENCHMARK_RELATIVE_NAMED_PARAM(logTransactions, Enabled_1B, true, 1)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(logTransactions, Disabled_128B, false, 128)
+BENCHMARK_RELATIVE_NAMED_PARAM(logTransactions, Enabled_128B, true, 128)
+BENCHMARK_RELATIVE_NAMED_PARAM(logTransactionsWhileDumping, Dumping_128B, 128)
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -1,8 +1,10 @@
 // (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
 
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <fstream>
+#include <thread>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -563,4 +565,46 @@ TEST_F(I2cLogBufferTest, testReplayScenarios) {
   lambda();
 }
 
+TEST_F(I2cLogBufferTest, testDumpWhileLogging) {
+  // Dumps racing with log() must only return complete entries, in order
+  I2cLogBuffer logBuffer = createBuffer(kFullBuffer);
+  const int kNumLogs = 100000;
+  std::atomic<bool> done{false};
+
+  std::thread logger([&]() {
+    std::vector<uint8_t> data(kMaxI2clogDataSize);
+    TransceiverAccessParameter param(0, 0, data.size());
+    for (int i = 0; i < kNumLogs; i++) {
+      std::fill(data.begin(), data.end(), i % 0xFF);
+      param.offset = i;
+      logBuffer.log(param, kField, data.data(), I2cLogBuffer::Operation::Read);
+    }
+    done = true;
+  });
+
+  size_t totalEntries = 0;
+  int lastOffset = -1;
+  std::vector<I2cLogBuffer::I2cLogEntry> entries;
+  while (true) {
+    bool finished = done;
+    auto count = logBuffer.dump(entries);
+    totalEntries += count.totalEntries;
+    EXPECT_LE(count.bufferEntries, kFullBuffer);
+    for (size_t i = 0; i < count.bufferEntries; i++) {
+      const auto& entry = entries[i];
+      EXPECT_GT(entry.param.offset, lastOffset);
+      lastOffset = entry.param.offset;
+      for (auto byte : entry.data) {
+        ASSERT_EQ(byte, entry.param.offset % 0xFF);
+      }
+    }
+    if (finished) {
+      break;
+    }
+  }
+  logger.join();
+  EXPECT_EQ(totalEntries, kNumLogs);
+  EXPECT_EQ(lastOffset, kNumLogs - 1);
+}
+
 } // namespace facebook::fboss
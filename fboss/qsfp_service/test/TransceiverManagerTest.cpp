@@ -3,9 +3,67 @@
 #include "fboss/qsfp_service/test/TransceiverManagerTestHelper.h"
 
 #include "fboss/lib/CommonFileUtils.h"
+#include "fboss/qsfp_service/module/cmis/CmisModule.h"
+#include "fboss/qsfp_service/module/tests/FakeTransceiverImpl.h"
+
+#include <folly/io/async/ScopedEventBaseThread.h>
+
+#include <atomic>
+#include <thread>
 
 namespace facebook::fboss {
 
+namespace {
+// A transceiver behind an I2C controller with its own event base
+class I2cControllerTransceiver : public Cmis200GTransceiver {
+ public:
+  I2cControllerTransceiver(
+      int module,
+      TransceiverManager* mgr,
+      folly::EventBase* i2cEvb)
+      : Cmis200GTransceiver(module, mgr), i2cEvb_(i2cEvb) {}
+
+  folly::EventBase* getI2cEventBase() override {
+    return i2cEvb_;
+  }
+
+  bool detectTransceiver() override {
+    detected = true;
+    return Cmis200GTransceiver::detectTransceiver();
+  }
+
+  std::atomic<bool> detected{false};
+
+ private:
+  folly::EventBase* i2cEvb_;
+};
+
+// A transceiver without an I2C event base, which is refreshed inline.
+// Refreshing it waits for the I2C controller transceiver to be refreshed
+// too, which only happens if that was fired first.
+class InlineTransceiver : public Cmis200GTransceiver {
+ public:
+  InlineTransceiver(int module, TransceiverManager* mgr)
+      : Cmis200GTransceiver(module, mgr) {}
+
+  bool detectTransceiver() override {
+    if (waitFor) {
+      auto deadline =
+          std::chrono::steady_clock::now() + std::chrono::seconds(10);
+      while (!waitFor->detected &&
+             std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      refreshedAfterWaitFor = waitFor->detected.load();
+    }
+    return Cmis200GTransceiver::detectTransceiver();
+  }
+
+  I2cControllerTransceiver* waitFor{nullptr};
+  bool refreshedAfterWaitFor{false};
+};
+} // namespace
+
 class TransceiverManagerTest : public TransceiverManagerTestHelper {
  public:
   std::string warmBootFlagFile = qsfpSvcVolatileDir + "/can_warm_boot";
@@ -121,6 +179,41 @@ TEST_F(TransceiverManagerTest, runState) {
   EXPECT_EQ(transceiverManager_->getRunState(), QsfpServiceRunState::EXITING);
 }
 
+TEST_F(TransceiverManagerTest, refreshInlineTransceiversLast) {
+  folly::ScopedEventBaseThread i2cThread;
+  // Transceivers are refreshed in id order, so the inline one comes first
+  auto inlineId = TransceiverID(0);
+  auto i2cId = TransceiverID(1);
+  auto inlineImpl = std::make_unique<InlineTransceiver>(
+      inlineId, transceiverManager_.get());
+  auto i2cImpl = std::make_unique<I2cControllerTransceiver>(
+      i2cId, transceiverManager_.get(), i2cThread.getEventBase());
+  auto inlineXcvr = inlineImpl.get();
+  auto i2cXcvr = i2cImpl.get();
+  auto overrideCmisModule = [this](
+                                TransceiverID id,
+                                std::unique_ptr<TransceiverImpl> impl) {
+    transceiverManager_->overrideTransceiverForTesting(
+        id,
+        std::make_unique<CmisModule>(
+            transceiverManager_->getPortNames(id),
+            impl.get(),
+            tcvrConfig_,
+            true /*supportRemediate*/));
+    qsfpImpls_.push_back(std::move(impl));
+  };
+  overrideCmisModule(inlineId, std::move(inlineImpl));
+  overrideCmisModule(i2cId, std::move(i2cImpl));
+  i2cXcvr->detected = false;
+  inlineXcvr->waitFor = i2cXcvr;
+
+  auto refreshed = transceiverManager_->refreshTransceivers(
+      std::unordered_set<TransceiverID>{inlineId, i2cId});
+  EXPECT_EQ(refreshed.size(), 2);
+  EXPECT_TRUE(i2cXcvr->detected);
+  EXPECT_TRUE(inlineXcvr->refreshedAfterWaitFor);
+}
+
 ACTION(ThrowFbossError) {
   throw FbossError("Mock FbossError");
 }
@@ -0,0 +1,243 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#pragma once
+
+#include <fatal/container/tuple.h>
+#include <folly/io/IOBuf.h>
+#include <folly/io/IOBufQueue.h>
+#include <thrift/lib/cpp/protocol/TType.h>
+#include "fboss/fsdb/if/gen-cpp2/fsdb_oper_types.h"
+#include "fboss/thrift_cow/nodes/Serializer.h"
+#include "fboss/thrift_cow/nodes/Types.h"
+
+#include <memory>
+#include <unordered_map>
+
+namespace facebook::fboss::thrift_cow {
+
+/*
+ * A thrift_cow struct node decoded from serialized bytes, e.g. an FSDB
+ * subscription update, which only deserializes a top level field the first
+ * time it is accessed.
+ *
+ * Construction does a single pass over the buffer, skipping field values to
+ * record where each top level field starts and ends. Accessing a field
+ * decodes just that field, so a consumer that subscribes to a large struct
+ * (e.g. all of switch state) but reads a couple of fields doesn't pay for
+ * deserializing and building COW nodes for the rest of it.
+ *
+ * Only BINARY and COMPACT can be decoded lazily, other protocols are decoded
+ * eagerly on construction. Accessors materialize fields on the fly, so like
+ * an unpublished node this is not thread safe.
+ */
+template <
+    typename TType,
+    typename Resolver = ThriftStructResolver<TType, false>>
+class ThriftLazyStructNode {
+ public:
+  using Node = typename Resolver::type;
+  using Fields = typename Node::Fields;
+  using ThriftType = TType;
+
+  template <typename Name>
+  using TypeFor = typename Fields::template TypeFor<Name>;
+
+  template <typename Name>
+  using ThriftTypeFor = typename Fields::template ThriftTypeFor<Name>;
+
+  ThriftLazyStructNode(fsdb::OperProtocol protocol, folly::IOBuf encoded)
+      : protocol_(protocol),
+        encoded_(std::move(encoded)),
+        node_(std::make_shared<Node>()) {
+    switch (protocol_) {
+      case fsdb::OperProtocol::BINARY:
+        index<fsdb::OperProtocol::BINARY>();
+        break;
+      case fsdb::OperProtocol::COMPACT:
+        index<fsdb::OperProtocol::COMPACT>();
+        break;
+      default:
+        node_->fromEncodedBuf(protocol_, std::move(encoded_));
+        break;
+    }
+  }
+
+  template <typename Name>
+  const TypeFor<Name>& cref() const {
+    materialize<Name>();
+    return node_->template cref<Name>();
+  }
+
+  template <typename Name>
+  bool isSet() const {
+    return pending_.count(idFor<Name>()) || node_->template isSet<Name>();
+  }
+
+  template <typename Name>
+  bool isMaterialized() const {
+    return !pending_.count(idFor<Name>());
+  }
+
+  /*
+   * Thrift value of a single field. Unlike cref(), this does not build COW
+   * nodes for a field that hasn't been accessed yet, which is cheaper for
+   * consumers that only want the thrift object.
+   */
+  template <typename Name>
+  ThriftTypeFor<Name> getThrift() const {
+    auto it = pending_.find(idFor<Name>());
+    if (it != pending_.end()) {
+      auto thrift = decodeField(it->first, it->second);
+      return std::move(*fieldRef<Name>(thrift));
+    }
+    const auto& field = node_->template cref<Name>();
+    if (!field) {
+      return ThriftTypeFor<Name>{};
+    }
+    return field->toThrift();
+  }
+
+  // Decode all remaining fields and return the underlying node
+  std::shared_ptr<Node> materialize() const {
+    if (!pending_.empty()) {
+      fatal::foreach<typename Fields::Members>([&](auto tag) {
+        using member = decltype(fatal::tag_type(tag));
+        materialize<typename member::name>();
+      });
+      // Drop fields unknown to this version of the struct
+      pending_.clear();
+    }
+    return node_;
+  }
+
+  TType toThrift() const {
+    return materialize()->toThrift();
+  }
+
+  size_t numPendingFields() const {
+    return pending_.size();
+  }
+
+ private:
+  // Location of a not yet decoded field in encoded_
+  struct PendingField {
+    apache::thrift::protocol::TType type;
+    size_t begin;
+    size_t end;
+    // Compact protocol encodes bools in the field header, so bools are read
+    // while indexing instead of being decoded from [begin, end).
+    bool boolValue{false};
+  };
+
+  template <typename Name>
+  static constexpr int16_t idFor() {
+    return Fields::template MemberFor<Name>::id::value;
+  }
+
+  template <typename Name>
+  static auto fieldRef(TType& thrift) {
+    return typename Fields::template MemberFor<Name>::field_ref_getter{}(
+        thrift);
+  }
+
+  template <fsdb::OperProtocol Protocol>
+  void index() {
+    using Reader = typename Serializer<Protocol>::Reader;
+    encoded_.coalesce();
+    Reader reader;
+    reader.setInput(&encoded_);
+
+    std::string name;
+    apache::thrift::protocol::TType fieldType;
+    int16_t fieldId;
+    reader.readStructBegin(name);
+    while (true) {
+      reader.readFieldBegin(name, fieldType, fieldId);
+      if (fieldType == apache::thrift::protocol::T_STOP) {
+        break;
+      }
+      PendingField field{fieldType, reader.getCursorPosition(), 0};
+      if (fieldType == apache::thrift::protocol::T_BOOL) {
+        reader.readBool(field.boolValue);
+      } else {
+        reader.skip(fieldType);
+      }
+      field.end = reader.getCursorPosition();
+      reader.readFieldEnd();
+      pending_[fieldId] = field;
+    }
+    reader.readStructEnd();
+  }
+
+  TType decodeField(int16_t id, const PendingField& field) const {
+    switch (protocol_) {
+      case fsdb::OperProtocol::BINARY:
+        return decodeField<fsdb::OperProtocol::BINARY>(id, field);
+      case fsdb::OperProtocol::COMPACT:
+        return decodeField<fsdb::OperProtocol::COMPACT>(id, field);
+      default:
+        throw std::logic_error("Unexpected protocol for lazy decoding");
+    }
+  }
+
+  /*
+   * Decode a struct containing only the given field. Field headers can't be
+   * copied from encoded_ as compact protocol encodes field ids as a delta
+   * from the previous field, so write a fresh header followed by the value
+   * bytes and a field stop.
+   */
+  template <fsdb::OperProtocol Protocol>
+  TType decodeField(int16_t id, const PendingField& field) const {
+    // Field stop is a single zero byte in both binary and compact protocol
+    static constexpr uint8_t kFieldStop = 0;
+
+    folly::IOBufQueue queue;
+    typename Serializer<Protocol>::Writer writer;
+    writer.setOutput(&queue);
+    writer.writeStructBegin("");
+    writer.writeFieldBegin("", field.type, id);
+    auto isBool = field.type == apache::thrift::protocol::T_BOOL;
+    if (isBool) {
+      writer.writeBool(field.boolValue);
+    }
+    auto buf = queue.move();
+
+    if (!isBool) {
+      auto value = encoded_.cloneOne();
+      value->trimStart(field.begin);
+      value->trimEnd(value->length() - (field.end - field.begin));
+      buf->prependChain(std::move(value));
+    }
+    buf->prependChain(folly::IOBuf::copyBuffer(&kFieldStop, 1));
+
+    return Serializer<Protocol>::template deserializeBuf<
+        apache::thrift::type_class::structure,
+        TType>(std::move(*buf));
+  }
+
+  template <typename Name>
+  void materialize() const {
+    auto it = pending_.find(idFor<Name>());
+    if (it == pending_.end()) {
+      return;
+    }
+    auto thrift = decodeField(it->first, it->second);
+    node_->template set<Name>(std::move(*fieldRef<Name>(thrift)));
+    pending_.erase(it);
+  }
+
+  const fsdb::OperProtocol protocol_;
+  folly::IOBuf encoded_;
+  const std::shared_ptr<Node> node_;
+  mutable std::unordered_map<int16_t, PendingField> pending_;
+};
+
+} // namespace facebook::fboss::thrift_cow
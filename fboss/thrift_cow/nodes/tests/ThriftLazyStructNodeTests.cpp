@@ -0,0 +1,119 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/fsdb/if/gen-cpp2/fsdb_oper_types.h"
+#include "fboss/thrift_cow/nodes/Serializer.h"
+#include "fboss/thrift_cow/nodes/ThriftLazyStructNode.h"
+#include "fboss/thrift_cow/nodes/Types.h"
+#include "fboss/thrift_cow/nodes/tests/gen-cpp2/test_fatal_types.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss;
+using namespace facebook::fboss::thrift_cow;
+
+using k = test_tags::strings;
+
+namespace {
+
+TestStruct createTestStruct() {
+  TestStruct data;
+  data.inlineBool() = true;
+  data.inlineInt() = 123;
+  data.inlineString() = "HelloThere";
+  data.inlineStruct()->min() = 10;
+  data.inlineStruct()->max() = 20;
+  data.listOfPrimitives() = {1, 2, 3};
+  data.optionalInt() = 42;
+  data.mapOfStringToI32()["test"] = 1;
+  data.mapA()["a"].inlineString() = "nested";
+  data.mapA()["a"].inlineBool() = true;
+  return data;
+}
+
+ThriftLazyStructNode<TestStruct> lazyDecode(
+    fsdb::OperProtocol protocol,
+    const TestStruct& data) {
+  return ThriftLazyStructNode<TestStruct>(
+      protocol,
+      serializeBuf<apache::thrift::type_class::structure>(protocol, data));
+}
+
+} // namespace
+
+class ThriftLazyStructNodeTests
+    : public ::testing::TestWithParam<fsdb::OperProtocol> {};
+
+TEST_P(ThriftLazyStructNodeTests, MaterializeAll) {
+  auto data = createTestStruct();
+  auto lazy = lazyDecode(GetParam(), data);
+  EXPECT_EQ(lazy.toThrift(), data);
+  EXPECT_EQ(lazy.numPendingFields(), 0);
+  EXPECT_EQ(lazy.materialize()->toThrift(), data);
+}
+
+TEST_P(ThriftLazyStructNodeTests, MaterializeOnAccess) {
+  auto data = createTestStruct();
+  auto lazy = lazyDecode(GetParam(), data);
+  if (GetParam() == fsdb::OperProtocol::SIMPLE_JSON) {
+    // Decoded eagerly
+    EXPECT_EQ(lazy.numPendingFields(), 0);
+    EXPECT_EQ(lazy.toThrift(), data);
+    return;
+  }
+  auto numFields = lazy.numPendingFields();
+  EXPECT_GT(numFields, 0);
+
+  EXPECT_FALSE(lazy.isMaterialized<k::inlineString>());
+  EXPECT_EQ(lazy.cref<k::inlineString>()->toThrift(), *data.inlineString());
+  EXPECT_TRUE(lazy.isMaterialized<k::inlineString>());
+  EXPECT_EQ(lazy.numPendingFields(), numFields - 1);
+
+  EXPECT_EQ(lazy.cref<k::inlineBool>()->toThrift(), true);
+  EXPECT_EQ(lazy.cref<k::mapA>()->toThrift(), *data.mapA());
+  EXPECT_FALSE(lazy.isMaterialized<k::mapOfStringToI32>());
+  EXPECT_EQ(lazy.numPendingFields(), numFields - 3);
+
+  // Remaining fields are still decoded correctly
+  EXPECT_EQ(lazy.toThrift(), data);
+}
+
+TEST_P(ThriftLazyStructNodeTests, GetThrift) {
+  auto data = createTestStruct();
+  auto lazy = lazyDecode(GetParam(), data);
+  auto numFields = lazy.numPendingFields();
+
+  EXPECT_EQ(lazy.getThrift<k::mapA>(), *data.mapA());
+  EXPECT_EQ(lazy.getThrift<k::inlineBool>(), true);
+  // getThrift doesn't build the COW node
+  EXPECT_EQ(lazy.numPendingFields(), numFields);
+
+  lazy.cref<k::mapA>();
+  EXPECT_EQ(lazy.getThrift<k::mapA>(), *data.mapA());
+}
+
+TEST_P(ThriftLazyStructNodeTests, OptionalFields) {
+  auto data = createTestStruct();
+  auto lazy = lazyDecode(GetParam(), data);
+
+  EXPECT_TRUE(lazy.isSet<k::optionalInt>());
+  EXPECT_EQ(lazy.cref<k::optionalInt>()->toThrift(), 42);
+  EXPECT_FALSE(lazy.isSet<k::optionalStruct>());
+  EXPECT_FALSE(lazy.cref<k::optionalStruct>());
+  EXPECT_EQ(lazy.getThrift<k::optionalStruct>(), cfg::L4PortRange{});
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ThriftLazyStructNodeTests,
+    ThriftLazyStructNodeTests,
+    ::testing::Values(
+        fsdb::OperProtocol::BINARY,
+        fsdb::OperProtocol::COMPACT,
+        fsdb::OperProtocol::SIMPLE_JSON));
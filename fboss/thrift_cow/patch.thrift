@@ -11,19 +11,30 @@ namespace go facebook.fboss.thrift_cow
 typedef binary ByteBuffer
 typedef byte Empty
 
+// How compressedChildren is encoded on top of binary serialization
+enum CompressionCodec {
+  NONE = 0,
+  // zstd frame, optionally using a trained dictionary. The dictionary id is
+  // carried in the frame header.
+  ZSTD = 1,
+}
+
 struct StructPatch {
   1: map<i16, PatchNode> children;
   2: optional ByteBuffer compressedChildren;
+  3: CompressionCodec compressionCodec = CompressionCodec.NONE;
 }
 
 struct MapPatch {
   1: map<string, PatchNode> children;
   2: optional ByteBuffer compressedChildren;
+  3: CompressionCodec compressionCodec = CompressionCodec.NONE;
 }
 
 struct ListPatch {
   1: map<i32, PatchNode> children;
   2: optional ByteBuffer compressedChildren;
+  3: CompressionCodec compressionCodec = CompressionCodec.NONE;
 }
 
 // keys for set children are the actual value. PatchNode will be either a val or del
@@ -31,6 +42,7 @@ struct ListPatch {
 struct SetPatch {
   1: map<string, PatchNode> children;
   2: optional ByteBuffer compressedChildren;
+  3: CompressionCodec compressionCodec = CompressionCodec.NONE;
 }
 
 struct VariantPatch {
@@ -359,7 +359,9 @@ struct DeltaVisitor<apache::thrift::type_class::set<ValueTypeClass>> {
 
           hasDifferences = true;
           traverser.push(
-              folly::to<std::string>(val->cref()), TCType<ValueTypeClass>);
+              folly::to<std::string>(val->cref()),
+              toPathToken(val->cref()),
+              TCType<ValueTypeClass>);
           if (auto it = oldFields.find(val); it != oldFields.end()) {
             dv_detail::visitAddedOrRemovedNode<ValueTypeClass>(
                 traverser,
@@ -468,7 +470,8 @@ struct DeltaVisitor<apache::thrift::type_class::list<ValueTypeClass>> {
       hasDifferences = true;
       // loop in reverse order for removals
       for (int i = oldFields.size() - 1; i >= minSize; --i) {
-        traverser.push(folly::to<std::string>(i), TCType<ValueTypeClass>);
+        traverser.push(
+            folly::to<std::string>(i), toPathToken(i), TCType<ValueTypeClass>);
         dv_detail::visitAddedOrRemovedNode<ValueTypeClass>(
             traverser,
             oldFields.at(i),
@@ -480,7 +483,8 @@ struct DeltaVisitor<apache::thrift::type_class::list<ValueTypeClass>> {
     } else if (oldFields.size() < newFields.size()) { // entries added
       hasDifferences = true;
       for (int i = minSize; i < newFields.size(); ++i) {
-        traverser.push(folly::to<std::string>(i), TCType<ValueTypeClass>);
+        traverser.push(
+            folly::to<std::string>(i), toPathToken(i), TCType<ValueTypeClass>);
         dv_detail::visitAddedOrRemovedNode<ValueTypeClass>(
             traverser,
             typename Fields::value_type{},
@@ -495,7 +499,8 @@ struct DeltaVisitor<apache::thrift::type_class::list<ValueTypeClass>> {
       const auto& oldRef = oldFields.at(i);
       const auto& newRef = newFields.at(i);
       if (oldRef != newRef) {
-        traverser.push(folly::to<std::string>(i), TCType<ValueTypeClass>);
+        traverser.push(
+            folly::to<std::string>(i), toPathToken(i), TCType<ValueTypeClass>);
         if (DeltaVisitor<ValueTypeClass>::visit(
                 traverser, oldRef, newRef, options, std::forward<Func>(f))) {
           hasDifferences = true;
@@ -589,7 +594,10 @@ struct DeltaVisitor<
 
     // changed fields
     for (const auto& [key, val] : oldFields) {
-      traverser.push(folly::to<std::string>(key), TCType<MappedTypeClass>);
+      traverser.push(
+          folly::to<std::string>(key),
+          toPathToken(key),
+          TCType<MappedTypeClass>);
       if (auto it = newFields.find(key); it != newFields.end()) {
         if (DeltaVisitor<MappedTypeClass>::visit(
                 traverser, val, it->second, options, std::forward<Func>(f))) {
@@ -608,7 +616,10 @@ struct DeltaVisitor<
         // only look at keys that didn't exist. First loop should handle all
         // replacement deltas
         hasDifferences = true;
-        traverser.push(folly::to<std::string>(key), TCType<MappedTypeClass>);
+        traverser.push(
+            folly::to<std::string>(key),
+            toPathToken(key),
+            TCType<MappedTypeClass>);
 
         dv_detail::visitAddedOrRemovedNode<MappedTypeClass>(
             traverser, decltype(val){}, val, options, std::forward<Func>(f));
@@ -649,7 +660,10 @@ struct DeltaVisitor<
         // unchanged entry
         continue;
       }
-      traverser.push(folly::to<std::string>(key), TCType<MappedTypeClass>);
+      traverser.push(
+          folly::to<std::string>(key),
+          toPathToken(key),
+          TCType<MappedTypeClass>);
       if (it == newRef.end()) {
         // deleted entry
         hasDifferences = true;
@@ -676,7 +690,10 @@ struct DeltaVisitor<
     for (const auto& [key, val] : newRef) {
       if (oldRef.find(key) == oldRef.end()) {
         hasDifferences = true;
-        traverser.push(folly::to<std::string>(key), TCType<MappedTypeClass>);
+        traverser.push(
+            folly::to<std::string>(key),
+            toPathToken(key),
+            TCType<MappedTypeClass>);
 
         dv_detail::invokeVisitorFnHelper(
             traverser,
@@ -754,7 +771,11 @@ struct DeltaVisitor<apache::thrift::type_class::variant> {
                   getMemberName<typename descriptor::metadata>(
                       options.outputIdPaths);
 
-              traverser.push(std::move(memberName), TCType<tc>);
+              traverser.push(
+                  std::move(memberName),
+                  getMemberToken<typename descriptor::metadata>(
+                      options.outputIdPaths),
+                  TCType<tc>);
 
               const auto& oldRef = oldFields.template cref<name>();
 
@@ -780,7 +801,11 @@ struct DeltaVisitor<apache::thrift::type_class::variant> {
                   getMemberName<typename descriptor::metadata>(
                       options.outputIdPaths);
 
-              traverser.push(std::move(memberName), TCType<tc>);
+              traverser.push(
+                  std::move(memberName),
+                  getMemberToken<typename descriptor::metadata>(
+                      options.outputIdPaths),
+                  TCType<tc>);
 
               const auto& newRef = newFields.template cref<name>();
 
@@ -806,7 +831,11 @@ struct DeltaVisitor<apache::thrift::type_class::variant> {
                 getMemberName<typename descriptor::metadata>(
                     options.outputIdPaths);
 
-            traverser.push(std::move(memberName), TCType<tc>);
+            traverser.push(
+                std::move(memberName),
+                getMemberToken<typename descriptor::metadata>(
+                    options.outputIdPaths),
+                TCType<tc>);
             hasDifferences = DeltaVisitor<tc>::visit(
                 traverser,
                 oldFields.template cref<name>(),
@@ -908,7 +937,10 @@ struct DeltaVisitor<apache::thrift::type_class::structure> {
       // Look for the expected member name
       std::string memberName = getMemberName<member>(options.outputIdPaths);
 
-      traverser.push(std::move(memberName), TCType<tc>);
+      traverser.push(
+          std::move(memberName),
+          getMemberToken<member>(options.outputIdPaths),
+          TCType<tc>);
       SCOPE_EXIT {
         traverser.pop(TCType<tc>);
       };
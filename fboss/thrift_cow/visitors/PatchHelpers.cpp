@@ -3,9 +3,131 @@
 #include "fboss/thrift_cow/visitors/PatchHelpers.h"
 #include "fboss/thrift_cow/gen-cpp2/patch_visitation.h"
 
+#include <folly/FileUtil.h>
+#include <folly/Synchronized.h>
+#include <folly/logging/xlog.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
+#include <zdict.h>
+#include <zstd.h>
+
+#include <filesystem>
+#include <map>
 
 namespace {
+using facebook::fboss::thrift_cow::CompressionCodec;
+using facebook::fboss::thrift_cow::PatchCompressionDictionary;
+using facebook::fboss::thrift_cow::PatchCompressionOptions;
+using facebook::fboss::thrift_cow::PatchCompressionResult;
+
+constexpr auto kDictionaryExtension = ".zdict";
+// Upper bound on the decompressed size of a patch, so a corrupt or
+// malicious frame header can't make us allocate arbitrary amounts of memory
+constexpr unsigned long long kMaxDecompressedPatchSize = 512 * 1024 * 1024;
+
+struct DictionaryRegistry {
+  std::map<std::string, std::shared_ptr<const PatchCompressionDictionary>>
+      byName;
+  std::map<uint32_t, std::shared_ptr<const PatchCompressionDictionary>> byId;
+};
+
+folly::Synchronized<DictionaryRegistry>& dictionaryRegistry() {
+  static folly::Synchronized<DictionaryRegistry> registry;
+  return registry;
+}
+
+// zstd contexts are expensive to create, keep one per thread
+ZSTD_CCtx* threadCCtx() {
+  thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> cctx(
+      ZSTD_createCCtx(), &ZSTD_freeCCtx);
+  return cctx.get();
+}
+
+ZSTD_DCtx* threadDCtx() {
+  thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> dctx(
+      ZSTD_createDCtx(), &ZSTD_freeDCtx);
+  return dctx.get();
+}
+
+void checkZstd(size_t ret, const char* op) {
+  if (ZSTD_isError(ret)) {
+    throw std::runtime_error(
+        std::string("zstd ") + op + " failed: " + ZSTD_getErrorName(ret));
+  }
+}
+
+folly::IOBuf zstdCompress(
+    folly::IOBuf& in,
+    const PatchCompressionDictionary* dictionary) {
+  in.coalesce();
+  auto bound = ZSTD_compressBound(in.length());
+  auto out = folly::IOBuf::create(bound);
+  size_t ret;
+  if (dictionary) {
+    ret = ZSTD_compress_usingCDict(
+        threadCCtx(),
+        out->writableData(),
+        bound,
+        in.data(),
+        in.length(),
+        dictionary->cdict());
+  } else {
+    ret = ZSTD_compressCCtx(
+        threadCCtx(),
+        out->writableData(),
+        bound,
+        in.data(),
+        in.length(),
+        PatchCompressionDictionary::kDefaultLevel);
+  }
+  checkZstd(ret, "compress");
+  out->append(ret);
+  return std::move(*out);
+}
+
+folly::IOBuf zstdDecompress(folly::IOBuf& in) {
+  in.coalesce();
+  auto contentSize = ZSTD_getFrameContentSize(in.data(), in.length());
+  if (contentSize == ZSTD_CONTENTSIZE_UNKNOWN ||
+      contentSize == ZSTD_CONTENTSIZE_ERROR) {
+    throw std::runtime_error("Invalid zstd frame in compressed patch");
+  }
+  if (contentSize > kMaxDecompressedPatchSize) {
+    throw std::runtime_error(
+        "Compressed patch too large: " + std::to_string(contentSize) +
+        " bytes decompressed");
+  }
+  auto out = folly::IOBuf::create(contentSize);
+  size_t ret;
+  if (auto dictId = ZSTD_getDictID_fromFrame(in.data(), in.length())) {
+    auto dictionary =
+        facebook::fboss::thrift_cow::getPatchCompressionDictionary(dictId);
+    if (!dictionary) {
+      throw std::runtime_error(
+          "Unknown patch compression dictionary id " + std::to_string(dictId));
+    }
+    ret = ZSTD_decompress_usingDDict(
+        threadDCtx(),
+        out->writableData(),
+        contentSize,
+        in.data(),
+        in.length(),
+        dictionary->ddict());
+  } else {
+    ret = ZSTD_decompressDCtx(
+        threadDCtx(),
+        out->writableData(),
+        contentSize,
+        in.data(),
+        in.length());
+  }
+  checkZstd(ret, "decompress");
+  if (ret != contentSize) {
+    throw std::runtime_error("Truncated zstd frame in compressed patch");
+  }
+  out->append(ret);
+  return std::move(*out);
+}
+
 template <typename Patch>
 void compressChildren(Patch& patch) {
   auto buf = apache::thrift::BinarySerializer::serialize<folly::IOBufQueue>(
@@ -14,6 +136,27 @@ void compressChildren(Patch& patch) {
   patch.children() = {};
 }
 
+template <typename Patch>
+std::optional<PatchCompressionResult> compressChildren(
+    Patch& patch,
+    const PatchCompressionOptions& options) {
+  if (*patch.compressionCodec() != CompressionCodec::NONE) {
+    return std::nullopt;
+  }
+  if (!patch.compressedChildren().has_value()) {
+    compressChildren(patch);
+  }
+  PatchCompressionResult result;
+  result.serializedBytes = patch.compressedChildren()->computeChainDataLength();
+  if (options.codec == CompressionCodec::ZSTD) {
+    patch.compressedChildren() =
+        zstdCompress(*patch.compressedChildren(), options.dictionary.get());
+    patch.compressionCodec() = CompressionCodec::ZSTD;
+  }
+  result.compressedBytes = patch.compressedChildren()->computeChainDataLength();
+  return result;
+}
+
 template <typename Patch>
 void decompressChildren(Patch& patch) {
   using ChildrenType = decltype(*patch.children());
@@ -23,6 +166,10 @@ void decompressChildren(Patch& patch) {
   // All children should have been compressed
   DCHECK(patch.children()->size() == 0);
   auto buf = std::move(*patch.compressedChildren());
+  if (*patch.compressionCodec() == CompressionCodec::ZSTD) {
+    buf = zstdDecompress(buf);
+  }
+  patch.compressionCodec() = CompressionCodec::NONE;
   apache::thrift::BinarySerializer::deserialize<ChildrenType>(
       &buf,
       *patch.children(),
@@ -32,6 +179,117 @@ void decompressChildren(Patch& patch) {
 
 namespace facebook::fboss::thrift_cow {
 
+PatchCompressionDictionary::PatchCompressionDictionary(
+    std::string dictionary,
+    int level)
+    : dictionary_(std::move(dictionary)),
+      level_(level),
+      id_(ZSTD_getDictID_fromDict(dictionary_.data(), dictionary_.size())) {
+  // Decompression relies on the id in the frame header to find the dictionary
+  if (id_ == 0) {
+    throw std::invalid_argument("Not a trained zstd dictionary");
+  }
+  cdict_ = ZSTD_createCDict(dictionary_.data(), dictionary_.size(), level_);
+  ddict_ = ZSTD_createDDict(dictionary_.data(), dictionary_.size());
+  if (!cdict_ || !ddict_) {
+    ZSTD_freeCDict(cdict_);
+    ZSTD_freeDDict(ddict_);
+    throw std::runtime_error("Failed to load zstd dictionary");
+  }
+}
+
+PatchCompressionDictionary::~PatchCompressionDictionary() {
+  ZSTD_freeCDict(cdict_);
+  ZSTD_freeDDict(ddict_);
+}
+
+std::shared_ptr<PatchCompressionDictionary> PatchCompressionDictionary::train(
+    const std::vector<PatchNode>& samples,
+    size_t maxSize,
+    int level) {
+  std::string samplesBuffer;
+  std::vector<size_t> sampleSizes;
+  sampleSizes.reserve(samples.size());
+  for (const auto& sample : samples) {
+    auto serialized =
+        apache::thrift::BinarySerializer::serialize<std::string>(sample);
+    samplesBuffer.append(serialized);
+    sampleSizes.push_back(serialized.size());
+  }
+  std::string dictionary(maxSize, '\0');
+  auto size = ZDICT_trainFromBuffer(
+      dictionary.data(),
+      dictionary.size(),
+      samplesBuffer.data(),
+      sampleSizes.data(),
+      sampleSizes.size());
+  if (ZDICT_isError(size)) {
+    throw std::runtime_error(
+        std::string("Failed to train patch compression dictionary: ") +
+        ZDICT_getErrorName(size));
+  }
+  dictionary.resize(size);
+  return std::make_shared<PatchCompressionDictionary>(
+      std::move(dictionary), level);
+}
+
+void registerPatchCompressionDictionary(
+    const std::string& name,
+    std::shared_ptr<const PatchCompressionDictionary> dictionary) {
+  auto registry = dictionaryRegistry().wlock();
+  registry->byId[dictionary->id()] = dictionary;
+  registry->byName[name] = std::move(dictionary);
+}
+
+std::shared_ptr<const PatchCompressionDictionary>
+getPatchCompressionDictionary(const std::string& name) {
+  auto registry = dictionaryRegistry().rlock();
+  auto it = registry->byName.find(name);
+  return it == registry->byName.end() ? nullptr : it->second;
+}
+
+std::shared_ptr<const PatchCompressionDictionary>
+getPatchCompressionDictionary(uint32_t id) {
+  auto registry = dictionaryRegistry().rlock();
+  auto it = registry->byId.find(id);
+  return it == registry->byId.end() ? nullptr : it->second;
+}
+
+std::vector<uint32_t> getPatchCompressionDictionaryIds() {
+  auto registry = dictionaryRegistry().rlock();
+  std::vector<uint32_t> ids;
+  ids.reserve(registry->byId.size());
+  for (const auto& [id, _] : registry->byId) {
+    ids.push_back(id);
+  }
+  return ids;
+}
+
+size_t loadPatchCompressionDictionaries(const std::string& dir) {
+  size_t loaded = 0;
+  for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+    if (!entry.is_regular_file() ||
+        entry.path().extension() != kDictionaryExtension) {
+      continue;
+    }
+    std::string bytes;
+    if (!folly::readFile(entry.path().c_str(), bytes)) {
+      throw std::runtime_error(
+          "Failed to read patch compression dictionary " +
+          entry.path().string());
+    }
+    auto name = entry.path().stem().string();
+    auto dictionary =
+        std::make_shared<PatchCompressionDictionary>(std::move(bytes));
+    XLOG(INFO) << "Loaded patch compression dictionary " << name
+               << ", id: " << dictionary->id()
+               << ", size: " << dictionary->bytes().size();
+    registerPatchCompressionDictionary(name, std::move(dictionary));
+    ++loaded;
+  }
+  return loaded;
+}
+
 void compressPatch(PatchNode& node) {
   apache::thrift::visit_union(
       node,
@@ -49,6 +307,31 @@ void compressPatch(PatchNode& node) {
       });
 }
 
+std::optional<PatchCompressionResult> compressPatch(
+    PatchNode& node,
+    const PatchCompressionOptions& options) {
+  std::optional<PatchCompressionResult> result;
+  apache::thrift::visit_union(
+      node,
+      [&](const apache::thrift::metadata::ThriftField& /* meta */,
+          auto& patch) {
+        auto compress = folly::overload(
+            [](Empty& /* b */) {},
+            [](ByteBuffer& /* b */) {},
+            [&](StructPatch& patch) {
+              result = compressChildren(patch, options);
+            },
+            [&](ListPatch& patch) {
+              result = compressChildren(patch, options);
+            },
+            [&](MapPatch& patch) { result = compressChildren(patch, options); },
+            [&](SetPatch& patch) { result = compressChildren(patch, options); },
+            [&](VariantPatch& patch) {});
+        compress(patch);
+      });
+  return result;
+}
+
 void decompressPatch(PatchNode& node) {
   apache::thrift::visit_union(
       node,
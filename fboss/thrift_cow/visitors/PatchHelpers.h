@@ -2,14 +2,123 @@
 
 #include "fboss/thrift_cow/gen-cpp2/patch_types.h"
 
+#include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 #pragma once
 
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
 namespace facebook::fboss::thrift_cow {
 
+/*
+ * zstd dictionary for patch compression. Patches of the same root (e.g. agent
+ * stats) repeat the same field ids and keys every cycle, so a dictionary
+ * trained on past patches of that root compresses much better than plain
+ * zstd, especially for the small per-interval patches.
+ *
+ * Publisher and subscribers must use the same dictionary. It is identified
+ * by the zstd dictionary id, which is embedded in every compressed frame, so
+ * decompression looks it up in the registry below.
+ */
+class PatchCompressionDictionary {
+ public:
+  static constexpr int kDefaultLevel = 3;
+
+  explicit PatchCompressionDictionary(
+      std::string dictionary,
+      int level = kDefaultLevel);
+  ~PatchCompressionDictionary();
+
+  PatchCompressionDictionary(const PatchCompressionDictionary&) = delete;
+  PatchCompressionDictionary& operator=(const PatchCompressionDictionary&) =
+      delete;
+
+  // Train a dictionary of at most maxSize bytes on the binary serialized
+  // samples. Only children get compressed, but they make up most of a
+  // serialized patch, so whole past patches of a root are good samples.
+  static std::shared_ptr<PatchCompressionDictionary> train(
+      const std::vector<PatchNode>& samples,
+      size_t maxSize = 64 * 1024,
+      int level = kDefaultLevel);
+
+  uint32_t id() const {
+    return id_;
+  }
+
+  int level() const {
+    return level_;
+  }
+
+  const std::string& bytes() const {
+    return dictionary_;
+  }
+
+  const ZSTD_CDict_s* cdict() const {
+    return cdict_;
+  }
+
+  const ZSTD_DDict_s* ddict() const {
+    return ddict_;
+  }
+
+ private:
+  std::string dictionary_;
+  int level_;
+  uint32_t id_;
+  ZSTD_CDict_s* cdict_;
+  ZSTD_DDict_s* ddict_;
+};
+
+// Process wide dictionary registry, keyed both by name (used to pick the
+// dictionary for a root when compressing) and by id (used to decompress).
+void registerPatchCompressionDictionary(
+    const std::string& name,
+    std::shared_ptr<const PatchCompressionDictionary> dictionary);
+
+std::shared_ptr<const PatchCompressionDictionary>
+getPatchCompressionDictionary(const std::string& name);
+
+std::shared_ptr<const PatchCompressionDictionary>
+getPatchCompressionDictionary(uint32_t id);
+
+// Ids of all registered dictionaries, advertised by subscribers so the
+// server only compresses with a dictionary they can decompress with.
+std::vector<uint32_t> getPatchCompressionDictionaryIds();
+
+// Register every <name>.zdict file in dir under <name>. Returns the number of
+// dictionaries loaded.
+size_t loadPatchCompressionDictionaries(const std::string& dir);
+
+struct PatchCompressionOptions {
+  CompressionCodec codec{CompressionCodec::NONE};
+  // Only used with ZSTD, plain zstd if null
+  std::shared_ptr<const PatchCompressionDictionary> dictionary;
+};
+
+struct PatchCompressionResult {
+  // Size of the binary serialized children
+  size_t serializedBytes{0};
+  // Size of compressedChildren after applying the codec
+  size_t compressedBytes{0};
+};
+
+// Serialize the children of node into compressedChildren
 void compressPatch(PatchNode& node);
 
+/*
+ * Serialize the children of node, if not already done, and compress them
+ * with the given codec. Returns std::nullopt if node has no children to
+ * compress (e.g. a leaf value) or was already compressed with a codec.
+ */
+std::optional<PatchCompressionResult> compressPatch(
+    PatchNode& node,
+    const PatchCompressionOptions& options);
+
+// Inverse of compressPatch, for any codec
 void decompressPatch(PatchNode& node);
 
 } // namespace facebook::fboss::thrift_cow
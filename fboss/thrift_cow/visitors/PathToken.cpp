@@ -0,0 +1,95 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include "fboss/thrift_cow/visitors/PathToken.h"
+
+#include <folly/Conv.h>
+#include <folly/SharedMutex.h>
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+namespace facebook::fboss::thrift_cow {
+
+namespace {
+
+struct InternTable {
+  folly::F14FastMap<std::string, int64_t> ids;
+  std::vector<std::string> names;
+};
+
+using SyncedInternTable = folly::Synchronized<InternTable, folly::SharedMutex>;
+
+SyncedInternTable& internTable() {
+  // leaked, tokens may be used from static destructors
+  static auto* table = new SyncedInternTable();
+  return *table;
+}
+
+} // namespace
+
+std::optional<int64_t> PathToken::parseInt(std::string_view tok) {
+  auto digits = tok.substr(!tok.empty() && tok.front() == '-' ? 1 : 0);
+  if (digits.empty() || (digits.front() == '0' && tok.size() > 1)) {
+    return std::nullopt;
+  }
+  for (auto c : digits) {
+    if (c < '0' || c > '9') {
+      return std::nullopt;
+    }
+  }
+  auto value = folly::tryTo<int64_t>(tok);
+  if (value.hasError()) {
+    return std::nullopt;
+  }
+  return *value;
+}
+
+PathToken PathToken::intern(std::string_view tok) {
+  if (auto value = parseInt(tok)) {
+    return PathToken(*value);
+  }
+  if (auto token = find(tok); token.isResolved()) {
+    return token;
+  }
+  auto table = internTable().wlock();
+  auto [it, inserted] =
+      table->ids.emplace(std::string(tok), table->names.size());
+  if (inserted) {
+    table->names.emplace_back(tok);
+  }
+  return PathToken(it->second, Kind::INTERNED);
+}
+
+PathToken PathToken::find(std::string_view tok) {
+  if (auto value = parseInt(tok)) {
+    return PathToken(*value);
+  }
+  auto table = internTable().rlock();
+  if (auto it = table->ids.find(tok); it != table->ids.end()) {
+    return PathToken(it->second, Kind::INTERNED);
+  }
+  return PathToken();
+}
+
+std::vector<PathToken> PathToken::intern(
+    const std::vector<std::string>& path) {
+  std::vector<PathToken> tokens;
+  tokens.reserve(path.size());
+  for (const auto& tok : path) {
+    tokens.push_back(intern(tok));
+  }
+  return tokens;
+}
+
+std::string PathToken::str() const {
+  switch (kind_) {
+    case Kind::INT:
+      return folly::to<std::string>(value_);
+    case Kind::INTERNED:
+      return internTable().rlock()->names.at(value_);
+    case Kind::UNRESOLVED:
+      break;
+  }
+  return "<unresolved>";
+}
+
+} // namespace facebook::fboss::thrift_cow
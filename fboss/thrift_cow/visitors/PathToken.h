@@ -0,0 +1,103 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#pragma once
+
+#include <folly/Utility.h>
+#include <folly/hash/Hash.h>
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace facebook::fboss::thrift_cow {
+
+/*
+ * Compact form of one path token, compared and hashed without touching
+ * strings. Tokens that are integers in canonical form, i.e. struct field
+ * ids, integer and enum map keys and list indices, are kept as the integer.
+ * Any other token is interned once in a process wide, append only table and
+ * kept as its index there.
+ *
+ * A default constructed token is unresolved: it was not interned or was
+ * pushed as a plain string, see TraverseHelper::lastToken(). Unresolved
+ * tokens never match a token that was interned.
+ */
+class PathToken {
+ public:
+  PathToken() = default;
+  explicit PathToken(int64_t value) : value_(value), kind_(Kind::INT) {}
+
+  // For tokens stored in lookup structures, e.g. subscribed paths
+  static PathToken intern(std::string_view tok);
+
+  // For tokens only looked up, never interns
+  static PathToken find(std::string_view tok);
+
+  static std::vector<PathToken> intern(const std::vector<std::string>& path);
+
+  // canonical decimal form only, so "01" or "+1" stay strings
+  static std::optional<int64_t> parseInt(std::string_view tok);
+
+  bool isResolved() const {
+    return kind_ != Kind::UNRESOLVED;
+  }
+
+  std::string str() const;
+
+  size_t hash() const {
+    return folly::hash::hash_128_to_64(
+        static_cast<uint64_t>(kind_), static_cast<uint64_t>(value_));
+  }
+
+  bool operator==(const PathToken& other) const {
+    return value_ == other.value_ && kind_ == other.kind_;
+  }
+  bool operator!=(const PathToken& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  enum class Kind : uint8_t { UNRESOLVED, INT, INTERNED };
+
+  PathToken(int64_t value, Kind kind) : value_(value), kind_(kind) {}
+
+  int64_t value_{0};
+  Kind kind_{Kind::UNRESOLVED};
+};
+
+/*
+ * Token of a map key or list index, matching PathToken::find() of the
+ * folly::to<std::string>() form the visitors push. Non integer keys are left
+ * unresolved, to be looked up from the string only if needed.
+ */
+template <typename T>
+PathToken toPathToken(const T& key) {
+  if constexpr (std::is_enum_v<T>) {
+    return toPathToken(folly::to_underlying(key));
+  } else if constexpr (std::is_integral_v<T>) {
+    if constexpr (std::is_unsigned_v<T> && sizeof(T) == sizeof(int64_t)) {
+      if (key > static_cast<T>(std::numeric_limits<int64_t>::max())) {
+        return PathToken();
+      }
+    }
+    return PathToken(static_cast<int64_t>(key));
+  } else {
+    return PathToken();
+  }
+}
+
+} // namespace facebook::fboss::thrift_cow
+
+namespace std {
+template <>
+struct hash<facebook::fboss::thrift_cow::PathToken> {
+  size_t operator()(const facebook::fboss::thrift_cow::PathToken& token) const {
+    return token.hash();
+  }
+};
+} // namespace std
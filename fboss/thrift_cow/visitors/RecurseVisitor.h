@@ -178,7 +178,9 @@ struct RecurseVisitor<apache::thrift::type_class::set<ValueTypeClass>> {
   {
     for (auto& val : fields) {
       traverser.push(
-          folly::to<std::string>(val->cref()), TCType<ValueTypeClass>);
+          folly::to<std::string>(val->cref()),
+          toPathToken(val->cref()),
+          TCType<ValueTypeClass>);
       rv_detail::invokeVisitorFnHelper(
           traverser, typename Fields::value_type{val}, std::forward<Func>(f));
       traverser.pop(TCType<ValueTypeClass>);
@@ -231,7 +233,8 @@ struct RecurseVisitor<apache::thrift::type_class::list<ValueTypeClass>> {
     }
     // visit list elements
     for (int i = 0; i < tObj.size(); ++i) {
-      traverser.push(folly::to<std::string>(i), TCType<ValueTypeClass>);
+      traverser.push(
+          folly::to<std::string>(i), toPathToken(i), TCType<ValueTypeClass>);
       rv_detail::invokeVisitorFnHelper(
           traverser, &tObj.at(i), std::forward<Func>(f));
       traverser.pop(TCType<ValueTypeClass>);
@@ -252,7 +255,8 @@ struct RecurseVisitor<apache::thrift::type_class::list<ValueTypeClass>> {
     requires(std::is_same_v<typename Fields::CowType, FieldsType>)
   {
     for (int i = 0; i < fields.size(); ++i) {
-      traverser.push(folly::to<std::string>(i), TCType<ValueTypeClass>);
+      traverser.push(
+          folly::to<std::string>(i), toPathToken(i), TCType<ValueTypeClass>);
       RecurseVisitor<ValueTypeClass>::visit(
           traverser, fields.ref(i), options, std::forward<Func>(f));
       traverser.pop(TCType<ValueTypeClass>);
@@ -307,14 +311,20 @@ struct RecurseVisitor<
     // visit map entries
     if constexpr (std::is_const_v<NodePtr>) {
       for (const auto& [key, val] : tObj) {
-        traverser.push(folly::to<std::string>(key), TCType<MappedTypeClass>);
+        traverser.push(
+            folly::to<std::string>(key),
+            toPathToken(key),
+            TCType<MappedTypeClass>);
         rv_detail::invokeVisitorFnHelper(
             traverser, &val, std::forward<Func>(f));
         traverser.pop(TCType<MappedTypeClass>);
       }
     } else {
       for (auto& [key, val] : tObj) {
-        traverser.push(folly::to<std::string>(key), TCType<MappedTypeClass>);
+        traverser.push(
+            folly::to<std::string>(key),
+            toPathToken(key),
+            TCType<MappedTypeClass>);
         rv_detail::invokeVisitorFnHelper(
             traverser, &val, std::forward<Func>(f));
         traverser.pop(TCType<MappedTypeClass>);
@@ -337,14 +347,20 @@ struct RecurseVisitor<
   {
     if constexpr (std::is_const_v<Fields>) {
       for (const auto& [key, val] : fields) {
-        traverser.push(folly::to<std::string>(key), TCType<MappedTypeClass>);
+        traverser.push(
+            folly::to<std::string>(key),
+            toPathToken(key),
+            TCType<MappedTypeClass>);
         RecurseVisitor<MappedTypeClass>::visit(
             traverser, val, options, std::forward<Func>(f));
         traverser.pop(TCType<MappedTypeClass>);
       }
     } else {
       for (auto& [key, val] : fields) {
-        traverser.push(folly::to<std::string>(key), TCType<MappedTypeClass>);
+        traverser.push(
+            folly::to<std::string>(key),
+            toPathToken(key),
+            TCType<MappedTypeClass>);
         RecurseVisitor<MappedTypeClass>::visit(
             traverser, val, options, std::forward<Func>(f));
         traverser.pop(TCType<MappedTypeClass>);
@@ -412,7 +428,11 @@ struct RecurseVisitor<apache::thrift::type_class::variant> {
           std::string memberName = getMemberName<typename descriptor::metadata>(
               options.outputIdPaths);
 
-          traverser.push(std::move(memberName), TCType<tc>);
+          traverser.push(
+              std::move(memberName),
+              getMemberToken<typename descriptor::metadata>(
+                  options.outputIdPaths),
+              TCType<tc>);
 
           if constexpr (std::is_const_v<Fields>) {
             const auto& ref = fields.template cref<name>();
@@ -502,7 +522,10 @@ struct RecurseVisitor<apache::thrift::type_class::structure> {
       // Look for the expected member name
       std::string memberName = getMemberName<member>(options.outputIdPaths);
 
-      traverser.push(std::move(memberName), TCType<tc>);
+      traverser.push(
+          std::move(memberName),
+          getMemberToken<member>(options.outputIdPaths),
+          TCType<tc>);
 
       if constexpr (std::is_const_v<Fields>) {
         const auto& ref = fields.template cref<name>();
@@ -0,0 +1,330 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#pragma once
+
+#include <fboss/fsdb/if/gen-cpp2/fsdb_oper_types.h>
+#include <fboss/thrift_cow/gen-cpp2/patch_types.h>
+
+#include <folly/Conv.h>
+#include <folly/io/IOBufQueue.h>
+#include <thrift/lib/cpp/util/EnumUtils.h>
+#include <thrift/lib/cpp2/op/Encode.h>
+#include <thrift/lib/cpp2/op/Get.h>
+#include <thrift/lib/cpp2/protocol/BinaryProtocol.h>
+#include <thrift/lib/cpp2/protocol/CompactProtocol.h>
+
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace facebook::fboss::thrift_cow {
+
+namespace opb_detail {
+
+namespace op = apache::thrift::op;
+namespace type = apache::thrift::type;
+
+// Strip cpp.Type annotations, e.g. F14FastMap instead of std::map
+template <typename Tag>
+struct Standard {
+  using type = Tag;
+};
+template <typename T, typename Tag>
+struct Standard<type::cpp_type<T, Tag>> {
+  using type = Tag;
+};
+template <typename Tag>
+using standard_t = typename Standard<Tag>::type;
+
+template <typename Tag>
+constexpr bool kIsStruct = false;
+template <typename T>
+constexpr bool kIsStruct<type::struct_t<T>> = true;
+
+template <typename Tag>
+struct MapTags {
+  static constexpr bool value = false;
+};
+template <typename KeyTag, typename MappedTag>
+struct MapTags<type::map<KeyTag, MappedTag>> {
+  static constexpr bool value = true;
+  using key = KeyTag;
+  using mapped = MappedTag;
+};
+
+// Map keys that PatchApplier can parse back, see tryParseKey
+template <typename KeyTag>
+constexpr bool kIsSupportedKey =
+    std::is_same_v<standard_t<KeyTag>, type::string_t> ||
+    std::is_same_v<standard_t<KeyTag>, type::byte_t> ||
+    std::is_same_v<standard_t<KeyTag>, type::i16_t> ||
+    std::is_same_v<standard_t<KeyTag>, type::i32_t> ||
+    std::is_same_v<standard_t<KeyTag>, type::i64_t> ||
+    type::is_a_v<KeyTag, type::enum_c>;
+
+template <typename KeyTag, typename KeyT>
+std::string keyToString(const KeyT& key) {
+  if constexpr (type::is_a_v<KeyTag, type::enum_c>) {
+    return apache::thrift::util::enumNameSafe(key);
+  } else if constexpr (std::is_same_v<standard_t<KeyTag>, type::string_t>) {
+    return std::string(key);
+  } else {
+    return folly::to<std::string>(key);
+  }
+}
+
+template <typename Ref>
+constexpr bool kIsFieldRef = false;
+template <typename T>
+constexpr bool kIsFieldRef<apache::thrift::field_ref<T>> = true;
+
+// Always present integer, bool and enum fields. These are compared as flat
+// int64 arrays instead of one field at a time.
+template <typename S, typename Id>
+constexpr bool kIsFlatField =
+    kIsFieldRef<decltype(op::get<Id, S>(std::declval<const S&>()))> &&
+    (type::is_a_v<op::get_type_tag<S, Id>, type::integral_c> ||
+     type::is_a_v<op::get_type_tag<S, Id>, type::enum_c>);
+
+template <typename S, size_t... I>
+constexpr auto flatOrdinals(std::index_sequence<I...>) {
+  constexpr size_t kCount =
+      (size_t{kIsFlatField<S, type::ordinal<I + 1>>} + ... + 0);
+  std::array<size_t, kCount> ordinals{};
+  size_t pos = 0;
+  ((kIsFlatField<S, type::ordinal<I + 1>> ? (void)(ordinals[pos++] = I + 1)
+                                          : void()),
+   ...);
+  return ordinals;
+}
+
+template <typename S>
+inline constexpr auto kFlatOrdinals =
+    flatOrdinals<S>(std::make_index_sequence<op::size_v<S>>{});
+
+template <typename S, size_t J>
+using flat_id_t = type::ordinal<kFlatOrdinals<S>[J]>;
+
+template <typename S, typename Id>
+int16_t fieldId() {
+  return static_cast<int16_t>(op::get_field_id_v<S, Id>);
+}
+
+template <typename Writer, typename Tag, typename T>
+folly::IOBuf encode(const T& value) {
+  folly::IOBufQueue queue(folly::IOBufQueue::cacheChainLength());
+  Writer writer;
+  writer.setOutput(&queue);
+  op::encode<Tag>(writer, value);
+  return queue.moveAsValue();
+}
+
+template <typename Writer, typename Tag, typename T>
+bool diff(const T& before, const T& after, PatchNode& patch);
+
+template <typename S, size_t... J>
+void gather(const S& obj, int64_t* out, std::index_sequence<J...>) {
+  ((out[J] = static_cast<int64_t>(*op::get<flat_id_t<S, J>, S>(obj))), ...);
+}
+
+template <typename Writer, typename S, size_t J>
+void addFlatField(const S& after, StructPatch& patch) {
+  using Id = flat_id_t<S, J>;
+  PatchNode child;
+  child.set_val(encode<Writer, op::get_type_tag<S, Id>>(
+      *op::get<Id, S>(after)));
+  patch.children()->emplace(fieldId<S, Id>(), std::move(child));
+}
+
+template <typename Writer, typename S, size_t... J>
+void diffFlatFields(
+    const S& before,
+    const S& after,
+    StructPatch& patch,
+    std::index_sequence<J...>) {
+  constexpr size_t kCount = sizeof...(J);
+  if constexpr (kCount > 0) {
+    std::array<int64_t, kCount> old;
+    std::array<int64_t, kCount> cur;
+    gather(before, old.data(), std::index_sequence<J...>{});
+    gather(after, cur.data(), std::index_sequence<J...>{});
+    if (std::memcmp(old.data(), cur.data(), sizeof(old)) == 0) {
+      return;
+    }
+    // Branch free so the compiler can vectorize it
+    std::array<uint8_t, kCount> changed;
+    for (size_t i = 0; i < kCount; ++i) {
+      changed[i] = old[i] != cur[i];
+    }
+    ((changed[J] ? addFlatField<Writer, S, J>(after, patch) : void()), ...);
+  }
+}
+
+template <typename Writer, typename S, typename Id>
+void diffField(const S& before, const S& after, StructPatch& patch) {
+  if constexpr (!kIsFlatField<S, Id>) {
+    using Tag = op::get_type_tag<S, Id>;
+    const auto* old = op::getValueOrNull(op::get<Id, S>(before));
+    const auto* cur = op::getValueOrNull(op::get<Id, S>(after));
+    if (!old && !cur) {
+      return;
+    }
+    PatchNode child;
+    if (!cur) {
+      child.set_del();
+    } else if (!old) {
+      child.set_val(encode<Writer, Tag>(*cur));
+    } else if (!diff<Writer, Tag>(*old, *cur, child)) {
+      return;
+    }
+    patch.children()->emplace(fieldId<S, Id>(), std::move(child));
+  }
+}
+
+template <typename Writer, typename S, size_t... I>
+void diffFields(
+    const S& before,
+    const S& after,
+    StructPatch& patch,
+    std::index_sequence<I...>) {
+  (diffField<Writer, S, type::ordinal<I + 1>>(before, after, patch), ...);
+}
+
+template <typename Writer, typename S>
+void diffStruct(const S& before, const S& after, StructPatch& patch) {
+  diffFlatFields<Writer>(
+      before,
+      after,
+      patch,
+      std::make_index_sequence<kFlatOrdinals<S>.size()>{});
+  diffFields<Writer>(
+      before, after, patch, std::make_index_sequence<op::size_v<S>>{});
+}
+
+template <typename Writer, typename KeyTag, typename MappedTag, typename M>
+void diffMap(const M& before, const M& after, MapPatch& patch) {
+  size_t kept = 0;
+  for (const auto& [key, value] : after) {
+    PatchNode child;
+    auto it = before.find(key);
+    if (it == before.end()) {
+      child.set_val(encode<Writer, MappedTag>(value));
+    } else {
+      ++kept;
+      if (!diff<Writer, MappedTag>(it->second, value, child)) {
+        continue;
+      }
+    }
+    patch.children()->emplace(keyToString<KeyTag>(key), std::move(child));
+  }
+  if (kept == before.size()) {
+    return;
+  }
+  for (const auto& [key, value] : before) {
+    if (after.find(key) == after.end()) {
+      PatchNode child;
+      child.set_del();
+      patch.children()->emplace(keyToString<KeyTag>(key), std::move(child));
+    }
+  }
+}
+
+/*
+ * Sets patch to the changes from before to after. False, leaving patch
+ * alone, if there are none. Structs and maps are patched member by member,
+ * everything else is replaced as a whole.
+ */
+template <typename Writer, typename Tag, typename T>
+bool diff(const T& before, const T& after, PatchNode& patch) {
+  using StdTag = standard_t<Tag>;
+  if constexpr (kIsStruct<StdTag>) {
+    StructPatch structPatch;
+    diffStruct<Writer>(before, after, structPatch);
+    if (structPatch.children()->empty()) {
+      return false;
+    }
+    patch.set_struct_node(std::move(structPatch));
+    return true;
+  } else if constexpr (
+      MapTags<StdTag>::value &&
+      kIsSupportedKey<typename MapTags<StdTag>::key>) {
+    MapPatch mapPatch;
+    diffMap<
+        Writer,
+        typename MapTags<StdTag>::key,
+        typename MapTags<StdTag>::mapped>(before, after, mapPatch);
+    if (mapPatch.children()->empty()) {
+      return false;
+    }
+    patch.set_map_node(std::move(mapPatch));
+    return true;
+  } else {
+    if (before == after) {
+      return false;
+    }
+    patch.set_val(encode<Writer, Tag>(after));
+    return true;
+  }
+}
+
+template <typename Fn>
+decltype(auto) withWriter(fsdb::OperProtocol protocol, Fn&& fn) {
+  switch (protocol) {
+    case fsdb::OperProtocol::BINARY:
+      return fn(std::type_identity<apache::thrift::BinaryProtocolWriter>{});
+    case fsdb::OperProtocol::COMPACT:
+      return fn(std::type_identity<apache::thrift::CompactProtocolWriter>{});
+    default:
+      throw std::invalid_argument("Unsupported patch protocol");
+  }
+}
+
+} // namespace opb_detail
+
+/*
+ * Builds patches between two plain thrift structs, for publishers that keep
+ * what they published last instead of a thrift_cow tree (see PatchBuilder
+ * for the latter). The always present integer fields of each struct are
+ * compared as flat arrays, so unchanged counters cost a memcmp.
+ */
+struct ThriftObjectPatchBuilder {
+  template <typename T>
+  static fsdb::Patch build(
+      const T& oldObj,
+      const T& newObj,
+      const std::vector<std::string>& basePath,
+      fsdb::OperProtocol protocol = fsdb::OperProtocol::COMPACT) {
+    fsdb::Patch patch;
+    patch.basePath() = basePath;
+    patch.protocol() = protocol;
+    opb_detail::withWriter(protocol, [&](auto writer) {
+      using Writer = typename decltype(writer)::type;
+      opb_detail::diff<Writer, apache::thrift::type::struct_t<T>>(
+          oldObj, newObj, *patch.patch());
+    });
+    return patch;
+  }
+
+  // Patch replacing the whole object at basePath, e.g. on (re)connect
+  template <typename T>
+  static fsdb::Patch buildFull(
+      const T& obj,
+      const std::vector<std::string>& basePath,
+      fsdb::OperProtocol protocol = fsdb::OperProtocol::COMPACT) {
+    fsdb::Patch patch;
+    patch.basePath() = basePath;
+    patch.protocol() = protocol;
+    opb_detail::withWriter(protocol, [&](auto writer) {
+      using Writer = typename decltype(writer)::type;
+      patch.patch()->set_val(
+          opb_detail::encode<Writer, apache::thrift::type::struct_t<T>>(obj));
+    });
+    return patch;
+  }
+};
+
+} // namespace facebook::fboss::thrift_cow
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <fboss/thrift_cow/visitors/PathToken.h>
 #include <fboss/thrift_cow/visitors/ThriftTCType.h>
 
 #include <folly/String.h>
@@ -26,7 +27,13 @@ template <typename Impl>
 class TraverseHelper {
  public:
   void push(std::string&& tok, ThriftTCType tc) {
+    push(std::move(tok), PathToken(), tc);
+  }
+
+  // token is tok already resolved, if the caller has it for free
+  void push(std::string&& tok, PathToken token, ThriftTCType tc) {
     currentPath_.emplace_back(std::move(tok));
+    currentTokens_.push_back(token);
     if (XLOG_IS_ON(DBG6)) {
       XLOG(DBG6) << "Traversing up to path " << folly::join("/", currentPath_);
     }
@@ -36,6 +43,7 @@ class TraverseHelper {
   void pop(ThriftTCType tc) {
     std::string tok = std::move(currentPath_.back());
     currentPath_.pop_back();
+    currentTokens_.pop_back();
     if (XLOG_IS_ON(DBG6)) {
       XLOG(DBG6) << "Traversing down to path "
                  << folly::join("/", currentPath_);
@@ -52,6 +60,13 @@ class TraverseHelper {
     return currentPath_;
   }
 
+  // Token of path().back(), only resolved from the string if it was pushed
+  // without one
+  PathToken lastToken() const {
+    const auto& token = currentTokens_.back();
+    return token.isResolved() ? token : PathToken::find(currentPath_.back());
+  }
+
  private:
   void onPush(ThriftTCType tc) {
     return static_cast<Impl*>(this)->onPushImpl(tc);
@@ -62,6 +77,7 @@ class TraverseHelper {
   }
 
   std::vector<std::string> currentPath_;
+  std::vector<PathToken> currentTokens_;
 };
 
 struct SimpleTraverseHelper : TraverseHelper<SimpleTraverseHelper> {
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <fboss/thrift_cow/visitors/PathToken.h>
 #include <thrift/lib/cpp2/reflection/reflection.h>
 #include "folly/Conv.h"
 
@@ -18,6 +19,19 @@ std::string getMemberName(bool useId) {
   }
 }
 
+// Token of getMemberName(useId), the name is only interned once per member
+template <typename Meta>
+PathToken getMemberToken(bool useId) {
+  using name = typename Meta::name;
+  using id = typename Meta::id;
+  if (useId) {
+    return PathToken(id::value);
+  }
+  static const PathToken nameToken = PathToken::intern(
+      std::string_view(fatal::z_data<name>(), fatal::size<name>::value));
+  return nameToken;
+}
+
 template <typename MemberTypes, typename Func>
 void visitMember(const std::string& key, Func&& f) {
   // try to find child using id first, then fallback to name
@@ -7,9 +7,11 @@
 #include "fboss/thrift_cow/nodes/tests/gen-cpp2/test_types.h"
 #include "fboss/thrift_cow/visitors/PatchApplier.h"
 #include "fboss/thrift_cow/visitors/PatchBuilder.h"
+#include "fboss/thrift_cow/visitors/PatchHelpers.h"
 #include "fboss/thrift_cow/visitors/tests/VisitorTestUtils.h"
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <memory>
 
 namespace {
@@ -32,6 +34,43 @@ void testPatchBuildApply(
   EXPECT_EQ(nodeB->toThrift(), nodeC->toThrift());
 }
 
+std::shared_ptr<ThriftStructNode<TestStruct>> buildMapNode(int base) {
+  auto s = createSimpleTestStruct();
+  for (int i = 0; i < 100; ++i) {
+    s.mapOfI32ToI32()[i] = base + i;
+  }
+  auto node = std::make_shared<ThriftStructNode<TestStruct>>(s);
+  node->publish();
+  return node;
+}
+
+PatchNode buildMapPatch(int baseA, int baseB) {
+  return *PatchBuilder::build(
+              buildMapNode(baseA),
+              buildMapNode(baseB),
+              {},
+              fsdb::OperProtocol::COMPACT,
+              false /* incrementallyCompress */)
+              .patch();
+}
+
+void testCompressedPatchApply(const PatchCompressionOptions& options) {
+  auto nodeA = buildMapNode(0);
+  auto nodeB = buildMapNode(1000);
+  auto patch = buildMapPatch(0, 1000);
+
+  auto result = compressPatch(patch, options);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_LT(result->compressedBytes, result->serializedBytes);
+  // Already compressed
+  EXPECT_FALSE(compressPatch(patch, options).has_value());
+
+  auto nodeC = nodeA->clone();
+  auto ret = RootPatchApplier::apply(*nodeC, std::move(patch));
+  EXPECT_EQ(ret, PatchApplyResult::OK);
+  EXPECT_EQ(nodeB->toThrift(), nodeC->toThrift());
+}
+
 } // namespace
 
 namespace facebook::fboss::thrift_cow::test {
@@ -135,4 +174,44 @@ TEST(PatchBuildApplyTests, TestTruncactionNestedStruct) {
   testPatchBuildApply(nodeA, nodeB);
 }
 
+TEST(PatchBuildApplyTests, TestZstdCompression) {
+  PatchCompressionOptions options;
+  options.codec = CompressionCodec::ZSTD;
+  testCompressedPatchApply(options);
+}
+
+TEST(PatchBuildApplyTests, TestZstdDictionaryCompression) {
+  std::vector<PatchNode> samples;
+  for (int i = 0; i < 200; ++i) {
+    samples.push_back(buildMapPatch(i, i + 1));
+  }
+  auto dictionary = PatchCompressionDictionary::train(samples, 4 * 1024);
+  registerPatchCompressionDictionary("test_state", dictionary);
+  EXPECT_EQ(dictionary, getPatchCompressionDictionary("test_state"));
+  EXPECT_EQ(dictionary, getPatchCompressionDictionary(dictionary->id()));
+  auto ids = getPatchCompressionDictionaryIds();
+  EXPECT_NE(std::find(ids.begin(), ids.end(), dictionary->id()), ids.end());
+
+  PatchCompressionOptions options;
+  options.codec = CompressionCodec::ZSTD;
+  options.dictionary = dictionary;
+  testCompressedPatchApply(options);
+}
+
+TEST(PatchBuildApplyTests, TestZstdDecompressedSizeCap) {
+  // zstd frame header claiming 1TB of content: magic number, single segment
+  // frame with an 8 byte little endian content size
+  std::string frame{"\x28\xb5\x2f\xfd\xe0", 5};
+  uint64_t contentSize = 1ULL << 40;
+  frame.append(reinterpret_cast<const char*>(&contentSize), 8);
+
+  StructPatch structPatch;
+  structPatch.compressedChildren() =
+      *folly::IOBuf::copyBuffer(frame.data(), frame.size());
+  structPatch.compressionCodec() = CompressionCodec::ZSTD;
+  PatchNode patch;
+  patch.set_struct_node(std::move(structPatch));
+  EXPECT_THROW(decompressPatch(patch), std::runtime_error);
+}
+
 } // namespace facebook::fboss::thrift_cow::test
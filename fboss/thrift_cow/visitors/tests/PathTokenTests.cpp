@@ -0,0 +1,117 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include <folly/String.h>
+#include <gtest/gtest.h>
+
+#include <fboss/thrift_cow/visitors/DeltaVisitor.h>
+#include <fboss/thrift_cow/visitors/PathToken.h>
+#include <fboss/thrift_cow/visitors/RecurseVisitor.h>
+#include <fboss/thrift_cow/visitors/tests/VisitorTestUtils.h>
+#include "fboss/thrift_cow/nodes/Types.h"
+
+namespace {
+
+using namespace facebook::fboss;
+using namespace facebook::fboss::thrift_cow;
+
+// Checks that tokens pushed by the visitors match the pushed strings
+struct TokenCheckingTraverser : TraverseHelper<TokenCheckingTraverser> {
+  using Base = TraverseHelper<TokenCheckingTraverser>;
+
+  using Base::lastToken;
+  using Base::path;
+  using Base::shouldShortCircuit;
+
+  bool shouldShortCircuitImpl(VisitorType /* visitorType */) const {
+    return false;
+  }
+
+  void onPushImpl(ThriftTCType /* tc */) {
+    EXPECT_TRUE(lastToken() == PathToken::find(path().back()))
+        << folly::join('/', path());
+    ++numPushes;
+  }
+
+  void onPopImpl(std::string&& /* popped */, ThriftTCType /* tc */) {}
+
+  int numPushes{0};
+};
+
+} // namespace
+
+namespace facebook::fboss::thrift_cow {
+
+TEST(PathTokenTests, IntegersAndNames) {
+  EXPECT_TRUE(PathToken::intern("42") == PathToken(42));
+  EXPECT_TRUE(PathToken::find("-7") == PathToken(-7));
+  EXPECT_TRUE(PathToken::find("0") == PathToken(0));
+  for (auto tok : {"01", "+1", "-0", "1.0", "", "-", "99999999999999999999"}) {
+    EXPECT_FALSE(PathToken::parseInt(tok).has_value()) << tok;
+  }
+  EXPECT_FALSE(PathToken::intern("01") == PathToken(1));
+
+  EXPECT_FALSE(PathToken::find("neverInternedToken").isResolved());
+  auto token = PathToken::intern("internedToken");
+  EXPECT_TRUE(token.isResolved());
+  EXPECT_TRUE(PathToken::find("internedToken") == token);
+  EXPECT_TRUE(PathToken::intern("internedToken") == token);
+  EXPECT_FALSE(PathToken::intern("otherToken") == token);
+  EXPECT_EQ(token.str(), "internedToken");
+  EXPECT_EQ(PathToken(-7).str(), "-7");
+}
+
+TEST(PathTokenTests, KeyTokens) {
+  EXPECT_TRUE(toPathToken(int16_t(5)) == PathToken::find("5"));
+  EXPECT_TRUE(toPathToken(TestEnum::THIRD) == PathToken::find("3"));
+  EXPECT_TRUE(toPathToken(true) == PathToken::find("1"));
+  EXPECT_FALSE(toPathToken(std::numeric_limits<uint64_t>::max()).isResolved());
+  EXPECT_FALSE(toPathToken(std::string("5")).isResolved());
+}
+
+TEST(PathTokenTests, VisitorTokensMatchPath) {
+  auto structA = createSimpleTestStruct();
+  auto structB = structA;
+  structB.inlineInt() = 1;
+  structB.inlineVariant()->inlineString_ref() = "variant";
+  structB.mapOfEnumToStruct()[TestEnum::FIRST].min() = 1;
+  structB.mapOfI32ToI32()[-5] = 5;
+  structB.mapOfStringToI32()["test1"] = 10;
+  structB.mapOfStringToI32()["01"] = 10;
+  structB.listOfPrimitives() = {1, 2, 3};
+  structB.setOfI32() = {4, 5};
+  structB.setOfString() = {"a"};
+  structB.unsigned_int64() = std::numeric_limits<uint64_t>::max();
+
+  auto nodeA = std::make_shared<ThriftStructNode<TestStruct>>(structA);
+  auto nodeB = std::make_shared<ThriftStructNode<TestStruct>>(structB);
+
+  for (auto outputIdPaths : {false, true}) {
+    TokenCheckingTraverser deltaTraverser;
+    RootDeltaVisitor::visit(
+        deltaTraverser,
+        nodeA,
+        nodeB,
+        DeltaVisitOptions(
+            DeltaVisitMode::FULL,
+            DeltaVisitOrder::PARENTS_FIRST,
+            outputIdPaths),
+        [](const std::vector<std::string>& /* path */,
+           auto&& /* oldNode */,
+           auto&& /* newNode */,
+           DeltaElemTag /* tag */) {});
+    EXPECT_GT(deltaTraverser.numPushes, 0);
+
+    TokenCheckingTraverser recurseTraverser;
+    RootRecurseVisitor::visit(
+        recurseTraverser,
+        nodeB,
+        RecurseVisitOptions(
+            RecurseVisitMode::FULL,
+            RecurseVisitOrder::PARENTS_FIRST,
+            outputIdPaths),
+        [](const std::vector<std::string>& /* path */, auto&& /* node */) {});
+    EXPECT_GT(recurseTraverser.numPushes, 0);
+  }
+}
+
+} // namespace facebook::fboss::thrift_cow
@@ -0,0 +1,119 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+#include "fboss/thrift_cow/nodes/tests/gen-cpp2/test_types.h"
+#include "fboss/thrift_cow/visitors/PatchApplier.h"
+#include "fboss/thrift_cow/visitors/ThriftObjectPatchBuilder.h"
+#include "fboss/thrift_cow/visitors/tests/VisitorTestUtils.h"
+
+namespace {
+
+using namespace facebook::fboss;
+using namespace facebook::fboss::thrift_cow;
+
+fsdb::Patch buildAndApply(
+    const TestStruct& before,
+    const TestStruct& after,
+    fsdb::OperProtocol protocol = fsdb::OperProtocol::COMPACT) {
+  auto patch = ThriftObjectPatchBuilder::build(before, after, {}, protocol);
+  auto result = before;
+  auto ret =
+      RootPatchApplier::apply(result, PatchNode(*patch.patch()), protocol);
+  EXPECT_EQ(ret, PatchApplyResult::OK);
+  EXPECT_EQ(result, after);
+  return patch;
+}
+
+const StructPatch& structPatch(const fsdb::Patch& patch) {
+  return patch.patch()->get_struct_node();
+}
+
+} // namespace
+
+namespace facebook::fboss::thrift_cow {
+
+TEST(ThriftObjectPatchBuilderTests, NoChanges) {
+  auto s = createSimpleTestStruct();
+  auto patch = ThriftObjectPatchBuilder::build(s, s, {"root"});
+  EXPECT_EQ(patch.patch()->getType(), PatchNode::Type::__EMPTY__);
+  EXPECT_EQ(*patch.basePath(), std::vector<std::string>{"root"});
+}
+
+TEST(ThriftObjectPatchBuilderTests, FlatFields) {
+  auto before = createSimpleTestStruct();
+  auto after = before;
+  after.inlineInt() = 55;
+  after.inlineBool() = false;
+  after.unsigned_int64() = std::numeric_limits<uint64_t>::max();
+  for (auto protocol :
+       {fsdb::OperProtocol::COMPACT, fsdb::OperProtocol::BINARY}) {
+    auto patch = buildAndApply(before, after, protocol);
+    EXPECT_EQ(structPatch(patch).children()->size(), 3);
+  }
+}
+
+TEST(ThriftObjectPatchBuilderTests, OptionalFields) {
+  auto before = createSimpleTestStruct();
+  auto after = before;
+  after.optionalInt() = 1;
+  after.optionalString().reset();
+  auto patch = buildAndApply(before, after);
+  const auto& children = *structPatch(patch).children();
+  EXPECT_EQ(children.size(), 2);
+  EXPECT_EQ(
+      children.at(TestStructMembers::optionalString::id()).getType(),
+      PatchNode::Type::del);
+  buildAndApply(after, before);
+}
+
+TEST(ThriftObjectPatchBuilderTests, NestedStructsAndMaps) {
+  auto before = createSimpleTestStruct();
+  for (int i = 0; i < 100; ++i) {
+    before.mapOfI32ToI32()[i] = i;
+  }
+  auto after = before;
+  after.mapOfI32ToI32()[5] = 500;
+  after.mapOfI32ToI32()[1000] = 1000;
+  after.mapOfI32ToI32()->erase(7);
+  after.inlineStruct()->min() = 11;
+  after.mapOfI32ToStruct()[20].max() = 601;
+  after.mapOfEnumToStruct()->erase(TestEnum::THIRD);
+  after.mapOfStringToI32()["test1"] = 10;
+  auto patch = buildAndApply(before, after);
+
+  const auto& mapPatch = structPatch(patch)
+                             .children()
+                             ->at(TestStructMembers::mapOfI32ToI32::id())
+                             .get_map_node();
+  EXPECT_EQ(mapPatch.children()->size(), 3);
+  EXPECT_EQ(mapPatch.children()->at("7").getType(), PatchNode::Type::del);
+}
+
+TEST(ThriftObjectPatchBuilderTests, LeavesReplacedWhole) {
+  auto before = createSimpleTestStruct();
+  auto after = before;
+  after.listOfPrimitives() = {1, 2, 3};
+  after.setOfString() = {"a"};
+  after.inlineVariant()->inlineString_ref() = "variant";
+  after.inlineString() = "other";
+  auto patch = buildAndApply(before, after);
+  for (const auto& [id, child] : *structPatch(patch).children()) {
+    EXPECT_EQ(child.getType(), PatchNode::Type::val);
+  }
+}
+
+TEST(ThriftObjectPatchBuilderTests, FullPatch) {
+  auto s = createSimpleTestStruct();
+  auto patch = ThriftObjectPatchBuilder::buildFull(s, {"root"});
+  ASSERT_EQ(patch.patch()->getType(), PatchNode::Type::val);
+  TestStruct result;
+  result.inlineInt() = 1000;
+  auto ret = RootPatchApplier::apply(result, PatchNode(*patch.patch()));
+  EXPECT_EQ(ret, PatchApplyResult::OK);
+  EXPECT_EQ(result, s);
+}
+
+} // namespace facebook::fboss::thrift_cow